@@ -3,9 +3,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
-#include <ctype.h>
 #include <string.h>
-#include <limits.h>
 #include "azure_c_shared_utility/gballoc.h"
 #include "azure_c_shared_utility/httpheaders.h"
 #include "azure_c_shared_utility/crt_abstractions.h"
@@ -15,6 +13,7 @@
 #include "azure_c_shared_utility/tlsio.h"
 #include "azure_c_shared_utility/threadapi.h"
 #include "azure_c_shared_utility/shared_util_options.h"
+#include "azure_c_shared_utility/http_response_parser.h"
 
 /*Codes_SRS_HTTPAPI_COMPACT_21_001: [ The httpapi_compact shall implement the methods defined by the `httpapi.h`. ]*/
 /*Codes_SRS_HTTPAPI_COMPACT_21_002: [ The httpapi_compact shall support the http requests. ]*/
@@ -37,6 +36,18 @@
 
 DEFINE_ENUM_STRINGS(HTTPAPI_RESULT, HTTPAPI_RESULT_VALUES)
 
+typedef struct HTTP_RESPONSE_CONTEXT_TAG
+{
+    unsigned int*   statusCode;
+    HTTP_HEADERS_HANDLE responseHeadersHandle;
+    BUFFER_HANDLE   responseContent;
+    size_t          bodyBytesReceived;
+    size_t          bytesReceived;
+    bool            isChunked;
+    bool            statusReceived;
+    HTTPAPI_RESULT  result;
+} HTTP_RESPONSE_CONTEXT;
+
 typedef struct HTTP_HANDLE_DATA_TAG
 {
     char*           certificate;
@@ -45,129 +56,13 @@ typedef struct HTTP_HANDLE_DATA_TAG
     XIO_HANDLE      xio_handle;
     size_t          received_bytes_count;
     unsigned char*  received_bytes;
+    HTTP_RESPONSE_PARSER_HANDLE response_parser;
+    HTTP_RESPONSE_CONTEXT* response_context;
     unsigned int    is_io_error : 1;
     unsigned int    is_connected : 1;
     unsigned int    send_completed : 1;
 } HTTP_HANDLE_DATA;
 
-/*the following function does the same as sscanf(pos2, "%d", &sec)*/
-/*this function only exists because some of platforms do not have sscanf. */
-static int ParseStringToDecimal(const char *src, int* dst)
-{
-    int result;
-    char* next;
-    long num = strtol(src, &next, 0);
-    if (src == next || num < INT_MIN || num > INT_MAX)
-    {
-        result = EOF;
-    }
-    else
-    {
-        result = 1;
-    }
-    if (num < INT_MIN) num = INT_MIN;
-    if (num > INT_MAX) num = INT_MAX;
-    *dst = (int)num;
-    return result;
-}
-
-/*the following function does the same as sscanf(pos2, "%x", &sec)*/
-/*this function only exists because some of platforms do not have sscanf. This is not a full implementation; it only works with well-defined x numbers. */
-#define HEXA_DIGIT_VAL(c)         (((c>='0') && (c<='9')) ? (c-'0') : ((c>='a') && (c<='f')) ? (c-'a'+10) : ((c>='A') && (c<='F')) ? (c-'A'+10) : -1)
-static int ParseStringToHexadecimal(const char *src, size_t* dst)
-{
-    int result;
-    int digitVal;
-    if (src == NULL)
-    {
-        result = EOF;
-    }
-    else if (HEXA_DIGIT_VAL(*src) == -1)
-    {
-        result = EOF;
-    }
-    else
-    {
-        (*dst) = 0;
-        while ((digitVal = HEXA_DIGIT_VAL(*src)) != -1)
-        {
-            (*dst) *= 0x10;
-            (*dst) += (size_t)digitVal;
-            src++;
-        }
-        result = 1;
-    }
-    return result;
-}
-
-/*the following function does the same as sscanf(buf, "HTTP/%*d.%*d %d %*[^\r\n]", &ret) */
-/*this function only exists because some of platforms do not have sscanf. This is not a full implementation; it only works with well-defined HTTP response. */
-static int  ParseHttpResponse(const char* src, int* dst)
-{
-    int result;
-    static const char HTTPPrefix[] = "HTTP/";
-    bool fail;
-    const char* runPrefix;
-
-    if ((src == NULL) || (dst == NULL))
-    {
-        result = EOF;
-    }
-    else
-    {
-        fail = false;
-        runPrefix = HTTPPrefix;
-
-        while((*runPrefix) != '\0')
-        {
-            if ((*runPrefix) != (*src))
-            {
-                fail = true;
-                break;
-            }
-            src++;
-            runPrefix++;
-        }
-
-        if (!fail)
-        {
-            while ((*src) != '.')
-            {
-                if ((*src) == '\0')
-                {
-                    fail = true;
-                    break;
-                }
-                src++;
-            }
-        }
-
-        if (!fail)
-        {
-            while ((*src) != ' ')
-            {
-                if ((*src) == '\0')
-                {
-                    fail = true;
-                    break;
-                }
-                src++;
-            }
-        }
-
-        if (fail)
-        {
-            result = EOF;
-        }
-        else
-        {
-            result = ParseStringToDecimal(src, dst);
-        }
-    }
-
-    return result;
-}
-
 HTTPAPI_RESULT HTTPAPI_Init(void)
 {
 /*Codes_SRS_HTTPAPI_COMPACT_21_004: [ The HTTPAPI_Init shall allocate all memory to control the http protocol. ]*/
@@ -236,6 +131,8 @@ HTTP_HANDLE HTTPAPI_CreateConnection(const char* hostName)
                 http_instance->is_io_error = 0;
                 http_instance->received_bytes_count = 0;
                 http_instance->received_bytes = NULL;
+                http_instance->response_parser = NULL;
+                http_instance->response_context = NULL;
                 http_instance->certificate = NULL;
                 http_instance->x509ClientCertificate = NULL;
                 http_instance->x509ClientPrivateKey = NULL;
@@ -305,6 +202,12 @@ void HTTPAPI_CloseConnection(HTTP_HANDLE handle)
             xio_destroy(http_instance->xio_handle);
         }
 
+        /* bytes received after the last response was complete are not consumed by anyone */
+        if (http_instance->received_bytes != NULL)
+        {
+            free(http_instance->received_bytes);
+        }
+
         /*Codes_SRS_HTTPAPI_COMPACT_21_018: [ If there is a certificate associated to this connection, the HTTPAPI_CloseConnection shall free all allocated memory for the certificate. ]*/
         if (http_instance->certificate)
         {
@@ -362,32 +265,21 @@ static void on_send_complete(void* context, IO_SEND_RESULT send_result)
     }
 }
 
-#define TOLOWER(c) (((c>='A') && (c<='Z'))?c-'A'+'a':c)
-static int InternStrnicmp(const char* s1, const char* s2, size_t n)
+static void feed_response_parser(HTTP_HANDLE_DATA* http_instance, const unsigned char* buffer, size_t size)
 {
-    int result;
+    HTTP_RESPONSE_CONTEXT* response_context = http_instance->response_context;
 
-    if (s1 == NULL) result = -1;
-    else if (s2 == NULL) result = 1;
-    else
-    {
-        result = 0;
-
-        while(n-- && result == 0)
-        {
-            if (*s1 == 0) result = -1;
-            else if (*s2 == 0) result = 1;
-            else
-            {
+    response_context->bytesReceived += size;
 
-                result = TOLOWER(*s1) - TOLOWER(*s2);
-                ++s1;
-                ++s2;
-            }
-        }
+    /* the parser stops consuming bytes once the response is complete, anything after it is discarded */
+    if ((response_context->result == HTTPAPI_OK) &&
+        (http_response_parser_parse(http_instance->response_parser, buffer, size, NULL) != 0))
+    {
+        /*Codes_SRS_HTTPAPI_COMPACT_21_055: [ If the HTTPAPI_ExecuteRequest cannot parser the recived message, it shall return HTTPAPI_RECEIVE_RESPONSE_FAILED. ]*/
+        /*Codes_SRS_HTTPAPI_COMPACT_21_032: [ If the HTTPAPI_ExecuteRequest cannot read the message with the request result, it shall return HTTPAPI_READ_DATA_FAILED. ]*/
+        LogError("Not a correct HTTP answer");
+        response_context->result = (response_context->statusReceived) ? HTTPAPI_READ_DATA_FAILED : HTTPAPI_RECEIVE_RESPONSE_FAILED;
     }
-
-    return result;
 }
 
 static void on_bytes_received(void* context, const unsigned char* buffer, size_t size)
@@ -403,9 +295,14 @@ static void on_bytes_received(void* context, const unsigned char* buffer, size_t
             http_instance->is_io_error = 1;
             LogError("NULL pointer error");
         }
+        else if (http_instance->response_parser != NULL)
+        {
+            /*Codes_SRS_HTTPAPI_COMPACT_21_088: [ While receiving the response, the HTTPAPI_ExecuteRequest shall hand the received bytes directly to the http_response_parser, without buffering them. ]*/
+            feed_response_parser(http_instance, buffer, size);
+        }
         else
         {
-            /* Here we got some bytes so we'll buffer them so the receive functions can consumer it */
+            /* Bytes received before the response is expected are buffered until the receive starts */
             new_received_bytes = (unsigned char*)realloc(http_instance->received_bytes, http_instance->received_bytes_count + size);
             if (new_received_bytes == NULL)
             {
@@ -415,15 +312,8 @@ static void on_bytes_received(void* context, const unsigned char* buffer, size_t
             else
             {
                 http_instance->received_bytes = new_received_bytes;
-                if (memcpy(http_instance->received_bytes + http_instance->received_bytes_count, buffer, size) == NULL)
-                {
-                    http_instance->is_io_error = 1;
-                    LogError("Error copping received data to the HTTP bufffer");
-                }
-                else
-                {
-                    http_instance->received_bytes_count += size;
-                }
+                (void)memcpy(http_instance->received_bytes + http_instance->received_bytes_count, buffer, size);
+                http_instance->received_bytes_count += size;
             }
         }
     }
@@ -439,56 +329,6 @@ static void on_io_error(void* context)
     }
 }
 
-static int conn_receive(HTTP_HANDLE_DATA* http_instance, char* buffer, int count)
-{
-    int result;
-
-    if ((http_instance == NULL) || (buffer == NULL) || (count < 0))
-    {
-        LogError("conn_receive: %s", ((http_instance == NULL) ? "Invalid HTTP instance" : "Invalid HTTP buffer"));
-        result = -1;
-    }
-    else
-    {
-        result = 0;
-        while (result < count)
-        {
-            xio_dowork(http_instance->xio_handle);
-
-            /* if any error was detected while receiving then simply break and report it */
-            if (http_instance->is_io_error != 0)
-            {
-                LogError("xio reported error on dowork");
-                result = -1;
-                break;
-            }
-
-            if (http_instance->received_bytes_count >= (size_t)count)
-            {
-                /* Consuming bytes from the receive buffer */
-                (void)memcpy(buffer, http_instance->received_bytes, count);
-                (void)memmove(http_instance->received_bytes, http_instance->received_bytes + count, http_instance->received_bytes_count - count);
-                http_instance->received_bytes_count -= count;
-
-                /* we're not reallocating at each consumption so that we don't trash due to byte by byte consumption */
-                if (http_instance->received_bytes_count == 0)
-                {
-                    free(http_instance->received_bytes);
-                    http_instance->received_bytes = NULL;
-                }
-
-                result = count;
-                break;
-            }
-
-            /*Codes_SRS_HTTPAPI_COMPACT_21_083: [ The HTTPAPI_ExecuteRequest shall wait, at least, 100 milliseconds between retries. ]*/
-            ThreadAPI_Sleep(RETRY_INTERVAL_IN_MICROSECONDS);
-        }
-    }
-
-    return result;
-}
-
 static void conn_receive_discard_buffer(HTTP_HANDLE_DATA* http_instance)
 {
     if (http_instance != NULL)
@@ -502,187 +342,6 @@ static void conn_receive_discard_buffer(HTTP_HANDLE_DATA* http_instance)
     }
 }
 
-static int readLine(HTTP_HANDLE_DATA* http_instance, char* buf, const size_t maxBufSize)
-{
-    int resultLineSize;
-
-    if ((http_instance == NULL) || (buf == NULL) || (maxBufSize == 0))
-    {
-        LogError("%s", ((http_instance == NULL) ? "Invalid HTTP instance" : "Invalid HTTP buffer"));
-        resultLineSize = -1;
-    }
-    else
-    {
-        char* destByte = buf;
-        /*Codes_SRS_HTTPAPI_COMPACT_21_081: [ The HTTPAPI_ExecuteRequest shall try to read the message with the response up to 20 seconds. ]*/
-        int countRetry = MAX_RECEIVE_RETRY;
-        bool endOfSearch = false;
-        resultLineSize = -1;
-        while (!endOfSearch)
-        {
-            xio_dowork(http_instance->xio_handle);
-
-            /* if any error was detected while receiving then simply break and report it */
-            if (http_instance->is_io_error != 0)
-            {
-                LogError("xio reported error on dowork");
-                endOfSearch = true;
-            }
-            else
-            {
-                unsigned char* receivedByte = http_instance->received_bytes;
-                while (receivedByte < (http_instance->received_bytes + http_instance->received_bytes_count))
-                {
-                    if ((*receivedByte) != '\r')
-                    {
-                        (*destByte) = (*receivedByte);
-                        destByte++;
-                        receivedByte++;
-
-                        if (destByte >= (buf + maxBufSize - 1))
-                        {
-                            LogError("Received message is bigger than the http buffer");
-                            receivedByte = http_instance->received_bytes + http_instance->received_bytes_count;
-                            endOfSearch = true;
-                            break;
-                        }
-                    }
-                    else
-                    {
-                        receivedByte++;
-                        if ((receivedByte < (http_instance->received_bytes + http_instance->received_bytes_count)) && ((*receivedByte) == '\n'))
-                        {
-                            receivedByte++;
-                        }
-                        (*destByte) = '\0';
-                        resultLineSize = (int)(destByte - buf);
-                        endOfSearch = true;
-                        break;
-                    }
-                }
-
-                http_instance->received_bytes_count -= (receivedByte - http_instance->received_bytes);
-                if (http_instance->received_bytes_count != 0)
-                {
-                    (void)memmove(http_instance->received_bytes, receivedByte, http_instance->received_bytes_count);
-                }
-                else
-                {
-                    conn_receive_discard_buffer(http_instance);
-                }
-            }
-
-            if (!endOfSearch)
-            {
-                if ((countRetry--) > 0)
-                {
-                    /*Codes_SRS_HTTPAPI_COMPACT_21_083: [ The HTTPAPI_ExecuteRequest shall wait, at least, 100 milliseconds between retries. ]*/
-                    ThreadAPI_Sleep(RETRY_INTERVAL_IN_MICROSECONDS);
-                }
-                else
-                {
-                    /*Codes_SRS_HTTPAPI_COMPACT_21_082: [ If the HTTPAPI_ExecuteRequest retries 20 seconds to receive the message without success, it shall fail and return HTTPAPI_READ_DATA_FAILED. ]*/
-                    LogError("Receive timeout. The HTTP request is incomplete");
-                    endOfSearch = true;
-                }
-            }
-        }
-    }
-
-    return resultLineSize;
-}
-
-static int readChunk(HTTP_HANDLE_DATA* http_instance, char* buf, size_t size)
-{
-    int cur, offset;
-
-    // read content with specified length, even if it is received
-    // only in chunks due to fragmentation in the networking layer.
-    // returns -1 in case of error.
-    offset = 0;
-    while (size > (size_t)0)
-    {
-        cur = conn_receive(http_instance, buf + offset, (int)size);
-
-        // end of stream reached
-        if (cur == 0)
-        {
-            break;
-        }
-
-        // read cur bytes (might be less than requested)
-        size -= (size_t)cur;
-        offset += cur;
-    }
-
-    return offset;
-}
-
-static int skipN(HTTP_HANDLE_DATA* http_instance, size_t n)
-{
-    // read and abandon response content with specified length
-    // returns -1 in case of error.
-
-    int result;
-
-    if (http_instance == NULL)
-    {
-        LogError("Invalid HTTP instance");
-        result = -1;
-    }
-    else
-    {
-        /*Codes_SRS_HTTPAPI_COMPACT_21_081: [ The HTTPAPI_ExecuteRequest shall try to read the message with the response up to 20 seconds. ]*/
-        int countRetry = MAX_RECEIVE_RETRY;
-        result = (int)n;
-        while (n > 0)
-        {
-            xio_dowork(http_instance->xio_handle);
-
-            /* if any error was detected while receiving then simply break and report it */
-            if (http_instance->is_io_error != 0)
-            {
-                LogError("xio reported error on dowork");
-                result = -1;
-                n = 0;
-            }
-            else
-            {
-                if (http_instance->received_bytes_count <= n)
-                {
-                    n -= http_instance->received_bytes_count;
-                    http_instance->received_bytes_count = 0;
-                }
-                else
-                {
-                    http_instance->received_bytes_count -= n;
-                    (void)memmove(http_instance->received_bytes, http_instance->received_bytes + n, http_instance->received_bytes_count);
-                    n = 0;
-                }
-
-                if (n > 0)
-                {
-                    if ((countRetry--) > 0)
-                    {
-                        /*Codes_SRS_HTTPAPI_COMPACT_21_083: [ The HTTPAPI_ExecuteRequest shall wait, at least, 100 milliseconds between retries. ]*/
-                        ThreadAPI_Sleep(RETRY_INTERVAL_IN_MICROSECONDS);
-                    }
-                    else
-                    {
-                        /*Codes_SRS_HTTPAPI_COMPACT_21_082: [ If the HTTPAPI_ExecuteRequest retries 20 seconds to receive the message without success, it shall fail and return HTTPAPI_READ_DATA_FAILED. ]*/
-                        LogError("Receive timeout. The HTTP request is incomplete");
-                        n = 0;
-                        result = -1;
-                    }
-                }
-            }
-        }
-    }
-
-    return result;
-}
-
-
 /*Codes_SRS_HTTPAPI_COMPACT_21_021: [ The HTTPAPI_ExecuteRequest shall execute the http communtication with the provided host, sending a request and reciving the response. ]*/
 static HTTPAPI_RESULT OpenXIOConnection(HTTP_HANDLE_DATA* http_instance)
 {
@@ -827,7 +486,7 @@ static HTTPAPI_RESULT SendHeadsToXIO(HTTP_HANDLE_DATA* http_instance, HTTPAPI_RE
     /*Codes_SRS_HTTPAPI_COMPACT_21_038: [ The HTTPAPI_ExecuteRequest shall execute the resquest for the path in relativePath parameter. ]*/
     /*Codes_SRS_HTTPAPI_COMPACT_21_036: [ The request type shall be provided in the parameter requestType. ]*/
     if (((ret = snprintf(buf, sizeof(buf), "%s %s HTTP/1.1\r\n", get_request_type(requestType), relativePath)) < 0) ||
-        (ret >= sizeof(buf)))
+        ((size_t)ret >= sizeof(buf)))
     {
         /*Codes_SRS_HTTPAPI_COMPACT_21_027: [ If the HTTPAPI_ExecuteRequest cannot create a buffer to send the request, it shall not send any request and return HTTPAPI_STRING_PROCESSING_ERROR. ]*/
         result = HTTPAPI_STRING_PROCESSING_ERROR;
@@ -885,264 +544,204 @@ static HTTPAPI_RESULT SendContentToXIO(HTTP_HANDLE_DATA* http_instance, const un
     return result;
 }
 
-/*Codes_SRS_HTTPAPI_COMPACT_21_030: [ At the end of the transmission, the HTTPAPI_ExecuteRequest shall receive the response from the host. ]*/
-static HTTPAPI_RESULT RecieveHeaderFromXIO(HTTP_HANDLE_DATA* http_instance, unsigned int* statusCode)
+static void on_response_status(void* context, int status_code, const char* reason_phrase, size_t reason_phrase_length)
 {
-    HTTPAPI_RESULT result;
-    char    buf[TEMP_BUFFER_SIZE];
-    int     ret;
+    HTTP_RESPONSE_CONTEXT* response_context = ((HTTP_HANDLE_DATA*)context)->response_context;
+    (void)reason_phrase;
+    (void)reason_phrase_length;
 
-    http_instance->is_io_error = 0;
+    response_context->statusReceived = true;
 
-    //Receive response
-    if (readLine(http_instance, buf, TEMP_BUFFER_SIZE) < 0)
+    /*Codes_SRS_HTTPAPI_COMPACT_21_046: [ The HTTPAPI_ExecuteRequest shall return the http status reported by the host in the received response. ]*/
+    /*Codes_SRS_HTTPAPI_COMPACT_21_048: [ If the statusCode is NULL, the HTTPAPI_ExecuteRequest shall report not report any status. ]*/
+    if (response_context->statusCode != NULL)
     {
-        /*Codes_SRS_HTTPAPI_COMPACT_21_032: [ If the HTTPAPI_ExecuteRequest cannot read the message with the request result, it shall return HTTPAPI_READ_DATA_FAILED. ]*/
-        /*Codes_SRS_HTTPAPI_COMPACT_21_082: [ If the HTTPAPI_ExecuteRequest retries 20 seconds to receive the message without success, it shall fail and return HTTPAPI_READ_DATA_FAILED. ]*/
-        result = HTTPAPI_READ_DATA_FAILED;
+        /*Codes_SRS_HTTPAPI_COMPACT_21_047: [ The HTTPAPI_ExecuteRequest shall report the status in the statusCode parameter. ]*/
+        *response_context->statusCode = (unsigned int)status_code;
     }
-    //Parse HTTP response
-    else if (ParseHttpResponse(buf, &ret) != 1)
-    {
-        //Cannot match string, error
-        /*Codes_SRS_HTTPAPI_COMPACT_21_055: [ If the HTTPAPI_ExecuteRequest cannot parser the recived message, it shall return HTTPAPI_RECEIVE_RESPONSE_FAILED. ]*/
-        LogInfo("Not a correct HTTP answer");
-        result = HTTPAPI_RECEIVE_RESPONSE_FAILED;
-    }
-    else
+}
+
+static void on_response_header(void* context, const char* name, size_t name_length, const char* value, size_t value_length)
+{
+    HTTP_RESPONSE_CONTEXT* response_context = ((HTTP_HANDLE_DATA*)context)->response_context;
+
+    /*Codes_SRS_HTTPAPI_COMPACT_21_049: [ If responseHeadersHandle is provide, the HTTPAPI_ExecuteRequest shall prepare a Response Header usign the HTTPHeaders_AddHeaderNameValuePair. ]*/
+    if ((response_context->result == HTTPAPI_OK) &&
+        (response_context->responseHeadersHandle != NULL))
     {
-        /*Codes_SRS_HTTPAPI_COMPACT_21_046: [ The HTTPAPI_ExecuteRequest shall return the http status reported by the host in the received response. ]*/
-        /*Codes_SRS_HTTPAPI_COMPACT_21_048: [ If the statusCode is NULL, the HTTPAPI_ExecuteRequest shall report not report any status. ]*/
-        if (statusCode)
+        char buf[TEMP_BUFFER_SIZE];
+
+        if ((name_length + value_length + 2) > sizeof(buf))
         {
-            /*Codes_SRS_HTTPAPI_COMPACT_21_047: [ The HTTPAPI_ExecuteRequest shall report the status in the statusCode parameter. ]*/
-            *statusCode = ret;
+            /*Codes_SRS_HTTPAPI_COMPACT_21_032: [ If the HTTPAPI_ExecuteRequest cannot read the message with the request result, it shall return HTTPAPI_READ_DATA_FAILED. ]*/
+            LogError("Received header is bigger than the http buffer");
+            response_context->result = HTTPAPI_READ_DATA_FAILED;
+        }
+        else
+        {
+            /* the parser hands out views into the received bytes, HTTPHeaders needs zero terminated strings */
+            (void)memcpy(buf, name, name_length);
+            buf[name_length] = '\0';
+            (void)memcpy(buf + name_length + 1, value, value_length);
+            buf[name_length + 1 + value_length] = '\0';
+            if (HTTPHeaders_AddHeaderNameValuePair(response_context->responseHeadersHandle, buf, buf + name_length + 1) != HTTP_HEADERS_OK)
+            {
+                /*Codes_SRS_HTTPAPI_COMPACT_21_090: [ If adding a received header to responseHeadersHandle fails, the HTTPAPI_ExecuteRequest shall return HTTPAPI_ERROR. ]*/
+                LogError("Cannot add the received header to the response headers");
+                response_context->result = HTTPAPI_ERROR;
+            }
         }
-        /*Codes_SRS_HTTPAPI_COMPACT_21_033: [ If the whole process succeed, the HTTPAPI_ExecuteRequest shall retur HTTPAPI_OK. ]*/
-        result = HTTPAPI_OK;
     }
-
-    return result;
 }
 
-static HTTPAPI_RESULT RecieveContentInfoFromXIO(HTTP_HANDLE_DATA* http_instance, HTTP_HEADERS_HANDLE responseHeadersHandle, size_t* bodyLength, bool* chunked)
+static void on_response_headers_complete(void* context, bool is_chunked, size_t content_length)
 {
-    HTTPAPI_RESULT result;
-    char    buf[TEMP_BUFFER_SIZE];
-    const char* substr;
-    char* whereIsColon;
-    int lengthInMsg;
-    const char ContentLength[] = "content-length:";
-    const size_t ContentLengthSize = sizeof(ContentLength) - 1;
-    const char TransferEncoding[] = "transfer-encoding:";
-    const size_t TransferEncodingSize = sizeof(TransferEncoding) - 1;
-    const char Chunked[] = "chunked";
-    const size_t ChunkedSize = sizeof(Chunked) - 1;
+    HTTP_RESPONSE_CONTEXT* response_context = ((HTTP_HANDLE_DATA*)context)->response_context;
 
-    http_instance->is_io_error = 0;
+    response_context->isChunked = is_chunked;
 
-    //Read HTTP response headers
-    if (readLine(http_instance, buf, sizeof(buf)) < 0)
+    /*Codes_SRS_HTTPAPI_COMPACT_21_051: [ If the responseContent is NULL, the HTTPAPI_ExecuteRequest shall ignore any content in the response. ]*/
+    if ((response_context->result == HTTPAPI_OK) &&
+        (response_context->responseContent != NULL) &&
+        (!is_chunked) &&
+        (content_length > 0))
     {
-        /*Codes_SRS_HTTPAPI_COMPACT_21_032: [ If the HTTPAPI_ExecuteRequest cannot read the message with the request result, it shall return HTTPAPI_READ_DATA_FAILED. ]*/
-        /*Codes_SRS_HTTPAPI_COMPACT_21_082: [ If the HTTPAPI_ExecuteRequest retries 20 seconds to receive the message without success, it shall fail and return HTTPAPI_READ_DATA_FAILED. ]*/
-        result = HTTPAPI_READ_DATA_FAILED;
+        /* the whole body is allocated once, the body callbacks only copy into it */
+        if (BUFFER_pre_build(response_context->responseContent, content_length) != 0)
+        {
+            /*Codes_SRS_HTTPAPI_COMPACT_21_052: [ If any memory allocation get fail, the HTTPAPI_ExecuteRequest shall return HTTPAPI_ALLOC_FAILED. ]*/
+            LogError("Cannot allocate the response content");
+            response_context->result = HTTPAPI_ALLOC_FAILED;
+        }
     }
-    else
-    {
-        /*Codes_SRS_HTTPAPI_COMPACT_21_033: [ If the whole process succeed, the HTTPAPI_ExecuteRequest shall retur HTTPAPI_OK. ]*/
-        result = HTTPAPI_OK;
+}
 
-        while (*buf && (result == HTTPAPI_OK))
-        {
-            if (InternStrnicmp(buf, ContentLength, ContentLengthSize) == 0)
-            {
-                substr = buf + ContentLengthSize;
-                if (ParseStringToDecimal(substr, &lengthInMsg) != 1)
-                {
-                    /*Codes_SRS_HTTPAPI_COMPACT_21_032: [ If the HTTPAPI_ExecuteRequest cannot read the message with the request result, it shall return HTTPAPI_READ_DATA_FAILED. ]*/
-                    result = HTTPAPI_READ_DATA_FAILED;
-                }
-                else
-                {
-                    (*bodyLength) = (size_t)lengthInMsg;
-                }
-            }
-            else if (InternStrnicmp(buf, TransferEncoding, TransferEncodingSize) == 0)
-            {
-                substr = buf + TransferEncodingSize;
+static void on_response_body(void* context, const unsigned char* body_bytes, size_t length)
+{
+    HTTP_RESPONSE_CONTEXT* response_context = ((HTTP_HANDLE_DATA*)context)->response_context;
 
-                while (isspace(*substr)) substr++;
+    /*Codes_SRS_HTTPAPI_COMPACT_21_051: [ If the responseContent is NULL, the HTTPAPI_ExecuteRequest shall ignore any content in the response. ]*/
+    if ((response_context->result == HTTPAPI_OK) &&
+        (response_context->responseContent != NULL))
+    {
+        unsigned char* receivedContent;
 
-                if (InternStrnicmp(substr, Chunked, ChunkedSize) == 0)
-                {
-                    (*chunked) = true;
-                }
-            }
+        if (response_context->isChunked &&
+            (BUFFER_enlarge(response_context->responseContent, length) != 0))
+        {
+            (void)BUFFER_unbuild(response_context->responseContent);
 
-            if (result == HTTPAPI_OK)
-            {
-                whereIsColon = strchr((char*)buf, ':');
-                /*Codes_SRS_HTTPAPI_COMPACT_21_049: [ If responseHeadersHandle is provide, the HTTPAPI_ExecuteRequest shall prepare a Response Header usign the HTTPHeaders_AddHeaderNameValuePair. ]*/
-                if (whereIsColon && (responseHeadersHandle != NULL))
-                {
-                    *whereIsColon = '\0';
-                    HTTPHeaders_AddHeaderNameValuePair(responseHeadersHandle, buf, whereIsColon + 1);
-                }
+            /*Codes_SRS_HTTPAPI_COMPACT_21_052: [ If any memory allocation get fail, the HTTPAPI_ExecuteRequest shall return HTTPAPI_ALLOC_FAILED. ]*/
+            LogError("Cannot enlarge the response content");
+            response_context->result = HTTPAPI_ALLOC_FAILED;
+        }
+        else if ((receivedContent = BUFFER_u_char(response_context->responseContent)) == NULL)
+        {
+            (void)BUFFER_unbuild(response_context->responseContent);
 
-                if (readLine(http_instance, buf, sizeof(buf)) < 0)
-                {
-                    /*Codes_SRS_HTTPAPI_COMPACT_21_032: [ If the HTTPAPI_ExecuteRequest cannot read the message with the request result, it shall return HTTPAPI_READ_DATA_FAILED. ]*/
-                    /*Codes_SRS_HTTPAPI_COMPACT_21_082: [ If the HTTPAPI_ExecuteRequest retries 20 seconds to receive the message without success, it shall fail and return HTTPAPI_READ_DATA_FAILED. ]*/
-                    result = HTTPAPI_READ_DATA_FAILED;
-                }
-            }
+            /*Codes_SRS_HTTPAPI_COMPACT_21_052: [ If any memory allocation get fail, the HTTPAPI_ExecuteRequest shall return HTTPAPI_ALLOC_FAILED. ]*/
+            LogError("Cannot get the response content");
+            response_context->result = HTTPAPI_ALLOC_FAILED;
+        }
+        else
+        {
+            /*Codes_SRS_HTTPAPI_COMPACT_21_050: [ If there is a content in the response, the HTTPAPI_ExecuteRequest shall copy it in the responseContent buffer. ]*/
+            (void)memcpy(receivedContent + response_context->bodyBytesReceived, body_bytes, length);
+            response_context->bodyBytesReceived += length;
         }
     }
-
-    return result;
 }
 
-static HTTPAPI_RESULT ReadHTTPResponseBodyFromXIO(HTTP_HANDLE_DATA* http_instance, size_t bodyLength, bool chunked, BUFFER_HANDLE responseContent)
+/*Codes_SRS_HTTPAPI_COMPACT_21_030: [ At the end of the transmission, the HTTPAPI_ExecuteRequest shall receive the response from the host. ]*/
+static HTTPAPI_RESULT ReceiveResponseFromXIO(HTTP_HANDLE_DATA* http_instance, unsigned int* statusCode, HTTP_HEADERS_HANDLE responseHeadersHandle, BUFFER_HANDLE responseContent)
 {
     HTTPAPI_RESULT result;
-    char    buf[TEMP_BUFFER_SIZE];
-    const unsigned char* receivedContent;
+    HTTP_RESPONSE_CONTEXT response_context;
+
+    response_context.statusCode = statusCode;
+    response_context.responseHeadersHandle = responseHeadersHandle;
+    response_context.responseContent = responseContent;
+    response_context.bodyBytesReceived = 0;
+    response_context.bytesReceived = 0;
+    response_context.isChunked = false;
+    response_context.statusReceived = false;
+    /*Codes_SRS_HTTPAPI_COMPACT_21_033: [ If the whole process succeed, the HTTPAPI_ExecuteRequest shall retur HTTPAPI_OK. ]*/
+    response_context.result = HTTPAPI_OK;
 
     http_instance->is_io_error = 0;
 
-    //Read HTTP response body
-    if (!chunked)
+    /*Codes_SRS_HTTPAPI_COMPACT_21_089: [ The HTTPAPI_ExecuteRequest shall parse the response using an http_response_parser created by calling http_response_parser_create. ]*/
+    if ((http_instance->response_parser = http_response_parser_create(on_response_status, on_response_header, on_response_headers_complete, on_response_body, NULL, http_instance)) == NULL)
     {
-        if (bodyLength)
-        {
-            if (responseContent != NULL)
-            {
-                if (BUFFER_pre_build(responseContent, bodyLength) != 0)
-                {
-                    /*Codes_SRS_HTTPAPI_COMPACT_21_052: [ If any memory allocation get fail, the HTTPAPI_ExecuteRequest shall return HTTPAPI_ALLOC_FAILED. ]*/
-                    result = HTTPAPI_ALLOC_FAILED;
-                }
-                else if (BUFFER_content(responseContent, &receivedContent) != 0)
-                {
-                    (void)BUFFER_unbuild(responseContent);
-
-                    /*Codes_SRS_HTTPAPI_COMPACT_21_052: [ If any memory allocation get fail, the HTTPAPI_ExecuteRequest shall return HTTPAPI_ALLOC_FAILED. ]*/
-                    result = HTTPAPI_ALLOC_FAILED;
-                }
-                else if (readChunk(http_instance, (char*)receivedContent, bodyLength) < 0)
-                {
-                    /*Codes_SRS_HTTPAPI_COMPACT_21_032: [ If the HTTPAPI_ExecuteRequest cannot read the message with the request result, it shall return HTTPAPI_READ_DATA_FAILED. ]*/
-                    result = HTTPAPI_READ_DATA_FAILED;
-                }
-                else
-                {
-                    /*Codes_SRS_HTTPAPI_COMPACT_21_033: [ If the whole process succeed, the HTTPAPI_ExecuteRequest shall retur HTTPAPI_OK. ]*/
-                    result = HTTPAPI_OK;
-                }
-            }
-            else
-            {
-                /*Codes_SRS_HTTPAPI_COMPACT_21_051: [ If the responseContent is NULL, the HTTPAPI_ExecuteRequest shall ignore any content in the response. ]*/
-                if (skipN(http_instance, bodyLength) < 0)
-                {
-                    /*Codes_SRS_HTTPAPI_COMPACT_21_082: [ If the HTTPAPI_ExecuteRequest retries 20 seconds to receive the message without success, it shall fail and return HTTPAPI_READ_DATA_FAILED. ]*/
-                    result = HTTPAPI_READ_DATA_FAILED;
-                }
-                else
-                {
-                    result = HTTPAPI_OK;
-                }
-            }
-        }
-        else
-        {
-            /*Codes_SRS_HTTPAPI_COMPACT_21_033: [ If the whole process succeed, the HTTPAPI_ExecuteRequest shall retur HTTPAPI_OK. ]*/
-            result = HTTPAPI_OK;
-        }
+        /*Codes_SRS_HTTPAPI_COMPACT_21_052: [ If any memory allocation get fail, the HTTPAPI_ExecuteRequest shall return HTTPAPI_ALLOC_FAILED. ]*/
+        LogError("Cannot create the HTTP response parser");
+        result = HTTPAPI_ALLOC_FAILED;
     }
     else
     {
-        size_t size = 0;
-        /*Codes_SRS_HTTPAPI_COMPACT_21_033: [ If the whole process succeed, the HTTPAPI_ExecuteRequest shall retur HTTPAPI_OK. ]*/
+        /*Codes_SRS_HTTPAPI_COMPACT_21_081: [ The HTTPAPI_ExecuteRequest shall try to read the message with the response up to 20 seconds. ]*/
+        int countRetry = MAX_RECEIVE_RETRY;
+
+        http_instance->response_context = &response_context;
+
+        /* the response may have started arriving while the request was being sent */
+        if (http_instance->received_bytes_count > 0)
+        {
+            feed_response_parser(http_instance, http_instance->received_bytes, http_instance->received_bytes_count);
+            conn_receive_discard_buffer(http_instance);
+        }
+
         result = HTTPAPI_OK;
-        while (result == HTTPAPI_OK)
+        while ((result == HTTPAPI_OK) &&
+            (response_context.result == HTTPAPI_OK) &&
+            !http_response_parser_is_complete(http_instance->response_parser))
         {
-            size_t chunkSize;
-            if (readLine(http_instance, buf, sizeof(buf)) < 0)    // read [length in hex]/r/n
+            size_t bytesReceived = response_context.bytesReceived;
+
+            xio_dowork(http_instance->xio_handle);
+
+            /* if any error was detected while receiving then simply break and report it */
+            if (http_instance->is_io_error != 0)
             {
                 /*Codes_SRS_HTTPAPI_COMPACT_21_032: [ If the HTTPAPI_ExecuteRequest cannot read the message with the request result, it shall return HTTPAPI_READ_DATA_FAILED. ]*/
-                /*Codes_SRS_HTTPAPI_COMPACT_21_082: [ If the HTTPAPI_ExecuteRequest retries 20 seconds to receive the message without success, it shall fail and return HTTPAPI_READ_DATA_FAILED. ]*/
+                LogError("xio reported error on dowork");
                 result = HTTPAPI_READ_DATA_FAILED;
             }
-            else if (ParseStringToHexadecimal(buf, &chunkSize) != 1)     // chunkSize is length of next line (/r/n is not counted)
+            else if ((response_context.result == HTTPAPI_OK) &&
+                !http_response_parser_is_complete(http_instance->response_parser))
             {
-                //Cannot match string, error
-                /*Codes_SRS_HTTPAPI_COMPACT_21_055: [ If the HTTPAPI_ExecuteRequest cannot parser the recived message, it shall return HTTPAPI_RECEIVE_RESPONSE_FAILED. ]*/
-                result = HTTPAPI_RECEIVE_RESPONSE_FAILED;
-            }
-            else if (chunkSize == 0)
-            {
-                // 0 length means next line is just '\r\n' and end of chunks
-                if (readChunk(http_instance, (char*)buf, (size_t)2) < 0
-                    || buf[0] != '\r' || buf[1] != '\n') // skip /r/n
+                if (response_context.bytesReceived != bytesReceived)
                 {
-                    (void)BUFFER_unbuild(responseContent);
-
-                    result = HTTPAPI_READ_DATA_FAILED;
+                    countRetry = MAX_RECEIVE_RETRY;
                 }
-                break;
-            }
-            else
-            {
-                if (responseContent != NULL)
-                {
-                    if (BUFFER_enlarge(responseContent, chunkSize) != 0)
-                    {
-                        (void)BUFFER_unbuild(responseContent);
-
-                        /*Codes_SRS_HTTPAPI_COMPACT_21_052: [ If any memory allocation get fail, the HTTPAPI_ExecuteRequest shall return HTTPAPI_ALLOC_FAILED. ]*/
-                        result = HTTPAPI_ALLOC_FAILED;
-                    }
-                    else if (BUFFER_content(responseContent, &receivedContent) != 0)
-                    {
-                        (void)BUFFER_unbuild(responseContent);
 
-                        /*Codes_SRS_HTTPAPI_COMPACT_21_052: [ If any memory allocation get fail, the HTTPAPI_ExecuteRequest shall return HTTPAPI_ALLOC_FAILED. ]*/
-                        result = HTTPAPI_ALLOC_FAILED;
-                    }
-                    else if (readChunk(http_instance, (char*)receivedContent + size, chunkSize) < 0)
-                    {
-                        result = HTTPAPI_READ_DATA_FAILED;
-                    }
-                }
-                else
+                if ((countRetry--) > 0)
                 {
-                    /*Codes_SRS_HTTPAPI_COMPACT_21_051: [ If the responseContent is NULL, the HTTPAPI_ExecuteRequest shall ignore any content in the response. ]*/
-                    if (skipN(http_instance, chunkSize) < 0)
-                    {
-                        /*Codes_SRS_HTTPAPI_COMPACT_21_082: [ If the HTTPAPI_ExecuteRequest retries 20 seconds to receive the message without success, it shall fail and return HTTPAPI_READ_DATA_FAILED. ]*/
-                        result = HTTPAPI_READ_DATA_FAILED;
-                    }
+                    /*Codes_SRS_HTTPAPI_COMPACT_21_083: [ The HTTPAPI_ExecuteRequest shall wait, at least, 100 milliseconds between retries. ]*/
+                    ThreadAPI_Sleep(RETRY_INTERVAL_IN_MICROSECONDS);
                 }
-
-                if (result == HTTPAPI_OK)
+                else
                 {
-                    if (readChunk(http_instance, (char*)buf, (size_t)2) < 0
-                        || buf[0] != '\r' || buf[1] != '\n') // skip /r/n
-                    {
-                        result = HTTPAPI_READ_DATA_FAILED;
-                    }
-                    size += chunkSize;
+                    /*Codes_SRS_HTTPAPI_COMPACT_21_082: [ If the HTTPAPI_ExecuteRequest retries 20 seconds to receive the message without success, it shall fail and return HTTPAPI_READ_DATA_FAILED. ]*/
+                    LogError("Receive timeout. The HTTP request is incomplete");
+                    result = HTTPAPI_READ_DATA_FAILED;
                 }
             }
         }
 
+        if (result == HTTPAPI_OK)
+        {
+            result = response_context.result;
+        }
+
+        http_response_parser_destroy(http_instance->response_parser);
+        http_instance->response_parser = NULL;
+        http_instance->response_context = NULL;
     }
+
     return result;
 }
 
-
 /*Codes_SRS_HTTPAPI_COMPACT_21_037: [ If the request type is unknown, the HTTPAPI_ExecuteRequest shall return HTTPAPI_INVALID_ARG. ]*/
 static bool validRequestType(HTTPAPI_REQUEST_TYPE requestType)
 {
@@ -1175,8 +774,6 @@ HTTPAPI_RESULT HTTPAPI_ExecuteRequest(HTTP_HANDLE handle, HTTPAPI_REQUEST_TYPE r
 {
     HTTPAPI_RESULT result = HTTPAPI_ERROR;
     size_t  headersCount;
-    size_t  bodyLength = 0;
-    bool    chunked = false;
     HTTP_HANDLE_DATA* http_instance = (HTTP_HANDLE_DATA*)handle;
 
     /*Codes_SRS_HTTPAPI_COMPACT_21_034: [ If there is no previous connection, the HTTPAPI_ExecuteRequest shall return HTTPAPI_INVALID_ARG. ]*/
@@ -1212,24 +809,15 @@ HTTPAPI_RESULT HTTPAPI_ExecuteRequest(HTTP_HANDLE handle, HTTPAPI_REQUEST_TYPE r
     }
     /*Codes_SRS_HTTPAPI_COMPACT_21_030: [ At the end of the transmission, the HTTPAPI_ExecuteRequest shall receive the response from the host. ]*/
     /*Codes_SRS_HTTPAPI_COMPACT_21_073: [ The message recived by the HTTPAPI_ExecuteRequest shall starts with a valid header. ]*/
-    else if ((result = RecieveHeaderFromXIO(http_instance, statusCode)) != HTTPAPI_OK)
-    {
-        LogError("Receive header from HTTP failed (result = %s)", ENUM_TO_STRING(HTTPAPI_RESULT, result));
-    }
     /*Codes_SRS_HTTPAPI_COMPACT_21_074: [ After the header, the message recieved by the HTTPAPI_ExecuteRequest can contain addition information about the content. ]*/
-    else if ((result = RecieveContentInfoFromXIO(http_instance, responseHeadersHandle, &bodyLength, &chunked)) != HTTPAPI_OK)
-    {
-        LogError("Receive content information from HTTP failed (result = %s)", ENUM_TO_STRING(HTTPAPI_RESULT, result));
-    }
     /*Codes_SRS_HTTPAPI_COMPACT_21_075: [ The message recieved by the HTTPAPI_ExecuteRequest can contain a body with the message content. ]*/
-    else if ((result = ReadHTTPResponseBodyFromXIO(http_instance, bodyLength, chunked, responseContent)) != HTTPAPI_OK)
+    else if ((result = ReceiveResponseFromXIO(http_instance, statusCode, responseHeadersHandle, responseContent)) != HTTPAPI_OK)
     {
-        LogError("Read HTTP response body from HTTP failed (result = %s)", ENUM_TO_STRING(HTTPAPI_RESULT, result));
+        LogError("Receive response from HTTP failed (result = %s)", ENUM_TO_STRING(HTTPAPI_RESULT, result));
     }
 
     conn_receive_discard_buffer(http_instance);
 
-
     return result;
 }
 
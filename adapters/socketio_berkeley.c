@@ -22,6 +22,7 @@
 #include <errno.h>
 #include "azure_c_shared_utility/singlylinkedlist.h"
 #include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/slaballoc.h"
 #include "azure_c_shared_utility/optimize_size.h"
 #include "azure_c_shared_utility/xlogging.h"
 
@@ -117,7 +118,7 @@ static void indicate_error(SOCKET_IO_INSTANCE* socket_io_instance)
 static int add_pending_io(SOCKET_IO_INSTANCE* socket_io_instance, const unsigned char* buffer, size_t size, ON_SEND_COMPLETE on_send_complete, void* callback_context)
 {
     int result;
-    PENDING_SOCKET_IO* pending_socket_io = (PENDING_SOCKET_IO*)malloc(sizeof(PENDING_SOCKET_IO));
+    PENDING_SOCKET_IO* pending_socket_io = (PENDING_SOCKET_IO*)SLABALLOC_MALLOC(sizeof(PENDING_SOCKET_IO));
     if (pending_socket_io == NULL)
     {
         result = __FAILURE__;
@@ -128,7 +129,7 @@ static int add_pending_io(SOCKET_IO_INSTANCE* socket_io_instance, const unsigned
         if (pending_socket_io->bytes == NULL)
         {
             LogError("Allocation Failure: Unable to allocate pending list.");
-            free(pending_socket_io);
+            SLABALLOC_FREE(pending_socket_io);
             result = __FAILURE__;
         }
         else
@@ -143,7 +144,7 @@ static int add_pending_io(SOCKET_IO_INSTANCE* socket_io_instance, const unsigned
             {
                 LogError("Failure: Unable to add socket to pending list.");
                 free(pending_socket_io->bytes);
-                free(pending_socket_io);
+                SLABALLOC_FREE(pending_socket_io);
                 result = __FAILURE__;
             }
             else
@@ -247,7 +248,7 @@ void socketio_destroy(CONCRETE_IO_HANDLE socket_io)
             if (pending_socket_io != NULL)
             {
                 free(pending_socket_io->bytes);
-                free(pending_socket_io);
+                SLABALLOC_FREE(pending_socket_io);
             }
 
             (void)singlylinkedlist_remove(socket_io_instance->pending_io_list, first_pending_io);
@@ -569,7 +570,7 @@ void socketio_dowork(CONCRETE_IO_HANDLE socket_io)
                         else
                         {
                             free(pending_socket_io->bytes);
-                            free(pending_socket_io);
+                            SLABALLOC_FREE(pending_socket_io);
                             (void)singlylinkedlist_remove(socket_io_instance->pending_io_list, first_pending_io);
 
                             LogError("Failure: sending Socket information. errno=%d (%s).", errno, strerror(errno));
@@ -593,7 +594,7 @@ void socketio_dowork(CONCRETE_IO_HANDLE socket_io)
                     }
 
                     free(pending_socket_io->bytes);
-                    free(pending_socket_io);
+                    SLABALLOC_FREE(pending_socket_io);
                     if (singlylinkedlist_remove(socket_io_instance->pending_io_list, first_pending_io) != 0)
                     {
                         socket_io_instance->io_state = IO_STATE_ERROR;
@@ -18,6 +18,7 @@
 #include <pthread.h>
 #include <time.h>
 #include "azure_c_shared_utility/xlogging.h"
+#include "azure_c_shared_utility/slaballoc.h"
 
 DEFINE_ENUM_STRINGS(THREADAPI_RESULT, THREADAPI_RESULT_VALUES);
 
@@ -32,6 +33,8 @@ static void* ThreadWrapper(void* threadInstanceArg)
 {
     THREAD_INSTANCE* threadInstance = (THREAD_INSTANCE*)threadInstanceArg;
     int result = threadInstance->ThreadStartFunc(threadInstance->Arg);
+    /* the blocks cached by this thread would otherwise not be reused until slaballoc_deinit */
+    slaballoc_release_thread_cache();
     return (void*)(intptr_t)result;
 }
 
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C"
+{
+#else
+#include <stddef.h>
+#endif
+
+/* An arena hands out memory by bumping a pointer through blocks obtained from malloc and releases all of it at once with
+ARENA_reset or ARENA_destroy. It is meant for the many short lived allocations that make up a single operation (an HTTP
+request with its temporary headers and buffers): objects created in an arena need no individual free and ARENA_reset keeps
+the memory for the next operation. An arena is not thread-safe. */
+typedef struct ARENA_TAG* ARENA_HANDLE;
+
+/* creation */
+MOCKABLE_FUNCTION(, ARENA_HANDLE, ARENA_create, size_t, block_size);
+MOCKABLE_FUNCTION(, void, ARENA_destroy, ARENA_HANDLE, arena);
+
+/* allocation */
+MOCKABLE_FUNCTION(, void*, ARENA_malloc, ARENA_HANDLE, arena, size_t, size);
+MOCKABLE_FUNCTION(, void*, ARENA_realloc, ARENA_HANDLE, arena, void*, ptr, size_t, size);
+MOCKABLE_FUNCTION(, void, ARENA_free, ARENA_HANDLE, arena, void*, ptr);
+MOCKABLE_FUNCTION(, char*, ARENA_strdup, ARENA_HANDLE, arena, const char*, source);
+
+/* release */
+MOCKABLE_FUNCTION(, void, ARENA_reset, ARENA_HANDLE, arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARENA_H */
@@ -21,6 +21,9 @@ extern "C" {
 
 #include "azure_c_shared_utility/umock_c_prod.h"
 
+typedef struct BASE64_ENCODE_CONTEXT_TAG* BASE64_ENCODE_CONTEXT_HANDLE;
+typedef struct BASE64_DECODE_CONTEXT_TAG* BASE64_DECODE_CONTEXT_HANDLE;
+
 
 /**
  * @brief	Base64 encodes a buffer and returns the resulting string.
@@ -59,6 +62,22 @@ MOCKABLE_FUNCTION(, STRING_HANDLE, Base64_Encoder, BUFFER_HANDLE, input);
  */
 MOCKABLE_FUNCTION(, STRING_HANDLE, Base64_Encode_Bytes, const unsigned char*, source, size_t, size);
 
+/**
+ * @brief	Base64 encodes the buffer pointed to by @p source into a caller provided buffer.
+ *
+ * @param	source         	The buffer that needs to be base64 encoded.
+ * @param	size           	The size of @p source.
+ * @param	destination    	The buffer receiving the null terminated encoding, or @c NULL to only query its length.
+ * @param	destinationSize	The size of @p destination, which has to be larger than the encoded length.
+ * @param	encodedLength  	Receives the length of the encoding, not including the null terminator.
+ *
+ * 			No memory is allocated. @p encodedLength is set even when @p destination is too small,
+ * 			so the function can be called once with a @c NULL @p destination to size the buffer.
+ *
+ * @return	@c 0 if the encoding was written to @p destination, a non-zero value otherwise.
+ */
+MOCKABLE_FUNCTION(, int, Base64_Encode_Into, const unsigned char*, source, size_t, size, char*, destination, size_t, destinationSize, size_t*, encodedLength);
+
 /**
  * @brief	Base64 decodes the buffer pointed to by @p source and returns the resulting buffer.
  *
@@ -76,6 +95,93 @@ MOCKABLE_FUNCTION(, STRING_HANDLE, Base64_Encode_Bytes, const unsigned char*, so
  */
 MOCKABLE_FUNCTION(, BUFFER_HANDLE, Base64_Decoder, const char*, source);
 
+/**
+ * @brief	Base64 decodes @p sourceLength characters from @p source into a caller provided buffer.
+ *
+ * @param	source         	The base64 encoded characters, which do not need to be null terminated.
+ * @param	sourceLength   	The number of characters in @p source, a multiple of 4.
+ * @param	destination    	The buffer receiving the decoded bytes, or @c NULL to only query their count.
+ * @param	destinationSize	The size of @p destination.
+ * @param	decodedLength  	Receives the number of decoded bytes.
+ *
+ * 			No memory is allocated. Unlike @c Base64_Decoder, any character outside of the base64
+ * 			alphabet, other than 1 or 2 '=' padding characters at the end, makes the decoding fail.
+ * 			@p decodedLength is set from the length and padding of @p source even when @p destination
+ * 			is too small.
+ *
+ * @return	@c 0 if the decoded bytes were written to @p destination, a non-zero value otherwise.
+ */
+MOCKABLE_FUNCTION(, int, Base64_Decode_Into, const char*, source, size_t, sourceLength, unsigned char*, destination, size_t, destinationSize, size_t*, decodedLength);
+
+/**
+ * @brief	Creates a context for base64 encoding a stream of bytes that arrives in chunks.
+ *
+ * 			Each call to @c Base64_Encode_Update encodes the complete groups of 3 bytes it has
+ * 			and keeps the 1 or 2 remaining bytes for the next call. @c Base64_Encode_Final writes
+ * 			the padded encoding of the kept bytes. The concatenation of everything written is the
+ * 			same as @c Base64_Encode_Bytes over the whole stream. Nothing is null terminated.
+ *
+ * @return	A context to be freed with @c Base64_Encode_DestroyContext, or @c NULL on failure.
+ */
+MOCKABLE_FUNCTION(, BASE64_ENCODE_CONTEXT_HANDLE, Base64_Encode_Init);
+
+/**
+ * @brief	Encodes the next @p size bytes of the stream.
+ *
+ * 			@p encodedLength receives the number of characters written, which is never more
+ * 			than ((@p size + 2) / 3) * 4. It is also set when @p destination is @c NULL or too
+ * 			small, in which case nothing is consumed and a non-zero value is returned.
+ *
+ * @return	@c 0 on success, a non-zero value otherwise.
+ */
+MOCKABLE_FUNCTION(, int, Base64_Encode_Update, BASE64_ENCODE_CONTEXT_HANDLE, context, const unsigned char*, source, size_t, size, char*, destination, size_t, destinationSize, size_t*, encodedLength);
+
+/**
+ * @brief	Writes the last, padded, group of the stream (0 or 4 characters) to @p destination.
+ *
+ * @return	@c 0 on success, a non-zero value otherwise.
+ */
+MOCKABLE_FUNCTION(, int, Base64_Encode_Final, BASE64_ENCODE_CONTEXT_HANDLE, context, char*, destination, size_t, destinationSize, size_t*, encodedLength);
+
+/**
+ * @brief	Frees a context created by @c Base64_Encode_Init.
+ */
+MOCKABLE_FUNCTION(, void, Base64_Encode_DestroyContext, BASE64_ENCODE_CONTEXT_HANDLE, context);
+
+/**
+ * @brief	Creates a context for decoding a stream of base64 characters that arrives in chunks.
+ *
+ * 			Chunks may split the groups of 4 characters anywhere. Line breaks ('\r' and '\n'), as
+ * 			found in PEM and MIME payloads, are skipped. Any other character outside of the
+ * 			alphabet, or after the padding, makes the stream invalid.
+ *
+ * @return	A context to be freed with @c Base64_Decode_DestroyContext, or @c NULL on failure.
+ */
+MOCKABLE_FUNCTION(, BASE64_DECODE_CONTEXT_HANDLE, Base64_Decode_Init);
+
+/**
+ * @brief	Decodes the next @p sourceLength characters of the stream.
+ *
+ * 			@p destination has to hold at least ((@p sourceLength + 3) / 4) * 3 bytes.
+ * 			@p decodedLength receives the number of bytes written.
+ *
+ * @return	@c 0 on success, a non-zero value otherwise. After a failure the context only accepts
+ * 			@c Base64_Decode_DestroyContext.
+ */
+MOCKABLE_FUNCTION(, int, Base64_Decode_Update, BASE64_DECODE_CONTEXT_HANDLE, context, const char*, source, size_t, sourceLength, unsigned char*, destination, size_t, destinationSize, size_t*, decodedLength);
+
+/**
+ * @brief	Checks that the stream ended on a complete group.
+ *
+ * @return	@c 0 if the stream was valid base64, a non-zero value otherwise.
+ */
+MOCKABLE_FUNCTION(, int, Base64_Decode_Final, BASE64_DECODE_CONTEXT_HANDLE, context);
+
+/**
+ * @brief	Frees a context created by @c Base64_Decode_Init.
+ */
+MOCKABLE_FUNCTION(, void, Base64_Decode_DestroyContext, BASE64_DECODE_CONTEXT_HANDLE, context);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6,17 +6,22 @@
 
 #ifdef __cplusplus
 #include <cstddef>
+#include <cstdbool>
 extern "C"
 {
 #else
 #include <stddef.h>
+#include <stdbool.h>
 #endif
 
+#include "azure_c_shared_utility/arena.h"
 #include "azure_c_shared_utility/umock_c_prod.h"
 
 typedef struct BUFFER_TAG* BUFFER_HANDLE;
 
 MOCKABLE_FUNCTION(, BUFFER_HANDLE, BUFFER_new);
+/*a buffer whose handle and memory come from arena: BUFFER_delete gives nothing back to the heap, the arena reclaims it when it is reset*/
+MOCKABLE_FUNCTION(, BUFFER_HANDLE, BUFFER_new_in_arena, ARENA_HANDLE, arena);
 MOCKABLE_FUNCTION(, BUFFER_HANDLE, BUFFER_create, const unsigned char*, source, size_t, size);
 MOCKABLE_FUNCTION(, void, BUFFER_delete, BUFFER_HANDLE, handle);
 MOCKABLE_FUNCTION(, int, BUFFER_pre_build, BUFFER_HANDLE, handle, size_t, size);
@@ -30,6 +35,11 @@ MOCKABLE_FUNCTION(, int, BUFFER_prepend, BUFFER_HANDLE, handle1, BUFFER_HANDLE,
 MOCKABLE_FUNCTION(, unsigned char*, BUFFER_u_char, BUFFER_HANDLE, handle);
 MOCKABLE_FUNCTION(, size_t, BUFFER_length, BUFFER_HANDLE, handle);
 MOCKABLE_FUNCTION(, BUFFER_HANDLE, BUFFER_clone, BUFFER_HANDLE, handle);
+MOCKABLE_FUNCTION(, BUFFER_HANDLE, BUFFER_create_with_moved_memory, unsigned char*, buffer, size_t, size);
+MOCKABLE_FUNCTION(, int, BUFFER_transfer, BUFFER_HANDLE, handle, unsigned char**, buffer, size_t*, size);
+MOCKABLE_FUNCTION(, int, BUFFER_reserve, BUFFER_HANDLE, handle, size_t, capacity);
+MOCKABLE_FUNCTION(, int, BUFFER_reserve_front, BUFFER_HANDLE, handle, size_t, headroom);
+MOCKABLE_FUNCTION(, int, BUFFER_shrink, BUFFER_HANDLE, handle, size_t, decreaseSize, bool, fromEnd);
 
 #ifdef __cplusplus
 }
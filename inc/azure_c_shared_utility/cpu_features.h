@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*the instruction set extensions modules with vector or hardware kernels pick them by*/
+#define CPU_FEATURE_X86_SSSE3   0x01
+#define CPU_FEATURE_X86_SSE41   0x02
+/*only reported when the OS also saves the YMM registers*/
+#define CPU_FEATURE_X86_AVX2    0x04
+#define CPU_FEATURE_X86_SHA     0x08
+#define CPU_FEATURE_ARM_SHA1    0x10
+#define CPU_FEATURE_ARM_SHA2    0x20
+
+/*returns the CPU_FEATURE_ bits of the processor, probed by the first call and published to all threads from then on*/
+extern int cpu_features_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CPU_FEATURES_H */
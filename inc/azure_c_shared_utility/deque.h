@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C"
+{
+#else
+#include <stddef.h>
+#endif
+
+typedef struct DEQUE_TAG* DEQUE_HANDLE;
+
+/* creation */
+MOCKABLE_FUNCTION(, DEQUE_HANDLE, DEQUE_create, size_t, elementSize);
+MOCKABLE_FUNCTION(, void, DEQUE_destroy, DEQUE_HANDLE, handle);
+
+/* insertion */
+MOCKABLE_FUNCTION(, int, DEQUE_push_back, DEQUE_HANDLE, handle, const void*, element);
+MOCKABLE_FUNCTION(, int, DEQUE_push_front, DEQUE_HANDLE, handle, const void*, element);
+
+/* removal */
+MOCKABLE_FUNCTION(, void, DEQUE_pop_front, DEQUE_HANDLE, handle);
+MOCKABLE_FUNCTION(, void, DEQUE_pop_back, DEQUE_HANDLE, handle);
+
+/* access */
+MOCKABLE_FUNCTION(, void*, DEQUE_element, DEQUE_HANDLE, handle, size_t, index);
+MOCKABLE_FUNCTION(, void*, DEQUE_front, DEQUE_HANDLE, handle);
+MOCKABLE_FUNCTION(, void*, DEQUE_back, DEQUE_HANDLE, handle);
+
+/* capacity */
+MOCKABLE_FUNCTION(, size_t, DEQUE_size, DEQUE_HANDLE, handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEQUE_H */
@@ -19,8 +19,25 @@ extern "C" {
 
 DEFINE_ENUM(HMACSHA256_RESULT, HMACSHA256_RESULT_VALUES)
 
+typedef struct HMACSHA256_KEY_TAG* HMACSHA256_KEY_HANDLE;
+typedef struct HMACSHA256_CONTEXT_TAG* HMACSHA256_CONTEXT_HANDLE;
+
+/* every function below that outputs an HMAC appends its 32 bytes to the content of hash, the buffer has to be empty to receive the HMAC alone */
 MOCKABLE_FUNCTION(, HMACSHA256_RESULT, HMACSHA256_ComputeHash, const unsigned char*, key, size_t, keyLen, const unsigned char*, payload, size_t, payloadLen, BUFFER_HANDLE, hash);
 
+/* a key object holds the SHA256 states after the padded key has been hashed, so it can be reused for many messages */
+MOCKABLE_FUNCTION(, HMACSHA256_KEY_HANDLE, HMACSHA256_CreateKey, const unsigned char*, key, size_t, keyLen);
+MOCKABLE_FUNCTION(, void, HMACSHA256_DestroyKey, HMACSHA256_KEY_HANDLE, hmacKey);
+MOCKABLE_FUNCTION(, HMACSHA256_RESULT, HMACSHA256_ComputeHashWithKey, HMACSHA256_KEY_HANDLE, hmacKey, const unsigned char*, payload, size_t, payloadLen, BUFFER_HANDLE, hash);
+/* computes the HMAC of count payloads with the same key, several payloads at once when the processor supports it */
+MOCKABLE_FUNCTION(, HMACSHA256_RESULT, HMACSHA256_ComputeHashBatch, HMACSHA256_KEY_HANDLE, hmacKey, const unsigned char* const*, payloads, const size_t*, payloadLens, size_t, count, BUFFER_HANDLE*, hashes);
+
+/* streaming API for payloads that arrive in pieces */
+MOCKABLE_FUNCTION(, HMACSHA256_CONTEXT_HANDLE, HMACSHA256_Init, HMACSHA256_KEY_HANDLE, hmacKey);
+MOCKABLE_FUNCTION(, HMACSHA256_RESULT, HMACSHA256_Update, HMACSHA256_CONTEXT_HANDLE, hmacContext, const unsigned char*, payload, size_t, payloadLen);
+MOCKABLE_FUNCTION(, HMACSHA256_RESULT, HMACSHA256_Final, HMACSHA256_CONTEXT_HANDLE, hmacContext, BUFFER_HANDLE, hash);
+MOCKABLE_FUNCTION(, void, HMACSHA256_DestroyContext, HMACSHA256_CONTEXT_HANDLE, hmacContext);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,41 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef HTTP_RESPONSE_PARSER_H
+#define HTTP_RESPONSE_PARSER_H
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdbool>
+extern "C" {
+#else
+#include <stddef.h>
+#include <stdbool.h>
+#endif /* __cplusplus */
+
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+typedef struct HTTP_RESPONSE_PARSER_INSTANCE_TAG* HTTP_RESPONSE_PARSER_HANDLE;
+
+/* All the pointers handed to the callbacks below are only valid for the duration of the callback.
+   They point either into the buffer passed to http_response_parser_parse or into the parser's own line buffer,
+   and they are not zero terminated. */
+typedef void(*ON_HTTP_RESPONSE_STATUS)(void* context, int status_code, const char* reason_phrase, size_t reason_phrase_length);
+typedef void(*ON_HTTP_RESPONSE_HEADER)(void* context, const char* name, size_t name_length, const char* value, size_t value_length);
+typedef void(*ON_HTTP_RESPONSE_HEADERS_COMPLETE)(void* context, bool is_chunked, size_t content_length);
+typedef void(*ON_HTTP_RESPONSE_BODY)(void* context, const unsigned char* body_bytes, size_t length);
+typedef void(*ON_HTTP_RESPONSE_COMPLETE)(void* context);
+
+MOCKABLE_FUNCTION(, HTTP_RESPONSE_PARSER_HANDLE, http_response_parser_create, ON_HTTP_RESPONSE_STATUS, on_status, ON_HTTP_RESPONSE_HEADER, on_header, ON_HTTP_RESPONSE_HEADERS_COMPLETE, on_headers_complete, ON_HTTP_RESPONSE_BODY, on_body, ON_HTTP_RESPONSE_COMPLETE, on_complete, void*, callback_context);
+MOCKABLE_FUNCTION(, void, http_response_parser_destroy, HTTP_RESPONSE_PARSER_HANDLE, http_response_parser);
+MOCKABLE_FUNCTION(, int, http_response_parser_parse, HTTP_RESPONSE_PARSER_HANDLE, http_response_parser, const unsigned char*, buffer, size_t, size, size_t*, bytes_consumed);
+MOCKABLE_FUNCTION(, bool, http_response_parser_is_complete, HTTP_RESPONSE_PARSER_HANDLE, http_response_parser);
+MOCKABLE_FUNCTION(, void, http_response_parser_reset, HTTP_RESPONSE_PARSER_HANDLE, http_response_parser);
+/* The responses parsed from now on answer a CONNECT request: a 2xx one ends with its headers, whatever Content-Length or Transfer-Encoding say (RFC 7230 3.3.3), since the bytes after it belong to the tunnel */
+MOCKABLE_FUNCTION(, void, http_response_parser_set_connect_response, HTTP_RESPONSE_PARSER_HANDLE, http_response_parser);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* HTTP_RESPONSE_PARSER_H */
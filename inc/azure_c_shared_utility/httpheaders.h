@@ -21,6 +21,7 @@
 #define HTTPHEADERS_H
 
 #include "azure_c_shared_utility/macro_utils.h"
+#include "azure_c_shared_utility/arena.h"
 #include "azure_c_shared_utility/umock_c_prod.h"
 
 #ifdef __cplusplus
@@ -54,6 +55,20 @@ typedef struct HTTP_HEADERS_HANDLE_DATA_TAG* HTTP_HEADERS_HANDLE;
  */
 MOCKABLE_FUNCTION(, HTTP_HEADERS_HANDLE, HTTPHeaders_Alloc);
 
+/**
+ * @brief	Produces an empty @c HTTP_HEADERS_HANDLE whose memory, headers included,
+ *			comes from @p arena.
+ *
+ *			::HTTPHeaders_Free gives nothing back to the heap for such a handle, the
+ *			memory is reclaimed when the arena is reset. ::HTTPHeaders_Clone and
+ *			::HTTPHeaders_GetHeader still allocate from the heap.
+ *
+ * @param	arena	The arena to allocate from.
+ *
+ * @return	A HTTP_HEADERS_HANDLE or @c NULL in case an error occurs.
+ */
+MOCKABLE_FUNCTION(, HTTP_HEADERS_HANDLE, HTTPHeaders_AllocInArena, ARENA_HANDLE, arena);
+
 /**
  * @brief	De-allocates the data structures allocated by previous API calls to the same handle.
  *
@@ -75,7 +90,8 @@ MOCKABLE_FUNCTION(, void, HTTPHeaders_Free, HTTP_HEADERS_HANDLE, httpHeadersHand
  *			that is @c strcmp equal to @c name+": "+value. If the name already exists
  *			in the collection of headers, the function concatenates the new value
  *			after the existing value, separated by a comma and a space as in:
- *			<code>old-value+", "+new-value</code>.
+ *			<code>old-value+", "+new-value</code>. Names are compared regardless
+ *			of case and an existing header keeps the name it was first added with.
  * 
  * @return	Returns @c HTTP_HEADERS_OK when execution is successful or an error code from
  * 			the ::HTTPAPIEX_RESULT enum.
@@ -102,7 +118,10 @@ MOCKABLE_FUNCTION(, HTTP_HEADERS_RESULT, HTTPHeaders_ReplaceHeaderNameValuePair,
  * @brief	Retrieves the value for a previously stored name.
  *
  * @param	httpHeadersHandle	A valid @c HTTP_HEADERS_HANDLE value.
- * @param	name			 	The name of the HTTP header to find.
+ * @param	name			 	The name of the HTTP header to find, in any case.
+ *
+ *			The header is found through a hash of the lower case name, without
+ *			comparing @p name with every stored name.
  *
  * @return	The return value points to a string that shall be @c strcmp equal
  * 			to the original stored string.
@@ -138,6 +157,28 @@ MOCKABLE_FUNCTION(, HTTP_HEADERS_RESULT, HTTPHeaders_GetHeaderCount, HTTP_HEADER
  */
 MOCKABLE_FUNCTION(, HTTP_HEADERS_RESULT, HTTPHeaders_GetHeader, HTTP_HEADERS_HANDLE, handle, size_t, index, char**, destination);
 
+/**
+ * @brief	This API writes the string name+": "+value for the header element at
+ * 			the given @p index into a caller provided buffer.
+ *
+ * @param	handle			A valid @c HTTP_HEADERS_HANDLE value.
+ * @param	index			Zero-based index of the item in the headers collection.
+ * @param	destination		The buffer receiving the null terminated header, or @c NULL
+ * 							to only query its length.
+ * @param	destinationSize	The size of @p destination, which has to be larger than the
+ * 							length of the header.
+ * @param	headerLength	Receives the length of the header, not including the null
+ * 							terminator.
+ *
+ *			No memory is allocated. @p headerLength is set even when @p destination is
+ *			too small, so that the caller can size a buffer for the header.
+ *
+ * @return	Returns @c HTTP_HEADERS_OK when the header was written to @p destination,
+ * 			@c HTTP_HEADERS_INSUFFICIENT_BUFFER when @p destination is too small or
+ * 			another error code when an error occurs.
+ */
+MOCKABLE_FUNCTION(, HTTP_HEADERS_RESULT, HTTPHeaders_GetHeaderInto, HTTP_HEADERS_HANDLE, handle, size_t, index, char*, destination, size_t, destinationSize, size_t*, headerLength);
+
 /**
  * @brief	This API produces a clone of the @p handle parameter.
  *
@@ -145,6 +186,13 @@ MOCKABLE_FUNCTION(, HTTP_HEADERS_RESULT, HTTPHeaders_GetHeader, HTTP_HEADERS_HAN
  *
  *			If @p handle is not @c NULL this function clones the content
  *			of the handle to a new handle and returns it.
+ *
+ *			The clone shares the headers of @p handle until either of them
+ *			adds or replaces a header, which first gives it a copy of its own.
+ *			Cloning a set of headers that is used as a template for many
+ *			requests is therefore a single small allocation. Since the first
+ *			clone of a handle records that its headers are shared, a handle
+ *			shall not be cloned from several threads at once.
  *			
  * @return	A @c HTTP_HEADERS_HANDLE containing a cloned copy of the
  * 			contents of @p handle.
@@ -12,6 +12,7 @@
 #include "azure_c_shared_utility/macro_utils.h"
 #include "azure_c_shared_utility/strings.h"
 #include "azure_c_shared_utility/crt_abstractions.h"
+#include "azure_c_shared_utility/arena.h"
 #include "azure_c_shared_utility/umock_c_prod.h"
 
 #ifdef __cplusplus
@@ -55,6 +56,19 @@ typedef int (*MAP_FILTER_CALLBACK)(const char* mapProperty, const char* mapValue
  */
 MOCKABLE_FUNCTION(, MAP_HANDLE, Map_Create, MAP_FILTER_CALLBACK, mapFilterFunc);
 
+/**
+ * @brief   Creates a new, empty map whose memory, keys and values included,
+ *          comes from @p arena.
+ *
+ * @param   arena           The arena the map allocates from. Destroying the map
+ *                          gives nothing back to the heap, the memory is
+ *                          reclaimed when the arena is reset.
+ * @param   mapFilterFunc   The same callback as for ::Map_Create.
+ *
+ * @return  A valid @c MAP_HANDLE or @c NULL in case an error occurs.
+ */
+MOCKABLE_FUNCTION(, MAP_HANDLE, Map_CreateInArena, ARENA_HANDLE, arena, MAP_FILTER_CALLBACK, mapFilterFunc);
+
 /**
  * @brief   Release all resources associated with the map.
  *
@@ -5,6 +5,7 @@
 #define OPTIONHANDLER_H
 
 #include "azure_c_shared_utility/macro_utils.h"
+#include "azure_c_shared_utility/shared_util_option_ids.h"
 
 #define OPTIONHANDLER_RESULT_VALUES \
 OPTIONHANDLER_OK, \
@@ -35,11 +36,24 @@ typedef void (*pfDestroyOption)(const char* name, const void* value);
 /*returns 0 if _SetOption succeeded, any other value is error, if the option is not intended for that module, returns 0*/
 typedef int (*pfSetOption)(void* handle, const char* name, const void* value);
 
+/*the following function pointer points to a function that sets an option for a module given the interned id of its name*/
+/*id is OPTION_ID_UNKNOWN for names that are not in shared_util_options.h, name is always passed*/
+/*to be implemented by modules that dispatch their options on OPTION_ID*/
+typedef int (*pfSetOptionById)(void* handle, OPTION_ID id, const char* name, const void* value);
+
+/*the following function pointers point to functions that clone and free an option given the interned id of its name*/
+/*same contract as pfCloneOption and pfDestroyOption, id is OPTION_ID_UNKNOWN for names that are not in shared_util_options.h*/
+/*to be implemented by modules that dispatch their options on OPTION_ID*/
+typedef void* (*pfCloneOptionById)(OPTION_ID id, const char* name, const void* value);
+typedef void (*pfDestroyOptionById)(OPTION_ID id, const char* name, const void* value);
+
 MOCKABLE_FUNCTION(, OPTIONHANDLER_HANDLE, OptionHandler_Create, pfCloneOption, cloneOption, pfDestroyOption, destroyOption, pfSetOption, setOption);
+MOCKABLE_FUNCTION(, OPTIONHANDLER_HANDLE, OptionHandler_CreateWithOptionIds, pfCloneOptionById, cloneOptionById, pfDestroyOptionById, destroyOptionById, pfSetOptionById, setOptionById);
 MOCKABLE_FUNCTION(, OPTIONHANDLER_HANDLE, OptionHandler_Clone, OPTIONHANDLER_HANDLE, handler);
 MOCKABLE_FUNCTION(, OPTIONHANDLER_RESULT, OptionHandler_AddOption, OPTIONHANDLER_HANDLE, handle, const char*, name, const void*, value);
 MOCKABLE_FUNCTION(, OPTIONHANDLER_RESULT, OptionHandler_FeedOptions, OPTIONHANDLER_HANDLE, handle, void*, destinationHandle);
 MOCKABLE_FUNCTION(, void, OptionHandler_Destroy, OPTIONHANDLER_HANDLE, handle);
+MOCKABLE_FUNCTION(, OPTION_ID, OptionHandler_GetOptionId, const char*, name);
 
 #ifdef __cplusplus
 }
@@ -5,6 +5,7 @@
 #define SASTOKEN_H
 
 #include "azure_c_shared_utility/strings.h"
+#include "azure_c_shared_utility/buffer_.h"
 #include <stdbool.h>
 #include "azure_c_shared_utility/umock_c_prod.h"
 
@@ -12,9 +13,20 @@
 extern "C" {
 #endif
 
+    typedef struct SAS_TOKEN_REQUEST_TAG
+    {
+        const char* key;
+        const char* scope;
+        const char* keyName;
+        size_t expiry;
+    } SAS_TOKEN_REQUEST;
+
     MOCKABLE_FUNCTION(, bool, SASToken_Validate, STRING_HANDLE, sasToken);
     MOCKABLE_FUNCTION(, STRING_HANDLE, SASToken_Create, STRING_HANDLE, key, STRING_HANDLE, scope, STRING_HANDLE, keyName, size_t, expiry);
     MOCKABLE_FUNCTION(, STRING_HANDLE, SASToken_CreateString, const char*, key, const char*, scope, const char*, keyName, size_t, expiry);
+    MOCKABLE_FUNCTION(, STRING_HANDLE, SASToken_CreateWithDecodedKey, BUFFER_HANDLE, decodedKey, const char*, scope, const char*, keyName, size_t, expiry);
+    MOCKABLE_FUNCTION(, int, SASToken_CreateInto, BUFFER_HANDLE, decodedKey, const char*, scope, const char*, keyName, size_t, expiry, char*, destination, size_t, destinationSize, size_t*, tokenLength);
+    MOCKABLE_FUNCTION(, int, SASToken_CreateBatch, const SAS_TOKEN_REQUEST*, requests, size_t, requestCount, STRING_HANDLE*, tokens);
 
 #ifdef __cplusplus
 }
@@ -29,5 +29,28 @@
 
 #define SHA_Parity(x, y, z)  ((x) ^ (y) ^ (z))
 
+/*
+* A block function hashes block_count consecutive 64 byte message
+* blocks into Intermediate_Hash. The hardware block functions
+* (sha-hw.c) use the processor's SHA instructions and are NULL when
+* the processor does not have them.
+*/
+typedef void(*SHA_PROCESS_BLOCKS)(uint32_t *Intermediate_Hash,
+    const uint8_t *blocks, unsigned int block_count);
+
+extern SHA_PROCESS_BLOCKS SHA1HardwareProcessBlocks(void);
+extern SHA_PROCESS_BLOCKS SHA256HardwareProcessBlocks(void);
+
+/*
+* A multi-buffer block function hashes one 64 byte block into each
+* of SHA256MultiBufferLanes independent intermediate hashes at once.
+* It is NULL when the processor cannot run it (no AVX2).
+*/
+typedef void(*SHA_PROCESS_BLOCKS_MULTI)(
+    uint32_t *Intermediate_Hashes[SHA256MultiBufferLanes],
+    const uint8_t *blocks[SHA256MultiBufferLanes]);
+
+extern SHA_PROCESS_BLOCKS_MULTI SHA256HardwareProcessBlocksMulti(void);
+
 #endif /* _SHA_PRIVATE__H */
 
@@ -74,7 +74,10 @@ enum {
 
     SHA1HashSizeBits = 160, SHA224HashSizeBits = 224,
     SHA256HashSizeBits = 256, SHA384HashSizeBits = 384,
-    SHA512HashSizeBits = 512, USHAMaxHashSizeBits = SHA512HashSizeBits
+    SHA512HashSizeBits = 512, USHAMaxHashSizeBits = SHA512HashSizeBits,
+
+    /* messages hashed at once by SHA256InputResultMultiple */
+    SHA256MultiBufferLanes = 8
 };
 
 /*
@@ -179,6 +182,18 @@ typedef struct HMACContext {
                         /* outer padding - key XORd with opad */
 } HMACContext;
 
+/*
+ *  This structure will hold the SHA states of an HMAC after the key
+ *  has been processed, so that a key can be used for many messages
+ *  without hashing the padded key again for every message.
+ */
+typedef struct HMACKeyContext {
+    int whichSha;               /* which SHA is being used */
+    int hashSize;               /* hash size of SHA being used */
+    USHAContext innerContext;   /* SHA state after the inner pad */
+    USHAContext outerContext;   /* SHA state after the outer pad */
+} HMACKeyContext;
+
 
 /*
  *  Function Prototypes
@@ -210,6 +225,11 @@ extern int SHA256FinalBits(SHA256Context *, const uint8_t bits,
                            unsigned int bitcount);
 extern int SHA256Result(SHA256Context *,
                         uint8_t Message_Digest[SHA256HashSize]);
+extern int SHA256InputResultMultiple(SHA256Context *contexts,
+                        const uint8_t *const messages[],
+                        const unsigned int lengths[],
+                        uint8_t Message_Digests[][SHA256HashSize],
+                        unsigned int count);
 
 /* SHA-384 */
 extern int SHA384Reset(SHA384Context *);
@@ -268,6 +288,18 @@ extern int hmacFinalBits(HMACContext *ctx, const uint8_t bits,
 extern int hmacResult(HMACContext *ctx,
                       uint8_t digest[USHAMaxHashSize]);
 
+/*
+ * HMAC with a precomputed key. hmacKeyReset processes the key once;
+ * copy the resulting context for each message and use the copy with
+ * hmacKeyInput and hmacKeyResult.
+ */
+extern int hmacKeyReset(HMACKeyContext *ctx, enum SHAversion whichSha,
+                        const unsigned char *key, int key_len);
+extern int hmacKeyInput(HMACKeyContext *ctx, const unsigned char *text,
+                        int text_len);
+extern int hmacKeyResult(HMACKeyContext *ctx,
+                         uint8_t digest[USHAMaxHashSize]);
+
 
 #ifdef __cplusplus
 }
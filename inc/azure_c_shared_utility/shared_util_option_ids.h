@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef SHARED_UTIL_OPTION_IDS_H
+#define SHARED_UTIL_OPTION_IDS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /* the options in shared_util_options.h interned to small integers, OptionHandler_GetOptionId maps a name to its id so that a module can
+    dispatch on the id with a switch instead of comparing the name against every option it knows */
+    typedef enum OPTION_ID_TAG
+    {
+        OPTION_ID_UNKNOWN,
+        OPTION_ID_HTTP_PROXY,
+        OPTION_ID_HTTP_TIMEOUT,
+        OPTION_ID_X509_CERT,
+        OPTION_ID_X509_PRIVATE_KEY,
+        OPTION_ID_X509_ECC_CERT,
+        OPTION_ID_X509_ECC_KEY,
+        OPTION_ID_CURL_LOW_SPEED_LIMIT,
+        OPTION_ID_CURL_LOW_SPEED_TIME,
+        OPTION_ID_CURL_FRESH_CONNECT,
+        OPTION_ID_CURL_FORBID_REUSE,
+        OPTION_ID_CURL_VERBOSE,
+        OPTION_ID_SAS_TOKEN_REFRESH_MARGIN,
+        OPTION_ID_TRUSTED_CERT,
+        OPTION_ID_TLS_VERSION,
+        OPTION_ID_TLS_VALIDATION_CALLBACK,
+        OPTION_ID_TLS_VALIDATION_CALLBACK_DATA,
+        OPTION_ID_TCP_KEEP_ALIVE,
+        OPTION_ID_TCP_KEEP_ALIVE_TIME,
+        OPTION_ID_TCP_KEEP_ALIVE_INTERVAL
+    } OPTION_ID;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHARED_UTIL_OPTION_IDS_H */
@@ -4,6 +4,8 @@
 #ifndef SHARED_UTIL_OPTIONS_H
 #define SHARED_UTIL_OPTIONS_H
 
+#include "azure_c_shared_utility/shared_util_option_ids.h"
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -32,6 +34,17 @@ extern "C"
     static const char* OPTION_CURL_FORBID_REUSE = "CURLOPT_FORBID_REUSE";
     static const char* OPTION_CURL_VERBOSE = "CURLOPT_VERBOSE";
 
+    static const char* OPTION_SAS_TOKEN_REFRESH_MARGIN = "sas_token_refresh_margin";
+
+    static const char* OPTION_TRUSTED_CERT = "TrustedCerts";
+    static const char* OPTION_TLS_VERSION = "tls_version";
+    static const char* OPTION_TLS_VALIDATION_CALLBACK = "tls_validation_callback";
+    static const char* OPTION_TLS_VALIDATION_CALLBACK_DATA = "tls_validation_callback_data";
+
+    static const char* OPTION_TCP_KEEP_ALIVE = "tcp_keepalive";
+    static const char* OPTION_TCP_KEEP_ALIVE_TIME = "tcp_keepalive_time";
+    static const char* OPTION_TCP_KEEP_ALIVE_INTERVAL = "tcp_keepalive_interval";
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef SLABALLOC_H
+#define SLABALLOC_H
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C"
+{
+#else
+#include <stddef.h>
+#endif
+
+#include "azure_c_shared_utility/umock_c_prod.h"
+
+/* slaballoc serves small allocations (up to SLABALLOC_MAX_BLOCK_SIZE bytes) from per size class free lists that are carved out of
+larger slabs, so that the many short lived list items, handles and pending IO records do not each cost a trip to the heap.
+Nothing in the library calls slaballoc_init: the application calls it (like gballoc_init) before it creates any handle, and until
+then (and after slaballoc_deinit) all allocations are passed through to malloc. slaballoc_deinit releases the slabs, so the application
+shall only call it once every block has been freed, that is after all the handles are destroyed.
+Memory obtained from slaballoc_malloc/calloc/realloc shall only be released with slaballoc_free.
+A thread keeps a small cache of free blocks, which slaballoc_release_thread_cache hands back to the shared free lists. Threads started with
+ThreadAPI_Create on pthreads call it when they exit, any other thread that frees slaballoc blocks should call it before it exits, otherwise
+the blocks in its cache are not reused until slaballoc_deinit. */
+#define SLABALLOC_MAX_BLOCK_SIZE 256
+
+MOCKABLE_FUNCTION(, int, slaballoc_init);
+MOCKABLE_FUNCTION(, void, slaballoc_deinit);
+MOCKABLE_FUNCTION(, void*, slaballoc_malloc, size_t, size);
+MOCKABLE_FUNCTION(, void*, slaballoc_calloc, size_t, nmemb, size_t, size);
+MOCKABLE_FUNCTION(, void*, slaballoc_realloc, void*, ptr, size_t, size);
+MOCKABLE_FUNCTION(, void, slaballoc_free, void*, ptr);
+MOCKABLE_FUNCTION(, void, slaballoc_release_thread_cache);
+
+/* translation units that want their small fixed size objects to come from slaballoc need to have SLABALLOC_FOR_THIS defined and
+allocate/free those objects with SLABALLOC_MALLOC/SLABALLOC_FREE. Without it the macros are plain malloc/free (and therefore still
+subject to gballoc redirection). Objects allocated with SLABALLOC_MALLOC shall never be handed out to be freed by other modules. */
+#ifdef SLABALLOC_FOR_THIS
+#define SLABALLOC_MALLOC(size) slaballoc_malloc(size)
+#define SLABALLOC_FREE(ptr) slaballoc_free(ptr)
+#else
+#define SLABALLOC_MALLOC(size) malloc(size)
+#define SLABALLOC_FREE(ptr) free(ptr)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLABALLOC_H */
@@ -18,6 +18,7 @@ MOCKABLE_FUNCTION(, STRING_TOKENIZER_HANDLE, STRING_TOKENIZER_create, STRING_HAN
 MOCKABLE_FUNCTION(, STRING_TOKENIZER_HANDLE, STRING_TOKENIZER_create_from_char, const char*, input);
 MOCKABLE_FUNCTION(, int, STRING_TOKENIZER_get_next_token, STRING_TOKENIZER_HANDLE, t, STRING_HANDLE, output, const char*, delimiters);
 MOCKABLE_FUNCTION(, void, STRING_TOKENIZER_destroy, STRING_TOKENIZER_HANDLE, t);
+MOCKABLE_FUNCTION(, int, STRING_VIEW_get_next_token, STRING_VIEW*, input, STRING_VIEW*, token, const char*, delimiters);
 
 #ifdef __cplusplus
 }
@@ -4,6 +4,19 @@
 #ifndef STRING_TOKENIZER_TYPES_H
 #define STRING_TOKENIZER_TYPES_H
 
+#ifdef __cplusplus
+#include <cstddef>
+#else
+#include <stddef.h>
+#endif
+
 typedef struct STRING_TOKEN_TAG* STRING_TOKENIZER_HANDLE;
 
+/*a non owning view of length characters starting at str, the characters are not necessarily '\0' terminated*/
+typedef struct STRING_VIEW_TAG
+{
+    const char* str;
+    size_t length;
+} STRING_VIEW;
+
 #endif  /*STRING_TOKENIZER_TYPES_H*/
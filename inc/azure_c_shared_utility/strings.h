@@ -6,6 +6,7 @@
 
 #include "azure_c_shared_utility/umock_c_prod.h"
 #include "azure_c_shared_utility/strings_types.h"
+#include "azure_c_shared_utility/arena.h"
 
 #ifdef __cplusplus
 #include <cstddef>
@@ -23,9 +24,15 @@ MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_new_with_memory, const char*, memory);
 MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_new_quoted, const char*, source);
 MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_new_JSON, const char*, source);
 MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_from_byte_array, const unsigned char*, source, size_t, size);
+/* strings whose memory comes from arena, STRING_delete gives it back and the clones are allocated from the heap */
+MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_new_in_arena, ARENA_HANDLE, arena);
+MOCKABLE_FUNCTION(, STRING_HANDLE, STRING_construct_in_arena, ARENA_HANDLE, arena, const char*, psz);
 MOCKABLE_FUNCTION(, void, STRING_delete, STRING_HANDLE, handle);
 MOCKABLE_FUNCTION(, int, STRING_concat, STRING_HANDLE, handle, const char*, s2);
 MOCKABLE_FUNCTION(, int, STRING_concat_with_STRING, STRING_HANDLE, s1, STRING_HANDLE, s2);
+MOCKABLE_FUNCTION(, int, STRING_concat_n, STRING_HANDLE, handle, const char*, s2, size_t, n);
+MOCKABLE_FUNCTION(, int, STRING_concat_JSON, STRING_HANDLE, handle, const char*, source);
+MOCKABLE_FUNCTION(, int, STRING_reserve, STRING_HANDLE, handle, size_t, capacity);
 MOCKABLE_FUNCTION(, int, STRING_quote, STRING_HANDLE, handle);
 MOCKABLE_FUNCTION(, int, STRING_copy, STRING_HANDLE, s1, const char*, s2);
 MOCKABLE_FUNCTION(, int, STRING_copy_n, STRING_HANDLE, s1, const char*, s2, size_t, n);
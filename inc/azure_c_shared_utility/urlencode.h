@@ -15,6 +15,20 @@ extern "C" {
     MOCKABLE_FUNCTION(, STRING_HANDLE, URL_EncodeString, const char*, textEncode);
     MOCKABLE_FUNCTION(, STRING_HANDLE, URL_Encode, STRING_HANDLE, input);
 
+    /* Encodes textLength characters of textEncode into destination, which has to be larger than the encoding so that it
+    can be null terminated. *encodedLength is set even when destination is NULL or too small, so that a first call with a
+    NULL destination sizes the buffer. Returns 0 on success. */
+    MOCKABLE_FUNCTION(, int, URL_Encode_Into, const char*, textEncode, size_t, textLength, char*, destination, size_t, destinationSize, size_t*, encodedLength);
+
+    /* Reverse URL_Encode. "%xx" escapes are accepted in either case; a '%' that is not followed by 2 hexadecimal digits
+    makes the decoding fail. */
+    MOCKABLE_FUNCTION(, STRING_HANDLE, URL_DecodeString, const char*, textDecode);
+    MOCKABLE_FUNCTION(, STRING_HANDLE, URL_Decode, STRING_HANDLE, input);
+
+    /* Decodes textLength characters of textDecode into destination and null terminates it. The decoding is never longer
+    than the encoding, so textLength + 1 bytes are always enough. Returns 0 on success. */
+    MOCKABLE_FUNCTION(, int, URL_Decode_Into, const char*, textDecode, size_t, textLength, char*, destination, size_t, destinationSize, size_t*, decodedLength);
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,8 +15,21 @@ extern "C" {
 
 #include "azure_c_shared_utility/umock_c_prod.h"
 
+/* state of a check done in pieces, the fields are only meant to be used by utf8_checker */
+typedef struct UTF8_CHECKER_STATE_TAG
+{
+    unsigned char previous[3];  /* the last 3 bytes checked, the most recent first */
+    unsigned char error;
+} UTF8_CHECKER_STATE;
+
 MOCKABLE_FUNCTION(, bool, utf8_checker_is_valid_utf8, const unsigned char*, utf8_str, size_t, length);
 
+/* utf8_checker_update can be called with each fragment of a string (for example the frames of a WebSocket text message),
+a sequence may be split between fragments. utf8_checker_final tells whether the whole string was valid. */
+MOCKABLE_FUNCTION(, void, utf8_checker_init, UTF8_CHECKER_STATE*, state);
+MOCKABLE_FUNCTION(, bool, utf8_checker_update, UTF8_CHECKER_STATE*, state, const unsigned char*, utf8_str, size_t, length);
+MOCKABLE_FUNCTION(, bool, utf8_checker_final, UTF8_CHECKER_STATE*, state);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
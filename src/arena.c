@@ -0,0 +1,319 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "azure_c_shared_utility/arena.h"
+#include "azure_c_shared_utility/optimize_size.h"
+#include "azure_c_shared_utility/xlogging.h"
+
+/*ARENA_reset does not keep more than this many times block_size, so that one unusually large operation does not pin its memory for the life of the arena*/
+#define ARENA_MAX_RETAINED_BLOCKS 16
+
+/*every allocation is aligned for any of these*/
+typedef union ARENA_ALIGNMENT_TAG
+{
+    void* p;
+    long long ll;
+    double d;
+    void(*f)(void);
+} ARENA_ALIGNMENT;
+
+#define ARENA_ALIGN(size) ((((size) + sizeof(ARENA_ALIGNMENT) - 1) / sizeof(ARENA_ALIGNMENT)) * sizeof(ARENA_ALIGNMENT))
+
+typedef struct ARENA_BLOCK_TAG
+{
+    struct ARENA_BLOCK_TAG* previous;
+    /*bytes that can be handed out after the block header*/
+    size_t capacity;
+} ARENA_BLOCK;
+
+#define ARENA_BLOCK_HEADER_SIZE ARENA_ALIGN(sizeof(ARENA_BLOCK))
+#define ARENA_BLOCK_DATA(block) ((unsigned char*)(block) + ARENA_BLOCK_HEADER_SIZE)
+
+/*precedes every allocation, it is what lets ARENA_realloc know how many bytes to copy*/
+typedef union ARENA_ALLOCATION_TAG
+{
+    size_t size;
+    ARENA_ALIGNMENT alignment;
+} ARENA_ALLOCATION;
+
+typedef struct ARENA_TAG
+{
+    /*the block allocations are carved from, the older ones are linked through previous*/
+    ARENA_BLOCK* current;
+    /*bytes of current already handed out*/
+    size_t used;
+    /*the most recent allocation, the only one that can grow or be given back in place*/
+    ARENA_ALLOCATION* last;
+    size_t block_size;
+} ARENA;
+
+static void free_blocks(ARENA* arena)
+{
+    while (arena->current != NULL)
+    {
+        ARENA_BLOCK* previous = arena->current->previous;
+        free(arena->current);
+        arena->current = previous;
+    }
+}
+
+static ARENA_BLOCK* add_block(ARENA* arena, size_t capacity)
+{
+    ARENA_BLOCK* result;
+
+    if (capacity > SIZE_MAX - ARENA_BLOCK_HEADER_SIZE)
+    {
+        LogError("block too large: %zu bytes", capacity);
+        result = NULL;
+    }
+    else if ((result = (ARENA_BLOCK*)malloc(ARENA_BLOCK_HEADER_SIZE + capacity)) == NULL)
+    {
+        LogError("unable to allocate a block of %zu bytes", capacity);
+    }
+    else
+    {
+        result->previous = arena->current;
+        result->capacity = capacity;
+        arena->current = result;
+        arena->used = 0;
+    }
+
+    return result;
+}
+
+/*returns the number of bytes an allocation of size bytes takes in a block, 0 if that overflows*/
+static size_t allocation_footprint(size_t size)
+{
+    return (size > SIZE_MAX - sizeof(ARENA_ALLOCATION) - sizeof(ARENA_ALIGNMENT)) ? 0 : ARENA_ALIGN(sizeof(ARENA_ALLOCATION) + size);
+}
+
+ARENA_HANDLE ARENA_create(size_t block_size)
+{
+    ARENA* result;
+
+    if (block_size == 0)
+    {
+        /*Codes_SRS_ARENA_01_001: [ If block_size is 0, ARENA_create shall fail and return NULL. ]*/
+        LogError("Invalid argument: block_size=0");
+        result = NULL;
+    }
+    /*Codes_SRS_ARENA_01_002: [ ARENA_create shall allocate a new arena with malloc and return a non-NULL handle to it. ]*/
+    else if ((result = (ARENA*)malloc(sizeof(ARENA))) == NULL)
+    {
+        /*Codes_SRS_ARENA_01_003: [ If malloc fails, ARENA_create shall fail and return NULL. ]*/
+        LogError("unable to allocate the arena");
+    }
+    else
+    {
+        /*Codes_SRS_ARENA_01_004: [ ARENA_create shall not allocate any block, the first block is allocated by the first allocation. ]*/
+        result->current = NULL;
+        result->used = 0;
+        result->last = NULL;
+        result->block_size = block_size;
+    }
+
+    return (ARENA_HANDLE)result;
+}
+
+void ARENA_destroy(ARENA_HANDLE arena)
+{
+    /*Codes_SRS_ARENA_01_005: [ If arena is NULL, ARENA_destroy shall do nothing. ]*/
+    if (arena != NULL)
+    {
+        /*Codes_SRS_ARENA_01_006: [ ARENA_destroy shall free all the blocks of the arena and the arena itself. ]*/
+        free_blocks(arena);
+        free(arena);
+    }
+}
+
+void* ARENA_malloc(ARENA_HANDLE arena, size_t size)
+{
+    void* result;
+    size_t footprint;
+
+    if (arena == NULL)
+    {
+        /*Codes_SRS_ARENA_01_007: [ If arena is NULL, ARENA_malloc shall fail and return NULL. ]*/
+        LogError("Invalid argument: arena=NULL");
+        result = NULL;
+    }
+    else if ((footprint = allocation_footprint(size)) == 0)
+    {
+        /*Codes_SRS_ARENA_01_008: [ If size plus the size of the allocation header overflows, ARENA_malloc shall fail and return NULL. ]*/
+        LogError("size too large: %zu", size);
+        result = NULL;
+    }
+    /*Codes_SRS_ARENA_01_010: [ If the current block does not have room for the allocation, ARENA_malloc shall allocate a new block of block_size bytes, or of as many bytes as the allocation needs if that is more, by calling malloc. ]*/
+    else if (((arena->current == NULL) || (arena->current->capacity - arena->used < footprint)) &&
+        (add_block(arena, (footprint > arena->block_size) ? footprint : arena->block_size) == NULL))
+    {
+        /*Codes_SRS_ARENA_01_011: [ If allocating the block fails, ARENA_malloc shall fail and return NULL. ]*/
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_ARENA_01_009: [ Otherwise ARENA_malloc shall return size bytes carved from the current block of the arena, aligned for any fundamental type. ]*/
+        ARENA_ALLOCATION* allocation = (ARENA_ALLOCATION*)(ARENA_BLOCK_DATA(arena->current) + arena->used);
+        allocation->size = size;
+        arena->used += footprint;
+        arena->last = allocation;
+        result = allocation + 1;
+    }
+
+    return result;
+}
+
+void* ARENA_realloc(ARENA_HANDLE arena, void* ptr, size_t size)
+{
+    void* result;
+
+    if (arena == NULL)
+    {
+        /*Codes_SRS_ARENA_01_012: [ If arena is NULL, ARENA_realloc shall fail and return NULL. ]*/
+        LogError("Invalid argument: arena=NULL");
+        result = NULL;
+    }
+    else if (ptr == NULL)
+    {
+        /*Codes_SRS_ARENA_01_013: [ If ptr is NULL, ARENA_realloc shall behave as ARENA_malloc. ]*/
+        result = ARENA_malloc(arena, size);
+    }
+    else
+    {
+        ARENA_ALLOCATION* allocation = (ARENA_ALLOCATION*)ptr - 1;
+        size_t footprint = allocation_footprint(size);
+
+        if (footprint == 0)
+        {
+            /*Codes_SRS_ARENA_01_017: [ If size plus the size of the allocation header overflows, ARENA_realloc shall fail and return NULL. ]*/
+            LogError("size too large: %zu", size);
+            result = NULL;
+        }
+        else if (allocation == arena->last)
+        {
+            size_t offset = (unsigned char*)allocation - ARENA_BLOCK_DATA(arena->current);
+            if (footprint <= arena->current->capacity - offset)
+            {
+                /*Codes_SRS_ARENA_01_014: [ If ptr is the most recent allocation of the arena and the current block has room for size bytes, ARENA_realloc shall grow or shrink the allocation in place and return ptr. ]*/
+                allocation->size = size;
+                arena->used = offset + footprint;
+                result = ptr;
+            }
+            else
+            {
+                result = NULL;
+            }
+        }
+        else if (size <= allocation->size)
+        {
+            /*Codes_SRS_ARENA_01_015: [ If ptr is not the most recent allocation and size is not greater than its size, ARENA_realloc shall return ptr. ]*/
+            allocation->size = size;
+            result = ptr;
+        }
+        else
+        {
+            result = NULL;
+        }
+
+        if ((result == NULL) && (footprint != 0))
+        {
+            /*Codes_SRS_ARENA_01_016: [ Otherwise ARENA_realloc shall allocate size bytes with ARENA_malloc, copy the content of ptr and return the new memory. ]*/
+            size_t old_size = allocation->size;
+            if ((result = ARENA_malloc(arena, size)) == NULL)
+            {
+                /*Codes_SRS_ARENA_01_018: [ If the allocation fails, ARENA_realloc shall return NULL and leave ptr unchanged. ]*/
+                LogError("unable to reallocate to %zu bytes", size);
+            }
+            else
+            {
+                (void)memcpy(result, ptr, old_size);
+            }
+        }
+    }
+
+    return result;
+}
+
+void ARENA_free(ARENA_HANDLE arena, void* ptr)
+{
+    /*Codes_SRS_ARENA_01_019: [ If arena or ptr is NULL, ARENA_free shall do nothing. ]*/
+    if ((arena != NULL) &&
+        (ptr != NULL))
+    {
+        ARENA_ALLOCATION* allocation = (ARENA_ALLOCATION*)ptr - 1;
+        if (allocation == arena->last)
+        {
+            /*Codes_SRS_ARENA_01_020: [ If ptr is the most recent allocation of the arena, ARENA_free shall give its memory back to the current block. ]*/
+            arena->used = (unsigned char*)allocation - ARENA_BLOCK_DATA(arena->current);
+            arena->last = NULL;
+        }
+        else
+        {
+            /*Codes_SRS_ARENA_01_021: [ Otherwise ARENA_free shall do nothing, the memory is reclaimed by ARENA_reset. ]*/
+        }
+    }
+}
+
+char* ARENA_strdup(ARENA_HANDLE arena, const char* source)
+{
+    char* result;
+
+    if ((arena == NULL) ||
+        (source == NULL))
+    {
+        /*Codes_SRS_ARENA_01_022: [ If arena or source is NULL, ARENA_strdup shall fail and return NULL. ]*/
+        LogError("Invalid arguments: arena=%p, source=%p", arena, source);
+        result = NULL;
+    }
+    else
+    {
+        size_t length = strlen(source);
+        /*Codes_SRS_ARENA_01_023: [ ARENA_strdup shall allocate strlen(source) + 1 bytes with ARENA_malloc, copy source into them and return them. ]*/
+        if ((result = (char*)ARENA_malloc(arena, length + 1)) == NULL)
+        {
+            /*Codes_SRS_ARENA_01_024: [ If the allocation fails, ARENA_strdup shall fail and return NULL. ]*/
+            LogError("unable to allocate %zu bytes", length + 1);
+        }
+        else
+        {
+            (void)memcpy(result, source, length + 1);
+        }
+    }
+
+    return result;
+}
+
+void ARENA_reset(ARENA_HANDLE arena)
+{
+    /*Codes_SRS_ARENA_01_025: [ If arena is NULL, ARENA_reset shall do nothing. ]*/
+    if (arena != NULL)
+    {
+        /*Codes_SRS_ARENA_01_026: [ ARENA_reset shall make all the memory handed out by the arena available again. ]*/
+        arena->used = 0;
+        arena->last = NULL;
+
+        if ((arena->current != NULL) &&
+            (arena->current->previous != NULL))
+        {
+            /*Codes_SRS_ARENA_01_027: [ If the arena has more than one block, ARENA_reset shall free all of them and allocate a single block as large as all of them together, but not larger than ARENA_MAX_RETAINED_BLOCKS times block_size, so that the same work fits in one block the next time. ]*/
+            size_t total = 0;
+            size_t max_retained = (arena->block_size > SIZE_MAX / ARENA_MAX_RETAINED_BLOCKS) ? SIZE_MAX : arena->block_size * ARENA_MAX_RETAINED_BLOCKS;
+            ARENA_BLOCK* block;
+
+            for (block = arena->current; block != NULL; block = block->previous)
+            {
+                total = (block->capacity > max_retained - total) ? max_retained : total + block->capacity;
+            }
+
+            free_blocks(arena);
+
+            /*Codes_SRS_ARENA_01_028: [ If allocating the block fails, ARENA_reset shall leave the arena without blocks. ]*/
+            (void)add_block(arena, total);
+        }
+    }
+}
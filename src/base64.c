@@ -5,107 +5,370 @@
 #include "azure_c_shared_utility/gballoc.h"
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "azure_c_shared_utility/base64.h"
+#include "azure_c_shared_utility/cpu_features.h"
+#include "azure_c_shared_utility/optimize_size.h"
 #include "azure_c_shared_utility/xlogging.h"
 
+/*the vector kernels below are picked at runtime, so a library built with them still runs on processors without them*/
+/*defining NO_SIMD (the no_simd cmake option) compiles them out*/
+#if !defined(NO_SIMD)
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5)))
+#define BASE64_SIMD_X86
+#include <immintrin.h>
+#define BASE64_SSSE3_TARGET __attribute__((target("ssse3")))
+#define BASE64_AVX2_TARGET __attribute__((target("avx2")))
+#elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER) && (_MSC_VER >= 1900)
+#define BASE64_SIMD_X86
+#include <immintrin.h>
+#define BASE64_SSSE3_TARGET
+#define BASE64_AVX2_TARGET
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define BASE64_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif /* NO_SIMD */
 
-#define splitInt(intVal, bytePos)   (char)((intVal >> (bytePos << 3)) & 0xFF)
-#define joinChars(a, b, c, d) (uint32_t)((uint32_t)a + ((uint32_t)b << 8) + ((uint32_t)c << 16) + ((uint32_t)d << 24))
+static const char base64_alphabet[64] = {
+    'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+    'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f',
+    'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v',
+    'w', 'x', 'y', 'z', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '+', '/'
+};
 
-static char base64char(unsigned char val)
+/*value of each base64 character, -1 for the characters that are not part of the alphabet (including '=')*/
+static const signed char base64_values[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+/*encodes whole groups of 3 bytes from the start of source and returns the number of bytes consumed (a multiple of 3)*/
+typedef size_t(*BASE64_ENCODE_BLOCKS)(const unsigned char* source, size_t size, char* destination);
+/*decodes whole groups of 4 characters from the start of source, stopping before any group that holds a character outside the alphabet.
+Returns the number of characters consumed (a multiple of 4). destination shall have room for at least 3/4 of length minus 2 bytes*/
+typedef size_t(*BASE64_DECODE_BLOCKS)(const char* source, size_t length, unsigned char* destination);
+
+#if defined(BASE64_SIMD_X86)
+
+/*the SSSE3 and AVX2 kernels follow "Faster Base64 Encoding and Decoding using AVX2 Instructions" (Mula, Lemire)*/
+
+/*turns 6 bit values into their characters by adding the offset of the range each value falls in:
+values below 26 pick 'A', the others are turned by a saturated subtraction into an index to the offsets of the other ranges*/
+BASE64_SSSE3_TARGET
+static __m128i Base64EncodeLookupSSSE3(__m128i indices)
 {
-    char result;
+    const __m128i shift_lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    __m128i ranges = _mm_or_si128(_mm_subs_epu8(indices, _mm_set1_epi8(51)),
+        _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+    return _mm_add_epi8(indices, _mm_shuffle_epi8(shift_lut, ranges));
+}
 
-    if (val < 26)
-    {
-        result = 'A' + (char)val;
-    }
-    else if (val < 52)
+BASE64_AVX2_TARGET
+static __m256i Base64EncodeLookupAVX2(__m256i indices)
+{
+    const __m256i shift_lut = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    __m256i ranges = _mm256_or_si256(_mm256_subs_epu8(indices, _mm256_set1_epi8(51)),
+        _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+    return _mm256_add_epi8(indices, _mm256_shuffle_epi8(shift_lut, ranges));
+}
+
+BASE64_SSSE3_TARGET
+static size_t Base64EncodeBlocksSSSE3(const unsigned char* source, size_t size, char* destination)
+{
+    const __m128i shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    size_t consumed = 0;
+
+    /*each round reads 16 bytes and encodes the first 12: the shuffle puts the 3 bytes of a group in each 32 bit word
+    and the multiplications shift the 4 6 bit fields of the word into their own bytes*/
+    while (size - consumed >= 16)
     {
-        result = 'a' + ((char)val - 26);
+        __m128i input = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(source + consumed)), shuffle);
+        __m128i indices = _mm_or_si128(
+            _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040)),
+            _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010)));
+        _mm_storeu_si128((__m128i*)destination, Base64EncodeLookupSSSE3(indices));
+        consumed += 12;
+        destination += 16;
     }
-    else if (val < 62)
+
+    return consumed;
+}
+
+BASE64_AVX2_TARGET
+static size_t Base64EncodeBlocksAVX2(const unsigned char* source, size_t size, char* destination)
+{
+    const __m256i shuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    size_t consumed = 0;
+
+    /*each round encodes 24 bytes, 12 per lane, and reads 28*/
+    while (size - consumed >= 28)
     {
-        result = '0' + ((char)val - 52);
+        __m256i input = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)(source + consumed))),
+            _mm_loadu_si128((const __m128i*)(source + consumed + 12)), 1);
+        __m256i indices;
+        input = _mm256_shuffle_epi8(input, shuffle);
+        indices = _mm256_or_si256(
+            _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040)),
+            _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010)));
+        _mm256_storeu_si256((__m256i*)destination, Base64EncodeLookupAVX2(indices));
+        consumed += 24;
+        destination += 32;
     }
-    else if (val == 62)
+
+    return consumed;
+}
+
+BASE64_SSSE3_TARGET
+static size_t Base64DecodeBlocksSSSE3(const char* source, size_t length, unsigned char* destination)
+{
+    /*a character is valid when the bits picked by its low nibble and by its high nibble do not intersect*/
+    const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    size_t consumed = 0;
+
+    /*each round decodes 16 characters and stores 16 bytes, 12 of them meaningful*/
+    while (length - consumed >= 24)
     {
-        result = '+';
+        __m128i input = _mm_loadu_si128((const __m128i*)(source + consumed));
+        __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(input, 4), nibble_mask);
+        __m128i lo_nibbles = _mm_and_si128(input, nibble_mask);
+        __m128i values;
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(_mm_shuffle_epi8(lut_lo, lo_nibbles), _mm_shuffle_epi8(lut_hi, hi_nibbles)), _mm_setzero_si128())) != 0xFFFF)
+        {
+            break;
+        }
+        values = _mm_add_epi8(input, _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(input, _mm_set1_epi8('/')), hi_nibbles)));
+        values = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128((__m128i*)destination, _mm_shuffle_epi8(values, pack));
+        consumed += 16;
+        destination += 12;
     }
-    else
+
+    return consumed;
+}
+
+BASE64_AVX2_TARGET
+static size_t Base64DecodeBlocksAVX2(const char* source, size_t length, unsigned char* destination)
+{
+    const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    size_t consumed = 0;
+
+    /*each round decodes 32 characters and stores 32 bytes, 24 of them meaningful*/
+    while (length - consumed >= 48)
     {
-        result = '/';
+        __m256i input = _mm256_loadu_si256((const __m256i*)(source + consumed));
+        __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(input, 4), nibble_mask);
+        __m256i lo_nibbles = _mm256_and_si256(input, nibble_mask);
+        __m256i values;
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(_mm256_shuffle_epi8(lut_lo, lo_nibbles), _mm256_shuffle_epi8(lut_hi, hi_nibbles)), _mm256_setzero_si256())) != -1)
+        {
+            break;
+        }
+        values = _mm256_add_epi8(input, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(input, _mm256_set1_epi8('/')), hi_nibbles)));
+        values = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+        values = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(values, pack), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256((__m256i*)destination, values);
+        consumed += 32;
+        destination += 24;
     }
 
+    return consumed;
+}
+
+#elif defined(BASE64_SIMD_NEON)
+
+static uint8x16x4_t Base64LoadTableNEON(const uint8_t* table)
+{
+    uint8x16x4_t result;
+    result.val[0] = vld1q_u8(table);
+    result.val[1] = vld1q_u8(table + 16);
+    result.val[2] = vld1q_u8(table + 32);
+    result.val[3] = vld1q_u8(table + 48);
     return result;
 }
 
-static char base64b16(unsigned char val)
+static size_t Base64EncodeBlocksNEON(const unsigned char* source, size_t size, char* destination)
 {
-    const uint32_t base64b16values[4] = {
-        joinChars('A', 'E', 'I', 'M'),
-        joinChars('Q', 'U', 'Y', 'c'),
-        joinChars('g', 'k', 'o', 's'),
-        joinChars('w', '0', '4', '8')
-    };
-    return splitInt(base64b16values[val >> 2], (val & 0x03));
+    const uint8x16x4_t alphabet = Base64LoadTableNEON((const uint8_t*)base64_alphabet);
+    size_t consumed = 0;
+
+    /*each round splits 48 bytes in their 3 byte positions and writes 64 interleaved characters*/
+    while (size - consumed >= 48)
+    {
+        uint8x16x3_t input = vld3q_u8(source + consumed);
+        uint8x16x4_t output;
+        output.val[0] = vshrq_n_u8(input.val[0], 2);
+        output.val[1] = vorrq_u8(vshlq_n_u8(vandq_u8(input.val[0], vdupq_n_u8(0x03)), 4), vshrq_n_u8(input.val[1], 4));
+        output.val[2] = vorrq_u8(vshlq_n_u8(vandq_u8(input.val[1], vdupq_n_u8(0x0F)), 2), vshrq_n_u8(input.val[2], 6));
+        output.val[3] = vandq_u8(input.val[2], vdupq_n_u8(0x3F));
+        output.val[0] = vqtbl4q_u8(alphabet, output.val[0]);
+        output.val[1] = vqtbl4q_u8(alphabet, output.val[1]);
+        output.val[2] = vqtbl4q_u8(alphabet, output.val[2]);
+        output.val[3] = vqtbl4q_u8(alphabet, output.val[3]);
+        vst4q_u8((uint8_t*)destination, output);
+        consumed += 48;
+        destination += 64;
+    }
+
+    return consumed;
 }
 
-static char base64b8(unsigned char val)
+static uint8x16_t Base64LookupNEON(uint8x16x4_t low_values, uint8x16x4_t high_values, uint8x16_t characters)
 {
-    const uint32_t base64b8values = joinChars('A', 'Q', 'g', 'w');
-    return splitInt(base64b8values, val);
+    /*vqtbl4q_u8 yields 0 and vqtbx4q_u8 keeps the previous byte for indices past 63*/
+    return vqtbx4q_u8(vqtbl4q_u8(low_values, characters), high_values, vsubq_u8(characters, vdupq_n_u8(64)));
 }
 
-static int base64toValue(char base64character, unsigned char* value)
+static size_t Base64DecodeBlocksNEON(const char* source, size_t length, unsigned char* destination)
 {
-    int result = 0;
-    if (('A' <= base64character) && (base64character <= 'Z'))
-    {
-        *value = base64character - 'A';
-    }
-    else if (('a' <= base64character) && (base64character <= 'z'))
+    const uint8x16x4_t low_values = Base64LoadTableNEON((const uint8_t*)base64_values);
+    const uint8x16x4_t high_values = Base64LoadTableNEON((const uint8_t*)base64_values + 64);
+    size_t consumed = 0;
+
+    /*each round splits 64 characters in their 4 positions and writes 48 interleaved bytes*/
+    while (length - consumed >= 64)
     {
-        *value = ('Z' - 'A') + 1 + (base64character - 'a');
+        uint8x16x4_t input = vld4q_u8((const uint8_t*)source + consumed);
+        uint8x16_t a = Base64LookupNEON(low_values, high_values, input.val[0]);
+        uint8x16_t b = Base64LookupNEON(low_values, high_values, input.val[1]);
+        uint8x16_t c = Base64LookupNEON(low_values, high_values, input.val[2]);
+        uint8x16_t d = Base64LookupNEON(low_values, high_values, input.val[3]);
+        uint8x16x3_t output;
+
+        /*invalid characters map to 0xFF, characters above 127 keep their top bit*/
+        uint8x16_t invalid = vorrq_u8(vorrq_u8(vorrq_u8(a, b), vorrq_u8(c, d)),
+            vorrq_u8(vorrq_u8(input.val[0], input.val[1]), vorrq_u8(input.val[2], input.val[3])));
+        if (vmaxvq_u8(invalid) >= 0x80)
+        {
+            break;
+        }
+
+        output.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+        output.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+        output.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+        vst3q_u8(destination, output);
+        consumed += 64;
+        destination += 48;
     }
-    else if (('0' <= base64character) && (base64character <= '9'))
+
+    return consumed;
+}
+
+#endif
+
+/*the kernels for this processor, NULL when the portable code does all the work*/
+static BASE64_ENCODE_BLOCKS getEncodeBlocksFunction(void)
+{
+#if defined(BASE64_SIMD_X86)
+    int features = cpu_features_get();
+    return ((features & CPU_FEATURE_X86_AVX2) != 0) ? Base64EncodeBlocksAVX2 :
+        ((features & CPU_FEATURE_X86_SSSE3) != 0) ? Base64EncodeBlocksSSSE3 : NULL;
+#elif defined(BASE64_SIMD_NEON)
+    return Base64EncodeBlocksNEON;
+#else
+    return NULL;
+#endif
+}
+
+static BASE64_DECODE_BLOCKS getDecodeBlocksFunction(void)
+{
+#if defined(BASE64_SIMD_X86)
+    int features = cpu_features_get();
+    return ((features & CPU_FEATURE_X86_AVX2) != 0) ? Base64DecodeBlocksAVX2 :
+        ((features & CPU_FEATURE_X86_SSSE3) != 0) ? Base64DecodeBlocksSSSE3 : NULL;
+#elif defined(BASE64_SIMD_NEON)
+    return Base64DecodeBlocksNEON;
+#else
+    return NULL;
+#endif
+}
+
+static size_t Base64encode_len(size_t size)
+{
+    return (size == 0) ? 0 : ((((size - 1) / 3) + 1) * 4);
+}
+
+/*writes the base64 encoding of source to destination (no '\0') and returns the number of characters written*/
+static size_t Base64encode(char* destination, const unsigned char* source, size_t size)
+{
+    /*b0            b1(+1)          b2(+2)
+    7 6 5 4 3 2 1 0 7 6 5 4 3 2 1 0 7 6 5 4 3 2 1 0
+    |----c1---| |----c2---| |----c3---| |----c4---|
+    */
+    size_t currentPosition = 0;
+    size_t destinationPosition = 0;
+    BASE64_ENCODE_BLOCKS encodeBlocks;
+
+    encodeBlocks = getEncodeBlocksFunction();
+    if (encodeBlocks != NULL)
     {
-        *value = ('Z' - 'A') + 1 + ('z' - 'a') + 1 + (base64character - '0');
+        currentPosition = encodeBlocks(source, size, destination);
+        destinationPosition = currentPosition / 3 * 4;
     }
-    else if ('+' == base64character)
+
+    while (size - currentPosition >= 3)
     {
-        *value = 62;
+        destination[destinationPosition++] = base64_alphabet[source[currentPosition] >> 2];
+        destination[destinationPosition++] = base64_alphabet[((source[currentPosition] & 0x03) << 4) | (source[currentPosition + 1] >> 4)];
+        destination[destinationPosition++] = base64_alphabet[((source[currentPosition + 1] & 0x0F) << 2) | (source[currentPosition + 2] >> 6)];
+        destination[destinationPosition++] = base64_alphabet[source[currentPosition + 2] & 0x3F];
+        currentPosition += 3;
     }
-    else if ('/' == base64character)
+    if (size - currentPosition == 2)
     {
-        *value = 63;
+        destination[destinationPosition++] = base64_alphabet[source[currentPosition] >> 2];
+        destination[destinationPosition++] = base64_alphabet[((source[currentPosition] & 0x03) << 4) | (source[currentPosition + 1] >> 4)];
+        destination[destinationPosition++] = base64_alphabet[(source[currentPosition + 1] & 0x0F) << 2];
+        destination[destinationPosition++] = '=';
     }
-    else
+    else if (size - currentPosition == 1)
     {
-        *value = 0;
-        result = -1;
+        destination[destinationPosition++] = base64_alphabet[source[currentPosition] >> 2];
+        destination[destinationPosition++] = base64_alphabet[(source[currentPosition] & 0x03) << 4];
+        destination[destinationPosition++] = '=';
+        destination[destinationPosition++] = '=';
     }
-    return result;
-}
 
-static size_t numberOfBase64Characters(const char* encodedString)
-{
-    size_t length = 0;
-    unsigned char junkChar;
-    while (base64toValue(encodedString[length],&junkChar) != -1)
-    {
-        length++;
-    }
-    return length;
+    return destinationPosition;
 }
 
 /*returns the count of original bytes before being base64 encoded*/
 /*notice NO validation of the content of encodedString. Its length is validated to be a multiple of 4.*/
-static size_t Base64decode_len(const char *encodedString)
+static size_t Base64decode_len(const char *encodedString, size_t sourceLength)
 {
     size_t result;
-    size_t sourceLength = strlen(encodedString);
-    
+
     if (sourceLength == 0)
     {
         result = 0;
@@ -125,63 +388,73 @@ static size_t Base64decode_len(const char *encodedString)
     return result;
 }
 
-static void Base64decode(unsigned char *decodedString, const char *base64String)
+/*decodes the whole groups of 4 base64 characters at the start of base64String, up to the first group holding a character
+that is not part of the alphabet. Returns the number of characters decoded, a multiple of 4*/
+static size_t Base64decode_blocks(unsigned char *decodedString, const char *base64String, size_t length)
 {
+    size_t indexOfFirstEncodedChar = 0;
+    size_t decodedIndex = 0;
+    BASE64_DECODE_BLOCKS decodeBlocks;
 
-    size_t numberOfEncodedChars;
-    size_t indexOfFirstEncodedChar;
-    size_t decodedIndex;
+    decodeBlocks = getDecodeBlocksFunction();
+    if (decodeBlocks != NULL)
+    {
+        indexOfFirstEncodedChar = decodeBlocks(base64String, length, decodedString);
+        decodedIndex = indexOfFirstEncodedChar / 4 * 3;
+    }
 
     //
     // We can only operate on individual bytes.  If we attempt to work
     // on anything larger we could get an alignment fault on some
     // architectures
     //
-
-    numberOfEncodedChars = numberOfBase64Characters(base64String);
-    indexOfFirstEncodedChar = 0;
-    decodedIndex = 0;
-    while (numberOfEncodedChars >= 4)
-    {
-        unsigned char c1;
-        unsigned char c2;
-        unsigned char c3;
-        unsigned char c4;
-        (void)base64toValue(base64String[indexOfFirstEncodedChar], &c1);
-        (void)base64toValue(base64String[indexOfFirstEncodedChar + 1], &c2);
-        (void)base64toValue(base64String[indexOfFirstEncodedChar + 2], &c3);
-        (void)base64toValue(base64String[indexOfFirstEncodedChar + 3], &c4);
-        decodedString[decodedIndex] = (c1 << 2) | (c2 >> 4);
-        decodedIndex++;
-        decodedString[decodedIndex] = ((c2 & 0x0f) << 4) | (c3 >> 2);
-        decodedIndex++;
-        decodedString[decodedIndex] = ((c3 & 0x03) << 6) | c4;
-        decodedIndex++;
-        numberOfEncodedChars -= 4;
+    while (length - indexOfFirstEncodedChar >= 4)
+    {
+        int c1 = base64_values[(unsigned char)base64String[indexOfFirstEncodedChar]];
+        int c2 = base64_values[(unsigned char)base64String[indexOfFirstEncodedChar + 1]];
+        int c3 = base64_values[(unsigned char)base64String[indexOfFirstEncodedChar + 2]];
+        int c4 = base64_values[(unsigned char)base64String[indexOfFirstEncodedChar + 3]];
+        if ((c1 | c2 | c3 | c4) < 0)
+        {
+            break;
+        }
+        decodedString[decodedIndex++] = (unsigned char)((c1 << 2) | (c2 >> 4));
+        decodedString[decodedIndex++] = (unsigned char)(((c2 & 0x0f) << 4) | (c3 >> 2));
+        decodedString[decodedIndex++] = (unsigned char)(((c3 & 0x03) << 6) | c4);
         indexOfFirstEncodedChar += 4;
-
     }
 
-    if (numberOfEncodedChars == 2)
+    return indexOfFirstEncodedChar;
+}
+
+/*decodes the base64 characters at the start of base64String, up to the first character that is not part of the alphabet.
+Returns the number of characters decoded; a trailing group of 2 or 3 characters produces 1 or 2 bytes*/
+static size_t Base64decode(unsigned char *decodedString, const char *base64String, size_t length)
+{
+    size_t indexOfFirstEncodedChar = Base64decode_blocks(decodedString, base64String, length);
+    size_t decodedIndex = indexOfFirstEncodedChar / 4 * 3;
+
+    /*the group that stopped the blocks (or the last characters) may still start with 2 or 3 valid characters*/
+    int c1 = (length - indexOfFirstEncodedChar > 0) ? base64_values[(unsigned char)base64String[indexOfFirstEncodedChar]] : -1;
+    int c2 = (length - indexOfFirstEncodedChar > 1) ? base64_values[(unsigned char)base64String[indexOfFirstEncodedChar + 1]] : -1;
+    int c3 = (length - indexOfFirstEncodedChar > 2) ? base64_values[(unsigned char)base64String[indexOfFirstEncodedChar + 2]] : -1;
+    if ((c1 >= 0) && (c2 >= 0))
     {
-        unsigned char c1;
-        unsigned char c2;
-        (void)base64toValue(base64String[indexOfFirstEncodedChar], &c1);
-        (void)base64toValue(base64String[indexOfFirstEncodedChar + 1], &c2);
-        decodedString[decodedIndex] = (c1 << 2) | (c2 >> 4);
+        decodedString[decodedIndex] = (unsigned char)((c1 << 2) | (c2 >> 4));
+        indexOfFirstEncodedChar += 2;
+        if (c3 >= 0)
+        {
+            decodedIndex++;
+            decodedString[decodedIndex] = (unsigned char)(((c2 & 0x0f) << 4) | (c3 >> 2));
+            indexOfFirstEncodedChar++;
+        }
     }
-    else if (numberOfEncodedChars == 3)
+    else if (c1 >= 0)
     {
-        unsigned char c1;
-        unsigned char c2;
-        unsigned char c3;
-        (void)base64toValue(base64String[indexOfFirstEncodedChar], &c1);
-        (void)base64toValue(base64String[indexOfFirstEncodedChar + 1], &c2);
-        (void)base64toValue(base64String[indexOfFirstEncodedChar + 2], &c3);
-        decodedString[decodedIndex] = (c1 << 2) | (c2 >> 4);
-        decodedIndex++;
-        decodedString[decodedIndex] = ((c2 & 0x0f) << 4) | (c3 >> 2);
+        indexOfFirstEncodedChar++;
     }
+
+    return indexOfFirstEncodedChar;
 }
 
 BUFFER_HANDLE Base64_Decoder(const char* source)
@@ -195,7 +468,8 @@ BUFFER_HANDLE Base64_Decoder(const char* source)
     }
     else
     {
-        if ((strlen(source) % 4) != 0)
+        size_t sourceLength = strlen(source);
+        if ((sourceLength % 4) != 0)
         {
             /*Codes_SRS_BASE64_06_011: [If the source string has an invalid length for a base 64 encoded string then Base64_Decode shall return NULL.]*/
             LogError("Invalid length Base64 string!");
@@ -210,7 +484,7 @@ BUFFER_HANDLE Base64_Decoder(const char* source)
             }
             else
             {
-                size_t sizeOfOutputBuffer = Base64decode_len(source);
+                size_t sizeOfOutputBuffer = Base64decode_len(source, sourceLength);
                 /*Codes_SRS_BASE64_06_009: [If the string pointed to by source is zero length then the handle returned shall refer to a zero length buffer.]*/
                 if (sizeOfOutputBuffer > 0)
                 {
@@ -223,7 +497,7 @@ BUFFER_HANDLE Base64_Decoder(const char* source)
                     }
                     else
                     {
-                        Base64decode(BUFFER_u_char(result), source);
+                        (void)Base64decode(BUFFER_u_char(result), source, sourceLength);
                     }
                 }
             }
@@ -232,15 +506,58 @@ BUFFER_HANDLE Base64_Decoder(const char* source)
     return result;
 }
 
+int Base64_Decode_Into(const char* source, size_t sourceLength, unsigned char* destination, size_t destinationSize, size_t* decodedLength)
+{
+    int result;
+    /*Codes_SRS_BASE64_01_006: [If source or decodedLength is NULL then Base64_Decode_Into shall fail and return a non-zero value.]*/
+    if ((source == NULL) || (decodedLength == NULL))
+    {
+        LogError("invalid parameter const char* source=%p, size_t* decodedLength=%p", source, decodedLength);
+        result = __FAILURE__;
+    }
+    /*Codes_SRS_BASE64_01_007: [If sourceLength is not a multiple of 4 then Base64_Decode_Into shall fail and return a non-zero value.]*/
+    else if ((sourceLength % 4) != 0)
+    {
+        LogError("Invalid length Base64 string!");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /*Codes_SRS_BASE64_01_008: [Base64_Decode_Into shall set *decodedLength to the number of bytes encoded by source.]*/
+        *decodedLength = Base64decode_len(source, sourceLength);
+
+        /*Codes_SRS_BASE64_01_009: [If destination is NULL or destinationSize is smaller than the decoded length then Base64_Decode_Into shall fail and return a non-zero value.]*/
+        if ((destination == NULL) || (destinationSize < *decodedLength))
+        {
+            result = __FAILURE__;
+        }
+        else
+        {
+            size_t encodedCharacters = Base64decode(destination, source, sourceLength);
+            /*what is left after the characters that encode *decodedLength bytes is the '=' padding*/
+            size_t paddingCharacters = sourceLength - ((*decodedLength / 3) * 4) - (((*decodedLength % 3) == 0) ? 0 : ((*decodedLength % 3) + 1));
+
+            /*Codes_SRS_BASE64_01_010: [If source holds a character that is not part of the base64 alphabet, other than 1 or 2 '=' padding characters at its end, then Base64_Decode_Into shall fail and return a non-zero value.]*/
+            if (encodedCharacters + paddingCharacters != sourceLength)
+            {
+                LogError("Invalid character in Base64 string");
+                result = __FAILURE__;
+            }
+            else
+            {
+                /*Codes_SRS_BASE64_01_011: [Otherwise Base64_Decode_Into shall write the decoded bytes to destination without allocating any memory and return 0.]*/
+                result = 0;
+            }
+        }
+    }
+    return result;
+}
 
 static STRING_HANDLE Base64_Encode_Internal(const unsigned char* source, size_t size)
 {
     STRING_HANDLE result;
-    size_t neededSize = 0;
+    size_t neededSize = Base64encode_len(size) + 1; /*+1 because \0 at the end of the string*/
     char* encoded;
-    size_t currentPosition = 0;
-    neededSize += (size == 0) ? (0) : ((((size - 1) / 3) + 1) * 4);
-    neededSize += 1; /*+1 because \0 at the end of the string*/
     /*Codes_SRS_BASE64_06_006: [If when allocating memory to produce the encoding a failure occurs then Base64_Encoder shall return NULL.]*/
     encoded = (char*)malloc(neededSize);
     if (encoded == NULL)
@@ -250,58 +567,8 @@ static STRING_HANDLE Base64_Encode_Internal(const unsigned char* source, size_t
     }
     else
     {
-        /*b0            b1(+1)          b2(+2)
-        7 6 5 4 3 2 1 0 7 6 5 4 3 2 1 0 7 6 5 4 3 2 1 0
-        |----c1---| |----c2---| |----c3---| |----c4---|
-        */
-
-        size_t destinationPosition = 0;
-        while (size - currentPosition >= 3)
-        {
-            char c1 = base64char(source[currentPosition] >> 2);
-            char c2 = base64char(
-                ((source[currentPosition] & 3) << 4) |
-                    (source[currentPosition + 1] >> 4)
-            );
-            char c3 = base64char(
-                ((source[currentPosition + 1] & 0x0F) << 2) |
-                    ((source[currentPosition + 2] >> 6) & 3)
-            );
-            char c4 = base64char(
-                source[currentPosition + 2] & 0x3F
-            );
-            currentPosition += 3;
-            encoded[destinationPosition++] = c1;
-            encoded[destinationPosition++] = c2;
-            encoded[destinationPosition++] = c3;
-            encoded[destinationPosition++] = c4;
-
-        }
-        if (size - currentPosition == 2)
-        {
-            char c1 = base64char(source[currentPosition] >> 2);
-            char c2 = base64char(
-                ((source[currentPosition] & 0x03) << 4) |
-                    (source[currentPosition + 1] >> 4)
-            );
-            char c3 = base64b16(source[currentPosition + 1] & 0x0F);
-            encoded[destinationPosition++] = c1;
-            encoded[destinationPosition++] = c2;
-            encoded[destinationPosition++] = c3;
-            encoded[destinationPosition++] = '=';
-        }
-        else if (size - currentPosition == 1)
-        {
-            char c1 = base64char(source[currentPosition] >> 2);
-            char c2 = base64b8(source[currentPosition] & 0x03);
-            encoded[destinationPosition++] = c1;
-            encoded[destinationPosition++] = c2;
-            encoded[destinationPosition++] = '=';
-            encoded[destinationPosition++] = '=';
-        }
-
         /*null terminating the string*/
-        encoded[destinationPosition] = '\0';
+        encoded[Base64encode(encoded, source, size)] = '\0';
         /*Codes_SRS_BASE64_06_007: [Otherwise Base64_Encoder shall return a pointer to STRING, that string contains the base 64 encoding of input.]*/
         result = STRING_new_with_memory(encoded);
         if (result == NULL)
@@ -333,6 +600,35 @@ STRING_HANDLE Base64_Encode_Bytes(const unsigned char* source, size_t size)
     return result;
 }
 
+int Base64_Encode_Into(const unsigned char* source, size_t size, char* destination, size_t destinationSize, size_t* encodedLength)
+{
+    int result;
+    /*Codes_SRS_BASE64_01_001: [If source or encodedLength is NULL then Base64_Encode_Into shall fail and return a non-zero value.]*/
+    if ((source == NULL) || (encodedLength == NULL))
+    {
+        LogError("invalid parameter const unsigned char* source=%p, size_t* encodedLength=%p", source, encodedLength);
+        result = __FAILURE__;
+    }
+    else
+    {
+        /*Codes_SRS_BASE64_01_002: [Base64_Encode_Into shall set *encodedLength to the length of the base64 encoding of source, not including the null terminator.]*/
+        *encodedLength = Base64encode_len(size);
+
+        /*Codes_SRS_BASE64_01_003: [If destination is NULL or destinationSize is not larger than the encoded length then Base64_Encode_Into shall fail and return a non-zero value.]*/
+        if ((destination == NULL) || (destinationSize <= *encodedLength))
+        {
+            result = __FAILURE__;
+        }
+        else
+        {
+            /*Codes_SRS_BASE64_01_004: [Otherwise Base64_Encode_Into shall write the null terminated base64 encoding of source to destination without allocating any memory and return 0.]*/
+            destination[Base64encode(destination, source, size)] = '\0';
+            result = 0;
+        }
+    }
+    return result;
+}
+
 STRING_HANDLE Base64_Encoder(BUFFER_HANDLE input)
 {
     STRING_HANDLE result;
@@ -366,3 +662,312 @@ STRING_HANDLE Base64_Encoder(BUFFER_HANDLE input)
     }
     return result;
 }
+
+typedef struct BASE64_ENCODE_CONTEXT_TAG
+{
+    unsigned char pending[2];   /*bytes of an incomplete group, kept for the next call*/
+    size_t pendingCount;
+    int finalized;
+} BASE64_ENCODE_CONTEXT;
+
+typedef struct BASE64_DECODE_CONTEXT_TAG
+{
+    unsigned char pending[4];   /*values of the characters of an incomplete group, kept for the next call*/
+    size_t pendingCount;
+    size_t paddingCount;        /*number of '=' in the pending group*/
+    int ended;                  /*a padded group was decoded, nothing but line breaks may follow*/
+    int failed;
+    int finalized;
+} BASE64_DECODE_CONTEXT;
+
+BASE64_ENCODE_CONTEXT_HANDLE Base64_Encode_Init(void)
+{
+    /*Codes_SRS_BASE64_01_012: [Base64_Encode_Init shall allocate a context for encoding a stream of bytes and return it.]*/
+    BASE64_ENCODE_CONTEXT* result = (BASE64_ENCODE_CONTEXT*)malloc(sizeof(BASE64_ENCODE_CONTEXT));
+    if (result == NULL)
+    {
+        /*Codes_SRS_BASE64_01_013: [If allocating the context fails, Base64_Encode_Init shall return NULL.]*/
+        LogError("Base64_Encode_Init:: Allocation failed.");
+    }
+    else
+    {
+        result->pendingCount = 0;
+        result->finalized = 0;
+    }
+    return result;
+}
+
+int Base64_Encode_Update(BASE64_ENCODE_CONTEXT_HANDLE context, const unsigned char* source, size_t size, char* destination, size_t destinationSize, size_t* encodedLength)
+{
+    int result;
+    /*Codes_SRS_BASE64_01_014: [If context or encodedLength is NULL, or source is NULL while size is not zero, Base64_Encode_Update shall fail and return a non-zero value.]*/
+    if ((context == NULL) || (encodedLength == NULL) || ((source == NULL) && (size > 0)))
+    {
+        LogError("invalid parameter BASE64_ENCODE_CONTEXT_HANDLE context=%p, const unsigned char* source=%p, size_t size=%lu, size_t* encodedLength=%p",
+            context, source, (unsigned long)size, encodedLength);
+        result = __FAILURE__;
+    }
+    /*Codes_SRS_BASE64_01_015: [If Base64_Encode_Final was already called for context, Base64_Encode_Update shall fail and return a non-zero value.]*/
+    else if (context->finalized)
+    {
+        LogError("Base64_Encode_Update:: context already finalized");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /*Codes_SRS_BASE64_01_016: [Base64_Encode_Update shall set *encodedLength to the number of characters encoding the complete groups of 3 bytes formed by the bytes kept from previous calls and source.]*/
+        *encodedLength = ((context->pendingCount + size) / 3) * 4;
+
+        /*Codes_SRS_BASE64_01_017: [If characters are to be written and destination is NULL or destinationSize is smaller than *encodedLength, Base64_Encode_Update shall fail and return a non-zero value without changing context.]*/
+        if ((*encodedLength > 0) && ((destination == NULL) || (destinationSize < *encodedLength)))
+        {
+            result = __FAILURE__;
+        }
+        else
+        {
+            /*Codes_SRS_BASE64_01_018: [Otherwise Base64_Encode_Update shall write those characters to destination, without a null terminator, keep the remaining 1 or 2 bytes in context and return 0.]*/
+            size_t written = 0;
+            if ((context->pendingCount > 0) && (context->pendingCount + size >= 3))
+            {
+                unsigned char group[3];
+                size_t taken = 3 - context->pendingCount;
+                (void)memcpy(group, context->pending, context->pendingCount);
+                (void)memcpy(group + context->pendingCount, source, taken);
+                written = Base64encode(destination, group, 3);
+                source += taken;
+                size -= taken;
+                context->pendingCount = 0;
+            }
+            if ((context->pendingCount == 0) && (size >= 3))
+            {
+                size_t wholeGroups = size - (size % 3);
+                written += Base64encode(destination + written, source, wholeGroups);
+                source += wholeGroups;
+                size -= wholeGroups;
+            }
+            if (size > 0)
+            {
+                (void)memcpy(context->pending + context->pendingCount, source, size);
+                context->pendingCount += size;
+            }
+            result = 0;
+        }
+    }
+    return result;
+}
+
+int Base64_Encode_Final(BASE64_ENCODE_CONTEXT_HANDLE context, char* destination, size_t destinationSize, size_t* encodedLength)
+{
+    int result;
+    /*Codes_SRS_BASE64_01_019: [If context or encodedLength is NULL, Base64_Encode_Final shall fail and return a non-zero value.]*/
+    if ((context == NULL) || (encodedLength == NULL))
+    {
+        LogError("invalid parameter BASE64_ENCODE_CONTEXT_HANDLE context=%p, size_t* encodedLength=%p", context, encodedLength);
+        result = __FAILURE__;
+    }
+    /*Codes_SRS_BASE64_01_020: [If Base64_Encode_Final was already called for context, Base64_Encode_Final shall fail and return a non-zero value.]*/
+    else if (context->finalized)
+    {
+        LogError("Base64_Encode_Final:: context already finalized");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /*Codes_SRS_BASE64_01_021: [Base64_Encode_Final shall set *encodedLength to 4 if 1 or 2 bytes are kept in context and to 0 otherwise.]*/
+        *encodedLength = (context->pendingCount > 0) ? 4 : 0;
+
+        /*Codes_SRS_BASE64_01_022: [If characters are to be written and destination is NULL or destinationSize is smaller than *encodedLength, Base64_Encode_Final shall fail and return a non-zero value without changing context.]*/
+        if ((*encodedLength > 0) && ((destination == NULL) || (destinationSize < *encodedLength)))
+        {
+            result = __FAILURE__;
+        }
+        else
+        {
+            /*Codes_SRS_BASE64_01_023: [Otherwise Base64_Encode_Final shall write the padded encoding of the kept bytes to destination, without a null terminator, and return 0.]*/
+            if (context->pendingCount > 0)
+            {
+                (void)Base64encode(destination, context->pending, context->pendingCount);
+                context->pendingCount = 0;
+            }
+            context->finalized = 1;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+void Base64_Encode_DestroyContext(BASE64_ENCODE_CONTEXT_HANDLE context)
+{
+    /*Codes_SRS_BASE64_01_024: [Base64_Encode_DestroyContext shall free context. If context is NULL it shall do nothing.]*/
+    if (context != NULL)
+    {
+        free(context);
+    }
+}
+
+BASE64_DECODE_CONTEXT_HANDLE Base64_Decode_Init(void)
+{
+    /*Codes_SRS_BASE64_01_025: [Base64_Decode_Init shall allocate a context for decoding a stream of base64 characters and return it.]*/
+    BASE64_DECODE_CONTEXT* result = (BASE64_DECODE_CONTEXT*)malloc(sizeof(BASE64_DECODE_CONTEXT));
+    if (result == NULL)
+    {
+        /*Codes_SRS_BASE64_01_026: [If allocating the context fails, Base64_Decode_Init shall return NULL.]*/
+        LogError("Base64_Decode_Init:: Allocation failed.");
+    }
+    else
+    {
+        result->pendingCount = 0;
+        result->paddingCount = 0;
+        result->ended = 0;
+        result->failed = 0;
+        result->finalized = 0;
+    }
+    return result;
+}
+
+/*writes the bytes of the complete pending group, 1 or 2 of them when the group is padded*/
+static size_t Base64decode_pending(BASE64_DECODE_CONTEXT* context, unsigned char* destination)
+{
+    size_t result = 3 - context->paddingCount;
+    destination[0] = (unsigned char)((context->pending[0] << 2) | (context->pending[1] >> 4));
+    if (result > 1)
+    {
+        destination[1] = (unsigned char)(((context->pending[1] & 0x0f) << 4) | (context->pending[2] >> 2));
+    }
+    if (result > 2)
+    {
+        destination[2] = (unsigned char)(((context->pending[2] & 0x03) << 6) | context->pending[3]);
+    }
+    context->pendingCount = 0;
+    return result;
+}
+
+int Base64_Decode_Update(BASE64_DECODE_CONTEXT_HANDLE context, const char* source, size_t sourceLength, unsigned char* destination, size_t destinationSize, size_t* decodedLength)
+{
+    int result;
+    /*Codes_SRS_BASE64_01_027: [If context or decodedLength is NULL, or source is NULL while sourceLength is not zero, Base64_Decode_Update shall fail and return a non-zero value.]*/
+    if ((context == NULL) || (decodedLength == NULL) || ((source == NULL) && (sourceLength > 0)))
+    {
+        LogError("invalid parameter BASE64_DECODE_CONTEXT_HANDLE context=%p, const char* source=%p, size_t sourceLength=%lu, size_t* decodedLength=%p",
+            context, source, (unsigned long)sourceLength, decodedLength);
+        result = __FAILURE__;
+    }
+    /*Codes_SRS_BASE64_01_028: [If Base64_Decode_Final was already called for context, or a previous call failed, Base64_Decode_Update shall fail and return a non-zero value.]*/
+    else if (context->finalized || context->failed)
+    {
+        LogError("Base64_Decode_Update:: context already finalized or failed");
+        result = __FAILURE__;
+    }
+    /*Codes_SRS_BASE64_01_029: [If sourceLength is not zero and destination is NULL or destinationSize is smaller than ((sourceLength + 3) / 4) * 3, Base64_Decode_Update shall fail and return a non-zero value without changing context.]*/
+    else if ((sourceLength > 0) && ((destination == NULL) || (destinationSize < ((sourceLength + 3) / 4) * 3)))
+    {
+        LogError("Base64_Decode_Update:: destination too small");
+        result = __FAILURE__;
+    }
+    else
+    {
+        size_t consumed = 0;
+        size_t decoded = 0;
+        result = 0;
+
+        while ((result == 0) && (consumed < sourceLength))
+        {
+            unsigned char character;
+
+            if ((context->pendingCount == 0) && (!context->ended))
+            {
+                /*whole groups are decoded in bulk, the limit keeps the vector kernels inside destination*/
+                size_t limit = ((destinationSize - decoded) / 3) * 4;
+                size_t blockCharacters = Base64decode_blocks(destination + decoded, source + consumed,
+                    ((sourceLength - consumed) < limit) ? (sourceLength - consumed) : limit);
+                consumed += blockCharacters;
+                decoded += (blockCharacters / 4) * 3;
+                if (consumed == sourceLength)
+                {
+                    break;
+                }
+            }
+
+            character = (unsigned char)source[consumed++];
+            /*Codes_SRS_BASE64_01_030: [Base64_Decode_Update shall skip the '\r' and '\n' characters.]*/
+            if ((character == '\r') || (character == '\n'))
+            {
+                continue;
+            }
+            else if (character == '=')
+            {
+                /*Codes_SRS_BASE64_01_031: [A '=' shall only be accepted as the third or fourth character of the last group.]*/
+                if ((context->ended) || (context->pendingCount < 2))
+                {
+                    result = __FAILURE__;
+                }
+                else
+                {
+                    context->pending[context->pendingCount++] = 0;
+                    context->paddingCount++;
+                    if (context->pendingCount == 4)
+                    {
+                        decoded += Base64decode_pending(context, destination + decoded);
+                        context->ended = 1;
+                    }
+                }
+            }
+            /*Codes_SRS_BASE64_01_032: [Any other character that is not part of the base64 alphabet, or any character after the padding, shall make Base64_Decode_Update fail and return a non-zero value.]*/
+            else if ((context->ended) || (context->paddingCount > 0) || (base64_values[character] < 0))
+            {
+                result = __FAILURE__;
+            }
+            else
+            {
+                context->pending[context->pendingCount++] = (unsigned char)base64_values[character];
+                if (context->pendingCount == 4)
+                {
+                    decoded += Base64decode_pending(context, destination + decoded);
+                }
+            }
+        }
+
+        if (result != 0)
+        {
+            LogError("Base64_Decode_Update:: invalid character in base64 stream");
+            context->failed = 1;
+        }
+
+        /*Codes_SRS_BASE64_01_033: [Otherwise Base64_Decode_Update shall write the bytes of the complete groups to destination, keep the characters of an incomplete group in context, set *decodedLength to the number of bytes written and return 0.]*/
+        *decodedLength = decoded;
+    }
+    return result;
+}
+
+int Base64_Decode_Final(BASE64_DECODE_CONTEXT_HANDLE context)
+{
+    int result;
+    /*Codes_SRS_BASE64_01_034: [If context is NULL, Base64_Decode_Final shall fail and return a non-zero value.]*/
+    if (context == NULL)
+    {
+        LogError("invalid parameter BASE64_DECODE_CONTEXT_HANDLE context=NULL");
+        result = __FAILURE__;
+    }
+    /*Codes_SRS_BASE64_01_035: [If Base64_Decode_Final was already called, a call to Base64_Decode_Update failed or an incomplete group is left in context, Base64_Decode_Final shall fail and return a non-zero value.]*/
+    else if (context->finalized || context->failed || (context->pendingCount != 0))
+    {
+        LogError("Base64_Decode_Final:: truncated or invalid base64 stream");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /*Codes_SRS_BASE64_01_036: [Otherwise Base64_Decode_Final shall return 0.]*/
+        context->finalized = 1;
+        result = 0;
+    }
+    return result;
+}
+
+void Base64_Decode_DestroyContext(BASE64_DECODE_CONTEXT_HANDLE context)
+{
+    /*Codes_SRS_BASE64_01_037: [Base64_Decode_DestroyContext shall free context. If context is NULL it shall do nothing.]*/
+    if (context != NULL)
+    {
+        free(context);
+    }
+}
@@ -3,8 +3,11 @@
 
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/slaballoc.h"
+#include "azure_c_shared_utility/arena.h"
 #include "azure_c_shared_utility/buffer_.h"
 #include "azure_c_shared_utility/optimize_size.h"
 #include "azure_c_shared_utility/xlogging.h"
@@ -13,21 +16,127 @@ typedef struct BUFFER_TAG
 {
     unsigned char* buffer;
     size_t size;
+    /*number of bytes allocated for buffer, always at least head + size*/
+    size_t capacity;
+    /*number of unused bytes in front of the content, the content starts at buffer + head*/
+    size_t head;
+    /*the arena the handle and its memory come from, NULL for the heap*/
+    ARENA_HANDLE arena;
 }BUFFER;
 
+/*all the memory of a buffer goes through these, so that a buffer created in an arena never touches the heap*/
+static void* BUFFER_malloc(BUFFER* b, size_t size)
+{
+    return (b->arena == NULL) ? malloc(size) : ARENA_malloc(b->arena, size);
+}
+
+static void* BUFFER_realloc(BUFFER* b, void* ptr, size_t size)
+{
+    return (b->arena == NULL) ? realloc(ptr, size) : ARENA_realloc(b->arena, ptr, size);
+}
+
+static void BUFFER_free(BUFFER* b, void* ptr)
+{
+    if (b->arena == NULL)
+    {
+        free(ptr);
+    }
+    else
+    {
+        ARENA_free(b->arena, ptr);
+    }
+}
+
+static unsigned char* BUFFER_get_content(BUFFER* b)
+{
+    return (b->buffer == NULL) ? NULL : b->buffer + b->head;
+}
+
+/*growing geometrically keeps the number of reallocations logarithmic in the final size when a buffer is grown piece by piece*/
+static size_t BUFFER_grow_capacity(size_t capacity, size_t needed)
+{
+    size_t result = (capacity > SIZE_MAX / 2) ? SIZE_MAX : capacity * 2;
+    if (result < needed)
+    {
+        result = needed;
+    }
+    return result;
+}
+
+/*makes room for extraSize bytes after the content*/
+static int BUFFER_ensure_tailroom(BUFFER* b, size_t extraSize)
+{
+    int result;
+    if (extraSize > SIZE_MAX - b->head - b->size)
+    {
+        LogError("size overflow, size=%zu, extraSize=%zu", b->size, extraSize);
+        result = __FAILURE__;
+    }
+    else if (b->head + b->size + extraSize <= b->capacity)
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t newCapacity = BUFFER_grow_capacity(b->capacity, b->head + b->size + extraSize);
+        unsigned char* temp = (unsigned char*)BUFFER_realloc(b, b->buffer, newCapacity);
+        if (temp == NULL)
+        {
+            LogError("unable to realloc to %zu bytes", newCapacity);
+            result = __FAILURE__;
+        }
+        else
+        {
+            b->buffer = temp;
+            b->capacity = newCapacity;
+            result = 0;
+        }
+    }
+    return result;
+}
+
 /* Codes_SRS_BUFFER_07_001: [BUFFER_new shall allocate a BUFFER_HANDLE that will contain a NULL unsigned char*.] */
 BUFFER_HANDLE BUFFER_new(void)
 {
-    BUFFER* temp = (BUFFER*)malloc(sizeof(BUFFER));
+    BUFFER* temp = (BUFFER*)SLABALLOC_MALLOC(sizeof(BUFFER));
     /* Codes_SRS_BUFFER_07_002: [BUFFER_new shall return NULL on any error that occurs.] */
     if (temp != NULL)
     {
         temp->buffer = NULL;
         temp->size = 0;
+        temp->capacity = 0;
+        temp->head = 0;
+        temp->arena = NULL;
     }
     return (BUFFER_HANDLE)temp;
 }
 
+BUFFER_HANDLE BUFFER_new_in_arena(ARENA_HANDLE arena)
+{
+    BUFFER* result;
+    if (arena == NULL)
+    {
+        /*Codes_SRS_BUFFER_01_037: [If arena is NULL, BUFFER_new_in_arena shall fail and return NULL.]*/
+        LogError("Invalid argument: arena=NULL");
+        result = NULL;
+    }
+    /*Codes_SRS_BUFFER_01_038: [BUFFER_new_in_arena shall allocate an empty BUFFER_HANDLE with ARENA_malloc, all the memory the buffer needs later shall also be allocated, grown and freed with ARENA_malloc, ARENA_realloc and ARENA_free.]*/
+    else if ((result = (BUFFER*)ARENA_malloc(arena, sizeof(BUFFER))) == NULL)
+    {
+        /*Codes_SRS_BUFFER_01_039: [If ARENA_malloc fails, BUFFER_new_in_arena shall fail and return NULL.]*/
+        LogError("unable to allocate the buffer from the arena");
+    }
+    else
+    {
+        result->buffer = NULL;
+        result->size = 0;
+        result->capacity = 0;
+        result->head = 0;
+        result->arena = arena;
+    }
+    return (BUFFER_HANDLE)result;
+}
+
 static int BUFFER_safemalloc(BUFFER* handleptr, size_t size)
 {
     int result;
@@ -36,7 +145,7 @@ static int BUFFER_safemalloc(BUFFER* handleptr, size_t size)
     {
         sizetomalloc = 1;
     }
-    handleptr->buffer = (unsigned char*)malloc(sizetomalloc);
+    handleptr->buffer = (unsigned char*)BUFFER_malloc(handleptr, sizetomalloc);
     if (handleptr->buffer == NULL)
     {
         /*Codes_SRS_BUFFER_02_003: [If allocating memory fails, then BUFFER_create shall return NULL.]*/
@@ -46,6 +155,8 @@ static int BUFFER_safemalloc(BUFFER* handleptr, size_t size)
     {
         // we still consider the real buffer size is 0
         handleptr->size = size;
+        handleptr->capacity = sizetomalloc;
+        handleptr->head = 0;
         result = 0;
     }
     return result;
@@ -62,7 +173,7 @@ BUFFER_HANDLE BUFFER_create(const unsigned char* source, size_t size)
     else
     {
         /*Codes_SRS_BUFFER_02_002: [Otherwise, BUFFER_create shall allocate memory to hold size bytes and shall copy from source size bytes into the newly allocated memory.] */
-        result = (BUFFER*)malloc(sizeof(BUFFER));
+        result = (BUFFER*)SLABALLOC_MALLOC(sizeof(BUFFER));
         if (result == NULL)
         {
             /*Codes_SRS_BUFFER_02_003: [If allocating memory fails, then BUFFER_create shall return NULL.] */
@@ -70,11 +181,12 @@ BUFFER_HANDLE BUFFER_create(const unsigned char* source, size_t size)
         }
         else
         {
+            result->arena = NULL;
             /* Codes_SRS_BUFFER_02_005: [If size parameter is 0 then 1 byte of memory shall be allocated yet size of the buffer shall be set to 0.]*/
             if (BUFFER_safemalloc(result, size) != 0)
             {
                 LogError("unable to BUFFER_safemalloc ");
-                free(result);
+                SLABALLOC_FREE(result);
                 result = NULL;
             }
             else
@@ -87,6 +199,37 @@ BUFFER_HANDLE BUFFER_create(const unsigned char* source, size_t size)
     return (BUFFER_HANDLE)result;
 }
 
+BUFFER_HANDLE BUFFER_create_with_moved_memory(unsigned char* buffer, size_t size)
+{
+    BUFFER* result;
+    if ((buffer == NULL) && (size != 0))
+    {
+        /*Codes_SRS_BUFFER_01_006: [If buffer is NULL and size is different than 0 then BUFFER_create_with_moved_memory shall fail and return NULL.]*/
+        LogError("Invalid arguments: buffer=%p, size=%zu", buffer, size);
+        result = NULL;
+    }
+    else
+    {
+        result = (BUFFER*)SLABALLOC_MALLOC(sizeof(BUFFER));
+        if (result == NULL)
+        {
+            /*Codes_SRS_BUFFER_01_008: [If any error occurs, BUFFER_create_with_moved_memory shall fail, return NULL and leave the ownership of buffer with the caller.]*/
+            LogError("unable to malloc");
+            /*return as is*/
+        }
+        else
+        {
+            /*Codes_SRS_BUFFER_01_007: [BUFFER_create_with_moved_memory shall allocate a new BUFFER_HANDLE that takes ownership of buffer and size without copying the bytes.]*/
+            result->buffer = buffer;
+            result->size = size;
+            result->capacity = size;
+            result->head = 0;
+            result->arena = NULL;
+        }
+    }
+    return (BUFFER_HANDLE)result;
+}
+
 /* Codes_SRS_BUFFER_07_003: [BUFFER_delete shall delete the data associated with the BUFFER_HANDLE along with the Buffer.] */
 void BUFFER_delete(BUFFER_HANDLE handle)
 {
@@ -97,9 +240,17 @@ void BUFFER_delete(BUFFER_HANDLE handle)
         if (b->buffer != NULL)
         {
             /* Codes_SRS_BUFFER_07_003: [BUFFER_delete shall delete the data associated with the BUFFER_HANDLE along with the Buffer.] */
-            free(b->buffer);
+            BUFFER_free(b, b->buffer);
+        }
+        if (b->arena == NULL)
+        {
+            SLABALLOC_FREE(b);
+        }
+        else
+        {
+            /* Codes_SRS_BUFFER_01_040: [If the buffer was created by BUFFER_new_in_arena, BUFFER_delete shall give its memory back with ARENA_free.] */
+            ARENA_free(b->arena, b);
         }
-        free(b);
     }
 }
 
@@ -119,9 +270,11 @@ int BUFFER_build(BUFFER_HANDLE handle, const unsigned char* source, size_t size)
     {
         /* Codes_SRS_BUFFER_01_003: [If size is zero, source can be NULL.] */
         BUFFER* b = (BUFFER*)handle;
-        free(b->buffer);
+        BUFFER_free(b, b->buffer);
         b->buffer = NULL;
         b->size = 0;
+        b->capacity = 0;
+        b->head = 0;
 
         result = 0;
     }
@@ -135,21 +288,36 @@ int BUFFER_build(BUFFER_HANDLE handle, const unsigned char* source, size_t size)
         else
         {
             BUFFER* b = (BUFFER*)handle;
-            /* Codes_SRS_BUFFER_07_011: [BUFFER_build shall overwrite previous contents if the buffer has been previously allocated.] */
-            unsigned char* newBuffer = (unsigned char*)realloc(b->buffer, size);
-            if (newBuffer == NULL)
+            if (size <= b->capacity)
             {
-                /* Codes_SRS_BUFFER_07_010: [BUFFER_build shall return nonzero if any error is encountered.] */
-                result = __FAILURE__;
+                /* Codes_SRS_BUFFER_01_021: [If size is not greater than the capacity of the buffer, BUFFER_build shall copy source into the memory already allocated without reallocating it.] */
+                /* Codes_SRS_BUFFER_07_011: [BUFFER_build shall overwrite previous contents if the buffer has been previously allocated.] */
+                (void)memcpy(b->buffer, source, size);
+                b->size = size;
+                b->head = 0;
+
+                result = 0;
             }
             else
             {
-                b->buffer = newBuffer;
-                b->size = size;
-                /* Codes_SRS_BUFFER_01_002: [The size argument can be zero, in which case nothing shall be copied from source.] */
-                (void)memcpy(b->buffer, source, size);
+                /* Codes_SRS_BUFFER_07_011: [BUFFER_build shall overwrite previous contents if the buffer has been previously allocated.] */
+                unsigned char* newBuffer = (unsigned char*)BUFFER_realloc(b, b->buffer, size);
+                if (newBuffer == NULL)
+                {
+                    /* Codes_SRS_BUFFER_07_010: [BUFFER_build shall return nonzero if any error is encountered.] */
+                    result = __FAILURE__;
+                }
+                else
+                {
+                    b->buffer = newBuffer;
+                    b->size = size;
+                    b->capacity = size;
+                    b->head = 0;
+                    /* Codes_SRS_BUFFER_01_002: [The size argument can be zero, in which case nothing shall be copied from source.] */
+                    (void)memcpy(b->buffer, source, size);
 
-                result = 0;
+                    result = 0;
+                }
             }
         }
     }
@@ -183,7 +351,7 @@ int BUFFER_pre_build(BUFFER_HANDLE handle, size_t size)
         }
         else
         {
-            if ((b->buffer = (unsigned char*)malloc(size)) == NULL)
+            if ((b->buffer = (unsigned char*)BUFFER_malloc(b, size)) == NULL)
             {
                 /* Codes_SRS_BUFFER_07_013: [BUFFER_pre_build shall return nonzero if any error is encountered.] */
                 result = __FAILURE__;
@@ -191,6 +359,8 @@ int BUFFER_pre_build(BUFFER_HANDLE handle, size_t size)
             else
             {
                 b->size = size;
+                b->capacity = size;
+                b->head = 0;
                 result = 0;
             }
         }
@@ -210,7 +380,7 @@ int BUFFER_content(BUFFER_HANDLE handle, const unsigned char** content)
     else
     {
         BUFFER* b = (BUFFER*)handle;
-        *content = b->buffer;
+        *content = BUFFER_get_content(b);
         result = 0;
     }
     return result;
@@ -231,9 +401,11 @@ extern int BUFFER_unbuild(BUFFER_HANDLE handle)
         BUFFER* b = (BUFFER*)handle;
         if (b->buffer != NULL)
         {
-            free(b->buffer);
+            BUFFER_free(b, b->buffer);
             b->buffer = NULL;
             b->size = 0;
+            b->capacity = 0;
+            b->head = 0;
             result = 0;
         }
         else
@@ -262,15 +434,16 @@ int BUFFER_enlarge(BUFFER_HANDLE handle, size_t enlargeSize)
     else
     {
         BUFFER* b = (BUFFER*)handle;
-        unsigned char* temp = (unsigned char*)realloc(b->buffer, b->size + enlargeSize);
-        if (temp == NULL)
+        /* Codes_SRS_BUFFER_01_022: [If the new size fits in the memory allocated after the headroom, BUFFER_enlarge shall not reallocate the memory.] */
+        /* Codes_SRS_BUFFER_01_026: [Otherwise BUFFER_enlarge shall grow the memory to the larger of twice its capacity and the number of bytes needed.] */
+        if (BUFFER_ensure_tailroom(b, enlargeSize) != 0)
         {
+            /* Codes_SRS_BUFFER_01_025: [If the new size would overflow a size_t, BUFFER_enlarge shall fail and return a nonzero result.] */
             /* Codes_SRS_BUFFER_07_018: [BUFFER_enlarge shall return a nonzero result if any error is encountered.] */
             result = __FAILURE__;
         }
         else
         {
-            b->buffer = temp;
             b->size += enlargeSize;
             result = 0;
         }
@@ -329,8 +502,9 @@ int BUFFER_append(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
             else
             {
                 // b2->size != 0, whatever b1->size is
-                unsigned char* temp = (unsigned char*)realloc(b1->buffer, b1->size + b2->size);
-                if (temp == NULL)
+                /* Codes_SRS_BUFFER_01_023: [If the concatenated content fits in the memory allocated after the headroom of handle1, BUFFER_append shall not reallocate the memory.] */
+                /* Codes_SRS_BUFFER_01_027: [Otherwise BUFFER_append shall grow the memory of handle1 to the larger of twice its capacity and the number of bytes needed.] */
+                if (BUFFER_ensure_tailroom(b1, b2->size) != 0)
                 {
                     /* Codes_SRS_BUFFER_07_023: [BUFFER_append shall return a nonzero upon any error that is encountered.] */
                     result = __FAILURE__;
@@ -338,9 +512,8 @@ int BUFFER_append(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
                 else
                 {
                     /* Codes_SRS_BUFFER_07_024: [BUFFER_append concatenates b2 onto b1 without modifying b2 and shall return zero on success.]*/
-                    b1->buffer = temp;
                     // Append the BUFFER
-                    (void)memcpy(&b1->buffer[b1->size], b2->buffer, b2->size);
+                    (void)memcpy(&b1->buffer[b1->head + b1->size], BUFFER_get_content(b2), b2->size);
                     b1->size += b2->size;
                     result = 0;
                 }
@@ -380,10 +553,37 @@ int BUFFER_prepend(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
                 // do nothing
                 result = 0;
             }
+            else if (b2->size <= b1->head)
+            {
+                /* Codes_SRS_BUFFER_01_028: [If handle1 has at least as many unused bytes in front of its content as the size of handle2, BUFFER_prepend shall copy the content of handle2 there without moving the content of handle1.] */
+                b1->head -= b2->size;
+                (void)memcpy(&b1->buffer[b1->head], BUFFER_get_content(b2), b2->size);
+                b1->size += b2->size;
+                result = 0;
+            }
+            else if (b2->size > SIZE_MAX - b1->size)
+            {
+                /* Codes_SRS_BUFFER_01_005: [ BUFFER_prepend shall return a non-zero upon value any error that is encountered. ]*/
+                LogError("size overflow, size1=%zu, size2=%zu", b1->size, b2->size);
+                result = __FAILURE__;
+            }
+            else if (b1->size + b2->size <= b1->capacity)
+            {
+                /* Codes_SRS_BUFFER_01_024: [If the concatenated content fits in the capacity of handle1, BUFFER_prepend shall move the content of handle1 in place without allocating memory.] */
+                /* Codes_SRS_BUFFER_01_029: [When BUFFER_prepend moves the content or allocates new memory, it shall split the unused capacity evenly between the front and the back of the content.] */
+                size_t newHead = (b1->capacity - b1->size - b2->size) / 2;
+                (void)memmove(&b1->buffer[newHead + b2->size], &b1->buffer[b1->head], b1->size);
+                (void)memcpy(&b1->buffer[newHead], BUFFER_get_content(b2), b2->size);
+                b1->head = newHead;
+                b1->size += b2->size;
+                result = 0;
+            }
             else
             {
                 // b2->size != 0
-                unsigned char* temp = (unsigned char*)malloc(b1->size + b2->size);
+                /* Codes_SRS_BUFFER_01_030: [Otherwise BUFFER_prepend shall allocate the larger of twice the capacity of handle1 and the number of bytes needed.] */
+                size_t newCapacity = BUFFER_grow_capacity(b1->capacity, b1->size + b2->size);
+                unsigned char* temp = (unsigned char*)BUFFER_malloc(b1, newCapacity);
                 if (temp == NULL)
                 {
                     /* Codes_SRS_BUFFER_01_005: [ BUFFER_prepend shall return a non-zero upon value any error that is encountered. ]*/
@@ -392,13 +592,17 @@ int BUFFER_prepend(BUFFER_HANDLE handle1, BUFFER_HANDLE handle2)
                 else
                 {
                     /* Codes_SRS_BUFFER_01_004: [ BUFFER_prepend concatenates handle1 onto handle2 without modifying handle1 and shall return zero on success. ]*/
+                    /* Codes_SRS_BUFFER_01_029: [When BUFFER_prepend moves the content or allocates new memory, it shall split the unused capacity evenly between the front and the back of the content.] */
+                    size_t newHead = (newCapacity - b1->size - b2->size) / 2;
                     // Append the BUFFER
-                    (void)memcpy(temp, b2->buffer, b2->size);
+                    (void)memcpy(&temp[newHead], BUFFER_get_content(b2), b2->size);
                     // start from b1->size to append b1
-                    (void)memcpy(&temp[b2->size], b1->buffer, b1->size);
-                    free(b1->buffer);
+                    (void)memcpy(&temp[newHead + b2->size], BUFFER_get_content(b1), b1->size);
+                    BUFFER_free(b1, b1->buffer);
                     b1->buffer = temp;
                     b1->size += b2->size;
+                    b1->capacity = newCapacity;
+                    b1->head = newHead;
                     result = 0;
                 }
             }
@@ -421,7 +625,7 @@ unsigned char* BUFFER_u_char(BUFFER_HANDLE handle)
     }
     else
     {
-        result = handleData->buffer;
+        result = BUFFER_get_content(handleData);
     }
     return result;
 }
@@ -453,16 +657,18 @@ BUFFER_HANDLE BUFFER_clone(BUFFER_HANDLE handle)
     else
     {
         BUFFER* suppliedBuff = (BUFFER*)handle;
-        BUFFER* b = (BUFFER*)malloc(sizeof(BUFFER));
+        BUFFER* b = (BUFFER*)SLABALLOC_MALLOC(sizeof(BUFFER));
         if (b != NULL)
         {
+            /*Codes_SRS_BUFFER_01_041: [The clone of a buffer created by BUFFER_new_in_arena shall be allocated with malloc, it does not depend on the arena.]*/
+            b->arena = NULL;
             if (BUFFER_safemalloc(b, suppliedBuff->size) != 0)
             {
                 result = NULL;
             }
             else
             {
-                (void)memcpy(b->buffer, suppliedBuff->buffer, suppliedBuff->size);
+                (void)memcpy(b->buffer, BUFFER_get_content(suppliedBuff), suppliedBuff->size);
                 b->size = suppliedBuff->size;
                 result = (BUFFER_HANDLE)b;
             }
@@ -474,3 +680,199 @@ BUFFER_HANDLE BUFFER_clone(BUFFER_HANDLE handle)
     }
     return result;
 }
+
+int BUFFER_transfer(BUFFER_HANDLE handle, unsigned char** buffer, size_t* size)
+{
+    int result;
+    if ((handle == NULL) || (buffer == NULL) || (size == NULL))
+    {
+        /*Codes_SRS_BUFFER_01_009: [If handle, buffer or size is NULL, BUFFER_transfer shall fail and return a non-zero value.]*/
+        LogError("Invalid arguments: handle=%p, buffer=%p, size=%p", handle, buffer, size);
+        result = __FAILURE__;
+    }
+    else
+    {
+        BUFFER* b = (BUFFER*)handle;
+        if (b->arena != NULL)
+        {
+            /*Codes_SRS_BUFFER_01_042: [If the buffer was created by BUFFER_new_in_arena, BUFFER_transfer shall hand the caller a copy of the content allocated with malloc instead, since the memory of the arena cannot be given to free.]*/
+            unsigned char* copy = (unsigned char*)malloc((b->size == 0) ? 1 : b->size);
+            if (copy == NULL)
+            {
+                /*Codes_SRS_BUFFER_01_043: [If allocating the copy fails, BUFFER_transfer shall fail, return a non-zero value and leave the buffer unchanged.]*/
+                LogError("unable to allocate %zu bytes", b->size);
+                result = __FAILURE__;
+            }
+            else
+            {
+                if (b->size != 0)
+                {
+                    (void)memcpy(copy, BUFFER_get_content(b), b->size);
+                }
+                *buffer = copy;
+                *size = b->size;
+                ARENA_free(b->arena, b->buffer);
+                b->buffer = NULL;
+                b->size = 0;
+                b->capacity = 0;
+                b->head = 0;
+                result = 0;
+            }
+        }
+        else
+        {
+            if (b->head != 0)
+            {
+                /*Codes_SRS_BUFFER_01_035: [If there are unused bytes in front of the content, BUFFER_transfer shall first move the content to the beginning of the memory.]*/
+                (void)memmove(b->buffer, &b->buffer[b->head], b->size);
+            }
+
+            /*Codes_SRS_BUFFER_01_010: [BUFFER_transfer shall hand the underlying memory and its size to the caller, who becomes responsible for freeing it with free, and return 0.]*/
+            *buffer = b->buffer;
+            *size = b->size;
+            /*Codes_SRS_BUFFER_01_011: [BUFFER_transfer shall leave handle empty, as if it had been created with BUFFER_new.]*/
+            b->buffer = NULL;
+            b->size = 0;
+            b->capacity = 0;
+            b->head = 0;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+int BUFFER_reserve(BUFFER_HANDLE handle, size_t capacity)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /*Codes_SRS_BUFFER_01_012: [If handle is NULL, BUFFER_reserve shall fail and return a non-zero value.]*/
+        LogError("Invalid arguments: handle=%p, capacity=%zu", handle, capacity);
+        result = __FAILURE__;
+    }
+    else
+    {
+        BUFFER* b = (BUFFER*)handle;
+        if (capacity <= b->capacity - b->head)
+        {
+            /*Codes_SRS_BUFFER_01_013: [If capacity bytes already fit in the memory allocated after the headroom, BUFFER_reserve shall succeed without allocating memory.]*/
+            result = 0;
+        }
+        else if (capacity > SIZE_MAX - b->head)
+        {
+            /*Codes_SRS_BUFFER_01_015: [If any error occurs, BUFFER_reserve shall fail, return a non-zero value and leave the buffer unchanged.]*/
+            LogError("size overflow, head=%zu, capacity=%zu", b->head, capacity);
+            result = __FAILURE__;
+        }
+        else
+        {
+            /*Codes_SRS_BUFFER_01_014: [Otherwise BUFFER_reserve shall reallocate the memory so that capacity bytes fit after the headroom, keeping the content and size, and return 0.]*/
+            unsigned char* temp = (unsigned char*)BUFFER_realloc(b, b->buffer, b->head + capacity);
+            if (temp == NULL)
+            {
+                /*Codes_SRS_BUFFER_01_015: [If any error occurs, BUFFER_reserve shall fail, return a non-zero value and leave the buffer unchanged.]*/
+                LogError("unable to realloc to %zu bytes", b->head + capacity);
+                result = __FAILURE__;
+            }
+            else
+            {
+                b->buffer = temp;
+                b->capacity = b->head + capacity;
+                result = 0;
+            }
+        }
+    }
+    return result;
+}
+
+int BUFFER_shrink(BUFFER_HANDLE handle, size_t decreaseSize, bool fromEnd)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /*Codes_SRS_BUFFER_01_016: [If handle is NULL, BUFFER_shrink shall fail and return a non-zero value.]*/
+        LogError("Invalid arguments: handle=%p", handle);
+        result = __FAILURE__;
+    }
+    else
+    {
+        BUFFER* b = (BUFFER*)handle;
+        if ((decreaseSize == 0) || (decreaseSize > b->size))
+        {
+            /*Codes_SRS_BUFFER_01_017: [If decreaseSize is 0 or greater than the size of the buffer, BUFFER_shrink shall fail and return a non-zero value.]*/
+            LogError("Invalid decreaseSize=%zu, size=%zu", decreaseSize, b->size);
+            result = __FAILURE__;
+        }
+        else
+        {
+            /*Codes_SRS_BUFFER_01_018: [If fromEnd is true, BUFFER_shrink shall remove the last decreaseSize bytes of the buffer.]*/
+            /*Codes_SRS_BUFFER_01_020: [BUFFER_shrink shall not reallocate the memory, the capacity of the buffer is kept.]*/
+            b->size -= decreaseSize;
+
+            if (!fromEnd)
+            {
+                /*Codes_SRS_BUFFER_01_019: [Otherwise BUFFER_shrink shall remove the first decreaseSize bytes by skipping them, without moving the remaining bytes.]*/
+                b->head += decreaseSize;
+
+                if (b->head > b->capacity / 2)
+                {
+                    /*Codes_SRS_BUFFER_01_036: [If after that more than half of the capacity is in front of the content, BUFFER_shrink shall move the content to the beginning of the memory.]*/
+                    (void)memmove(b->buffer, &b->buffer[b->head], b->size);
+                    b->head = 0;
+                }
+            }
+
+            result = 0;
+        }
+    }
+    return result;
+}
+
+int BUFFER_reserve_front(BUFFER_HANDLE handle, size_t headroom)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /*Codes_SRS_BUFFER_01_031: [If handle is NULL, BUFFER_reserve_front shall fail and return a non-zero value.]*/
+        LogError("Invalid arguments: handle=%p, headroom=%zu", handle, headroom);
+        result = __FAILURE__;
+    }
+    else
+    {
+        BUFFER* b = (BUFFER*)handle;
+        /*the bytes after the content are kept, so that reserving room for a header does not cost the room already reserved for the payload*/
+        size_t tailroom = b->capacity - b->head - b->size;
+        if (headroom <= b->head)
+        {
+            /*Codes_SRS_BUFFER_01_032: [If the buffer already has headroom unused bytes in front of its content, BUFFER_reserve_front shall succeed without allocating memory.]*/
+            result = 0;
+        }
+        else if (headroom > SIZE_MAX - b->size - tailroom)
+        {
+            /*Codes_SRS_BUFFER_01_034: [If any error occurs, BUFFER_reserve_front shall fail, return a non-zero value and leave the buffer unchanged.]*/
+            LogError("size overflow, size=%zu, headroom=%zu", b->size, headroom);
+            result = __FAILURE__;
+        }
+        else
+        {
+            /*Codes_SRS_BUFFER_01_033: [Otherwise BUFFER_reserve_front shall reallocate the memory so that headroom unused bytes are in front of the content, keeping the content, its size and the unused bytes after it, and return 0.]*/
+            size_t newCapacity = headroom + b->size + tailroom;
+            unsigned char* temp = (unsigned char*)BUFFER_realloc(b, b->buffer, newCapacity);
+            if (temp == NULL)
+            {
+                /*Codes_SRS_BUFFER_01_034: [If any error occurs, BUFFER_reserve_front shall fail, return a non-zero value and leave the buffer unchanged.]*/
+                LogError("unable to realloc to %zu bytes", newCapacity);
+                result = __FAILURE__;
+            }
+            else
+            {
+                (void)memmove(&temp[headroom], &temp[b->head], b->size);
+                b->buffer = temp;
+                b->capacity = newCapacity;
+                b->head = headroom;
+                result = 0;
+            }
+        }
+    }
+    return result;
+}
@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
+#include <stdlib.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include <string.h>
 #include "azure_c_shared_utility/connection_string_parser.h"
 #include "azure_c_shared_utility/map.h"
 #include "azure_c_shared_utility/strings.h"
@@ -10,21 +13,104 @@
 #include "azure_c_shared_utility/xlogging.h"
 
 
+static MAP_HANDLE parse_key_value_pairs(const char* connection_string, size_t length)
+{
+    MAP_HANDLE result;
+    /* Codes_SRS_CONNECTIONSTRINGPARSER_01_003: [connectionstringparser_parse shall make a single copy of the connection string, in which the key and value tokens are '\0' terminated in place.] */
+    char* pairs = (char*)malloc(length + 1);
+    if (pairs == NULL)
+    {
+        /* Codes_SRS_CONNECTIONSTRINGPARSER_01_015: [If allocating the copy of the connection string fails, connectionstringparser_parse shall fail and return NULL.] */
+        result = NULL;
+        LogError("Error allocating a copy of the connection string.");
+    }
+    else
+    {
+        (void)memcpy(pairs, connection_string, length);
+        pairs[length] = '\0';
+
+        result = Map_Create(NULL);
+        if (result == NULL)
+        {
+            /* Codes_SRS_CONNECTIONSTRINGPARSER_01_018: [If creating the result map fails, then connectionstringparser_parse shall return NULL.] */
+            LogError("Error creating Map.");
+        }
+        else
+        {
+            /* Codes_SRS_CONNECTIONSTRINGPARSER_01_004: [connectionstringparser_parse shall start scanning at the beginning of the connection string.] */
+            STRING_VIEW remaining;
+            STRING_VIEW key;
+            STRING_VIEW value;
+
+            remaining.str = pairs;
+            remaining.length = length;
+
+            /* Codes_SRS_CONNECTIONSTRINGPARSER_01_005: [The following actions shall be repeated until parsing is complete:] */
+            /* Codes_SRS_CONNECTIONSTRINGPARSER_01_006: [connectionstringparser_parse shall find a token (the key of the key/value pair) delimited by the `=` character, by calling STRING_VIEW_get_next_token.] */
+            /* Codes_SRS_CONNECTIONSTRINGPARSER_01_007: [If STRING_VIEW_get_next_token fails, parsing shall be considered complete.] */
+            while (STRING_VIEW_get_next_token(&remaining, &key, "=") == 0)
+            {
+                bool is_error = false;
+
+                /* Codes_SRS_CONNECTIONSTRINGPARSER_01_008: [connectionstringparser_parse shall find a token (the value of the key/value pair) delimited by the `;` character, by calling STRING_VIEW_get_next_token.] */
+                if (STRING_VIEW_get_next_token(&remaining, &value, ";") != 0)
+                {
+                    /* Codes_SRS_CONNECTIONSTRINGPARSER_01_009: [If STRING_VIEW_get_next_token fails, connectionstringparser_parse shall fail and return NULL (freeing the allocated result map).] */
+                    is_error = true;
+                    LogError("Error reading value token from the connection string.");
+                }
+                /* Codes_SRS_CONNECTIONSTRINGPARSER_01_019: [If the key length is zero then connectionstringparser_parse shall fail and return NULL (freeing the allocated result map).] */
+                else if (key.length == 0)
+                {
+                    is_error = true;
+                    LogError("The key token is empty.");
+                }
+                else
+                {
+                    /* Codes_SRS_CONNECTIONSTRINGPARSER_01_011: [The key and value shall be '\0' terminated in the copy of the connection string, over the delimiter that ends them.] */
+                    pairs[(key.str - pairs) + key.length] = '\0';
+                    pairs[(value.str - pairs) + value.length] = '\0';
+
+                    /* Codes_SRS_CONNECTIONSTRINGPARSER_01_010: [The key and value shall be added to the result map by using Map_Add.] */
+                    if (Map_Add(result, key.str, value.str) != MAP_OK)
+                    {
+                        /* Codes_SRS_CONNECTIONSTRINGPARSER_01_012: [If Map_Add fails connectionstringparser_parse shall fail and return NULL (freeing the allocated result map).] */
+                        is_error = true;
+                        LogError("Could not add the key/value pair to the result map.");
+                    }
+                }
+
+                if (is_error)
+                {
+                    LogError("Error parsing connection string.");
+                    Map_Destroy(result);
+                    result = NULL;
+                    break;
+                }
+            }
+        }
+
+        /* Codes_SRS_CONNECTIONSTRINGPARSER_01_014: [After the parsing is complete the copy of the connection string shall be freed.] */
+        free(pairs);
+    }
+
+    return result;
+}
+
 MAP_HANDLE connectionstringparser_parse_from_char(const char* connection_string)
 {
     MAP_HANDLE result;
-    STRING_HANDLE connString = NULL;
 
-    /* Codes_SRS_CONNECTIONSTRINGPARSER_21_020: [connectionstringparser_parse_from_char shall create a STRING_HANDLE from the connection_string passed in as argument and parse it using the connectionstringparser_parse.]*/
-    if ((connString = STRING_construct(connection_string)) == NULL)
+    if (connection_string == NULL)
     {
-        /* Codes_SRS_CONNECTIONSTRINGPARSER_21_021: [If connectionstringparser_parse_from_char get error creating a STRING_HANDLE, it shall return NULL.]*/
-        LogError("Error constructing connection String");
+        /* Codes_SRS_CONNECTIONSTRINGPARSER_21_021: [If connection_string is NULL, connectionstringparser_parse_from_char shall return NULL.]*/
+        LogError("NULL connection string.");
         result = NULL;
     }
     else
     {
-        result = connectionstringparser_parse(connString);
+        /* Codes_SRS_CONNECTIONSTRINGPARSER_21_020: [connectionstringparser_parse_from_char shall parse the connection_string passed in as argument the same way connectionstringparser_parse does, without creating a STRING_HANDLE.]*/
+        result = parse_key_value_pairs(connection_string, strlen(connection_string));
     }
 
     return result;
@@ -44,111 +130,17 @@ MAP_HANDLE connectionstringparser_parse(STRING_HANDLE connection_string)
     }
     else
     {
-        /* Codes_SRS_CONNECTIONSTRINGPARSER_01_003: [connectionstringparser_parse shall create a STRING tokenizer to be used for parsing the connection string, by calling STRING_TOKENIZER_create.] */
-        /* Codes_SRS_CONNECTIONSTRINGPARSER_01_004: [connectionstringparser_parse shall start scanning at the beginning of the connection string.] */
-        STRING_TOKENIZER_HANDLE tokenizer = STRING_TOKENIZER_create(connection_string);
-        if (tokenizer == NULL)
+        /* Codes_SRS_CONNECTIONSTRINGPARSER_01_020: [connectionstringparser_parse shall obtain the characters of connection_string by calling STRING_c_str and STRING_length.] */
+        const char* characters = STRING_c_str(connection_string);
+        if (characters == NULL)
         {
-            /* Codes_SRS_CONNECTIONSTRINGPARSER_01_015: [If STRING_TOKENIZER_create fails, connectionstringparser_parse shall fail and return NULL.] */
+            /* Codes_SRS_CONNECTIONSTRINGPARSER_01_013: [If STRING_c_str fails then connectionstringparser_parse shall fail and return NULL.] */
             result = NULL;
-            LogError("Error creating STRING tokenizer.");
+            LogError("Could not get the C string of the connection string.");
         }
         else
         {
-            /* Codes_SRS_CONNECTIONSTRINGPARSER_01_016: [2 STRINGs shall be allocated in order to hold the to be parsed key and value tokens.] */
-            STRING_HANDLE token_key_string = STRING_new();
-            if (token_key_string == NULL)
-            {
-                /* Codes_SRS_CONNECTIONSTRINGPARSER_01_017: [If allocating the STRINGs fails connectionstringparser_parse shall fail and return NULL.] */
-                result = NULL;
-                LogError("Error creating key token STRING.");
-            }
-            else
-            {
-                STRING_HANDLE token_value_string = STRING_new();
-                if (token_value_string == NULL)
-                {
-                    /* Codes_SRS_CONNECTIONSTRINGPARSER_01_017: [If allocating the STRINGs fails connectionstringparser_parse shall fail and return NULL.] */
-                    result = NULL;
-                    LogError("Error creating value token STRING.");
-                }
-                else
-                {
-                    result = Map_Create(NULL);
-                    if (result == NULL)
-                    {
-                        /* Codes_SRS_CONNECTIONSTRINGPARSER_01_018: [If creating the result map fails, then connectionstringparser_parse shall return NULL.] */
-                        LogError("Error creating Map.");
-                    }
-                    else
-                    {
-                        /* Codes_SRS_CONNECTIONSTRINGPARSER_01_005: [The following actions shall be repeated until parsing is complete:] */
-                        /* Codes_SRS_CONNECTIONSTRINGPARSER_01_006: [connectionstringparser_parse shall find a token (the key of the key/value pair) delimited by the `=` character, by calling STRING_TOKENIZER_get_next_token.] */
-                        /* Codes_SRS_CONNECTIONSTRINGPARSER_01_007: [If STRING_TOKENIZER_get_next_token fails, parsing shall be considered complete.] */
-                        while (STRING_TOKENIZER_get_next_token(tokenizer, token_key_string, "=") == 0)
-                        {
-                            bool is_error = false;
-
-                            /* Codes_SRS_CONNECTIONSTRINGPARSER_01_008: [connectionstringparser_parse shall find a token (the value of the key/value pair) delimited by the `;` character, by calling STRING_TOKENIZER_get_next_token.] */
-                            if (STRING_TOKENIZER_get_next_token(tokenizer, token_value_string, ";") != 0)
-                            {
-                                /* Codes_SRS_CONNECTIONSTRINGPARSER_01_009: [If STRING_TOKENIZER_get_next_token fails, connectionstringparser_parse shall fail and return NULL (freeing the allocated result map).] */
-                                is_error = true;
-                                LogError("Error reading value token from the connection string.");
-                            }
-                            else
-                            {
-                                /* Codes_SRS_CONNECTIONSTRINGPARSER_01_011: [The C strings for the key and value shall be extracted from the previously parsed STRINGs by using STRING_c_str.] */
-                                const char* token = STRING_c_str(token_key_string);
-                                /* Codes_SRS_CONNECTIONSTRINGPARSER_01_013: [If STRING_c_str fails then connectionstringparser_parse shall fail and return NULL (freeing the allocated result map).] */
-                                if ((token == NULL) ||
-                                    /* Codes_SRS_CONNECTIONSTRINGPARSER_01_019: [If the key length is zero then connectionstringparser_parse shall fail and return NULL (freeing the allocated result map).] */
-                                    (strlen(token) == 0))
-                                {
-                                    is_error = true;
-                                    LogError("The key token is NULL or empty.");
-                                }
-                                else
-                                {
-                                    /* Codes_SRS_CONNECTIONSTRINGPARSER_01_011: [The C strings for the key and value shall be extracted from the previously parsed STRINGs by using STRING_c_str.] */
-                                    const char* value = STRING_c_str(token_value_string);
-                                    if (value == NULL)
-                                    {
-                                        /* Codes_SRS_CONNECTIONSTRINGPARSER_01_013: [If STRING_c_str fails then connectionstringparser_parse shall fail and return NULL (freeing the allocated result map).] */
-                                        is_error = true;
-                                        LogError("Could not get C string for value token.");
-                                    }
-                                    else
-                                    {
-                                        /* Codes_SRS_CONNECTIONSTRINGPARSER_01_010: [The key and value shall be added to the result map by using Map_Add.] */
-                                        if (Map_Add(result, token, value) != 0)
-                                        {
-                                            /* Codes_SRS_CONNECTIONSTRINGPARSER_01_012: [If Map_Add fails connectionstringparser_parse shall fail and return NULL (freeing the allocated result map).] */
-                                            is_error = true;
-                                            LogError("Could not add the key/value pair to the result map.");
-                                        }
-                                    }
-                                }
-                            }
-
-                            if (is_error)
-                            {
-                                LogError("Error parsing connection string.");
-                                Map_Destroy(result);
-                                result = NULL;
-                                break;
-                            }
-                        }
-                    }
-
-                    STRING_delete(token_value_string);
-                }
-
-                STRING_delete(token_key_string);
-            }
-
-            /* Codes_SRS_CONNECTIONSTRINGPARSER_01_014: [After the parsing is complete the previously allocated STRINGs and STRING tokenizer shall be freed by calling STRING_TOKENIZER_destroy.] */
-            STRING_TOKENIZER_destroy(tokenizer);
+            result = parse_key_value_pairs(characters, STRING_length(connection_string));
         }
     }
 
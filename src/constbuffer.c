@@ -11,9 +11,21 @@
 #include "azure_c_shared_utility/xlogging.h"
 #include "azure_c_shared_utility/refcount.h"
 
+typedef enum CONSTBUFFER_TYPE_TAG
+{
+    CONSTBUFFER_TYPE_COPIED,
+    CONSTBUFFER_TYPE_MEMORY_MOVED,
+    CONSTBUFFER_TYPE_WITH_CUSTOM_FREE,
+    CONSTBUFFER_TYPE_FROM_OFFSET_AND_SIZE
+} CONSTBUFFER_TYPE;
+
 typedef struct CONSTBUFFER_HANDLE_DATA_TAG
 {
     CONSTBUFFER alias;
+    CONSTBUFFER_TYPE bufferType;
+    CONSTBUFFER_CUSTOM_FREE_FUNC customFreeFunc;
+    void* customFreeFuncContext;
+    CONSTBUFFER_HANDLE originalHandle;
 }CONSTBUFFER_HANDLE_DATA;
 
 DEFINE_REFCOUNT_TYPE(CONSTBUFFER_HANDLE_DATA);
@@ -34,6 +46,7 @@ static CONSTBUFFER_HANDLE CONSTBUFFER_Create_Internal(const unsigned char* sourc
     else
     {
         /*Codes_SRS_CONSTBUFFER_02_002: [Otherwise, CONSTBUFFER_Create shall create a copy of the memory area pointed to by source having size bytes.]*/
+        result->bufferType = CONSTBUFFER_TYPE_COPIED;
         result->alias.size = size;
         if (size == 0)
         {
@@ -102,6 +115,123 @@ CONSTBUFFER_HANDLE CONSTBUFFER_CreateFromBuffer(BUFFER_HANDLE buffer)
     return (CONSTBUFFER_HANDLE)result;
 }
 
+CONSTBUFFER_HANDLE CONSTBUFFER_CreateWithMoveMemory(unsigned char* source, size_t size)
+{
+    CONSTBUFFER_HANDLE_DATA* result;
+    /*Codes_SRS_CONSTBUFFER_01_001: [If source is NULL and size is different than 0 then CONSTBUFFER_CreateWithMoveMemory shall fail and return NULL.]*/
+    if ((source == NULL) && (size != 0))
+    {
+        LogError("invalid arguments passed to CONSTBUFFER_CreateWithMoveMemory");
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_01_004: [The non-NULL handle returned by CONSTBUFFER_CreateWithMoveMemory shall have its ref count set to "1".]*/
+        result = REFCOUNT_TYPE_CREATE(CONSTBUFFER_HANDLE_DATA);
+        if (result == NULL)
+        {
+            /*Codes_SRS_CONSTBUFFER_01_005: [If any error occurs, CONSTBUFFER_CreateWithMoveMemory shall fail, return NULL and leave the ownership of source with the caller.]*/
+            LogError("unable to malloc");
+        }
+        else
+        {
+            /*Codes_SRS_CONSTBUFFER_01_002: [CONSTBUFFER_CreateWithMoveMemory shall store source and size and return a non-NULL handle to the newly created const buffer, without copying the bytes.]*/
+            /*Codes_SRS_CONSTBUFFER_01_003: [The const buffer shall own source, which is freed with free when the last reference goes away.]*/
+            result->alias.buffer = source;
+            result->alias.size = size;
+            result->bufferType = CONSTBUFFER_TYPE_MEMORY_MOVED;
+        }
+    }
+    return (CONSTBUFFER_HANDLE)result;
+}
+
+CONSTBUFFER_HANDLE CONSTBUFFER_CreateWithCustomFree(const unsigned char* source, size_t size, CONSTBUFFER_CUSTOM_FREE_FUNC customFreeFunc, void* customFreeFuncContext)
+{
+    CONSTBUFFER_HANDLE_DATA* result;
+    if (
+        /*Codes_SRS_CONSTBUFFER_01_006: [If source is NULL and size is different than 0 then CONSTBUFFER_CreateWithCustomFree shall fail and return NULL.]*/
+        ((source == NULL) && (size != 0)) ||
+        /*Codes_SRS_CONSTBUFFER_01_007: [If customFreeFunc is NULL, CONSTBUFFER_CreateWithCustomFree shall fail and return NULL.]*/
+        (customFreeFunc == NULL)
+        )
+    {
+        LogError("invalid arguments passed to CONSTBUFFER_CreateWithCustomFree: source = %p, size = %zu, customFreeFunc = %p",
+            source, size, customFreeFunc);
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_01_010: [The non-NULL handle returned by CONSTBUFFER_CreateWithCustomFree shall have its ref count set to "1".]*/
+        result = REFCOUNT_TYPE_CREATE(CONSTBUFFER_HANDLE_DATA);
+        if (result == NULL)
+        {
+            /*Codes_SRS_CONSTBUFFER_01_011: [If any error occurs, CONSTBUFFER_CreateWithCustomFree shall fail and return NULL without calling customFreeFunc.]*/
+            LogError("unable to malloc");
+        }
+        else
+        {
+            /*Codes_SRS_CONSTBUFFER_01_008: [CONSTBUFFER_CreateWithCustomFree shall store source, size, customFreeFunc and customFreeFuncContext and return a non-NULL handle to the newly created const buffer, without copying the bytes.]*/
+            /*Codes_SRS_CONSTBUFFER_01_009: [customFreeFunc shall be called with customFreeFuncContext when the last reference goes away.]*/
+            result->alias.buffer = source;
+            result->alias.size = size;
+            result->bufferType = CONSTBUFFER_TYPE_WITH_CUSTOM_FREE;
+            result->customFreeFunc = customFreeFunc;
+            result->customFreeFuncContext = customFreeFuncContext;
+        }
+    }
+    return (CONSTBUFFER_HANDLE)result;
+}
+
+CONSTBUFFER_HANDLE CONSTBUFFER_CreateFromOffsetAndSize(CONSTBUFFER_HANDLE handle, size_t offset, size_t size)
+{
+    CONSTBUFFER_HANDLE result;
+    if (
+        /*Codes_SRS_CONSTBUFFER_01_012: [If handle is NULL then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL.]*/
+        (handle == NULL) ||
+        /*Codes_SRS_CONSTBUFFER_01_013: [If offset is greater than the size of handle then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL.]*/
+        (offset > handle->alias.size) ||
+        /*Codes_SRS_CONSTBUFFER_01_014: [If offset + size is greater than the size of handle then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL.]*/
+        (size > handle->alias.size - offset)
+        )
+    {
+        LogError("invalid arguments passed to CONSTBUFFER_CreateFromOffsetAndSize: handle = %p, offset = %zu, size = %zu",
+            handle, offset, size);
+        result = NULL;
+    }
+    else if ((offset == 0) && (size == handle->alias.size))
+    {
+        /*Codes_SRS_CONSTBUFFER_01_015: [If offset is 0 and size is the size of handle then CONSTBUFFER_CreateFromOffsetAndSize shall increment the reference count of handle and return handle.]*/
+        INC_REF(CONSTBUFFER_HANDLE_DATA, handle);
+        result = handle;
+    }
+    else
+    {
+        /*Codes_SRS_CONSTBUFFER_01_018: [The non-NULL handle returned by CONSTBUFFER_CreateFromOffsetAndSize shall have its ref count set to "1".]*/
+        CONSTBUFFER_HANDLE_DATA* slice = REFCOUNT_TYPE_CREATE(CONSTBUFFER_HANDLE_DATA);
+        if (slice == NULL)
+        {
+            /*Codes_SRS_CONSTBUFFER_01_019: [If any error occurs, CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL.]*/
+            LogError("unable to malloc");
+            result = NULL;
+        }
+        else
+        {
+            /*Codes_SRS_CONSTBUFFER_01_016: [Otherwise CONSTBUFFER_CreateFromOffsetAndSize shall return a non-NULL handle whose content is the size bytes of handle starting at offset, without copying the bytes.]*/
+            slice->alias.buffer = handle->alias.buffer + offset;
+            slice->alias.size = size;
+            slice->bufferType = CONSTBUFFER_TYPE_FROM_OFFSET_AND_SIZE;
+
+            /*Codes_SRS_CONSTBUFFER_01_017: [CONSTBUFFER_CreateFromOffsetAndSize shall increment the reference count of the const buffer that owns the bytes, so that they stay valid until the new handle is destroyed.]*/
+            /*slices of slices hold on to the owner directly, so chains of slices do not build up*/
+            slice->originalHandle = (handle->bufferType == CONSTBUFFER_TYPE_FROM_OFFSET_AND_SIZE) ? handle->originalHandle : handle;
+            INC_REF(CONSTBUFFER_HANDLE_DATA, slice->originalHandle);
+
+            result = (CONSTBUFFER_HANDLE)slice;
+        }
+    }
+    return result;
+}
+
 CONSTBUFFER_HANDLE CONSTBUFFER_Clone(CONSTBUFFER_HANDLE constbufferHandle)
 {
     if (constbufferHandle == NULL)
@@ -144,7 +274,20 @@ void CONSTBUFFER_Destroy(CONSTBUFFER_HANDLE constbufferHandle)
         {
             /*Codes_SRS_CONSTBUFFER_02_017: [If the refcount reaches zero, then CONSTBUFFER_Destroy shall deallocate all resources used by the CONSTBUFFER_HANDLE.]*/
             CONSTBUFFER_HANDLE_DATA* constbufferHandleData = (CONSTBUFFER_HANDLE_DATA*)constbufferHandle;
-            free((void*)constbufferHandleData->alias.buffer);
+            switch (constbufferHandleData->bufferType)
+            {
+            case CONSTBUFFER_TYPE_WITH_CUSTOM_FREE:
+                /*Codes_SRS_CONSTBUFFER_01_020: [If the const buffer was created with CONSTBUFFER_CreateWithCustomFree, CONSTBUFFER_Destroy shall call customFreeFunc with customFreeFuncContext instead of freeing the bytes.]*/
+                constbufferHandleData->customFreeFunc(constbufferHandleData->customFreeFuncContext);
+                break;
+            case CONSTBUFFER_TYPE_FROM_OFFSET_AND_SIZE:
+                /*Codes_SRS_CONSTBUFFER_01_021: [If the const buffer was created with CONSTBUFFER_CreateFromOffsetAndSize, CONSTBUFFER_Destroy shall release the reference it holds on the const buffer that owns the bytes.]*/
+                CONSTBUFFER_Destroy(constbufferHandleData->originalHandle);
+                break;
+            default:
+                free((void*)constbufferHandleData->alias.buffer);
+                break;
+            }
             free(constbufferHandleData);
         }
     }
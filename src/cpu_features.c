@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stddef.h>
+#include "azure_c_shared_utility/cpu_features.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5)))
+#define CPU_FEATURES_X86
+#include <cpuid.h>
+#elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER) && (_MSC_VER >= 1900)
+#define CPU_FEATURES_X86
+#include <intrin.h>
+#elif defined(__aarch64__) && defined(__linux__) && defined(__GNUC__)
+#define CPU_FEATURES_ARM
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+#if defined(CPU_FEATURES_X86) || defined(CPU_FEATURES_ARM)
+
+/*
+0 until the processor has been probed, then its features with CPU_FEATURES_PROBED set.
+Threads racing on the first call may all probe, only the first one to finish publishes what it found
+and every caller returns the published value, so no thread ever sees a partially initialized state.
+*/
+#define CPU_FEATURES_PROBED 0x4000
+
+#if defined(_MSC_VER)
+static volatile long cpu_features = 0;
+/*volatile reads have acquire semantics with /volatile:ms, the default for x86 and x64*/
+#define CPU_FEATURES_LOAD() ((int)cpu_features)
+#define CPU_FEATURES_PUBLISH(features) (void)_InterlockedCompareExchange(&cpu_features, (long)(features), 0)
+#else
+static int cpu_features = 0;
+#define CPU_FEATURES_LOAD() __atomic_load_n(&cpu_features, __ATOMIC_ACQUIRE)
+#define CPU_FEATURES_PUBLISH(features) (void)__sync_val_compare_and_swap(&cpu_features, 0, (features))
+#endif
+
+#if defined(CPU_FEATURES_X86)
+/*checks CPUID for the extensions and, for AVX2, that the OS saves the YMM registers*/
+static int probe_features(void)
+{
+    int result = 0;
+    unsigned int leaf1_ecx;
+    unsigned int leaf7_ebx = 0;
+    unsigned int xcr0 = 0;
+#if defined(_MSC_VER)
+    int registers[4];
+    int max_leaf;
+    __cpuid(registers, 0);
+    max_leaf = registers[0];
+    __cpuid(registers, 1);
+    leaf1_ecx = (unsigned int)registers[2];
+    if (max_leaf >= 7)
+    {
+        __cpuidex(registers, 7, 0);
+        leaf7_ebx = (unsigned int)registers[1];
+    }
+    if ((leaf1_ecx & (1u << 27)) != 0) /* OSXSAVE */
+    {
+        xcr0 = (unsigned int)_xgetbv(0);
+    }
+#else
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int max_leaf = __get_cpuid_max(0, NULL);
+    __cpuid(1, eax, ebx, ecx, edx);
+    leaf1_ecx = ecx;
+    if (max_leaf >= 7)
+    {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        leaf7_ebx = ebx;
+    }
+    if ((leaf1_ecx & (1u << 27)) != 0) /* OSXSAVE */
+    {
+        __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        xcr0 = eax;
+    }
+#endif
+    if ((leaf1_ecx & (1u << 9)) != 0) /* SSSE3 */
+    {
+        result |= CPU_FEATURE_X86_SSSE3;
+    }
+    if ((leaf1_ecx & (1u << 19)) != 0) /* SSE4.1 */
+    {
+        result |= CPU_FEATURE_X86_SSE41;
+    }
+    if (((leaf1_ecx & (1u << 28)) != 0) && /* AVX */
+        ((xcr0 & 0x06) == 0x06) &&         /* XMM and YMM state */
+        ((leaf7_ebx & (1u << 5)) != 0))    /* AVX2 */
+    {
+        result |= CPU_FEATURE_X86_AVX2;
+    }
+    if ((leaf7_ebx & (1u << 29)) != 0) /* SHA */
+    {
+        result |= CPU_FEATURE_X86_SHA;
+    }
+    return result;
+}
+#else
+static int probe_features(void)
+{
+    int result = 0;
+    unsigned long hwcap = getauxval(AT_HWCAP);
+#if defined(HWCAP_SHA1)
+    if ((hwcap & HWCAP_SHA1) != 0)
+    {
+        result |= CPU_FEATURE_ARM_SHA1;
+    }
+#endif
+#if defined(HWCAP_SHA2)
+    if ((hwcap & HWCAP_SHA2) != 0)
+    {
+        result |= CPU_FEATURE_ARM_SHA2;
+    }
+#endif
+    (void)hwcap;
+    return result;
+}
+#endif
+
+int cpu_features_get(void)
+{
+    int features = CPU_FEATURES_LOAD();
+    if (features == 0)
+    {
+        /* Codes_SRS_CPU_FEATURES_01_002: [ The processor shall be probed by the first call and the features published with a single atomic compare-and-swap, so that every call on every thread, including threads racing on the first call, returns the same value. ]*/
+        CPU_FEATURES_PUBLISH(probe_features() | CPU_FEATURES_PROBED);
+        features = CPU_FEATURES_LOAD();
+    }
+    /* Codes_SRS_CPU_FEATURES_01_001: [ `cpu_features_get` shall return the `CPU_FEATURE_` bits of the extensions the processor has, reporting `CPU_FEATURE_X86_AVX2` only when the OS also saves the YMM registers. ]*/
+    return features & ~CPU_FEATURES_PROBED;
+}
+
+#else
+
+int cpu_features_get(void)
+{
+    /* Codes_SRS_CPU_FEATURES_01_003: [ When there is no runtime probe for the processor or the compiler, `cpu_features_get` shall return 0. ]*/
+    return 0;
+}
+
+#endif
@@ -0,0 +1,302 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <string.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/deque.h"
+#include "azure_c_shared_utility/optimize_size.h"
+#include "azure_c_shared_utility/xlogging.h"
+
+/* the elements are kept in a ring buffer: element i lives in slot (head + i) modulo capacity */
+typedef struct DEQUE_TAG
+{
+    unsigned char* storage;
+    size_t capacity;
+    size_t head;
+    size_t count;
+    size_t elementSize;
+} DEQUE;
+
+static unsigned char* slot(DEQUE* handle, size_t index)
+{
+    size_t position = handle->head + index;
+    if (position >= handle->capacity)
+    {
+        position -= handle->capacity;
+    }
+    return handle->storage + (handle->elementSize * position);
+}
+
+/* makes room for one more element; the storage doubles so that both ends are amortized O(1) */
+static int grow_if_full(DEQUE* handle)
+{
+    int result;
+    if (handle->count < handle->capacity)
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t newCapacity = (handle->capacity == 0) ? 1 : handle->capacity * 2;
+        if ((newCapacity < handle->capacity) || (newCapacity > ((size_t)-1) / handle->elementSize))
+        {
+            LogError("capacity(%zd) is too large.", handle->capacity);
+            result = __FAILURE__;
+        }
+        else
+        {
+            unsigned char* temp = (unsigned char*)realloc(handle->storage, handle->elementSize * newCapacity);
+            if (temp == NULL)
+            {
+                LogError("realloc failed.");
+                result = __FAILURE__;
+            }
+            else
+            {
+                /* the storage is full, so the elements that wrapped around are the first head slots; they move right after the old end */
+                (void)memcpy(temp + (handle->elementSize * handle->capacity), temp, handle->elementSize * handle->head);
+                handle->storage = temp;
+                handle->capacity = newCapacity;
+                result = 0;
+            }
+        }
+    }
+    return result;
+}
+
+DEQUE_HANDLE DEQUE_create(size_t elementSize)
+{
+    DEQUE_HANDLE result;
+
+    /* Codes_SRS_DEQUE_01_002: [DEQUE_create shall fail and return NULL if elementSize is 0.] */
+    if (elementSize == 0)
+    {
+        LogError("invalid elementSize(%zd).", elementSize);
+        result = NULL;
+    }
+    else
+    {
+        result = (DEQUE*)malloc(sizeof(DEQUE));
+        if (result == NULL)
+        {
+            /* Codes_SRS_DEQUE_01_003: [DEQUE_create shall fail and return NULL if malloc fails.] */
+            LogError("malloc failed.");
+        }
+        else
+        {
+            /* Codes_SRS_DEQUE_01_001: [DEQUE_create shall allocate a DEQUE_HANDLE that will contain an empty deque. The size of each element is given in elementSize.] */
+            result->storage = NULL;
+            result->capacity = 0;
+            result->head = 0;
+            result->count = 0;
+            result->elementSize = elementSize;
+        }
+    }
+    return result;
+}
+
+void DEQUE_destroy(DEQUE_HANDLE handle)
+{
+    if (handle == NULL)
+    {
+        /* Codes_SRS_DEQUE_01_005: [DEQUE_destroy shall return if the given handle is NULL.] */
+        LogError("invalid argument handle(NULL).");
+    }
+    else
+    {
+        /* Codes_SRS_DEQUE_01_004: [DEQUE_destroy shall free the given handle and its internal storage.] */
+        free(handle->storage);
+        free(handle);
+    }
+}
+
+/* insertion */
+
+int DEQUE_push_back(DEQUE_HANDLE handle, const void* element)
+{
+    int result;
+    if (handle == NULL || element == NULL)
+    {
+        /* Codes_SRS_DEQUE_01_006: [DEQUE_push_back shall fail and return non-zero if `handle` or `element` is NULL.] */
+        LogError("invalid argument - handle(%p), element(%p).", handle, element);
+        result = __FAILURE__;
+    }
+    /* Codes_SRS_DEQUE_01_008: [If the deque is full, DEQUE_push_back shall double its capacity.] */
+    else if (grow_if_full(handle) != 0)
+    {
+        /* Codes_SRS_DEQUE_01_009: [DEQUE_push_back shall fail and return non-zero if memory allocation fails.] */
+        LogError("unable to grow the deque.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /* Codes_SRS_DEQUE_01_007: [DEQUE_push_back shall copy `element` after the last element of the deque and return 0.] */
+        (void)memcpy(slot(handle, handle->count), element, handle->elementSize);
+        handle->count++;
+        result = 0;
+    }
+    return result;
+}
+
+int DEQUE_push_front(DEQUE_HANDLE handle, const void* element)
+{
+    int result;
+    if (handle == NULL || element == NULL)
+    {
+        /* Codes_SRS_DEQUE_01_010: [DEQUE_push_front shall fail and return non-zero if `handle` or `element` is NULL.] */
+        LogError("invalid argument - handle(%p), element(%p).", handle, element);
+        result = __FAILURE__;
+    }
+    /* Codes_SRS_DEQUE_01_012: [If the deque is full, DEQUE_push_front shall double its capacity.] */
+    else if (grow_if_full(handle) != 0)
+    {
+        /* Codes_SRS_DEQUE_01_013: [DEQUE_push_front shall fail and return non-zero if memory allocation fails.] */
+        LogError("unable to grow the deque.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /* Codes_SRS_DEQUE_01_011: [DEQUE_push_front shall copy `element` before the first element of the deque and return 0.] */
+        handle->head = (handle->head == 0) ? handle->capacity - 1 : handle->head - 1;
+        (void)memcpy(handle->storage + (handle->elementSize * handle->head), element, handle->elementSize);
+        handle->count++;
+        result = 0;
+    }
+    return result;
+}
+
+/* removal */
+
+void DEQUE_pop_front(DEQUE_HANDLE handle)
+{
+    if (handle == NULL)
+    {
+        /* Codes_SRS_DEQUE_01_014: [DEQUE_pop_front shall return if `handle` is NULL.] */
+        LogError("invalid argument handle(NULL).");
+    }
+    else if (handle->count == 0)
+    {
+        /* Codes_SRS_DEQUE_01_015: [DEQUE_pop_front shall return if the deque is empty.] */
+        LogError("deque is empty.");
+    }
+    else
+    {
+        /* Codes_SRS_DEQUE_01_016: [DEQUE_pop_front shall remove the first element of the deque without reallocating the internal storage.] */
+        handle->head++;
+        if (handle->head == handle->capacity)
+        {
+            handle->head = 0;
+        }
+        handle->count--;
+    }
+}
+
+void DEQUE_pop_back(DEQUE_HANDLE handle)
+{
+    if (handle == NULL)
+    {
+        /* Codes_SRS_DEQUE_01_017: [DEQUE_pop_back shall return if `handle` is NULL.] */
+        LogError("invalid argument handle(NULL).");
+    }
+    else if (handle->count == 0)
+    {
+        /* Codes_SRS_DEQUE_01_018: [DEQUE_pop_back shall return if the deque is empty.] */
+        LogError("deque is empty.");
+    }
+    else
+    {
+        /* Codes_SRS_DEQUE_01_019: [DEQUE_pop_back shall remove the last element of the deque without reallocating the internal storage.] */
+        handle->count--;
+    }
+}
+
+/* access */
+
+void* DEQUE_element(DEQUE_HANDLE handle, size_t index)
+{
+    void* result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_DEQUE_01_021: [DEQUE_element shall fail and return NULL if handle is NULL.] */
+        LogError("invalid argument handle(NULL).");
+        result = NULL;
+    }
+    else if (index >= handle->count)
+    {
+        /* Codes_SRS_DEQUE_01_022: [DEQUE_element shall fail and return NULL if the given index is out of range.] */
+        LogError("invalid argument - index(%zd); should be >= 0 and < %zd.", index, handle->count);
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_DEQUE_01_020: [DEQUE_element shall return a pointer to the element at the given index, counting from the front of the deque.] */
+        result = slot(handle, index);
+    }
+    return result;
+}
+
+void* DEQUE_front(DEQUE_HANDLE handle)
+{
+    void* result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_DEQUE_01_024: [DEQUE_front shall fail and return NULL if handle is NULL.] */
+        LogError("invalid argument handle(NULL).");
+        result = NULL;
+    }
+    else if (handle->count == 0)
+    {
+        /* Codes_SRS_DEQUE_01_025: [DEQUE_front shall fail and return NULL if the deque is empty.] */
+        LogError("deque is empty.");
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_DEQUE_01_023: [DEQUE_front shall return a pointer to the first element of the deque.] */
+        result = handle->storage + (handle->elementSize * handle->head);
+    }
+    return result;
+}
+
+void* DEQUE_back(DEQUE_HANDLE handle)
+{
+    void* result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_DEQUE_01_027: [DEQUE_back shall fail and return NULL if handle is NULL.] */
+        LogError("invalid argument handle(NULL).");
+        result = NULL;
+    }
+    else if (handle->count == 0)
+    {
+        /* Codes_SRS_DEQUE_01_028: [DEQUE_back shall fail and return NULL if the deque is empty.] */
+        LogError("deque is empty.");
+        result = NULL;
+    }
+    else
+    {
+        /* Codes_SRS_DEQUE_01_026: [DEQUE_back shall return a pointer to the last element of the deque.] */
+        result = slot(handle, handle->count - 1);
+    }
+    return result;
+}
+
+/* capacity */
+
+size_t DEQUE_size(DEQUE_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_DEQUE_01_030: [DEQUE_size shall return 0 if the given handle is NULL.] */
+        LogError("invalid argument handle(NULL).");
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_DEQUE_01_029: [DEQUE_size shall return the number of elements stored in the deque.] */
+        result = handle->count;
+    }
+    return result;
+}
@@ -230,4 +230,105 @@ int hmacResult(HMACContext *ctx, uint8_t *digest)
         USHAResult(&ctx->shaContext, digest);
 }
 
+/*
+*  hmacKeyReset
+*
+*  Description:
+*      This function will process the key once, leaving the SHA state
+*      after the inner pad and the SHA state after the outer pad in
+*      the key context. The key context can then be copied for every
+*      message computed with the same key.
+*
+*  Parameters:
+*      context: [in/out]
+*          The key context to reset.
+*      whichSha: [in]
+*          One of SHA1, SHA224, SHA256, SHA384, SHA512
+*      key: [in]
+*          The secret shared key.
+*      key_len: [in]
+*          The length of the secret shared key.
+*
+*  Returns:
+*      sha Error Code.
+*
+*/
+int hmacKeyReset(HMACKeyContext *ctx, enum SHAversion whichSha,
+    const unsigned char *key, int key_len)
+{
+    HMACContext hmacContext;
+    int err;
+    if (!ctx) return shaNull;
+
+    /* hmacReset computes both pads and absorbs the inner one */
+    err = hmacReset(&hmacContext, whichSha, key, key_len);
+    if (err != shaSuccess) return err;
 
+    ctx->whichSha = hmacContext.whichSha;
+    ctx->hashSize = hmacContext.hashSize;
+    ctx->innerContext = hmacContext.shaContext;
+
+    /* absorb the outer pad once as well */
+    return USHAReset(&ctx->outerContext, whichSha) ||
+        USHAInput(&ctx->outerContext, hmacContext.k_opad, hmacContext.blockSize);
+}
+
+/*
+*  hmacKeyInput
+*
+*  Description:
+*      This function accepts an array of octets as the next portion
+*      of the message.
+*
+*  Parameters:
+*      context: [in/out]
+*          A copy of a key context produced by hmacKeyReset
+*      message_array: [in]
+*          An array of characters representing the next portion of
+*          the message.
+*      length: [in]
+*          The length of the message in message_array
+*
+*  Returns:
+*      sha Error Code.
+*
+*/
+int hmacKeyInput(HMACKeyContext *ctx, const unsigned char *text,
+    int text_len)
+{
+    if (!ctx) return shaNull;
+    return USHAInput(&ctx->innerContext, text, text_len);
+}
+
+/*
+*  hmacKeyResult
+*
+*  Description:
+*      This function will return the N-byte message digest into the
+*      Message_Digest array provided by the caller. The context can
+*      not be used for another message afterwards.
+*
+*  Parameters:
+*      context: [in/out]
+*          A copy of a key context produced by hmacKeyReset
+*      digest: [out]
+*          Where the digest is returned.
+*
+*  Returns:
+*      sha Error Code.
+*
+*/
+int hmacKeyResult(HMACKeyContext *ctx, uint8_t *digest)
+{
+    if (!ctx) return shaNull;
+
+    /* finish up 1st pass */
+    /* (Use digest here as a temporary buffer.) */
+    return USHAResult(&ctx->innerContext, digest) ||
+
+        /* the outer pad has already been absorbed, add the results of 1st hash */
+        USHAInput(&ctx->outerContext, digest, ctx->hashSize) ||
+
+        /* finish up 2nd pass */
+        USHAResult(&ctx->outerContext, digest);
+}
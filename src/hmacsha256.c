@@ -1,10 +1,47 @@
 // Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
+#include <stdlib.h>
 #include <stddef.h>
+#include <limits.h>
+#include <string.h>
+#include "azure_c_shared_utility/gballoc.h"
 #include "azure_c_shared_utility/hmacsha256.h"
 #include "azure_c_shared_utility/hmac.h"
 #include "azure_c_shared_utility/buffer_.h"
+#include "azure_c_shared_utility/sha.h"
+
+typedef struct HMACSHA256_KEY_TAG
+{
+    HMACKeyContext keyContext;
+} HMACSHA256_KEY;
+
+typedef struct HMACSHA256_CONTEXT_TAG
+{
+    HMACKeyContext messageContext;
+    int finalized;
+} HMACSHA256_CONTEXT;
+
+/* every function that outputs an HMAC appends it to the content of the caller's buffer */
+static HMACSHA256_RESULT append_digest(BUFFER_HANDLE hash, const uint8_t* digest)
+{
+    HMACSHA256_RESULT result;
+    size_t length = BUFFER_length(hash);
+
+    /*Codes_SRS_HMACSHA256_01_002: [ If computing the HMAC or growing hash fails, HMACSHA256_ComputeHash, HMACSHA256_ComputeHashWithKey and HMACSHA256_Final shall return HMACSHA256_ERROR and leave hash unchanged. ]*/
+    if (BUFFER_enlarge(hash, SHA256HashSize) != 0)
+    {
+        result = HMACSHA256_ERROR;
+    }
+    else
+    {
+        /*Codes_SRS_HMACSHA256_01_001: [ HMACSHA256_ComputeHash, HMACSHA256_ComputeHashWithKey and HMACSHA256_Final shall append the 32 byte HMAC to the content of hash by calling BUFFER_enlarge, keeping the bytes hash already holds. ]*/
+        (void)memcpy(BUFFER_u_char(hash) + length, digest, SHA256HashSize);
+        result = HMACSHA256_OK;
+    }
+
+    return result;
+}
 
 HMACSHA256_RESULT HMACSHA256_ComputeHash(const unsigned char* key, size_t keyLen, const unsigned char* payload, size_t payloadLen, BUFFER_HANDLE hash)
 {
@@ -20,16 +57,255 @@ HMACSHA256_RESULT HMACSHA256_ComputeHash(const unsigned char* key, size_t keyLen
     }
     else
     {
-        if ((BUFFER_enlarge(hash, 32) != 0) ||
-            (hmac(SHA256, payload, (int)payloadLen, key, (int)keyLen, BUFFER_u_char(hash) ) != 0))
+        uint8_t digest[USHAMaxHashSize];
+
+        /*Codes_SRS_HMACSHA256_01_002: [ If computing the HMAC or growing hash fails, HMACSHA256_ComputeHash, HMACSHA256_ComputeHashWithKey and HMACSHA256_Final shall return HMACSHA256_ERROR and leave hash unchanged. ]*/
+        if (hmac(SHA256, payload, (int)payloadLen, key, (int)keyLen, digest) != 0)
         {
             result = HMACSHA256_ERROR;
         }
         else
         {
-            result = HMACSHA256_OK;
+            result = append_digest(hash, digest);
+        }
+    }
+
+    return result;
+}
+
+HMACSHA256_KEY_HANDLE HMACSHA256_CreateKey(const unsigned char* key, size_t keyLen)
+{
+    HMACSHA256_KEY* result;
+
+    if (key == NULL ||
+        keyLen == 0)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = (HMACSHA256_KEY*)malloc(sizeof(HMACSHA256_KEY));
+        if ((result != NULL) &&
+            (hmacKeyReset(&result->keyContext, SHA256, key, (int)keyLen) != 0))
+        {
+            free(result);
+            result = NULL;
         }
     }
 
     return result;
 }
+
+void HMACSHA256_DestroyKey(HMACSHA256_KEY_HANDLE hmacKey)
+{
+    if (hmacKey != NULL)
+    {
+        free(hmacKey);
+    }
+}
+
+HMACSHA256_RESULT HMACSHA256_ComputeHashWithKey(HMACSHA256_KEY_HANDLE hmacKey, const unsigned char* payload, size_t payloadLen, BUFFER_HANDLE hash)
+{
+    HMACSHA256_RESULT result;
+
+    if (hmacKey == NULL ||
+        payload == NULL ||
+        payloadLen == 0 ||
+        hash == NULL)
+    {
+        result = HMACSHA256_INVALID_ARG;
+    }
+    else
+    {
+        /* only the message dependent part is hashed, starting from a copy of the precomputed key states */
+        HMACKeyContext messageContext = hmacKey->keyContext;
+        uint8_t digest[USHAMaxHashSize];
+
+        if ((hmacKeyInput(&messageContext, payload, (int)payloadLen) != 0) ||
+            (hmacKeyResult(&messageContext, digest) != 0))
+        {
+            result = HMACSHA256_ERROR;
+        }
+        else
+        {
+            result = append_digest(hash, digest);
+        }
+    }
+
+    return result;
+}
+
+HMACSHA256_RESULT HMACSHA256_ComputeHashBatch(HMACSHA256_KEY_HANDLE hmacKey, const unsigned char* const* payloads, const size_t* payloadLens, size_t count, BUFFER_HANDLE* hashes)
+{
+    HMACSHA256_RESULT result;
+
+    if (hmacKey == NULL ||
+        payloads == NULL ||
+        payloadLens == NULL ||
+        count == 0 ||
+        hashes == NULL)
+    {
+        result = HMACSHA256_INVALID_ARG;
+    }
+    else
+    {
+        size_t i;
+
+        result = HMACSHA256_OK;
+        for (i = 0; i < count; i++)
+        {
+            if (payloads[i] == NULL ||
+                payloadLens[i] == 0 ||
+                payloadLens[i] > UINT_MAX ||
+                hashes[i] == NULL)
+            {
+                result = HMACSHA256_INVALID_ARG;
+                break;
+            }
+        }
+
+        if (result == HMACSHA256_OK)
+        {
+            size_t first;
+
+            for (first = 0; (result == HMACSHA256_OK) && (first < count); first += SHA256MultiBufferLanes)
+            {
+                /* the inner hashes of a group of payloads are computed together, then their outer hashes */
+                SHA256Context contexts[SHA256MultiBufferLanes];
+                const uint8_t* messages[SHA256MultiBufferLanes];
+                unsigned int lengths[SHA256MultiBufferLanes];
+                uint8_t innerDigests[SHA256MultiBufferLanes][SHA256HashSize];
+                uint8_t digests[SHA256MultiBufferLanes][SHA256HashSize];
+                unsigned int lanes = (unsigned int)(((count - first) < SHA256MultiBufferLanes) ? (count - first) : SHA256MultiBufferLanes);
+
+                for (i = 0; i < lanes; i++)
+                {
+                    contexts[i] = hmacKey->keyContext.innerContext.ctx.sha256Context;
+                    messages[i] = payloads[first + i];
+                    lengths[i] = (unsigned int)payloadLens[first + i];
+                }
+
+                if (SHA256InputResultMultiple(contexts, messages, lengths, innerDigests, lanes) != shaSuccess)
+                {
+                    result = HMACSHA256_ERROR;
+                }
+                else
+                {
+                    for (i = 0; i < lanes; i++)
+                    {
+                        contexts[i] = hmacKey->keyContext.outerContext.ctx.sha256Context;
+                        messages[i] = innerDigests[i];
+                        lengths[i] = SHA256HashSize;
+                    }
+
+                    if (SHA256InputResultMultiple(contexts, messages, lengths, digests, lanes) != shaSuccess)
+                    {
+                        result = HMACSHA256_ERROR;
+                    }
+                    else
+                    {
+                        /*Codes_SRS_HMACSHA256_01_003: [ HMACSHA256_ComputeHashBatch shall append the HMAC of payloads[i] to the content of hashes[i], as HMACSHA256_ComputeHashWithKey does. ]*/
+                        for (i = 0; i < lanes; i++)
+                        {
+                            if ((result = append_digest(hashes[first + i], digests[i])) != HMACSHA256_OK)
+                            {
+                                /*Codes_SRS_HMACSHA256_01_004: [ If HMACSHA256_ComputeHashBatch fails part way, it shall return HMACSHA256_ERROR; the HMACs of the payloads before the failing one may already have been appended. ]*/
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+HMACSHA256_CONTEXT_HANDLE HMACSHA256_Init(HMACSHA256_KEY_HANDLE hmacKey)
+{
+    HMACSHA256_CONTEXT* result;
+
+    if (hmacKey == NULL)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = (HMACSHA256_CONTEXT*)malloc(sizeof(HMACSHA256_CONTEXT));
+        if (result != NULL)
+        {
+            result->messageContext = hmacKey->keyContext;
+            result->finalized = 0;
+        }
+    }
+
+    return result;
+}
+
+HMACSHA256_RESULT HMACSHA256_Update(HMACSHA256_CONTEXT_HANDLE hmacContext, const unsigned char* payload, size_t payloadLen)
+{
+    HMACSHA256_RESULT result;
+
+    if (hmacContext == NULL ||
+        (payload == NULL && payloadLen > 0))
+    {
+        result = HMACSHA256_INVALID_ARG;
+    }
+    else if (hmacContext->finalized)
+    {
+        result = HMACSHA256_ERROR;
+    }
+    else if ((payloadLen > 0) &&
+        (hmacKeyInput(&hmacContext->messageContext, payload, (int)payloadLen) != 0))
+    {
+        result = HMACSHA256_ERROR;
+    }
+    else
+    {
+        result = HMACSHA256_OK;
+    }
+
+    return result;
+}
+
+HMACSHA256_RESULT HMACSHA256_Final(HMACSHA256_CONTEXT_HANDLE hmacContext, BUFFER_HANDLE hash)
+{
+    HMACSHA256_RESULT result;
+
+    if (hmacContext == NULL ||
+        hash == NULL)
+    {
+        result = HMACSHA256_INVALID_ARG;
+    }
+    else if (hmacContext->finalized)
+    {
+        result = HMACSHA256_ERROR;
+    }
+    else
+    {
+        uint8_t digest[USHAMaxHashSize];
+
+        /* the SHA states are consumed by computing the result, so no further updates are possible */
+        hmacContext->finalized = 1;
+
+        if (hmacKeyResult(&hmacContext->messageContext, digest) != 0)
+        {
+            result = HMACSHA256_ERROR;
+        }
+        else
+        {
+            result = append_digest(hash, digest);
+        }
+    }
+
+    return result;
+}
+
+void HMACSHA256_DestroyContext(HMACSHA256_CONTEXT_HANDLE hmacContext)
+{
+    if (hmacContext != NULL)
+    {
+        free(hmacContext);
+    }
+}
@@ -13,6 +13,7 @@
 #include "azure_c_shared_utility/crt_abstractions.h"
 #include "azure_c_shared_utility/http_proxy_io.h"
 #include "azure_c_shared_utility/base64.h"
+#include "azure_c_shared_utility/http_response_parser.h"
 
 typedef enum HTTP_PROXY_IO_STATE_TAG
 {
@@ -42,8 +43,8 @@ typedef struct HTTP_PROXY_IO_INSTANCE_TAG
     char* username;
     char* password;
     XIO_HANDLE underlying_io;
-    unsigned char* receive_buffer;
-    size_t receive_buffer_size;
+    HTTP_RESPONSE_PARSER_HANDLE connect_response_parser;
+    int connect_response_status_code;
 } HTTP_PROXY_IO_INSTANCE;
 
 static CONCRETE_IO_HANDLE http_proxy_io_create(void* io_create_parameters)
@@ -184,8 +185,8 @@ static CONCRETE_IO_HANDLE http_proxy_io_create(void* io_create_parameters)
                                     {
                                         result->port = http_proxy_io_config->port;
                                         result->proxy_port = http_proxy_io_config->proxy_port;
-                                        result->receive_buffer = NULL;
-                                        result->receive_buffer_size = 0;
+                                        result->connect_response_parser = NULL;
+                                        result->connect_response_status_code = 0;
                                         result->http_proxy_io_state = HTTP_PROXY_IO_STATE_CLOSED;
                                     }
                                 }
@@ -200,6 +201,15 @@ static CONCRETE_IO_HANDLE http_proxy_io_create(void* io_create_parameters)
     return result;
 }
 
+static void destroy_connect_response_parser(HTTP_PROXY_IO_INSTANCE* http_proxy_io_instance)
+{
+    if (http_proxy_io_instance->connect_response_parser != NULL)
+    {
+        http_response_parser_destroy(http_proxy_io_instance->connect_response_parser);
+        http_proxy_io_instance->connect_response_parser = NULL;
+    }
+}
+
 static void http_proxy_io_destroy(CONCRETE_IO_HANDLE http_proxy_io)
 {
     if (http_proxy_io == NULL)
@@ -212,10 +222,7 @@ static void http_proxy_io_destroy(CONCRETE_IO_HANDLE http_proxy_io)
         HTTP_PROXY_IO_INSTANCE* http_proxy_io_instance = (HTTP_PROXY_IO_INSTANCE*)http_proxy_io;
 
         /* Codes_SRS_HTTP_PROXY_IO_01_013: [ `http_proxy_io_destroy` shall free the HTTP proxy IO instance indicated by `http_proxy_io`. ]*/
-        if (http_proxy_io_instance->receive_buffer != NULL)
-        {
-            free(http_proxy_io_instance->receive_buffer);
-        }
+        destroy_connect_response_parser(http_proxy_io_instance);
 
         /* Codes_SRS_HTTP_PROXY_IO_01_016: [ `http_proxy_io_destroy` shall destroy the underlying IO created in `http_proxy_io_create` by calling `xio_destroy`. ]*/
         xio_destroy(http_proxy_io_instance->underlying_io);
@@ -500,96 +507,28 @@ static void on_underlying_io_close_complete(void* context)
     }
 }
 
-/*the following function does the same as sscanf(pos2, "%d", &sec)*/
-/*this function only exists because some of platforms do not have sscanf. */
-static int ParseStringToDecimal(const char *src, int* dst)
+static void on_connect_response_status(void* context, int status_code, const char* reason_phrase, size_t reason_phrase_length)
 {
-    int result;
-    char* next;
-
-    (*dst) = strtol(src, &next, 0);
-    if ((src == next) || ((((*dst) == INT_MAX) || ((*dst) == INT_MIN)) && (errno != 0)))
-    {
-        result = __LINE__;
-    }
-    else
-    {
-        result = 0;
-    }
+    HTTP_PROXY_IO_INSTANCE* http_proxy_io_instance = (HTTP_PROXY_IO_INSTANCE*)context;
+    (void)reason_phrase;
+    (void)reason_phrase_length;
 
-    return result;
+    http_proxy_io_instance->connect_response_status_code = status_code;
 }
 
-/*the following function does the same as sscanf(buf, "HTTP/%*d.%*d %d %*[^\r\n]", &ret) */
-/*this function only exists because some of platforms do not have sscanf. This is not a full implementation; it only works with well-defined HTTP response. */
-static int ParseHttpResponse(const char* src, int* dst)
+static int create_connect_response_parser(HTTP_PROXY_IO_INSTANCE* http_proxy_io_instance)
 {
     int result;
-    static const char HTTPPrefix[] = "HTTP/";
-    bool fail;
-    const char* runPrefix;
 
-    if ((src == NULL) || (dst == NULL))
+    if ((http_proxy_io_instance->connect_response_parser = http_response_parser_create(on_connect_response_status, NULL, NULL, NULL, NULL, http_proxy_io_instance)) == NULL)
     {
         result = __LINE__;
     }
     else
     {
-        fail = false;
-        runPrefix = HTTPPrefix;
-
-        while ((*runPrefix) != '\0')
-        {
-            if ((*runPrefix) != (*src))
-            {
-                fail = true;
-                break;
-            }
-            src++;
-            runPrefix++;
-        }
-
-        if (!fail)
-        {
-            while ((*src) != '.')
-            {
-                if ((*src) == '\0')
-                {
-                    fail = true;
-                    break;
-                }
-                src++;
-            }
-        }
-
-        if (!fail)
-        {
-            while ((*src) != ' ')
-            {
-                if ((*src) == '\0')
-                {
-                    fail = true;
-                    break;
-                }
-                src++;
-            }
-        }
-
-        if (fail)
-        {
-            result = __LINE__;
-        }
-        else
-        {
-            if (ParseStringToDecimal(src, dst) != 0)
-            {
-                result = __LINE__;
-            }
-            else
-            {
-                result = 0;
-            }
-        }
+        /* Codes_SRS_HTTP_PROXY_IO_01_097: [ The HTTP response parser shall be told by calling `http_response_parser_set_connect_response` that it parses a CONNECT response, so that the bytes following the headers of a 2xx response are never taken as a body. ]*/
+        http_response_parser_set_connect_response(http_proxy_io_instance->connect_response_parser);
+        result = 0;
     }
 
     return result;
@@ -621,65 +560,46 @@ static void on_underlying_io_bytes_received(void* context, const unsigned char*
 
         case HTTP_PROXY_IO_STATE_WAITING_FOR_CONNECT_RESPONSE:
         {
-            /* Codes_SRS_HTTP_PROXY_IO_01_065: [ When bytes are received and the response to the CONNECT request was not yet received, the bytes shall be accumulated until a double new-line is detected. ]*/
-            unsigned char* new_receive_buffer = (unsigned char*)realloc(http_proxy_io_instance->receive_buffer, http_proxy_io_instance->receive_buffer_size + size + 1);
-            if (new_receive_buffer == NULL)
+            size_t bytes_consumed;
+
+            /* Codes_SRS_HTTP_PROXY_IO_01_065: [ When bytes are received and the response to the CONNECT request was not yet received, the bytes shall be handed to an HTTP response parser, without being accumulated. ]*/
+            /* Codes_SRS_HTTP_PROXY_IO_01_096: [ The HTTP response parser shall be created by calling `http_response_parser_create` the first time bytes are received for the CONNECT response. ]*/
+            if ((http_proxy_io_instance->connect_response_parser == NULL) &&
+                (create_connect_response_parser(http_proxy_io_instance) != 0))
             {
-                /* Codes_SRS_HTTP_PROXY_IO_01_067: [ If allocating memory for the buffered bytes fails, the `on_open_complete` callback shall be triggered with `IO_OPEN_ERROR`, passing also the `on_open_complete_context` argument as `context`. ]*/
-                LogError("Cannot allocate memory for received data");
+                /* Codes_SRS_HTTP_PROXY_IO_01_067: [ If creating the HTTP response parser fails, the `on_open_complete` callback shall be triggered with `IO_OPEN_ERROR`, passing also the `on_open_complete_context` argument as `context`. ]*/
+                LogError("Cannot create HTTP response parser");
                 indicate_open_complete_error_and_close(http_proxy_io_instance);
             }
-            else
+            /* Codes_SRS_HTTP_PROXY_IO_01_066: [ The response shall be parsed incrementally in order to extract the status code. ]*/
+            else if (http_response_parser_parse(http_proxy_io_instance->connect_response_parser, buffer, size, &bytes_consumed) != 0)
             {
-                http_proxy_io_instance->receive_buffer = new_receive_buffer;
-                memcpy(http_proxy_io_instance->receive_buffer + http_proxy_io_instance->receive_buffer_size, buffer, size);
-                http_proxy_io_instance->receive_buffer_size += size;
+                /* Codes_SRS_HTTP_PROXY_IO_01_068: [ If parsing the CONNECT response fails, the `on_open_complete` callback shall be triggered with `IO_OPEN_ERROR`, passing also the `on_open_complete_context` argument as `context`. ]*/
+                LogError("Cannot decode HTTP response");
+                indicate_open_complete_error_and_close(http_proxy_io_instance);
             }
-
-            if (http_proxy_io_instance->receive_buffer_size >= 4)
+            /* Codes_SRS_HTTP_PROXY_IO_01_069: [ Any successful (2xx) response to a CONNECT request indicates that the proxy has established a connection to the requested host and port, and has switched to tunneling the current connection to that server connection. ]*/
+            /* Codes_SRS_HTTP_PROXY_IO_01_090: [ Any successful (2xx) response to a CONNECT request indicates that the proxy has established a connection to the requested host and port, and has switched to tunneling the current connection to that server connection. ]*/
+            else if ((http_proxy_io_instance->connect_response_status_code != 0) &&
+                ((http_proxy_io_instance->connect_response_status_code < 200) || (http_proxy_io_instance->connect_response_status_code > 299)))
+            {
+                /* Codes_SRS_HTTP_PROXY_IO_01_071: [ If the status code is not successful, the `on_open_complete` callback shall be triggered with `IO_OPEN_ERROR`, passing also the `on_open_complete_context` argument as `context`. ]*/
+                LogError("Bad status (%d) received in CONNECT response", http_proxy_io_instance->connect_response_status_code);
+                indicate_open_complete_error_and_close(http_proxy_io_instance);
+            }
+            else if (http_response_parser_is_complete(http_proxy_io_instance->connect_response_parser))
             {
-                const char* request_end_ptr;
+                destroy_connect_response_parser(http_proxy_io_instance);
 
-                http_proxy_io_instance->receive_buffer[http_proxy_io_instance->receive_buffer_size] = 0;
+                /* Codes_SRS_HTTP_PROXY_IO_01_073: [ Once a success status code was parsed, the IO shall be OPEN. ]*/
+                http_proxy_io_instance->http_proxy_io_state = HTTP_PROXY_IO_STATE_OPEN;
+                /* Codes_SRS_HTTP_PROXY_IO_01_070: [ When a success status code is parsed, the `on_open_complete` callback shall be triggered with `IO_OPEN_OK`, passing also the `on_open_complete_context` argument as `context`. ]*/
+                http_proxy_io_instance->on_io_open_complete(http_proxy_io_instance->on_io_open_complete_context, IO_OPEN_OK);
 
-                /* Codes_SRS_HTTP_PROXY_IO_01_066: [ When a double new-line is detected the response shall be parsed in order to extract the status code. ]*/
-                if ((http_proxy_io_instance->receive_buffer_size >= 4) &&
-                    ((request_end_ptr = strstr((const char*)http_proxy_io_instance->receive_buffer, "\r\n\r\n")) != NULL))
+                if (bytes_consumed < size)
                 {
-                    int status_code;
-
-                    /* This part should really be done with the HTTPAPI, but that has to be done as a separate step
-                    as the HTTPAPI has to expose somehow the underlying IO and currently this would be a too big of a change. */
-
-                    if (ParseHttpResponse((const char*)http_proxy_io_instance->receive_buffer, &status_code) != 0)
-                    {
-                        /* Codes_SRS_HTTP_PROXY_IO_01_068: [ If parsing the CONNECT response fails, the `on_open_complete` callback shall be triggered with `IO_OPEN_ERROR`, passing also the `on_open_complete_context` argument as `context`. ]*/
-                        LogError("Cannot decode HTTP response");
-                        indicate_open_complete_error_and_close(http_proxy_io_instance);
-                    }
-                    /* Codes_SRS_HTTP_PROXY_IO_01_069: [ Any successful (2xx) response to a CONNECT request indicates that the proxy has established a connection to the requested host and port, and has switched to tunneling the current connection to that server connection. ]*/
-                    /* Codes_SRS_HTTP_PROXY_IO_01_090: [ Any successful (2xx) response to a CONNECT request indicates that the proxy has established a connection to the requested host and port, and has switched to tunneling the current connection to that server connection. ]*/
-                    else if ((status_code < 200) || (status_code > 299))
-                    {
-                        /* Codes_SRS_HTTP_PROXY_IO_01_071: [ If the status code is not successful, the `on_open_complete` callback shall be triggered with `IO_OPEN_ERROR`, passing also the `on_open_complete_context` argument as `context`. ]*/
-                        LogError("Bad status (%d) received in CONNECT response", status_code);
-                        indicate_open_complete_error_and_close(http_proxy_io_instance);
-                    }
-                    else
-                    {
-                        size_t length_remaining = http_proxy_io_instance->receive_buffer + http_proxy_io_instance->receive_buffer_size - ((const unsigned char *)request_end_ptr + 4);
-
-                        /* Codes_SRS_HTTP_PROXY_IO_01_073: [ Once a success status code was parsed, the IO shall be OPEN. ]*/
-                        http_proxy_io_instance->http_proxy_io_state = HTTP_PROXY_IO_STATE_OPEN;
-                        /* Codes_SRS_HTTP_PROXY_IO_01_070: [ When a success status code is parsed, the `on_open_complete` callback shall be triggered with `IO_OPEN_OK`, passing also the `on_open_complete_context` argument as `context`. ]*/
-                        http_proxy_io_instance->on_io_open_complete(http_proxy_io_instance->on_io_open_complete_context, IO_OPEN_OK);
-
-                        if (length_remaining > 0)
-                        {
-                            /* Codes_SRS_HTTP_PROXY_IO_01_072: [ Any bytes that are extra (not consumed by the CONNECT response), shall be indicated as received by calling the `on_bytes_received` callback and passing the `on_bytes_received_context` as context argument. ]*/
-                            http_proxy_io_instance->on_bytes_received(http_proxy_io_instance->on_bytes_received_context, (const unsigned char*)request_end_ptr + 4, length_remaining);
-                        }
-                    }
+                    /* Codes_SRS_HTTP_PROXY_IO_01_072: [ Any bytes that are extra (not consumed by the CONNECT response), shall be indicated as received by calling the `on_bytes_received` callback and passing the `on_bytes_received_context` as context argument. ]*/
+                    http_proxy_io_instance->on_bytes_received(http_proxy_io_instance->on_bytes_received_context, buffer + bytes_consumed, size - bytes_consumed);
                 }
             }
             break;
@@ -732,6 +652,12 @@ static int http_proxy_io_open(CONCRETE_IO_HANDLE http_proxy_io, ON_IO_OPEN_COMPL
 
             http_proxy_io_instance->http_proxy_io_state = HTTP_PROXY_IO_STATE_OPENING_UNDERLYING_IO;
 
+            http_proxy_io_instance->connect_response_status_code = 0;
+            if (http_proxy_io_instance->connect_response_parser != NULL)
+            {
+                http_response_parser_reset(http_proxy_io_instance->connect_response_parser);
+            }
+
             /* Codes_SRS_HTTP_PROXY_IO_01_019: [ `http_proxy_io_open` shall open the underlying IO by calling `xio_open` on the underlying IO handle created in `http_proxy_io_create`, while passing to it the callbacks `on_underlying_io_open_complete`, `on_underlying_io_bytes_received` and `on_underlying_io_error`. ]*/
             if (xio_open(http_proxy_io_instance->underlying_io, on_underlying_io_open_complete, http_proxy_io_instance, on_underlying_io_bytes_received, http_proxy_io_instance, on_underlying_io_error, http_proxy_io_instance) != 0)
             {
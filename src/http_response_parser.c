@@ -0,0 +1,703 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/http_response_parser.h"
+#include "azure_c_shared_utility/optimize_size.h"
+#include "azure_c_shared_utility/xlogging.h"
+
+/* Longest status line, header line or chunk size line that the parser accepts */
+#ifndef HTTP_RESPONSE_PARSER_MAX_LINE_LENGTH
+#define HTTP_RESPONSE_PARSER_MAX_LINE_LENGTH 8192
+#endif
+
+#define INITIAL_LINE_BUFFER_SIZE 64
+
+typedef enum HTTP_RESPONSE_PARSER_STATE_TAG
+{
+    HTTP_RESPONSE_PARSER_STATE_STATUS_LINE,
+    HTTP_RESPONSE_PARSER_STATE_HEADER_LINE,
+    HTTP_RESPONSE_PARSER_STATE_BODY,
+    HTTP_RESPONSE_PARSER_STATE_CHUNK_SIZE_LINE,
+    HTTP_RESPONSE_PARSER_STATE_CHUNK_DATA,
+    HTTP_RESPONSE_PARSER_STATE_CHUNK_DATA_END,
+    HTTP_RESPONSE_PARSER_STATE_TRAILER_LINE,
+    HTTP_RESPONSE_PARSER_STATE_COMPLETE,
+    HTTP_RESPONSE_PARSER_STATE_ERROR
+} HTTP_RESPONSE_PARSER_STATE;
+
+typedef struct HTTP_RESPONSE_PARSER_INSTANCE_TAG
+{
+    ON_HTTP_RESPONSE_STATUS on_status;
+    ON_HTTP_RESPONSE_HEADER on_header;
+    ON_HTTP_RESPONSE_HEADERS_COMPLETE on_headers_complete;
+    ON_HTTP_RESPONSE_BODY on_body;
+    ON_HTTP_RESPONSE_COMPLETE on_complete;
+    void* callback_context;
+    HTTP_RESPONSE_PARSER_STATE state;
+    bool is_connect_response;
+    int status_code;
+    bool is_chunked;
+    size_t content_length;
+    size_t body_bytes_remaining;
+    char* line_buffer;
+    size_t line_buffer_length;
+    size_t line_buffer_capacity;
+} HTTP_RESPONSE_PARSER_INSTANCE;
+
+static const char HTTP_PREFIX[] = "HTTP/";
+static const char CONTENT_LENGTH_NAME[] = "Content-Length";
+static const char TRANSFER_ENCODING_NAME[] = "Transfer-Encoding";
+static const char CHUNKED_CODING[] = "chunked";
+
+#define TO_LOWER(c) ((((c) >= 'A') && ((c) <= 'Z')) ? (char)((c) - 'A' + 'a') : (c))
+#define IS_OWS(c) (((c) == ' ') || ((c) == '\t'))
+
+static int hex_digit_value(char c)
+{
+    int result;
+
+    if ((c >= '0') && (c <= '9'))
+    {
+        result = c - '0';
+    }
+    else if ((c >= 'a') && (c <= 'f'))
+    {
+        result = c - 'a' + 10;
+    }
+    else if ((c >= 'A') && (c <= 'F'))
+    {
+        result = c - 'A' + 10;
+    }
+    else
+    {
+        result = -1;
+    }
+
+    return result;
+}
+
+static bool equals_ignore_case(const char* s1, size_t s1_length, const char* s2, size_t s2_length)
+{
+    bool result;
+
+    if (s1_length != s2_length)
+    {
+        result = false;
+    }
+    else
+    {
+        size_t i;
+        for (i = 0; i < s1_length; i++)
+        {
+            if (TO_LOWER(s1[i]) != TO_LOWER(s2[i]))
+            {
+                break;
+            }
+        }
+
+        result = (i == s1_length);
+    }
+
+    return result;
+}
+
+static void indicate_complete(HTTP_RESPONSE_PARSER_INSTANCE* http_response_parser)
+{
+    http_response_parser->state = HTTP_RESPONSE_PARSER_STATE_COMPLETE;
+    if (http_response_parser->on_complete != NULL)
+    {
+        http_response_parser->on_complete(http_response_parser->callback_context);
+    }
+}
+
+/* Same leniency as the sscanf(buf, "HTTP/%*d.%*d %d %*[^\r\n]", &ret) based parsing it replaces */
+static int process_status_line(HTTP_RESPONSE_PARSER_INSTANCE* http_response_parser, const char* line, size_t length)
+{
+    int result;
+    size_t pos = sizeof(HTTP_PREFIX) - 1;
+
+    if ((length < pos) ||
+        (memcmp(line, HTTP_PREFIX, pos) != 0))
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_014: [ If the status line does not start with `HTTP/`, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+        LogError("Status line does not start with HTTP/");
+        result = __FAILURE__;
+    }
+    else
+    {
+        bool has_dot = false;
+        while ((pos < length) && (line[pos] != ' '))
+        {
+            if (line[pos] == '.')
+            {
+                has_dot = true;
+            }
+            pos++;
+        }
+
+        if ((!has_dot) || (pos == length))
+        {
+            /* Codes_SRS_HTTP_RESPONSE_PARSER_01_015: [ If the HTTP version or the status code is missing or malformed, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+            LogError("Malformed HTTP version in status line");
+            result = __FAILURE__;
+        }
+        else
+        {
+            int status_code = 0;
+            size_t digit_count = 0;
+
+            while ((pos < length) && (line[pos] == ' '))
+            {
+                pos++;
+            }
+
+            while ((pos < length) && (line[pos] >= '0') && (line[pos] <= '9') && (digit_count < 3))
+            {
+                status_code = (status_code * 10) + (line[pos] - '0');
+                digit_count++;
+                pos++;
+            }
+
+            if ((digit_count == 0) ||
+                ((pos < length) && (line[pos] != ' ')))
+            {
+                /* Codes_SRS_HTTP_RESPONSE_PARSER_01_015: [ If the HTTP version or the status code is missing or malformed, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+                LogError("Malformed status code in status line");
+                result = __FAILURE__;
+            }
+            else
+            {
+                if (pos < length)
+                {
+                    /* skip the SP separating the status code from the reason phrase */
+                    pos++;
+                }
+
+                http_response_parser->status_code = status_code;
+
+                /* Codes_SRS_HTTP_RESPONSE_PARSER_01_016: [ Once the status line is parsed, `on_status` shall be called with the status code and a view of the reason phrase. ]*/
+                if (http_response_parser->on_status != NULL)
+                {
+                    http_response_parser->on_status(http_response_parser->callback_context, status_code, line + pos, length - pos);
+                }
+
+                http_response_parser->state = HTTP_RESPONSE_PARSER_STATE_HEADER_LINE;
+                result = 0;
+            }
+        }
+    }
+
+    return result;
+}
+
+static int process_end_of_headers(HTTP_RESPONSE_PARSER_INSTANCE* http_response_parser)
+{
+    int status_code = http_response_parser->status_code;
+
+    /* Codes_SRS_HTTP_RESPONSE_PARSER_01_020: [ When the empty line ending the headers is parsed, `on_headers_complete` shall be called indicating whether the body is chunked and the content length. ]*/
+    if (http_response_parser->on_headers_complete != NULL)
+    {
+        http_response_parser->on_headers_complete(http_response_parser->callback_context, http_response_parser->is_chunked, http_response_parser->content_length);
+    }
+
+    /* Codes_SRS_HTTP_RESPONSE_PARSER_01_021: [ Responses with a 1xx, 204 or 304 status code shall be considered to have no body. ]*/
+    if (((status_code >= 100) && (status_code < 200)) ||
+        (status_code == 204) ||
+        (status_code == 304))
+    {
+        indicate_complete(http_response_parser);
+    }
+    else if (http_response_parser->is_connect_response &&
+        (status_code >= 200) && (status_code < 300))
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_036: [ Once `http_response_parser_set_connect_response` was called, a response with a 2xx status code shall be complete at the end of its headers, ignoring `Content-Length` and `Transfer-Encoding`. ]*/
+        indicate_complete(http_response_parser);
+    }
+    else if (http_response_parser->is_chunked)
+    {
+        http_response_parser->state = HTTP_RESPONSE_PARSER_STATE_CHUNK_SIZE_LINE;
+    }
+    else if (http_response_parser->content_length > 0)
+    {
+        http_response_parser->body_bytes_remaining = http_response_parser->content_length;
+        http_response_parser->state = HTTP_RESPONSE_PARSER_STATE_BODY;
+    }
+    else
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_022: [ A response that is neither chunked nor has a `Content-Length` header shall be considered to have no body. ]*/
+        indicate_complete(http_response_parser);
+    }
+
+    return 0;
+}
+
+static int process_header_line(HTTP_RESPONSE_PARSER_INSTANCE* http_response_parser, const char* line, size_t length)
+{
+    int result;
+
+    if (length == 0)
+    {
+        result = process_end_of_headers(http_response_parser);
+    }
+    else
+    {
+        const char* colon = (const char*)memchr(line, ':', length);
+        if ((colon == NULL) || (colon == line))
+        {
+            /* Codes_SRS_HTTP_RESPONSE_PARSER_01_017: [ If a header line does not contain a `:` preceded by a header name, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+            LogError("Malformed header line");
+            result = __FAILURE__;
+        }
+        else
+        {
+            size_t name_length = colon - line;
+            const char* value = colon + 1;
+            const char* value_end = line + length;
+
+            /* Codes_SRS_HTTP_RESPONSE_PARSER_01_018: [ Leading and trailing whitespace shall be stripped from header values. ]*/
+            while ((value < value_end) && IS_OWS(*value))
+            {
+                value++;
+            }
+            while ((value_end > value) && IS_OWS(*(value_end - 1)))
+            {
+                value_end--;
+            }
+
+            result = 0;
+
+            if (equals_ignore_case(line, name_length, CONTENT_LENGTH_NAME, sizeof(CONTENT_LENGTH_NAME) - 1))
+            {
+                const char* digit = value;
+                size_t content_length = 0;
+
+                while ((digit < value_end) && (*digit >= '0') && (*digit <= '9'))
+                {
+                    size_t digit_value = (size_t)(*digit - '0');
+                    if (content_length > ((SIZE_MAX - digit_value) / 10))
+                    {
+                        break;
+                    }
+
+                    content_length = (content_length * 10) + digit_value;
+                    digit++;
+                }
+
+                if ((digit == value) || (digit != value_end))
+                {
+                    /* Codes_SRS_HTTP_RESPONSE_PARSER_01_019: [ If the `Content-Length` value is not a valid decimal number, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+                    LogError("Invalid Content-Length value");
+                    result = __FAILURE__;
+                }
+                else
+                {
+                    http_response_parser->content_length = content_length;
+                }
+            }
+            else if (equals_ignore_case(line, name_length, TRANSFER_ENCODING_NAME, sizeof(TRANSFER_ENCODING_NAME) - 1))
+            {
+                size_t value_length = value_end - value;
+                size_t chunked_length = sizeof(CHUNKED_CODING) - 1;
+
+                /* chunked has to be the last transfer coding applied */
+                if ((value_length >= chunked_length) &&
+                    equals_ignore_case(value_end - chunked_length, chunked_length, CHUNKED_CODING, chunked_length))
+                {
+                    http_response_parser->is_chunked = true;
+                }
+            }
+
+            /* Codes_SRS_HTTP_RESPONSE_PARSER_01_023: [ For each header line `on_header` shall be called with views of the header name and header value. ]*/
+            if ((result == 0) &&
+                (http_response_parser->on_header != NULL))
+            {
+                http_response_parser->on_header(http_response_parser->callback_context, line, name_length, value, value_end - value);
+            }
+        }
+    }
+
+    return result;
+}
+
+static int process_chunk_size_line(HTTP_RESPONSE_PARSER_INSTANCE* http_response_parser, const char* line, size_t length)
+{
+    int result;
+    size_t pos = 0;
+    size_t chunk_size = 0;
+    int digit_value;
+
+    while ((pos < length) && ((digit_value = hex_digit_value(line[pos])) >= 0))
+    {
+        if (chunk_size > ((SIZE_MAX - (size_t)digit_value) / 16))
+        {
+            break;
+        }
+
+        chunk_size = (chunk_size * 16) + (size_t)digit_value;
+        pos++;
+    }
+
+    /* chunk extensions (";name=value") are allowed after the size and are ignored */
+    if ((pos == 0) ||
+        ((pos < length) && (line[pos] != ';') && !IS_OWS(line[pos])))
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_025: [ If a chunk size line does not start with a hexadecimal number, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+        LogError("Invalid chunk size");
+        result = __FAILURE__;
+    }
+    else
+    {
+        if (chunk_size == 0)
+        {
+            /* Codes_SRS_HTTP_RESPONSE_PARSER_01_026: [ A chunk of size 0 shall end the body; any trailer lines up to the final empty line shall be consumed and ignored. ]*/
+            http_response_parser->state = HTTP_RESPONSE_PARSER_STATE_TRAILER_LINE;
+        }
+        else
+        {
+            http_response_parser->body_bytes_remaining = chunk_size;
+            http_response_parser->state = HTTP_RESPONSE_PARSER_STATE_CHUNK_DATA;
+        }
+
+        result = 0;
+    }
+
+    return result;
+}
+
+static int process_line(HTTP_RESPONSE_PARSER_INSTANCE* http_response_parser, const char* line, size_t length)
+{
+    int result;
+
+    /* Codes_SRS_HTTP_RESPONSE_PARSER_01_013: [ Lines shall be terminated by LF, with an optional preceding CR that is not part of the line. ]*/
+    if ((length > 0) && (line[length - 1] == '\r'))
+    {
+        length--;
+    }
+
+    switch (http_response_parser->state)
+    {
+    default:
+        result = __FAILURE__;
+        break;
+
+    case HTTP_RESPONSE_PARSER_STATE_STATUS_LINE:
+        result = process_status_line(http_response_parser, line, length);
+        break;
+
+    case HTTP_RESPONSE_PARSER_STATE_HEADER_LINE:
+        result = process_header_line(http_response_parser, line, length);
+        break;
+
+    case HTTP_RESPONSE_PARSER_STATE_CHUNK_SIZE_LINE:
+        result = process_chunk_size_line(http_response_parser, line, length);
+        break;
+
+    case HTTP_RESPONSE_PARSER_STATE_CHUNK_DATA_END:
+        if (length != 0)
+        {
+            /* Codes_SRS_HTTP_RESPONSE_PARSER_01_027: [ If the chunk data is not followed by CRLF, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+            LogError("Chunk data not followed by CRLF");
+            result = __FAILURE__;
+        }
+        else
+        {
+            http_response_parser->state = HTTP_RESPONSE_PARSER_STATE_CHUNK_SIZE_LINE;
+            result = 0;
+        }
+        break;
+
+    case HTTP_RESPONSE_PARSER_STATE_TRAILER_LINE:
+        if (length == 0)
+        {
+            indicate_complete(http_response_parser);
+        }
+        result = 0;
+        break;
+    }
+
+    return result;
+}
+
+static int append_to_line_buffer(HTTP_RESPONSE_PARSER_INSTANCE* http_response_parser, const unsigned char* bytes, size_t length)
+{
+    int result;
+    size_t needed = http_response_parser->line_buffer_length + length;
+
+    if (needed > HTTP_RESPONSE_PARSER_MAX_LINE_LENGTH)
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_028: [ If a line is longer than `HTTP_RESPONSE_PARSER_MAX_LINE_LENGTH`, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+        LogError("Line exceeds %u bytes", (unsigned int)HTTP_RESPONSE_PARSER_MAX_LINE_LENGTH);
+        result = __FAILURE__;
+    }
+    else
+    {
+        if (needed > http_response_parser->line_buffer_capacity)
+        {
+            /* Codes_SRS_HTTP_RESPONSE_PARSER_01_029: [ The line buffer shall grow geometrically so that a line split across many calls does not cause a reallocation per call. ]*/
+            size_t new_capacity = (http_response_parser->line_buffer_capacity == 0) ? INITIAL_LINE_BUFFER_SIZE : http_response_parser->line_buffer_capacity;
+            char* new_line_buffer;
+
+            while (new_capacity < needed)
+            {
+                new_capacity *= 2;
+            }
+            if (new_capacity > HTTP_RESPONSE_PARSER_MAX_LINE_LENGTH)
+            {
+                new_capacity = HTTP_RESPONSE_PARSER_MAX_LINE_LENGTH;
+            }
+
+            new_line_buffer = (char*)realloc(http_response_parser->line_buffer, new_capacity);
+            if (new_line_buffer == NULL)
+            {
+                /* Codes_SRS_HTTP_RESPONSE_PARSER_01_030: [ If growing the line buffer fails, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+                LogError("Cannot grow line buffer");
+                result = __FAILURE__;
+            }
+            else
+            {
+                http_response_parser->line_buffer = new_line_buffer;
+                http_response_parser->line_buffer_capacity = new_capacity;
+                result = 0;
+            }
+        }
+        else
+        {
+            result = 0;
+        }
+
+        if (result == 0)
+        {
+            (void)memcpy(http_response_parser->line_buffer + http_response_parser->line_buffer_length, bytes, length);
+            http_response_parser->line_buffer_length += length;
+        }
+    }
+
+    return result;
+}
+
+HTTP_RESPONSE_PARSER_HANDLE http_response_parser_create(ON_HTTP_RESPONSE_STATUS on_status, ON_HTTP_RESPONSE_HEADER on_header, ON_HTTP_RESPONSE_HEADERS_COMPLETE on_headers_complete, ON_HTTP_RESPONSE_BODY on_body, ON_HTTP_RESPONSE_COMPLETE on_complete, void* callback_context)
+{
+    /* Codes_SRS_HTTP_RESPONSE_PARSER_01_001: [ `http_response_parser_create` shall create a new parser instance and on success return a non-NULL handle to it. ]*/
+    /* Codes_SRS_HTTP_RESPONSE_PARSER_01_002: [ Any of the callback arguments and `callback_context` shall be allowed to be NULL. ]*/
+    HTTP_RESPONSE_PARSER_INSTANCE* result = (HTTP_RESPONSE_PARSER_INSTANCE*)malloc(sizeof(HTTP_RESPONSE_PARSER_INSTANCE));
+    if (result == NULL)
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_003: [ If allocating memory for the parser fails, `http_response_parser_create` shall return NULL. ]*/
+        LogError("Cannot allocate memory for the HTTP response parser");
+    }
+    else
+    {
+        result->on_status = on_status;
+        result->on_header = on_header;
+        result->on_headers_complete = on_headers_complete;
+        result->on_body = on_body;
+        result->on_complete = on_complete;
+        result->callback_context = callback_context;
+        result->line_buffer = NULL;
+        result->line_buffer_capacity = 0;
+        result->is_connect_response = false;
+
+        http_response_parser_reset(result);
+    }
+
+    return result;
+}
+
+void http_response_parser_destroy(HTTP_RESPONSE_PARSER_HANDLE http_response_parser)
+{
+    if (http_response_parser == NULL)
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_005: [ If `http_response_parser` is NULL, `http_response_parser_destroy` shall do nothing. ]*/
+        LogError("NULL http_response_parser");
+    }
+    else
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_004: [ `http_response_parser_destroy` shall free all resources associated with the parser. ]*/
+        if (http_response_parser->line_buffer != NULL)
+        {
+            free(http_response_parser->line_buffer);
+        }
+
+        free(http_response_parser);
+    }
+}
+
+int http_response_parser_parse(HTTP_RESPONSE_PARSER_HANDLE http_response_parser, const unsigned char* buffer, size_t size, size_t* bytes_consumed)
+{
+    int result;
+
+    if ((http_response_parser == NULL) ||
+        ((buffer == NULL) && (size > 0)))
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_007: [ If `http_response_parser` is NULL, or `buffer` is NULL while `size` is not 0, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+        LogError("Invalid arguments: http_response_parser = %p, buffer = %p, size = %u", http_response_parser, buffer, (unsigned int)size);
+        result = __FAILURE__;
+    }
+    else if (http_response_parser->state == HTTP_RESPONSE_PARSER_STATE_ERROR)
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_008: [ Once parsing failed, any subsequent call to `http_response_parser_parse` shall fail until `http_response_parser_reset` is called. ]*/
+        LogError("Parser is in error state");
+        result = __FAILURE__;
+    }
+    else
+    {
+        size_t pos = 0;
+        result = 0;
+
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_006: [ `http_response_parser_parse` shall parse the bytes in `buffer` incrementally, carrying any incomplete line over to the next call. ]*/
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_009: [ Once the response is complete, `http_response_parser_parse` shall stop consuming bytes. ]*/
+        while ((pos < size) &&
+            (result == 0) &&
+            (http_response_parser->state != HTTP_RESPONSE_PARSER_STATE_COMPLETE))
+        {
+            switch (http_response_parser->state)
+            {
+            default:
+                result = __FAILURE__;
+                break;
+
+            case HTTP_RESPONSE_PARSER_STATE_BODY:
+            case HTTP_RESPONSE_PARSER_STATE_CHUNK_DATA:
+            {
+                size_t available = size - pos;
+                size_t body_bytes = (available < http_response_parser->body_bytes_remaining) ? available : http_response_parser->body_bytes_remaining;
+
+                /* Codes_SRS_HTTP_RESPONSE_PARSER_01_024: [ Body bytes shall be indicated through `on_body` as views into `buffer`, without being copied. ]*/
+                if (http_response_parser->on_body != NULL)
+                {
+                    http_response_parser->on_body(http_response_parser->callback_context, buffer + pos, body_bytes);
+                }
+
+                pos += body_bytes;
+                http_response_parser->body_bytes_remaining -= body_bytes;
+
+                if (http_response_parser->body_bytes_remaining == 0)
+                {
+                    if (http_response_parser->state == HTTP_RESPONSE_PARSER_STATE_BODY)
+                    {
+                        indicate_complete(http_response_parser);
+                    }
+                    else
+                    {
+                        http_response_parser->state = HTTP_RESPONSE_PARSER_STATE_CHUNK_DATA_END;
+                    }
+                }
+                break;
+            }
+
+            case HTTP_RESPONSE_PARSER_STATE_STATUS_LINE:
+            case HTTP_RESPONSE_PARSER_STATE_HEADER_LINE:
+            case HTTP_RESPONSE_PARSER_STATE_CHUNK_SIZE_LINE:
+            case HTTP_RESPONSE_PARSER_STATE_CHUNK_DATA_END:
+            case HTTP_RESPONSE_PARSER_STATE_TRAILER_LINE:
+            {
+                const unsigned char* line_start = buffer + pos;
+                const unsigned char* line_feed = (const unsigned char*)memchr(line_start, '\n', size - pos);
+
+                if (line_feed == NULL)
+                {
+                    /* Codes_SRS_HTTP_RESPONSE_PARSER_01_010: [ If a line is not complete, its bytes shall be copied to an internal line buffer. ]*/
+                    result = append_to_line_buffer(http_response_parser, line_start, size - pos);
+                    pos = size;
+                }
+                else
+                {
+                    size_t line_length = line_feed - line_start;
+                    pos += line_length + 1;
+
+                    if (http_response_parser->line_buffer_length == 0)
+                    {
+                        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_011: [ Lines fully contained in `buffer` shall be processed in place, without any copy. ]*/
+                        if (line_length > HTTP_RESPONSE_PARSER_MAX_LINE_LENGTH)
+                        {
+                            /* Codes_SRS_HTTP_RESPONSE_PARSER_01_028: [ If a line is longer than `HTTP_RESPONSE_PARSER_MAX_LINE_LENGTH`, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+                            LogError("Line exceeds %u bytes", (unsigned int)HTTP_RESPONSE_PARSER_MAX_LINE_LENGTH);
+                            result = __FAILURE__;
+                        }
+                        else
+                        {
+                            result = process_line(http_response_parser, (const char*)line_start, line_length);
+                        }
+                    }
+                    else if ((result = append_to_line_buffer(http_response_parser, line_start, line_length)) == 0)
+                    {
+                        size_t buffered_line_length = http_response_parser->line_buffer_length;
+                        http_response_parser->line_buffer_length = 0;
+                        result = process_line(http_response_parser, http_response_parser->line_buffer, buffered_line_length);
+                    }
+                }
+                break;
+            }
+            }
+        }
+
+        if (result != 0)
+        {
+            http_response_parser->state = HTTP_RESPONSE_PARSER_STATE_ERROR;
+        }
+
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_012: [ If `bytes_consumed` is not NULL, it shall be set to the number of bytes from `buffer` that were consumed. ]*/
+        if (bytes_consumed != NULL)
+        {
+            *bytes_consumed = pos;
+        }
+    }
+
+    return result;
+}
+
+bool http_response_parser_is_complete(HTTP_RESPONSE_PARSER_HANDLE http_response_parser)
+{
+    bool result;
+
+    if (http_response_parser == NULL)
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_032: [ If `http_response_parser` is NULL, `http_response_parser_is_complete` shall return false. ]*/
+        LogError("NULL http_response_parser");
+        result = false;
+    }
+    else
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_031: [ `http_response_parser_is_complete` shall return true once a full response has been parsed. ]*/
+        result = (http_response_parser->state == HTTP_RESPONSE_PARSER_STATE_COMPLETE);
+    }
+
+    return result;
+}
+
+void http_response_parser_reset(HTTP_RESPONSE_PARSER_HANDLE http_response_parser)
+{
+    if (http_response_parser == NULL)
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_034: [ If `http_response_parser` is NULL, `http_response_parser_reset` shall do nothing. ]*/
+        LogError("NULL http_response_parser");
+    }
+    else
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_033: [ `http_response_parser_reset` shall prepare the parser for a new response, keeping the line buffer allocated. ]*/
+        http_response_parser->state = HTTP_RESPONSE_PARSER_STATE_STATUS_LINE;
+        http_response_parser->status_code = 0;
+        http_response_parser->is_chunked = false;
+        http_response_parser->content_length = 0;
+        http_response_parser->body_bytes_remaining = 0;
+        http_response_parser->line_buffer_length = 0;
+    }
+}
+
+void http_response_parser_set_connect_response(HTTP_RESPONSE_PARSER_HANDLE http_response_parser)
+{
+    if (http_response_parser == NULL)
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_037: [ If `http_response_parser` is NULL, `http_response_parser_set_connect_response` shall do nothing. ]*/
+        LogError("NULL http_response_parser");
+    }
+    else
+    {
+        /* Codes_SRS_HTTP_RESPONSE_PARSER_01_035: [ `http_response_parser_set_connect_response` shall make the parser treat every response it parses from then on, including after `http_response_parser_reset`, as the response to a CONNECT request. ]*/
+        http_response_parser->is_connect_response = true;
+    }
+}
@@ -9,6 +9,10 @@
 #include "azure_c_shared_utility/strings.h"
 #include "azure_c_shared_utility/crt_abstractions.h"
 #include "azure_c_shared_utility/vector.h"
+#include "azure_c_shared_utility/arena.h"
+
+/*room for the temporary headers and buffers of a typical request, the arena grows past it and keeps what it needed*/
+#define HTTPAPIEX_ARENA_BLOCK_SIZE 4096
 
 typedef struct HTTPAPIEX_SAVED_OPTION_TAG
 {
@@ -22,6 +26,8 @@ typedef struct HTTPAPIEX_HANDLE_DATA_TAG
     int k;
     HTTP_HANDLE httpHandle;
     VECTOR_HANDLE savedOptions;
+    /*the temporaries of HTTPAPIEX_ExecuteRequest come from here and are all released with one ARENA_reset*/
+    ARENA_HANDLE arena;
 }HTTPAPIEX_HANDLE_DATA;
 
 DEFINE_ENUM_STRINGS(HTTPAPIEX_RESULT, HTTPAPIEX_RESULT_VALUES);
@@ -66,6 +72,16 @@ HTTPAPIEX_HANDLE HTTPAPIEX_Create(const char* hostName)
                     free(handleData);
                     result = NULL;
                 }
+                /*Codes_SRS_HTTPAPIEX_01_001: [ HTTPAPIEX_Create shall create an arena by calling ARENA_create, the temporaries of HTTPAPIEX_ExecuteRequest are allocated from it. ]*/
+                else if ((handleData->arena = ARENA_create(HTTPAPIEX_ARENA_BLOCK_SIZE)) == NULL)
+                {
+                    /*Codes_SRS_HTTPAPIEX_01_002: [ If ARENA_create fails, HTTPAPIEX_Create shall fail and return NULL. ]*/
+                    LogError("unable to ARENA_create");
+                    VECTOR_destroy(handleData->savedOptions);
+                    STRING_delete(handleData->hostName);
+                    free(handleData);
+                    result = NULL;
+                }
                 else
                 {
                     handleData->k = -1;
@@ -98,8 +114,9 @@ static int buildRequestHttpHeadersHandle(HTTPAPIEX_HANDLE_DATA *handleData, BUFF
         Host:{hostname} - as it was indicated by the call to HTTPAPIEX_Create API call
         Content-Length:the size of the requestContent parameter, and use this instance to all the subsequent calls to HTTPAPI_ExecuteRequest as parameter httpHeadersHandle.]
         */
+        /*Codes_SRS_HTTPAPIEX_01_003: [ HTTPAPIEX_ExecuteRequest shall allocate its temporary HTTPHEADERS and BUFFER instances in the arena of the handle by calling HTTPHeaders_AllocInArena and BUFFER_new_in_arena. ]*/
         *isOriginalRequestHttpHeadersHandle = false;
-        *toBeUsedRequestHttpHeadersHandle = HTTPHeaders_Alloc();
+        *toBeUsedRequestHttpHeadersHandle = HTTPHeaders_AllocInArena(handleData->arena);
     }
 
     if (*toBeUsedRequestHttpHeadersHandle == NULL)
@@ -139,12 +156,12 @@ static int buildRequestHttpHeadersHandle(HTTPAPIEX_HANDLE_DATA *handleData, BUFF
     return result;
 }
 
-static int buildResponseHttpHeadersHandle(HTTP_HEADERS_HANDLE originalResponsetHttpHeadersHandle, bool* isOriginalResponseHttpHeadersHandle, HTTP_HEADERS_HANDLE* toBeUsedResponsetHttpHeadersHandle)
+static int buildResponseHttpHeadersHandle(ARENA_HANDLE arena, HTTP_HEADERS_HANDLE originalResponsetHttpHeadersHandle, bool* isOriginalResponseHttpHeadersHandle, HTTP_HEADERS_HANDLE* toBeUsedResponsetHttpHeadersHandle)
 {
     int result;
     if (originalResponsetHttpHeadersHandle == NULL)
     {
-        if ((*toBeUsedResponsetHttpHeadersHandle = HTTPHeaders_Alloc()) == NULL)
+        if ((*toBeUsedResponsetHttpHeadersHandle = HTTPHeaders_AllocInArena(arena)) == NULL)
         {
             result = __FAILURE__;
         }
@@ -164,12 +181,12 @@ static int buildResponseHttpHeadersHandle(HTTP_HEADERS_HANDLE originalResponsetH
 }
 
 
-static int buildBufferIfNotExist(BUFFER_HANDLE originalRequestContent, bool* isOriginalRequestContent, BUFFER_HANDLE* toBeUsedRequestContent)
+static int buildBufferIfNotExist(ARENA_HANDLE arena, BUFFER_HANDLE originalRequestContent, bool* isOriginalRequestContent, BUFFER_HANDLE* toBeUsedRequestContent)
 {
     int result;
     if (originalRequestContent == NULL)
     {
-        *toBeUsedRequestContent = BUFFER_new();
+        *toBeUsedRequestContent = BUFFER_new_in_arena(arena);
         if (*toBeUsedRequestContent == NULL)
         {
             result = __FAILURE__;
@@ -206,7 +223,7 @@ static int buildAllRequests(HTTPAPIEX_HANDLE_DATA* handle, HTTPAPI_REQUEST_TYPE
     (void)requestType;
     /*Codes_SRS_HTTPAPIEX_02_013: [If requestContent is NULL then HTTPAPIEX_ExecuteRequest shall behave as if a buffer of zero size would have been used, that is, it shall call HTTPAPI_ExecuteRequest with parameter content = NULL and contentLength = 0.]*/
     /*Codes_SRS_HTTPAPIEX_02_014: [If requestContent is not NULL then its content and its size shall be used for parameters content and contentLength of HTTPAPI_ExecuteRequest.] */
-    if (buildBufferIfNotExist(requestContent, isOriginalRequestContent, toBeUsedRequestContent) != 0)
+    if (buildBufferIfNotExist(handle->arena, requestContent, isOriginalRequestContent, toBeUsedRequestContent) != 0)
     {
         LogError("unable to build the request content");
         result = __FAILURE__;
@@ -248,7 +265,7 @@ static int buildAllRequests(HTTPAPIEX_HANDLE_DATA* handle, HTTPAPI_REQUEST_TYPE
 
             /*Codes_SRS_HTTPAPIEX_02_017: [If responseHeaders handle is NULL then HTTPAPIEX_ExecuteRequest shall create a temporary internal instance of HTTPHEADERS object and use that for responseHeaders parameter of HTTPAPI_ExecuteRequest call.] */
             /*Codes_SRS_HTTPAPIEX_02_019: [If responseHeaders is not NULL, then then HTTPAPIEX_ExecuteRequest shall use that object as parameter responseHeaders of HTTPAPI_ExecuteRequest call.] */
-            if (buildResponseHttpHeadersHandle(responseHttpHeadersHandle, isOriginalResponseHttpHeadersHandle, toBeUsedResponseHttpHeadersHandle) != 0)
+            if (buildResponseHttpHeadersHandle(handle->arena, responseHttpHeadersHandle, isOriginalResponseHttpHeadersHandle, toBeUsedResponseHttpHeadersHandle) != 0)
             {
                 /*Codes_SRS_HTTPAPIEX_02_018: [If creating the temporary http headers in SRS_HTTPAPIEX_02_017 fails then HTTPAPIEX_ExecuteRequest shall return HTTPAPIEX_ERROR.] */
                 if (*isOriginalRequestContent == false)
@@ -266,7 +283,7 @@ static int buildAllRequests(HTTPAPIEX_HANDLE_DATA* handle, HTTPAPI_REQUEST_TYPE
             {
                 /*Codes_SRS_HTTPAPIEX_02_020: [If responseContent is NULL then HTTPAPIEX_ExecuteRequest shall create a temporary internal BUFFER object and use that as parameter responseContent of HTTPAPI_ExecuteRequest call.] */
                 /*Codes_SRS_HTTPAPIEX_02_022: [If responseContent is not NULL then HTTPAPIEX_ExecuteRequest use that as parameter responseContent of HTTPAPI_ExecuteRequest call.] */
-                if (buildBufferIfNotExist(responseContent, isOriginalResponseContent, toBeUsedResponseContent) != 0)
+                if (buildBufferIfNotExist(handle->arena, responseContent, isOriginalResponseContent, toBeUsedResponseContent) != 0)
                 {
                     /*Codes_SRS_HTTPAPIEX_02_021: [If creating the BUFFER_HANDLE in SRS_HTTPAPIEX_02_020 fails, then HTTPAPIEX_ExecuteRequest shall return HTTPAPIEX_ERROR.] */
                     if (*isOriginalRequestContent == false)
@@ -333,6 +350,8 @@ HTTPAPIEX_RESULT HTTPAPIEX_ExecuteRequest(HTTPAPIEX_HANDLE handle, HTTPAPI_REQUE
                 &toBeUsedResponseHttpHeadersHandle, &isOriginalResponseHttpHeadersHandle,
                 &toBeUsedResponseContent, &isOriginalResponseContent) != 0)
             {
+                /*Codes_SRS_HTTPAPIEX_01_005: [ If building the temporaries fails, HTTPAPIEX_ExecuteRequest shall call ARENA_reset. ]*/
+                ARENA_reset(handleData->arena);
                 result = HTTPAPIEX_ERROR;
                 LOG_HTTAPIEX_ERROR();
             }
@@ -390,6 +409,7 @@ HTTPAPIEX_RESULT HTTPAPIEX_ExecuteRequest(HTTPAPIEX_HANDLE handle, HTTPAPI_REQUE
                             {
                                 size_t i;
                                 size_t vectorSize = VECTOR_size(handleData->savedOptions);
+                                /*options are replayed by name: this only runs when a connection is (re)created, and HTTPAPI is a porting layer whose adapters only take names*/
                                 for (i = 0; i < vectorSize; i++)
                                 {
                                     /*Codes_SRS_HTTPAPIEX_02_035: [HTTPAPIEX_ExecuteRequest shall pass all the saved options (see HTTPAPIEX_SetOption) to the newly create HTTPAPI_HANDLE in step 2 by calling HTTPAPI_SetOption.]*/
@@ -491,6 +511,12 @@ HTTPAPIEX_RESULT HTTPAPIEX_ExecuteRequest(HTTPAPIEX_HANDLE handle, HTTPAPI_REQUE
                 {
                     HTTPHeaders_Free(toBeUsedResponseHttpHeadersHandle);
                 }
+
+                /*Codes_SRS_HTTPAPIEX_01_004: [ After freeing the temporaries, if it created any, HTTPAPIEX_ExecuteRequest shall call ARENA_reset, so that the next request reuses their memory without allocating. ]*/
+                if (!(isOriginalRequestContent && isOriginalRequestHttpHeadersHandle && isOriginalResponseContent && isOriginalResponseHttpHeadersHandle))
+                {
+                    ARENA_reset(handleData->arena);
+                }
             }
         }
     }
@@ -522,6 +548,8 @@ void HTTPAPIEX_Destroy(HTTPAPIEX_HANDLE handle)
             free((void*)savedOption->value);
         }
         VECTOR_destroy(handleData->savedOptions);
+        /*Codes_SRS_HTTPAPIEX_01_006: [ HTTPAPIEX_Destroy shall destroy the arena by calling ARENA_destroy. ]*/
+        ARENA_destroy(handleData->arena);
 
         free(handle);
     }
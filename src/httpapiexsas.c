@@ -4,21 +4,33 @@
 #include <stdlib.h>
 #include "azure_c_shared_utility/gballoc.h"
 #include <stddef.h>
+#include <string.h>
 #include <time.h>
 #include "azure_c_shared_utility/agenttime.h"
 #include "azure_c_shared_utility/strings.h"
 #include "azure_c_shared_utility/buffer_.h"
+#include "azure_c_shared_utility/base64.h"
 #include "azure_c_shared_utility/sastoken.h"
 #include "azure_c_shared_utility/httpheaders.h"
 #include "azure_c_shared_utility/httpapiex.h"
 #include "azure_c_shared_utility/httpapiexsas.h"
+#include "azure_c_shared_utility/lock.h"
+#include "azure_c_shared_utility/shared_util_options.h"
 #include "azure_c_shared_utility/xlogging.h"
 
+#define SAS_TOKEN_LIFETIME_SECS         3600
+#define DEFAULT_SAS_TOKEN_REFRESH_MARGIN 600
+
 typedef struct HTTPAPIEX_SAS_STATE_TAG
 {
     STRING_HANDLE key;
     STRING_HANDLE uriResource;
     STRING_HANDLE keyName;
+    BUFFER_HANDLE decodedKey;
+    STRING_HANDLE cachedSASToken;
+    size_t cachedSASTokenExpiry;
+    size_t refreshMargin;
+    LOCK_HANDLE lock;
 }HTTPAPIEX_SAS_STATE;
 
 
@@ -50,6 +62,11 @@ HTTPAPIEX_SAS_HANDLE HTTPAPIEX_SAS_Create(STRING_HANDLE key, STRING_HANDLE uriRe
             state->key = NULL;
             state->uriResource = NULL;
             state->keyName = NULL;
+            state->decodedKey = NULL;
+            state->cachedSASToken = NULL;
+            state->cachedSASTokenExpiry = 0;
+            state->refreshMargin = DEFAULT_SAS_TOKEN_REFRESH_MARGIN;
+            state->lock = NULL;
             if (((state->key = STRING_clone(key)) == NULL) ||
                 ((state->uriResource = STRING_clone(uriResource)) == NULL) ||
                 ((state->keyName = STRING_clone(keyName)) == NULL))
@@ -58,6 +75,13 @@ HTTPAPIEX_SAS_HANDLE HTTPAPIEX_SAS_Create(STRING_HANDLE key, STRING_HANDLE uriRe
                 LogError("Unable to clone the arguments.");
                 HTTPAPIEX_SAS_Destroy(state);
             }
+            /*Codes_SRS_HTTPAPIEXSAS_01_014: [ HTTPAPIEX_SAS_Create shall create a lock guarding the cached SAS token and the refresh margin by calling Lock_Init. ]*/
+            else if ((state->lock = Lock_Init()) == NULL)
+            {
+                /*Codes_SRS_HTTPAPIEXSAS_06_004: [If there are any other errors in the instantiation of this handle then HTTPAPIEX_SAS_Create shall return NULL.]*/
+                LogError("Unable to create the lock.");
+                HTTPAPIEX_SAS_Destroy(state);
+            }
             else
             {
                 result = state;
@@ -86,6 +110,19 @@ void HTTPAPIEX_SAS_Destroy(HTTPAPIEX_SAS_HANDLE handle)
         {
             STRING_delete(state->keyName);
         }
+        if (state->decodedKey)
+        {
+            BUFFER_delete(state->decodedKey);
+        }
+        if (state->cachedSASToken)
+        {
+            STRING_delete(state->cachedSASToken);
+        }
+        if (state->lock)
+        {
+            /*Codes_SRS_HTTPAPIEXSAS_01_015: [ HTTAPIEX_SAS_Destroy shall free the lock by calling Lock_Deinit. ]*/
+            (void)Lock_Deinit(state->lock);
+        }
         free(state);
     }
 }
@@ -110,26 +147,67 @@ HTTPAPIEX_RESULT HTTPAPIEX_SAS_ExecuteRequest(HTTPAPIEX_SAS_HANDLE sasHandle, HT
                 {
                     LogError("Time does not appear to be working.");
                 }
+                /*Codes_SRS_HTTPAPIEXSAS_01_016: [ The cached SAS token shall only be read, generated and replaced while holding the lock. ]*/
+                else if (Lock(state->lock) != LOCK_OK)
+                {
+                    /*Codes_SRS_HTTPAPIEXSAS_01_017: [ If Lock fails then fallthrough. ]*/
+                    LogError("Unable to lock the SAS token cache.");
+                }
                 else
                 {
-                    /*Codes_SRS_HTTPAPIEXSAS_06_011: [SASToken_Create shall be invoked.]*/
-                    /*Codes_SRS_HTTPAPIEXSAS_06_012: [If the return result of SASToken_Create is NULL then fallthrough.]*/
-                    size_t expiry = (size_t)(difftime(currentTime, 0) + 3600);
-                    STRING_HANDLE newSASToken = SASToken_Create(state->key, state->uriResource, state->keyName, expiry);
-                    if (newSASToken != NULL)
+                    size_t now = (size_t)difftime(currentTime, 0);
+
+                    /*Codes_SRS_HTTPAPIEXSAS_01_007: [ If a SAS token was generated by a previous call and it does not expire within the refresh margin, it shall be reused and no new SAS token shall be generated. ]*/
+                    if ((state->cachedSASToken == NULL) ||
+                        (now + state->refreshMargin >= state->cachedSASTokenExpiry))
                     {
-                        /*Codes_SRS_HTTPAPIEXSAS_06_013: [HTTPHeaders_ReplaceHeaderNameValuePair shall be invoked with "Authorization" as its second argument and STRING_c_str (newSASToken) as its third argument.]*/
-                        if (HTTPHeaders_ReplaceHeaderNameValuePair(requestHttpHeadersHandle, "Authorization", STRING_c_str(newSASToken)) != HTTP_HEADERS_OK)
+                        /*Codes_SRS_HTTPAPIEXSAS_01_008: [ The key shall be decoded by calling Base64_Decoder only the first time a SAS token is generated; the decoded key shall be kept for subsequent SAS token generations. ]*/
+                        if ((state->decodedKey == NULL) &&
+                            ((state->decodedKey = Base64_Decoder(STRING_c_str(state->key))) == NULL))
+                        {
+                            /*Codes_SRS_HTTPAPIEXSAS_01_009: [ If Base64_Decoder fails, no new SAS token shall be generated. ]*/
+                            LogError("Unable to decode the key.");
+                        }
+                        else
+                        {
+                            /*Codes_SRS_HTTPAPIEXSAS_01_010: [ A new SAS token shall be generated by calling SASToken_CreateWithDecodedKey with the decoded key, the uri resource, the key name and an expiry of the current time plus 3600 seconds. ]*/
+                            size_t expiry = now + SAS_TOKEN_LIFETIME_SECS;
+                            const char* uriResource = STRING_c_str(state->uriResource);
+                            const char* keyName = STRING_c_str(state->keyName);
+                            STRING_HANDLE newSASToken = SASToken_CreateWithDecodedKey(state->decodedKey, uriResource, keyName, expiry);
+                            if (newSASToken == NULL)
+                            {
+                                /*Codes_SRS_HTTPAPIEXSAS_01_011: [ If SASToken_CreateWithDecodedKey fails, the previously cached SAS token (if any) shall be kept. ]*/
+                                LogError("Unable to create a new SAS token.");
+                            }
+                            else
+                            {
+                                /*Codes_SRS_HTTPAPIEXSAS_01_012: [ The newly generated SAS token shall replace the cached SAS token, which shall be freed with STRING_delete. ]*/
+                                if (state->cachedSASToken != NULL)
+                                {
+                                    STRING_delete(state->cachedSASToken);
+                                }
+                                state->cachedSASToken = newSASToken;
+                                state->cachedSASTokenExpiry = expiry;
+                            }
+                        }
+                    }
+
+                    /*Codes_SRS_HTTPAPIEXSAS_01_013: [ If there is no cached SAS token or the cached SAS token has already expired then fallthrough. ]*/
+                    if ((state->cachedSASToken != NULL) &&
+                        (now < state->cachedSASTokenExpiry))
+                    {
+                        /*Codes_SRS_HTTPAPIEXSAS_06_013: [HTTPHeaders_ReplaceHeaderNameValuePair shall be invoked with "Authorization" as its second argument and STRING_c_str of the cached SAS token as its third argument.]*/
+                        if (HTTPHeaders_ReplaceHeaderNameValuePair(requestHttpHeadersHandle, "Authorization", STRING_c_str(state->cachedSASToken)) != HTTP_HEADERS_OK)
                         {
                             /*Codes_SRS_HTTPAPIEXSAS_06_014: [If the result of the invocation of HTTPHeaders_ReplaceHeaderNameValuePair is NOT HTTP_HEADERS_OK then fallthrough.]*/
                             LogError("Unable to replace the old SAS Token.");
                         }
-                        /*Codes_SRS_HTTPAPIEXSAS_06_015: [STRING_delete(newSASToken) will be invoked.]*/
-                        STRING_delete(newSASToken);
                     }
-                    else
+
+                    if (Unlock(state->lock) != LOCK_OK)
                     {
-                        LogError("Unable to create a new SAS token.");
+                        LogError("Unable to unlock the SAS token cache.");
                     }
                 }
             }
@@ -138,3 +216,56 @@ HTTPAPIEX_RESULT HTTPAPIEX_SAS_ExecuteRequest(HTTPAPIEX_SAS_HANDLE sasHandle, HT
     /*Codes_SRS_HTTPAPIEXSAS_06_016: [HTTPAPIEX_ExecuteRequest with the remaining parameters (following sasHandle) as its arguments will be invoked and the result of that call is the result of HTTPAPIEX_SAS_ExecuteRequest.]*/
     return HTTPAPIEX_ExecuteRequest(handle,requestType,relativePath,requestHttpHeadersHandle,requestContent,statusCode,responseHeadersHandle,responseContent);
 }
+
+HTTPAPIEX_RESULT HTTPAPIEX_SAS_SetOption(HTTPAPIEX_SAS_HANDLE sasHandle, const char* optionName, const void* value)
+{
+    HTTPAPIEX_RESULT result;
+    if ((sasHandle == NULL) ||
+        (optionName == NULL) ||
+        (value == NULL))
+    {
+        /*Codes_SRS_HTTPAPIEXSAS_01_002: [ If sasHandle, optionName or value is NULL, HTTPAPIEX_SAS_SetOption shall fail and return HTTPAPIEX_INVALID_ARG. ]*/
+        LogError("Invalid arguments: sasHandle = %p, optionName = %p, value = %p", sasHandle, optionName, value);
+        result = HTTPAPIEX_INVALID_ARG;
+    }
+    else if (strcmp(optionName, OPTION_SAS_TOKEN_REFRESH_MARGIN) == 0)
+    {
+        /*Codes_SRS_HTTPAPIEXSAS_01_003: [ The option OPTION_SAS_TOKEN_REFRESH_MARGIN shall take a pointer to a size_t holding the number of seconds before expiry at which a cached SAS token is regenerated. ]*/
+        size_t refreshMargin = *(const size_t*)value;
+        if (refreshMargin >= SAS_TOKEN_LIFETIME_SECS)
+        {
+            /*Codes_SRS_HTTPAPIEXSAS_01_004: [ If the refresh margin is not smaller than the SAS token lifetime of 3600 seconds, HTTPAPIEX_SAS_SetOption shall fail and return HTTPAPIEX_INVALID_ARG. ]*/
+            LogError("Refresh margin %lu is not smaller than the token lifetime", (unsigned long)refreshMargin);
+            result = HTTPAPIEX_INVALID_ARG;
+        }
+        else
+        {
+            /*Codes_SRS_HTTPAPIEXSAS_01_018: [ The refresh margin shall be updated while holding the lock. ]*/
+            if (Lock(sasHandle->lock) != LOCK_OK)
+            {
+                /*Codes_SRS_HTTPAPIEXSAS_01_019: [ If Lock fails, HTTPAPIEX_SAS_SetOption shall fail and return HTTPAPIEX_ERROR. ]*/
+                LogError("Unable to lock the SAS token cache.");
+                result = HTTPAPIEX_ERROR;
+            }
+            else
+            {
+                sasHandle->refreshMargin = refreshMargin;
+                if (Unlock(sasHandle->lock) != LOCK_OK)
+                {
+                    LogError("Unable to unlock the SAS token cache.");
+                }
+
+                /*Codes_SRS_HTTPAPIEXSAS_01_005: [ On success HTTPAPIEX_SAS_SetOption shall return HTTPAPIEX_OK. ]*/
+                result = HTTPAPIEX_OK;
+            }
+        }
+    }
+    else
+    {
+        /*Codes_SRS_HTTPAPIEXSAS_01_006: [ If optionName is not a known option, HTTPAPIEX_SAS_SetOption shall fail and return HTTPAPIEX_INVALID_ARG. ]*/
+        LogError("Unknown option %s", optionName);
+        result = HTTPAPIEX_INVALID_ARG;
+    }
+
+    return result;
+}
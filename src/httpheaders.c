@@ -5,17 +5,290 @@
 #include "azure_c_shared_utility/gballoc.h"
 #include "azure_c_shared_utility/map.h"
 #include "azure_c_shared_utility/httpheaders.h"
+#include <stdint.h>
 #include <string.h>
 #include "azure_c_shared_utility/crt_abstractions.h"
 #include "azure_c_shared_utility/xlogging.h"
+#include "azure_c_shared_utility/refcount.h"
 
 DEFINE_ENUM_STRINGS(HTTP_HEADERS_RESULT, HTTP_HEADERS_RESULT_VALUES);
 
+/*the index starts with this many entries and doubles whenever it would become more than 3/4 full*/
+#define HEADER_INDEX_INITIAL_SIZE 16
+#define HEADER_INDEX_EMPTY SIZE_MAX
+
+/*header names are case-insensitive, so they are found through a hash of their lower case form*/
+typedef struct HEADER_INDEX_ENTRY_TAG
+{
+    uint32_t hash;
+    /*position of the header in the keys and values of the map, HEADER_INDEX_EMPTY for an unused entry*/
+    size_t position;
+} HEADER_INDEX_ENTRY;
+
+/*headers shared by a handle and its clones, the first of them to change the headers makes its own copy*/
+typedef struct SHARED_HEADERS_TAG
+{
+    MAP_HANDLE headers;
+    HEADER_INDEX_ENTRY* index;
+} SHARED_HEADERS;
+
+DEFINE_REFCOUNT_TYPE(SHARED_HEADERS);
+
 typedef struct HTTP_HEADERS_HANDLE_DATA_TAG
 {
     MAP_HANDLE headers;
+    /*open addressing hash table over the names in headers, NULL until the first header is added*/
+    HEADER_INDEX_ENTRY* index;
+    /*number of entries of index, a power of 2*/
+    size_t indexSize;
+    /*number of headers in headers, the map appends a new header at this position*/
+    size_t headerCount;
+    /*not NULL when headers and index are shared with other handles, created by the first HTTPHeaders_Clone*/
+    SHARED_HEADERS* shared;
+    /*the arena the handle and its map come from, NULL for the heap*/
+    ARENA_HANDLE arena;
 } HTTP_HEADERS_HANDLE_DATA;
 
+static char fold_header_name_char(char c)
+{
+    return ((c >= 'A') && (c <= 'Z')) ? (char)(c - 'A' + 'a') : c;
+}
+
+/*FNV-1a over the lower case form of name*/
+static uint32_t hash_header_name(const char* name)
+{
+    uint32_t result = 2166136261u;
+    for (; *name != '\0'; name++)
+    {
+        result = (result ^ (unsigned char)fold_header_name_char(*name)) * 16777619u;
+    }
+    return result;
+}
+
+static bool header_names_are_equal(const char* left, const char* right)
+{
+    while ((*left != '\0') &&
+        (fold_header_name_char(*left) == fold_header_name_char(*right)))
+    {
+        left++;
+        right++;
+    }
+    return (*left == *right);
+}
+
+static void* headers_malloc(ARENA_HANDLE arena, size_t size)
+{
+    return (arena == NULL) ? malloc(size) : ARENA_malloc(arena, size);
+}
+
+static void headers_free(ARENA_HANDLE arena, void* ptr)
+{
+    if (ptr == NULL)
+    {
+        /*nothing to free*/
+    }
+    else if (arena == NULL)
+    {
+        free(ptr);
+    }
+    else
+    {
+        ARENA_free(arena, ptr);
+    }
+}
+
+/*adds the header at position to the index, which has room for it*/
+static void insert_into_index(HEADER_INDEX_ENTRY* index, size_t indexSize, uint32_t hash, size_t position)
+{
+    size_t i = hash & (indexSize - 1);
+    while (index[i].position != HEADER_INDEX_EMPTY)
+    {
+        i = (i + 1) & (indexSize - 1);
+    }
+    index[i].hash = hash;
+    index[i].position = position;
+}
+
+/*makes sure the index has room for one more header, growing it if needed*/
+static int reserve_index_entry(HTTP_HEADERS_HANDLE_DATA* handleData)
+{
+    int result;
+
+    if ((handleData->headerCount + 1) * 4 <= handleData->indexSize * 3)
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t newSize = (handleData->indexSize == 0) ? HEADER_INDEX_INITIAL_SIZE : handleData->indexSize * 2;
+        HEADER_INDEX_ENTRY* newIndex;
+
+        if ((newSize > SIZE_MAX / sizeof(HEADER_INDEX_ENTRY)) ||
+            ((newIndex = (HEADER_INDEX_ENTRY*)headers_malloc(handleData->arena, newSize * sizeof(HEADER_INDEX_ENTRY))) == NULL))
+        {
+            LogError("unable to allocate a header index of %zu entries", newSize);
+            result = __FAILURE__;
+        }
+        else
+        {
+            size_t i;
+            for (i = 0; i < newSize; i++)
+            {
+                newIndex[i].position = HEADER_INDEX_EMPTY;
+            }
+            for (i = 0; i < handleData->indexSize; i++)
+            {
+                if (handleData->index[i].position != HEADER_INDEX_EMPTY)
+                {
+                    insert_into_index(newIndex, newSize, handleData->index[i].hash, handleData->index[i].position);
+                }
+            }
+
+            headers_free(handleData->arena, handleData->index);
+            handleData->index = newIndex;
+            handleData->indexSize = newSize;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+/*copies the index of handleData to the heap, for a handle that is about to get headers of its own*/
+static int copy_index(const HTTP_HEADERS_HANDLE_DATA* handleData, HEADER_INDEX_ENTRY** destination)
+{
+    int result;
+
+    if (handleData->index == NULL)
+    {
+        *destination = NULL;
+        result = 0;
+    }
+    else if ((*destination = (HEADER_INDEX_ENTRY*)malloc(handleData->indexSize * sizeof(HEADER_INDEX_ENTRY))) == NULL)
+    {
+        LogError("unable to allocate a header index of %zu entries", handleData->indexSize);
+        result = __FAILURE__;
+    }
+    else
+    {
+        (void)memcpy(*destination, handleData->index, handleData->indexSize * sizeof(HEADER_INDEX_ENTRY));
+        result = 0;
+    }
+
+    return result;
+}
+
+/*finds the header called name regardless of case, *existingName is set to NULL when there is none*/
+static int find_header(HTTP_HEADERS_HANDLE_DATA* handleData, const char* name, uint32_t hash, const char** existingName, const char** existingValue)
+{
+    int result = 0;
+
+    *existingName = NULL;
+    *existingValue = NULL;
+
+    if (handleData->index != NULL)
+    {
+        const char*const* keys = NULL;
+        const char*const* values = NULL;
+        size_t count;
+        size_t i = hash & (handleData->indexSize - 1);
+
+        while (handleData->index[i].position != HEADER_INDEX_EMPTY)
+        {
+            if (handleData->index[i].hash == hash)
+            {
+                /*the names are only looked at when the hashes match, which is almost always the header that is looked for*/
+                if ((keys == NULL) &&
+                    (Map_GetInternals(handleData->headers, &keys, &values, &count) != MAP_OK))
+                {
+                    LogError("Map_GetInternals failed");
+                    result = __FAILURE__;
+                    break;
+                }
+                else if ((handleData->index[i].position < count) &&
+                    header_names_are_equal(keys[handleData->index[i].position], name))
+                {
+                    *existingName = keys[handleData->index[i].position];
+                    *existingValue = values[handleData->index[i].position];
+                    break;
+                }
+            }
+            i = (i + 1) & (handleData->indexSize - 1);
+        }
+    }
+
+    return result;
+}
+
+static void release_shared_headers(SHARED_HEADERS* shared)
+{
+    if (DEC_REF(SHARED_HEADERS, shared) == DEC_RETURN_ZERO)
+    {
+        Map_Destroy(shared->headers);
+        headers_free(NULL, shared->index);
+        free(shared);
+    }
+}
+
+/*once the headers of a handle are shared, cloning it only increments their reference count*/
+static int share_headers(HTTP_HEADERS_HANDLE_DATA* handleData)
+{
+    int result;
+    /*Codes_SRS_HTTP_HEADERS_01_007: [ The first time the headers of handle are shared, HTTPHeaders_Clone shall allocate their reference count with malloc. ]*/
+    SHARED_HEADERS* shared = REFCOUNT_TYPE_CREATE(SHARED_HEADERS);
+    if (shared == NULL)
+    {
+        LogError("unable to allocate the shared headers");
+        result = __FAILURE__;
+    }
+    else
+    {
+        shared->headers = handleData->headers;
+        shared->index = handleData->index;
+        handleData->shared = shared;
+        result = 0;
+    }
+    return result;
+}
+
+/*gives the handle headers of its own before they are changed, the handles it shares them with keep seeing the old ones*/
+static int unshare_headers(HTTP_HEADERS_HANDLE_DATA* handleData)
+{
+    int result;
+
+    if (handleData->shared == NULL)
+    {
+        result = 0;
+    }
+    else
+    {
+        /*Codes_SRS_HTTP_HEADERS_01_008: [ HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair called on a handle whose headers are shared shall first make a copy of the headers of their own by calling Map_Clone, so that no other handle observes the change. ]*/
+        MAP_HANDLE headers = Map_Clone(handleData->headers);
+        HEADER_INDEX_ENTRY* index;
+        if (headers == NULL)
+        {
+            LogError("Map_Clone failed");
+            result = __FAILURE__;
+        }
+        /*Map_Clone keeps the order of the headers, so the positions in the index stay valid for the copy*/
+        else if (copy_index(handleData, &index) != 0)
+        {
+            Map_Destroy(headers);
+            result = __FAILURE__;
+        }
+        else
+        {
+            release_shared_headers(handleData->shared);
+            handleData->shared = NULL;
+            handleData->headers = headers;
+            handleData->index = index;
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
 HTTP_HEADERS_HANDLE HTTPHeaders_Alloc(void)
 {
     /*Codes_SRS_HTTP_HEADERS_99_002:[ This API shall produce a HTTP_HANDLE that can later be used in subsequent calls to the module.]*/
@@ -38,7 +311,11 @@ HTTP_HEADERS_HANDLE HTTPHeaders_Alloc(void)
         }
         else
         {
-            /*all is fine*/
+            result->index = NULL;
+            result->indexSize = 0;
+            result->headerCount = 0;
+            result->shared = NULL;
+            result->arena = NULL;
         }
     }
 
@@ -46,6 +323,41 @@ HTTP_HEADERS_HANDLE HTTPHeaders_Alloc(void)
     return (HTTP_HEADERS_HANDLE)result;
 }
 
+HTTP_HEADERS_HANDLE HTTPHeaders_AllocInArena(ARENA_HANDLE arena)
+{
+    HTTP_HEADERS_HANDLE_DATA* result;
+
+    if (arena == NULL)
+    {
+        /*Codes_SRS_HTTP_HEADERS_01_001: [ If arena is NULL, HTTPHeaders_AllocInArena shall fail and return NULL. ]*/
+        LogError("invalid arg (NULL) arena");
+        result = NULL;
+    }
+    /*Codes_SRS_HTTP_HEADERS_01_002: [ HTTPHeaders_AllocInArena shall allocate the handle with ARENA_malloc and its headers with Map_CreateInArena, so that no header added later is allocated from the heap. ]*/
+    else if ((result = (HTTP_HEADERS_HANDLE_DATA*)ARENA_malloc(arena, sizeof(HTTP_HEADERS_HANDLE_DATA))) == NULL)
+    {
+        /*Codes_SRS_HTTP_HEADERS_01_003: [ If any of these fails, HTTPHeaders_AllocInArena shall return NULL. ]*/
+        LogError("ARENA_malloc failed");
+    }
+    else if ((result->headers = Map_CreateInArena(arena, NULL)) == NULL)
+    {
+        /*Codes_SRS_HTTP_HEADERS_01_003: [ If any of these fails, HTTPHeaders_AllocInArena shall return NULL. ]*/
+        LogError("Map_CreateInArena failed");
+        ARENA_free(arena, result);
+        result = NULL;
+    }
+    else
+    {
+        result->index = NULL;
+        result->indexSize = 0;
+        result->headerCount = 0;
+        result->shared = NULL;
+        result->arena = arena;
+    }
+
+    return (HTTP_HEADERS_HANDLE)result;
+}
+
 /*Codes_SRS_HTTP_HEADERS_99_005:[ Calling this API shall de-allocate the data structures allocated by previous API calls to the same handle.]*/
 void HTTPHeaders_Free(HTTP_HEADERS_HANDLE handle)
 {
@@ -59,8 +371,26 @@ void HTTPHeaders_Free(HTTP_HEADERS_HANDLE handle)
         /*Codes_SRS_HTTP_HEADERS_99_005:[ Calling this API shall de-allocate the data structures allocated by previous API calls to the same handle.]*/
         HTTP_HEADERS_HANDLE_DATA* handleData = (HTTP_HEADERS_HANDLE_DATA*)handle;
 
-        Map_Destroy(handleData->headers);
-        free(handleData);
+        if (handleData->shared != NULL)
+        {
+            /*Codes_SRS_HTTP_HEADERS_01_010: [ HTTPHeaders_Free of a handle whose headers are shared shall release its reference to them and destroy them with Map_Destroy only if it was the last reference. ]*/
+            release_shared_headers(handleData->shared);
+        }
+        else
+        {
+            Map_Destroy(handleData->headers);
+            headers_free(handleData->arena, handleData->index);
+        }
+
+        if (handleData->arena == NULL)
+        {
+            free(handleData);
+        }
+        else
+        {
+            /*Codes_SRS_HTTP_HEADERS_01_004: [ For a handle created by HTTPHeaders_AllocInArena, HTTPHeaders_Free shall give the memory back to the arena, which reclaims it when it is reset. ]*/
+            ARENA_free(handleData->arena, handleData);
+        }
     }
 }
 
@@ -97,10 +427,18 @@ static HTTP_HEADERS_RESULT headers_ReplaceHeaderNameValuePair(HTTP_HEADERS_HANDL
             result = HTTP_HEADERS_INVALID_ARG;
             LogError("(result = %s)", ENUM_TO_STRING(HTTP_HEADERS_RESULT, result));
         }
+        else if (unshare_headers((HTTP_HEADERS_HANDLE_DATA*)handle) != 0)
+        {
+            /*Codes_SRS_HTTP_HEADERS_01_009: [ If Map_Clone fails, HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair shall return HTTP_HEADERS_ALLOC_FAILED and leave the handle unchanged. ]*/
+            result = HTTP_HEADERS_ALLOC_FAILED;
+            LogError("unable to copy the shared headers, result= %s", ENUM_TO_STRING(HTTP_HEADERS_RESULT, result));
+        }
         else
         {
             HTTP_HEADERS_HANDLE_DATA* handleData = (HTTP_HEADERS_HANDLE_DATA*)handle;
-            const char* existingValue = Map_GetValueFromKey(handleData->headers, name);
+            uint32_t hash = hash_header_name(name);
+            const char* existingName;
+            const char* existingValue;
             /*eat up the whitespaces from value, as per RFC 2616, chapter 4.2 "The field value MAY be preceded by any amount of LWS, though a single SP is preferred."*/
             /*Codes_SRS_HTTP_HEADERS_02_002: [The LWS from the beginning of the value shall not be stored.] */
             while ((value[0] == ' ') || (value[0] == '\t') || (value[0] == '\r') || (value[0] == '\n'))
@@ -108,7 +446,38 @@ static HTTP_HEADERS_RESULT headers_ReplaceHeaderNameValuePair(HTTP_HEADERS_HANDL
                 value++;
             }
 
-            if (!replace && (existingValue != NULL))
+            /*Codes_SRS_HTTP_HEADERS_01_012: [ HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair shall look for an existing header with the same name regardless of case, through a hash index of the lower case names that does not compare the name with any header whose hash is different. ]*/
+            if (find_header(handleData, name, hash, &existingName, &existingValue) != 0)
+            {
+                /*Codes_SRS_HTTP_HEADERS_01_013: [ If Map_GetInternals fails, HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair shall return HTTP_HEADERS_ERROR. ]*/
+                result = HTTP_HEADERS_ERROR;
+                LogError("unable to look up the header, result= %s", ENUM_TO_STRING(HTTP_HEADERS_RESULT, result));
+            }
+            else if (existingName == NULL)
+            {
+                /*Codes_SRS_HTTP_HEADERS_01_015: [ Before adding a header with a new name, HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair shall make room for it in the index, allocating a larger index when it would be more than 3/4 full. ]*/
+                if (reserve_index_entry(handleData) != 0)
+                {
+                    /*Codes_SRS_HTTP_HEADERS_01_016: [ If allocating the index fails, HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair shall return HTTP_HEADERS_ALLOC_FAILED. ]*/
+                    result = HTTP_HEADERS_ALLOC_FAILED;
+                    LogError("unable to grow the header index, result= %s", ENUM_TO_STRING(HTTP_HEADERS_RESULT, result));
+                }
+                /*Codes_SRS_HTTP_HEADERS_99_016:[ The function shall store the name:value pair in such a way that when later retrieved by a call to GetHeader it will return a string that shall strcmp equal to the name+": "+value.]*/
+                else if (Map_AddOrUpdate(handleData->headers, name, value) != MAP_OK)
+                {
+                    /*Codes_SRS_HTTP_HEADERS_99_015:[ The function shall return HTTP_HEADERS_ALLOC_FAILED when an internal request to allocate memory fails.]*/
+                    result = HTTP_HEADERS_ALLOC_FAILED;
+                    LogError("failed to Map_AddOrUpdate, result= %s", ENUM_TO_STRING(HTTP_HEADERS_RESULT, result));
+                }
+                else
+                {
+                    /*the map appends a new key*/
+                    insert_into_index(handleData->index, handleData->indexSize, hash, handleData->headerCount);
+                    handleData->headerCount++;
+                    result = HTTP_HEADERS_OK;
+                }
+            }
+            else if (!replace)
             {
                 size_t existingValueLen = strlen(existingValue);
                 size_t valueLen = strlen(value);
@@ -129,8 +498,8 @@ static HTTP_HEADERS_RESULT headers_ReplaceHeaderNameValuePair(HTTP_HEADERS_HANDL
                     (*runNewValue++) = ' ';
                     (void)memcpy(runNewValue, value, valueLen + /*EOL*/ 1);
 
-                    /*Codes_SRS_HTTP_HEADERS_99_016:[ The function shall store the name:value pair in such a way that when later retrieved by a call to GetHeader it will return a string that shall strcmp equal to the name+": "+value.]*/
-                    if (Map_AddOrUpdate(handleData->headers, name, newValue) != MAP_OK)
+                    /*Codes_SRS_HTTP_HEADERS_01_014: [ The value of an existing header shall be stored under the name it was first added with. ]*/
+                    if (Map_AddOrUpdate(handleData->headers, existingName, newValue) != MAP_OK)
                     {
                         /*Codes_SRS_HTTP_HEADERS_99_015:[ The function shall return HTTP_HEADERS_ALLOC_FAILED when an internal request to allocate memory fails.]*/
                         result = HTTP_HEADERS_ERROR;
@@ -146,8 +515,8 @@ static HTTP_HEADERS_RESULT headers_ReplaceHeaderNameValuePair(HTTP_HEADERS_HANDL
             }
             else
             {
-                /*Codes_SRS_HTTP_HEADERS_99_016:[ The function shall store the name:value pair in such a way that when later retrieved by a call to GetHeader it will return a string that shall strcmp equal to the name+": "+value.]*/
-                if (Map_AddOrUpdate(handleData->headers, name, value) != MAP_OK)
+                /*Codes_SRS_HTTP_HEADERS_01_014: [ The value of an existing header shall be stored under the name it was first added with. ]*/
+                if (Map_AddOrUpdate(handleData->headers, existingName, value) != MAP_OK)
                 {
                     /*Codes_SRS_HTTP_HEADERS_99_015:[ The function shall return HTTP_HEADERS_ALLOC_FAILED when an internal request to allocate memory fails.]*/
                     result = HTTP_HEADERS_ALLOC_FAILED;
@@ -193,7 +562,14 @@ const char* HTTPHeaders_FindHeaderValue(HTTP_HEADERS_HANDLE httpHeadersHandle, c
         /*Codes_SRS_HTTP_HEADERS_99_020:[ The return value shall be different than NULL when the name matches the name of a previously stored name:value pair.] */
         /*Codes_SRS_HTTP_HEADERS_99_021:[ In this case the return value shall point to a string that shall strcmp equal to the original stored string.]*/
         HTTP_HEADERS_HANDLE_DATA* handleData = (HTTP_HEADERS_HANDLE_DATA*)httpHeadersHandle;
-        result = Map_GetValueFromKey(handleData->headers, name);
+        const char* existingName;
+        /*Codes_SRS_HTTP_HEADERS_01_017: [ HTTPHeaders_FindHeaderValue shall find the header regardless of the case of name, through the hash index of the lower case names. ]*/
+        if (find_header(handleData, name, hash_header_name(name), &existingName, &result) != 0)
+        {
+            /*Codes_SRS_HTTP_HEADERS_01_018: [ If Map_GetInternals fails, HTTPHeaders_FindHeaderValue shall return NULL. ]*/
+            LogError("unable to look up the header");
+            result = NULL;
+        }
     }
     return result;
 
@@ -299,6 +675,69 @@ HTTP_HEADERS_RESULT HTTPHeaders_GetHeader(HTTP_HEADERS_HANDLE handle, size_t ind
     return result;
 }
 
+/*writes name: value into a caller buffer, without allocating*/
+HTTP_HEADERS_RESULT HTTPHeaders_GetHeaderInto(HTTP_HEADERS_HANDLE handle, size_t index, char* destination, size_t destinationSize, size_t* headerLength)
+{
+    HTTP_HEADERS_RESULT result;
+
+    if (
+        (handle == NULL) ||
+        (headerLength == NULL)
+        )
+    {
+        /*Codes_SRS_HTTP_HEADERS_01_019: [ If handle or headerLength is NULL, HTTPHeaders_GetHeaderInto shall return HTTP_HEADERS_INVALID_ARG. ]*/
+        result = HTTP_HEADERS_INVALID_ARG;
+        LogError("invalid arg (NULL), result= %s", ENUM_TO_STRING(HTTP_HEADERS_RESULT, result));
+    }
+    else
+    {
+        HTTP_HEADERS_HANDLE_DATA* handleData = (HTTP_HEADERS_HANDLE_DATA*)handle;
+        const char*const* keys;
+        const char*const* values;
+        size_t headerCount;
+        if (Map_GetInternals(handleData->headers, &keys, &values, &headerCount) != MAP_OK)
+        {
+            /*Codes_SRS_HTTP_HEADERS_01_020: [ If Map_GetInternals fails, HTTPHeaders_GetHeaderInto shall return HTTP_HEADERS_ERROR. ]*/
+            result = HTTP_HEADERS_ERROR;
+            LogError("Map_GetInternals failed, result= %s", ENUM_TO_STRING(HTTP_HEADERS_RESULT, result));
+        }
+        else if (index >= headerCount)
+        {
+            /*Codes_SRS_HTTP_HEADERS_01_021: [ If index is not smaller than the number of stored headers, HTTPHeaders_GetHeaderInto shall return HTTP_HEADERS_INVALID_ARG. ]*/
+            result = HTTP_HEADERS_INVALID_ARG;
+            LogError("index out of bounds, result= %s", ENUM_TO_STRING(HTTP_HEADERS_RESULT, result));
+        }
+        else
+        {
+            size_t keyLen = strlen(keys[index]);
+            size_t valueLen = strlen(values[index]);
+
+            /*Codes_SRS_HTTP_HEADERS_01_022: [ HTTPHeaders_GetHeaderInto shall set *headerLength to the length of name+": "+value of the index header, not including the null terminator. ]*/
+            *headerLength = keyLen + /*COLON_AND_SPACE_LENGTH*/ 2 + valueLen;
+
+            if (
+                (destination == NULL) ||
+                (destinationSize <= *headerLength)
+                )
+            {
+                /*Codes_SRS_HTTP_HEADERS_01_023: [ If destination is NULL or destinationSize is not larger than *headerLength, HTTPHeaders_GetHeaderInto shall return HTTP_HEADERS_INSUFFICIENT_BUFFER. ]*/
+                result = HTTP_HEADERS_INSUFFICIENT_BUFFER;
+            }
+            else
+            {
+                /*Codes_SRS_HTTP_HEADERS_01_024: [ Otherwise HTTPHeaders_GetHeaderInto shall write the null terminated name+": "+value to destination without allocating any memory and return HTTP_HEADERS_OK. ]*/
+                (void)memcpy(destination, keys[index], keyLen);
+                destination[keyLen] = ':';
+                destination[keyLen + 1] = ' ';
+                (void)memcpy(destination + keyLen + 2, values[index], valueLen + /*EOL*/ 1);
+                result = HTTP_HEADERS_OK;
+            }
+        }
+    }
+
+    return result;
+}
+
 HTTP_HEADERS_HANDLE HTTPHeaders_Clone(HTTP_HEADERS_HANDLE handle)
 {
     HTTP_HEADERS_HANDLE_DATA* result;
@@ -318,8 +757,37 @@ HTTP_HEADERS_HANDLE HTTPHeaders_Clone(HTTP_HEADERS_HANDLE handle)
         else
         {
             HTTP_HEADERS_HANDLE_DATA* handleData = handle;
-            result->headers = Map_Clone(handleData->headers);
-            if (result->headers == NULL)
+            /*Codes_SRS_HTTP_HEADERS_01_005: [ HTTPHeaders_Clone shall always allocate the clone from the heap, also when handle was created in an arena. ]*/
+            result->arena = NULL;
+            result->indexSize = handleData->indexSize;
+            result->headerCount = handleData->headerCount;
+            if (handleData->arena != NULL)
+            {
+                /*Codes_SRS_HTTP_HEADERS_01_011: [ For a handle created in an arena, HTTPHeaders_Clone shall copy the headers by calling Map_Clone, since they do not outlive ARENA_reset. ]*/
+                result->shared = NULL;
+                result->headers = Map_Clone(handleData->headers);
+                if (result->headers == NULL)
+                {
+                    /*Codes_SRS_HTTP_HEADERS_02_005: [If cloning fails for any reason, then HTTPHeaders_Clone shall return NULL.] */
+                    free(result);
+                    result = NULL;
+                }
+                else if (copy_index(handleData, &result->index) != 0)
+                {
+                    /*Codes_SRS_HTTP_HEADERS_02_005: [If cloning fails for any reason, then HTTPHeaders_Clone shall return NULL.] */
+                    Map_Destroy(result->headers);
+                    free(result);
+                    result = NULL;
+                }
+                else
+                {
+                    /*all is fine*/
+                }
+            }
+            else if (
+                (handleData->shared == NULL) &&
+                (share_headers(handleData) != 0)
+                )
             {
                 /*Codes_SRS_HTTP_HEADERS_02_005: [If cloning fails for any reason, then HTTPHeaders_Clone shall return NULL.] */
                 free(result);
@@ -327,7 +795,11 @@ HTTP_HEADERS_HANDLE HTTPHeaders_Clone(HTTP_HEADERS_HANDLE handle)
             }
             else
             {
-                /*all is fine*/
+                /*Codes_SRS_HTTP_HEADERS_01_006: [ Otherwise HTTPHeaders_Clone shall not copy the headers, the clone shall share them with handle and count its reference to them. ]*/
+                INC_REF(SHARED_HEADERS, handleData->shared);
+                result->shared = handleData->shared;
+                result->headers = handleData->headers;
+                result->index = handleData->index;
             }
         }
     }
@@ -16,14 +16,56 @@ typedef struct MAP_HANDLE_DATA_TAG
     char** values;
     size_t count;
     MAP_FILTER_CALLBACK mapFilterCallback;
+    /*where the map, its keys and its values live, NULL for the heap*/
+    ARENA_HANDLE arena;
 }MAP_HANDLE_DATA;
 
 #define LOG_MAP_ERROR LogError("result = %s", ENUM_TO_STRING(MAP_RESULT, result));
 
-MAP_HANDLE Map_Create(MAP_FILTER_CALLBACK mapFilterFunc)
+/*all the memory of a map goes through these, so that a map created in an arena never touches the heap*/
+static void* map_malloc(ARENA_HANDLE arena, size_t size)
 {
-    /*Codes_SRS_MAP_02_001: [Map_Create shall create a new, empty map.]*/
-    MAP_HANDLE_DATA* result = (MAP_HANDLE_DATA*)malloc(sizeof(MAP_HANDLE_DATA));
+    return (arena == NULL) ? malloc(size) : ARENA_malloc(arena, size);
+}
+
+static void* map_realloc(ARENA_HANDLE arena, void* ptr, size_t size)
+{
+    return (arena == NULL) ? realloc(ptr, size) : ARENA_realloc(arena, ptr, size);
+}
+
+static void map_free(ARENA_HANDLE arena, void* ptr)
+{
+    if (arena == NULL)
+    {
+        free(ptr);
+    }
+    else
+    {
+        ARENA_free(arena, ptr);
+    }
+}
+
+static int map_strdup(ARENA_HANDLE arena, char** destination, const char* source)
+{
+    int result;
+    if (arena == NULL)
+    {
+        result = mallocAndStrcpy_s(destination, source);
+    }
+    else if ((*destination = ARENA_strdup(arena, source)) == NULL)
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+static MAP_HANDLE create_map(ARENA_HANDLE arena, MAP_FILTER_CALLBACK mapFilterFunc)
+{
+    MAP_HANDLE_DATA* result = (MAP_HANDLE_DATA*)map_malloc(arena, sizeof(MAP_HANDLE_DATA));
     /*Codes_SRS_MAP_02_002: [If during creation there are any error, then Map_Create shall return NULL.]*/
     if (result != NULL)
     {
@@ -32,10 +74,35 @@ MAP_HANDLE Map_Create(MAP_FILTER_CALLBACK mapFilterFunc)
         result->values = NULL;
         result->count = 0;
         result->mapFilterCallback = mapFilterFunc;
+        result->arena = arena;
     }
     return (MAP_HANDLE)result;
 }
 
+MAP_HANDLE Map_Create(MAP_FILTER_CALLBACK mapFilterFunc)
+{
+    /*Codes_SRS_MAP_02_001: [Map_Create shall create a new, empty map.]*/
+    return create_map(NULL, mapFilterFunc);
+}
+
+MAP_HANDLE Map_CreateInArena(ARENA_HANDLE arena, MAP_FILTER_CALLBACK mapFilterFunc)
+{
+    MAP_HANDLE result;
+    if (arena == NULL)
+    {
+        /*Codes_SRS_MAP_01_002: [ If arena is NULL, Map_CreateInArena shall fail and return NULL. ]*/
+        LogError("invalid arg (NULL) arena");
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_MAP_01_003: [ Map_CreateInArena shall create a new, empty map as Map_Create does, with the map and all the keys and values later added to it allocated from arena. ]*/
+        /*Codes_SRS_MAP_01_004: [ If allocating from arena fails, Map_CreateInArena shall return NULL. ]*/
+        result = create_map(arena, mapFilterFunc);
+    }
+    return result;
+}
+
 void Map_Destroy(MAP_HANDLE handle)
 {
     /*Codes_SRS_MAP_02_005: [If parameter handle is NULL then Map_Destroy shall take no action.] */
@@ -45,14 +112,17 @@ void Map_Destroy(MAP_HANDLE handle)
         MAP_HANDLE_DATA* handleData = (MAP_HANDLE_DATA*)handle;
         size_t i;
       
+        /*Codes_SRS_MAP_01_005: [ For a map created in an arena, Map_Destroy shall give the memory back to the arena, which reclaims it when it is reset. ]*/
+        ARENA_HANDLE arena = handleData->arena;
+
         for (i = 0; i < handleData->count; i++)
         {
-            free(handleData->keys[i]);
-            free(handleData->values[i]);
+            map_free(arena, handleData->keys[i]);
+            map_free(arena, handleData->values[i]);
         }
-        free(handleData->keys);
-        free(handleData->values);
-        free(handleData);
+        map_free(arena, handleData->keys);
+        map_free(arena, handleData->values);
+        map_free(arena, handleData);
     }
 }
 
@@ -108,6 +178,7 @@ MAP_HANDLE Map_Clone(MAP_HANDLE handle)
     else
     {
         MAP_HANDLE_DATA * handleData = (MAP_HANDLE_DATA *)handle;
+        /*Codes_SRS_MAP_01_006: [ Map_Clone shall always allocate the clone from the heap, also when handle was created in an arena. ]*/
         result = (MAP_HANDLE_DATA*)malloc(sizeof(MAP_HANDLE_DATA));
         if (result == NULL)
         {
@@ -117,6 +188,7 @@ MAP_HANDLE Map_Clone(MAP_HANDLE handle)
         }
         else
         {
+            result->arena = NULL;
             if (handleData->count == 0)  
             {
                 result->count = 0;
@@ -161,7 +233,7 @@ MAP_HANDLE Map_Clone(MAP_HANDLE handle)
 static int Map_IncreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
 {
     int result;
-    char** newKeys = (char**)realloc(handleData->keys, (handleData->count + 1) * sizeof(char*));
+    char** newKeys = (char**)map_realloc(handleData->arena, handleData->keys, (handleData->count + 1) * sizeof(char*));
     if (newKeys == NULL)
     {
         LogError("realloc error");
@@ -172,18 +244,18 @@ static int Map_IncreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
         char** newValues;
         handleData->keys = newKeys;
         handleData->keys[handleData->count] = NULL;
-        newValues = (char**)realloc(handleData->values, (handleData->count + 1) * sizeof(char*));
+        newValues = (char**)map_realloc(handleData->arena, handleData->values, (handleData->count + 1) * sizeof(char*));
         if (newValues == NULL)
         {
             LogError("realloc error");
             if (handleData->count == 0) /*avoiding an implementation defined behavior */
             {
-                free(handleData->keys);
+                map_free(handleData->arena, handleData->keys);
                 handleData->keys = NULL;
             }
             else
             {
-                char** undoneKeys = (char**)realloc(handleData->keys, (handleData->count) * sizeof(char*));
+                char** undoneKeys = (char**)map_realloc(handleData->arena, handleData->keys, (handleData->count) * sizeof(char*));
                 if (undoneKeys == NULL)
                 {
                     LogError("CATASTROPHIC error, unable to undo through realloc to a smaller size");
@@ -210,9 +282,9 @@ static void Map_DecreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
 {
     if (handleData->count == 1)
     {
-        free(handleData->keys);
+        map_free(handleData->arena, handleData->keys);
         handleData->keys = NULL;
-        free(handleData->values);
+        map_free(handleData->arena, handleData->values);
         handleData->values = NULL;
         handleData->count = 0;
         handleData->mapFilterCallback = NULL;
@@ -221,7 +293,7 @@ static void Map_DecreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
     {
         /*certainly > 1...*/
         char** undoneValues;
-        char** undoneKeys = (char**)realloc(handleData->keys, sizeof(char*)* (handleData->count - 1)); 
+        char** undoneKeys = (char**)map_realloc(handleData->arena, handleData->keys, sizeof(char*)* (handleData->count - 1)); 
         if (undoneKeys == NULL)
         {
             LogError("CATASTROPHIC error, unable to undo through realloc to a smaller size");
@@ -231,7 +303,7 @@ static void Map_DecreaseStorageKeysValues(MAP_HANDLE_DATA* handleData)
             handleData->keys = undoneKeys;
         }
 
-        undoneValues = (char**)realloc(handleData->values, sizeof(char*)* (handleData->count - 1));
+        undoneValues = (char**)map_realloc(handleData->arena, handleData->values, sizeof(char*)* (handleData->count - 1));
         if (undoneValues == NULL)
         {
             LogError("CATASTROPHIC error, unable to undo through realloc to a smaller size");
@@ -300,7 +372,7 @@ static int insertNewKeyValue(MAP_HANDLE_DATA* handleData, const char* key, const
     }
     else
     {
-        if (mallocAndStrcpy_s(&(handleData->keys[handleData->count - 1]), key) != 0)
+        if (map_strdup(handleData->arena, &(handleData->keys[handleData->count - 1]), key) != 0)
         {
             Map_DecreaseStorageKeysValues(handleData);
             LogError("unable to mallocAndStrcpy_s");
@@ -308,9 +380,9 @@ static int insertNewKeyValue(MAP_HANDLE_DATA* handleData, const char* key, const
         }
         else
         {
-            if (mallocAndStrcpy_s(&(handleData->values[handleData->count - 1]), value) != 0)
+            if (map_strdup(handleData->arena, &(handleData->values[handleData->count - 1]), value) != 0)
             {
-                free(handleData->keys[handleData->count - 1]);
+                map_free(handleData->arena, handleData->keys[handleData->count - 1]);
                 Map_DecreaseStorageKeysValues(handleData);
                 LogError("unable to mallocAndStrcpy_s");
                 result = __FAILURE__;
@@ -420,7 +492,7 @@ MAP_RESULT Map_AddOrUpdate(MAP_HANDLE handle, const char* key, const char* value
                 size_t index = whereIsIt - handleData->keys;
                 size_t valueLength = strlen(value);
                 /*try to realloc value of this key*/
-                char* newValue = (char*)realloc(handleData->values[index],valueLength  + 1);
+                char* newValue = (char*)map_realloc(handleData->arena, handleData->values[index],valueLength  + 1);
                 if (newValue == NULL)
                 {
                     result = MAP_ERROR;
@@ -465,8 +537,8 @@ MAP_RESULT Map_Delete(MAP_HANDLE handle, const char* key)
         {
             /*Codes_SRS_MAP_02_023: [Otherwise, Map_Delete shall remove the key and its associated value from the map and return MAP_OK.]*/
             size_t index = whereIsIt - handleData->keys;
-            free(handleData->keys[index]);
-            free(handleData->values[index]);
+            map_free(handleData->arena, handleData->keys[index]);
+            map_free(handleData->arena, handleData->values[index]);
             memmove(handleData->keys + index, handleData->keys + index + 1, (handleData->count - index - 1)*sizeof(char*)); /*if order doesn't matter... then this can be optimized*/
             memmove(handleData->values + index, handleData->values + index + 1, (handleData->count - index - 1)*sizeof(char*));
             Map_DecreaseStorageKeysValues(handleData);
@@ -595,71 +667,64 @@ STRING_HANDLE Map_ToJSON(MAP_HANDLE handle)
     }
     else
     {
+        MAP_HANDLE_DATA* handleData = (MAP_HANDLE_DATA *)handle;
+        size_t i;
+        /*the braces, and for every entry 2 pairs of quotes, the colon and the comma. Escaped characters are not counted,
+        the JSON grows for them if there are any*/
+        size_t jsonLength = 2;
+        for (i = 0; i < handleData->count; i++)
+        {
+            jsonLength += strlen(handleData->keys[i]) + strlen(handleData->values[i]) + 6;
+        }
+
         /*Codes_SRS_MAP_02_048: [Map_ToJSON shall produce a STRING_HANDLE representing the content of the MAP.] */
-        result = STRING_construct("{");
+        result = STRING_new();
         if (result == NULL)
         {
-            LogError("STRING_construct failed");
+            LogError("STRING_new failed");
+        }
+        /*Codes_SRS_MAP_01_001: [ Map_ToJSON shall reserve the memory for the whole JSON before writing it. ]*/
+        else if ((STRING_reserve(result, jsonLength) != 0) ||
+            (STRING_concat_n(result, "{", 1) != 0))
+        {
+            /*Codes_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
+            LogError("failed to build the JSON");
+            STRING_delete(result);
+            result = NULL;
         }
         else
         {
-            size_t i;
-            MAP_HANDLE_DATA* handleData = (MAP_HANDLE_DATA *)handle;
             /*Codes_SRS_MAP_02_049: [If the MAP is empty, then Map_ToJSON shall produce the string "{}".*/
             bool breakFor = false; /*used to break out of for*/
             for (i = 0; (i < handleData->count) && (!breakFor); i++)
             {
-                /*add one entry to the JSON*/
+                /*add one entry to the JSON, escaping the key and the value straight into it*/
                 /*Codes_SRS_MAP_02_050: [If the map has properties then Map_ToJSON shall produce the following string:{"name1":"value1", "name2":"value2" ...}]*/
-                STRING_HANDLE key = STRING_new_JSON(handleData->keys[i]);
-                if (key == NULL)
+                if (!(
+                    ((i>0) ? (STRING_concat_n(result, ",", 1) == 0) : 1) &&
+                    (STRING_concat_JSON(result, handleData->keys[i]) == 0) &&
+                    (STRING_concat_n(result, ":", 1) == 0) &&
+                    (STRING_concat_JSON(result, handleData->values[i]) == 0)
+                    ))
                 {
-                    LogError("STRING_new_JSON failed");
+                    LogError("failed to build the JSON");
                     STRING_delete(result);
                     result = NULL;
                     breakFor = true;
                 }
                 else
                 {
-                    STRING_HANDLE value = STRING_new_JSON(handleData->values[i]);
-                    if (value == NULL)
-                    {
-                        LogError("STRING_new_JSON failed");
-                        STRING_delete(result);
-                        result = NULL;
-                        breakFor = true;
-                    }
-                    else
-                    {
-                        if (!(
-                            ((i>0) ? (STRING_concat(result, ",") == 0) : 1) &&
-                            (STRING_concat_with_STRING(result, key) == 0) &&
-                            (STRING_concat(result, ":") == 0) &&
-                            (STRING_concat_with_STRING(result, value) == 0)
-                            ))
-                        {
-                            LogError("failed to build the JSON");
-                            STRING_delete(result);
-                            result = NULL;
-                            breakFor = true;
-                        }
-                        else
-                        {
-                            /*all nice, go to the next element in the map*/
-                        }
-                        STRING_delete(value);
-                    }
-                    STRING_delete(key);
+                    /*all nice, go to the next element in the map*/
                 }
             }
-                
+
             if (breakFor)
             {
                 LogError("error happened during JSON string builder");
             }
             else
             {
-                if (STRING_concat(result, "}") != 0)
+                if (STRING_concat_n(result, "}", 1) != 0)
                 {
                     LogError("failed to build the JSON");
                     STRING_delete(result);
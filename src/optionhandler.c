@@ -2,7 +2,9 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #include <stdlib.h>
+#include <string.h>
 #include "azure_c_shared_utility/optionhandler.h"
+#include "azure_c_shared_utility/shared_util_options.h"
 #include "azure_c_shared_utility/xlogging.h"
 #include "azure_c_shared_utility/gballoc.h"
 #include "azure_c_shared_utility/vector.h"
@@ -10,18 +12,102 @@
 typedef struct OPTION_TAG
 {
     const char* name;
+    OPTION_ID id;
     void* storage;
 }OPTION;
 
 typedef struct OPTIONHANDLER_HANDLE_DATA_TAG
 {
+    /*either the three name based functions or the three id based functions are not NULL*/
     pfCloneOption cloneOption;
     pfDestroyOption destroyOption;
     pfSetOption setOption;
+    pfCloneOptionById cloneOptionById;
+    pfDestroyOptionById destroyOptionById;
+    pfSetOptionById setOptionById;
     VECTOR_HANDLE storage;
 }OPTIONHANDLER_HANDLE_DATA;
 
-static OPTIONHANDLER_HANDLE CreateInternal(pfCloneOption cloneOption, pfDestroyOption destroyOption, pfSetOption setOption)
+/*the names are referenced through the variables of shared_util_options.h so that it stays the only place that spells them*/
+typedef struct OPTION_NAME_TAG
+{
+    const char* const* name;
+    OPTION_ID id;
+}OPTION_NAME;
+
+static const OPTION_NAME optionNames[] =
+{
+    { &OPTION_HTTP_PROXY, OPTION_ID_HTTP_PROXY },
+    { &OPTION_HTTP_TIMEOUT, OPTION_ID_HTTP_TIMEOUT },
+    { &SU_OPTION_X509_CERT, OPTION_ID_X509_CERT },
+    { &SU_OPTION_X509_PRIVATE_KEY, OPTION_ID_X509_PRIVATE_KEY },
+    { &OPTION_X509_ECC_CERT, OPTION_ID_X509_ECC_CERT },
+    { &OPTION_X509_ECC_KEY, OPTION_ID_X509_ECC_KEY },
+    { &OPTION_CURL_LOW_SPEED_LIMIT, OPTION_ID_CURL_LOW_SPEED_LIMIT },
+    { &OPTION_CURL_LOW_SPEED_TIME, OPTION_ID_CURL_LOW_SPEED_TIME },
+    { &OPTION_CURL_FRESH_CONNECT, OPTION_ID_CURL_FRESH_CONNECT },
+    { &OPTION_CURL_FORBID_REUSE, OPTION_ID_CURL_FORBID_REUSE },
+    { &OPTION_CURL_VERBOSE, OPTION_ID_CURL_VERBOSE },
+    { &OPTION_SAS_TOKEN_REFRESH_MARGIN, OPTION_ID_SAS_TOKEN_REFRESH_MARGIN },
+    { &OPTION_TRUSTED_CERT, OPTION_ID_TRUSTED_CERT },
+    { &OPTION_TLS_VERSION, OPTION_ID_TLS_VERSION },
+    { &OPTION_TLS_VALIDATION_CALLBACK, OPTION_ID_TLS_VALIDATION_CALLBACK },
+    { &OPTION_TLS_VALIDATION_CALLBACK_DATA, OPTION_ID_TLS_VALIDATION_CALLBACK_DATA },
+    { &OPTION_TCP_KEEP_ALIVE, OPTION_ID_TCP_KEEP_ALIVE },
+    { &OPTION_TCP_KEEP_ALIVE_TIME, OPTION_ID_TCP_KEEP_ALIVE_TIME },
+    { &OPTION_TCP_KEEP_ALIVE_INTERVAL, OPTION_ID_TCP_KEEP_ALIVE_INTERVAL }
+};
+
+static OPTION_ID GetOptionIdInternal(const char* name)
+{
+    OPTION_ID result = OPTION_ID_UNKNOWN;
+    size_t i;
+
+    /*this is a linear scan over all the known names, comparing the first character only saves calling strcmp on names that cannot match*/
+    for (i = 0; i < sizeof(optionNames) / sizeof(optionNames[0]); i++)
+    {
+        const char* optionName = *optionNames[i].name;
+        if ((optionName[0] == name[0]) &&
+            (strcmp(optionName, name) == 0))
+        {
+            result = optionNames[i].id;
+            break;
+        }
+    }
+
+    return result;
+}
+
+static void* CloneValue(OPTIONHANDLER_HANDLE handle, OPTION_ID id, const char* name, const void* value)
+{
+    void* result;
+    if (handle->cloneOptionById != NULL)
+    {
+        /*Codes_SRS_OPTIONHANDLER_01_021: [ If the option handler was created with OptionHandler_CreateWithOptionIds, OptionHandler_AddOption and OptionHandler_Clone shall clone value by calling cloneOptionById passing the id of the option, name and value. ]*/
+        result = handle->cloneOptionById(id, name, value);
+    }
+    else
+    {
+        /*Codes_SRS_OPTIONHANDLER_02_006: [ OptionHandler_AddProperty shall call pfCloneOption passing name and value. ]*/
+        result = handle->cloneOption(name, value);
+    }
+    return result;
+}
+
+static void DestroyValue(OPTIONHANDLER_HANDLE handle, OPTION_ID id, const char* name, const void* value)
+{
+    if (handle->destroyOptionById != NULL)
+    {
+        /*Codes_SRS_OPTIONHANDLER_01_022: [ If the option handler was created with OptionHandler_CreateWithOptionIds, the options shall be freed by calling destroyOptionById passing the saved id, name and value. ]*/
+        handle->destroyOptionById(id, name, value);
+    }
+    else
+    {
+        handle->destroyOption(name, value);
+    }
+}
+
+static OPTIONHANDLER_HANDLE CreateInternal(pfCloneOption cloneOption, pfDestroyOption destroyOption, pfSetOption setOption, pfCloneOptionById cloneOptionById, pfDestroyOptionById destroyOptionById, pfSetOptionById setOptionById)
 {
     OPTIONHANDLER_HANDLE result;
 
@@ -49,6 +135,9 @@ static OPTIONHANDLER_HANDLE CreateInternal(pfCloneOption cloneOption, pfDestroyO
             result->cloneOption = cloneOption;
             result->destroyOption = destroyOption;
             result->setOption = setOption;
+            result->cloneOptionById = cloneOptionById;
+            result->destroyOptionById = destroyOptionById;
+            result->setOptionById = setOptionById;
             /*return as is*/
         }
     }
@@ -56,7 +145,7 @@ static OPTIONHANDLER_HANDLE CreateInternal(pfCloneOption cloneOption, pfDestroyO
     return result;
 }
 
-static OPTIONHANDLER_RESULT AddOptionInternal(OPTIONHANDLER_HANDLE handle, const char* name, const void* value)
+static OPTIONHANDLER_RESULT AddOptionInternal(OPTIONHANDLER_HANDLE handle, const char* name, OPTION_ID id, const void* value)
 {
     OPTIONHANDLER_RESULT result;
     const char* cloneOfName;
@@ -68,8 +157,7 @@ static OPTIONHANDLER_RESULT AddOptionInternal(OPTIONHANDLER_HANDLE handle, const
     }
     else
     {
-        /*Codes_SRS_OPTIONHANDLER_02_006: [ OptionHandler_AddProperty shall call pfCloneOption passing name and value. ]*/
-        void* cloneOfValue = handle->cloneOption(name, value);
+        void* cloneOfValue = CloneValue(handle, id, name, value);
         if (cloneOfValue == NULL)
         {
             /*Codes_SRS_OPTIONHANDLER_02_009: [ Otherwise, OptionHandler_AddProperty shall succeed and return OPTIONHANDLER_ERROR. ]*/
@@ -81,13 +169,14 @@ static OPTIONHANDLER_RESULT AddOptionInternal(OPTIONHANDLER_HANDLE handle, const
         {
             OPTION temp;
             temp.name = cloneOfName;
+            temp.id = id;
             temp.storage = cloneOfValue;
             /*Codes_SRS_OPTIONHANDLER_02_007: [ OptionHandler_AddProperty shall use VECTOR APIs to save the name and the newly created clone of value. ]*/
             if (VECTOR_push_back(handle->storage, &temp, 1) != 0)
             {
                 /*Codes_SRS_OPTIONHANDLER_02_009: [ Otherwise, OptionHandler_AddProperty shall succeed and return OPTIONHANDLER_ERROR. ]*/
                 LogError("unable to VECTOR_push_back");
-                handle->destroyOption(name, cloneOfValue);
+                DestroyValue(handle, id, name, cloneOfValue);
                 free((void*)cloneOfName);
                 result = OPTIONHANDLER_ERROR;
             }
@@ -109,7 +198,7 @@ static void DestroyInternal(OPTIONHANDLER_HANDLE handle)
     for (i = 0; i < nOptions; i++)
     {
         OPTION* option = (OPTION*)VECTOR_element(handle->storage, i);
-        handle->destroyOption(option->name, option->storage);
+        DestroyValue(handle, option->id, option->name, option->storage);
         free((void*)option->name);
     }
 
@@ -132,13 +221,35 @@ OPTIONHANDLER_HANDLE OptionHandler_Create(pfCloneOption cloneOption, pfDestroyOp
     }
     else
     {
-        result = CreateInternal(cloneOption, destroyOption, setOption);
+        result = CreateInternal(cloneOption, destroyOption, setOption, NULL, NULL, NULL);
     }
 
     return result;
 
 }
 
+OPTIONHANDLER_HANDLE OptionHandler_CreateWithOptionIds(pfCloneOptionById cloneOptionById, pfDestroyOptionById destroyOptionById, pfSetOptionById setOptionById)
+{
+    OPTIONHANDLER_HANDLE_DATA* result;
+    if (
+        (cloneOptionById == NULL) ||
+        (destroyOptionById == NULL) ||
+        (setOptionById == NULL)
+        )
+    {
+        /*Codes_SRS_OPTIONHANDLER_01_012: [ OptionHandler_CreateWithOptionIds shall fail and return NULL if any parameters are NULL. ]*/
+        LogError("invalid parameter = pfCloneOptionById cloneOptionById=%p, pfDestroyOptionById destroyOptionById=%p, pfSetOptionById setOptionById=%p", cloneOptionById, destroyOptionById, setOptionById);
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_OPTIONHANDLER_01_013: [ Otherwise OptionHandler_CreateWithOptionIds shall create the option handler as OptionHandler_Create does, except that its options shall be cloned with cloneOptionById, destroyed with destroyOptionById and fed with setOptionById. ]*/
+        result = CreateInternal(NULL, NULL, NULL, cloneOptionById, destroyOptionById, setOptionById);
+    }
+
+    return result;
+}
+
 OPTIONHANDLER_HANDLE OptionHandler_Clone(OPTIONHANDLER_HANDLE handler)
 {
     OPTIONHANDLER_HANDLE_DATA* result;
@@ -154,7 +265,8 @@ OPTIONHANDLER_HANDLE OptionHandler_Clone(OPTIONHANDLER_HANDLE handler)
         /* Codes_SRS_OPTIONHANDLER_01_001: [ `OptionHandler_Clone` shall clone an existing option handler instance. ]*/
         /* Codes_SRS_OPTIONHANDLER_01_002: [ On success it shall return a non-NULL handle. ]*/
         /* Codes_SRS_OPTIONHANDLER_01_003: [ `OptionHandler_Clone` shall allocate memory for the new option handler instance. ]*/
-        result = CreateInternal(handler->cloneOption, handler->destroyOption, handler->setOption);
+        /* Codes_SRS_OPTIONHANDLER_01_016: [ The clone shall clone, destroy and feed its options with the same functions as handler. ]*/
+        result = CreateInternal(handler->cloneOption, handler->destroyOption, handler->setOption, handler->cloneOptionById, handler->destroyOptionById, handler->setOptionById);
         if (result == NULL)
         {
             /* Codes_SRS_OPTIONHANDLER_01_004: [ If allocating memory fails, `OptionHandler_Clone` shall return NULL. ]*/
@@ -172,7 +284,8 @@ OPTIONHANDLER_HANDLE OptionHandler_Clone(OPTIONHANDLER_HANDLE handler)
 
                 /* Codes_SRS_OPTIONHANDLER_01_006: [ For each option the option name shall be cloned by calling `mallocAndStrcpy_s`. ]*/
                 /* Codes_SRS_OPTIONHANDLER_01_007: [ For each option the value shall be cloned by using the cloning function associated with the source option handler `handler`. ]*/
-                if (AddOptionInternal(result, option->name, option->storage) != OPTIONHANDLER_OK)
+                /* Codes_SRS_OPTIONHANDLER_01_017: [ The saved id of every option shall be copied to the clone. ]*/
+                if (AddOptionInternal(result, option->name, option->id, option->storage) != OPTIONHANDLER_OK)
                 {
                     /* Codes_SRS_OPTIONHANDLER_01_008: [ If cloning one of the option names fails, `OptionHandler_Clone` shall return NULL. ]*/
                     /* Codes_SRS_OPTIONHANDLER_01_009: [ If cloning one of the option values fails, `OptionHandler_Clone` shall return NULL. ]*/
@@ -207,7 +320,8 @@ OPTIONHANDLER_RESULT OptionHandler_AddOption(OPTIONHANDLER_HANDLE handle, const
     }
     else
     {
-        result = AddOptionInternal(handle, name, value);
+        /*Codes_SRS_OPTIONHANDLER_01_014: [ OptionHandler_AddOption shall save along with name the id of name as returned by OptionHandler_GetOptionId. ]*/
+        result = AddOptionInternal(handle, name, GetOptionIdInternal(name), value);
     }
 
     return result;
@@ -232,8 +346,19 @@ OPTIONHANDLER_RESULT OptionHandler_FeedOptions(OPTIONHANDLER_HANDLE handle, void
         for (i = 0;i < nOptions;i++)
         {
             OPTION* option = (OPTION*)VECTOR_element(handle->storage, i);
-            /*Codes_SRS_OPTIONHANDLER_02_012: [ OptionHandler_FeedOptions shall call for every pair of name,value setOption passing destinationHandle, name and value. ]*/
-            if (handle->setOption(destinationHandle, option->name, option->storage) != 0)
+            int setOptionResult;
+            if (handle->setOptionById != NULL)
+            {
+                /*Codes_SRS_OPTIONHANDLER_01_015: [ If the option handler was created with OptionHandler_CreateWithOptionIds, OptionHandler_FeedOptions shall call for every option setOptionById passing destinationHandle, the saved id, name and value. ]*/
+                setOptionResult = handle->setOptionById(destinationHandle, option->id, option->name, option->storage);
+            }
+            else
+            {
+                /*Codes_SRS_OPTIONHANDLER_02_012: [ OptionHandler_FeedOptions shall call for every pair of name,value setOption passing destinationHandle, name and value. ]*/
+                setOptionResult = handle->setOption(destinationHandle, option->name, option->storage);
+            }
+
+            if (setOptionResult != 0)
             {
                 LogError("failure while trying to _SetOption");
                 break;
@@ -266,3 +391,22 @@ void OptionHandler_Destroy(OPTIONHANDLER_HANDLE handle)
         DestroyInternal(handle);
     }
 }
+
+OPTION_ID OptionHandler_GetOptionId(const char* name)
+{
+    OPTION_ID result;
+    if (name == NULL)
+    {
+        /*Codes_SRS_OPTIONHANDLER_01_018: [ If name is NULL, OptionHandler_GetOptionId shall return OPTION_ID_UNKNOWN. ]*/
+        LogError("invalid argument const char* name=%p", name);
+        result = OPTION_ID_UNKNOWN;
+    }
+    else
+    {
+        /*Codes_SRS_OPTIONHANDLER_01_019: [ OptionHandler_GetOptionId shall return the OPTION_ID of name when name is one of the option names of shared_util_options.h. ]*/
+        /*Codes_SRS_OPTIONHANDLER_01_020: [ Otherwise OptionHandler_GetOptionId shall return OPTION_ID_UNKNOWN. ]*/
+        result = GetOptionIdInternal(name);
+    }
+
+    return result;
+}
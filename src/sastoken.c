@@ -7,7 +7,7 @@
 #include "azure_c_shared_utility/gballoc.h"
 #include "azure_c_shared_utility/sastoken.h"
 #include "azure_c_shared_utility/urlencode.h"
-#include "azure_c_shared_utility/hmacsha256.h"
+#include "azure_c_shared_utility/sha.h"
 #include "azure_c_shared_utility/base64.h"
 #include "azure_c_shared_utility/agenttime.h"
 #include "azure_c_shared_utility/strings.h"
@@ -202,11 +202,259 @@ bool SASToken_Validate(STRING_HANDLE sasToken)
     return result;
 }
 
-static STRING_HANDLE construct_sas_token(const char* key, const char* scope, const char* keyname, size_t expiry)
+#define SAS_TOKEN_PREFIX                "SharedAccessSignature sr="
+#define SAS_TOKEN_SIGNATURE_IDENTIFIER  "&sig="
+#define SAS_TOKEN_EXPIRY_IDENTIFIER     "&se="
+#define SAS_TOKEN_KEYNAME_IDENTIFIER    "&skn="
+
+/* an HMAC-SHA256 is 32 bytes, which base64 encodes to 44 characters. Only '+', '/' and '=' need url encoding and each becomes 3 characters */
+#define SIGNATURE_BASE64_LENGTH         ((SHA256HashSize + 2) / 3 * 4)
+#define MAX_SIGNATURE_LENGTH            (SIGNATURE_BASE64_LENGTH * 3)
+
+typedef struct SAS_TOKEN_PARTS_TAG
+{
+    const char* scope;
+    size_t scopeLength;
+    const char* keyName;
+    size_t keyNameLength;
+    char tokenExpirationTime[32];
+    size_t tokenExpirationTimeLength;
+    char signature[MAX_SIGNATURE_LENGTH];
+    size_t signatureLength;
+} SAS_TOKEN_PARTS;
+
+static const char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static size_t url_encode_base64_char(char base64Char, char* destination)
+{
+    size_t result;
+    switch (base64Char)
+    {
+    case '+':
+        destination[0] = '%'; destination[1] = '2'; destination[2] = 'b';
+        result = 3;
+        break;
+    case '/':
+        destination[0] = '%'; destination[1] = '2'; destination[2] = 'f';
+        result = 3;
+        break;
+    case '=':
+        destination[0] = '%'; destination[1] = '3'; destination[2] = 'd';
+        result = 3;
+        break;
+    default:
+        destination[0] = base64Char;
+        result = 1;
+        break;
+    }
+    return result;
+}
+
+/* base64 encodes the hash and url encodes each produced character in the same pass */
+static size_t encode_signature(const unsigned char* hash, size_t hashLength, char* destination)
+{
+    size_t result = 0;
+    size_t i;
+
+    for (i = 0; i + 2 < hashLength; i += 3)
+    {
+        result += url_encode_base64_char(base64_chars[hash[i] >> 2], destination + result);
+        result += url_encode_base64_char(base64_chars[((hash[i] & 0x03) << 4) | (hash[i + 1] >> 4)], destination + result);
+        result += url_encode_base64_char(base64_chars[((hash[i + 1] & 0x0F) << 2) | (hash[i + 2] >> 6)], destination + result);
+        result += url_encode_base64_char(base64_chars[hash[i + 2] & 0x3F], destination + result);
+    }
+
+    if (i + 1 == hashLength)
+    {
+        result += url_encode_base64_char(base64_chars[hash[i] >> 2], destination + result);
+        result += url_encode_base64_char(base64_chars[(hash[i] & 0x03) << 4], destination + result);
+        result += url_encode_base64_char('=', destination + result);
+        result += url_encode_base64_char('=', destination + result);
+    }
+    else if (i + 2 == hashLength)
+    {
+        result += url_encode_base64_char(base64_chars[hash[i] >> 2], destination + result);
+        result += url_encode_base64_char(base64_chars[((hash[i] & 0x03) << 4) | (hash[i + 1] >> 4)], destination + result);
+        result += url_encode_base64_char(base64_chars[(hash[i + 1] & 0x0F) << 2], destination + result);
+        result += url_encode_base64_char('=', destination + result);
+    }
+
+    return result;
+}
+
+static int init_sas_token_parts(const char* scope, const char* keyName, size_t expiry, SAS_TOKEN_PARTS* parts)
+{
+    int result;
+
+    /*Codes_SRS_SASTOKEN_06_026: [If the conversion to string form fails for any reason then SASToken_Create shall return NULL.]*/
+    if (size_tToString(parts->tokenExpirationTime, sizeof(parts->tokenExpirationTime), expiry) != 0)
+    {
+        LogError("For some reason converting seconds to a string failed.  No SAS can be generated.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        parts->scope = scope;
+        parts->scopeLength = strlen(scope);
+        parts->keyName = keyName;
+        parts->keyNameLength = strlen(keyName);
+        parts->tokenExpirationTimeLength = strlen(parts->tokenExpirationTime);
+        result = 0;
+    }
+
+    return result;
+}
+
+/* runs the key dependent part of the HMAC (hashing the inner and outer pads) so that keyedContext can be copied for every token signed with the same key */
+static int init_keyed_hmac(BUFFER_HANDLE decodedKey, HMACKeyContext* keyedContext)
+{
+    int result;
+    const unsigned char* key = BUFFER_u_char(decodedKey);
+    size_t keyLength = BUFFER_length(decodedKey);
+
+    if ((key == NULL) ||
+        (keyLength == 0) ||
+        (hmacKeyReset(keyedContext, SHA256, key, (int)keyLength) != 0))
+    {
+        /*Codes_SRS_SASTOKEN_06_013: [If an error is returned from the HMAC256 function then NULL is returned from SASToken_Create.]*/
+        LogError("Unable to initialize the HMAC with the decoded key.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+/* computes the url encoded signature and the exact length of the token (without the null terminator) */
+static int sign_sas_token(const HMACKeyContext* keyedContext, SAS_TOKEN_PARTS* parts, size_t* tokenLength)
+{
+    int result;
+    HMACKeyContext hmacContext = *keyedContext;
+    uint8_t hash[USHAMaxHashSize];
+
+    /*Codes_SRS_SASTOKEN_06_009: [The scope is the basis for creating a STRING_HANDLE.]*/
+    /*Codes_SRS_SASTOKEN_06_010: [A "\n" is appended to that string.]*/
+    /*Codes_SRS_SASTOKEN_06_011: [tokenExpirationTime is appended to that string.]*/
+    /*Codes_SRS_SASTOKEN_06_012: [An HMAC256 hash is calculated using the decodedKey, over toBeHashed.]*/
+    if ((hmacKeyInput(&hmacContext, (const unsigned char*)parts->scope, (int)parts->scopeLength) != 0) ||
+        (hmacKeyInput(&hmacContext, (const unsigned char*)"\n", 1) != 0) ||
+        (hmacKeyInput(&hmacContext, (const unsigned char*)parts->tokenExpirationTime, (int)parts->tokenExpirationTimeLength) != 0) ||
+        (hmacKeyResult(&hmacContext, hash) != 0))
+    {
+        /*Codes_SRS_SASTOKEN_06_013: [If an error is returned from the HMAC256 function then NULL is returned from SASToken_Create.]*/
+        LogError("Unable to compute the HMAC to prepare SAS token.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /*Codes_SRS_SASTOKEN_06_015: [The hash is base 64 encoded.]*/
+        /*Codes_SRS_SASTOKEN_06_028: [base64Signature shall be url encoded.]*/
+        parts->signatureLength = encode_signature(hash, SHA256HashSize, parts->signature);
+
+        *tokenLength = (sizeof(SAS_TOKEN_PREFIX) - 1) + parts->scopeLength +
+            (sizeof(SAS_TOKEN_SIGNATURE_IDENTIFIER) - 1) + parts->signatureLength +
+            (sizeof(SAS_TOKEN_EXPIRY_IDENTIFIER) - 1) + parts->tokenExpirationTimeLength +
+            (sizeof(SAS_TOKEN_KEYNAME_IDENTIFIER) - 1) + parts->keyNameLength;
+        result = 0;
+    }
+
+    return result;
+}
+
+static int prepare_sas_token(BUFFER_HANDLE decodedKey, const char* scope, const char* keyName, size_t expiry, SAS_TOKEN_PARTS* parts, size_t* tokenLength)
+{
+    int result;
+    HMACKeyContext keyedContext;
+
+    if ((init_sas_token_parts(scope, keyName, expiry, parts) != 0) ||
+        (init_keyed_hmac(decodedKey, &keyedContext) != 0) ||
+        (sign_sas_token(&keyedContext, parts, tokenLength) != 0))
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        result = 0;
+    }
+
+    return result;
+}
+
+static char* append_token_part(char* destination, const char* source, size_t length)
+{
+    (void)memcpy(destination, source, length);
+    return destination + length;
+}
+
+static void write_sas_token(const SAS_TOKEN_PARTS* parts, char* destination)
+{
+    /*Codes_SRS_SASTOKEN_06_016: [The string "SharedAccessSignature sr=" is the first part of the result of SASToken_Create.]*/
+    destination = append_token_part(destination, SAS_TOKEN_PREFIX, sizeof(SAS_TOKEN_PREFIX) - 1);
+    /*Codes_SRS_SASTOKEN_06_017: [The scope parameter is appended to result.]*/
+    destination = append_token_part(destination, parts->scope, parts->scopeLength);
+    /*Codes_SRS_SASTOKEN_06_018: [The string "&sig=" is appended to result.]*/
+    destination = append_token_part(destination, SAS_TOKEN_SIGNATURE_IDENTIFIER, sizeof(SAS_TOKEN_SIGNATURE_IDENTIFIER) - 1);
+    /*Codes_SRS_SASTOKEN_06_019: [The string urlEncodedSignature shall be appended to result.]*/
+    destination = append_token_part(destination, parts->signature, parts->signatureLength);
+    /*Codes_SRS_SASTOKEN_06_020: [The string "&se=" shall be appended to result.]*/
+    destination = append_token_part(destination, SAS_TOKEN_EXPIRY_IDENTIFIER, sizeof(SAS_TOKEN_EXPIRY_IDENTIFIER) - 1);
+    /*Codes_SRS_SASTOKEN_06_021: [tokenExpirationTime is appended to result.]*/
+    destination = append_token_part(destination, parts->tokenExpirationTime, parts->tokenExpirationTimeLength);
+    /*Codes_SRS_SASTOKEN_06_022: [The string "&skn=" is appended to result.]*/
+    destination = append_token_part(destination, SAS_TOKEN_KEYNAME_IDENTIFIER, sizeof(SAS_TOKEN_KEYNAME_IDENTIFIER) - 1);
+    /*Codes_SRS_SASTOKEN_06_023: [The argument keyName is appended to result.]*/
+    destination = append_token_part(destination, parts->keyName, parts->keyNameLength);
+    *destination = '\0';
+}
+
+static STRING_HANDLE create_sas_token_string(const SAS_TOKEN_PARTS* parts, size_t tokenLength)
 {
     STRING_HANDLE result;
+    /*Codes_SRS_SASTOKEN_01_003: [ The SAS token shall be written into a single allocation of exactly the token length plus the null terminator, which shall be handed over to STRING_new_with_memory. ]*/
+    char* token = (char*)malloc(tokenLength + 1);
+    if (token == NULL)
+    {
+        LogError("Unable to allocate memory for the SAS token.");
+        result = NULL;
+    }
+    else
+    {
+        write_sas_token(parts, token);
+        if ((result = STRING_new_with_memory(token)) == NULL)
+        {
+            LogError("Unable to create the SAS token string.");
+            free(token);
+        }
+    }
+
+    return result;
+}
+
+static STRING_HANDLE construct_sas_token_with_decoded_key(BUFFER_HANDLE decodedKey, const char* scope, const char* keyname, size_t expiry)
+{
+    STRING_HANDLE result;
+    SAS_TOKEN_PARTS parts;
+    size_t tokenLength;
+
+    /*Codes_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
+    if (prepare_sas_token(decodedKey, scope, keyname, expiry, &parts, &tokenLength) != 0)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = create_sas_token_string(&parts, tokenLength);
+    }
 
-    char tokenExpirationTime[32] = { 0 };
+    return result;
+}
+
+static STRING_HANDLE construct_sas_token(const char* key, const char* scope, const char* keyname, size_t expiry)
+{
+    STRING_HANDLE result;
 
     BUFFER_HANDLE decodedKey;
 
@@ -219,84 +467,7 @@ static STRING_HANDLE construct_sas_token(const char* key, const char* scope, con
     }
     else
     {
-        /*Codes_SRS_SASTOKEN_06_026: [If the conversion to string form fails for any reason then SASToken_Create shall return NULL.]*/
-        if (size_tToString(tokenExpirationTime, sizeof(tokenExpirationTime), expiry) != 0)
-        {
-            LogError("For some reason converting seconds to a string failed.  No SAS can be generated.");
-            result = NULL;
-        }
-        else
-        {
-            STRING_HANDLE toBeHashed = NULL;
-            BUFFER_HANDLE hash = NULL;
-            if (((hash = BUFFER_new()) == NULL) ||
-                ((toBeHashed = STRING_new()) == NULL) ||
-                ((result = STRING_new()) == NULL))
-            {
-                LogError("Unable to allocate memory to prepare SAS token.");
-                result = NULL;
-            }
-            else
-            {
-                /*Codes_SRS_SASTOKEN_06_009: [The scope is the basis for creating a STRING_HANDLE.]*/
-                /*Codes_SRS_SASTOKEN_06_010: [A "\n" is appended to that string.]*/
-                /*Codes_SRS_SASTOKEN_06_011: [tokenExpirationTime is appended to that string.]*/
-                if ((STRING_concat(toBeHashed, scope) != 0) ||
-                    (STRING_concat(toBeHashed, "\n") != 0) ||
-                    (STRING_concat(toBeHashed, tokenExpirationTime) != 0))
-                {
-                    LogError("Unable to build the input to the HMAC to prepare SAS token.");
-                    STRING_delete(result);
-                    result = NULL;
-                }
-                else
-                {
-                    STRING_HANDLE base64Signature = NULL;
-                    STRING_HANDLE urlEncodedSignature = NULL;
-                    size_t inLen = STRING_length(toBeHashed);
-                    const unsigned char* inBuf = (const unsigned char*)STRING_c_str(toBeHashed);
-                    size_t outLen = BUFFER_length(decodedKey);
-                    unsigned char* outBuf = BUFFER_u_char(decodedKey);
-                    /*Codes_SRS_SASTOKEN_06_013: [If an error is returned from the HMAC256 function then NULL is returned from SASToken_Create.]*/
-                    /*Codes_SRS_SASTOKEN_06_012: [An HMAC256 hash is calculated using the decodedKey, over toBeHashed.]*/
-                    /*Codes_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
-                    /*Codes_SRS_SASTOKEN_06_015: [The hash is base 64 encoded.]*/
-                    /*Codes_SRS_SASTOKEN_06_028: [base64Signature shall be url encoded.]*/
-                    /*Codes_SRS_SASTOKEN_06_016: [The string "SharedAccessSignature sr=" is the first part of the result of SASToken_Create.]*/
-                    /*Codes_SRS_SASTOKEN_06_017: [The scope parameter is appended to result.]*/
-                    /*Codes_SRS_SASTOKEN_06_018: [The string "&sig=" is appended to result.]*/
-                    /*Codes_SRS_SASTOKEN_06_019: [The string urlEncodedSignature shall be appended to result.]*/
-                    /*Codes_SRS_SASTOKEN_06_020: [The string "&se=" shall be appended to result.]*/
-                    /*Codes_SRS_SASTOKEN_06_021: [tokenExpirationTime is appended to result.]*/
-                    /*Codes_SRS_SASTOKEN_06_022: [The string "&skn=" is appended to result.]*/
-                    /*Codes_SRS_SASTOKEN_06_023: [The argument keyName is appended to result.]*/
-                    if ((HMACSHA256_ComputeHash(outBuf, outLen, inBuf, inLen, hash) != HMACSHA256_OK) ||
-                        ((base64Signature = Base64_Encoder(hash)) == NULL) ||
-                        ((urlEncodedSignature = URL_Encode(base64Signature)) == NULL) ||
-                        (STRING_copy(result, "SharedAccessSignature sr=") != 0) ||
-                        (STRING_concat(result, scope) != 0) ||
-                        (STRING_concat(result, "&sig=") != 0) ||
-                        (STRING_concat_with_STRING(result, urlEncodedSignature) != 0) ||
-                        (STRING_concat(result, "&se=") != 0) ||
-                        (STRING_concat(result, tokenExpirationTime) != 0) ||
-                        (STRING_concat(result, "&skn=") != 0) ||
-                        (STRING_concat(result, keyname) != 0))
-                    {
-                        LogError("Unable to build the SAS token.");
-                        STRING_delete(result);
-                        result = NULL;
-                    }
-                    else
-                    {
-                        /* everything OK */
-                    }
-                    STRING_delete(base64Signature);
-                    STRING_delete(urlEncodedSignature);
-                }
-            }
-            STRING_delete(toBeHashed);
-            BUFFER_delete(hash);
-        }
+        result = construct_sas_token_with_decoded_key(decodedKey, scope, keyname, expiry);
         BUFFER_delete(decodedKey);
     }
     return result;
@@ -346,3 +517,168 @@ STRING_HANDLE SASToken_CreateString(const char* key, const char* scope, const ch
     }
     return result;
 }
+
+STRING_HANDLE SASToken_CreateWithDecodedKey(BUFFER_HANDLE decodedKey, const char* scope, const char* keyName, size_t expiry)
+{
+    STRING_HANDLE result;
+
+    /*Codes_SRS_SASTOKEN_01_001: [ If decodedKey, scope or keyName is NULL then SASToken_CreateWithDecodedKey shall return NULL. ]*/
+    if ((decodedKey == NULL) ||
+        (scope == NULL) ||
+        (keyName == NULL))
+    {
+        LogError("Invalid Parameter to SASToken_CreateWithDecodedKey. decodedKey: %p, scope: %p, keyName: %p", decodedKey, scope, keyName);
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_SASTOKEN_01_002: [ SASToken_CreateWithDecodedKey shall build the SAS token exactly like SASToken_Create, using decodedKey as the HMAC key instead of decoding a base64 key. ]*/
+        result = construct_sas_token_with_decoded_key(decodedKey, scope, keyName, expiry);
+    }
+    return result;
+}
+
+int SASToken_CreateInto(BUFFER_HANDLE decodedKey, const char* scope, const char* keyName, size_t expiry, char* destination, size_t destinationSize, size_t* tokenLength)
+{
+    int result;
+
+    /*Codes_SRS_SASTOKEN_01_004: [ If decodedKey, scope, keyName or tokenLength is NULL then SASToken_CreateInto shall fail and return a non-zero value. ]*/
+    if ((decodedKey == NULL) ||
+        (scope == NULL) ||
+        (keyName == NULL) ||
+        (tokenLength == NULL))
+    {
+        LogError("Invalid Parameter to SASToken_CreateInto. decodedKey: %p, scope: %p, keyName: %p, tokenLength: %p", decodedKey, scope, keyName, tokenLength);
+        result = __FAILURE__;
+    }
+    else
+    {
+        SAS_TOKEN_PARTS parts;
+        size_t length;
+
+        if (prepare_sas_token(decodedKey, scope, keyName, expiry, &parts, &length) != 0)
+        {
+            /*Codes_SRS_SASTOKEN_01_005: [ If computing the SAS token fails, SASToken_CreateInto shall fail and return a non-zero value. ]*/
+            result = __FAILURE__;
+        }
+        else
+        {
+            /*Codes_SRS_SASTOKEN_01_006: [ SASToken_CreateInto shall set *tokenLength to the length of the SAS token, not including the null terminator. ]*/
+            *tokenLength = length;
+
+            if ((destination == NULL) ||
+                (destinationSize <= length))
+            {
+                /*Codes_SRS_SASTOKEN_01_007: [ If destination is NULL or destinationSize is not larger than the SAS token length, SASToken_CreateInto shall fail and return a non-zero value. ]*/
+                result = __FAILURE__;
+            }
+            else
+            {
+                /*Codes_SRS_SASTOKEN_01_008: [ Otherwise SASToken_CreateInto shall write the null terminated SAS token, built exactly like SASToken_Create builds it, into destination without allocating any memory and return 0. ]*/
+                write_sas_token(&parts, destination);
+                result = 0;
+            }
+        }
+    }
+
+    return result;
+}
+
+int SASToken_CreateBatch(const SAS_TOKEN_REQUEST* requests, size_t requestCount, STRING_HANDLE* tokens)
+{
+    int result;
+
+    /*Codes_SRS_SASTOKEN_01_009: [ If requests or tokens is NULL or requestCount is 0 then SASToken_CreateBatch shall fail and return a non-zero value. ]*/
+    if ((requests == NULL) ||
+        (requestCount == 0) ||
+        (tokens == NULL))
+    {
+        LogError("Invalid Parameter to SASToken_CreateBatch. requests: %p, requestCount: %lu, tokens: %p", requests, (unsigned long)requestCount, tokens);
+        result = __FAILURE__;
+    }
+    else
+    {
+        HMACKeyContext keyedContext;
+        const char* keyedContextKey = NULL;
+        size_t i;
+
+        for (i = 0; i < requestCount; i++)
+        {
+            tokens[i] = NULL;
+        }
+
+        result = 0;
+
+        for (i = 0; (result == 0) && (i < requestCount); i++)
+        {
+            const SAS_TOKEN_REQUEST* request = &requests[i];
+            SAS_TOKEN_PARTS parts;
+            size_t tokenLength;
+
+            if ((request->key == NULL) ||
+                (request->scope == NULL) ||
+                (request->keyName == NULL))
+            {
+                /*Codes_SRS_SASTOKEN_01_010: [ If the key, scope or keyName of any request is NULL then SASToken_CreateBatch shall fail and return a non-zero value. ]*/
+                LogError("Invalid request %lu to SASToken_CreateBatch. key: %p, scope: %p, keyName: %p", (unsigned long)i, request->key, request->scope, request->keyName);
+                result = __FAILURE__;
+            }
+            else
+            {
+                /*Codes_SRS_SASTOKEN_01_011: [ When a request has the same key as the previous request, the key shall not be decoded again and the HMAC state computed from it shall be reused. ]*/
+                if ((keyedContextKey == NULL) ||
+                    (strcmp(keyedContextKey, request->key) != 0))
+                {
+                    /*Codes_SRS_SASTOKEN_01_012: [ Otherwise the key shall be decoded from base64 and used to initialize the HMAC state. ]*/
+                    BUFFER_HANDLE decodedKey = Base64_Decoder(request->key);
+                    if (decodedKey == NULL)
+                    {
+                        LogError("Unable to decode the key of request %lu.", (unsigned long)i);
+                        result = __FAILURE__;
+                    }
+                    else
+                    {
+                        if (init_keyed_hmac(decodedKey, &keyedContext) != 0)
+                        {
+                            result = __FAILURE__;
+                        }
+                        else
+                        {
+                            keyedContextKey = request->key;
+                        }
+
+                        BUFFER_delete(decodedKey);
+                    }
+                }
+
+                /*Codes_SRS_SASTOKEN_01_013: [ Each token shall be built exactly like SASToken_CreateString builds it and stored at the same index in tokens. ]*/
+                if ((result == 0) &&
+                    ((init_sas_token_parts(request->scope, request->keyName, request->expiry, &parts) != 0) ||
+                     (sign_sas_token(&keyedContext, &parts, &tokenLength) != 0) ||
+                     ((tokens[i] = create_sas_token_string(&parts, tokenLength)) == NULL)))
+                {
+                    result = __FAILURE__;
+                }
+            }
+        }
+
+        if (result != 0)
+        {
+            /*Codes_SRS_SASTOKEN_01_014: [ If creating any token fails, SASToken_CreateBatch shall free all tokens created so far, set them to NULL and return a non-zero value. ]*/
+            for (i = 0; i < requestCount; i++)
+            {
+                if (tokens[i] != NULL)
+                {
+                    STRING_delete(tokens[i]);
+                    tokens[i] = NULL;
+                }
+            }
+        }
+        else
+        {
+            /*Codes_SRS_SASTOKEN_01_015: [ On success SASToken_CreateBatch shall return 0. ]*/
+        }
+    }
+
+    return result;
+}
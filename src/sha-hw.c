@@ -0,0 +1,490 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/**************************** sha-hw.c ****************************/
+/*
+*  Description:
+*      This file implements the SHA-1 and SHA-256 block functions
+*      with the SHA instructions found in recent processors:
+*          - the x86 SHA extensions (SHA-NI), available with
+*            gcc/clang on x86 and x64 and with Visual Studio 2015
+*            and later;
+*          - the ARMv8 cryptography extensions, available when the
+*            compiler targets them (for example with
+*            -march=armv8-a+crypto).
+*      It also implements an AVX2 SHA-256 block function hashing
+*      one block of 8 independent messages at once, which is used by
+*      SHA256InputResultMultiple.
+*
+*      The presence of the instructions is checked at runtime, so
+*      a library built with them still runs on processors that lack
+*      them: the Hardware functions then return NULL and sha1.c and
+*      sha224.c keep using the portable RFC 4634 code.
+*
+*      Defining NO_HARDWARE_SHA (the no_hardware_sha cmake option)
+*      compiles the hardware code out.
+*/
+
+#include <stdlib.h>
+#include "azure_c_shared_utility/gballoc.h"
+
+#include "azure_c_shared_utility/sha.h"
+#include "azure_c_shared_utility/sha-private.h"
+#include "azure_c_shared_utility/cpu_features.h"
+
+#if !defined(NO_HARDWARE_SHA)
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5)))
+#define SHA_HW_X86
+#include <immintrin.h>
+#define SHA_HW_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#define SHA_HW_AVX2_TARGET __attribute__((target("avx2")))
+#elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER) && (_MSC_VER >= 1900)
+#define SHA_HW_X86
+#include <immintrin.h>
+#define SHA_HW_TARGET
+#define SHA_HW_AVX2_TARGET
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2))
+#define SHA_HW_ARM
+#include <arm_neon.h>
+#endif
+#endif /* NO_HARDWARE_SHA */
+
+#if defined(SHA_HW_X86)
+/* the SHA extensions, and the SSSE3/SSE4.1 instructions used to shuffle the state and the message */
+#define SHA_HW_X86_SHA_FEATURES \
+    (CPU_FEATURE_X86_SHA | CPU_FEATURE_X86_SSSE3 | CPU_FEATURE_X86_SSE41)
+#endif
+
+#if defined(SHA_HW_X86) || defined(SHA_HW_ARM)
+/* Constants defined in FIPS-180-2, section 4.2.2 */
+static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b,
+    0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01,
+    0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7,
+    0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+    0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152,
+    0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819,
+    0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08,
+    0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f,
+    0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+#endif
+
+#if defined(SHA_HW_X86)
+
+/*
+*  SHA256ProcessBlocksX86
+*
+*  Description:
+*      Hashes block_count 64 byte blocks with the SHA-NI
+*      instructions. The instructions keep the state as the ABEF
+*      and CDGH word pairs, so the intermediate hash is shuffled
+*      in and out of that layout around the blocks.
+*
+*      Each iteration of the inner loop does 4 rounds and computes
+*      the 4 message words needed 4 iterations later.
+*/
+SHA_HW_TARGET
+static void SHA256ProcessBlocksX86(uint32_t *Intermediate_Hash,
+    const uint8_t *blocks, unsigned int block_count)
+{
+    const __m128i byte_swap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0;
+    __m128i state1;
+    __m128i temp;
+
+    temp = _mm_loadu_si128((const __m128i*)&Intermediate_Hash[0]);
+    state1 = _mm_loadu_si128((const __m128i*)&Intermediate_Hash[4]);
+    temp = _mm_shuffle_epi32(temp, 0xB1);            /* CDAB */
+    state1 = _mm_shuffle_epi32(state1, 0x1B);        /* EFGH */
+    state0 = _mm_alignr_epi8(temp, state1, 8);       /* ABEF */
+    state1 = _mm_blend_epi16(state1, temp, 0xF0);    /* CDGH */
+
+    while (block_count--) {
+        const __m128i abef_save = state0;
+        const __m128i cdgh_save = state1;
+        __m128i W[4];
+        int i;
+
+        for (i = 0; i < 4; i++)
+            W[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + (i * 16))), byte_swap);
+
+        for (i = 0; i < 16; i++) {
+            __m128i message = _mm_add_epi32(W[i & 3], _mm_loadu_si128((const __m128i*)&SHA256_K[i * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, message);
+            message = _mm_shuffle_epi32(message, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, message);
+
+            if (i < 12) {
+                temp = _mm_sha256msg1_epu32(W[i & 3], W[(i + 1) & 3]);
+                temp = _mm_add_epi32(temp, _mm_alignr_epi8(W[(i + 3) & 3], W[(i + 2) & 3], 4));
+                W[i & 3] = _mm_sha256msg2_epu32(temp, W[(i + 3) & 3]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+        blocks += SHA256_Message_Block_Size;
+    }
+
+    temp = _mm_shuffle_epi32(state0, 0x1B);          /* FEBA */
+    state1 = _mm_shuffle_epi32(state1, 0xB1);        /* DCHG */
+    state0 = _mm_blend_epi16(temp, state1, 0xF0);    /* DCBA */
+    state1 = _mm_alignr_epi8(state1, temp, 8);       /* HGFE */
+
+    _mm_storeu_si128((__m128i*)&Intermediate_Hash[0], state0);
+    _mm_storeu_si128((__m128i*)&Intermediate_Hash[4], state1);
+}
+
+/*
+* Four SHA-1 rounds: j is the index of the 4 message words (0 to 19).
+* The sha1rnds4 function selector has to be a constant, which is
+* why the rounds are unrolled through this macro rather than looped.
+*/
+#define SHA1_X86_ROUNDS(j)                                                  \
+    do {                                                                    \
+        if ((j) == 0)                                                       \
+            E[0] = _mm_add_epi32(E[0], W[0]);                               \
+        else                                                                \
+            E[(j) & 1] = _mm_sha1nexte_epu32(E[(j) & 1], W[(j) & 3]);       \
+        E[((j) + 1) & 1] = abcd;                                            \
+        if ((j) >= 3 && (j) <= 18)                                          \
+            W[((j) + 1) & 3] = _mm_sha1msg2_epu32(W[((j) + 1) & 3], W[(j) & 3]); \
+        abcd = _mm_sha1rnds4_epu32(abcd, E[(j) & 1], (j) / 5);              \
+        if ((j) >= 1 && (j) <= 16)                                          \
+            W[((j) - 1) & 3] = _mm_sha1msg1_epu32(W[((j) - 1) & 3], W[(j) & 3]); \
+        if ((j) >= 2 && (j) <= 17)                                          \
+            W[((j) - 2) & 3] = _mm_xor_si128(W[((j) - 2) & 3], W[(j) & 3]); \
+    } while (0)
+
+/*
+*  SHA1ProcessBlocksX86
+*
+*  Description:
+*      Hashes block_count 64 byte blocks with the SHA-NI
+*      instructions.
+*/
+SHA_HW_TARGET
+static void SHA1ProcessBlocksX86(uint32_t *Intermediate_Hash,
+    const uint8_t *blocks, unsigned int block_count)
+{
+    const __m128i byte_swap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd;
+    __m128i e0;
+
+    abcd = _mm_loadu_si128((const __m128i*)Intermediate_Hash);
+    abcd = _mm_shuffle_epi32(abcd, 0x1B);
+    e0 = _mm_set_epi32((int)Intermediate_Hash[4], 0, 0, 0);
+
+    while (block_count--) {
+        const __m128i abcd_save = abcd;
+        const __m128i e0_save = e0;
+        __m128i W[4];
+        __m128i E[2];
+        int i;
+
+        for (i = 0; i < 4; i++)
+            W[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + (i * 16))), byte_swap);
+
+        E[0] = e0;
+        E[1] = e0;
+
+        SHA1_X86_ROUNDS(0);  SHA1_X86_ROUNDS(1);  SHA1_X86_ROUNDS(2);  SHA1_X86_ROUNDS(3);
+        SHA1_X86_ROUNDS(4);  SHA1_X86_ROUNDS(5);  SHA1_X86_ROUNDS(6);  SHA1_X86_ROUNDS(7);
+        SHA1_X86_ROUNDS(8);  SHA1_X86_ROUNDS(9);  SHA1_X86_ROUNDS(10); SHA1_X86_ROUNDS(11);
+        SHA1_X86_ROUNDS(12); SHA1_X86_ROUNDS(13); SHA1_X86_ROUNDS(14); SHA1_X86_ROUNDS(15);
+        SHA1_X86_ROUNDS(16); SHA1_X86_ROUNDS(17); SHA1_X86_ROUNDS(18); SHA1_X86_ROUNDS(19);
+
+        e0 = _mm_sha1nexte_epu32(E[0], e0_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+        blocks += SHA1_Message_Block_Size;
+    }
+
+    abcd = _mm_shuffle_epi32(abcd, 0x1B);
+    _mm_storeu_si128((__m128i*)Intermediate_Hash, abcd);
+    Intermediate_Hash[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+/* Define the SHA-256 functions working on 8 lanes of 32 bit words */
+#define SHA256_AVX2_ROTR(bits, word) \
+    _mm256_or_si256(_mm256_srli_epi32((word), (bits)), _mm256_slli_epi32((word), 32 - (bits)))
+#define SHA256_AVX2_SIGMA0(word) _mm256_xor_si256(_mm256_xor_si256( \
+    SHA256_AVX2_ROTR(2, word), SHA256_AVX2_ROTR(13, word)), SHA256_AVX2_ROTR(22, word))
+#define SHA256_AVX2_SIGMA1(word) _mm256_xor_si256(_mm256_xor_si256( \
+    SHA256_AVX2_ROTR(6, word), SHA256_AVX2_ROTR(11, word)), SHA256_AVX2_ROTR(25, word))
+#define SHA256_AVX2_sigma0(word) _mm256_xor_si256(_mm256_xor_si256( \
+    SHA256_AVX2_ROTR(7, word), SHA256_AVX2_ROTR(18, word)), _mm256_srli_epi32((word), 3))
+#define SHA256_AVX2_sigma1(word) _mm256_xor_si256(_mm256_xor_si256( \
+    SHA256_AVX2_ROTR(17, word), SHA256_AVX2_ROTR(19, word)), _mm256_srli_epi32((word), 10))
+#define SHA256_AVX2_Ch(x, y, z) \
+    _mm256_xor_si256(_mm256_and_si256((x), (y)), _mm256_andnot_si256((x), (z)))
+#define SHA256_AVX2_Maj(x, y, z) \
+    _mm256_or_si256(_mm256_and_si256((x), (y)), _mm256_and_si256((z), _mm256_or_si256((x), (y))))
+
+/*
+* Turns 8 rows (one per message) of 8 words into 8 columns holding
+* the same word of every message.
+*/
+#define SHA256_AVX2_TRANSPOSE(rows, columns)                                       \
+    do {                                                                           \
+        __m256i t0 = _mm256_unpacklo_epi32(rows[0], rows[1]);                      \
+        __m256i t1 = _mm256_unpackhi_epi32(rows[0], rows[1]);                      \
+        __m256i t2 = _mm256_unpacklo_epi32(rows[2], rows[3]);                      \
+        __m256i t3 = _mm256_unpackhi_epi32(rows[2], rows[3]);                      \
+        __m256i t4 = _mm256_unpacklo_epi32(rows[4], rows[5]);                      \
+        __m256i t5 = _mm256_unpackhi_epi32(rows[4], rows[5]);                      \
+        __m256i t6 = _mm256_unpacklo_epi32(rows[6], rows[7]);                      \
+        __m256i t7 = _mm256_unpackhi_epi32(rows[6], rows[7]);                      \
+        __m256i u0 = _mm256_unpacklo_epi64(t0, t2);                                \
+        __m256i u1 = _mm256_unpackhi_epi64(t0, t2);                                \
+        __m256i u2 = _mm256_unpacklo_epi64(t1, t3);                                \
+        __m256i u3 = _mm256_unpackhi_epi64(t1, t3);                                \
+        __m256i u4 = _mm256_unpacklo_epi64(t4, t6);                                \
+        __m256i u5 = _mm256_unpackhi_epi64(t4, t6);                                \
+        __m256i u6 = _mm256_unpacklo_epi64(t5, t7);                                \
+        __m256i u7 = _mm256_unpackhi_epi64(t5, t7);                                \
+        columns[0] = _mm256_permute2x128_si256(u0, u4, 0x20);                      \
+        columns[1] = _mm256_permute2x128_si256(u1, u5, 0x20);                      \
+        columns[2] = _mm256_permute2x128_si256(u2, u6, 0x20);                      \
+        columns[3] = _mm256_permute2x128_si256(u3, u7, 0x20);                      \
+        columns[4] = _mm256_permute2x128_si256(u0, u4, 0x31);                      \
+        columns[5] = _mm256_permute2x128_si256(u1, u5, 0x31);                      \
+        columns[6] = _mm256_permute2x128_si256(u2, u6, 0x31);                      \
+        columns[7] = _mm256_permute2x128_si256(u3, u7, 0x31);                      \
+    } while (0)
+
+/*
+*  SHA256ProcessBlocksMultiAVX2
+*
+*  Description:
+*      Hashes one 64 byte block into each of 8 intermediate hashes,
+*      running the SHA-256 rounds of the 8 messages in the 8 lanes
+*      of the AVX2 registers.
+*/
+SHA_HW_AVX2_TARGET
+static void SHA256ProcessBlocksMultiAVX2(
+    uint32_t *Intermediate_Hashes[SHA256MultiBufferLanes],
+    const uint8_t *blocks[SHA256MultiBufferLanes])
+{
+    const __m256i byte_swap = _mm256_set_epi8(
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    uint32_t words[SHA256MultiBufferLanes];
+    __m256i rows[SHA256MultiBufferLanes];
+    __m256i H[8];
+    __m256i W[16];
+    __m256i A, B, C, D, E, F, G, HH;
+    int lane;
+    int t;
+
+    for (t = 0; t < 16; t += 8) {
+        for (lane = 0; lane < SHA256MultiBufferLanes; lane++)
+            rows[lane] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(blocks[lane] + (t * 4))), byte_swap);
+        SHA256_AVX2_TRANSPOSE(rows, (W + t));
+    }
+
+    for (t = 0; t < 8; t++) {
+        for (lane = 0; lane < SHA256MultiBufferLanes; lane++)
+            words[lane] = Intermediate_Hashes[lane][t];
+        H[t] = _mm256_loadu_si256((const __m256i*)words);
+    }
+
+    A = H[0]; B = H[1]; C = H[2]; D = H[3];
+    E = H[4]; F = H[5]; G = H[6]; HH = H[7];
+
+    for (t = 0; t < 64; t++) {
+        __m256i temp1;
+        __m256i temp2;
+
+        if (t >= 16)
+            W[t & 15] = _mm256_add_epi32(
+                _mm256_add_epi32(SHA256_AVX2_sigma1(W[(t - 2) & 15]), W[(t - 7) & 15]),
+                _mm256_add_epi32(SHA256_AVX2_sigma0(W[(t - 15) & 15]), W[t & 15]));
+
+        temp1 = _mm256_add_epi32(
+            _mm256_add_epi32(HH, SHA256_AVX2_SIGMA1(E)),
+            _mm256_add_epi32(SHA256_AVX2_Ch(E, F, G),
+                _mm256_add_epi32(_mm256_set1_epi32((int)SHA256_K[t]), W[t & 15])));
+        temp2 = _mm256_add_epi32(SHA256_AVX2_SIGMA0(A), SHA256_AVX2_Maj(A, B, C));
+        HH = G;
+        G = F;
+        F = E;
+        E = _mm256_add_epi32(D, temp1);
+        D = C;
+        C = B;
+        B = A;
+        A = _mm256_add_epi32(temp1, temp2);
+    }
+
+    H[0] = _mm256_add_epi32(H[0], A); H[1] = _mm256_add_epi32(H[1], B);
+    H[2] = _mm256_add_epi32(H[2], C); H[3] = _mm256_add_epi32(H[3], D);
+    H[4] = _mm256_add_epi32(H[4], E); H[5] = _mm256_add_epi32(H[5], F);
+    H[6] = _mm256_add_epi32(H[6], G); H[7] = _mm256_add_epi32(H[7], HH);
+
+    for (t = 0; t < 8; t++) {
+        _mm256_storeu_si256((__m256i*)words, H[t]);
+        for (lane = 0; lane < SHA256MultiBufferLanes; lane++)
+            Intermediate_Hashes[lane][t] = words[lane];
+    }
+}
+
+#endif /* SHA_HW_X86 */
+
+#if defined(SHA_HW_ARM)
+
+/*
+*  SHA256ProcessBlocksARM
+*
+*  Description:
+*      Hashes block_count 64 byte blocks with the ARMv8 SHA-256
+*      instructions. Each iteration of the inner loop does 4 rounds
+*      and computes the 4 message words needed 4 iterations later.
+*/
+static void SHA256ProcessBlocksARM(uint32_t *Intermediate_Hash,
+    const uint8_t *blocks, unsigned int block_count)
+{
+    uint32x4_t state0 = vld1q_u32(&Intermediate_Hash[0]);
+    uint32x4_t state1 = vld1q_u32(&Intermediate_Hash[4]);
+
+    while (block_count--) {
+        const uint32x4_t abcd_save = state0;
+        const uint32x4_t efgh_save = state1;
+        uint32x4_t W[4];
+        int i;
+
+        for (i = 0; i < 4; i++)
+            W[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + (i * 16))));
+
+        for (i = 0; i < 16; i++) {
+            const uint32x4_t message = vaddq_u32(W[i & 3], vld1q_u32(&SHA256_K[i * 4]));
+            const uint32x4_t previous_state0 = state0;
+            state0 = vsha256hq_u32(state0, state1, message);
+            state1 = vsha256h2q_u32(state1, previous_state0, message);
+
+            if (i < 12)
+                W[i & 3] = vsha256su1q_u32(vsha256su0q_u32(W[i & 3], W[(i + 1) & 3]), W[(i + 2) & 3], W[(i + 3) & 3]);
+        }
+
+        state0 = vaddq_u32(state0, abcd_save);
+        state1 = vaddq_u32(state1, efgh_save);
+        blocks += SHA256_Message_Block_Size;
+    }
+
+    vst1q_u32(&Intermediate_Hash[0], state0);
+    vst1q_u32(&Intermediate_Hash[4], state1);
+}
+
+/*
+*  SHA1ProcessBlocksARM
+*
+*  Description:
+*      Hashes block_count 64 byte blocks with the ARMv8 SHA-1
+*      instructions.
+*/
+static void SHA1ProcessBlocksARM(uint32_t *Intermediate_Hash,
+    const uint8_t *blocks, unsigned int block_count)
+{
+    /* Constants defined in FIPS-180-2, section 4.2.1 */
+    static const uint32_t K[4] = {
+        0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6
+    };
+    uint32x4_t abcd = vld1q_u32(Intermediate_Hash);
+    uint32_t e = Intermediate_Hash[4];
+
+    while (block_count--) {
+        const uint32x4_t abcd_save = abcd;
+        const uint32_t e_save = e;
+        uint32x4_t W[4];
+        int i;
+
+        for (i = 0; i < 4; i++)
+            W[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + (i * 16))));
+
+        for (i = 0; i < 20; i++) {
+            const uint32x4_t message = vaddq_u32(W[i & 3], vdupq_n_u32(K[i / 5]));
+            const uint32_t next_e = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+
+            if (i < 5)
+                abcd = vsha1cq_u32(abcd, e, message);
+            else if ((i >= 10) && (i < 15))
+                abcd = vsha1mq_u32(abcd, e, message);
+            else
+                abcd = vsha1pq_u32(abcd, e, message);
+            e = next_e;
+
+            if (i < 16)
+                W[i & 3] = vsha1su1q_u32(vsha1su0q_u32(W[i & 3], W[(i + 1) & 3], W[(i + 2) & 3]), W[(i + 3) & 3]);
+        }
+
+        abcd = vaddq_u32(abcd, abcd_save);
+        e += e_save;
+        blocks += SHA1_Message_Block_Size;
+    }
+
+    vst1q_u32(Intermediate_Hash, abcd);
+    Intermediate_Hash[4] = e;
+}
+
+#endif /* SHA_HW_ARM */
+
+/*
+*  SHA256HardwareProcessBlocks
+*
+*  Description:
+*      Returns the SHA-256 block function that uses the processor's
+*      SHA instructions, or NULL when they are not available.
+*/
+SHA_PROCESS_BLOCKS SHA256HardwareProcessBlocks(void)
+{
+#if defined(SHA_HW_X86)
+    return ((cpu_features_get() & SHA_HW_X86_SHA_FEATURES) == SHA_HW_X86_SHA_FEATURES) ? SHA256ProcessBlocksX86 : NULL;
+#elif defined(SHA_HW_ARM) && defined(__linux__)
+    return ((cpu_features_get() & CPU_FEATURE_ARM_SHA2) != 0) ? SHA256ProcessBlocksARM : NULL;
+#elif defined(SHA_HW_ARM)
+    /* the compiler was told that the target has the crypto extensions */
+    return SHA256ProcessBlocksARM;
+#else
+    return NULL;
+#endif
+}
+
+/*
+*  SHA1HardwareProcessBlocks
+*
+*  Description:
+*      Returns the SHA-1 block function that uses the processor's
+*      SHA instructions, or NULL when they are not available.
+*/
+SHA_PROCESS_BLOCKS SHA1HardwareProcessBlocks(void)
+{
+#if defined(SHA_HW_X86)
+    return ((cpu_features_get() & SHA_HW_X86_SHA_FEATURES) == SHA_HW_X86_SHA_FEATURES) ? SHA1ProcessBlocksX86 : NULL;
+#elif defined(SHA_HW_ARM) && defined(__linux__)
+    return ((cpu_features_get() & CPU_FEATURE_ARM_SHA1) != 0) ? SHA1ProcessBlocksARM : NULL;
+#elif defined(SHA_HW_ARM)
+    /* the compiler was told that the target has the crypto extensions */
+    return SHA1ProcessBlocksARM;
+#else
+    return NULL;
+#endif
+}
+
+/*
+*  SHA256HardwareProcessBlocksMulti
+*
+*  Description:
+*      Returns the SHA-256 block function hashing several messages
+*      at once with AVX2, or NULL when it is not available.
+*/
+SHA_PROCESS_BLOCKS_MULTI SHA256HardwareProcessBlocksMulti(void)
+{
+#if defined(SHA_HW_X86)
+    return ((cpu_features_get() & CPU_FEATURE_X86_AVX2) != 0) ? SHA256ProcessBlocksMultiAVX2 : NULL;
+#else
+    return NULL;
+#endif
+}
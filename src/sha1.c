@@ -39,6 +39,7 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include "azure_c_shared_utility/gballoc.h"
 
 #include "azure_c_shared_utility/sha.h"
@@ -63,6 +64,10 @@
 static void SHA1Finalize(SHA1Context *context, uint8_t Pad_Byte);
 static void SHA1PadMessage(SHA1Context *, uint8_t Pad_Byte);
 static void SHA1ProcessMessageBlock(SHA1Context *);
+static void SHA1ProcessBlocks(SHA1Context *context,
+    const uint8_t *blocks, unsigned int block_count);
+static void SHA1ProcessBlocksPortable(uint32_t *Intermediate_Hash,
+    const uint8_t *blocks, unsigned int block_count);
 
 /*
 *  SHA1Reset
@@ -140,15 +145,39 @@ int SHA1Input(SHA1Context *context,
     if (context->Corrupted)
         return context->Corrupted;
 
-    while (length-- && !context->Corrupted) {
-        context->Message_Block[context->Message_Block_Index++] =
-            (*message_array & 0xFF);
-
-        if (!SHA1AddLength(context, 8) &&
-            (context->Message_Block_Index == SHA1_Message_Block_Size))
-            SHA1ProcessMessageBlock(context);
-
-        message_array++;
+    while (length && !context->Corrupted) {
+        if ((context->Message_Block_Index == 0) &&
+            (length >= SHA1_Message_Block_Size)) {
+            /*
+            * Whole blocks are hashed straight from message_array
+            * instead of being copied to Message_Block first
+            */
+            unsigned int block_count = 0;
+            while ((length - (block_count * SHA1_Message_Block_Size) >=
+                SHA1_Message_Block_Size) &&
+                !SHA1AddLength(context, SHA1_Message_Block_Size * 8))
+                block_count++;
+
+            SHA1ProcessBlocks(context, message_array, block_count);
+            message_array += block_count * SHA1_Message_Block_Size;
+            length -= block_count * SHA1_Message_Block_Size;
+        }
+        else {
+            unsigned int count = SHA1_Message_Block_Size -
+                context->Message_Block_Index;
+            if (count > length)
+                count = length;
+
+            (void)memcpy(&context->Message_Block[context->Message_Block_Index],
+                message_array, count);
+            context->Message_Block_Index += (int_least16_t)count;
+            message_array += count;
+            length -= count;
+
+            if (!SHA1AddLength(context, count * 8) &&
+                (context->Message_Block_Index == SHA1_Message_Block_Size))
+                SHA1ProcessMessageBlock(context);
+        }
     }
 
     return shaSuccess;
@@ -356,13 +385,69 @@ static void SHA1PadMessage(SHA1Context *context, uint8_t Pad_Byte)
 *
 * Returns:
 *   Nothing.
+*/
+static void SHA1ProcessMessageBlock(SHA1Context *context)
+{
+    SHA1ProcessBlocks(context, context->Message_Block, 1);
+    context->Message_Block_Index = 0;
+}
+
+/*
+* SHA1ProcessBlocks
+*
+* Description:
+*   This function will process block_count consecutive 512 bit
+*   blocks of the message with the processor's SHA instructions
+*   when they are available, or with the portable code otherwise.
+*
+* Parameters:
+*   context: [in/out]
+*     The SHA context to update
+*   blocks: [in]
+*     The message blocks.
+*   block_count: [in]
+*     The number of blocks.
+*
+* Returns:
+*   Nothing.
+*/
+static void SHA1ProcessBlocks(SHA1Context *context,
+    const uint8_t *blocks, unsigned int block_count)
+{
+    /* the processor's features are probed once, by cpu_features.c */
+    SHA_PROCESS_BLOCKS hardware_function = SHA1HardwareProcessBlocks();
+
+    if (hardware_function != NULL)
+        hardware_function(context->Intermediate_Hash, blocks, block_count);
+    else
+        SHA1ProcessBlocksPortable(context->Intermediate_Hash, blocks, block_count);
+}
+
+/*
+* SHA1ProcessBlocksPortable
+*
+* Description:
+*   This function will process block_count consecutive 512 bit
+*   blocks of the message.
+*
+* Parameters:
+*   Intermediate_Hash: [in/out]
+*     The hash to update
+*   blocks: [in]
+*     The message blocks.
+*   block_count: [in]
+*     The number of blocks.
+*
+* Returns:
+*   Nothing.
 *
 * Comments:
 *   Many of the variable names in this code, especially the
 *   single character names, were used because those were the
 *   names used in the publication.
 */
-static void SHA1ProcessMessageBlock(SHA1Context *context)
+static void SHA1ProcessBlocksPortable(uint32_t *Intermediate_Hash,
+    const uint8_t *blocks, unsigned int block_count)
 {
     /* Constants defined in FIPS-180-2, section 4.2.1 */
     const uint32_t K[4] = {
@@ -373,68 +458,69 @@ static void SHA1ProcessMessageBlock(SHA1Context *context)
     uint32_t   W[80];           /* Word sequence */
     uint32_t   A, B, C, D, E;   /* Word buffers */
 
-    /*
-    * Initialize the first 16 words in the array W
-    */
-    for (t = 0; t < 16; t++) {
-        W[t] = ((uint32_t)context->Message_Block[t * 4]) << 24;
-        W[t] |= ((uint32_t)context->Message_Block[t * 4 + 1]) << 16;
-        W[t] |= ((uint32_t)context->Message_Block[t * 4 + 2]) << 8;
-        W[t] |= ((uint32_t)context->Message_Block[t * 4 + 3]);
+    for (; block_count > 0; block_count--,
+        blocks += SHA1_Message_Block_Size) {
+        /*
+        * Initialize the first 16 words in the array W
+        */
+        for (t = 0; t < 16; t++) {
+            W[t] = ((uint32_t)blocks[t * 4]) << 24;
+            W[t] |= ((uint32_t)blocks[t * 4 + 1]) << 16;
+            W[t] |= ((uint32_t)blocks[t * 4 + 2]) << 8;
+            W[t] |= ((uint32_t)blocks[t * 4 + 3]);
+        }
+
+        for (t = 16; t < 80; t++)
+            W[t] = SHA1_ROTL(1, W[t - 3] ^ W[t - 8] ^ W[t - 14] ^ W[t - 16]);
+
+        A = Intermediate_Hash[0];
+        B = Intermediate_Hash[1];
+        C = Intermediate_Hash[2];
+        D = Intermediate_Hash[3];
+        E = Intermediate_Hash[4];
+
+        for (t = 0; t < 20; t++) {
+            temp = SHA1_ROTL(5, A) + SHA_Ch(B, C, D) + E + W[t] + K[0];
+            E = D;
+            D = C;
+            C = SHA1_ROTL(30, B);
+            B = A;
+            A = temp;
+        }
+
+        for (t = 20; t < 40; t++) {
+            temp = SHA1_ROTL(5, A) + SHA_Parity(B, C, D) + E + W[t] + K[1];
+            E = D;
+            D = C;
+            C = SHA1_ROTL(30, B);
+            B = A;
+            A = temp;
+        }
+
+        for (t = 40; t < 60; t++) {
+            temp = SHA1_ROTL(5, A) + SHA_Maj(B, C, D) + E + W[t] + K[2];
+            E = D;
+            D = C;
+            C = SHA1_ROTL(30, B);
+            B = A;
+            A = temp;
+        }
+
+        for (t = 60; t < 80; t++) {
+            temp = SHA1_ROTL(5, A) + SHA_Parity(B, C, D) + E + W[t] + K[3];
+            E = D;
+            D = C;
+            C = SHA1_ROTL(30, B);
+            B = A;
+            A = temp;
+        }
+
+        Intermediate_Hash[0] += A;
+        Intermediate_Hash[1] += B;
+        Intermediate_Hash[2] += C;
+
+        Intermediate_Hash[3] += D;
+        Intermediate_Hash[4] += E;
     }
-
-    for (t = 16; t < 80; t++)
-        W[t] = SHA1_ROTL(1, W[t - 3] ^ W[t - 8] ^ W[t - 14] ^ W[t - 16]);
-
-    A = context->Intermediate_Hash[0];
-    B = context->Intermediate_Hash[1];
-    C = context->Intermediate_Hash[2];
-    D = context->Intermediate_Hash[3];
-    E = context->Intermediate_Hash[4];
-
-    for (t = 0; t < 20; t++) {
-        temp = SHA1_ROTL(5, A) + SHA_Ch(B, C, D) + E + W[t] + K[0];
-        E = D;
-        D = C;
-        C = SHA1_ROTL(30, B);
-        B = A;
-        A = temp;
-    }
-
-    for (t = 20; t < 40; t++) {
-        temp = SHA1_ROTL(5, A) + SHA_Parity(B, C, D) + E + W[t] + K[1];
-        E = D;
-        D = C;
-        C = SHA1_ROTL(30, B);
-        B = A;
-        A = temp;
-    }
-
-    for (t = 40; t < 60; t++) {
-        temp = SHA1_ROTL(5, A) + SHA_Maj(B, C, D) + E + W[t] + K[2];
-        E = D;
-        D = C;
-        C = SHA1_ROTL(30, B);
-        B = A;
-        A = temp;
-    }
-
-    for (t = 60; t < 80; t++) {
-        temp = SHA1_ROTL(5, A) + SHA_Parity(B, C, D) + E + W[t] + K[3];
-        E = D;
-        D = C;
-        C = SHA1_ROTL(30, B);
-        B = A;
-        A = temp;
-    }
-
-    context->Intermediate_Hash[0] += A;
-    context->Intermediate_Hash[1] += B;
-    context->Intermediate_Hash[2] += C;
-
-    context->Intermediate_Hash[3] += D;
-    context->Intermediate_Hash[4] += E;
-
-    context->Message_Block_Index = 0;
 }
 
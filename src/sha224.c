@@ -40,6 +40,7 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include "azure_c_shared_utility/gballoc.h"
 
 #include "azure_c_shared_utility/sha.h"
@@ -75,10 +76,21 @@ static void SHA224_256Finalize(SHA256Context *context,
 static void SHA224_256PadMessage(SHA256Context *context,
     uint8_t Pad_Byte);
 static void SHA224_256ProcessMessageBlock(SHA256Context *context);
+static void SHA224_256ProcessBlocks(SHA256Context *context,
+    const uint8_t *blocks, unsigned int block_count);
+static void SHA224_256ProcessBlocksPortable(uint32_t *Intermediate_Hash,
+    const uint8_t *blocks, unsigned int block_count);
+static const uint8_t *SHA224_256NextBlock(SHA256Context *context,
+    const uint8_t **message_array, unsigned int *length, int *phase);
 static int SHA224_256Reset(SHA256Context *context, uint32_t *H0);
 static int SHA224_256ResultN(SHA256Context *context,
     uint8_t Message_Digest[], int HashSize);
 
+/* Where each message of SHA256InputResultMultiple is at */
+#define SHA_PHASE_MESSAGE   0   /* hashing the message */
+#define SHA_PHASE_LENGTH    1   /* only the length block is left */
+#define SHA_PHASE_DONE      2   /* the last block has been handed out */
+
 /* Initial Hash Values: FIPS-180-2 Change Notice 1 */
 static uint32_t SHA224_H0[SHA256HashSize / 4] = {
     0xC1059ED8, 0x367CD507, 0x3070DD17, 0xF70E5939,
@@ -241,15 +253,39 @@ int SHA256Input(SHA256Context *context, const uint8_t *message_array,
     if (context->Corrupted)
         return context->Corrupted;
 
-    while (length-- && !context->Corrupted) {
-        context->Message_Block[context->Message_Block_Index++] =
-            (*message_array & 0xFF);
-
-        if (!SHA224_256AddLength(context, 8) &&
-            (context->Message_Block_Index == SHA256_Message_Block_Size))
-            SHA224_256ProcessMessageBlock(context);
-
-        message_array++;
+    while (length && !context->Corrupted) {
+        if ((context->Message_Block_Index == 0) &&
+            (length >= SHA256_Message_Block_Size)) {
+            /*
+            * Whole blocks are hashed straight from message_array
+            * instead of being copied to Message_Block first
+            */
+            unsigned int block_count = 0;
+            while ((length - (block_count * SHA256_Message_Block_Size) >=
+                SHA256_Message_Block_Size) &&
+                !SHA224_256AddLength(context, SHA256_Message_Block_Size * 8))
+                block_count++;
+
+            SHA224_256ProcessBlocks(context, message_array, block_count);
+            message_array += block_count * SHA256_Message_Block_Size;
+            length -= block_count * SHA256_Message_Block_Size;
+        }
+        else {
+            unsigned int count = SHA256_Message_Block_Size -
+                context->Message_Block_Index;
+            if (count > length)
+                count = length;
+
+            (void)memcpy(&context->Message_Block[context->Message_Block_Index],
+                message_array, count);
+            context->Message_Block_Index += (int_least16_t)count;
+            message_array += count;
+            length -= count;
+
+            if (!SHA224_256AddLength(context, count * 8) &&
+                (context->Message_Block_Index == SHA256_Message_Block_Size))
+                SHA224_256ProcessMessageBlock(context);
+        }
     }
 
     return shaSuccess;
@@ -337,6 +373,230 @@ int SHA256Result(SHA256Context *context, uint8_t Message_Digest[])
         return SHA224_256ResultN(context, Message_Digest, SHA256HashSize);
 }
 
+/*
+* SHA256InputResultMultiple
+*
+* Description:
+*   This function hashes count independent messages. For each i it
+*   is equivalent to SHA256Input(&contexts[i], messages[i],
+*   lengths[i]) followed by SHA256Result(&contexts[i],
+*   Message_Digests[i]), but the blocks of up to
+*   SHA256MultiBufferLanes messages are hashed at once when the
+*   processor supports it. The contexts may already hold part of
+*   their message (an HMAC key for instance).
+*
+* Parameters:
+*   contexts: [in/out]
+*     The count contexts to use to calculate the SHA hashes.
+*   messages: [in]
+*     The count messages.
+*   lengths: [in]
+*     The lengths of the messages.
+*   Message_Digests: [out]
+*     Where the count digests are returned.
+*   count: [in]
+*     The number of messages.
+*
+* Returns:
+*   sha Error Code. Nothing is hashed unless every context can
+*   accept input.
+*/
+int SHA256InputResultMultiple(SHA256Context *contexts,
+    const uint8_t *const messages[], const unsigned int lengths[],
+    uint8_t Message_Digests[][SHA256HashSize], unsigned int count)
+{
+    static const uint8_t idle_block[SHA256_Message_Block_Size] = { 0 };
+    uint32_t idle_hash[SHA256HashSize / 4];
+    SHA_PROCESS_BLOCKS_MULTI multi_function;
+    unsigned int first;
+    unsigned int i;
+
+    if (!count)
+        return shaSuccess;
+
+    if (!contexts || !messages || !lengths || !Message_Digests)
+        return shaNull;
+
+    for (i = 0; i < count; i++) {
+        if (!messages[i] && lengths[i])
+            return shaNull;
+        if (contexts[i].Computed) {
+            contexts[i].Corrupted = shaStateError;
+            return shaStateError;
+        }
+        if (contexts[i].Corrupted)
+            return contexts[i].Corrupted;
+    }
+
+    /* one stream on the SHA instructions outruns 8 AVX2 lanes */
+    multi_function = (SHA256HardwareProcessBlocks() == NULL) ?
+        SHA256HardwareProcessBlocksMulti() : NULL;
+
+    for (first = 0; first < count; first += SHA256MultiBufferLanes) {
+        unsigned int lanes = ((count - first) < SHA256MultiBufferLanes) ?
+            (count - first) : SHA256MultiBufferLanes;
+        const uint8_t *message_array[SHA256MultiBufferLanes];
+        unsigned int length[SHA256MultiBufferLanes];
+        int phase[SHA256MultiBufferLanes];
+        uint32_t *hashes[SHA256MultiBufferLanes];
+        const uint8_t *blocks[SHA256MultiBufferLanes];
+        int busy_lanes;
+
+        for (i = 0; i < lanes; i++) {
+            SHA256Context *context = &contexts[first + i];
+            uint32_t addTemp;
+            message_array[i] = messages[first + i];
+            length[i] = lengths[first + i];
+            phase[i] = SHA_PHASE_MESSAGE;
+            /* the length is added in two steps so that length * 8 cannot overflow */
+            SHA224_256AddLength(context, (length[i] & 0x1FFFFFFF) << 3);
+            context->Length_High += length[i] >> 29;
+        }
+
+        do {
+            busy_lanes = 0;
+            for (i = 0; i < SHA256MultiBufferLanes; i++) {
+                blocks[i] = (i < lanes) ? SHA224_256NextBlock(&contexts[first + i],
+                    &message_array[i], &length[i], &phase[i]) : NULL;
+                if (blocks[i] != NULL) {
+                    hashes[i] = contexts[first + i].Intermediate_Hash;
+                    busy_lanes++;
+                }
+                else {
+                    /* lanes without a message hash a throw away block */
+                    hashes[i] = idle_hash;
+                    blocks[i] = idle_block;
+                }
+            }
+
+            if (busy_lanes == 0)
+                break;
+
+            if ((multi_function != NULL) && (busy_lanes > 1)) {
+                multi_function(hashes, blocks);
+            }
+            else {
+                for (i = 0; i < lanes; i++)
+                    if (hashes[i] != idle_hash)
+                        SHA224_256ProcessBlocks(&contexts[first + i],
+                            blocks[i], 1);
+            }
+        } while (busy_lanes > 0);
+
+        for (i = 0; i < lanes; i++) {
+            SHA256Context *context = &contexts[first + i];
+            int j;
+            /* message may be sensitive, so clear it out */
+            for (j = 0; j < SHA256_Message_Block_Size; ++j)
+                context->Message_Block[j] = 0;
+            context->Message_Block_Index = 0;
+            context->Length_Low = 0;
+            context->Length_High = 0;
+            context->Computed = 1;
+
+            for (j = 0; j < SHA256HashSize; ++j)
+                Message_Digests[first + i][j] = (uint8_t)
+                (context->Intermediate_Hash[j >> 2] >> 8 * (3 - (j & 0x03)));
+        }
+    }
+
+    return shaSuccess;
+}
+
+/*
+* SHA224_256NextBlock
+*
+* Description:
+*   This function returns the next block of a message hashed by
+*   SHA256InputResultMultiple. Whole blocks are returned straight
+*   from message_array; the rest of the message and the padding are
+*   assembled in Message_Block.
+*
+* Parameters:
+*   context: [in/out]
+*     The SHA context of the message.
+*   message_array: [in/out]
+*     The part of the message not hashed yet.
+*   length: [in/out]
+*     The length of message_array.
+*   phase: [in/out]
+*     Where the message is at (SHA_PHASE_*).
+*
+* Returns:
+*   The block, or NULL when all the blocks have been returned.
+*/
+static const uint8_t *SHA224_256NextBlock(SHA256Context *context,
+    const uint8_t **message_array, unsigned int *length, int *phase)
+{
+    const uint8_t *result;
+
+    if (*phase == SHA_PHASE_DONE) {
+        result = NULL;
+    }
+    else if (*phase == SHA_PHASE_MESSAGE &&
+        context->Message_Block_Index == 0 &&
+        *length >= SHA256_Message_Block_Size) {
+        result = *message_array;
+        *message_array += SHA256_Message_Block_Size;
+        *length -= SHA256_Message_Block_Size;
+    }
+    else {
+        if (*phase == SHA_PHASE_MESSAGE) {
+            unsigned int count = SHA256_Message_Block_Size -
+                context->Message_Block_Index;
+            if (count > *length)
+                count = *length;
+
+            if (count > 0)
+                (void)memcpy(&context->Message_Block[context->Message_Block_Index],
+                    *message_array, count);
+            context->Message_Block_Index += (int_least16_t)count;
+            *message_array += count;
+            *length -= count;
+
+            if (context->Message_Block_Index < SHA256_Message_Block_Size) {
+                /* the message ends in this block */
+                context->Message_Block[context->Message_Block_Index++] = 0x80;
+                if (context->Message_Block_Index > (SHA256_Message_Block_Size - 8)) {
+                    /* no room left for the length */
+                    while (context->Message_Block_Index < SHA256_Message_Block_Size)
+                        context->Message_Block[context->Message_Block_Index++] = 0;
+                    *phase = SHA_PHASE_LENGTH;
+                }
+                else {
+                    *phase = SHA_PHASE_DONE;
+                }
+            }
+        }
+        else {
+            /* SHA_PHASE_LENGTH */
+            *phase = SHA_PHASE_DONE;
+        }
+
+        if (*phase == SHA_PHASE_DONE) {
+            while (context->Message_Block_Index < (SHA256_Message_Block_Size - 8))
+                context->Message_Block[context->Message_Block_Index++] = 0;
+
+            /*
+            * Store the message length as the last 8 octets
+            */
+            context->Message_Block[56] = (uint8_t)(context->Length_High >> 24);
+            context->Message_Block[57] = (uint8_t)(context->Length_High >> 16);
+            context->Message_Block[58] = (uint8_t)(context->Length_High >> 8);
+            context->Message_Block[59] = (uint8_t)(context->Length_High);
+            context->Message_Block[60] = (uint8_t)(context->Length_Low >> 24);
+            context->Message_Block[61] = (uint8_t)(context->Length_Low >> 16);
+            context->Message_Block[62] = (uint8_t)(context->Length_Low >> 8);
+            context->Message_Block[63] = (uint8_t)(context->Length_Low);
+        }
+
+        context->Message_Block_Index = 0;
+        result = context->Message_Block;
+    }
+
+    return result;
+}
+
 /*
 * SHA224_256Finalize
 *
@@ -441,13 +701,69 @@ static void SHA224_256PadMessage(SHA256Context *context,
 *
 * Returns:
 *   Nothing.
+*/
+static void SHA224_256ProcessMessageBlock(SHA256Context *context)
+{
+    SHA224_256ProcessBlocks(context, context->Message_Block, 1);
+    context->Message_Block_Index = 0;
+}
+
+/*
+* SHA224_256ProcessBlocks
+*
+* Description:
+*   This function will process block_count consecutive 512 bit
+*   blocks of the message with the processor's SHA instructions
+*   when they are available, or with the portable code otherwise.
+*
+* Parameters:
+*   context: [in/out]
+*     The SHA context to update
+*   blocks: [in]
+*     The message blocks.
+*   block_count: [in]
+*     The number of blocks.
+*
+* Returns:
+*   Nothing.
+*/
+static void SHA224_256ProcessBlocks(SHA256Context *context,
+    const uint8_t *blocks, unsigned int block_count)
+{
+    /* the processor's features are probed once, by cpu_features.c */
+    SHA_PROCESS_BLOCKS hardware_function = SHA256HardwareProcessBlocks();
+
+    if (hardware_function != NULL)
+        hardware_function(context->Intermediate_Hash, blocks, block_count);
+    else
+        SHA224_256ProcessBlocksPortable(context->Intermediate_Hash, blocks, block_count);
+}
+
+/*
+* SHA224_256ProcessBlocksPortable
+*
+* Description:
+*   This function will process block_count consecutive 512 bit
+*   blocks of the message.
+*
+* Parameters:
+*   Intermediate_Hash: [in/out]
+*     The hash to update
+*   blocks: [in]
+*     The message blocks.
+*   block_count: [in]
+*     The number of blocks.
+*
+* Returns:
+*   Nothing.
 *
 * Comments:
 *   Many of the variable names in this code, especially the
 *   single character names, were used because those were the
 *   names used in the publication.
 */
-static void SHA224_256ProcessMessageBlock(SHA256Context *context)
+static void SHA224_256ProcessBlocksPortable(uint32_t *Intermediate_Hash,
+    const uint8_t *blocks, unsigned int block_count)
 {
     /* Constants defined in FIPS-180-2, section 4.2.2 */
     static const uint32_t K[64] = {
@@ -470,51 +786,52 @@ static void SHA224_256ProcessMessageBlock(SHA256Context *context)
     uint32_t   W[64];                   /* Word sequence */
     uint32_t   A, B, C, D, E, F, G, H;  /* Word buffers */
 
-    /*
-    * Initialize the first 16 words in the array W
-    */
-    for (t = t4 = 0; t < 16; t++, t4 += 4)
-        W[t] = (((uint32_t)context->Message_Block[t4]) << 24) |
-        (((uint32_t)context->Message_Block[t4 + 1]) << 16) |
-        (((uint32_t)context->Message_Block[t4 + 2]) << 8) |
-        (((uint32_t)context->Message_Block[t4 + 3]));
-
-    for (t = 16; t < 64; t++)
-        W[t] = SHA256_sigma1(W[t - 2]) + W[t - 7] +
-        SHA256_sigma0(W[t - 15]) + W[t - 16];
-
-    A = context->Intermediate_Hash[0];
-    B = context->Intermediate_Hash[1];
-    C = context->Intermediate_Hash[2];
-    D = context->Intermediate_Hash[3];
-    E = context->Intermediate_Hash[4];
-    F = context->Intermediate_Hash[5];
-    G = context->Intermediate_Hash[6];
-    H = context->Intermediate_Hash[7];
-
-    for (t = 0; t < 64; t++) {
-        temp1 = H + SHA256_SIGMA1(E) + SHA_Ch(E, F, G) + K[t] + W[t];
-        temp2 = SHA256_SIGMA0(A) + SHA_Maj(A, B, C);
-        H = G;
-        G = F;
-        F = E;
-        E = D + temp1;
-        D = C;
-        C = B;
-        B = A;
-        A = temp1 + temp2;
+    for (; block_count > 0; block_count--,
+        blocks += SHA256_Message_Block_Size) {
+        /*
+        * Initialize the first 16 words in the array W
+        */
+        for (t = t4 = 0; t < 16; t++, t4 += 4)
+            W[t] = (((uint32_t)blocks[t4]) << 24) |
+            (((uint32_t)blocks[t4 + 1]) << 16) |
+            (((uint32_t)blocks[t4 + 2]) << 8) |
+            (((uint32_t)blocks[t4 + 3]));
+
+        for (t = 16; t < 64; t++)
+            W[t] = SHA256_sigma1(W[t - 2]) + W[t - 7] +
+            SHA256_sigma0(W[t - 15]) + W[t - 16];
+
+        A = Intermediate_Hash[0];
+        B = Intermediate_Hash[1];
+        C = Intermediate_Hash[2];
+        D = Intermediate_Hash[3];
+        E = Intermediate_Hash[4];
+        F = Intermediate_Hash[5];
+        G = Intermediate_Hash[6];
+        H = Intermediate_Hash[7];
+
+        for (t = 0; t < 64; t++) {
+            temp1 = H + SHA256_SIGMA1(E) + SHA_Ch(E, F, G) + K[t] + W[t];
+            temp2 = SHA256_SIGMA0(A) + SHA_Maj(A, B, C);
+            H = G;
+            G = F;
+            F = E;
+            E = D + temp1;
+            D = C;
+            C = B;
+            B = A;
+            A = temp1 + temp2;
+        }
+
+        Intermediate_Hash[0] += A;
+        Intermediate_Hash[1] += B;
+        Intermediate_Hash[2] += C;
+        Intermediate_Hash[3] += D;
+        Intermediate_Hash[4] += E;
+        Intermediate_Hash[5] += F;
+        Intermediate_Hash[6] += G;
+        Intermediate_Hash[7] += H;
     }
-
-    context->Intermediate_Hash[0] += A;
-    context->Intermediate_Hash[1] += B;
-    context->Intermediate_Hash[2] += C;
-    context->Intermediate_Hash[3] += D;
-    context->Intermediate_Hash[4] += E;
-    context->Intermediate_Hash[5] += F;
-    context->Intermediate_Hash[6] += G;
-    context->Intermediate_Hash[7] += H;
-
-    context->Message_Block_Index = 0;
 }
 
 /*
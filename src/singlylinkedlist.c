@@ -3,6 +3,7 @@
 
 #include <stdlib.h>
 #include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/slaballoc.h"
 #include "azure_c_shared_utility/singlylinkedlist.h"
 #include "azure_c_shared_utility/optimize_size.h"
 
@@ -22,7 +23,7 @@ SINGLYLINKEDLIST_HANDLE singlylinkedlist_create(void)
     LIST_INSTANCE* result;
 
     /* Codes_SRS_LIST_01_001: [singlylinkedlist_create shall create a new list and return a non-NULL handle on success.] */
-    result = (LIST_INSTANCE*)malloc(sizeof(LIST_INSTANCE));
+    result = (LIST_INSTANCE*)SLABALLOC_MALLOC(sizeof(LIST_INSTANCE));
     if (result != NULL)
     {
         /* Codes_SRS_LIST_01_002: [If any error occurs during the list creation, singlylinkedlist_create shall return NULL.] */
@@ -43,11 +44,11 @@ void singlylinkedlist_destroy(SINGLYLINKEDLIST_HANDLE list)
         {
             LIST_ITEM_INSTANCE* current_item = list_instance->head;
             list_instance->head = (LIST_ITEM_INSTANCE*)current_item->next;
-            free(current_item);
+            SLABALLOC_FREE(current_item);
         }
 
         /* Codes_SRS_LIST_01_003: [singlylinkedlist_destroy shall free all resources associated with the list identified by the handle argument.] */
-        free(list_instance);
+        SLABALLOC_FREE(list_instance);
     }
 }
 
@@ -64,7 +65,7 @@ LIST_ITEM_HANDLE singlylinkedlist_add(SINGLYLINKEDLIST_HANDLE list, const void*
     else
     {
         LIST_INSTANCE* list_instance = (LIST_INSTANCE*)list;
-        result = (LIST_ITEM_INSTANCE*)malloc(sizeof(LIST_ITEM_INSTANCE));
+        result = (LIST_ITEM_INSTANCE*)SLABALLOC_MALLOC(sizeof(LIST_ITEM_INSTANCE));
 
         if (result == NULL)
         {
@@ -126,7 +127,7 @@ int singlylinkedlist_remove(SINGLYLINKEDLIST_HANDLE list, LIST_ITEM_HANDLE item)
                     list_instance->head = (LIST_ITEM_INSTANCE*)current_item->next;
                 }
 
-                free(current_item);
+                SLABALLOC_FREE(current_item);
 
                 break;
             }
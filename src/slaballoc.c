@@ -0,0 +1,520 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/slaballoc.h"
+#include "azure_c_shared_utility/lock.h"
+#include "azure_c_shared_utility/optimize_size.h"
+#include "azure_c_shared_utility/xlogging.h"
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+/* per thread caches need thread local storage, without it all blocks go through the (locked) size class free lists */
+#ifdef SLABALLOC_THREAD_CACHE
+#if defined(_MSC_VER)
+#define SLABALLOC_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+#define SLABALLOC_THREAD_LOCAL __thread
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define SLABALLOC_THREAD_LOCAL _Thread_local
+#else
+#undef SLABALLOC_THREAD_CACHE
+#endif
+#endif
+
+#define SLABALLOC_CLASS_COUNT 8
+#define SLABALLOC_BLOCKS_PER_SLAB 64
+/* a thread refills its empty cache with this many blocks at once and gives half of its cache back once it holds more than the maximum */
+#define SLABALLOC_THREAD_CACHE_BATCH 16
+#define SLABALLOC_THREAD_CACHE_MAX 32
+
+typedef struct SIZE_CLASS_TAG SIZE_CLASS;
+
+/* every block (and every passed through allocation) is preceded by this header, so that slaballoc_free can find where the block came from */
+typedef union BLOCK_HEADER_TAG
+{
+    SIZE_CLASS* size_class; /* NULL for allocations passed through to malloc */
+    void* alignment_pointer;
+    long long alignment_long_long;
+    double alignment_double;
+} BLOCK_HEADER;
+
+/* a block that is not in use links to the next free block through its first bytes */
+typedef struct FREE_BLOCK_TAG
+{
+    struct FREE_BLOCK_TAG* next;
+} FREE_BLOCK;
+
+/* slabs are only released by slaballoc_deinit, the header keeps them in a list until then */
+typedef union SLAB_TAG
+{
+    union SLAB_TAG* next;
+    BLOCK_HEADER alignment;
+} SLAB;
+
+struct SIZE_CLASS_TAG
+{
+    size_t block_size;
+    LOCK_HANDLE lock;
+    FREE_BLOCK* free_blocks;
+    SLAB* slabs;
+};
+
+typedef enum SLABALLOC_STATE_TAG
+{
+    SLABALLOC_STATE_INIT,
+    SLABALLOC_STATE_NOT_INIT
+} SLABALLOC_STATE;
+
+static const size_t size_class_block_sizes[SLABALLOC_CLASS_COUNT] = { 16, 32, 48, 64, 96, 128, 192, SLABALLOC_MAX_BLOCK_SIZE };
+
+/* size class index for every (size + 15) / 16 */
+static const unsigned char size_class_indexes[(SLABALLOC_MAX_BLOCK_SIZE / 16) + 1] = { 0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7 };
+
+static SIZE_CLASS size_classes[SLABALLOC_CLASS_COUNT];
+static SLABALLOC_STATE slaballocState = SLABALLOC_STATE_NOT_INIT;
+
+#ifdef SLABALLOC_THREAD_CACHE
+typedef struct THREAD_CACHE_TAG
+{
+    unsigned int generation;
+    FREE_BLOCK* free_blocks[SLABALLOC_CLASS_COUNT];
+    size_t count[SLABALLOC_CLASS_COUNT];
+} THREAD_CACHE;
+
+/* bumped by every slaballoc_init, a thread cache filled under another generation holds blocks of slabs that slaballoc_deinit released */
+static unsigned int slaballocGeneration = 0;
+static SLABALLOC_THREAD_LOCAL THREAD_CACHE thread_cache;
+
+static THREAD_CACHE* get_thread_cache(void)
+{
+    if (thread_cache.generation != slaballocGeneration)
+    {
+        (void)memset(&thread_cache, 0, sizeof(thread_cache));
+        thread_cache.generation = slaballocGeneration;
+    }
+
+    return &thread_cache;
+}
+#endif
+
+static void* passthrough_malloc(size_t size)
+{
+    void* result;
+
+    if (size > SIZE_MAX - sizeof(BLOCK_HEADER))
+    {
+        /* Codes_SRS_SLABALLOC_01_009: [ If size plus the size of the block header overflows, slaballoc_malloc shall fail and return NULL. ]*/
+        LogError("Cannot allocate %lu bytes", (unsigned long)size);
+        result = NULL;
+    }
+    else
+    {
+        BLOCK_HEADER* header = (BLOCK_HEADER*)malloc(sizeof(BLOCK_HEADER) + size);
+        if (header == NULL)
+        {
+            LogError("unable to malloc");
+            result = NULL;
+        }
+        else
+        {
+            header->size_class = NULL;
+            result = header + 1;
+        }
+    }
+
+    return result;
+}
+
+/* allocates a new slab and returns its blocks as a NULL terminated chain, the caller holds the size class lock */
+static FREE_BLOCK* add_slab(SIZE_CLASS* size_class)
+{
+    FREE_BLOCK* result;
+    size_t block_stride = sizeof(BLOCK_HEADER) + size_class->block_size;
+    /* Codes_SRS_SLABALLOC_01_011: [ If the free list of the size class is empty, slaballoc_malloc shall allocate a new slab holding SLABALLOC_BLOCKS_PER_SLAB blocks by calling malloc and add its blocks to the free list. ]*/
+    SLAB* slab = (SLAB*)malloc(sizeof(SLAB) + (block_stride * SLABALLOC_BLOCKS_PER_SLAB));
+    if (slab == NULL)
+    {
+        /* Codes_SRS_SLABALLOC_01_012: [ If allocating the slab fails, slaballoc_malloc shall fail and return NULL. ]*/
+        LogError("unable to allocate a slab of %lu byte blocks", (unsigned long)size_class->block_size);
+        result = NULL;
+    }
+    else
+    {
+        unsigned char* blocks = (unsigned char*)(slab + 1);
+        size_t i;
+
+        slab->next = size_class->slabs;
+        size_class->slabs = slab;
+
+        /* chained back to front so that the blocks are handed out in address order */
+        result = NULL;
+        for (i = SLABALLOC_BLOCKS_PER_SLAB; i > 0; i--)
+        {
+            BLOCK_HEADER* header = (BLOCK_HEADER*)(blocks + ((i - 1) * block_stride));
+            FREE_BLOCK* block = (FREE_BLOCK*)(header + 1);
+            header->size_class = size_class;
+            block->next = result;
+            result = block;
+        }
+    }
+
+    return result;
+}
+
+/* takes up to count blocks off the size class free list as a NULL terminated chain */
+static FREE_BLOCK* take_blocks(SIZE_CLASS* size_class, size_t count, size_t* taken)
+{
+    FREE_BLOCK* result;
+
+    /* Codes_SRS_SLABALLOC_01_013: [ slaballoc_malloc shall only access the free list of a size class while holding the lock of the size class. ]*/
+    if (Lock(size_class->lock) != LOCK_OK)
+    {
+        /* Codes_SRS_SLABALLOC_01_014: [ If acquiring the lock fails, slaballoc_malloc shall fail and return NULL. ]*/
+        LogError("Failed to get the Lock.");
+        result = NULL;
+    }
+    else
+    {
+        if (size_class->free_blocks == NULL)
+        {
+            size_class->free_blocks = add_slab(size_class);
+        }
+
+        result = size_class->free_blocks;
+        if (result != NULL)
+        {
+            FREE_BLOCK* last = result;
+            size_t chain_length = 1;
+
+            while ((chain_length < count) && (last->next != NULL))
+            {
+                last = last->next;
+                chain_length++;
+            }
+
+            size_class->free_blocks = last->next;
+            last->next = NULL;
+            *taken = chain_length;
+        }
+
+        (void)Unlock(size_class->lock);
+    }
+
+    return result;
+}
+
+/* puts the NULL terminated chain first..last back on the size class free list */
+static void return_blocks(SIZE_CLASS* size_class, FREE_BLOCK* first, FREE_BLOCK* last)
+{
+    /* Codes_SRS_SLABALLOC_01_026: [ Otherwise slaballoc_free shall put the block back on the free list of its size class while holding the lock of the size class. ]*/
+    if (Lock(size_class->lock) != LOCK_OK)
+    {
+        /* Codes_SRS_SLABALLOC_01_028: [ If acquiring the lock fails, slaballoc_free shall log the error and leave the block unused until slaballoc_deinit. ]*/
+        LogError("Failed to get the Lock, %lu byte blocks cannot be reused.", (unsigned long)size_class->block_size);
+    }
+    else
+    {
+        last->next = size_class->free_blocks;
+        size_class->free_blocks = first;
+        (void)Unlock(size_class->lock);
+    }
+}
+
+int slaballoc_init(void)
+{
+    int result;
+
+    if (slaballocState != SLABALLOC_STATE_NOT_INIT)
+    {
+        /* Codes_SRS_SLABALLOC_01_002: [ Init after Init shall fail and return a non-zero value. ]*/
+        LogError("slaballoc is already initialized");
+        result = __FAILURE__;
+    }
+    else
+    {
+        size_t i;
+
+        for (i = 0; i < SLABALLOC_CLASS_COUNT; i++)
+        {
+            size_classes[i].block_size = size_class_block_sizes[i];
+            size_classes[i].free_blocks = NULL;
+            size_classes[i].slabs = NULL;
+
+            /* Codes_SRS_SLABALLOC_01_003: [ slaballoc_init shall create one lock for each size class by calling Lock_Init. ]*/
+            if ((size_classes[i].lock = Lock_Init()) == NULL)
+            {
+                LogError("Lock_Init failed");
+                break;
+            }
+        }
+
+        if (i < SLABALLOC_CLASS_COUNT)
+        {
+            /* Codes_SRS_SLABALLOC_01_004: [ If creating any of the locks fails, slaballoc_init shall destroy the locks created so far and return a non-zero value. ]*/
+            while (i > 0)
+            {
+                i--;
+                (void)Lock_Deinit(size_classes[i].lock);
+            }
+
+            result = __FAILURE__;
+        }
+        else
+        {
+#ifdef SLABALLOC_THREAD_CACHE
+            if (++slaballocGeneration == 0)
+            {
+                slaballocGeneration = 1;
+            }
+#endif
+            slaballocState = SLABALLOC_STATE_INIT;
+
+            /* Codes_SRS_SLABALLOC_01_001: [ slaballoc_init shall initialize the slaballoc module and return 0 upon success. ]*/
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+void slaballoc_deinit(void)
+{
+    /* Codes_SRS_SLABALLOC_01_006: [ If slaballoc is not initialized slaballoc_deinit shall do nothing. ]*/
+    if (slaballocState == SLABALLOC_STATE_INIT)
+    {
+        size_t i;
+
+        for (i = 0; i < SLABALLOC_CLASS_COUNT; i++)
+        {
+            /* Codes_SRS_SLABALLOC_01_005: [ slaballoc_deinit shall free all the slabs and destroy the locks created by slaballoc_init. ]*/
+            while (size_classes[i].slabs != NULL)
+            {
+                SLAB* slab = size_classes[i].slabs;
+                size_classes[i].slabs = slab->next;
+                free(slab);
+            }
+
+            size_classes[i].free_blocks = NULL;
+            (void)Lock_Deinit(size_classes[i].lock);
+        }
+
+        slaballocState = SLABALLOC_STATE_NOT_INIT;
+    }
+}
+
+void* slaballoc_malloc(size_t size)
+{
+    void* result;
+
+    if ((slaballocState != SLABALLOC_STATE_INIT) ||
+        (size > SLABALLOC_MAX_BLOCK_SIZE))
+    {
+        /* Codes_SRS_SLABALLOC_01_007: [ If slaballoc is not initialized, slaballoc_malloc shall call malloc for size bytes plus a block header and return the memory following the header. ]*/
+        /* Codes_SRS_SLABALLOC_01_008: [ If size is greater than SLABALLOC_MAX_BLOCK_SIZE, slaballoc_malloc shall call malloc for size bytes plus a block header and return the memory following the header. ]*/
+        result = passthrough_malloc(size);
+    }
+    else
+    {
+        /* Codes_SRS_SLABALLOC_01_010: [ Otherwise slaballoc_malloc shall return a block taken from the free list of the smallest size class whose blocks can hold size bytes. ]*/
+        size_t index = size_class_indexes[(size + 15) / 16];
+        FREE_BLOCK* block;
+#ifdef SLABALLOC_THREAD_CACHE
+        /* Codes_SRS_SLABALLOC_01_015: [ When built with SLABALLOC_THREAD_CACHE, slaballoc_malloc shall take the block from the cache of the calling thread and refill an empty cache with up to SLABALLOC_THREAD_CACHE_BATCH blocks from the free list of the size class. ]*/
+        THREAD_CACHE* cache = get_thread_cache();
+        if (cache->free_blocks[index] == NULL)
+        {
+            cache->free_blocks[index] = take_blocks(&size_classes[index], SLABALLOC_THREAD_CACHE_BATCH, &cache->count[index]);
+        }
+
+        block = cache->free_blocks[index];
+        if (block != NULL)
+        {
+            cache->free_blocks[index] = block->next;
+            cache->count[index]--;
+        }
+#else
+        size_t taken;
+        block = take_blocks(&size_classes[index], 1, &taken);
+#endif
+        result = block;
+    }
+
+    return result;
+}
+
+void* slaballoc_calloc(size_t nmemb, size_t size)
+{
+    void* result;
+
+    if ((size != 0) && (nmemb > SIZE_MAX / size))
+    {
+        /* Codes_SRS_SLABALLOC_01_016: [ If nmemb * size overflows, slaballoc_calloc shall fail and return NULL. ]*/
+        LogError("Cannot allocate %lu elements of %lu bytes", (unsigned long)nmemb, (unsigned long)size);
+        result = NULL;
+    }
+    /* Codes_SRS_SLABALLOC_01_017: [ slaballoc_calloc shall allocate nmemb * size bytes as slaballoc_malloc does and set them to 0. ]*/
+    else if ((result = slaballoc_malloc(nmemb * size)) != NULL)
+    {
+        (void)memset(result, 0, nmemb * size);
+    }
+
+    return result;
+}
+
+void* slaballoc_realloc(void* ptr, size_t size)
+{
+    void* result;
+
+    if (ptr == NULL)
+    {
+        /* Codes_SRS_SLABALLOC_01_018: [ If ptr is NULL, slaballoc_realloc shall behave as slaballoc_malloc. ]*/
+        result = slaballoc_malloc(size);
+    }
+    else
+    {
+        BLOCK_HEADER* header = (BLOCK_HEADER*)ptr - 1;
+        SIZE_CLASS* size_class = header->size_class;
+
+        if (size_class == NULL)
+        {
+            if (size > SIZE_MAX - sizeof(BLOCK_HEADER))
+            {
+                LogError("Cannot allocate %lu bytes", (unsigned long)size);
+                result = NULL;
+            }
+            else
+            {
+                /* Codes_SRS_SLABALLOC_01_022: [ If ptr was passed through to malloc, slaballoc_realloc shall call realloc for size bytes plus the block header and return the memory following the header. ]*/
+                BLOCK_HEADER* new_header = (BLOCK_HEADER*)realloc(header, sizeof(BLOCK_HEADER) + size);
+                if (new_header == NULL)
+                {
+                    /* Codes_SRS_SLABALLOC_01_023: [ If realloc fails, slaballoc_realloc shall fail and return NULL. ]*/
+                    LogError("unable to realloc");
+                    result = NULL;
+                }
+                else
+                {
+                    result = new_header + 1;
+                }
+            }
+        }
+        else if (size <= size_class->block_size)
+        {
+            /* Codes_SRS_SLABALLOC_01_019: [ If ptr is a block of a size class that can hold size bytes, slaballoc_realloc shall return ptr. ]*/
+            result = ptr;
+        }
+        else
+        {
+            /* Codes_SRS_SLABALLOC_01_020: [ Otherwise slaballoc_realloc shall allocate size bytes with slaballoc_malloc, copy the content of the block, free the block with slaballoc_free and return the new memory. ]*/
+            result = slaballoc_malloc(size);
+            if (result == NULL)
+            {
+                /* Codes_SRS_SLABALLOC_01_021: [ If the allocation fails, slaballoc_realloc shall return NULL and leave ptr unchanged. ]*/
+                LogError("unable to allocate %lu bytes", (unsigned long)size);
+            }
+            else
+            {
+                (void)memcpy(result, ptr, size_class->block_size);
+                slaballoc_free(ptr);
+            }
+        }
+    }
+
+    return result;
+}
+
+void slaballoc_free(void* ptr)
+{
+    /* Codes_SRS_SLABALLOC_01_024: [ If ptr is NULL, slaballoc_free shall do nothing. ]*/
+    if (ptr != NULL)
+    {
+        BLOCK_HEADER* header = (BLOCK_HEADER*)ptr - 1;
+        SIZE_CLASS* size_class = header->size_class;
+
+        if (size_class == NULL)
+        {
+            /* Codes_SRS_SLABALLOC_01_025: [ If ptr was passed through to malloc, slaballoc_free shall free the underlying allocation. ]*/
+            free(header);
+        }
+        else
+        {
+            FREE_BLOCK* block = (FREE_BLOCK*)ptr;
+#ifdef SLABALLOC_THREAD_CACHE
+            /* Codes_SRS_SLABALLOC_01_027: [ When built with SLABALLOC_THREAD_CACHE, slaballoc_free shall put the block in the cache of the calling thread and, once the cache holds more than SLABALLOC_THREAD_CACHE_MAX blocks, put half of them back on the free list of the size class. ]*/
+            THREAD_CACHE* cache = get_thread_cache();
+            size_t index = (size_t)(size_class - size_classes);
+
+            block->next = cache->free_blocks[index];
+            cache->free_blocks[index] = block;
+            cache->count[index]++;
+
+            if (cache->count[index] > SLABALLOC_THREAD_CACHE_MAX)
+            {
+                /* the most recently freed blocks are the likeliest to still be in the CPU cache, those stay with the thread */
+                FREE_BLOCK* last_kept = block;
+                FREE_BLOCK* first_returned;
+                FREE_BLOCK* last_returned;
+                size_t i;
+
+                for (i = 1; i < SLABALLOC_THREAD_CACHE_MAX / 2; i++)
+                {
+                    last_kept = last_kept->next;
+                }
+
+                first_returned = last_kept->next;
+                last_kept->next = NULL;
+                cache->count[index] = SLABALLOC_THREAD_CACHE_MAX / 2;
+
+                last_returned = first_returned;
+                while (last_returned->next != NULL)
+                {
+                    last_returned = last_returned->next;
+                }
+
+                return_blocks(size_class, first_returned, last_returned);
+            }
+#else
+            block->next = NULL;
+            return_blocks(size_class, block, block);
+#endif
+        }
+    }
+}
+
+void slaballoc_release_thread_cache(void)
+{
+#ifdef SLABALLOC_THREAD_CACHE
+    /* Codes_SRS_SLABALLOC_01_030: [ If slaballoc is not initialized, slaballoc_release_thread_cache shall do nothing. ]*/
+    if (slaballocState == SLABALLOC_STATE_INIT)
+    {
+        THREAD_CACHE* cache = get_thread_cache();
+        size_t i;
+
+        for (i = 0; i < SLABALLOC_CLASS_COUNT; i++)
+        {
+            FREE_BLOCK* first = cache->free_blocks[i];
+            if (first != NULL)
+            {
+                FREE_BLOCK* last = first;
+                while (last->next != NULL)
+                {
+                    last = last->next;
+                }
+
+                /* Codes_SRS_SLABALLOC_01_029: [ When built with SLABALLOC_THREAD_CACHE, slaballoc_release_thread_cache shall put all the blocks in the cache of the calling thread back on the free lists of their size classes while holding the lock of each size class. ]*/
+                /* Codes_SRS_SLABALLOC_01_031: [ If acquiring the lock fails, slaballoc_release_thread_cache shall log the error and leave the blocks unused until slaballoc_deinit. ]*/
+                return_blocks(&size_classes[i], first, last);
+                cache->free_blocks[i] = NULL;
+                cache->count[i] = 0;
+            }
+        }
+    }
+#endif
+}
@@ -4,6 +4,8 @@
 #include <stdlib.h>
 #include "azure_c_shared_utility/gballoc.h"
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 #include "azure_c_shared_utility/string_tokenizer.h"
 #include "azure_c_shared_utility/optimize_size.h"
 #include "azure_c_shared_utility/xlogging.h"
@@ -11,11 +13,30 @@
 
 typedef struct STRING_TOKEN_TAG
 {
-    const char* inputString;
-    const char* currentPos;
-    size_t sizeOfinputString;
+    char* inputString;
+    STRING_VIEW remaining; /*the part of inputString not yet tokenized*/
 } STRING_TOKEN;
 
+/*a set of delimiters, one bit for each of the 256 possible characters*/
+#define DELIMITER_SET_WORDS (256 / 32)
+
+static void build_delimiter_set(uint32_t delimiter_set[DELIMITER_SET_WORDS], const char* delimiters)
+{
+    (void)memset(delimiter_set, 0, DELIMITER_SET_WORDS * sizeof(uint32_t));
+    while (*delimiters != '\0')
+    {
+        unsigned char c = (unsigned char)*delimiters;
+        delimiter_set[c >> 5] |= (uint32_t)1 << (c & 31);
+        delimiters++;
+    }
+}
+
+static int is_delimiter(const uint32_t delimiter_set[DELIMITER_SET_WORDS], char character)
+{
+    unsigned char c = (unsigned char)character;
+    return (delimiter_set[c >> 5] >> (c & 31)) & 1;
+}
+
 STRING_TOKENIZER_HANDLE STRING_TOKENIZER_create(STRING_HANDLE handle)
 {
     STRING_TOKENIZER_HANDLE result;
@@ -60,8 +81,8 @@ extern STRING_TOKENIZER_HANDLE STRING_TOKENIZER_create_from_char(const char* inp
     else
     {
         result->inputString = inputStringToMalloc;
-        result->currentPos = result->inputString; //Current Pos will point to the initial position of Token.
-        result->sizeOfinputString = strlen(result->inputString); //Calculate Size of Current String
+        result->remaining.str = result->inputString; //Tokenizing starts at the beginning of the string.
+        result->remaining.length = strlen(result->inputString);
     }
     return (STRING_TOKENIZER_HANDLE)result;
 }
@@ -78,108 +99,96 @@ int STRING_TOKENIZER_get_next_token(STRING_TOKENIZER_HANDLE tokenizer, STRING_HA
     {
         STRING_TOKEN* token = (STRING_TOKEN*)tokenizer;
         /* Codes_SRS_STRING_04_011: [Each subsequent call to STRING_TOKENIZER_get_next_token starts searching from the saved position on t and behaves as described above.] */
-        size_t remainingInputStringSize = token->sizeOfinputString - (token->currentPos - token->inputString);
-        size_t delimitterSize = strlen(delimiters);
+        STRING_VIEW remaining = token->remaining;
+        STRING_VIEW next_token;
 
-        /* First Check if we reached the end of the string*/
-        /* Codes_SRS_STRING_TOKENIZER_04_014: [STRING_TOKENIZER_get_next_token shall return nonzero value if t contains an empty string.] */
-        if (remainingInputStringSize == 0)
+        /* Codes_SRS_STRING_04_005: [STRING_TOKENIZER_get_next_token searches the string inside STRING_TOKENIZER_HANDLE for the first character that is NOT contained in the current delimiter] */
+        /* Codes_SRS_STRING_04_007: [If such a character is found, STRING_TOKENIZER_get_next_token consider it as the start of a token.] */
+        /*Codes_SRS_STRING_04_008: [STRING_TOKENIZER_get_next_token than searches from the start of a token for a character that is contained in the delimiters string.] */
+        if (STRING_VIEW_get_next_token(&remaining, &next_token, delimiters) != 0)
         {
+            /* Codes_SRS_STRING_TOKENIZER_04_014: [STRING_TOKENIZER_get_next_token shall return nonzero value if t contains an empty string.] */
+            /* Codes_SRS_STRING_04_006: [If no such character is found, then STRING_TOKENIZER_get_next_token shall return a nonzero Value (You've reach the end of the string or the string consists with only delimiters).] */
+            token->remaining = remaining;
             result = __FAILURE__;
         }
-        else if (delimitterSize == 0)
+        /* Codes_SRS_STRING_04_009: [If no such character is found, STRING_TOKENIZER_get_next_token extends the current token to the end of the string inside t, copies the token to output and returns 0.] */
+        /* Codes_SRS_STRING_04_010: [If such a character is found, STRING_TOKENIZER_get_next_token consider it the end of the token and copy it's content to output, updates the current position inside t to the next character and returns 0.] */
+        else if (STRING_copy_n(output, next_token.str, next_token.length) != 0)
         {
-            LogError("Empty delimiters parameter.");
+            LogError("Problem copying token to output String.");
             result = __FAILURE__;
         }
         else
         {
-            size_t i;
-            /* Codes_SRS_STRING_04_005: [STRING_TOKENIZER_get_next_token searches the string inside STRING_TOKENIZER_HANDLE for the first character that is NOT contained in the current delimiter] */
-            for (i = 0; i < remainingInputStringSize; i++)
-            {
-                size_t j;
-
-                bool foundDelimitter = false;
-                for (j = 0; j < delimitterSize; j++)
-                {
-                    if (token->currentPos[i] == delimiters[j])
-                    {
-                        foundDelimitter = true;
-                        break;
-                    }
-                }
-
-                /* Codes_SRS_STRING_04_007: [If such a character is found, STRING_TOKENIZER_get_next_token consider it as the start of a token.] */
-                if (!foundDelimitter)
-                {
-                    break;
-                }
-            }
+            token->remaining = remaining;
+            result = 0;
+        }
+    }
 
-            /* Codes_SRS_STRING_04_006: [If no such character is found, then STRING_TOKENIZER_get_next_token shall return a nonzero Value (You've reach the end of the string or the string consists with only delimiters).] */
-            //At this point update Current Pos to the character of the last token found or end of String.
-            token->currentPos += i; 
-            
-            //Update the remainingInputStringSize
-            remainingInputStringSize -= i;
-            
-            /* Codes_SRS_STRING_04_006: [If no such character is found, then STRING_TOKENIZER_get_next_token shall return a nonzero Value (You've reach the end of the string or the string consists with only delimiters).] */
-            if (remainingInputStringSize == 0)
+    return result;
+}
+
+int STRING_VIEW_get_next_token(STRING_VIEW* input, STRING_VIEW* token, const char* delimiters)
+{
+    int result;
+
+    /* Codes_SRS_STRING_TOKENIZER_01_001: [ If input, token or delimiters is NULL, STRING_VIEW_get_next_token shall fail and return a non-zero value. ]*/
+    if ((input == NULL) || (token == NULL) || (delimiters == NULL))
+    {
+        LogError("invalid parameter (NULL)");
+        result = __FAILURE__;
+    }
+    /* Codes_SRS_STRING_TOKENIZER_01_002: [ If delimiters is an empty string, STRING_VIEW_get_next_token shall fail and return a non-zero value. ]*/
+    else if (*delimiters == '\0')
+    {
+        LogError("Empty delimiters parameter.");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /* Codes_SRS_STRING_TOKENIZER_01_007: [ STRING_VIEW_get_next_token shall not allocate memory and shall not copy characters. ]*/
+        uint32_t delimiter_set[DELIMITER_SET_WORDS];
+        const char* position = input->str;
+        const char* end = input->str + input->length;
+
+        build_delimiter_set(delimiter_set, delimiters);
+
+        /* Codes_SRS_STRING_TOKENIZER_01_003: [ STRING_VIEW_get_next_token shall skip the characters at the beginning of input that are contained in delimiters. ]*/
+        while ((position < end) && is_delimiter(delimiter_set, *position))
+        {
+            position++;
+        }
+
+        if (position == end)
+        {
+            /* Codes_SRS_STRING_TOKENIZER_01_004: [ If no other character remains in input, STRING_VIEW_get_next_token shall set input to an empty view at its end and return a non-zero value. ]*/
+            input->str = end;
+            input->length = 0;
+            result = __FAILURE__;
+        }
+        else
+        {
+            const char* token_end = position + 1;
+
+            /* Codes_SRS_STRING_TOKENIZER_01_005: [ Otherwise STRING_VIEW_get_next_token shall set token to the characters from the first character not contained in delimiters up to, but not including, the next character contained in delimiters or the end of input, and return 0. ]*/
+            while ((token_end < end) && !is_delimiter(delimiter_set, *token_end))
             {
-                result = __FAILURE__;
+                token_end++;
             }
-            else
+
+            token->str = position;
+            token->length = token_end - position;
+
+            /* Codes_SRS_STRING_TOKENIZER_01_006: [ STRING_VIEW_get_next_token shall advance input past the token and the delimiter that ended it. ]*/
+            if (token_end < end)
             {
-                bool foundDelimitter = false;
-                const char* endOfTokenPosition=NULL;
-                size_t amountOfCharactersToCopy;
-                size_t j;
-                //At this point the Current Pos is pointing to a character that is point to a nonDelimiter. So, now search for a Delimiter, till the end of the String. 
-                /*Codes_SRS_STRING_04_008: [STRING_TOKENIZER_get_next_token than searches from the start of a token for a character that is contained in the delimiters string.] */
-                /* Codes_SRS_STRING_04_009: [If no such character is found, STRING_TOKENIZER_get_next_token extends the current token to the end of the string inside t, copies the token to output and returns 0.] */
-                /* Codes_SRS_STRING_04_010: [If such a character is found, STRING_TOKENIZER_get_next_token consider it the end of the token and copy it's content to output, updates the current position inside t to the next character and returns 0.] */
-                for (j = 0; j < delimitterSize; j++)
-                {
-                    if ((endOfTokenPosition = strchr(token->currentPos, delimiters[j])) != NULL)
-                    {
-                        foundDelimitter = true;
-                        break;
-                    }
-                }
-
-                //If token not found, than update the EndOfToken to the end of the inputString;
-                if (endOfTokenPosition == NULL)
-                {
-                    amountOfCharactersToCopy = remainingInputStringSize;
-                }
-                else
-                {
-                    amountOfCharactersToCopy = endOfTokenPosition - token->currentPos;
-                }
-                
-                //copy here the string to output. 
-                if (STRING_copy_n(output, token->currentPos, amountOfCharactersToCopy) != 0)
-                {
-                    LogError("Problem copying token to output String.");
-                    result = __FAILURE__;
-                }
-                else
-                {
-                    //Update the Current position.
-                    //Check if end of String reached so, currentPos points to the end of String.
-                    if (foundDelimitter)
-                    {
-                        token->currentPos += amountOfCharactersToCopy + 1;
-                    }
-                    else
-                    {
-                        token->currentPos += amountOfCharactersToCopy;
-                    }
-                    
-                    result = 0; //Result will be on the output. 
-                }
+                token_end++;
             }
+
+            input->str = token_end;
+            input->length = end - token_end;
+            result = 0;
         }
     }
 
@@ -194,7 +203,7 @@ void STRING_TOKENIZER_destroy(STRING_TOKENIZER_HANDLE t)
     if (t != NULL)
     {
         STRING_TOKEN* value = (STRING_TOKEN*)t;
-        free((char*)value->inputString);
+        free(value->inputString);
         value->inputString = NULL;
         free(value);
     }
@@ -6,10 +6,12 @@
 //
 #include <stdlib.h>
 #include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/slaballoc.h"
 #include <stddef.h>
 #include <string.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdint.h>
 
 //
 // PUT NO CLIENT LIBRARY INCLUDES BEFORE HERE
@@ -19,31 +21,407 @@
 #include "azure_c_shared_utility/optimize_size.h"
 #include "azure_c_shared_utility/xlogging.h"
 
+/*SSE2 is part of every x86-64 processor and NEON of every ARM64 one, so the JSON scanner needs no runtime dispatch*/
+/*defining NO_SIMD (the no_simd cmake option) compiles it out*/
+#if !defined(NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define STRING_SIMD_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define STRING_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif /* NO_SIMD */
+
 static const char hexToASCII[16] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F' };
 
+#define JSON_INVALID_CHARACTER (-1)
+
+/*how each character is written in a JSON string: 0 is "as it is", 'u' is \u00xx, JSON_INVALID_CHARACTER cannot be written and
+any other value is written as a backslash followed by that value*/
+static const signed char json_escapes[256] = {
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '/',
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+/*returns how many characters at the start of source are written to a JSON string as they are*/
+static size_t json_plain_length(const char* source, size_t length)
+{
+    size_t pos = 0;
+
+#if defined(STRING_SIMD_SSE2)
+    /*a signed compare with 0x20 catches both the control characters and the ones above 127*/
+    const __m128i space = _mm_set1_epi8(0x20);
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i slash = _mm_set1_epi8('/');
+    while (length - pos >= 16)
+    {
+        __m128i characters = _mm_loadu_si128((const __m128i*)(source + pos));
+        __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmplt_epi8(characters, space), _mm_cmpeq_epi8(characters, quote)),
+            _mm_or_si128(_mm_cmpeq_epi8(characters, backslash), _mm_cmpeq_epi8(characters, slash)));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(special);
+        if (mask != 0)
+        {
+#if defined(_MSC_VER)
+            unsigned long first;
+            (void)_BitScanForward(&first, mask);
+            return pos + first;
+#else
+            return pos + (size_t)__builtin_ctz(mask);
+#endif
+        }
+        pos += 16;
+    }
+#elif defined(STRING_SIMD_NEON)
+    const int8x16_t space = vdupq_n_s8(0x20);
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t slash = vdupq_n_u8('/');
+    while (length - pos >= 16)
+    {
+        uint8x16_t characters = vld1q_u8((const uint8_t*)(source + pos));
+        uint8x16_t special = vorrq_u8(
+            vorrq_u8(vcltq_s8(vreinterpretq_s8_u8(characters), space), vceqq_u8(characters, quote)),
+            vorrq_u8(vceqq_u8(characters, backslash), vceqq_u8(characters, slash)));
+        if (vmaxvq_u8(special) != 0)
+        {
+            /*the scalar loop below finds which one it is*/
+            break;
+        }
+        pos += 16;
+    }
+#endif
+
+    while ((pos < length) && (json_escapes[(unsigned char)source[pos]] == 0))
+    {
+        pos++;
+    }
+
+    return pos;
+}
+
+/*strings shorter than this (the '\0' included) are kept in the STRING allocation itself, so that they need a single malloc*/
+#define STRING_INLINE_SIZE 24
+
 typedef struct STRING_TAG
 {
-    char* s;
+    char* s;            /* either inline_buffer or a heap allocation */
+    size_t length;      /* strlen(s), kept so that no operation needs to scan s */
+    size_t capacity;    /* bytes available in s, the '\0' included */
+    ARENA_HANDLE arena; /* the arena the STRING and s come from, NULL for the heap */
+    char inline_buffer[STRING_INLINE_SIZE];
 }STRING;
 
-/*this function will allocate a new string with just '\0' in it*/
-/*return NULL if it fails*/
-/* Codes_SRS_STRING_07_001: [STRING_new shall allocate a new STRING_HANDLE pointing to an empty string.] */
-STRING_HANDLE STRING_new(void)
+#define IS_INLINE(str) ((str)->s == (str)->inline_buffer)
+
+/*small strings grow by this many characters at least, so that building them does not reallocate on every append*/
+#define STRING_MIN_GROWTH 32
+
+/*the memory of s goes through these, so that a string created in an arena never touches the heap*/
+static void* string_malloc(STRING* str, size_t size)
 {
-    STRING* result;
-    if ((result = (STRING*)malloc(sizeof(STRING))) != NULL)
+    return (str->arena == NULL) ? malloc(size) : ARENA_malloc(str->arena, size);
+}
+
+static void* string_realloc(STRING* str, void* ptr, size_t size)
+{
+    return (str->arena == NULL) ? realloc(ptr, size) : ARENA_realloc(str->arena, ptr, size);
+}
+
+static void string_free(STRING* str, void* ptr)
+{
+    if (str->arena == NULL)
+    {
+        free(ptr);
+    }
+    else
+    {
+        ARENA_free(str->arena, ptr);
+    }
+}
+
+static void free_string_handle(STRING* str)
+{
+    if (str->arena == NULL)
+    {
+        SLABALLOC_FREE(str);
+    }
+    else
+    {
+        ARENA_free(str->arena, str);
+    }
+}
+
+/*allocates a STRING that has room for length characters and the '\0', from arena or from the heap when arena is NULL. The characters are not initialized*/
+static STRING* create_string(ARENA_HANDLE arena, size_t length)
+{
+    STRING* result = (STRING*)((arena == NULL) ? SLABALLOC_MALLOC(sizeof(STRING)) : ARENA_malloc(arena, sizeof(STRING)));
+    if (result == NULL)
+    {
+        LogError("unable to allocate STRING");
+    }
+    else
     {
-        if ((result->s = (char*)malloc(1)) != NULL)
+        result->arena = arena;
+
+        if (length < STRING_INLINE_SIZE)
         {
-            result->s[0] = '\0';
+            result->s = result->inline_buffer;
+            result->length = length;
+            result->capacity = STRING_INLINE_SIZE;
         }
-        else
+        else if ((length == SIZE_MAX) ||
+            ((result->s = (char*)string_malloc(result, length + 1)) == NULL))
         {
-            /* Codes_SRS_STRING_07_002: [STRING_new shall return an NULL STRING_HANDLE on any error that is encountered.] */
-            free(result);
+            LogError("unable to allocate %lu characters", (unsigned long)length);
+            free_string_handle(result);
             result = NULL;
         }
+        else
+        {
+            result->length = length;
+            result->capacity = length + 1;
+        }
+    }
+
+    return result;
+}
+
+/*moves the content of str to a heap allocation of new_capacity bytes, or resizes the one it has*/
+static int resize_heap(STRING* str, size_t new_capacity)
+{
+    int result;
+    char* temp;
+
+    if (IS_INLINE(str))
+    {
+        temp = (char*)string_malloc(str, new_capacity);
+        if (temp != NULL)
+        {
+            (void)memcpy(temp, str->s, str->length + 1);
+        }
+    }
+    else
+    {
+        temp = (char*)string_realloc(str, str->s, new_capacity);
+    }
+
+    if (temp == NULL)
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        str->s = temp;
+        str->capacity = new_capacity;
+        result = 0;
+    }
+
+    return result;
+}
+
+/*makes room in str for length characters (the '\0' not included). When it needs to reallocate, the memory grows by at least half
+of its size, so that a string built by appending small pieces is reallocated a logarithmic number of times*/
+static int ensure_capacity(STRING* str, size_t length)
+{
+    int result;
+
+    if (length < str->capacity)
+    {
+        result = 0;
+    }
+    else if (length == SIZE_MAX)
+    {
+        LogError("string too long");
+        result = __FAILURE__;
+    }
+    else
+    {
+        size_t growth = (str->capacity / 2 < STRING_MIN_GROWTH) ? STRING_MIN_GROWTH : (str->capacity / 2);
+        size_t new_capacity = str->capacity + growth;
+
+        if ((new_capacity < str->capacity) || (new_capacity <= length))
+        {
+            new_capacity = length + 1;
+        }
+
+        if (resize_heap(str, new_capacity) != 0)
+        {
+            LogError("unable to reallocate memory");
+            result = __FAILURE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+
+    return result;
+}
+
+static int append_chars(STRING* str, const char* s2, size_t s2Length)
+{
+    int result;
+
+    if (s2Length == 0)
+    {
+        result = 0;
+    }
+    else if ((s2Length >= SIZE_MAX - str->length) ||
+        (ensure_capacity(str, str->length + s2Length) != 0))
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        (void)memcpy(str->s + str->length, s2, s2Length);
+        str->length += s2Length;
+        str->s[str->length] = '\0';
+        result = 0;
+    }
+
+    return result;
+}
+
+/*appends source (length characters) to str as a quoted JSON string, escaping the characters that need it as it copies them.
+Room is made for the characters as they are, and grows when an escape sequence is found. On failure str is left unchanged*/
+static int append_JSON(STRING* str, const char* source, size_t length)
+{
+    int result;
+    size_t original_length = str->length;
+
+    if ((length >= SIZE_MAX - 2 - str->length) ||
+        (ensure_capacity(str, str->length + length + 2) != 0))
+    {
+        result = __FAILURE__;
+    }
+    else
+    {
+        size_t pos = 0;
+        result = 0;
+
+        /*Codes_SRS_STRING_02_012: [The string shall begin with the quote character.] */
+        str->s[str->length++] = '"';
+        while ((result == 0) && (pos < length))
+        {
+            /*Codes_SRS_STRING_02_013: [The string shall copy the characters of source "as they are" (until the '\0' character) with the following exceptions:] */
+            size_t plain = json_plain_length(source + pos, length - pos);
+            (void)memcpy(str->s + str->length, source + pos, plain);
+            str->length += plain;
+            pos += plain;
+
+            if (pos < length)
+            {
+                unsigned char c = (unsigned char)source[pos];
+                signed char escape = json_escapes[c];
+                size_t escape_length = (escape == 'u') ? 6 : 2;
+
+                if (escape == JSON_INVALID_CHARACTER)
+                {
+                    /*Codes_SRS_STRING_02_014: [If any character has the value outside [1...127] then STRING_new_JSON shall fail and return NULL.] */
+                    LogError("invalid character in input string");
+                    result = __FAILURE__;
+                }
+                /*the escape sequence, the characters after it as they are and the closing quote*/
+                else if ((escape_length + (length - pos) >= SIZE_MAX - str->length) ||
+                    (ensure_capacity(str, str->length + escape_length + (length - pos - 1) + 1) != 0))
+                {
+                    result = __FAILURE__;
+                }
+                else
+                {
+                    str->s[str->length++] = '\\';
+                    if (escape == 'u')
+                    {
+                        /*Codes_SRS_STRING_02_019: [If the character code is less than 0x20 then it shall be represented as \u00xx, where xx is the hex representation of the character code.]*/
+                        str->s[str->length++] = 'u';
+                        str->s[str->length++] = '0';
+                        str->s[str->length++] = '0';
+                        str->s[str->length++] = hexToASCII[(c & 0xF0) >> 4]; /*high nibble*/
+                        str->s[str->length++] = hexToASCII[c & 0x0F]; /*low nibble*/
+                    }
+                    else
+                    {
+                        /*Codes_SRS_STRING_02_016: [If the character is " (quote) then it shall be repsented as \".] */
+                        /*Codes_SRS_STRING_02_017: [If the character is \ (backslash) then it shall represented as \\.] */
+                        /*Codes_SRS_STRING_02_018: [If the character is / (slash) then it shall be represented as \/.] */
+                        str->s[str->length++] = (char)escape;
+                    }
+                    pos++;
+                }
+            }
+        }
+
+        if (result == 0)
+        {
+            /*Codes_SRS_STRING_02_020: [The string shall end with " (quote).] */
+            str->s[str->length++] = '"';
+        }
+        else
+        {
+            str->length = original_length;
+        }
+        str->s[str->length] = '\0';
+    }
+
+    return result;
+}
+
+/*sizes s to exactly length + 1 bytes, which is what the operations that replace the whole content do. A short string
+goes back to the inline buffer, keeping the characters that fit there*/
+static int set_exact_capacity(STRING* str, size_t length)
+{
+    int result;
+
+    if (length < STRING_INLINE_SIZE)
+    {
+        if (!IS_INLINE(str))
+        {
+            size_t kept = (str->capacity < STRING_INLINE_SIZE) ? str->capacity : STRING_INLINE_SIZE;
+            (void)memcpy(str->inline_buffer, str->s, kept);
+            string_free(str, str->s);
+            str->s = str->inline_buffer;
+            str->capacity = STRING_INLINE_SIZE;
+        }
+        result = 0;
+    }
+    else
+    {
+        result = resize_heap(str, length + 1);
+    }
+
+    return result;
+}
+
+/*this function will allocate a new string with just '\0' in it*/
+/*return NULL if it fails*/
+/* Codes_SRS_STRING_07_001: [STRING_new shall allocate a new STRING_HANDLE pointing to an empty string.] */
+STRING_HANDLE STRING_new(void)
+{
+    STRING* result;
+    /* Codes_SRS_STRING_07_002: [STRING_new shall return an NULL STRING_HANDLE on any error that is encountered.] */
+    if ((result = create_string(NULL, 0)) != NULL)
+    {
+        result->s[0] = '\0';
     }
     return (STRING_HANDLE)result;
 }
@@ -59,25 +437,12 @@ STRING_HANDLE STRING_clone(STRING_HANDLE handle)
     }
     else
     {
+        STRING* source = (STRING*)handle;
         /*Codes_SRS_STRING_02_003: [If STRING_clone fails for any reason, it shall return NULL.] */
-        if ((result = (STRING*)malloc(sizeof(STRING))) != NULL)
-        {
-            STRING* source = (STRING*)handle;
-            /*Codes_SRS_STRING_02_003: [If STRING_clone fails for any reason, it shall return NULL.] */
-            size_t sourceLen = strlen(source->s);
-            if ((result->s = (char*)malloc(sourceLen + 1)) == NULL)
-            {
-                free(result);
-                result = NULL;
-            }
-            else
-            {
-                (void)memcpy(result->s, source->s, sourceLen + 1);
-            }
-        }
-        else
+        /*Codes_SRS_STRING_01_018: [ The clone of a string created in an arena shall be allocated from the heap, it does not depend on the arena. ]*/
+        if ((result = create_string(NULL, source->length)) != NULL)
         {
-            /*not much to do, result is NULL from malloc*/
+            (void)memcpy(result->s, source->s, source->length + 1);
         }
     }
     return (STRING_HANDLE)result;
@@ -94,21 +459,12 @@ STRING_HANDLE STRING_construct(const char* psz)
     }
     else
     {
+        size_t nLen = strlen(psz);
         STRING* str;
-        if ((str = (STRING*)malloc(sizeof(STRING))) != NULL)
+        if ((str = create_string(NULL, nLen)) != NULL)
         {
-            size_t nLen = strlen(psz) + 1;
-            if ((str->s = (char*)malloc(nLen)) != NULL)
-            {
-                (void)memcpy(str->s, psz, nLen);
-                result = (STRING_HANDLE)str;
-            }
-            /* Codes_SRS_STRING_07_032: [STRING_construct encounters any error it shall return a NULL value.] */
-            else
-            {
-                free(str);
-                result = NULL;
-            }
+            (void)memcpy(str->s, psz, nLen + 1);
+            result = (STRING_HANDLE)str;
         }
         else
         {
@@ -119,6 +475,55 @@ STRING_HANDLE STRING_construct(const char* psz)
     return result;
 }
 
+STRING_HANDLE STRING_new_in_arena(ARENA_HANDLE arena)
+{
+    STRING* result;
+    if (arena == NULL)
+    {
+        /*Codes_SRS_STRING_01_014: [ If `arena` is NULL, `STRING_new_in_arena` shall fail and return NULL. ]*/
+        LogError("Invalid argument: arena=NULL");
+        result = NULL;
+    }
+    /*Codes_SRS_STRING_01_015: [ `STRING_new_in_arena` shall allocate a new empty string with `ARENA_malloc`, all the memory the string needs later shall also be allocated, grown and freed with `ARENA_malloc`, `ARENA_realloc` and `ARENA_free`. ]*/
+    else if ((result = create_string(arena, 0)) == NULL)
+    {
+        /*Codes_SRS_STRING_01_016: [ If allocating the memory fails, `STRING_new_in_arena` shall fail and return NULL. ]*/
+        LogError("unable to create the string in the arena");
+    }
+    else
+    {
+        result->s[0] = '\0';
+    }
+    return (STRING_HANDLE)result;
+}
+
+STRING_HANDLE STRING_construct_in_arena(ARENA_HANDLE arena, const char* psz)
+{
+    STRING* result;
+    if ((arena == NULL) ||
+        (psz == NULL))
+    {
+        /*Codes_SRS_STRING_01_019: [ If `arena` or `psz` is NULL, `STRING_construct_in_arena` shall fail and return NULL. ]*/
+        LogError("Invalid arguments: arena=%p, psz=%p", arena, psz);
+        result = NULL;
+    }
+    else
+    {
+        size_t length = strlen(psz);
+        /*Codes_SRS_STRING_01_020: [ `STRING_construct_in_arena` shall create a string with the value of `psz` the way `STRING_new_in_arena` does. ]*/
+        if ((result = create_string(arena, length)) == NULL)
+        {
+            /*Codes_SRS_STRING_01_021: [ If allocating the memory fails, `STRING_construct_in_arena` shall fail and return NULL. ]*/
+            LogError("unable to create the string in the arena");
+        }
+        else
+        {
+            (void)memcpy(result->s, psz, length + 1);
+        }
+    }
+    return (STRING_HANDLE)result;
+}
+
 #if defined(__GNUC__)
 __attribute__ ((format (printf, 1, 2)))
 #endif
@@ -145,33 +550,22 @@ STRING_HANDLE STRING_construct_sprintf(const char* format, ...)
         va_end(arg_list);
         if (length > 0)
         {
-            result = (STRING*)malloc(sizeof(STRING));
+            result = create_string(NULL, (size_t)length);
             if (result != NULL)
             {
-                result->s = (char*)malloc(length+1);
-                if (result->s != NULL)
-                {
-                    va_start(arg_list, format);
-                    if (vsnprintf(result->s, length+1, format, arg_list) < 0)
-                    {
-                        /* Codes_SRS_STRING_07_040: [If any error is encountered STRING_construct_sprintf shall return NULL.] */
-                        free(result->s);
-                        free(result);
-                        result = NULL;
-                        LogError("Failure: vsnprintf formatting failed.");
-                    }
-                    va_end(arg_list);
-                }
-                else
+                va_start(arg_list, format);
+                if (vsnprintf(result->s, length+1, format, arg_list) < 0)
                 {
                     /* Codes_SRS_STRING_07_040: [If any error is encountered STRING_construct_sprintf shall return NULL.] */
-                    free(result);
+                    STRING_delete((STRING_HANDLE)result);
                     result = NULL;
-                    LogError("Failure: allocation failed.");
+                    LogError("Failure: vsnprintf formatting failed.");
                 }
+                va_end(arg_list);
             }
             else
             {
+                /* Codes_SRS_STRING_07_040: [If any error is encountered STRING_construct_sprintf shall return NULL.] */
                 LogError("Failure: allocation failed.");
             }
         }
@@ -209,9 +603,13 @@ STRING_HANDLE STRING_new_with_memory(const char* memory)
     }
     else
     {
-        if ((result = (STRING*)malloc(sizeof(STRING))) != NULL)
+        if ((result = (STRING*)SLABALLOC_MALLOC(sizeof(STRING))) != NULL)
         {
             result->s = (char*)memory;
+            result->arena = NULL;
+            result->length = strlen(memory);
+            /*the memory could be larger, but this is all that is known*/
+            result->capacity = result->length + 1;
         }
     }
     return (STRING_HANDLE)result;
@@ -226,22 +624,17 @@ STRING_HANDLE STRING_new_quoted(const char* source)
         /* Codes_SRS_STRING_07_009: [STRING_new_quoted shall return a NULL STRING_HANDLE if the supplied const char* is NULL.] */
         result = NULL;
     }
-    else if ((result = (STRING*)malloc(sizeof(STRING))) != NULL)
+    else
     {
         size_t sourceLength = strlen(source);
-        if ((result->s = (char*)malloc(sourceLength + 3)) != NULL)
+        /* Codes_SRS_STRING_07_031: [STRING_new_quoted shall return a NULL STRING_HANDLE if any error is encountered.] */
+        if ((result = create_string(NULL, sourceLength + 2)) != NULL)
         {
             result->s[0] = '"';
             (void)memcpy(result->s + 1, source, sourceLength);
             result->s[sourceLength + 1] = '"';
             result->s[sourceLength + 2] = '\0';
         }
-        else
-        {
-            /* Codes_SRS_STRING_07_031: [STRING_new_quoted shall return a NULL STRING_HANDLE if any error is encountered.] */
-            free(result);
-            result = NULL;
-        }
     }
     return (STRING_HANDLE)result;
 }
@@ -260,102 +653,25 @@ STRING_HANDLE STRING_new_JSON(const char* source)
     }
     else
     {
-        size_t i;
-        size_t nControlCharacters = 0; /*counts how many characters are to be expanded from 1 character to \uxxxx (6 characters)*/
-        size_t nEscapeCharacters = 0;
         size_t vlen = strlen(source);
 
-        for (i = 0; i < vlen; i++)
+        /*room for the characters as they are and the quotes, most strings need no escaping*/
+        if ((result = create_string(NULL, vlen + 2)) == NULL)
         {
-            /*Codes_SRS_STRING_02_014: [If any character has the value outside [1...127] then STRING_new_JSON shall fail and return NULL.] */
-            if ((unsigned char)source[i] >= 128) /*this be a UNICODE character begin*/
-            {
-                break;
-            }
-            else
-            {
-                if (source[i] <= 0x1F)
-                {
-                    nControlCharacters++;
-                }
-                else if (
-                    (source[i] == '"') ||
-                    (source[i] == '\\') ||
-                    (source[i] == '/')
-                    )
-                {
-                    nEscapeCharacters++;
-                }
-            }
-        }
-
-        if (i < vlen)
-        {
-            result = NULL;
-            LogError("invalid character in input string");
+            /*Codes_SRS_STRING_02_021: [If the complete JSON representation cannot be produced, then STRING_new_JSON shall fail and return NULL.] */
+            LogError("malloc failure");
         }
         else
         {
-            if ((result = (STRING*)malloc(sizeof(STRING))) == NULL)
-            {
-                /*Codes_SRS_STRING_02_021: [If the complete JSON representation cannot be produced, then STRING_new_JSON shall fail and return NULL.] */
-                LogError("malloc failure");
-            }
-            else if ((result->s = (char*)malloc(vlen + 5 * nControlCharacters + nEscapeCharacters + 3)) == NULL)
+            result->length = 0;
+            if (append_JSON(result, source, vlen) != 0)
             {
                 /*Codes_SRS_STRING_02_021: [If the complete JSON representation cannot be produced, then STRING_new_JSON shall fail and return NULL.] */
-                free(result);
+                LogError("unable to produce the JSON representation");
+                STRING_delete((STRING_HANDLE)result);
                 result = NULL;
-                LogError("malloc failed");
-            }
-            else
-            {
-                size_t pos = 0;
-                /*Codes_SRS_STRING_02_012: [The string shall begin with the quote character.] */
-                result->s[pos++] = '"';
-                for (i = 0; i < vlen; i++)
-                {
-                    if (source[i] <= 0x1F)
-                    {
-                        /*Codes_SRS_STRING_02_019: [If the character code is less than 0x20 then it shall be represented as \u00xx, where xx is the hex representation of the character code.]*/
-                        result->s[pos++] = '\\';
-                        result->s[pos++] = 'u';
-                        result->s[pos++] = '0';
-                        result->s[pos++] = '0';
-                        result->s[pos++] = hexToASCII[(source[i] & 0xF0) >> 4]; /*high nibble*/
-                        result->s[pos++] = hexToASCII[source[i] & 0x0F]; /*low nibble*/
-                    }
-                    else if (source[i] == '"')
-                    {
-                        /*Codes_SRS_STRING_02_016: [If the character is " (quote) then it shall be repsented as \".] */
-                        result->s[pos++] = '\\';
-                        result->s[pos++] = '"';
-                    }
-                    else if (source[i] == '\\')
-                    {
-                        /*Codes_SRS_STRING_02_017: [If the character is \ (backslash) then it shall represented as \\.] */
-                        result->s[pos++] = '\\';
-                        result->s[pos++] = '\\';
-                    }
-                    else if (source[i] == '/')
-                    {
-                        /*Codes_SRS_STRING_02_018: [If the character is / (slash) then it shall be represented as \/.] */
-                        result->s[pos++] = '\\';
-                        result->s[pos++] = '/';
-                    }
-                    else
-                    {
-                        /*Codes_SRS_STRING_02_013: [The string shall copy the characters of source "as they are" (until the '\0' character) with the following exceptions:] */
-                        result->s[pos++] = source[i];
-                    }
-                }
-                /*Codes_SRS_STRING_02_020: [The string shall end with " (quote).] */
-                result->s[pos++] = '"';
-                /*zero terminating it*/
-                result->s[pos] = '\0';
             }
         }
-
     }
     return (STRING_HANDLE)result;
 }
@@ -375,18 +691,13 @@ int STRING_concat(STRING_HANDLE handle, const char* s2)
     else
     {
         STRING* s1 = (STRING*)handle;
-        size_t s1Length = strlen(s1->s);
-        size_t s2Length = strlen(s2);
-        char* temp = (char*)realloc(s1->s, s1Length + s2Length + 1);
-        if (temp == NULL)
+        if (append_chars(s1, s2, strlen(s2)) != 0)
         {
             /* Codes_SRS_STRING_07_013: [STRING_concat shall return a nonzero number if an error is encountered.] */
             result = __FAILURE__;
         }
         else
         {
-            s1->s = temp;
-            (void)memcpy(s1->s + s1Length, s2, s2Length + 1);
             result = 0;
         }
     }
@@ -409,20 +720,111 @@ int STRING_concat_with_STRING(STRING_HANDLE s1, STRING_HANDLE s2)
     {
         STRING* dest = (STRING*)s1;
         STRING* src = (STRING*)s2;
+        size_t s2Length = src->length;
 
-        size_t s1Length = strlen(dest->s);
-        size_t s2Length = strlen(src->s);
-        char* temp = (char*)realloc(dest->s, s1Length + s2Length + 1);
-        if (temp == NULL)
+        /*the memory is grown before src->s is read, because src can be dest*/
+        if ((s2Length >= SIZE_MAX - dest->length) ||
+            (ensure_capacity(dest, dest->length + s2Length) != 0))
         {
             /* Codes_SRS_STRING_07_035: [String_Concat_with_STRING shall return a nonzero number if an error is encountered.] */
             result = __FAILURE__;
         }
         else
         {
-            dest->s = temp;
             /* Codes_SRS_STRING_07_034: [String_Concat_with_STRING shall concatenate a given STRING_HANDLE variable with a source STRING_HANDLE.] */
-            (void)memcpy(dest->s + s1Length, src->s, s2Length + 1);
+            (void)memcpy(dest->s + dest->length, src->s, s2Length);
+            dest->length += s2Length;
+            dest->s[dest->length] = '\0';
+            result = 0;
+        }
+    }
+    return result;
+}
+
+/*this function will append to the string s1 the first n characters of s2, s2 does not need to be null terminated*/
+/*returns 0 if success*/
+/*any other error code is failure*/
+int STRING_concat_n(STRING_HANDLE handle, const char* s2, size_t n)
+{
+    int result;
+    if ((handle == NULL) || ((s2 == NULL) && (n > 0)))
+    {
+        /* Codes_SRS_STRING_01_001: [ If `handle` is NULL, or `s2` is NULL while `n` is not 0, `STRING_concat_n` shall fail and return a non-zero value. ]*/
+        LogError("invalid parameter handle=%p, s2=%p, n=%lu", handle, s2, (unsigned long)n);
+        result = __FAILURE__;
+    }
+    else
+    {
+        STRING* s1 = (STRING*)handle;
+        /* Codes_SRS_STRING_01_002: [ `STRING_concat_n` shall append the first `n` characters of `s2` to the string, without looking for a null terminator in `s2`. ]*/
+        /* Codes_SRS_STRING_01_003: [ When the string has to grow, its memory shall grow by at least half of its size and at least 32 characters, so that building a string in `n` appends is linear in its length. ]*/
+        if (append_chars(s1, s2, n) != 0)
+        {
+            /* Codes_SRS_STRING_01_004: [ If any error occurs, `STRING_concat_n` shall fail, leave the string unchanged and return a non-zero value. ]*/
+            result = __FAILURE__;
+        }
+        else
+        {
+            /* Codes_SRS_STRING_01_005: [ On success `STRING_concat_n` shall return 0. ]*/
+            result = 0;
+        }
+    }
+    return result;
+}
+
+int STRING_concat_JSON(STRING_HANDLE handle, const char* source)
+{
+    int result;
+    if ((handle == NULL) || (source == NULL))
+    {
+        /* Codes_SRS_STRING_01_011: [ If `handle` or `source` is NULL, `STRING_concat_JSON` shall fail and return a non-zero value. ]*/
+        LogError("invalid parameter (NULL)");
+        result = __FAILURE__;
+    }
+    else if (append_JSON((STRING*)handle, source, strlen(source)) != 0)
+    {
+        /* Codes_SRS_STRING_01_013: [ If `source` has a character outside [1...127] or allocating memory fails, `STRING_concat_JSON` shall fail, leave the string unchanged and return a non-zero value. ]*/
+        LogError("unable to append the JSON representation");
+        result = __FAILURE__;
+    }
+    else
+    {
+        /* Codes_SRS_STRING_01_012: [ `STRING_concat_JSON` shall append to the string the JSON representation of `source`, as produced by `STRING_new_JSON`, and return 0. ]*/
+        result = 0;
+    }
+    return result;
+}
+
+/*this function will make sure that the string can grow to capacity characters without allocating memory*/
+/*returns 0 if success*/
+/*any other error code is failure*/
+int STRING_reserve(STRING_HANDLE handle, size_t capacity)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_STRING_01_006: [ If `handle` is NULL, `STRING_reserve` shall fail and return a non-zero value. ]*/
+        LogError("invalid parameter (NULL)");
+        result = __FAILURE__;
+    }
+    else
+    {
+        STRING* s1 = (STRING*)handle;
+        if (capacity < s1->capacity)
+        {
+            /* Codes_SRS_STRING_01_007: [ If the string can already hold `capacity` characters, `STRING_reserve` shall not allocate memory and shall return 0. ]*/
+            result = 0;
+        }
+        else if ((capacity == SIZE_MAX) ||
+            (set_exact_capacity(s1, capacity) != 0))
+        {
+            /* Codes_SRS_STRING_01_009: [ If allocating the memory fails, `STRING_reserve` shall fail, leave the string unchanged and return a non-zero value. ]*/
+            LogError("unable to reserve %lu characters", (unsigned long)capacity);
+            result = __FAILURE__;
+        }
+        else
+        {
+            /* Codes_SRS_STRING_01_008: [ Otherwise `STRING_reserve` shall reallocate the string so that it can hold `capacity` characters plus the null terminator, keeping its content, and return 0. ]*/
             result = 0;
         }
     }
@@ -448,16 +850,15 @@ int STRING_copy(STRING_HANDLE handle, const char* s2)
         if (s1->s != s2)
         {
             size_t s2Length = strlen(s2);
-            char* temp = (char*)realloc(s1->s, s2Length + 1);
-            if (temp == NULL)
+            if (set_exact_capacity(s1, s2Length) != 0)
             {
                 /* Codes_SRS_STRING_07_027: [STRING_copy shall return a nonzero value if any error is encountered.] */
                 result = __FAILURE__;
             }
             else
             {
-                s1->s = temp;
                 memmove(s1->s, s2, s2Length + 1);
+                s1->length = s2Length;
                 result = 0;
             }
         }
@@ -485,24 +886,20 @@ int STRING_copy_n(STRING_HANDLE handle, const char* s2, size_t n)
     else
     {
         STRING* s1 = (STRING*)handle;
-        size_t s2Length = strlen(s2);
-        char* temp;
-        if (s2Length > n)
-        {
-            s2Length = n;
-        }
+        /*s2 does not need to be null terminated when it has n characters or more*/
+        const char* s2End = (const char*)memchr(s2, '\0', n);
+        size_t s2Length = (s2End == NULL) ? n : (size_t)(s2End - s2);
 
-        temp = (char*)realloc(s1->s, s2Length + 1);
-        if (temp == NULL)
+        if (set_exact_capacity(s1, s2Length) != 0)
         {
             /* Codes_SRS_STRING_07_028: [STRING_copy_n shall return a nonzero value if any error is encountered.] */
             result = __FAILURE__;
         }
         else
         {
-            s1->s = temp;
             (void)memcpy(s1->s, s2, s2Length);
             s1->s[s2Length] = 0;
+            s1->length = s2Length;
             result = 0;
         }
 
@@ -553,14 +950,12 @@ int STRING_sprintf(STRING_HANDLE handle, const char* format, ...)
         else
         {
             STRING* s1 = (STRING*)handle;
-			char* temp;
-            size_t s1Length = strlen(s1->s);
-            temp = (char*)realloc(s1->s, s1Length + s2Length + 1);
-            if (temp != NULL)
+            size_t s1Length = s1->length;
+            if (((size_t)s2Length < SIZE_MAX - s1Length) &&
+                (ensure_capacity(s1, s1Length + s2Length) == 0))
             {
-                s1->s = temp;
                 va_start(arg_list, format);
-                if (vsnprintf(s1->s + s1Length, s1Length + s2Length + 1, format, arg_list) < 0)
+                if (vsnprintf(s1->s + s1Length, (size_t)s2Length + 1, format, arg_list) < 0)
                 {
                     /* Codes_SRS_STRING_07_043: [If any error is encountered STRING_sprintf shall return a non zero value.] */
                     LogError("Failure vsnprintf formatting error");
@@ -570,6 +965,7 @@ int STRING_sprintf(STRING_HANDLE handle, const char* format, ...)
                 else
                 {
                     /* Codes_SRS_STRING_07_044: [On success STRING_sprintf shall return 0.]*/
+                    s1->length = s1Length + s2Length;
                     result = 0;
                 }
                 va_end(arg_list);
@@ -600,20 +996,20 @@ int STRING_quote(STRING_HANDLE handle)
     else
     {
         STRING* s1 = (STRING*)handle;
-        size_t s1Length = strlen(s1->s);
-        char* temp = (char*)realloc(s1->s, s1Length + 2 + 1);/*2 because 2 quotes, 1 because '\0'*/
-        if (temp == NULL)
+        size_t s1Length = s1->length;
+        if ((s1->capacity < s1Length + 2 + 1) && /*2 because 2 quotes, 1 because '\0'*/
+            (set_exact_capacity(s1, s1Length + 2) != 0))
         {
             /* Codes_SRS_STRING_07_029: [STRING_quote shall return a nonzero value if any error is encountered.] */
             result = __FAILURE__;
         }
         else
         {
-            s1->s = temp;
             memmove(s1->s + 1, s1->s, s1Length);
             s1->s[0] = '"';
             s1->s[s1Length + 1] = '"';
             s1->s[s1Length + 2] = '\0';
+            s1->length = s1Length + 2;
             result = 0;
         }
     }
@@ -633,16 +1029,15 @@ int STRING_empty(STRING_HANDLE handle)
     else
     {
         STRING* s1 = (STRING*)handle;
-        char* temp = (char*)realloc(s1->s, 1);
-        if (temp == NULL)
+        if (set_exact_capacity(s1, 0) != 0)
         {
             /* Codes_SRS_STRING_07_030: [STRING_empty shall return a nonzero value if the STRING_HANDLE is NULL.] */
             result = __FAILURE__;
         }
         else
         {
-            s1->s = temp;
             s1->s[0] = '\0';
+            s1->length = 0;
             result = 0;
         }
     }
@@ -657,9 +1052,13 @@ void STRING_delete(STRING_HANDLE handle)
     if (handle != NULL)
     {
         STRING* value = (STRING*)handle;
-        free(value->s);
+        if (!IS_INLINE(value))
+        {
+            string_free(value, value->s);
+        }
         value->s = NULL;
-        free(value);
+        /*Codes_SRS_STRING_01_017: [ If the string was created in an arena, `STRING_delete` shall give its memory back with `ARENA_free`. ]*/
+        free_string_handle(value);
     }
 }
 
@@ -687,7 +1086,7 @@ size_t STRING_length(STRING_HANDLE handle)
     if (handle != NULL)
     {
         STRING* value = (STRING*)handle;
-        result = strlen(value->s);
+        result = value->length;
     }
     return result;
 }
@@ -714,20 +1113,11 @@ STRING_HANDLE STRING_construct_n(const char* psz, size_t n)
         else
         {
             STRING* str;
-            if ((str = (STRING*)malloc(sizeof(STRING))) != NULL)
+            if ((str = create_string(NULL, n)) != NULL)
             {
-                if ((str->s = (char*)malloc(len + 1)) != NULL)
-                {
-                    (void)memcpy(str->s, psz, n);
-                    str->s[n] = '\0';
-                    result = (STRING_HANDLE)str;
-                }
-                /* Codes_SRS_STRING_02_010: [In all other error cases, STRING_construct_n shall return NULL.]  */
-                else
-                {
-                    free(str);
-                    result = NULL;
-                }
+                (void)memcpy(str->s, psz, n);
+                str->s[n] = '\0';
+                result = (STRING_HANDLE)str;
             }
             else
             {
@@ -780,7 +1170,7 @@ STRING_HANDLE STRING_from_byte_array(const unsigned char* source, size_t size)
     else
     {
         /*Codes_SRS_STRING_02_023: [ Otherwise, STRING_from_BUFFER shall build a string that has the same content (byte-by-byte) as source and return a non-NULL handle. ]*/
-        result = (STRING*)malloc(sizeof(STRING));
+        result = create_string(NULL, size);
         if (result == NULL)
         {
             /*Codes_SRS_STRING_02_024: [ If building the string fails, then STRING_from_BUFFER shall fail and return NULL. ]*/
@@ -789,20 +1179,13 @@ STRING_HANDLE STRING_from_byte_array(const unsigned char* source, size_t size)
         }
         else
         {
-            /*Codes_SRS_STRING_02_023: [ Otherwise, STRING_from_BUFFER shall build a string that has the same content (byte-by-byte) as source and return a non-NULL handle. ]*/
-            result->s = (char*)malloc(size + 1);
-            if (result->s == NULL)
-            {
-                /*Codes_SRS_STRING_02_024: [ If building the string fails, then STRING_from_BUFFER shall fail and return NULL. ]*/
-                LogError("oom - unable to malloc");
-                free(result);
-                result = NULL;
-            }
-            else
+            if (size > 0)
             {
                 (void)memcpy(result->s, source, size);
-                result->s[size] = '\0'; /*all is fine*/
             }
+            result->s[size] = '\0'; /*all is fine*/
+            /*a '\0' in source ends the string, as it always did*/
+            result->length = strlen(result->s);
         }
     }
     return (STRING_HANDLE)result;
@@ -62,8 +62,10 @@ struct CRYPTO_dynlock_value
     LOCK_HANDLE lock; 
 };
 
-/*this function will clone an option given by name and value*/
-static void* tlsio_openssl_CloneOption(const char* name, const void* value)
+static int tlsio_openssl_setoption_by_id(CONCRETE_IO_HANDLE tls_io, OPTION_ID id, const char* optionName, const void* value);
+
+/*this function will clone an option given by its id, name and value*/
+static void* tlsio_openssl_CloneOption(OPTION_ID id, const char* name, const void* value)
 {
     void* result;
     if(
@@ -75,85 +77,41 @@ static void* tlsio_openssl_CloneOption(const char* name, const void* value)
     }
     else
     {
-        if (strcmp(name, "TrustedCerts") == 0)
-        {
-            if(mallocAndStrcpy_s((char**)&result, value) != 0)
-            {
-                LogError("unable to mallocAndStrcpy_s TrustedCerts value");
-                result = NULL;
-            }
-            else
-            {
-                /*return as is*/
-            }
-        }
-        else if (strcmp(name, SU_OPTION_X509_CERT) == 0)
-        {
-            if (mallocAndStrcpy_s((char**)&result, value) != 0)
-            {
-                LogError("unable to mallocAndStrcpy_s x509certificate value");
-                result = NULL;
-            }
-            else
-            {
-                /*return as is*/
-            }
-        }
-        else if (strcmp(name, SU_OPTION_X509_PRIVATE_KEY) == 0)
-        {
-            if (mallocAndStrcpy_s((char**)&result, value) != 0)
-            {
-                LogError("unable to mallocAndStrcpy_s x509privatekey value");
-                result = NULL;
-            }
-            else
-            {
-                /*return as is*/
-            }
-        }
-        else if (strcmp(name, OPTION_X509_ECC_CERT) == 0)
+        switch (id)
         {
+        case OPTION_ID_TRUSTED_CERT:
+        case OPTION_ID_X509_CERT:
+        case OPTION_ID_X509_PRIVATE_KEY:
+        case OPTION_ID_X509_ECC_CERT:
+        case OPTION_ID_X509_ECC_KEY:
             if (mallocAndStrcpy_s((char**)&result, value) != 0)
             {
-                LogError("unable to mallocAndStrcpy_s x509EccCertificate value");
+                LogError("unable to mallocAndStrcpy_s %s value", name);
                 result = NULL;
             }
             else
             {
                 /*return as is*/
             }
-        }
-        else if (strcmp(name, OPTION_X509_ECC_KEY) == 0)
-        {
-            if (mallocAndStrcpy_s((char**)&result, value) != 0)
-            {
-                LogError("unable to mallocAndStrcpy_s x509EccKey value");
-                result = NULL;
-            }
-            else
-            {
-                /*return as is*/
-            }
-        }
-        else if (
-            (strcmp(name, "tls_version") == 0) ||
-            (strcmp(name, "tls_validation_callback") == 0) ||
-            (strcmp(name, "tls_validation_callback_data") == 0)
-            )
-        {
+            break;
+
+        case OPTION_ID_TLS_VERSION:
+        case OPTION_ID_TLS_VALIDATION_CALLBACK:
+        case OPTION_ID_TLS_VALIDATION_CALLBACK_DATA:
             result = (void*)value;
-        }
-        else
-        {
+            break;
+
+        default:
             LogError("not handled option : %s", name);
             result = NULL;
+            break;
         }
     }
     return result;
 }
 
 /*this function destroys an option previously created*/
-static void tlsio_openssl_DestroyOption(const char* name, const void* value)
+static void tlsio_openssl_DestroyOption(OPTION_ID id, const char* name, const void* value)
 {
     /*since all options for this layer are actually string copies., disposing of one is just calling free*/
     if (
@@ -164,27 +122,25 @@ static void tlsio_openssl_DestroyOption(const char* name, const void* value)
     }
     else
     {
-        if (
-            (strcmp(name, "TrustedCerts") == 0) ||
-            (strcmp(name, SU_OPTION_X509_CERT) == 0) ||
-            (strcmp(name, SU_OPTION_X509_PRIVATE_KEY) == 0) ||
-            (strcmp(name, OPTION_X509_ECC_CERT) == 0) ||
-            (strcmp(name, OPTION_X509_ECC_KEY) == 0)
-            )
+        switch (id)
         {
+        case OPTION_ID_TRUSTED_CERT:
+        case OPTION_ID_X509_CERT:
+        case OPTION_ID_X509_PRIVATE_KEY:
+        case OPTION_ID_X509_ECC_CERT:
+        case OPTION_ID_X509_ECC_KEY:
             free((void*)value);
-        }
-        else if (
-            (strcmp(name, "tls_version") == 0) ||
-            (strcmp(name, "tls_validation_callback") == 0) ||
-            (strcmp(name, "tls_validation_callback_data") == 0)
-            )
-        {
+            break;
+
+        case OPTION_ID_TLS_VERSION:
+        case OPTION_ID_TLS_VALIDATION_CALLBACK:
+        case OPTION_ID_TLS_VALIDATION_CALLBACK_DATA:
             // nothing to free.
-        }
-        else
-        {
+            break;
+
+        default:
             LogError("not handled option : %s", name);
+            break;
         }
     }
 }
@@ -199,10 +155,11 @@ static OPTIONHANDLER_HANDLE tlsio_openssl_retrieveoptions(CONCRETE_IO_HANDLE han
     }
     else
     {
-        result = OptionHandler_Create(tlsio_openssl_CloneOption, tlsio_openssl_DestroyOption, tlsio_openssl_setoption);
+        /*the saved options are cloned, destroyed and fed back by id, so none of them compares names*/
+        result = OptionHandler_CreateWithOptionIds(tlsio_openssl_CloneOption, tlsio_openssl_DestroyOption, tlsio_openssl_setoption_by_id);
         if (result == NULL)
         {
-            LogError("unable to OptionHandler_Create");
+            LogError("unable to OptionHandler_CreateWithOptionIds");
             /*return as is*/
         }
         else
@@ -211,7 +168,7 @@ static OPTIONHANDLER_HANDLE tlsio_openssl_retrieveoptions(CONCRETE_IO_HANDLE han
             TLS_IO_INSTANCE* tls_io_instance = (TLS_IO_INSTANCE*)handle;
             if(
                 (tls_io_instance->certificate != NULL) && 
-                (OptionHandler_AddOption(result, "TrustedCerts", tls_io_instance->certificate) != 0)
+                (OptionHandler_AddOption(result, OPTION_TRUSTED_CERT, tls_io_instance->certificate) != 0)
             )
             {
                 LogError("unable to save TrustedCerts option");
@@ -256,7 +213,7 @@ static OPTIONHANDLER_HANDLE tlsio_openssl_retrieveoptions(CONCRETE_IO_HANDLE han
             }
             else if (tls_io_instance->tls_version != 0)
             {
-                if (OptionHandler_AddOption(result, "tls_version", (void*)(intptr_t)tls_io_instance->tls_version) != 0)
+                if (OptionHandler_AddOption(result, OPTION_TLS_VERSION, (void*)(intptr_t)tls_io_instance->tls_version) != 0)
                 {
                     LogError("unable to save tls_version option");
                     OptionHandler_Destroy(result);
@@ -270,14 +227,14 @@ static OPTIONHANDLER_HANDLE tlsio_openssl_retrieveoptions(CONCRETE_IO_HANDLE han
                 void* ptr = tls_io_instance->tls_validation_callback;
                 #pragma warning(pop)
 
-                if (OptionHandler_AddOption(result, "tls_validation_callback", (const char*)ptr) != 0)
+                if (OptionHandler_AddOption(result, OPTION_TLS_VALIDATION_CALLBACK, (const char*)ptr) != 0)
                 {
                     LogError("unable to save tls_validation_callback option");
                     OptionHandler_Destroy(result);
                     result = NULL;
                 }
 
-                if (OptionHandler_AddOption(result, "tls_validation_callback_data", (const char*)tls_io_instance->tls_validation_callback_data) != 0)
+                if (OptionHandler_AddOption(result, OPTION_TLS_VALIDATION_CALLBACK_DATA, (const char*)tls_io_instance->tls_validation_callback_data) != 0)
                 {
                     LogError("unable to save tls_validation_callback_data option");
                     OptionHandler_Destroy(result);
@@ -1293,7 +1250,7 @@ void tlsio_openssl_dowork(CONCRETE_IO_HANDLE tls_io)
     }
 }
 
-int tlsio_openssl_setoption(CONCRETE_IO_HANDLE tls_io, const char* optionName, const void* value)
+static int tlsio_openssl_setoption_by_id(CONCRETE_IO_HANDLE tls_io, OPTION_ID id, const char* optionName, const void* value)
 {
     int result;
 
@@ -1305,7 +1262,9 @@ int tlsio_openssl_setoption(CONCRETE_IO_HANDLE tls_io, const char* optionName, c
     {
         TLS_IO_INSTANCE* tls_io_instance = (TLS_IO_INSTANCE*)tls_io;
 
-        if (strcmp("TrustedCerts", optionName) == 0)
+        switch (id)
+        {
+        case OPTION_ID_TRUSTED_CERT:
         {
             const char* cert = (const char*)value;
 
@@ -1333,8 +1292,9 @@ int tlsio_openssl_setoption(CONCRETE_IO_HANDLE tls_io, const char* optionName, c
             {
                 result = add_certificate_to_store(tls_io_instance, cert);
             }
+            break;
         }
-        else if (strcmp(SU_OPTION_X509_CERT, optionName) == 0)
+        case OPTION_ID_X509_CERT:
         {
             if (tls_io_instance->x509certificate != NULL)
             {
@@ -1354,8 +1314,9 @@ int tlsio_openssl_setoption(CONCRETE_IO_HANDLE tls_io, const char* optionName, c
                     result = 0;
                 }
             }
+            break;
         }
-        else if (strcmp(SU_OPTION_X509_PRIVATE_KEY, optionName) == 0)
+        case OPTION_ID_X509_PRIVATE_KEY:
         {
             if (tls_io_instance->x509privatekey != NULL)
             {
@@ -1375,8 +1336,9 @@ int tlsio_openssl_setoption(CONCRETE_IO_HANDLE tls_io, const char* optionName, c
                     result = 0;
                 }
             }
+            break;
         }
-        else if (strcmp(OPTION_X509_ECC_KEY, optionName) == 0)
+        case OPTION_ID_X509_ECC_KEY:
         {
             if (tls_io_instance->x509_ecc_aliaskey != NULL)
             {
@@ -1401,8 +1363,9 @@ int tlsio_openssl_setoption(CONCRETE_IO_HANDLE tls_io, const char* optionName, c
                     result = 0;
                 }
             }
+            break;
         }
-        else if (strcmp(OPTION_X509_ECC_CERT, optionName) == 0)
+        case OPTION_ID_X509_ECC_CERT:
         {
             if (tls_io_instance->x509_ecc_cert != NULL)
             {
@@ -1427,8 +1390,9 @@ int tlsio_openssl_setoption(CONCRETE_IO_HANDLE tls_io, const char* optionName, c
                     result = 0;
                 }
             }
+            break;
         }
-        else if (strcmp("tls_validation_callback", optionName) == 0)
+        case OPTION_ID_TLS_VALIDATION_CALLBACK:
         {
             #pragma warning(push)
             #pragma warning(disable:4055)
@@ -1441,8 +1405,9 @@ int tlsio_openssl_setoption(CONCRETE_IO_HANDLE tls_io, const char* optionName, c
             }
 
             result = 0;
+            break;
         }
-        else if (strcmp("tls_validation_callback_data", optionName) == 0)
+        case OPTION_ID_TLS_VALIDATION_CALLBACK_DATA:
         {
             tls_io_instance->tls_validation_callback_data = (void*)value;
 
@@ -1452,13 +1417,15 @@ int tlsio_openssl_setoption(CONCRETE_IO_HANDLE tls_io, const char* optionName, c
             }
 
             result = 0;
+            break;
         }
-        else if (strcmp("tls_version", optionName) == 0)
+        case OPTION_ID_TLS_VERSION:
         {
             tls_io_instance->tls_version = (int)(intptr_t)value;
             result = 0;
+            break;
         }
-        else
+        default:
         {
             if (tls_io_instance->underlying_io == NULL)
             {
@@ -1468,12 +1435,19 @@ int tlsio_openssl_setoption(CONCRETE_IO_HANDLE tls_io, const char* optionName, c
             {
                 result = xio_setoption(tls_io_instance->underlying_io, optionName, value);
             }
+            break;
+        }
         }
     }
 
     return result;
 }
 
+int tlsio_openssl_setoption(CONCRETE_IO_HANDLE tls_io, const char* optionName, const void* value)
+{
+    return tlsio_openssl_setoption_by_id(tls_io, OptionHandler_GetOptionId(optionName), optionName, value);
+}
+
 const IO_INTERFACE_DESCRIPTION* tlsio_openssl_get_interface_description(void)
 {
     return &tlsio_openssl_interface_description;
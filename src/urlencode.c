@@ -8,160 +8,358 @@
 #include "azure_c_shared_utility/urlencode.h"
 #include "azure_c_shared_utility/xlogging.h"
 #include "azure_c_shared_utility/strings.h"
+#include "azure_c_shared_utility/optimize_size.h"
 
-#define NIBBLE_STR(c) (char)(c < 10 ? c + '0' : c - 10 + 'a')
-#define IS_PRINTABLE(c) (                           \
-    (c == 0) ||                                     \
-    (c == '!') ||                                   \
-    (c == '(') || (c == ')') || (c == '*') ||       \
-    (c == '-') || (c == '.') ||                     \
-    ((c >= '0') && (c <= '9')) ||                   \
-    ((c >= 'A') && (c <= 'Z')) ||                   \
-    (c == '_') ||                                   \
-    ((c >= 'a') && (c <= 'z'))                      \
-)
-
-static size_t URL_PrintableChar(unsigned char charVal, char* buffer)
+/*number of characters each byte is encoded to: 1 for the characters that are kept as they are ('!', '(', ')', '*', '-', '.',
+digits, letters and '_'), 3 for "%xx" and 6 for the two byte UTF-8 "%c2%xx" or "%c3%xx" of the bytes above 0x7f*/
+static const unsigned char url_encoded_size[256] =
 {
-    size_t size;
-    if (IS_PRINTABLE(charVal))
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    3, 1, 3, 3, 3, 3, 3, 3, 1, 1, 1, 3, 3, 1, 1, 3,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 3, 3, 3, 3, 3,
+    3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 3, 3, 3, 1,
+    3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 3, 3, 3, 3, 3,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6
+};
+
+static const char url_hex_digits[16] = { '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' };
+
+/*value of each hexadecimal digit, -1 for the characters that are not one*/
+static const signed char url_hex_values[256] =
+{
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+     0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+static size_t URL_EncodedLength(const unsigned char* text, size_t length)
+{
+    size_t result = 0;
+    size_t i;
+    for (i = 0; i < length; i++)
+    {
+        result += url_encoded_size[text[i]];
+    }
+    return result;
+}
+
+/*writes the encoding of charVal, the caller has checked that there is room for url_encoded_size[charVal] characters*/
+static void URL_EncodeChar(unsigned char charVal, char* buffer)
+{
+    switch (url_encoded_size[charVal])
     {
+    case 1:
         buffer[0] = (char)charVal;
-        size = 1;
+        break;
+    case 3:
+        buffer[0] = '%';
+        buffer[1] = url_hex_digits[charVal >> 4];
+        buffer[2] = url_hex_digits[charVal & 0x0F];
+        break;
+    default:
+        /*the byte is taken as a Latin-1 character and written as its two byte UTF-8 sequence*/
+        buffer[0] = '%';
+        buffer[1] = 'c';
+        buffer[2] = (charVal < 0xC0) ? '2' : '3';
+        buffer[3] = '%';
+        buffer[4] = url_hex_digits[0x08 | ((charVal >> 4) & 0x03)];
+        buffer[5] = url_hex_digits[charVal & 0x0F];
+        break;
+    }
+}
+
+static STRING_HANDLE URL_EncodeText(const char* text)
+{
+    STRING_HANDLE result;
+    size_t textLength = strlen(text);
+    size_t lengthOfResult = URL_EncodedLength((const unsigned char*)text, textLength);
+    char* encodedURL;
+
+    /*Codes_SRS_URL_ENCODE_06_003: [If input is a zero length string then URL_Encode will return a zero length string.]*/
+    if ((encodedURL = (char*)malloc(lengthOfResult + 1)) == NULL)
+    {
+        /*Codes_SRS_URL_ENCODE_06_002: [If an error occurs during the encoding of input then URL_Encode will return NULL.]*/
+        result = NULL;
+        LogError("URL_Encode:: MALLOC failure on encode.");
     }
     else
     {
-        char bigNibbleStr;
-        char littleNibbleStr;
-        unsigned char bigNibbleVal = charVal >> 4;
-        unsigned char littleNibbleVal = charVal & 0x0F;
+        size_t currentEncodePosition = 0;
+        size_t i;
+        for (i = 0; i < textLength; i++)
+        {
+            unsigned char currentUnsignedChar = (unsigned char)text[i];
+            URL_EncodeChar(currentUnsignedChar, &encodedURL[currentEncodePosition]);
+            currentEncodePosition += url_encoded_size[currentUnsignedChar];
+        }
+        encodedURL[currentEncodePosition] = '\0';
 
-        if (bigNibbleVal >= 0x0C)
+        result = STRING_new_with_memory(encodedURL);
+        if (result == NULL)
         {
-            bigNibbleVal -= 0x04;
+            LogError("URL_Encode:: MALLOC failure on encode.");
+            free(encodedURL);
         }
+    }
+    return result;
+}
 
-        bigNibbleStr = NIBBLE_STR(bigNibbleVal);
-        littleNibbleStr = NIBBLE_STR(littleNibbleVal);
+STRING_HANDLE URL_EncodeString(const char* textEncode)
+{
+    STRING_HANDLE result;
+    if (textEncode == NULL)
+    {
+        result = NULL;
+    }
+    else
+    {
+        /*Codes_SRS_URL_ENCODE_01_001: [URL_EncodeString shall encode textEncode directly, without copying it to an intermediate STRING.]*/
+        result = URL_EncodeText(textEncode);
+    }
+    return result;
+}
 
-        buffer[0] = '%';
+STRING_HANDLE URL_Encode(STRING_HANDLE input)
+{
+    STRING_HANDLE result;
+    if (input == NULL)
+    {
+        /*Codes_SRS_URL_ENCODE_06_001: [If input is NULL then URL_Encode will return NULL.]*/
+        result = NULL;
+        LogError("URL_Encode:: NULL input");
+    }
+    else
+    {
+        result = URL_EncodeText(STRING_c_str(input));
+    }
+    return result;
+}
 
-        if (charVal < 0x80)
-        {
-            buffer[1] = bigNibbleStr;
-            buffer[2] = littleNibbleStr;
-            size = 3;
-        }
-        else
+int URL_Encode_Into(const char* textEncode, size_t textLength, char* destination, size_t destinationSize, size_t* encodedLength)
+{
+    int result;
+    if ((textEncode == NULL && textLength > 0) || encodedLength == NULL)
+    {
+        /*Codes_SRS_URL_ENCODE_01_002: [If textEncode is NULL while textLength is not 0, or encodedLength is NULL, URL_Encode_Into shall fail and return a non-zero value.]*/
+        LogError("invalid parameter const char* textEncode=%p, size_t textLength=%lu, size_t* encodedLength=%p", textEncode, (unsigned long)textLength, encodedLength);
+        result = __FAILURE__;
+    }
+    else
+    {
+        const unsigned char* text = (const unsigned char*)textEncode;
+        size_t position = 0;
+        size_t i;
+
+        /*Codes_SRS_URL_ENCODE_01_003: [URL_Encode_Into shall encode textLength characters of textEncode in a single pass, the same way URL_Encode does.]*/
+        if ((destination != NULL) && (destinationSize > 0) && (textLength <= (destinationSize - 1) / 6))
         {
-            buffer[1] = 'c';
-            buffer[3] = '%';
-            buffer[4] = bigNibbleStr;
-            buffer[5] = littleNibbleStr;
-            if (charVal < 0xC0)
+            /*even if every character takes 6 there is room, no need to check each one*/
+            for (i = 0; i < textLength; i++)
             {
-                buffer[2] = '2';
+                URL_EncodeChar(text[i], destination + position);
+                position += url_encoded_size[text[i]];
             }
-            else
+        }
+        else if (destination != NULL)
+        {
+            for (i = 0; i < textLength; i++)
             {
-                buffer[2] = '3';
+                size_t size = url_encoded_size[text[i]];
+                if (position + size >= destinationSize)
+                {
+                    break;
+                }
+                URL_EncodeChar(text[i], destination + position);
+                position += size;
             }
-            size = 6;
         }
-    }
+        else
+        {
+            i = 0;
+        }
+
+        /*Codes_SRS_URL_ENCODE_01_004: [URL_Encode_Into shall set *encodedLength to the length of the encoding, not including the null terminator, even when destination is NULL or too small.]*/
+        *encodedLength = position + ((i < textLength) ? URL_EncodedLength(text + i, textLength - i) : 0);
 
-    return size;
+        if (i < textLength || destination == NULL || destinationSize == 0)
+        {
+            /*Codes_SRS_URL_ENCODE_01_005: [If destination is NULL or destinationSize is not larger than the length of the encoding, URL_Encode_Into shall fail and return a non-zero value.]*/
+            result = __FAILURE__;
+        }
+        else
+        {
+            /*Codes_SRS_URL_ENCODE_01_006: [On success URL_Encode_Into shall null terminate destination and return 0.]*/
+            destination[position] = '\0';
+            result = 0;
+        }
+    }
+    return result;
 }
 
-static size_t URL_PrintableCharSize(unsigned char charVal)
+int URL_Decode_Into(const char* textDecode, size_t textLength, char* destination, size_t destinationSize, size_t* decodedLength)
 {
-    size_t size;
-    if (IS_PRINTABLE(charVal))
+    int result;
+    if ((textDecode == NULL && textLength > 0) || destination == NULL || decodedLength == NULL)
     {
-        size = 1;
+        /*Codes_SRS_URL_ENCODE_01_007: [If textDecode is NULL while textLength is not 0, or destination or decodedLength is NULL, URL_Decode_Into shall fail and return a non-zero value.]*/
+        LogError("invalid parameter const char* textDecode=%p, size_t textLength=%lu, char* destination=%p, size_t* decodedLength=%p", textDecode, (unsigned long)textLength, destination, decodedLength);
+        result = __FAILURE__;
     }
     else
     {
-        if (charVal < 0x80)
+        const unsigned char* text = (const unsigned char*)textDecode;
+        size_t position = 0;
+        size_t i = 0;
+
+        result = 0;
+        while (i < textLength)
         {
-            size = 3;
+            unsigned char decoded;
+            if (text[i] != '%')
+            {
+                /*Codes_SRS_URL_ENCODE_01_008: [Characters other than '%' shall be copied as they are.]*/
+                decoded = text[i];
+                i++;
+            }
+            else if ((textLength - i < 3) || (url_hex_values[text[i + 1]] < 0) || (url_hex_values[text[i + 2]] < 0))
+            {
+                /*Codes_SRS_URL_ENCODE_01_009: [If a '%' is not followed by 2 hexadecimal digits, URL_Decode_Into shall fail and return a non-zero value.]*/
+                LogError("invalid escape sequence at position %lu", (unsigned long)i);
+                result = __FAILURE__;
+                break;
+            }
+            else
+            {
+                /*Codes_SRS_URL_ENCODE_01_010: [Each "%xx" shall be decoded to the byte whose value the 2 hexadecimal digits, in either case, give.]*/
+                decoded = (unsigned char)((url_hex_values[text[i + 1]] << 4) | url_hex_values[text[i + 2]]);
+                i += 3;
+
+                /*Codes_SRS_URL_ENCODE_01_011: [A "%c2%xx" or "%c3%xx" where xx is in the range 80 to bf shall be decoded to the single byte URL_Encode encoded to it.]*/
+                if (((decoded == 0xC2) || (decoded == 0xC3)) &&
+                    (textLength - i >= 3) && (text[i] == '%') &&
+                    (url_hex_values[text[i + 1]] >= 8) && (url_hex_values[text[i + 1]] <= 0x0B) &&
+                    (url_hex_values[text[i + 2]] >= 0))
+                {
+                    decoded = (unsigned char)(((decoded & 0x03) << 6) | ((url_hex_values[text[i + 1]] & 0x03) << 4) | url_hex_values[text[i + 2]]);
+                    i += 3;
+                }
+            }
+
+            if (position + 1 >= destinationSize)
+            {
+                /*Codes_SRS_URL_ENCODE_01_012: [If destination cannot hold the decoded characters and a null terminator, URL_Decode_Into shall fail and return a non-zero value.]*/
+                LogError("destination too small, size_t destinationSize=%lu", (unsigned long)destinationSize);
+                result = __FAILURE__;
+                break;
+            }
+            destination[position++] = (char)decoded;
         }
-        else
+
+        if (result == 0)
         {
-            size = 6;
+            /*Codes_SRS_URL_ENCODE_01_013: [On success URL_Decode_Into shall null terminate destination, set *decodedLength to the number of decoded characters and return 0.]*/
+            if (destinationSize == 0)
+            {
+                LogError("destination too small, size_t destinationSize=%lu", (unsigned long)destinationSize);
+                result = __FAILURE__;
+            }
+            else
+            {
+                destination[position] = '\0';
+                *decodedLength = position;
+            }
         }
     }
-    return size;
+    return result;
 }
 
-STRING_HANDLE URL_EncodeString(const char* textEncode)
+STRING_HANDLE URL_DecodeString(const char* textDecode)
 {
     STRING_HANDLE result;
-    if (textEncode == NULL)
+    if (textDecode == NULL)
     {
+        /*Codes_SRS_URL_ENCODE_01_014: [If textDecode is NULL then URL_DecodeString shall return NULL.]*/
+        LogError("URL_DecodeString:: NULL input");
         result = NULL;
     }
     else
     {
-        STRING_HANDLE tempString = STRING_construct(textEncode);
-        if (tempString == NULL)
+        /*the decoding is never longer than the encoding*/
+        size_t textLength = strlen(textDecode);
+        char* decodedURL = (char*)malloc(textLength + 1);
+        if (decodedURL == NULL)
         {
+            /*Codes_SRS_URL_ENCODE_01_015: [If an error occurs during the decoding URL_DecodeString shall return NULL.]*/
+            LogError("URL_DecodeString:: MALLOC failure on decode.");
             result = NULL;
         }
         else
         {
-            result = URL_Encode(tempString);
-            STRING_delete(tempString);
+            size_t decodedLength;
+            if (URL_Decode_Into(textDecode, textLength, decodedURL, textLength + 1, &decodedLength) != 0)
+            {
+                LogError("URL_DecodeString:: invalid encoding.");
+                free(decodedURL);
+                result = NULL;
+            }
+            else if (strlen(decodedURL) != decodedLength)
+            {
+                /*Codes_SRS_URL_ENCODE_01_016: [If the decoding contains a null character URL_DecodeString shall return NULL.]*/
+                LogError("URL_DecodeString:: decoding contains a null character.");
+                free(decodedURL);
+                result = NULL;
+            }
+            else
+            {
+                /*Codes_SRS_URL_ENCODE_01_017: [Otherwise URL_DecodeString shall return a STRING holding the decoding of textDecode.]*/
+                result = STRING_new_with_memory(decodedURL);
+                if (result == NULL)
+                {
+                    LogError("URL_DecodeString:: MALLOC failure on decode.");
+                    free(decodedURL);
+                }
+            }
         }
     }
     return result;
 }
 
-STRING_HANDLE URL_Encode(STRING_HANDLE input)
+STRING_HANDLE URL_Decode(STRING_HANDLE input)
 {
     STRING_HANDLE result;
     if (input == NULL)
     {
-        /*Codes_SRS_URL_ENCODE_06_001: [If input is NULL then URL_Encode will return NULL.]*/
+        /*Codes_SRS_URL_ENCODE_01_018: [If input is NULL then URL_Decode shall return NULL.]*/
+        LogError("URL_Decode:: NULL input");
         result = NULL;
-        LogError("URL_Encode:: NULL input");
     }
     else
     {
-        size_t lengthOfResult = 0;
-        char* encodedURL;
-        const char* currentInput;
-        unsigned char currentUnsignedChar;
-        currentInput = STRING_c_str(input);
-        /*Codes_SRS_URL_ENCODE_06_003: [If input is a zero length string then URL_Encode will return a zero length string.]*/
-        do
-        {
-            currentUnsignedChar = (unsigned char)(*currentInput++);
-            lengthOfResult += URL_PrintableCharSize(currentUnsignedChar);
-        } while (currentUnsignedChar != 0);
-        if ((encodedURL = (char*)malloc(lengthOfResult)) == NULL)
-        {
-            /*Codes_SRS_URL_ENCODE_06_002: [If an error occurs during the encoding of input then URL_Encode will return NULL.]*/
-            result = NULL;
-            LogError("URL_Encode:: MALLOC failure on encode.");
-        }
-        else
-        {
-            size_t currentEncodePosition = 0;
-            currentInput = STRING_c_str(input);
-            do
-            {
-                currentUnsignedChar = (unsigned char)(*currentInput++);
-                currentEncodePosition += URL_PrintableChar(currentUnsignedChar, &encodedURL[currentEncodePosition]);
-            } while (currentUnsignedChar != 0);
-
-            result = STRING_new_with_memory(encodedURL);
-            if (result == NULL)
-            {
-                LogError("URL_Encode:: MALLOC failure on encode.");
-                free(encodedURL);
-            }
-        }
+        /*Codes_SRS_URL_ENCODE_01_019: [Otherwise URL_Decode shall behave as URL_DecodeString on the characters of input.]*/
+        result = URL_DecodeString(STRING_c_str(input));
     }
     return result;
 }
@@ -1,4 +1,4 @@
- // Copyright (c) Microsoft. All rights reserved.
+// Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #ifdef __cplusplus
@@ -6,14 +6,292 @@
 #include <cstdbool>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #else
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #endif
 
 #include "azure_c_shared_utility/utf8_checker.h"
+#include "azure_c_shared_utility/cpu_features.h"
+
+/*the vector kernels below are picked at runtime, so a library built with them still runs on processors without them*/
+/*defining NO_SIMD (the no_simd cmake option) compiles them out*/
+#if !defined(NO_SIMD)
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5)))
+#define UTF8_CHECKER_SIMD_X86
+#include <immintrin.h>
+#define UTF8_CHECKER_SSSE3_TARGET __attribute__((target("ssse3")))
+#define UTF8_CHECKER_AVX2_TARGET __attribute__((target("avx2")))
+#elif (defined(_M_X64) || defined(_M_IX86)) && defined(_MSC_VER) && (_MSC_VER >= 1900)
+#define UTF8_CHECKER_SIMD_X86
+#include <immintrin.h>
+#define UTF8_CHECKER_SSSE3_TARGET
+#define UTF8_CHECKER_AVX2_TARGET
+#endif
+#endif /* NO_SIMD */
+
+/*
+Every byte is checked against the 3 bytes before it, as in "Validating UTF-8 In Less Than One Instruction Per Byte"
+(Keiser, Lemire). Looking up the high and the low nibble of the previous byte and the high nibble of the byte itself in
+the 3 tables below and and-ing the results leaves the bits of the errors the pair of bytes makes.
+The tables accept what the checker always accepted: overlong forms are errors, surrogates and 4 byte sequences up to
+0x1FFFFF (F0 to F7 lead bytes) are not.
+*/
+#define UTF8_TOO_SHORT  0x01 /* a lead byte not followed by a continuation byte */
+#define UTF8_TOO_LONG   0x02 /* a continuation byte after an ASCII character */
+#define UTF8_OVERLONG_3 0x04 /* E0 followed by 80..9F */
+#define UTF8_TOO_LARGE  0x08 /* F8..FF, never part of UTF-8 */
+#define UTF8_OVERLONG_2 0x20 /* C0 and C1, which can only start overlong 2 byte sequences */
+#define UTF8_OVERLONG_4 0x40 /* F0 followed by 80..8F */
+#define UTF8_TWO_CONTS  0x80 /* 2 continuation bytes in a row, only valid as the 3rd or 4th byte of a sequence */
+#define UTF8_CARRY      (UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS)
+
+static const unsigned char utf8_byte_1_high[16] =
+{
+    /* 0_ to 7_, ASCII */
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    /* 8_ to B_, continuation */
+    UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+    /* C_ and D_, 2 byte lead */
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2, UTF8_TOO_SHORT,
+    /* E_, 3 byte lead */
+    UTF8_TOO_SHORT | UTF8_OVERLONG_3,
+    /* F_, 4 byte lead */
+    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_OVERLONG_4
+};
+
+static const unsigned char utf8_byte_1_low[16] =
+{
+    UTF8_CARRY | UTF8_OVERLONG_2 | UTF8_OVERLONG_3 | UTF8_OVERLONG_4,
+    UTF8_CARRY | UTF8_OVERLONG_2,
+    UTF8_CARRY, UTF8_CARRY, UTF8_CARRY, UTF8_CARRY, UTF8_CARRY, UTF8_CARRY,
+    UTF8_CARRY | UTF8_TOO_LARGE, UTF8_CARRY | UTF8_TOO_LARGE, UTF8_CARRY | UTF8_TOO_LARGE, UTF8_CARRY | UTF8_TOO_LARGE,
+    UTF8_CARRY | UTF8_TOO_LARGE, UTF8_CARRY | UTF8_TOO_LARGE, UTF8_CARRY | UTF8_TOO_LARGE, UTF8_CARRY | UTF8_TOO_LARGE
+};
+
+static const unsigned char utf8_byte_2_high[16] =
+{
+    /* 0_ to 7_ */
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2 | UTF8_TOO_LARGE, UTF8_TOO_SHORT | UTF8_OVERLONG_2 | UTF8_TOO_LARGE,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2 | UTF8_TOO_LARGE, UTF8_TOO_SHORT | UTF8_OVERLONG_2 | UTF8_TOO_LARGE,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2 | UTF8_TOO_LARGE, UTF8_TOO_SHORT | UTF8_OVERLONG_2 | UTF8_TOO_LARGE,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2 | UTF8_TOO_LARGE, UTF8_TOO_SHORT | UTF8_OVERLONG_2 | UTF8_TOO_LARGE,
+    /* 8_ */
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_OVERLONG_4 | UTF8_TOO_LARGE,
+    /* 9_ */
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+    /* A_ and B_ */
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_TOO_LARGE,
+    /* C_ to F_ */
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2 | UTF8_TOO_LARGE, UTF8_TOO_SHORT | UTF8_OVERLONG_2 | UTF8_TOO_LARGE,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2 | UTF8_TOO_LARGE, UTF8_TOO_SHORT | UTF8_OVERLONG_2 | UTF8_TOO_LARGE
+};
+
+/*checks a byte against the 3 before it. The 3rd and 4th bytes of a sequence are the only places where 2 continuation
+bytes in a row are expected, so there the UTF8_TWO_CONTS bit cancels out and anywhere else it is an error*/
+static unsigned char check_byte(unsigned char previous_3, unsigned char previous_2, unsigned char previous_1, unsigned char current)
+{
+    unsigned char special_cases = utf8_byte_1_high[previous_1 >> 4] & utf8_byte_1_low[previous_1 & 0x0F] & utf8_byte_2_high[current >> 4];
+    unsigned char must_be_2_3_continuation = ((previous_2 >= 0xE0) || (previous_3 >= 0xF0)) ? UTF8_TWO_CONTS : 0;
+    return (unsigned char)(special_cases ^ must_be_2_3_continuation);
+}
+
+/*true when the last bytes seen end in the middle of a sequence*/
+static bool is_incomplete(const UTF8_CHECKER_STATE* state)
+{
+    return (state->previous[0] >= 0xC0) || (state->previous[1] >= 0xE0) || (state->previous[2] >= 0xF0);
+}
+
+/*checks whole blocks from the start of utf8_str, updating state, and returns the number of bytes checked*/
+typedef size_t(*UTF8_CHECK_BLOCKS)(UTF8_CHECKER_STATE* state, const unsigned char* utf8_str, size_t length);
+
+#if defined(UTF8_CHECKER_SIMD_X86)
+
+UTF8_CHECKER_SSSE3_TARGET
+static size_t check_blocks_ssse3(UTF8_CHECKER_STATE* state, const unsigned char* utf8_str, size_t length)
+{
+    const __m128i byte_1_high = _mm_loadu_si128((const __m128i*)utf8_byte_1_high);
+    const __m128i byte_1_low = _mm_loadu_si128((const __m128i*)utf8_byte_1_low);
+    const __m128i byte_2_high = _mm_loadu_si128((const __m128i*)utf8_byte_2_high);
+    const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+    /*only the last 3 bytes of a block can start a sequence that goes on in the next one*/
+    const __m128i max_complete = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    __m128i previous_input = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        (char)state->previous[2], (char)state->previous[1], (char)state->previous[0]);
+    __m128i previous_incomplete = _mm_subs_epu8(previous_input, max_complete);
+    __m128i error = _mm_setzero_si128();
+    size_t checked = 0;
+
+    while (length - checked >= 16)
+    {
+        __m128i input = _mm_loadu_si128((const __m128i*)(utf8_str + checked));
+        if (_mm_movemask_epi8(input) == 0)
+        {
+            /*ASCII only, the block is valid if the one before it ended on a complete sequence*/
+            error = _mm_or_si128(error, previous_incomplete);
+            previous_incomplete = _mm_setzero_si128();
+        }
+        else
+        {
+            __m128i previous_1 = _mm_alignr_epi8(input, previous_input, 15);
+            __m128i previous_2 = _mm_alignr_epi8(input, previous_input, 14);
+            __m128i previous_3 = _mm_alignr_epi8(input, previous_input, 13);
+            __m128i special_cases = _mm_and_si128(_mm_and_si128(
+                _mm_shuffle_epi8(byte_1_high, _mm_and_si128(_mm_srli_epi16(previous_1, 4), nibble_mask)),
+                _mm_shuffle_epi8(byte_1_low, _mm_and_si128(previous_1, nibble_mask))),
+                _mm_shuffle_epi8(byte_2_high, _mm_and_si128(_mm_srli_epi16(input, 4), nibble_mask)));
+            __m128i must_be_2_3_continuation = _mm_and_si128(_mm_or_si128(
+                _mm_subs_epu8(previous_2, _mm_set1_epi8((char)(0xE0 - 0x80))),
+                _mm_subs_epu8(previous_3, _mm_set1_epi8((char)(0xF0 - 0x80)))),
+                _mm_set1_epi8((char)0x80));
+            error = _mm_or_si128(error, _mm_xor_si128(special_cases, must_be_2_3_continuation));
+            previous_incomplete = _mm_subs_epu8(input, max_complete);
+        }
+        previous_input = input;
+        checked += 16;
+    }
+
+    if (checked > 0)
+    {
+        state->previous[0] = utf8_str[checked - 1];
+        state->previous[1] = utf8_str[checked - 2];
+        state->previous[2] = utf8_str[checked - 3];
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xFFFF)
+        {
+            state->error = 1;
+        }
+    }
+
+    return checked;
+}
+
+UTF8_CHECKER_AVX2_TARGET
+static size_t check_blocks_avx2(UTF8_CHECKER_STATE* state, const unsigned char* utf8_str, size_t length)
+{
+    const __m256i byte_1_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)utf8_byte_1_high));
+    const __m256i byte_1_low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)utf8_byte_1_low));
+    const __m256i byte_2_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)utf8_byte_2_high));
+    const __m256i nibble_mask = _mm256_set1_epi8(0x0F);
+    const __m256i max_complete = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    __m256i previous_input = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        (char)state->previous[2], (char)state->previous[1], (char)state->previous[0]);
+    __m256i previous_incomplete = _mm256_subs_epu8(previous_input, max_complete);
+    __m256i error = _mm256_setzero_si256();
+    size_t checked = 0;
+
+    while (length - checked >= 32)
+    {
+        __m256i input = _mm256_loadu_si256((const __m256i*)(utf8_str + checked));
+        if (_mm256_movemask_epi8(input) == 0)
+        {
+            error = _mm256_or_si256(error, previous_incomplete);
+            previous_incomplete = _mm256_setzero_si256();
+        }
+        else
+        {
+            /*the AVX2 alignr works within each 128 bit lane, so the bytes before the input are first lined up with
+            a permute that puts the high lane of the previous input below the low lane of the input*/
+            __m256i shifted = _mm256_permute2x128_si256(previous_input, input, 0x21);
+            __m256i previous_1 = _mm256_alignr_epi8(input, shifted, 15);
+            __m256i previous_2 = _mm256_alignr_epi8(input, shifted, 14);
+            __m256i previous_3 = _mm256_alignr_epi8(input, shifted, 13);
+            __m256i special_cases = _mm256_and_si256(_mm256_and_si256(
+                _mm256_shuffle_epi8(byte_1_high, _mm256_and_si256(_mm256_srli_epi16(previous_1, 4), nibble_mask)),
+                _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(previous_1, nibble_mask))),
+                _mm256_shuffle_epi8(byte_2_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble_mask)));
+            __m256i must_be_2_3_continuation = _mm256_and_si256(_mm256_or_si256(
+                _mm256_subs_epu8(previous_2, _mm256_set1_epi8((char)(0xE0 - 0x80))),
+                _mm256_subs_epu8(previous_3, _mm256_set1_epi8((char)(0xF0 - 0x80)))),
+                _mm256_set1_epi8((char)0x80));
+            error = _mm256_or_si256(error, _mm256_xor_si256(special_cases, must_be_2_3_continuation));
+            previous_incomplete = _mm256_subs_epu8(input, max_complete);
+        }
+        previous_input = input;
+        checked += 32;
+    }
+
+    if (checked > 0)
+    {
+        state->previous[0] = utf8_str[checked - 1];
+        state->previous[1] = utf8_str[checked - 2];
+        state->previous[2] = utf8_str[checked - 3];
+        if (_mm256_testz_si256(error, error) == 0)
+        {
+            state->error = 1;
+        }
+    }
+
+    return checked;
+}
+
+#endif
+
+/*the kernel for this processor, NULL when the portable code does all the work*/
+static UTF8_CHECK_BLOCKS get_check_blocks_function(void)
+{
+#if defined(UTF8_CHECKER_SIMD_X86)
+    int features = cpu_features_get();
+    return ((features & CPU_FEATURE_X86_AVX2) != 0) ? check_blocks_avx2 :
+        ((features & CPU_FEATURE_X86_SSSE3) != 0) ? check_blocks_ssse3 : NULL;
+#else
+    return NULL;
+#endif
+}
+
+static bool is_ascii_8(const unsigned char* utf8_str)
+{
+    uint64_t word;
+    (void)memcpy(&word, utf8_str, sizeof(word));
+    return (word & 0x8080808080808080ULL) == 0;
+}
+
+static void check_bytes(UTF8_CHECKER_STATE* state, const unsigned char* utf8_str, size_t length)
+{
+    unsigned char previous_1 = state->previous[0];
+    unsigned char previous_2 = state->previous[1];
+    unsigned char previous_3 = state->previous[2];
+    unsigned char error = 0;
+    size_t pos = 0;
+
+    while (pos < length)
+    {
+        if ((length - pos >= 8) &&
+            (previous_1 < 0xC0) && (previous_2 < 0xE0) && (previous_3 < 0xF0) &&
+            is_ascii_8(utf8_str + pos))
+        {
+            /*8 ASCII characters after a complete sequence are valid, and to the bytes after them all ASCII characters look the same*/
+            previous_1 = 0;
+            previous_2 = 0;
+            previous_3 = 0;
+            pos += 8;
+        }
+        else
+        {
+            error |= check_byte(previous_3, previous_2, previous_1, utf8_str[pos]);
+            previous_3 = previous_2;
+            previous_2 = previous_1;
+            previous_1 = utf8_str[pos];
+            pos++;
+        }
+    }
+
+    state->previous[0] = previous_1;
+    state->previous[1] = previous_2;
+    state->previous[2] = previous_3;
+    if (error != 0)
+    {
+        state->error = 1;
+    }
+}
 
 bool utf8_checker_is_valid_utf8(const unsigned char* utf8_str, size_t length)
 {
@@ -26,152 +304,77 @@ bool utf8_checker_is_valid_utf8(const unsigned char* utf8_str, size_t length)
     }
     else
     {
-        size_t pos = 0;
+        UTF8_CHECKER_STATE state;
 
+        /* Codes_SRS_UTF8_CHECKER_01_001: [ `utf8_checker_is_valid_utf8` shall verify that the sequence of chars pointed to by `utf8_str` represent UTF-8 encoded codepoints. ]*/
+        /* Codes_SRS_UTF8_CHECKER_01_006: [ 00000000 0xxxxxxx 0xxxxxxx ]*/
+        /* Codes_SRS_UTF8_CHECKER_01_007: [ 00000yyy yyxxxxxx 110yyyyy 10xxxxxx ]*/
+        /* Codes_SRS_UTF8_CHECKER_01_008: [ zzzzyyyy yyxxxxxx 1110zzzz 10yyyyyy 10xxxxxx ]*/
+        /* Codes_SRS_UTF8_CHECKER_01_009: [ 000uuuuu zzzzyyyy yyxxxxxx 11110uuu 10uuzzzz 10yyyyyy 10xxxxxx ]*/
         /* Codes_SRS_UTF8_CHECKER_01_003: [ If `length` is 0, `utf8_checker_is_valid_utf8` shall consider `utf8_str` to be valid UTF-8 and return true. ]*/
-        result = true;
+        /* Codes_SRS_UTF8_CHECKER_01_005: [ On success it shall return true. ]*/
+        utf8_checker_init(&state);
+        result = utf8_checker_update(&state, utf8_str, length) && utf8_checker_final(&state);
+    }
+
+    return result;
+}
+
+void utf8_checker_init(UTF8_CHECKER_STATE* state)
+{
+    /* Codes_SRS_UTF8_CHECKER_01_010: [ If `state` is NULL, `utf8_checker_init` shall do nothing. ]*/
+    if (state != NULL)
+    {
+        /* Codes_SRS_UTF8_CHECKER_01_011: [ `utf8_checker_init` shall set `state` to the start of a string. ]*/
+        (void)memset(state, 0, sizeof(*state));
+    }
+}
+
+bool utf8_checker_update(UTF8_CHECKER_STATE* state, const unsigned char* utf8_str, size_t length)
+{
+    bool result;
 
-        while ((result == true) &&
-               (pos < length))
+    if ((state == NULL) ||
+        ((utf8_str == NULL) && (length > 0)))
+    {
+        /* Codes_SRS_UTF8_CHECKER_01_012: [ If `state` is NULL, or `utf8_str` is NULL while `length` is not 0, `utf8_checker_update` shall return false. ]*/
+        result = false;
+    }
+    else
+    {
+        if ((state->error == 0) && (length > 0))
         {
-            /* Codes_SRS_UTF8_CHECKER_01_001: [ `utf8_checker_is_valid_utf8` shall verify that the sequence of chars pointed to by `utf8_str` represent UTF-8 encoded codepoints. ]*/
-            if ((utf8_str[pos] >> 3) == 0x1E)
-            {
-                /* 4 bytes */
-                /* Codes_SRS_UTF8_CHECKER_01_009: [ 000uuuuu zzzzyyyy yyxxxxxx 11110uuu 10uuzzzz 10yyyyyy 10xxxxxx ]*/
-                uint32_t code_point = (utf8_str[pos] & 0x07);
-
-                pos++;
-                if ((pos < length) &&
-                    ((utf8_str[pos] >> 6) == 0x02))
-                {
-                    code_point <<= 6;
-                    code_point += utf8_str[pos] & 0x3F;
-
-                    pos++;
-                    if ((pos < length) &&
-                        ((utf8_str[pos] >> 6) == 0x02))
-                    {
-                        code_point <<= 6;
-                        code_point += utf8_str[pos] & 0x3F;
-
-                        pos++;
-                        if ((pos < length) &&
-                            ((utf8_str[pos] >> 6) == 0x02))
-                        {
-                            code_point <<= 6;
-                            code_point += utf8_str[pos] & 0x3F;
-
-                            if (code_point <= 0xFFFF)
-                            {
-                                result = false;
-                            }
-                            else
-                            {
-                                /* Codes_SRS_UTF8_CHECKER_01_005: [ On success it shall return true. ]*/
-                                result = true;
-                                pos++;
-                            }
-                        }
-                        else
-                        {
-                            result = false;
-                        }
-                    }
-                    else
-                    {
-                        result = false;
-                    }
-                }
-                else
-                {
-                    result = false;
-                }
-            }
-            else if ((utf8_str[pos] >> 4) == 0x0E)
-            {
-                /* 3 bytes */
-                /* Codes_SRS_UTF8_CHECKER_01_008: [ zzzzyyyy yyxxxxxx 1110zzzz 10yyyyyy 10xxxxxx ]*/
-                uint32_t code_point = (utf8_str[pos] & 0x0F);
-
-                pos++;
-                if ((pos < length) &&
-                    ((utf8_str[pos] >> 6) == 0x02))
-                {
-                    code_point <<= 6;
-                    code_point += utf8_str[pos] & 0x3F;
-
-                    pos++;
-                    if ((pos < length) &&
-                        ((utf8_str[pos] >> 6) == 0x02))
-                    {
-                        code_point <<= 6;
-                        code_point += utf8_str[pos] & 0x3F;
-
-                        if (code_point <= 0x7FF)
-                        {
-                            result = false;
-                        }
-                        else
-                        {
-                            /* Codes_SRS_UTF8_CHECKER_01_005: [ On success it shall return true. ]*/
-                            result = true;
-                            pos++;
-                        }
-                    }
-                    else
-                    {
-                        result = false;
-                    }
-                }
-                else
-                {
-                    result = false;
-                }
-            }
-            else if ((utf8_str[pos] >> 5) == 0x06)
-            {
-                /* 2 bytes */
-                /* Codes_SRS_UTF8_CHECKER_01_007: [ 00000yyy yyxxxxxx 110yyyyy 10xxxxxx ]*/
-                uint32_t code_point = (utf8_str[pos] & 0x1F);
-
-                pos++;
-                if ((pos < length) &&
-                    ((utf8_str[pos] >> 6) == 0x02))
-                {
-                    code_point <<= 6;
-                    code_point += utf8_str[pos] & 0x3F;
-
-                    if (code_point <= 0x7F)
-                    {
-                        result = false;
-                    }
-                    else
-                    {
-                        /* Codes_SRS_UTF8_CHECKER_01_005: [ On success it shall return true. ]*/
-                        result = true;
-                        pos++;
-                    }
-                }
-                else
-                {
-                    result = false;
-                }
-            }
-            else if ((utf8_str[pos] >> 7) == 0x00)
-            {
-                /* 1 byte */
-                /* Codes_SRS_UTF8_CHECKER_01_006: [ 00000000 0xxxxxxx 0xxxxxxx ]*/
-                /* Codes_SRS_UTF8_CHECKER_01_005: [ On success it shall return true. ]*/
-                result = true;
-                pos++;
-            }
-            else
+            size_t checked = 0;
+            UTF8_CHECK_BLOCKS check_blocks = get_check_blocks_function();
+
+            /* Codes_SRS_UTF8_CHECKER_01_013: [ `utf8_checker_update` shall check the `length` bytes of `utf8_str` as the continuation of the bytes given to the previous calls, so that a sequence may be split between calls. ]*/
+            if (check_blocks != NULL)
             {
-                /* error */
-                result = false;
+                checked = check_blocks(state, utf8_str, length);
             }
+            check_bytes(state, utf8_str + checked, length - checked);
         }
+
+        /* Codes_SRS_UTF8_CHECKER_01_014: [ `utf8_checker_update` shall return false once any of the bytes given since `utf8_checker_init` are not valid UTF-8, and true otherwise. ]*/
+        result = (state->error == 0);
+    }
+
+    return result;
+}
+
+bool utf8_checker_final(UTF8_CHECKER_STATE* state)
+{
+    bool result;
+
+    if (state == NULL)
+    {
+        /* Codes_SRS_UTF8_CHECKER_01_015: [ If `state` is NULL, `utf8_checker_final` shall return false. ]*/
+        result = false;
+    }
+    else
+    {
+        /* Codes_SRS_UTF8_CHECKER_01_016: [ `utf8_checker_final` shall return true if all the bytes given since `utf8_checker_init` are valid UTF-8 and do not end in the middle of a sequence, and false otherwise. ]*/
+        result = (state->error == 0) && !is_incomplete(state);
     }
 
     return result;
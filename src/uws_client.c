@@ -7,6 +7,7 @@
 #include <ctype.h>
 #include <limits.h>
 #include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/slaballoc.h"
 #include "azure_c_shared_utility/uws_client.h"
 #include "azure_c_shared_utility/optimize_size.h"
 #include "azure_c_shared_utility/xlogging.h"
@@ -23,6 +24,7 @@
 #include "azure_c_shared_utility/gb_rand.h"
 #include "azure_c_shared_utility/base64.h"
 #include "azure_c_shared_utility/optionhandler.h"
+#include "azure_c_shared_utility/http_response_parser.h"
 
 static const char* UWS_CLIENT_OPTIONS = "uWSClientOptions";
 
@@ -97,7 +99,11 @@ typedef struct UWS_CLIENT_INSTANCE_TAG
     void* on_ws_close_complete_context;
     unsigned char* received_bytes;
     size_t received_bytes_count;
+    HTTP_RESPONSE_PARSER_HANDLE upgrade_response_parser;
+    int upgrade_response_status_code;
     UWS_FRAME_DECODER_STATE frame_decoder_state;
+    UTF8_CHECKER_STATE text_message_utf8_state;
+    bool is_receiving_text_message;
 } UWS_CLIENT_INSTANCE;
 
 /* Codes_SRS_UWS_CLIENT_01_360: [ Connection confidentiality and integrity is provided by running the WebSocket Protocol over TLS (wss URIs). ]*/
@@ -267,6 +273,9 @@ UWS_CLIENT_HANDLE uws_client_create(const char* hostname, unsigned int port, con
                                 result->on_ws_close_complete_context = NULL;
                                 result->received_bytes = NULL;
                                 result->received_bytes_count = 0;
+                                result->upgrade_response_parser = NULL;
+                                result->upgrade_response_status_code = 0;
+                                result->is_receiving_text_message = false;
 
                                 result->protocol_count = protocol_count;
 
@@ -441,6 +450,9 @@ UWS_CLIENT_HANDLE uws_client_create_with_io(const IO_INTERFACE_DESCRIPTION* io_i
                                 result->on_ws_close_complete_context = NULL;
                                 result->received_bytes = NULL;
                                 result->received_bytes_count = 0;
+                                result->upgrade_response_parser = NULL;
+                                result->upgrade_response_status_code = 0;
+                                result->is_receiving_text_message = false;
 
                                 result->protocol_count = protocol_count;
 
@@ -510,6 +522,15 @@ UWS_CLIENT_HANDLE uws_client_create_with_io(const IO_INTERFACE_DESCRIPTION* io_i
     return result;
 }
 
+static void destroy_upgrade_response_parser(UWS_CLIENT_INSTANCE* uws_client)
+{
+    if (uws_client->upgrade_response_parser != NULL)
+    {
+        http_response_parser_destroy(uws_client->upgrade_response_parser);
+        uws_client->upgrade_response_parser = NULL;
+    }
+}
+
 void uws_client_destroy(UWS_CLIENT_HANDLE uws_client)
 {
     /* Codes_SRS_UWS_CLIENT_01_020: [ If `uws_client` is NULL, `uws_client_destroy` shall do nothing. ]*/
@@ -520,6 +541,7 @@ void uws_client_destroy(UWS_CLIENT_HANDLE uws_client)
     else
     {
         free(uws_client->received_bytes);
+        destroy_upgrade_response_parser(uws_client);
 
         /* Codes_SRS_UWS_CLIENT_01_021: [ `uws_client_destroy` shall perform a close action if the uws instance has already been open. ]*/
         switch (uws_client->uws_state)
@@ -839,96 +861,30 @@ static void on_underlying_io_close_sent(void* context, IO_SEND_RESULT io_send_re
     }
 }
 
-/*the following function does the same as sscanf(pos2, "%d", &sec)*/
-/*this function only exists because some of platforms do not have sscanf. */
-static int ParseStringToDecimal(const char *src, int* dst)
+static void on_upgrade_response_status(void* context, int status_code, const char* reason_phrase, size_t reason_phrase_length)
 {
-    int result;
-    char* next;
+    UWS_CLIENT_INSTANCE* uws_client = (UWS_CLIENT_INSTANCE*)context;
+    (void)reason_phrase;
+    (void)reason_phrase_length;
 
-    (*dst) = strtol(src, &next, 0);
-    if ((src == next) || ((((*dst) == INT_MAX) || ((*dst) == INT_MIN)) && (errno != 0)))
-    {
-        result = __FAILURE__;
-    }
-    else
-    {
-        result = 0;
-    }
-
-    return result;
+    uws_client->upgrade_response_status_code = status_code;
 }
 
-/*the following function does the same as sscanf(buf, "HTTP/%*d.%*d %d %*[^\r\n]", &ret) */
-/*this function only exists because some of platforms do not have sscanf. This is not a full implementation; it only works with well-defined HTTP response. */
-static int ParseHttpResponse(const char* src, int* dst)
+static int append_received_bytes(UWS_CLIENT_INSTANCE* uws_client, const unsigned char* buffer, size_t size)
 {
     int result;
-    static const char HTTPPrefix[] = "HTTP/";
-    bool fail;
-    const char* runPrefix;
-
-    if ((src == NULL) || (dst == NULL))
+    unsigned char* new_received_bytes = (unsigned char*)realloc(uws_client->received_bytes, uws_client->received_bytes_count + size + 1);
+    if (new_received_bytes == NULL)
     {
+        LogError("Cannot allocate memory for received data");
         result = __FAILURE__;
     }
     else
     {
-        fail = false;
-        runPrefix = HTTPPrefix;
-
-        while ((*runPrefix) != '\0')
-        {
-            if ((*runPrefix) != (*src))
-            {
-                fail = true;
-                break;
-            }
-            src++;
-            runPrefix++;
-        }
-
-        if (!fail)
-        {
-            while ((*src) != '.')
-            {
-                if ((*src) == '\0')
-                {
-                    fail = true;
-                    break;
-                }
-                src++;
-            }
-        }
-
-        if (!fail)
-        {
-            while ((*src) != ' ')
-            {
-                if ((*src) == '\0')
-                {
-                    fail = true;
-                    break;
-                }
-                src++;
-            }
-        }
-
-        if (fail)
-        {
-            result = __FAILURE__;
-        }
-        else
-        {
-            if (ParseStringToDecimal(src, dst) != 0)
-            {
-                result = __FAILURE__;
-            }
-            else
-            {
-                result = 0;
-            }
-        }
+        uws_client->received_bytes = new_received_bytes;
+        (void)memcpy(uws_client->received_bytes + uws_client->received_bytes_count, buffer, size);
+        uws_client->received_bytes_count += size;
+        result = 0;
     }
 
     return result;
@@ -966,21 +922,56 @@ static void on_underlying_io_bytes_received(void* context, const unsigned char*
 
             case UWS_STATE_WAITING_FOR_UPGRADE_RESPONSE:
             {
-                /* Codes_SRS_UWS_CLIENT_01_378: [ When `on_underlying_io_bytes_received` is called while the uws is OPENING, the received bytes shall be accumulated in order to attempt parsing the WebSocket Upgrade response. ]*/
-                unsigned char* new_received_bytes = (unsigned char*)realloc(uws_client->received_bytes, uws_client->received_bytes_count + size + 1);
-                if (new_received_bytes == NULL)
+                size_t bytes_consumed;
+
+                decode_stream = 0;
+
+                /* Codes_SRS_UWS_CLIENT_01_378: [ When `on_underlying_io_bytes_received` is called while the uws is OPENING, the received bytes shall be handed to an HTTP response parser in order to attempt parsing the WebSocket Upgrade response. ]*/
+                /* Codes_SRS_UWS_CLIENT_01_532: [ The HTTP response parser shall be created by calling `http_response_parser_create` the first time bytes are received for the WebSocket Upgrade response. ]*/
+                if ((uws_client->upgrade_response_parser == NULL) &&
+                    ((uws_client->upgrade_response_parser = http_response_parser_create(on_upgrade_response_status, NULL, NULL, NULL, NULL, uws_client)) == NULL))
                 {
-                    /* Codes_SRS_UWS_CLIENT_01_379: [ If allocating memory for accumulating the bytes fails, uws shall report that the open failed by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_NOT_ENOUGH_MEMORY`. ]*/
+                    /* Codes_SRS_UWS_CLIENT_01_379: [ If creating the HTTP response parser fails, uws shall report that the open failed by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_NOT_ENOUGH_MEMORY`. ]*/
+                    LogError("Cannot create HTTP response parser");
                     indicate_ws_open_complete_error_and_close(uws_client, WS_OPEN_ERROR_NOT_ENOUGH_MEMORY);
-                    decode_stream = 0;
                 }
-                else
+                /* Codes_SRS_UWS_CLIENT_01_380: [ The status shall be read from the WebSocket upgrade response by the HTTP response parser, without the received bytes being accumulated. ]*/
+                else if (http_response_parser_parse(uws_client->upgrade_response_parser, buffer, size, &bytes_consumed) != 0)
+                {
+                    /* Codes_SRS_UWS_CLIENT_01_383: [ If the WebSocket upgrade request cannot be decoded an error shall be indicated by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_BAD_UPGRADE_RESPONSE`. ]*/
+                    LogError("Cannot decode HTTP response");
+                    indicate_ws_open_complete_error_and_close(uws_client, WS_OPEN_ERROR_BAD_UPGRADE_RESPONSE);
+                }
+                /* Codes_SRS_UWS_CLIENT_01_478: [ A Status-Line with a 101 response code as per RFC 2616 [RFC2616]. ]*/
+                else if ((uws_client->upgrade_response_status_code != 0) &&
+                    (uws_client->upgrade_response_status_code != 101))
+                {
+                    /* Codes_SRS_UWS_CLIENT_01_382: [ If a negative status is decoded from the WebSocket upgrade request, an error shall be indicated by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_BAD_RESPONSE_STATUS`. ]*/
+                    LogError("Bad status (%d) received in WebSocket Upgrade response", uws_client->upgrade_response_status_code);
+                    indicate_ws_open_complete_error_and_close(uws_client, WS_OPEN_ERROR_BAD_RESPONSE_STATUS);
+                }
+                else if (http_response_parser_is_complete(uws_client->upgrade_response_parser))
                 {
-                    uws_client->received_bytes = new_received_bytes;
-                    (void)memcpy(uws_client->received_bytes + uws_client->received_bytes_count, buffer, size);
-                    uws_client->received_bytes_count += size;
+                    destroy_upgrade_response_parser(uws_client);
 
-                    decode_stream = 1;
+                    /* Codes_SRS_UWS_CLIENT_01_384: [ Any extra bytes that are left unconsumed after decoding a succesfull WebSocket upgrade response shall be used for decoding WebSocket frames ]*/
+                    if ((bytes_consumed < size) &&
+                        (append_received_bytes(uws_client, buffer + bytes_consumed, size - bytes_consumed) != 0))
+                    {
+                        /* Codes_SRS_UWS_CLIENT_01_533: [ If allocating memory for the extra bytes fails, uws shall report that the open failed by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_NOT_ENOUGH_MEMORY`. ]*/
+                        indicate_ws_open_complete_error_and_close(uws_client, WS_OPEN_ERROR_NOT_ENOUGH_MEMORY);
+                    }
+                    else
+                    {
+                        /* Codes_SRS_UWS_CLIENT_01_381: [ If the status is 101, uws shall be considered OPEN and this shall be indicated by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `IO_OPEN_OK`. ]*/
+                        uws_client->uws_state = UWS_STATE_OPEN;
+
+                        /* Codes_SRS_UWS_CLIENT_01_065: [ When the client is to _Establish a WebSocket Connection_ given a set of (/host/, /port/, /resource name/, and /secure/ flag), along with a list of /protocols/ and /extensions/ to be used, and an /origin/ in the case of web browsers, it MUST open a connection, send an opening handshake, and read the server's handshake in response. ]*/
+                        /* Codes_SRS_UWS_CLIENT_01_115: [ If the server's response is validated as provided for above, it is said that _The WebSocket Connection is Established_ and that the WebSocket Connection is in the OPEN state. ]*/
+                        uws_client->on_ws_open_complete(uws_client->on_ws_open_complete_context, WS_OPEN_OK);
+
+                        decode_stream = 1;
+                    }
                 }
 
                 break;
@@ -990,21 +981,15 @@ static void on_underlying_io_bytes_received(void* context, const unsigned char*
             case UWS_STATE_CLOSING_WAITING_FOR_CLOSE:
             {
                 /* Codes_SRS_UWS_CLIENT_01_385: [ If the state of the uws instance is OPEN, the received bytes shall be used for decoding WebSocket frames. ]*/
-                unsigned char* new_received_bytes = (unsigned char*)realloc(uws_client->received_bytes, uws_client->received_bytes_count + size + 1);
-                if (new_received_bytes == NULL)
+                if (append_received_bytes(uws_client, buffer, size) != 0)
                 {
                     /* Codes_SRS_UWS_CLIENT_01_418: [ If allocating memory for the bytes accumulated for decoding WebSocket frames fails, an error shall be indicated by calling the `on_ws_error` callback with `WS_ERROR_NOT_ENOUGH_MEMORY`. ]*/
-                    LogError("Cannot allocate memory for received data");
                     indicate_ws_error(uws_client, WS_ERROR_NOT_ENOUGH_MEMORY);
 
                     decode_stream = 0;
                 }
                 else
                 {
-                    uws_client->received_bytes = new_received_bytes;
-                    (void)memcpy(uws_client->received_bytes + uws_client->received_bytes_count, buffer, size);
-                    uws_client->received_bytes_count += size;
-                
                     decode_stream = 1;
                 }
 
@@ -1027,56 +1012,6 @@ static void on_underlying_io_bytes_received(void* context, const unsigned char*
                     indicate_ws_open_complete_error_and_close(uws_client, WS_OPEN_ERROR_BYTES_RECEIVED_BEFORE_UNDERLYING_OPEN);
                     break;
 
-                case UWS_STATE_WAITING_FOR_UPGRADE_RESPONSE:
-                {
-                    const char* request_end_ptr;
-
-                    /* Make sure it is zero terminated */
-                    uws_client->received_bytes[uws_client->received_bytes_count] = '\0';
-
-                    /* Codes_SRS_UWS_CLIENT_01_380: [ If an WebSocket Upgrade request can be parsed from the accumulated bytes, the status shall be read from the WebSocket upgrade response. ]*/
-                    /* Codes_SRS_UWS_CLIENT_01_381: [ If the status is 101, uws shall be considered OPEN and this shall be indicated by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `IO_OPEN_OK`. ]*/
-                    if ((uws_client->received_bytes_count >= 4) &&
-                        ((request_end_ptr = strstr((const char*)uws_client->received_bytes, "\r\n\r\n")) != NULL))
-                    {
-                        int status_code;
-
-                        /* This part should really be done with the HTTPAPI, but that has to be done as a separate step
-                        as the HTTPAPI has to expose somehow the underlying IO and currently this would be a too big of a change. */
-
-                        /* Codes_SRS_UWS_CLIENT_01_382: [ If a negative status is decoded from the WebSocket upgrade request, an error shall be indicated by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_BAD_RESPONSE_STATUS`. ]*/
-                        /* Codes_SRS_UWS_CLIENT_01_478: [ A Status-Line with a 101 response code as per RFC 2616 [RFC2616]. ]*/
-                        if (ParseHttpResponse((const char*)uws_client->received_bytes, &status_code) != 0)
-                        {
-                            /* Codes_SRS_UWS_CLIENT_01_383: [ If the WebSocket upgrade request cannot be decoded an error shall be indicated by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_BAD_UPGRADE_RESPONSE`. ]*/
-                            LogError("Cannot decode HTTP response");
-                            indicate_ws_open_complete_error_and_close(uws_client, WS_OPEN_ERROR_BAD_UPGRADE_RESPONSE);
-                        }
-                        else if (status_code != 101)
-                        {
-                            /* Codes_SRS_UWS_CLIENT_01_382: [ If a negative status is decoded from the WebSocket upgrade request, an error shall be indicated by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_BAD_RESPONSE_STATUS`. ]*/
-                            LogError("Bad status (%d) received in WebSocket Upgrade response", status_code);
-                            indicate_ws_open_complete_error_and_close(uws_client, WS_OPEN_ERROR_BAD_RESPONSE_STATUS);
-                        }
-                        else
-                        {
-                            /* Codes_SRS_UWS_CLIENT_01_384: [ Any extra bytes that are left unconsumed after decoding a succesfull WebSocket upgrade response shall be used for decoding WebSocket frames ]*/
-                            consume_received_bytes(uws_client, request_end_ptr - (char*)uws_client->received_bytes + 4);
-
-                            /* Codes_SRS_UWS_CLIENT_01_381: [ If the status is 101, uws shall be considered OPEN and this shall be indicated by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `IO_OPEN_OK`. ]*/
-                            uws_client->uws_state = UWS_STATE_OPEN;
-
-                            /* Codes_SRS_UWS_CLIENT_01_065: [ When the client is to _Establish a WebSocket Connection_ given a set of (/host/, /port/, /resource name/, and /secure/ flag), along with a list of /protocols/ and /extensions/ to be used, and an /origin/ in the case of web browsers, it MUST open a connection, send an opening handshake, and read the server's handshake in response. ]*/
-                            /* Codes_SRS_UWS_CLIENT_01_115: [ If the server's response is validated as provided for above, it is said that _The WebSocket Connection is Established_ and that the WebSocket Connection is in the OPEN state. ]*/
-                            uws_client->on_ws_open_complete(uws_client->on_ws_open_complete_context, WS_OPEN_OK);
-
-                            decode_stream = 1;
-                        }
-                    }
-
-                    break;
-                }
-
                 case UWS_STATE_OPEN:
                 case UWS_STATE_CLOSING_WAITING_FOR_CLOSE:
                 {
@@ -1192,8 +1127,59 @@ static void on_underlying_io_bytes_received(void* context, const unsigned char*
                                 /* Codes_SRS_UWS_CLIENT_01_280: [ Upon receiving a data frame (Section 5.6), the endpoint MUST note the /type/ of the data as defined by the opcode (frame-opcode) from Section 5.2. ]*/
                                 /* Codes_SRS_UWS_CLIENT_01_281: [ The "Application data" from this frame is defined as the /data/ of the message. ]*/
                                 /* Codes_SRS_UWS_CLIENT_01_282: [ If the frame comprises an unfragmented message (Section 5.4), it is said that _A WebSocket Message Has Been Received_ with type /type/ and data /data/. ]*/
-                                uws_client->on_ws_frame_received(uws_client->on_ws_frame_received_context, WS_FRAME_TYPE_TEXT, uws_client->received_bytes + needed_bytes - length, length);
-                                decode_stream = 1;
+                            {
+                                const unsigned char* payload = uws_client->received_bytes + needed_bytes - length;
+                                bool is_valid_utf8;
+
+                                /* Codes_SRS_UWS_CLIENT_01_261: [ The "Payload data" is text data encoded as UTF-8. ]*/
+                                if ((uws_client->received_bytes[0] & 0x80) != 0)
+                                {
+                                    uws_client->is_receiving_text_message = false;
+                                    is_valid_utf8 = utf8_checker_is_valid_utf8(payload, length);
+                                }
+                                else
+                                {
+                                    /* Codes_SRS_UWS_CLIENT_01_262: [ a particular text frame might include a partial UTF-8 sequence; however, the whole message MUST contain valid UTF-8. ]*/
+                                    uws_client->is_receiving_text_message = true;
+                                    utf8_checker_init(&uws_client->text_message_utf8_state);
+                                    is_valid_utf8 = utf8_checker_update(&uws_client->text_message_utf8_state, payload, length);
+                                }
+
+                                if (!is_valid_utf8)
+                                {
+                                    /* Codes_SRS_UWS_CLIENT_01_342: [ When an endpoint is to interpret a byte stream as UTF-8 but finds that the byte stream is not, in fact, a valid UTF-8 stream, that endpoint MUST _Fail the WebSocket Connection_. ]*/
+                                    /* Codes_SRS_UWS_CLIENT_01_331: [ 1007 indicates that an endpoint is terminating the connection because it has received data within a message that was not consistent with the type of the message (e.g., non-UTF-8 [RFC3629] data within a text message). ]*/
+                                    LogError("Received a text frame that is not UTF-8");
+                                    indicate_ws_error_and_close(uws_client, WS_ERROR_BAD_FRAME_RECEIVED, CLOSE_INCONSISTENT_DATA_IN_MESSAGE);
+                                }
+                                else
+                                {
+                                    uws_client->on_ws_frame_received(uws_client->on_ws_frame_received_context, WS_FRAME_TYPE_TEXT, payload, length);
+                                    decode_stream = 1;
+                                }
+                                break;
+                            }
+
+                                /* Codes_SRS_UWS_CLIENT_01_152: [ *  %x0 denotes a continuation frame ]*/
+                            case (unsigned char)WS_CONTINUATION_FRAME:
+                                /* Codes_SRS_UWS_CLIENT_01_263: [ Invalid UTF-8 in reassembled messages is handled as described in Section 8.1. ]*/
+                                if (uws_client->is_receiving_text_message)
+                                {
+                                    bool is_valid_utf8 = utf8_checker_update(&uws_client->text_message_utf8_state, uws_client->received_bytes + needed_bytes - length, length);
+
+                                    if ((uws_client->received_bytes[0] & 0x80) != 0)
+                                    {
+                                        uws_client->is_receiving_text_message = false;
+                                        is_valid_utf8 = is_valid_utf8 && utf8_checker_final(&uws_client->text_message_utf8_state);
+                                    }
+
+                                    if (!is_valid_utf8)
+                                    {
+                                        /* Codes_SRS_UWS_CLIENT_01_342: [ When an endpoint is to interpret a byte stream as UTF-8 but finds that the byte stream is not, in fact, a valid UTF-8 stream, that endpoint MUST _Fail the WebSocket Connection_. ]*/
+                                        LogError("Received a text message that is not UTF-8");
+                                        indicate_ws_error_and_close(uws_client, WS_ERROR_BAD_FRAME_RECEIVED, CLOSE_INCONSISTENT_DATA_IN_MESSAGE);
+                                    }
+                                }
                                 break;
 
                                 /* Codes_SRS_UWS_CLIENT_01_154: [ *  %x2 denotes a binary frame ]*/
@@ -1452,6 +1438,12 @@ int uws_client_open_async(UWS_CLIENT_HANDLE uws_client, ON_WS_OPEN_COMPLETE on_w
             uws_client->uws_state = UWS_STATE_OPENING_UNDERLYING_IO;
 
             uws_client->received_bytes_count = 0;
+            uws_client->upgrade_response_status_code = 0;
+            uws_client->is_receiving_text_message = false;
+            if (uws_client->upgrade_response_parser != NULL)
+            {
+                http_response_parser_reset(uws_client->upgrade_response_parser);
+            }
 
             uws_client->on_ws_open_complete = on_ws_open_complete;
             uws_client->on_ws_open_complete_context = on_ws_open_complete_context;
@@ -1504,7 +1496,7 @@ static int complete_send_frame(WS_PENDING_SEND* ws_pending_send, LIST_ITEM_HANDL
         }
 
         /* Codes_SRS_UWS_CLIENT_01_434: [ The memory associated with the sent frame shall be freed. ]*/
-        free(ws_pending_send);
+        SLABALLOC_FREE(ws_pending_send);
 
         result = 0;
     }
@@ -1707,7 +1699,7 @@ int uws_client_send_frame_async(UWS_CLIENT_HANDLE uws_client, unsigned char fram
     }
     else
     {
-        WS_PENDING_SEND* ws_pending_send = (WS_PENDING_SEND*)malloc(sizeof(WS_PENDING_SEND));
+        WS_PENDING_SEND* ws_pending_send = (WS_PENDING_SEND*)SLABALLOC_MALLOC(sizeof(WS_PENDING_SEND));
         if (ws_pending_send == NULL)
         {
             /* Codes_SRS_UWS_CLIENT_01_047: [ If allocating memory for the newly queued item fails, `uws_client_send_frame_async` shall fail and return a non-zero value. ]*/
@@ -1727,7 +1719,7 @@ int uws_client_send_frame_async(UWS_CLIENT_HANDLE uws_client, unsigned char fram
             {
                 /* Codes_SRS_UWS_CLIENT_01_426: [ If `uws_frame_encoder_encode` fails, `uws_client_send_frame_async` shall fail and return a non-zero value. ]*/
                 LogError("Failed encoding WebSocket frame");
-                free(ws_pending_send);
+                SLABALLOC_FREE(ws_pending_send);
                 result = __FAILURE__;
             }
             else
@@ -1755,7 +1747,7 @@ int uws_client_send_frame_async(UWS_CLIENT_HANDLE uws_client, unsigned char fram
                 {
                     /* Codes_SRS_UWS_CLIENT_01_049: [ If `singlylinkedlist_add` fails, `uws_client_send_frame_async` shall fail and return a non-zero value. ]*/
                     LogError("Could not allocate memory for pending frames");
-                    free(ws_pending_send);
+                    SLABALLOC_FREE(ws_pending_send);
                     result = __FAILURE__;
                 }
                 else
@@ -1772,7 +1764,7 @@ int uws_client_send_frame_async(UWS_CLIENT_HANDLE uws_client, unsigned char fram
                         /* Codes_SRS_UWS_CLIENT_01_058: [ If `xio_send` fails, `uws_client_send_frame_async` shall fail and return a non-zero value. ]*/
                         LogError("Could not send bytes through the underlying IO");
                         (void)singlylinkedlist_remove(uws_client->pending_sends, new_pending_send_list_item);
-                        free(ws_pending_send);
+                        SLABALLOC_FREE(ws_pending_send);
                         result = __FAILURE__;
                     }
                     else
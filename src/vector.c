@@ -32,6 +32,7 @@ VECTOR_HANDLE VECTOR_create(size_t elementSize)
             /* Codes_SRS_VECTOR_10_001: [VECTOR_create shall allocate a VECTOR_HANDLE that will contain an empty vector.The size of each element is given with the parameter elementSize.] */
             result->storage = NULL;
             result->count = 0;
+            result->capacity = 0;
             result->elementSize = elementSize;
         }
     }
@@ -74,11 +75,40 @@ VECTOR_HANDLE VECTOR_move(VECTOR_HANDLE handle)
         {
             /* Codes_SRS_VECTOR_10_004: [VECTOR_move shall allocate a VECTOR_HANDLE and move the data to it from the given handle.] */
             result->count = handle->count;
+            result->capacity = handle->capacity;
             result->elementSize = handle->elementSize;
             result->storage = handle->storage;
 
             handle->storage = NULL;
             handle->count = 0;
+            handle->capacity = 0;
+        }
+    }
+    return result;
+}
+
+/* resizes the storage to hold exactly newCapacity elements; the contents are kept on failure */
+static int set_capacity(VECTOR* handle, size_t newCapacity)
+{
+    int result;
+    if (newCapacity > ((size_t)-1) / handle->elementSize)
+    {
+        LogError("capacity(%zd) is too large.", newCapacity);
+        result = __FAILURE__;
+    }
+    else
+    {
+        void* temp = realloc(handle->storage, handle->elementSize * newCapacity);
+        if (temp == NULL)
+        {
+            LogError("realloc failed.");
+            result = __FAILURE__;
+        }
+        else
+        {
+            handle->storage = temp;
+            handle->capacity = newCapacity;
+            result = 0;
         }
     }
     return result;
@@ -99,23 +129,47 @@ int VECTOR_push_back(VECTOR_HANDLE handle, const void* elements, size_t numEleme
     }
     else
     {
-        size_t curSize = handle->elementSize * handle->count;
-        size_t appendSize = handle->elementSize * numElements;
-
-        void* temp = realloc(handle->storage, curSize + appendSize);
-        if (temp == NULL)
+        if (numElements > ((size_t)-1) - handle->count)
         {
-           /* Codes_SRS_VECTOR_10_012: [VECTOR_push_back shall fail and return non-zero if memory allocation fails.] */
-            LogError("realloc failed.");
+            /* Codes_SRS_VECTOR_10_012: [VECTOR_push_back shall fail and return non-zero if memory allocation fails.] */
+            LogError("invalid argument - numElements(%zd) is too large.", numElements);
             result = __FAILURE__;
         }
         else
         {
-            /* Codes_SRS_VECTOR_10_013: [VECTOR_push_back shall append the given elements and return 0 indicating success.] */
-            (void)memcpy((unsigned char*)temp + curSize, elements, appendSize);
-            handle->storage = temp;
-            handle->count += numElements;
-            result = 0;
+            size_t needed = handle->count + numElements;
+            if (needed <= handle->capacity)
+            {
+                /* Codes_SRS_VECTOR_01_002: [If the capacity of the vector is large enough, VECTOR_push_back shall not allocate memory.] */
+                result = 0;
+            }
+            else
+            {
+                /* Codes_SRS_VECTOR_01_001: [Otherwise VECTOR_push_back shall grow the capacity to the larger of twice the current capacity and the number of elements needed.] */
+                size_t newCapacity = (handle->capacity > ((size_t)-1) / 2) ? needed : handle->capacity * 2;
+                if (newCapacity < needed)
+                {
+                    newCapacity = needed;
+                }
+
+                if (set_capacity(handle, newCapacity) != 0)
+                {
+                    /* Codes_SRS_VECTOR_10_012: [VECTOR_push_back shall fail and return non-zero if memory allocation fails.] */
+                    LogError("unable to grow the vector to %zd elements.", newCapacity);
+                    result = __FAILURE__;
+                }
+                else
+                {
+                    result = 0;
+                }
+            }
+
+            if (result == 0)
+            {
+                /* Codes_SRS_VECTOR_10_013: [VECTOR_push_back shall append the given elements and return 0 indicating success.] */
+                (void)memcpy((unsigned char*)handle->storage + (handle->elementSize * handle->count), elements, handle->elementSize * numElements);
+                handle->count = needed;
+            }
         }
     }
     return result;
@@ -159,33 +213,35 @@ void VECTOR_erase(VECTOR_HANDLE handle, void* elements, size_t numElements)
                 }
                 else
                 {
-                    /* Codes_SRS_VECTOR_10_014: [VECTOR_erase shall remove the 'numElements' starting at 'elements' and reduce its internal storage.] */
+                    /* Codes_SRS_VECTOR_10_014: [VECTOR_erase shall remove the `numElements` starting at `elements`.] */
+                    /* Codes_SRS_VECTOR_01_003: [VECTOR_erase shall not reallocate the internal storage.] */
+                    (void)memmove(elements, src, srcEnd - src);
                     handle->count -= numElements;
-                    if (handle->count == 0)
-                    {
-                        free(handle->storage);
-                        handle->storage = NULL;
-                    }
-                    else
-                    {
-                        void* tmp;
-                        (void)memmove(elements, src, srcEnd - src);
-                        tmp = realloc(handle->storage, (handle->elementSize * handle->count));
-                        if (tmp == NULL)
-                        {
-                            LogInfo("realloc failed. Keeping original internal storage pointer.");
-                        }
-                        else
-                        {
-                            handle->storage = tmp;
-                        }
-                    }
                 }
             }
         }
     }
 }
 
+void VECTOR_pop_back(VECTOR_HANDLE handle)
+{
+    if (handle == NULL)
+    {
+        /* Codes_SRS_VECTOR_01_004: [VECTOR_pop_back shall return if `handle` is NULL.] */
+        LogError("invalid argument handle(NULL).");
+    }
+    else if (handle->count == 0)
+    {
+        /* Codes_SRS_VECTOR_01_005: [VECTOR_pop_back shall return if the vector is empty.] */
+        LogError("vector is empty.");
+    }
+    else
+    {
+        /* Codes_SRS_VECTOR_01_006: [VECTOR_pop_back shall remove the last element of the vector without reallocating the internal storage.] */
+        handle->count--;
+    }
+}
+
 void VECTOR_clear(VECTOR_HANDLE handle)
 {
     /* Codes_SRS_VECTOR_10_017: [VECTOR_clear shall if the object is NULL or empty.] */
@@ -199,6 +255,7 @@ void VECTOR_clear(VECTOR_HANDLE handle)
         free(handle->storage);
         handle->storage = NULL;
         handle->count = 0;
+        handle->capacity = 0;
     }
 }
 
@@ -336,3 +393,84 @@ size_t VECTOR_size(VECTOR_HANDLE handle)
     }
     return result;
 }
+
+size_t VECTOR_capacity(VECTOR_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_VECTOR_01_008: [VECTOR_capacity shall return 0 if the given handle is NULL.] */
+        LogError("invalid argument handle(NULL).");
+        result = 0;
+    }
+    else
+    {
+        /* Codes_SRS_VECTOR_01_007: [VECTOR_capacity shall return the number of elements the vector can hold without allocating memory.] */
+        result = handle->capacity;
+    }
+    return result;
+}
+
+int VECTOR_reserve(VECTOR_HANDLE handle, size_t numElements)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_VECTOR_01_009: [VECTOR_reserve shall fail and return non-zero if `handle` is NULL.] */
+        LogError("invalid argument handle(NULL).");
+        result = __FAILURE__;
+    }
+    else if (numElements <= handle->capacity)
+    {
+        /* Codes_SRS_VECTOR_01_010: [If `numElements` is not larger than the capacity, VECTOR_reserve shall return 0 without allocating memory.] */
+        result = 0;
+    }
+    /* Codes_SRS_VECTOR_01_011: [Otherwise VECTOR_reserve shall resize the internal storage to hold exactly `numElements` elements and return 0.] */
+    else if (set_capacity(handle, numElements) != 0)
+    {
+        /* Codes_SRS_VECTOR_01_012: [VECTOR_reserve shall fail and return non-zero if memory allocation fails, leaving the vector unchanged.] */
+        LogError("unable to reserve %zd elements.", numElements);
+        result = __FAILURE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+int VECTOR_shrink_to_fit(VECTOR_HANDLE handle)
+{
+    int result;
+    if (handle == NULL)
+    {
+        /* Codes_SRS_VECTOR_01_013: [VECTOR_shrink_to_fit shall fail and return non-zero if `handle` is NULL.] */
+        LogError("invalid argument handle(NULL).");
+        result = __FAILURE__;
+    }
+    else if (handle->count == handle->capacity)
+    {
+        /* Codes_SRS_VECTOR_01_014: [If the capacity already equals the number of elements, VECTOR_shrink_to_fit shall return 0 without touching the internal storage.] */
+        result = 0;
+    }
+    else if (handle->count == 0)
+    {
+        /* Codes_SRS_VECTOR_01_015: [If the vector is empty, VECTOR_shrink_to_fit shall free the internal storage and return 0.] */
+        free(handle->storage);
+        handle->storage = NULL;
+        handle->capacity = 0;
+        result = 0;
+    }
+    /* Codes_SRS_VECTOR_01_016: [Otherwise VECTOR_shrink_to_fit shall resize the internal storage to hold exactly the elements of the vector and return 0.] */
+    else if (set_capacity(handle, handle->count) != 0)
+    {
+        /* Codes_SRS_VECTOR_01_017: [VECTOR_shrink_to_fit shall fail and return non-zero if memory allocation fails, leaving the vector unchanged.] */
+        LogError("unable to shrink the vector to %zd elements.", handle->count);
+        result = __FAILURE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
@@ -0,0 +1,813 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+static void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* my_gballoc_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_gballoc_free(void* s)
+{
+    free(s);
+}
+
+#define ENABLE_MOCKS
+#include "azure_c_shared_utility/gballoc.h"
+#undef ENABLE_MOCKS
+
+#include "azure_c_shared_utility/arena.h"
+
+#include "testrunnerswitcher.h"
+#include "umock_c.h"
+
+#define TEST_BLOCK_SIZE 256
+/* must match ARENA_MAX_RETAINED_BLOCKS */
+#define TEST_MAX_RETAINED_BLOCKS 16
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    char temp_str[256];
+    (void)snprintf(temp_str, sizeof(temp_str), "umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+    ASSERT_FAIL(temp_str);
+}
+
+static TEST_MUTEX_HANDLE g_testByTest;
+static TEST_MUTEX_HANDLE g_dllByDll;
+
+static ARENA_HANDLE create_arena(void)
+{
+    ARENA_HANDLE arena = ARENA_create(TEST_BLOCK_SIZE);
+    ASSERT_IS_NOT_NULL(arena);
+    umock_c_reset_all_calls();
+    return arena;
+}
+
+static void fill(void* ptr, size_t size, unsigned char value)
+{
+    (void)memset(ptr, value, size);
+}
+
+static void assert_filled(const void* ptr, size_t size, unsigned char value)
+{
+    size_t i;
+    for (i = 0; i < size; i++)
+    {
+        ASSERT_ARE_EQUAL(int, (int)value, (int)((const unsigned char*)ptr)[i]);
+    }
+}
+
+BEGIN_TEST_SUITE(arena_UnitTests)
+
+    TEST_SUITE_INITIALIZE(TestClassInitialize)
+    {
+        TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+
+        g_testByTest = TEST_MUTEX_CREATE();
+        ASSERT_IS_NOT_NULL(g_testByTest);
+
+        int result = umock_c_init(on_umock_c_error);
+        ASSERT_ARE_EQUAL(int, 0, result);
+
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+        REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_realloc, my_gballoc_realloc);
+        REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_realloc, NULL);
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+    }
+
+    TEST_SUITE_CLEANUP(TestClassCleanup)
+    {
+        umock_c_deinit();
+        TEST_MUTEX_DESTROY(g_testByTest);
+
+        TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+    }
+
+    TEST_FUNCTION_INITIALIZE(TestMethodInitialize)
+    {
+        if (TEST_MUTEX_ACQUIRE(g_testByTest))
+        {
+            ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+        }
+
+        umock_c_reset_all_calls();
+    }
+
+    TEST_FUNCTION_CLEANUP(TestMethodCleanup)
+    {
+        TEST_MUTEX_RELEASE(g_testByTest);
+    }
+
+    /* ARENA_create */
+
+    /* Tests_SRS_ARENA_01_001: [ If block_size is 0, ARENA_create shall fail and return NULL. ]*/
+    TEST_FUNCTION(ARENA_create_with_0_block_size_fails)
+    {
+        ///act
+        ARENA_HANDLE arena = ARENA_create(0);
+
+        ///assert
+        ASSERT_IS_NULL(arena);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_ARENA_01_002: [ ARENA_create shall allocate a new arena with malloc and return a non-NULL handle to it. ]*/
+    /* Tests_SRS_ARENA_01_004: [ ARENA_create shall not allocate any block, the first block is allocated by the first allocation. ]*/
+    TEST_FUNCTION(ARENA_create_allocates_only_the_arena)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        ARENA_HANDLE arena = ARENA_create(TEST_BLOCK_SIZE);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(arena);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_003: [ If malloc fails, ARENA_create shall fail and return NULL. ]*/
+    TEST_FUNCTION(when_malloc_fails_ARENA_create_fails)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        ARENA_HANDLE arena = ARENA_create(TEST_BLOCK_SIZE);
+
+        ///assert
+        ASSERT_IS_NULL(arena);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* ARENA_destroy */
+
+    /* Tests_SRS_ARENA_01_005: [ If arena is NULL, ARENA_destroy shall do nothing. ]*/
+    TEST_FUNCTION(ARENA_destroy_with_NULL_arena_does_nothing)
+    {
+        ///act
+        ARENA_destroy(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_ARENA_01_006: [ ARENA_destroy shall free all the blocks of the arena and the arena itself. ]*/
+    TEST_FUNCTION(ARENA_destroy_frees_all_blocks_and_the_arena)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        ASSERT_IS_NOT_NULL(ARENA_malloc(arena, TEST_BLOCK_SIZE / 2));
+        ASSERT_IS_NOT_NULL(ARENA_malloc(arena, TEST_BLOCK_SIZE / 2));
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(gballoc_free(arena));
+
+        ///act
+        ARENA_destroy(arena);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* ARENA_malloc */
+
+    /* Tests_SRS_ARENA_01_007: [ If arena is NULL, ARENA_malloc shall fail and return NULL. ]*/
+    TEST_FUNCTION(ARENA_malloc_with_NULL_arena_fails)
+    {
+        ///act
+        void* result = ARENA_malloc(NULL, 1);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_ARENA_01_008: [ If size plus the size of the allocation header overflows, ARENA_malloc shall fail and return NULL. ]*/
+    TEST_FUNCTION(ARENA_malloc_with_size_that_overflows_fails)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+
+        ///act
+        void* result = ARENA_malloc(arena, SIZE_MAX - 1);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_009: [ Otherwise ARENA_malloc shall return size bytes carved from the current block of the arena, aligned for any fundamental type. ]*/
+    /* Tests_SRS_ARENA_01_010: [ If the current block does not have room for the allocation, ARENA_malloc shall allocate a new block of block_size bytes, or of as many bytes as the allocation needs if that is more, by calling malloc. ]*/
+    TEST_FUNCTION(ARENA_malloc_allocates_a_block_for_the_first_allocation)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        void* result = ARENA_malloc(arena, 10);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        fill(result, 10, 'a');
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_009: [ Otherwise ARENA_malloc shall return size bytes carved from the current block of the arena, aligned for any fundamental type. ]*/
+    TEST_FUNCTION(ARENA_malloc_carves_allocations_from_the_same_block)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        unsigned char* first = (unsigned char*)ARENA_malloc(arena, 3);
+        ASSERT_IS_NOT_NULL(first);
+        fill(first, 3, 'a');
+        umock_c_reset_all_calls();
+
+        ///act
+        unsigned char* second = (unsigned char*)ARENA_malloc(arena, 5);
+        double* third = (double*)ARENA_malloc(arena, sizeof(double));
+
+        ///assert
+        ASSERT_IS_NOT_NULL(second);
+        ASSERT_IS_NOT_NULL(third);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_IS_TRUE(second >= first + 3);
+        ASSERT_ARE_EQUAL(size_t, 0, ((uintptr_t)second) % sizeof(void*));
+        ASSERT_ARE_EQUAL(size_t, 0, ((uintptr_t)third) % sizeof(double));
+        fill(second, 5, 'b');
+        *third = 1.5;
+        assert_filled(first, 3, 'a');
+        assert_filled(second, 5, 'b');
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_010: [ If the current block does not have room for the allocation, ARENA_malloc shall allocate a new block of block_size bytes, or of as many bytes as the allocation needs if that is more, by calling malloc. ]*/
+    TEST_FUNCTION(ARENA_malloc_allocates_a_new_block_when_the_current_one_is_full)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        void* first = ARENA_malloc(arena, TEST_BLOCK_SIZE / 2);
+        ASSERT_IS_NOT_NULL(first);
+        fill(first, TEST_BLOCK_SIZE / 2, 'a');
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        void* second = ARENA_malloc(arena, TEST_BLOCK_SIZE / 2);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(second);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        fill(second, TEST_BLOCK_SIZE / 2, 'b');
+        assert_filled(first, TEST_BLOCK_SIZE / 2, 'a');
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_010: [ If the current block does not have room for the allocation, ARENA_malloc shall allocate a new block of block_size bytes, or of as many bytes as the allocation needs if that is more, by calling malloc. ]*/
+    TEST_FUNCTION(ARENA_malloc_larger_than_block_size_allocates_a_block_that_fits)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+
+        ///act
+        void* result = ARENA_malloc(arena, TEST_BLOCK_SIZE * 4);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        fill(result, TEST_BLOCK_SIZE * 4, 'a');
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_011: [ If allocating the block fails, ARENA_malloc shall fail and return NULL. ]*/
+    TEST_FUNCTION(when_allocating_the_block_fails_ARENA_malloc_fails)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        void* result = ARENA_malloc(arena, 10);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* ARENA_realloc */
+
+    /* Tests_SRS_ARENA_01_012: [ If arena is NULL, ARENA_realloc shall fail and return NULL. ]*/
+    TEST_FUNCTION(ARENA_realloc_with_NULL_arena_fails)
+    {
+        ///act
+        void* result = ARENA_realloc(NULL, NULL, 1);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_ARENA_01_013: [ If ptr is NULL, ARENA_realloc shall behave as ARENA_malloc. ]*/
+    TEST_FUNCTION(ARENA_realloc_with_NULL_ptr_allocates)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        void* result = ARENA_realloc(arena, NULL, 10);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        fill(result, 10, 'a');
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_014: [ If ptr is the most recent allocation of the arena and the current block has room for size bytes, ARENA_realloc shall grow or shrink the allocation in place and return ptr. ]*/
+    TEST_FUNCTION(ARENA_realloc_grows_the_last_allocation_in_place)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        void* ptr = ARENA_malloc(arena, 10);
+        ASSERT_IS_NOT_NULL(ptr);
+        fill(ptr, 10, 'a');
+        umock_c_reset_all_calls();
+
+        ///act
+        void* result = ARENA_realloc(arena, ptr, TEST_BLOCK_SIZE / 2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, ptr, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        assert_filled(result, 10, 'a');
+        fill(result, TEST_BLOCK_SIZE / 2, 'b');
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_014: [ If ptr is the most recent allocation of the arena and the current block has room for size bytes, ARENA_realloc shall grow or shrink the allocation in place and return ptr. ]*/
+    TEST_FUNCTION(ARENA_realloc_shrinking_the_last_allocation_gives_the_memory_back)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        unsigned char* ptr = (unsigned char*)ARENA_malloc(arena, TEST_BLOCK_SIZE / 2);
+        ASSERT_IS_NOT_NULL(ptr);
+        umock_c_reset_all_calls();
+
+        ///act
+        void* result = ARENA_realloc(arena, ptr, 8);
+        unsigned char* next = (unsigned char*)ARENA_malloc(arena, TEST_BLOCK_SIZE / 2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, ptr, result);
+        ASSERT_IS_NOT_NULL(next);
+        ASSERT_IS_TRUE(next < ptr + TEST_BLOCK_SIZE / 2);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_015: [ If ptr is not the most recent allocation and size is not greater than its size, ARENA_realloc shall return ptr. ]*/
+    TEST_FUNCTION(ARENA_realloc_shrinking_an_older_allocation_returns_ptr)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        void* ptr = ARENA_malloc(arena, 20);
+        ASSERT_IS_NOT_NULL(ptr);
+        ASSERT_IS_NOT_NULL(ARENA_malloc(arena, 20));
+        fill(ptr, 20, 'a');
+        umock_c_reset_all_calls();
+
+        ///act
+        void* result = ARENA_realloc(arena, ptr, 10);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, ptr, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        assert_filled(result, 10, 'a');
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_016: [ Otherwise ARENA_realloc shall allocate size bytes with ARENA_malloc, copy the content of ptr and return the new memory. ]*/
+    TEST_FUNCTION(ARENA_realloc_growing_an_older_allocation_copies_it)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        void* ptr = ARENA_malloc(arena, 10);
+        ASSERT_IS_NOT_NULL(ptr);
+        ASSERT_IS_NOT_NULL(ARENA_malloc(arena, 10));
+        fill(ptr, 10, 'a');
+        umock_c_reset_all_calls();
+
+        ///act
+        void* result = ARENA_realloc(arena, ptr, 40);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_NOT_EQUAL(void_ptr, ptr, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        assert_filled(result, 10, 'a');
+        fill(result, 40, 'b');
+        assert_filled(ptr, 10, 'a');
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_016: [ Otherwise ARENA_realloc shall allocate size bytes with ARENA_malloc, copy the content of ptr and return the new memory. ]*/
+    TEST_FUNCTION(ARENA_realloc_growing_the_last_allocation_past_the_block_moves_it_to_a_new_block)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        void* ptr = ARENA_malloc(arena, 10);
+        ASSERT_IS_NOT_NULL(ptr);
+        fill(ptr, 10, 'a');
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        void* result = ARENA_realloc(arena, ptr, TEST_BLOCK_SIZE * 2);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_NOT_EQUAL(void_ptr, ptr, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        assert_filled(result, 10, 'a');
+        fill(result, TEST_BLOCK_SIZE * 2, 'b');
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_017: [ If size plus the size of the allocation header overflows, ARENA_realloc shall fail and return NULL. ]*/
+    TEST_FUNCTION(ARENA_realloc_with_size_that_overflows_fails)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        void* ptr = ARENA_malloc(arena, 10);
+        ASSERT_IS_NOT_NULL(ptr);
+        umock_c_reset_all_calls();
+
+        ///act
+        void* result = ARENA_realloc(arena, ptr, SIZE_MAX - 1);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_018: [ If the allocation fails, ARENA_realloc shall return NULL and leave ptr unchanged. ]*/
+    TEST_FUNCTION(when_allocating_fails_ARENA_realloc_fails)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        void* ptr = ARENA_malloc(arena, 10);
+        ASSERT_IS_NOT_NULL(ptr);
+        fill(ptr, 10, 'a');
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        void* result = ARENA_realloc(arena, ptr, TEST_BLOCK_SIZE * 2);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        assert_filled(ptr, 10, 'a');
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* ARENA_free */
+
+    /* Tests_SRS_ARENA_01_019: [ If arena or ptr is NULL, ARENA_free shall do nothing. ]*/
+    TEST_FUNCTION(ARENA_free_with_NULL_arguments_does_nothing)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+
+        ///act
+        ARENA_free(NULL, NULL);
+        ARENA_free(arena, NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_020: [ If ptr is the most recent allocation of the arena, ARENA_free shall give its memory back to the current block. ]*/
+    TEST_FUNCTION(ARENA_free_of_the_last_allocation_gives_its_memory_back)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        void* ptr = ARENA_malloc(arena, 20);
+        ASSERT_IS_NOT_NULL(ptr);
+        umock_c_reset_all_calls();
+
+        ///act
+        ARENA_free(arena, ptr);
+        void* result = ARENA_malloc(arena, 20);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, ptr, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_021: [ Otherwise ARENA_free shall do nothing, the memory is reclaimed by ARENA_reset. ]*/
+    TEST_FUNCTION(ARENA_free_of_an_older_allocation_does_nothing)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        void* first = ARENA_malloc(arena, 20);
+        void* second = ARENA_malloc(arena, 20);
+        ASSERT_IS_NOT_NULL(first);
+        ASSERT_IS_NOT_NULL(second);
+        fill(second, 20, 'b');
+        umock_c_reset_all_calls();
+
+        ///act
+        ARENA_free(arena, first);
+        void* result = ARENA_malloc(arena, 20);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_NOT_EQUAL(void_ptr, first, result);
+        ASSERT_ARE_NOT_EQUAL(void_ptr, second, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        assert_filled(second, 20, 'b');
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* ARENA_strdup */
+
+    /* Tests_SRS_ARENA_01_022: [ If arena or source is NULL, ARENA_strdup shall fail and return NULL. ]*/
+    TEST_FUNCTION(ARENA_strdup_with_NULL_arguments_fails)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+
+        ///act
+        char* result1 = ARENA_strdup(NULL, "a");
+        char* result2 = ARENA_strdup(arena, NULL);
+
+        ///assert
+        ASSERT_IS_NULL(result1);
+        ASSERT_IS_NULL(result2);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_023: [ ARENA_strdup shall allocate strlen(source) + 1 bytes with ARENA_malloc, copy source into them and return them. ]*/
+    TEST_FUNCTION(ARENA_strdup_copies_the_string)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        char* result = ARENA_strdup(arena, "Content-Length");
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, "Content-Length", result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_024: [ If the allocation fails, ARENA_strdup shall fail and return NULL. ]*/
+    TEST_FUNCTION(when_allocating_fails_ARENA_strdup_fails)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        char* result = ARENA_strdup(arena, "Host");
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* ARENA_reset */
+
+    /* Tests_SRS_ARENA_01_025: [ If arena is NULL, ARENA_reset shall do nothing. ]*/
+    TEST_FUNCTION(ARENA_reset_with_NULL_arena_does_nothing)
+    {
+        ///act
+        ARENA_reset(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_ARENA_01_026: [ ARENA_reset shall make all the memory handed out by the arena available again. ]*/
+    TEST_FUNCTION(ARENA_reset_with_one_block_reuses_it)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        void* first = ARENA_malloc(arena, 20);
+        ASSERT_IS_NOT_NULL(first);
+        ASSERT_IS_NOT_NULL(ARENA_malloc(arena, 20));
+        umock_c_reset_all_calls();
+
+        ///act
+        ARENA_reset(arena);
+        void* result = ARENA_malloc(arena, 20);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, first, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_026: [ ARENA_reset shall make all the memory handed out by the arena available again. ]*/
+    TEST_FUNCTION(ARENA_reset_of_an_unused_arena_does_nothing)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+
+        ///act
+        ARENA_reset(arena);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_027: [ If the arena has more than one block, ARENA_reset shall free all of them and allocate a single block as large as all of them together, but not larger than ARENA_MAX_RETAINED_BLOCKS times block_size, so that the same work fits in one block the next time. ]*/
+    TEST_FUNCTION(ARENA_reset_with_several_blocks_coalesces_them)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        size_t i;
+        for (i = 0; i < 4; i++)
+        {
+            ASSERT_IS_NOT_NULL(ARENA_malloc(arena, TEST_BLOCK_SIZE / 2));
+        }
+        umock_c_reset_all_calls();
+
+        for (i = 0; i < 4; i++)
+        {
+            STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        }
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        ARENA_reset(arena);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        /* the same work now fits in the one block */
+        umock_c_reset_all_calls();
+        for (i = 0; i < 4; i++)
+        {
+            void* ptr = ARENA_malloc(arena, TEST_BLOCK_SIZE / 2);
+            ASSERT_IS_NOT_NULL(ptr);
+            fill(ptr, TEST_BLOCK_SIZE / 2, 'a');
+        }
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_027: [ If the arena has more than one block, ARENA_reset shall free all of them and allocate a single block as large as all of them together, but not larger than ARENA_MAX_RETAINED_BLOCKS times block_size, so that the same work fits in one block the next time. ]*/
+    TEST_FUNCTION(ARENA_reset_does_not_retain_more_than_the_maximum)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        ASSERT_IS_NOT_NULL(ARENA_malloc(arena, 10));
+        ASSERT_IS_NOT_NULL(ARENA_malloc(arena, TEST_BLOCK_SIZE * TEST_MAX_RETAINED_BLOCKS * 2));
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        ARENA_reset(arena);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        /* an allocation of the retained size takes a new block, proving the block is smaller than the large allocation */
+        umock_c_reset_all_calls();
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+        ASSERT_IS_NOT_NULL(ARENA_malloc(arena, TEST_BLOCK_SIZE * TEST_MAX_RETAINED_BLOCKS));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+    /* Tests_SRS_ARENA_01_028: [ If allocating the block fails, ARENA_reset shall leave the arena without blocks. ]*/
+    TEST_FUNCTION(when_allocating_the_block_fails_ARENA_reset_leaves_the_arena_empty)
+    {
+        ///arrange
+        ARENA_HANDLE arena = create_arena();
+        ASSERT_IS_NOT_NULL(ARENA_malloc(arena, TEST_BLOCK_SIZE / 2));
+        ASSERT_IS_NOT_NULL(ARENA_malloc(arena, TEST_BLOCK_SIZE / 2));
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        ARENA_reset(arena);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        /* the next allocation gets a new block */
+        umock_c_reset_all_calls();
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+        ASSERT_IS_NOT_NULL(ARENA_malloc(arena, 10));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        ARENA_destroy(arena);
+    }
+
+END_TEST_SUITE(arena_UnitTests)
@@ -1616,6 +1616,111 @@ TEST_FUNCTION(Base64_Encode_Bytes_exhaustive_succeeds)
     }
 }
 
+/*Tests_SRS_BASE64_01_001: [If source or encodedLength is NULL then Base64_Encode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Encode_Into_with_NULL_source_fails)
+{
+    ///arrange
+    char destination[8];
+    size_t encodedLength;
+
+    ///act
+    int result = Base64_Encode_Into(NULL, 3, destination, sizeof(destination), &encodedLength);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/*Tests_SRS_BASE64_01_001: [If source or encodedLength is NULL then Base64_Encode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Encode_Into_with_NULL_encodedLength_fails)
+{
+    ///arrange
+    char destination[8];
+
+    ///act
+    int result = Base64_Encode_Into((const unsigned char*)"abc", 3, destination, sizeof(destination), NULL);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/*Tests_SRS_BASE64_01_002: [Base64_Encode_Into shall set *encodedLength to the length of the base64 encoding of source, not including the null terminator.]*/
+/*Tests_SRS_BASE64_01_003: [If destination is NULL or destinationSize is not larger than the encoded length then Base64_Encode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Encode_Into_with_NULL_destination_returns_the_length_and_fails)
+{
+    ///arrange
+    size_t encodedLength = 0;
+
+    ///act
+    int result = Base64_Encode_Into((const unsigned char*)"any carnal pleasure.", 20, NULL, 0, &encodedLength);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 28, encodedLength);
+}
+
+/*Tests_SRS_BASE64_01_003: [If destination is NULL or destinationSize is not larger than the encoded length then Base64_Encode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Encode_Into_without_room_for_the_null_terminator_fails)
+{
+    ///arrange
+    char destination[4];
+    size_t encodedLength;
+
+    ///act
+    int result = Base64_Encode_Into((const unsigned char*)"a", 1, destination, sizeof(destination), &encodedLength);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 4, encodedLength);
+}
+
+/*Tests_SRS_BASE64_01_004: [Otherwise Base64_Encode_Into shall write the null terminated base64 encoding of source to destination without allocating any memory and return 0.]*/
+TEST_FUNCTION(Base64_Encode_Into_exhaustive_succeeds)
+{
+    for (size_t i = 0; i < sizeof(testVector_BINARY_with_equal_signs) / sizeof(testVector_BINARY_with_equal_signs[0]); i++)
+    {
+        ///arrange
+        char destination[32];
+        size_t encodedLength;
+
+        ///act
+        int result = Base64_Encode_Into(testVector_BINARY_with_equal_signs[i].inputData, testVector_BINARY_with_equal_signs[i].inputLength, destination, strlen(testVector_BINARY_with_equal_signs[i].expectedOutput) + 1, &encodedLength);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, strlen(testVector_BINARY_with_equal_signs[i].expectedOutput), encodedLength);
+        ASSERT_ARE_EQUAL(char_ptr, testVector_BINARY_with_equal_signs[i].expectedOutput, destination);
+    }
+}
+
+/*Tests_SRS_BASE64_01_004: [Otherwise Base64_Encode_Into shall write the null terminated base64 encoding of source to destination without allocating any memory and return 0.]*/
+TEST_FUNCTION(Base64_Encode_Into_long_input_matches_Base64_Encode_Bytes)
+{
+    ///arrange
+    unsigned char source[1000];
+    char destination[1338];
+    size_t encodedLength;
+
+    for (size_t i = 0; i < sizeof(source); i++)
+    {
+        source[i] = (unsigned char)(i * 7);
+    }
+
+    for (size_t size = 90; size <= sizeof(source); size += 91)
+    {
+        STRING_HANDLE expected = Base64_Encode_Bytes(source, size);
+
+        ///act
+        int result = Base64_Encode_Into(source, size, destination, sizeof(destination), &encodedLength);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, STRING_c_str(expected), destination);
+
+        ///cleanup
+        STRING_delete(expected);
+    }
+}
+
 TEST_FUNCTION(Base64_Decoder_exhaustive_succeeds)
 {
     for (size_t i = 0; i < sizeof(testVector_BINARY_with_equal_signs) / sizeof(testVector_BINARY_with_equal_signs[0]); i++)
@@ -1748,4 +1853,316 @@ TEST_FUNCTION(Base64_Decoder_invalid_length_fails_6)
 }
 
 
+/*Tests_SRS_BASE64_01_006: [If source or decodedLength is NULL then Base64_Decode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Decode_Into_with_NULL_source_fails)
+{
+    ///arrange
+    unsigned char destination[8];
+    size_t decodedLength;
+
+    ///act
+    int result = Base64_Decode_Into(NULL, 4, destination, sizeof(destination), &decodedLength);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/*Tests_SRS_BASE64_01_006: [If source or decodedLength is NULL then Base64_Decode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Decode_Into_with_NULL_decodedLength_fails)
+{
+    ///arrange
+    unsigned char destination[8];
+
+    ///act
+    int result = Base64_Decode_Into("YQ==", 4, destination, sizeof(destination), NULL);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/*Tests_SRS_BASE64_01_007: [If sourceLength is not a multiple of 4 then Base64_Decode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Decode_Into_with_invalid_length_fails)
+{
+    ///arrange
+    unsigned char destination[8];
+    size_t decodedLength;
+
+    ///act
+    int result = Base64_Decode_Into("YWJjZA", 6, destination, sizeof(destination), &decodedLength);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/*Tests_SRS_BASE64_01_008: [Base64_Decode_Into shall set *decodedLength to the number of bytes encoded by source.]*/
+/*Tests_SRS_BASE64_01_009: [If destination is NULL or destinationSize is smaller than the decoded length then Base64_Decode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Decode_Into_with_NULL_destination_returns_the_length_and_fails)
+{
+    ///arrange
+    size_t decodedLength = 0;
+
+    ///act
+    int result = Base64_Decode_Into("YW55IGNhcm5hbCBwbGVhc3VyZS4=", 28, NULL, 0, &decodedLength);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 20, decodedLength);
+}
+
+/*Tests_SRS_BASE64_01_009: [If destination is NULL or destinationSize is smaller than the decoded length then Base64_Decode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Decode_Into_with_small_destination_fails)
+{
+    ///arrange
+    unsigned char destination[2];
+    size_t decodedLength;
+
+    ///act
+    int result = Base64_Decode_Into("YWJj", 4, destination, sizeof(destination), &decodedLength);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 3, decodedLength);
+}
+
+/*Tests_SRS_BASE64_01_010: [If source holds a character that is not part of the base64 alphabet, other than 1 or 2 '=' padding characters at its end, then Base64_Decode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Decode_Into_with_invalid_characters_fails)
+{
+    static const char* invalidSources[] = { "YW!j", "YQ==YWJj", "Y===", "====", "YWJjZGVmZ2hpamtsbW5vcHFyc3R1dnd4eXpBQkNERUZHSElK\xe9" "LTU5P" };
+    for (size_t i = 0; i < sizeof(invalidSources) / sizeof(invalidSources[0]); i++)
+    {
+        ///arrange
+        unsigned char destination[64];
+        size_t decodedLength;
+
+        ///act
+        int result = Base64_Decode_Into(invalidSources[i], strlen(invalidSources[i]), destination, sizeof(destination), &decodedLength);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    }
+}
+
+/*Tests_SRS_BASE64_01_011: [Otherwise Base64_Decode_Into shall write the decoded bytes to destination without allocating any memory and return 0.]*/
+TEST_FUNCTION(Base64_Decode_Into_exhaustive_succeeds)
+{
+    for (size_t i = 0; i < sizeof(testVector_BINARY_with_equal_signs) / sizeof(testVector_BINARY_with_equal_signs[0]); i++)
+    {
+        ///arrange
+        unsigned char destination[16];
+        size_t decodedLength;
+
+        ///act
+        int result = Base64_Decode_Into(testVector_BINARY_with_equal_signs[i].expectedOutput, strlen(testVector_BINARY_with_equal_signs[i].expectedOutput), destination, testVector_BINARY_with_equal_signs[i].inputLength, &decodedLength);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, testVector_BINARY_with_equal_signs[i].inputLength, decodedLength);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(destination, testVector_BINARY_with_equal_signs[i].inputData, decodedLength));
+    }
+}
+
+/*Tests_SRS_BASE64_01_011: [Otherwise Base64_Decode_Into shall write the decoded bytes to destination without allocating any memory and return 0.]*/
+TEST_FUNCTION(Base64_Decode_Into_long_input_round_trips)
+{
+    ///arrange
+    unsigned char source[1000];
+    char encoded[1338];
+    unsigned char destination[1000];
+
+    for (size_t i = 0; i < sizeof(source); i++)
+    {
+        source[i] = (unsigned char)(i * 13);
+    }
+
+    for (size_t size = 89; size <= sizeof(source); size += 97)
+    {
+        size_t encodedLength;
+        size_t decodedLength;
+        ASSERT_ARE_EQUAL(int, 0, Base64_Encode_Into(source, size, encoded, sizeof(encoded), &encodedLength));
+
+        ///act
+        int result = Base64_Decode_Into(encoded, encodedLength, destination, size, &decodedLength);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, size, decodedLength);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(source, destination, size));
+    }
+}
+
+
+/*Tests_SRS_BASE64_01_012: [Base64_Encode_Init shall allocate a context for encoding a stream of bytes and return it.]*/
+/*Tests_SRS_BASE64_01_018: [Otherwise Base64_Encode_Update shall write those characters to destination, without a null terminator, keep the remaining 1 or 2 bytes in context and return 0.]*/
+/*Tests_SRS_BASE64_01_023: [Otherwise Base64_Encode_Final shall write the padded encoding of the kept bytes to destination, without a null terminator, and return 0.]*/
+TEST_FUNCTION(Base64_Encode_Update_one_byte_at_a_time_matches_Base64_Encode_Bytes)
+{
+    ///arrange
+    const char* leviathan = "any carnal pleasure.";
+    char encoded[32];
+    size_t encodedPosition = 0;
+    size_t encodedLength;
+    BASE64_ENCODE_CONTEXT_HANDLE context = Base64_Encode_Init();
+    ASSERT_IS_NOT_NULL(context);
+
+    ///act
+    for (size_t i = 0; i < strlen(leviathan); i++)
+    {
+        ASSERT_ARE_EQUAL(int, 0, Base64_Encode_Update(context, (const unsigned char*)leviathan + i, 1, encoded + encodedPosition, sizeof(encoded) - encodedPosition, &encodedLength));
+        encodedPosition += encodedLength;
+    }
+    ASSERT_ARE_EQUAL(int, 0, Base64_Encode_Final(context, encoded + encodedPosition, sizeof(encoded) - encodedPosition, &encodedLength));
+    encodedPosition += encodedLength;
+    encoded[encodedPosition] = '\0';
+
+    ///assert
+    ASSERT_ARE_EQUAL(char_ptr, "YW55IGNhcm5hbCBwbGVhc3VyZS4=", encoded);
+
+    ///cleanup
+    Base64_Encode_DestroyContext(context);
+}
+
+/*Tests_SRS_BASE64_01_014: [If context or encodedLength is NULL, or source is NULL while size is not zero, Base64_Encode_Update shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Encode_Update_with_NULL_context_fails)
+{
+    ///arrange
+    char encoded[8];
+    size_t encodedLength;
+
+    ///act
+    int result = Base64_Encode_Update(NULL, (const unsigned char*)"abc", 3, encoded, sizeof(encoded), &encodedLength);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/*Tests_SRS_BASE64_01_017: [If characters are to be written and destination is NULL or destinationSize is smaller than *encodedLength, Base64_Encode_Update shall fail and return a non-zero value without changing context.]*/
+TEST_FUNCTION(Base64_Encode_Update_with_small_destination_fails_and_keeps_the_stream)
+{
+    ///arrange
+    char encoded[9];
+    size_t encodedLength;
+    BASE64_ENCODE_CONTEXT_HANDLE context = Base64_Encode_Init();
+
+    ///act
+    int result = Base64_Encode_Update(context, (const unsigned char*)"abcdef", 6, encoded, 7, &encodedLength);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 8, encodedLength);
+    ASSERT_ARE_EQUAL(int, 0, Base64_Encode_Update(context, (const unsigned char*)"abcdef", 6, encoded, 8, &encodedLength));
+    encoded[encodedLength] = '\0';
+    ASSERT_ARE_EQUAL(char_ptr, "YWJjZGVm", encoded);
+
+    ///cleanup
+    Base64_Encode_DestroyContext(context);
+}
+
+/*Tests_SRS_BASE64_01_015: [If Base64_Encode_Final was already called for context, Base64_Encode_Update shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Encode_Update_after_Final_fails)
+{
+    ///arrange
+    char encoded[8];
+    size_t encodedLength;
+    BASE64_ENCODE_CONTEXT_HANDLE context = Base64_Encode_Init();
+    ASSERT_ARE_EQUAL(int, 0, Base64_Encode_Final(context, encoded, sizeof(encoded), &encodedLength));
+
+    ///act
+    int result = Base64_Encode_Update(context, (const unsigned char*)"abc", 3, encoded, sizeof(encoded), &encodedLength);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    ///cleanup
+    Base64_Encode_DestroyContext(context);
+}
+
+/*Tests_SRS_BASE64_01_025: [Base64_Decode_Init shall allocate a context for decoding a stream of base64 characters and return it.]*/
+/*Tests_SRS_BASE64_01_030: [Base64_Decode_Update shall skip the '\r' and '\n' characters.]*/
+/*Tests_SRS_BASE64_01_033: [Otherwise Base64_Decode_Update shall write the bytes of the complete groups to destination, keep the characters of an incomplete group in context, set *decodedLength to the number of bytes written and return 0.]*/
+/*Tests_SRS_BASE64_01_036: [Otherwise Base64_Decode_Final shall return 0.]*/
+TEST_FUNCTION(Base64_Decode_Update_with_line_breaks_in_chunks_succeeds)
+{
+    ///arrange
+    const char* pem = "YW55IGNh\r\ncm5hbCBw\r\nbGVhc3Vy\r\nZS4=\r\n";
+    unsigned char decoded[32];
+    size_t decodedPosition = 0;
+    size_t decodedLength;
+    BASE64_DECODE_CONTEXT_HANDLE context = Base64_Decode_Init();
+    ASSERT_IS_NOT_NULL(context);
+
+    ///act
+    for (size_t i = 0; i < strlen(pem); i += 3)
+    {
+        size_t chunk = (strlen(pem) - i < 3) ? strlen(pem) - i : 3;
+        ASSERT_ARE_EQUAL(int, 0, Base64_Decode_Update(context, pem + i, chunk, decoded + decodedPosition, sizeof(decoded) - decodedPosition, &decodedLength));
+        decodedPosition += decodedLength;
+    }
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, 0, Base64_Decode_Final(context));
+    ASSERT_ARE_EQUAL(size_t, 20, decodedPosition);
+    ASSERT_ARE_EQUAL(int, 0, memcmp("any carnal pleasure.", decoded, 20));
+
+    ///cleanup
+    Base64_Decode_DestroyContext(context);
+}
+
+/*Tests_SRS_BASE64_01_032: [Any other character that is not part of the base64 alphabet, or any character after the padding, shall make Base64_Decode_Update fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Decode_Update_with_data_after_padding_fails)
+{
+    ///arrange
+    unsigned char decoded[16];
+    size_t decodedLength;
+    BASE64_DECODE_CONTEXT_HANDLE context = Base64_Decode_Init();
+
+    ///act
+    int result = Base64_Decode_Update(context, "YQ==YWJj", 8, decoded, sizeof(decoded), &decodedLength);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_NOT_EQUAL(int, 0, Base64_Decode_Final(context));
+
+    ///cleanup
+    Base64_Decode_DestroyContext(context);
+}
+
+/*Tests_SRS_BASE64_01_029: [If sourceLength is not zero and destination is NULL or destinationSize is smaller than ((sourceLength + 3) / 4) * 3, Base64_Decode_Update shall fail and return a non-zero value without changing context.]*/
+TEST_FUNCTION(Base64_Decode_Update_with_small_destination_fails)
+{
+    ///arrange
+    unsigned char decoded[5];
+    size_t decodedLength;
+    BASE64_DECODE_CONTEXT_HANDLE context = Base64_Decode_Init();
+
+    ///act
+    int result = Base64_Decode_Update(context, "YWJjZA==", 8, decoded, sizeof(decoded), &decodedLength);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    ///cleanup
+    Base64_Decode_DestroyContext(context);
+}
+
+/*Tests_SRS_BASE64_01_035: [If Base64_Decode_Final was already called, a call to Base64_Decode_Update failed or an incomplete group is left in context, Base64_Decode_Final shall fail and return a non-zero value.]*/
+TEST_FUNCTION(Base64_Decode_Final_with_incomplete_group_fails)
+{
+    ///arrange
+    unsigned char decoded[8];
+    size_t decodedLength;
+    BASE64_DECODE_CONTEXT_HANDLE context = Base64_Decode_Init();
+    ASSERT_ARE_EQUAL(int, 0, Base64_Decode_Update(context, "YWJjZA", 6, decoded, sizeof(decoded), &decodedLength));
+
+    ///act
+    int result = Base64_Decode_Final(context);
+
+    ///assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 3, decodedLength);
+
+    ///cleanup
+    Base64_Decode_DestroyContext(context);
+}
+
+
 END_TEST_SUITE(base64_unittests);
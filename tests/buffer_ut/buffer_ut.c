@@ -4,12 +4,37 @@
 #ifdef __cplusplus
 #include <cstdlib>
 #include <cstddef>
+#include <cstring>
 #else
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
 #endif
 
 #include "umock_c.h"
+
+#define ENABLE_MOCKS
+#include "azure_c_shared_utility/arena.h"
+#undef ENABLE_MOCKS
+
+static void* my_ARENA_malloc(ARENA_HANDLE arena, size_t size)
+{
+    (void)arena;
+    return malloc(size);
+}
+
+static void* my_ARENA_realloc(ARENA_HANDLE arena, void* ptr, size_t size)
+{
+    (void)arena;
+    return realloc(ptr, size);
+}
+
+static void my_ARENA_free(ARENA_HANDLE arena, void* ptr)
+{
+    (void)arena;
+    free(ptr);
+}
+
 #include "azure_c_shared_utility/buffer_.h"
 #include "testrunnerswitcher.h"
 
@@ -78,6 +103,8 @@ void my_gballoc_free(void* ptr)
 #define BUFFER_TEST1_SIZE             5
 #define BUFFER_TEST2_SIZE             6
 
+#define TEST_ARENA                  (ARENA_HANDLE)0x4242
+
 unsigned char BUFFER_Test1[] = {0x01,0x02,0x03,0x04,0x05};
 unsigned char BUFFER_Test2[] = {0x06,0x07,0x08,0x09,0x10,0x11};
 unsigned char BUFFER_TEST_VALUE[] = {0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x10,0x11,0x12,0x13,0x14,0x15,0x16};
@@ -109,6 +136,11 @@ BEGIN_TEST_SUITE(Buffer_UnitTests)
         REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
         REGISTER_GLOBAL_MOCK_HOOK(gballoc_realloc, my_gballoc_realloc);
         REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+
+        REGISTER_UMOCK_ALIAS_TYPE(ARENA_HANDLE, void*);
+        REGISTER_GLOBAL_MOCK_HOOK(ARENA_malloc, my_ARENA_malloc);
+        REGISTER_GLOBAL_MOCK_HOOK(ARENA_realloc, my_ARENA_realloc);
+        REGISTER_GLOBAL_MOCK_HOOK(ARENA_free, my_ARENA_free);
     }
 
     TEST_SUITE_CLEANUP(TestClassCleanup)
@@ -158,6 +190,176 @@ BEGIN_TEST_SUITE(Buffer_UnitTests)
         BUFFER_delete(g_hBuffer);
     }
 
+    /* BUFFER_new_in_arena */
+
+    /* Tests_SRS_BUFFER_01_037: [If arena is NULL, BUFFER_new_in_arena shall fail and return NULL.] */
+    TEST_FUNCTION(BUFFER_new_in_arena_with_NULL_arena_fails)
+    {
+        ///arrange
+
+        ///act
+        BUFFER_HANDLE result = BUFFER_new_in_arena(NULL);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_01_038: [BUFFER_new_in_arena shall allocate an empty BUFFER_HANDLE with ARENA_malloc, all the memory the buffer needs later shall also be allocated, grown and freed with ARENA_malloc, ARENA_realloc and ARENA_free.] */
+    TEST_FUNCTION(BUFFER_new_in_arena_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG));
+
+        ///act
+        BUFFER_HANDLE result = BUFFER_new_in_arena(TEST_ARENA);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_EQUAL(size_t, 0, BUFFER_length(result));
+        ASSERT_IS_NULL(BUFFER_u_char(result));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(result);
+    }
+
+    /* Tests_SRS_BUFFER_01_039: [If ARENA_malloc fails, BUFFER_new_in_arena shall fail and return NULL.] */
+    TEST_FUNCTION(when_ARENA_malloc_fails_BUFFER_new_in_arena_fails)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        BUFFER_HANDLE result = BUFFER_new_in_arena(TEST_ARENA);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_01_038: [BUFFER_new_in_arena shall allocate an empty BUFFER_HANDLE with ARENA_malloc, all the memory the buffer needs later shall also be allocated, grown and freed with ARENA_malloc, ARENA_realloc and ARENA_free.] */
+    TEST_FUNCTION(BUFFER_build_on_a_buffer_in_an_arena_allocates_from_the_arena)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_new_in_arena(TEST_ARENA);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(ARENA_realloc(TEST_ARENA, NULL, ALLOCATION_SIZE));
+
+        ///act
+        int result = BUFFER_build(g_hBuffer, BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_01_040: [If the buffer was created by BUFFER_new_in_arena, BUFFER_delete shall give its memory back with ARENA_free.] */
+    TEST_FUNCTION(BUFFER_delete_of_a_buffer_in_an_arena_frees_to_the_arena)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_new_in_arena(TEST_ARENA);
+        (void)BUFFER_build(g_hBuffer, BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, g_hBuffer));
+
+        ///act
+        BUFFER_delete(g_hBuffer);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_BUFFER_01_041: [The clone of a buffer created by BUFFER_new_in_arena shall be allocated with malloc, it does not depend on the arena.] */
+    TEST_FUNCTION(BUFFER_clone_of_a_buffer_in_an_arena_allocates_from_the_heap)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_new_in_arena(TEST_ARENA);
+        BUFFER_HANDLE hClone;
+        (void)BUFFER_build(g_hBuffer, BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+        STRICT_EXPECTED_CALL(gballoc_malloc(ALLOCATION_SIZE));
+
+        ///act
+        hClone = BUFFER_clone(g_hBuffer);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(hClone);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hClone), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(hClone);
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_01_042: [If the buffer was created by BUFFER_new_in_arena, BUFFER_transfer shall hand the caller a copy of the content allocated with malloc instead, since the memory of the arena cannot be given to free.] */
+    /* Tests_SRS_BUFFER_01_011: [BUFFER_transfer shall leave handle empty, as if it had been created with BUFFER_new.] */
+    TEST_FUNCTION(BUFFER_transfer_of_a_buffer_in_an_arena_hands_out_a_heap_copy)
+    {
+        ///arrange
+        unsigned char* memory;
+        size_t size;
+        BUFFER_HANDLE g_hBuffer = BUFFER_new_in_arena(TEST_ARENA);
+        (void)BUFFER_build(g_hBuffer, BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(ALLOCATION_SIZE));
+        STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, IGNORED_PTR_ARG));
+
+        ///act
+        int result = BUFFER_transfer(g_hBuffer, &memory, &size);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, size);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(memory, BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(size_t, 0, BUFFER_length(g_hBuffer));
+        ASSERT_IS_NULL(BUFFER_u_char(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        free(memory);
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* Tests_SRS_BUFFER_01_043: [If allocating the copy fails, BUFFER_transfer shall fail, return a non-zero value and leave the buffer unchanged.] */
+    TEST_FUNCTION(when_malloc_fails_BUFFER_transfer_of_a_buffer_in_an_arena_fails)
+    {
+        ///arrange
+        unsigned char* memory;
+        size_t size;
+        BUFFER_HANDLE g_hBuffer = BUFFER_new_in_arena(TEST_ARENA);
+        (void)BUFFER_build(g_hBuffer, BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(ALLOCATION_SIZE))
+            .SetReturn(NULL);
+
+        ///act
+        int result = BUFFER_transfer(g_hBuffer, &memory, &size);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
     /* BUFFER_delete Tests BEGIN */
     /* Tests_SRS_BUFFER_07_003: [BUFFER_delete shall delete the data associated with the BUFFER_HANDLE.] */
     TEST_FUNCTION(BUFFER_delete_Succeed)
@@ -413,22 +615,22 @@ BEGIN_TEST_SUITE(Buffer_UnitTests)
     }
 
     /* Tests_SRS_BUFFER_07_011: [BUFFER_build shall overwrite previous contents if the buffer has been previously allocated.] */
+    /* Tests_SRS_BUFFER_01_021: [If size is not greater than the capacity of the buffer, BUFFER_build shall copy source into the memory already allocated without reallocating it.] */
     TEST_FUNCTION(BUFFER_build_when_the_buffer_is_already_allocated_and_the_same_amount_of_bytes_is_needed_succeeds)
     {
         ///arrange
         BUFFER_HANDLE g_hBuffer;
         g_hBuffer = BUFFER_new();
-        int nResult = BUFFER_build(g_hBuffer, BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        int nResult = BUFFER_build(g_hBuffer, ADDITIONAL_BUFFER, ALLOCATION_SIZE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, ALLOCATION_SIZE))
-            .IgnoreArgument(1);
-
         ///act
         nResult = BUFFER_build(g_hBuffer, BUFFER_TEST_VALUE, ALLOCATION_SIZE);
 
         ///assert
         ASSERT_ARE_EQUAL(int, nResult, 0);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
         ///cleanup
@@ -459,22 +661,22 @@ BEGIN_TEST_SUITE(Buffer_UnitTests)
     }
 
     /* Tests_SRS_BUFFER_07_011: [BUFFER_build shall overwrite previous contents if the buffer has been previously allocated.] */
+    /* Tests_SRS_BUFFER_01_021: [If size is not greater than the capacity of the buffer, BUFFER_build shall copy source into the memory already allocated without reallocating it.] */
     TEST_FUNCTION(BUFFER_build_when_the_buffer_is_already_allocated_and_less_bytes_are_needed_succeeds)
     {
         ///arrange
         BUFFER_HANDLE g_hBuffer;
         g_hBuffer = BUFFER_new();
-        int nResult = BUFFER_build(g_hBuffer, BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        int nResult = BUFFER_build(g_hBuffer, ADDITIONAL_BUFFER, ALLOCATION_SIZE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, ALLOCATION_SIZE - 1))
-            .IgnoreArgument(1);
-
         ///act
         nResult = BUFFER_build(g_hBuffer, BUFFER_TEST_VALUE, ALLOCATION_SIZE - 1);
 
         ///assert
         ASSERT_ARE_EQUAL(int, nResult, 0);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE - 1, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE - 1));
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
         ///cleanup
@@ -1195,4 +1397,927 @@ BEGIN_TEST_SUITE(Buffer_UnitTests)
         BUFFER_delete(res);
     }
 
+    /* BUFFER_create_with_moved_memory Tests BEGIN */
+    /*Tests_SRS_BUFFER_01_006: [If buffer is NULL and size is different than 0 then BUFFER_create_with_moved_memory shall fail and return NULL.]*/
+    TEST_FUNCTION(BUFFER_create_with_moved_memory_with_NULL_buffer_and_non_zero_size_fails)
+    {
+        ///arrange
+
+        ///act
+        BUFFER_HANDLE res = BUFFER_create_with_moved_memory(NULL, 1);
+
+        ///assert
+        ASSERT_IS_NULL(res);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_BUFFER_01_007: [BUFFER_create_with_moved_memory shall allocate a new BUFFER_HANDLE that takes ownership of buffer and size without copying the bytes.]*/
+    TEST_FUNCTION(BUFFER_create_with_moved_memory_succeeds)
+    {
+        ///arrange
+        unsigned char* memory = (unsigned char*)malloc(ALLOCATION_SIZE);
+        ASSERT_IS_NOT_NULL(memory);
+        (void)memcpy(memory, BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        BUFFER_HANDLE res = BUFFER_create_with_moved_memory(memory, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(res);
+        ASSERT_ARE_EQUAL(void_ptr, memory, BUFFER_u_char(res));
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(res));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(res);
+    }
+
+    /*Tests_SRS_BUFFER_01_007: [BUFFER_create_with_moved_memory shall allocate a new BUFFER_HANDLE that takes ownership of buffer and size without copying the bytes.]*/
+    TEST_FUNCTION(BUFFER_delete_frees_the_moved_memory)
+    {
+        ///arrange
+        unsigned char* memory = (unsigned char*)malloc(ALLOCATION_SIZE);
+        ASSERT_IS_NOT_NULL(memory);
+        BUFFER_HANDLE res = BUFFER_create_with_moved_memory(memory, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(memory));
+        STRICT_EXPECTED_CALL(gballoc_free(res));
+
+        ///act
+        BUFFER_delete(res);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_BUFFER_01_007: [BUFFER_create_with_moved_memory shall allocate a new BUFFER_HANDLE that takes ownership of buffer and size without copying the bytes.]*/
+    TEST_FUNCTION(BUFFER_create_with_moved_memory_with_NULL_buffer_and_zero_size_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        BUFFER_HANDLE res = BUFFER_create_with_moved_memory(NULL, 0);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(res);
+        ASSERT_ARE_EQUAL(size_t, 0, BUFFER_length(res));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(res);
+    }
+
+    /*Tests_SRS_BUFFER_01_008: [If any error occurs, BUFFER_create_with_moved_memory shall fail, return NULL and leave the ownership of buffer with the caller.]*/
+    TEST_FUNCTION(BUFFER_create_with_moved_memory_fails_when_malloc_fails)
+    {
+        ///arrange
+        unsigned char* memory = (unsigned char*)malloc(ALLOCATION_SIZE);
+        ASSERT_IS_NOT_NULL(memory);
+        umock_c_reset_all_calls();
+
+        whenShallmalloc_fail = currentmalloc_call + 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        BUFFER_HANDLE res = BUFFER_create_with_moved_memory(memory, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_IS_NULL(res);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        free(memory);
+    }
+
+    /* BUFFER_transfer Tests BEGIN */
+    /*Tests_SRS_BUFFER_01_009: [If handle, buffer or size is NULL, BUFFER_transfer shall fail and return a non-zero value.]*/
+    TEST_FUNCTION(BUFFER_transfer_with_NULL_handle_fails)
+    {
+        ///arrange
+        unsigned char* memory;
+        size_t size;
+
+        ///act
+        int result = BUFFER_transfer(NULL, &memory, &size);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_BUFFER_01_009: [If handle, buffer or size is NULL, BUFFER_transfer shall fail and return a non-zero value.]*/
+    TEST_FUNCTION(BUFFER_transfer_with_NULL_buffer_fails)
+    {
+        ///arrange
+        size_t size;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_transfer(g_hBuffer, NULL, &size);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_009: [If handle, buffer or size is NULL, BUFFER_transfer shall fail and return a non-zero value.]*/
+    TEST_FUNCTION(BUFFER_transfer_with_NULL_size_fails)
+    {
+        ///arrange
+        unsigned char* memory;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_transfer(g_hBuffer, &memory, NULL);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_010: [BUFFER_transfer shall hand the underlying memory and its size to the caller, who becomes responsible for freeing it with free, and return 0.]*/
+    /*Tests_SRS_BUFFER_01_011: [BUFFER_transfer shall leave handle empty, as if it had been created with BUFFER_new.]*/
+    TEST_FUNCTION(BUFFER_transfer_succeeds)
+    {
+        ///arrange
+        unsigned char* memory;
+        size_t size;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        unsigned char* expected = BUFFER_u_char(g_hBuffer);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_transfer(g_hBuffer, &memory, &size);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(void_ptr, expected, memory);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, size);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(memory, BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(size_t, 0, BUFFER_length(g_hBuffer));
+        ASSERT_IS_NULL(BUFFER_u_char(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        free(memory);
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_011: [BUFFER_transfer shall leave handle empty, as if it had been created with BUFFER_new.]*/
+    TEST_FUNCTION(BUFFER_transfer_leaves_a_buffer_that_can_be_built_again)
+    {
+        ///arrange
+        unsigned char* memory;
+        size_t size;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        (void)BUFFER_transfer(g_hBuffer, &memory, &size);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, BUFFER_TEST1_SIZE));
+
+        ///act
+        int result = BUFFER_build(g_hBuffer, BUFFER_Test1, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        free(memory);
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /* BUFFER_reserve Tests BEGIN */
+    /*Tests_SRS_BUFFER_01_012: [If handle is NULL, BUFFER_reserve shall fail and return a non-zero value.]*/
+    TEST_FUNCTION(BUFFER_reserve_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        int result = BUFFER_reserve(NULL, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_BUFFER_01_014: [Otherwise BUFFER_reserve shall reallocate the buffer to capacity bytes, keeping its content and size, and return 0.]*/
+    TEST_FUNCTION(BUFFER_reserve_grows_the_capacity_and_keeps_the_content)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, TOTAL_ALLOCATION_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        int result = BUFFER_reserve(g_hBuffer, TOTAL_ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_013: [If capacity is not greater than the capacity of the buffer, BUFFER_reserve shall succeed without allocating memory.]*/
+    TEST_FUNCTION(BUFFER_reserve_with_a_smaller_capacity_does_not_allocate)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_reserve(g_hBuffer, ALLOCATION_SIZE - 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_015: [If reallocating fails, BUFFER_reserve shall fail, return a non-zero value and leave the buffer unchanged.]*/
+    TEST_FUNCTION(BUFFER_reserve_fails_when_realloc_fails)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        whenShallrealloc_fail = currentrealloc_call + 1;
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, TOTAL_ALLOCATION_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        int result = BUFFER_reserve(g_hBuffer, TOTAL_ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_021: [If size is not greater than the capacity of the buffer, BUFFER_build shall copy source into the memory already allocated without reallocating it.]*/
+    TEST_FUNCTION(BUFFER_build_after_BUFFER_reserve_does_not_allocate)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_new();
+        (void)BUFFER_reserve(g_hBuffer, TOTAL_ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_build(g_hBuffer, TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_022: [If the new size is not greater than the capacity of the buffer, BUFFER_enlarge shall not reallocate the memory.]*/
+    TEST_FUNCTION(BUFFER_enlarge_within_the_capacity_does_not_allocate)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        (void)BUFFER_reserve(g_hBuffer, TOTAL_ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_enlarge(g_hBuffer, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_025: [If the new size would overflow a size_t, BUFFER_enlarge shall fail and return a nonzero result.]*/
+    TEST_FUNCTION(BUFFER_enlarge_with_overflowing_size_fails)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_enlarge(g_hBuffer, (size_t)-1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_023: [If the concatenated content fits in the capacity of handle1, BUFFER_append shall not reallocate the memory.]*/
+    TEST_FUNCTION(BUFFER_append_within_the_capacity_does_not_allocate)
+    {
+        ///arrange
+        BUFFER_HANDLE hAppend;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        (void)BUFFER_reserve(g_hBuffer, TOTAL_ALLOCATION_SIZE);
+        hAppend = BUFFER_create(ADDITIONAL_BUFFER, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_append(g_hBuffer, hAppend);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+        BUFFER_delete(hAppend);
+    }
+
+    /*Tests_SRS_BUFFER_01_024: [If the concatenated content fits in the capacity of handle1, BUFFER_prepend shall move the content of handle1 in place without allocating memory.]*/
+    TEST_FUNCTION(BUFFER_prepend_within_the_capacity_does_not_allocate)
+    {
+        ///arrange
+        BUFFER_HANDLE hPrepend;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(ADDITIONAL_BUFFER, ALLOCATION_SIZE);
+        (void)BUFFER_reserve(g_hBuffer, TOTAL_ALLOCATION_SIZE);
+        hPrepend = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_prepend(g_hBuffer, hPrepend);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+        BUFFER_delete(hPrepend);
+    }
+
+    /* BUFFER_shrink Tests BEGIN */
+    /*Tests_SRS_BUFFER_01_016: [If handle is NULL, BUFFER_shrink shall fail and return a non-zero value.]*/
+    TEST_FUNCTION(BUFFER_shrink_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        int result = BUFFER_shrink(NULL, 1, true);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_BUFFER_01_017: [If decreaseSize is 0 or greater than the size of the buffer, BUFFER_shrink shall fail and return a non-zero value.]*/
+    TEST_FUNCTION(BUFFER_shrink_with_zero_decreaseSize_fails)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_shrink(g_hBuffer, 0, true);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_017: [If decreaseSize is 0 or greater than the size of the buffer, BUFFER_shrink shall fail and return a non-zero value.]*/
+    TEST_FUNCTION(BUFFER_shrink_with_decreaseSize_greater_than_size_fails)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_shrink(g_hBuffer, ALLOCATION_SIZE + 1, false);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_018: [If fromEnd is true, BUFFER_shrink shall remove the last decreaseSize bytes of the buffer.]*/
+    /*Tests_SRS_BUFFER_01_020: [BUFFER_shrink shall not reallocate the memory, the capacity of the buffer is kept.]*/
+    TEST_FUNCTION(BUFFER_shrink_from_the_end_succeeds)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE);
+        unsigned char* memory = BUFFER_u_char(g_hBuffer);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_shrink(g_hBuffer, ALLOCATION_SIZE, true);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(void_ptr, memory, BUFFER_u_char(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_019: [Otherwise BUFFER_shrink shall remove the first decreaseSize bytes, moving the remaining bytes to the beginning of the buffer.]*/
+    /*Tests_SRS_BUFFER_01_020: [BUFFER_shrink shall not reallocate the memory, the capacity of the buffer is kept.]*/
+    TEST_FUNCTION(BUFFER_shrink_from_the_beginning_succeeds)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_shrink(g_hBuffer, ALLOCATION_SIZE, false);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), ADDITIONAL_BUFFER, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_020: [BUFFER_shrink shall not reallocate the memory, the capacity of the buffer is kept.]*/
+    TEST_FUNCTION(BUFFER_enlarge_after_BUFFER_shrink_does_not_allocate)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE);
+        (void)BUFFER_shrink(g_hBuffer, ALLOCATION_SIZE, true);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_enlarge(g_hBuffer, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_026: [Otherwise BUFFER_enlarge shall grow the memory to the larger of twice its capacity and the number of bytes needed.]*/
+    TEST_FUNCTION(BUFFER_enlarge_grows_the_capacity_geometrically)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * ALLOCATION_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        int result1 = BUFFER_enlarge(g_hBuffer, 1);
+        int result2 = BUFFER_enlarge(g_hBuffer, ALLOCATION_SIZE - 1);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_ARE_EQUAL(size_t, 2 * ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_026: [Otherwise BUFFER_enlarge shall grow the memory to the larger of twice its capacity and the number of bytes needed.]*/
+    TEST_FUNCTION(BUFFER_enlarge_grows_to_the_needed_size_when_it_is_more_than_twice_the_capacity)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_Test1, BUFFER_TEST1_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, BUFFER_TEST1_SIZE + ALLOCATION_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        int result = BUFFER_enlarge(g_hBuffer, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST1_SIZE + ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_027: [Otherwise BUFFER_append shall grow the memory of handle1 to the larger of twice its capacity and the number of bytes needed.]*/
+    TEST_FUNCTION(BUFFER_append_grows_the_capacity_geometrically)
+    {
+        ///arrange
+        BUFFER_HANDLE hAppend1;
+        BUFFER_HANDLE hAppend2;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        hAppend1 = BUFFER_create(BUFFER_Test1, BUFFER_TEST1_SIZE);
+        hAppend2 = BUFFER_create(BUFFER_Test2, BUFFER_TEST2_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * ALLOCATION_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        int result1 = BUFFER_append(g_hBuffer, hAppend1);
+        int result2 = BUFFER_append(g_hBuffer, hAppend2);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE + BUFFER_TEST1_SIZE + BUFFER_TEST2_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer) + ALLOCATION_SIZE, BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer) + ALLOCATION_SIZE + BUFFER_TEST1_SIZE, BUFFER_Test2, BUFFER_TEST2_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+        BUFFER_delete(hAppend1);
+        BUFFER_delete(hAppend2);
+    }
+
+    /*Tests_SRS_BUFFER_01_029: [When BUFFER_prepend moves the content or allocates new memory, it shall split the unused capacity evenly between the front and the back of the content.]*/
+    /*Tests_SRS_BUFFER_01_030: [Otherwise BUFFER_prepend shall allocate the larger of twice the capacity of handle1 and the number of bytes needed.]*/
+    /*Tests_SRS_BUFFER_01_028: [If handle1 has at least as many unused bytes in front of its content as the size of handle2, BUFFER_prepend shall copy the content of handle2 there without moving the content of handle1.]*/
+    TEST_FUNCTION(BUFFER_prepend_leaves_headroom_for_the_next_prepend)
+    {
+        ///arrange
+        BUFFER_HANDLE hPrepend;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        hPrepend = BUFFER_create(BUFFER_Test1, BUFFER_TEST1_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(2 * ALLOCATION_SIZE));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        int result1 = BUFFER_prepend(g_hBuffer, hPrepend);
+        int result2 = BUFFER_prepend(g_hBuffer, hPrepend);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE + 2 * BUFFER_TEST1_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer) + BUFFER_TEST1_SIZE, BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer) + 2 * BUFFER_TEST1_SIZE, BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+        BUFFER_delete(hPrepend);
+    }
+
+    /*Tests_SRS_BUFFER_01_029: [When BUFFER_prepend moves the content or allocates new memory, it shall split the unused capacity evenly between the front and the back of the content.]*/
+    TEST_FUNCTION(BUFFER_prepend_in_place_leaves_room_at_both_ends)
+    {
+        ///arrange
+        BUFFER_HANDLE hOther;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        (void)BUFFER_reserve(g_hBuffer, 2 * ALLOCATION_SIZE);
+        hOther = BUFFER_create(BUFFER_Test1, BUFFER_TEST1_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result1 = BUFFER_prepend(g_hBuffer, hOther);
+        int result2 = BUFFER_prepend(g_hBuffer, hOther);
+        int result3 = BUFFER_append(g_hBuffer, hOther);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_ARE_EQUAL(int, 0, result3);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE + 3 * BUFFER_TEST1_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer) + BUFFER_TEST1_SIZE, BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer) + 2 * BUFFER_TEST1_SIZE, BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer) + 2 * BUFFER_TEST1_SIZE + ALLOCATION_SIZE, BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+        BUFFER_delete(hOther);
+    }
+
+    /* BUFFER_reserve_front Tests BEGIN */
+    /*Tests_SRS_BUFFER_01_031: [If handle is NULL, BUFFER_reserve_front shall fail and return a non-zero value.]*/
+    TEST_FUNCTION(BUFFER_reserve_front_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        int result = BUFFER_reserve_front(NULL, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /*Tests_SRS_BUFFER_01_033: [Otherwise BUFFER_reserve_front shall reallocate the memory so that headroom unused bytes are in front of the content, keeping the content, its size and the unused bytes after it, and return 0.]*/
+    /*Tests_SRS_BUFFER_01_028: [If handle1 has at least as many unused bytes in front of its content as the size of handle2, BUFFER_prepend shall copy the content of handle2 there without moving the content of handle1.]*/
+    TEST_FUNCTION(BUFFER_reserve_front_makes_the_next_prepend_not_allocate)
+    {
+        ///arrange
+        BUFFER_HANDLE hPrepend;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        hPrepend = BUFFER_create(BUFFER_Test1, BUFFER_TEST1_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, BUFFER_TEST1_SIZE + ALLOCATION_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        int result1 = BUFFER_reserve_front(g_hBuffer, BUFFER_TEST1_SIZE);
+        unsigned char* content = BUFFER_u_char(g_hBuffer);
+        int result2 = BUFFER_prepend(g_hBuffer, hPrepend);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_ARE_EQUAL(void_ptr, content - BUFFER_TEST1_SIZE, BUFFER_u_char(g_hBuffer));
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST1_SIZE + ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer) + BUFFER_TEST1_SIZE, BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+        BUFFER_delete(hPrepend);
+    }
+
+    /*Tests_SRS_BUFFER_01_033: [Otherwise BUFFER_reserve_front shall reallocate the memory so that headroom unused bytes are in front of the content, keeping the content, its size and the unused bytes after it, and return 0.]*/
+    TEST_FUNCTION(BUFFER_reserve_front_keeps_the_room_after_the_content)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        (void)BUFFER_reserve(g_hBuffer, TOTAL_ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, BUFFER_TEST1_SIZE + TOTAL_ALLOCATION_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        int result1 = BUFFER_reserve_front(g_hBuffer, BUFFER_TEST1_SIZE);
+        int result2 = BUFFER_enlarge(g_hBuffer, ALLOCATION_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_032: [If the buffer already has headroom unused bytes in front of its content, BUFFER_reserve_front shall succeed without allocating memory.]*/
+    TEST_FUNCTION(BUFFER_reserve_front_with_enough_headroom_does_not_allocate)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        (void)BUFFER_reserve_front(g_hBuffer, BUFFER_TEST2_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_reserve_front(g_hBuffer, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_033: [Otherwise BUFFER_reserve_front shall reallocate the memory so that headroom unused bytes are in front of the content, keeping the content, its size and the unused bytes after it, and return 0.]*/
+    TEST_FUNCTION(BUFFER_reserve_front_on_an_empty_buffer_succeeds)
+    {
+        ///arrange
+        BUFFER_HANDLE hPrepend;
+        BUFFER_HANDLE g_hBuffer = BUFFER_new();
+        hPrepend = BUFFER_create(BUFFER_Test1, BUFFER_TEST1_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, BUFFER_TEST1_SIZE));
+
+        ///act
+        int result1 = BUFFER_reserve_front(g_hBuffer, BUFFER_TEST1_SIZE);
+        int result2 = BUFFER_prepend(g_hBuffer, hPrepend);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_ARE_EQUAL(size_t, BUFFER_TEST1_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_Test1, BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+        BUFFER_delete(hPrepend);
+    }
+
+    /*Tests_SRS_BUFFER_01_034: [If any error occurs, BUFFER_reserve_front shall fail, return a non-zero value and leave the buffer unchanged.]*/
+    TEST_FUNCTION(BUFFER_reserve_front_fails_when_realloc_fails)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        whenShallrealloc_fail = currentrealloc_call + 1;
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, BUFFER_TEST1_SIZE + ALLOCATION_SIZE))
+            .IgnoreArgument(1);
+
+        ///act
+        int result = BUFFER_reserve_front(g_hBuffer, BUFFER_TEST1_SIZE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_034: [If any error occurs, BUFFER_reserve_front shall fail, return a non-zero value and leave the buffer unchanged.]*/
+    TEST_FUNCTION(BUFFER_reserve_front_with_overflowing_headroom_fails)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_reserve_front(g_hBuffer, (size_t)-1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_035: [If there are unused bytes in front of the content, BUFFER_transfer shall first move the content to the beginning of the memory.]*/
+    TEST_FUNCTION(BUFFER_transfer_with_headroom_moves_the_content_to_the_beginning)
+    {
+        ///arrange
+        unsigned char* memory;
+        size_t size;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        (void)BUFFER_reserve_front(g_hBuffer, BUFFER_TEST1_SIZE);
+        unsigned char* expected = BUFFER_u_char(g_hBuffer) - BUFFER_TEST1_SIZE;
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_transfer(g_hBuffer, &memory, &size);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(void_ptr, expected, memory);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, size);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(memory, BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        free(memory);
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_019: [Otherwise BUFFER_shrink shall remove the first decreaseSize bytes by skipping them, without moving the remaining bytes.]*/
+    TEST_FUNCTION(BUFFER_shrink_from_the_beginning_does_not_move_the_content)
+    {
+        ///arrange
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE);
+        unsigned char* content = BUFFER_u_char(g_hBuffer);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_shrink(g_hBuffer, BUFFER_TEST1_SIZE, false);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(void_ptr, content + BUFFER_TEST1_SIZE, BUFFER_u_char(g_hBuffer));
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE - BUFFER_TEST1_SIZE, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), TOTAL_BUFFER + BUFFER_TEST1_SIZE, TOTAL_ALLOCATION_SIZE - BUFFER_TEST1_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+    }
+
+    /*Tests_SRS_BUFFER_01_036: [If after that more than half of the capacity is in front of the content, BUFFER_shrink shall move the content to the beginning of the memory.]*/
+    TEST_FUNCTION(BUFFER_shrink_from_the_beginning_past_half_the_capacity_moves_the_content)
+    {
+        ///arrange
+        BUFFER_HANDLE hAppend;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE);
+        unsigned char* content = BUFFER_u_char(g_hBuffer);
+        hAppend = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result1 = BUFFER_shrink(g_hBuffer, ALLOCATION_SIZE + 1, false);
+        int result2 = BUFFER_append(g_hBuffer, hAppend);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_ARE_EQUAL(void_ptr, content, BUFFER_u_char(g_hBuffer));
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE - 1, BUFFER_length(g_hBuffer));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer), ADDITIONAL_BUFFER + 1, ALLOCATION_SIZE - 1));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(g_hBuffer) + ALLOCATION_SIZE - 1, BUFFER_TEST_VALUE, ALLOCATION_SIZE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+        BUFFER_delete(hAppend);
+    }
+
+    /*Tests_SRS_BUFFER_07_024: [BUFFER_append concatenates b2 onto b1 without modifying b2 and shall return zero on success.]*/
+    TEST_FUNCTION(BUFFER_append_and_BUFFER_clone_use_the_content_after_the_headroom)
+    {
+        ///arrange
+        BUFFER_HANDLE hTarget;
+        BUFFER_HANDLE hClone;
+        BUFFER_HANDLE g_hBuffer = BUFFER_create(TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE);
+        (void)BUFFER_shrink(g_hBuffer, ALLOCATION_SIZE, false);
+        hTarget = BUFFER_create(BUFFER_TEST_VALUE, ALLOCATION_SIZE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = BUFFER_append(hTarget, g_hBuffer);
+        hClone = BUFFER_clone(g_hBuffer);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, TOTAL_ALLOCATION_SIZE, BUFFER_length(hTarget));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hTarget), TOTAL_BUFFER, TOTAL_ALLOCATION_SIZE));
+        ASSERT_IS_NOT_NULL(hClone);
+        ASSERT_ARE_EQUAL(size_t, ALLOCATION_SIZE, BUFFER_length(hClone));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hClone), ADDITIONAL_BUFFER, ALLOCATION_SIZE));
+
+        ///cleanup
+        BUFFER_delete(g_hBuffer);
+        BUFFER_delete(hTarget);
+        BUFFER_delete(hClone);
+    }
+
 END_TEST_SUITE(Buffer_UnitTests)
@@ -91,6 +91,7 @@ TEST_SUITE_INITIALIZE(suite_init)
 
     REGISTER_TYPE(MAP_RESULT, MAP_RESULT);
     REGISTER_UMOCK_ALIAS_TYPE(STRING_TOKENIZER_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(STRING_VIEW*, void*);
     REGISTER_UMOCK_ALIAS_TYPE(STRING_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(MAP_FILTER_CALLBACK, void*);
     REGISTER_UMOCK_ALIAS_TYPE(MAP_HANDLE, void*);
@@ -141,30 +142,25 @@ TEST_FUNCTION_CLEANUP(TestMethodCleanup)
 /* connectionstringparser_parse */
 
 /* Tests_SRS_CONNECTIONSTRINGPARSER_01_001: [connectionstringparser_parse shall parse all key value pairs from the connection_string passed in as argument and return a new map that holds the key/value pairs.]  */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_003: [connectionstringparser_parse shall create a STRING tokenizer to be used for parsing the connection string, by calling STRING_TOKENIZER_create.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_020: [connectionstringparser_parse shall obtain the characters of connection_string by calling STRING_c_str and STRING_length.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_003: [connectionstringparser_parse shall make a single copy of the connection string, in which the key and value tokens are '\0' terminated in place.] */
 /* Tests_SRS_CONNECTIONSTRINGPARSER_01_004: [connectionstringparser_parse shall start scanning at the beginning of the connection string.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_016: [2 STRINGs shall be allocated in order to hold the to be parsed key and value tokens.] */
 /* Tests_SRS_CONNECTIONSTRINGPARSER_01_005: [The following actions shall be repeated until parsing is complete:] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_006: [connectionstringparser_parse shall find a token (the key of the key/value pair) delimited by the "=" character, by calling STRING_TOKENIZER_get_next_token.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_007: [If STRING_TOKENIZER_get_next_token fails, parsing shall be considered complete.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_014: [After the parsing is complete the previously allocated STRINGs and STRING tokenizer shall be freed by calling STRING_TOKENIZER_destroy.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_006: [connectionstringparser_parse shall find a token (the key of the key/value pair) delimited by the `=` character, by calling STRING_VIEW_get_next_token.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_007: [If STRING_VIEW_get_next_token fails, parsing shall be considered complete.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_014: [After the parsing is complete the copy of the connection string shall be freed.] */
 TEST_FUNCTION(connectionstringparser_parse_with_an_empty_string_yields_an_empty_map)
 {
     // arrange
     STRING_HANDLE connectionString = STRING_new();
-    STRING_HANDLE key = STRING_new();
-    STRING_HANDLE value = STRING_new();
-    STRING_TOKENIZER_HANDLE tokens = STRING_TOKENIZER_create(connectionString);
 
     umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(connectionString)).SetReturn(tokens);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(key);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(value);
+    STRICT_EXPECTED_CALL(STRING_c_str(connectionString));
+    STRICT_EXPECTED_CALL(STRING_length(connectionString));
+    STRICT_EXPECTED_CALL(gballoc_malloc(1));
     STRICT_EXPECTED_CALL(Map_Create(NULL));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_delete(value));
-    STRICT_EXPECTED_CALL(STRING_delete(key));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(tokens));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
 
     // act
     MAP_HANDLE result = connectionstringparser_parse(connectionString);
@@ -190,32 +186,12 @@ TEST_FUNCTION(connectionstringparser_parse_with_NULL_connection_string_fails)
     ASSERT_ARE_EQUAL(void_ptr, NULL, result);
 }
 
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_015: [If STRING_TOKENIZER_create fails, connectionstringparser_parse shall fail and return NULL.] */
-TEST_FUNCTION(when_creating_the_string_tokenizer_fails_then_connectionstringparser_fails)
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_013: [If STRING_c_str fails then connectionstringparser_parse shall fail and return NULL.] */
+TEST_FUNCTION(when_getting_the_C_string_of_the_connection_string_fails_then_connectionstringparser_parse_fails)
 {
     // arrange
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR))
-        .SetReturn((STRING_TOKENIZER_HANDLE)NULL);
-
-    // act
-    MAP_HANDLE result = connectionstringparser_parse(TEST_STRING_HANDLE_PAIR);
-
-    // assert
-    ASSERT_ARE_EQUAL(void_ptr, NULL, result);
-
-    // cleanup
-}
-
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_017: [If allocating the STRINGs fails connectionstringparser_parse shall fail and return NULL.] */
-TEST_FUNCTION(when_allocating_the_key_token_string_fails_then_connectionstringparser_fails)
-{
-    // arrange
-    STRING_TOKENIZER_HANDLE tokens = STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR);
-
-    umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR)).SetReturn(tokens);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn((STRING_HANDLE)NULL);
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(tokens));
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_PAIR))
+        .SetReturn((const char*)NULL);
 
     // act
     MAP_HANDLE result = connectionstringparser_parse(TEST_STRING_HANDLE_PAIR);
@@ -223,23 +199,16 @@ TEST_FUNCTION(when_allocating_the_key_token_string_fails_then_connectionstringpa
     // assert
     ASSERT_ARE_EQUAL(void_ptr, NULL, result);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-
-    // cleanup
 }
 
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_017: [If allocating the STRINGs fails connectionstringparser_parse shall fail and return NULL.] */
-TEST_FUNCTION(when_allocating_the_value_token_string_fails_then_connectionstringparser_fails)
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_015: [If allocating the copy of the connection string fails, connectionstringparser_parse shall fail and return NULL.] */
+TEST_FUNCTION(when_allocating_the_copy_of_the_connection_string_fails_then_connectionstringparser_parse_fails)
 {
     // arrange
-    STRING_HANDLE key = STRING_new();
-    STRING_TOKENIZER_HANDLE tokens = STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR);
-
-    umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR)).SetReturn(tokens);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(key);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn((STRING_HANDLE)NULL);
-    STRICT_EXPECTED_CALL(STRING_delete(key));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(tokens));
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(STRING_length(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(gballoc_malloc(12))
+        .SetReturn(NULL);
 
     // act
     MAP_HANDLE result = connectionstringparser_parse(TEST_STRING_HANDLE_PAIR);
@@ -247,26 +216,18 @@ TEST_FUNCTION(when_allocating_the_value_token_string_fails_then_connectionstring
     // assert
     ASSERT_ARE_EQUAL(void_ptr, NULL, result);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-
-    // cleanup
 }
 
 /* Tests_SRS_CONNECTIONSTRINGPARSER_01_018: [If creating the result map fails, then connectionstringparser_parse shall return NULL.] */
 TEST_FUNCTION(when_allocating_the_result_map_fails_then_connectionstringparser_fails)
 {
     // arrange
-    STRING_HANDLE key = STRING_new();
-    STRING_HANDLE value = STRING_new();
-    STRING_TOKENIZER_HANDLE tokens = STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR);
-
-    umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR)).SetReturn(tokens);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(key);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn((MAP_HANDLE)NULL);
-    STRICT_EXPECTED_CALL(STRING_delete(value));
-    STRICT_EXPECTED_CALL(STRING_delete(key));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(tokens));
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(STRING_length(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(gballoc_malloc(12));
+    STRICT_EXPECTED_CALL(Map_Create(NULL))
+        .SetReturn((MAP_HANDLE)NULL);
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
 
     // act
     MAP_HANDLE result = connectionstringparser_parse(TEST_STRING_HANDLE_PAIR);
@@ -274,48 +235,30 @@ TEST_FUNCTION(when_allocating_the_result_map_fails_then_connectionstringparser_f
     // assert
     ASSERT_ARE_EQUAL(void_ptr, NULL, result);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-
-    // cleanup
 }
 
 /* Tests_SRS_CONNECTIONSTRINGPARSER_01_001: [connectionstringparser_parse shall parse all key value pairs from the connection_string passed in as argument and return a new map that holds the key/value pairs.]  */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_003: [connectionstringparser_parse shall create a STRING tokenizer to be used for parsing the connection string, by calling STRING_TOKENIZER_create.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_004: [connectionstringparser_parse shall start scanning at the beginning of the connection string.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_016: [2 STRINGs shall be allocated in order to hold the to be parsed key and value tokens.] */
 /* Tests_SRS_CONNECTIONSTRINGPARSER_01_005: [The following actions shall be repeated until parsing is complete:] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_006: [connectionstringparser_parse shall find a token (the key of the key/value pair) delimited by the "=" character, by calling STRING_TOKENIZER_get_next_token.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_007: [If STRING_TOKENIZER_get_next_token fails, parsing shall be considered complete.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_014: [After the parsing is complete the previously allocated STRINGs and STRING tokenizer shall be freed by calling STRING_TOKENIZER_destroy.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_008: [connectionstringparser_parse shall find a token (the value of the key/value pair) delimited by the ";" character, by calling STRING_TOKENIZER_get_next_token.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_006: [connectionstringparser_parse shall find a token (the key of the key/value pair) delimited by the `=` character, by calling STRING_VIEW_get_next_token.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_007: [If STRING_VIEW_get_next_token fails, parsing shall be considered complete.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_008: [connectionstringparser_parse shall find a token (the value of the key/value pair) delimited by the `;` character, by calling STRING_VIEW_get_next_token.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_011: [The key and value shall be '\0' terminated in the copy of the connection string, over the delimiter that ends them.] */
 /* Tests_SRS_CONNECTIONSTRINGPARSER_01_010: [The key and value shall be added to the result map by using Map_Add.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_011: [The C strings for the key and value shall be extracted from the previously parsed STRINGs by using STRING_c_str.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_014: [After the parsing is complete the copy of the connection string shall be freed.] */
 TEST_FUNCTION(connectionstringparser_parse_with_a_key_value_pair_adds_it_to_the_result_map)
 {
     // arrange
-    STRING_HANDLE key = STRING_new();
-    STRING_HANDLE value = STRING_new();
-    STRING_TOKENIZER_HANDLE tokens = STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR);
-
-    umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR)).SetReturn(tokens);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(key);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(value);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(STRING_length(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(gballoc_malloc(12));
     STRICT_EXPECTED_CALL(Map_Create(NULL));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_PAIR, 4));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
-    STRICT_EXPECTED_CALL(STRING_copy_n(value, (TEST_STRING_PAIR +5), 6));
-    STRICT_EXPECTED_CALL(STRING_c_str(key));
-    STRICT_EXPECTED_CALL(STRING_c_str(value));
-    STRICT_EXPECTED_CALL(Map_Add(IGNORED_PTR_ARG, "key1", "value1")).IgnoreArgument(1);
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, ";"));
+    STRICT_EXPECTED_CALL(Map_Add(IGNORED_PTR_ARG, "key1", "value1"));
     STRICT_EXPECTED_CALL(gballoc_malloc(5));
     STRICT_EXPECTED_CALL(gballoc_malloc(7));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_delete(value));
-    STRICT_EXPECTED_CALL(STRING_delete(key));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(tokens));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
 
     // act
     MAP_HANDLE result = connectionstringparser_parse(TEST_STRING_HANDLE_PAIR);
@@ -324,34 +267,24 @@ TEST_FUNCTION(connectionstringparser_parse_with_a_key_value_pair_adds_it_to_the_
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
     ASSERT_ARE_NOT_EQUAL(void_ptr, NULL, result);
     ASSERT_ARE_EQUAL(char_ptr, "value1", Map_GetValueFromKey(result, "key1"));
+    ASSERT_ARE_EQUAL(char_ptr, TEST_STRING_PAIR, STRING_c_str(TEST_STRING_HANDLE_PAIR));
 
     // cleanup
     Map_Destroy(result);
 }
 
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_009: [If STRING_TOKENIZER_get_next_token fails, connectionstringparser_parse shall fail and return NULL (freeing the allocated result map).] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_009: [If STRING_VIEW_get_next_token fails, connectionstringparser_parse shall fail and return NULL (freeing the allocated result map).] */
 TEST_FUNCTION(when_getting_the_value_token_fails_then_connectionstringparser_parse_fails)
 {
     // arrange
-    STRING_HANDLE key = STRING_new();
-    STRING_HANDLE value = STRING_new();
-    MAP_HANDLE map = Map_Create(NULL);
-    STRING_TOKENIZER_HANDLE tokens = STRING_TOKENIZER_create(TEST_STRING_HANDLE_KEY);
-
-    umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_KEY)).SetReturn(tokens);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(key);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_KEY, 4));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
-    STRICT_EXPECTED_CALL(Map_Destroy(map));
-    STRICT_EXPECTED_CALL(STRING_delete(value));
-    STRICT_EXPECTED_CALL(STRING_delete(key));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(tokens));
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_KEY));
+    STRICT_EXPECTED_CALL(STRING_length(TEST_STRING_HANDLE_KEY));
+    STRICT_EXPECTED_CALL(gballoc_malloc(6));
+    STRICT_EXPECTED_CALL(Map_Create(NULL));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, ";"));
+    STRICT_EXPECTED_CALL(Map_Destroy(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
 
     // act
     MAP_HANDLE result = connectionstringparser_parse(TEST_STRING_HANDLE_KEY);
@@ -365,26 +298,20 @@ TEST_FUNCTION(when_getting_the_value_token_fails_then_connectionstringparser_par
 TEST_FUNCTION(when_the_key_is_zero_length_then_connectionstringparser_parse_fails)
 {
     // arrange
-    STRING_HANDLE key = STRING_new();
-    STRING_HANDLE value = STRING_new();
-    MAP_HANDLE map = Map_Create(NULL);
+    STRING_VIEW empty_key;
+    empty_key.str = TEST_STRING_PAIR;
+    empty_key.length = 0;
 
-    umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR));
     STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_PAIR));
-    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)).IgnoreAllArguments();
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(key);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(IGNORED_PTR_ARG, key, "=")).IgnoreArgument(1);
-    STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_PAIR, 4));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(IGNORED_PTR_ARG, value, ";")).IgnoreArgument(1);
-    STRICT_EXPECTED_CALL(STRING_copy_n(value, (TEST_STRING_PAIR + 5), 6));
-    STRICT_EXPECTED_CALL(STRING_c_str(key)).SetReturn("");
-    STRICT_EXPECTED_CALL(Map_Destroy(map));
-    STRICT_EXPECTED_CALL(STRING_delete(value));
-    STRICT_EXPECTED_CALL(STRING_delete(key));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(IGNORED_PTR_ARG)).IgnoreArgument(1);
+    STRICT_EXPECTED_CALL(STRING_length(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(gballoc_malloc(12));
+    STRICT_EXPECTED_CALL(Map_Create(NULL));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="))
+        .CopyOutArgumentBuffer_token(&empty_key, sizeof(empty_key))
+        .SetReturn(0);
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, ";"));
+    STRICT_EXPECTED_CALL(Map_Destroy(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
 
     // act
     MAP_HANDLE result = connectionstringparser_parse(TEST_STRING_HANDLE_PAIR);
@@ -398,97 +325,16 @@ TEST_FUNCTION(when_the_key_is_zero_length_then_connectionstringparser_parse_fail
 TEST_FUNCTION(when_adding_the_key_value_pair_to_the_map_fails_then_connectionstringparser_parse_fails)
 {
     // arrange
-    STRING_HANDLE key = STRING_new();
-    STRING_HANDLE value = STRING_new();
-    MAP_HANDLE map = Map_Create(NULL);
-    STRING_TOKENIZER_HANDLE tokens = STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR);
-
-    umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR)).SetReturn(tokens);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(key);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_PAIR, 4));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
-    STRICT_EXPECTED_CALL(STRING_copy_n(value, (TEST_STRING_PAIR + 5), 6));
-    STRICT_EXPECTED_CALL(STRING_c_str(key));
-    STRICT_EXPECTED_CALL(STRING_c_str(value));
-    STRICT_EXPECTED_CALL(Map_Add(map, "key1", "value1")).SetReturn((MAP_RESULT)MAP_INVALIDARG);
-    STRICT_EXPECTED_CALL(Map_Destroy(map));
-    STRICT_EXPECTED_CALL(STRING_delete(value));
-    STRICT_EXPECTED_CALL(STRING_delete(key));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(tokens));
-
-    // act
-    MAP_HANDLE result = connectionstringparser_parse(TEST_STRING_HANDLE_PAIR);
-
-    // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, NULL, result);
-}
-
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_013: [If STRING_c_str fails then connectionstringparser_parse shall fail and return NULL (freeing the allocated result map).] */
-TEST_FUNCTION(when_getting_the_C_string_for_the_key_fails_then_connectionstringparser_parse_fails)
-{
-    // arrange
-    STRING_HANDLE key = STRING_new();
-    STRING_HANDLE value = STRING_new();
-    MAP_HANDLE map = Map_Create(NULL);
-
-    umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR));
     STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_PAIR));
-    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)).IgnoreAllArguments();
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(key);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(IGNORED_PTR_ARG, key, "=")).IgnoreArgument(1);
-    STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_PAIR, 4));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(IGNORED_PTR_ARG, value, ";")).IgnoreArgument(1);
-    STRICT_EXPECTED_CALL(STRING_copy_n(value, (TEST_STRING_PAIR + 5), 6));
-    STRICT_EXPECTED_CALL(STRING_c_str(key)).SetReturn(NULL);
-    STRICT_EXPECTED_CALL(Map_Destroy(map));
-    STRICT_EXPECTED_CALL(STRING_delete(value));
-    STRICT_EXPECTED_CALL(STRING_delete(key));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(IGNORED_PTR_ARG)).IgnoreArgument(1);
-
-    // act
-    MAP_HANDLE result = connectionstringparser_parse(TEST_STRING_HANDLE_PAIR);
-
-    // assert
-    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, NULL, result);
-}
-
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_013: [If STRING_c_str fails then connectionstringparser_parse shall fail and return NULL (freeing the allocated result map).] */
-TEST_FUNCTION(when_getting_the_C_string_for_the_value_fails_then_connectionstringparser_parse_fails)
-{
-    // arrange
-    STRING_HANDLE key = STRING_new();
-    STRING_HANDLE value = STRING_new();
-    MAP_HANDLE map = Map_Create(NULL);
-    STRING_TOKENIZER_HANDLE tokens = STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR);
-
-    umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_PAIR)).SetReturn(tokens);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(key);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_PAIR, 4));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
-    STRICT_EXPECTED_CALL(STRING_copy_n(value, (TEST_STRING_PAIR + 5), 6));
-    STRICT_EXPECTED_CALL(STRING_c_str(key));
-    STRICT_EXPECTED_CALL(STRING_c_str(value)).SetReturn((const char*)NULL);
-    STRICT_EXPECTED_CALL(Map_Destroy(map));
-    STRICT_EXPECTED_CALL(STRING_delete(value));
-    STRICT_EXPECTED_CALL(STRING_delete(key));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(tokens));
+    STRICT_EXPECTED_CALL(STRING_length(TEST_STRING_HANDLE_PAIR));
+    STRICT_EXPECTED_CALL(gballoc_malloc(12));
+    STRICT_EXPECTED_CALL(Map_Create(NULL));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, ";"));
+    STRICT_EXPECTED_CALL(Map_Add(IGNORED_PTR_ARG, "key1", "value1"))
+        .SetReturn((MAP_RESULT)MAP_INVALIDARG);
+    STRICT_EXPECTED_CALL(Map_Destroy(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
 
     // act
     MAP_HANDLE result = connectionstringparser_parse(TEST_STRING_HANDLE_PAIR);
@@ -499,133 +345,81 @@ TEST_FUNCTION(when_getting_the_C_string_for_the_value_fails_then_connectionstrin
 }
 
 /* Tests_SRS_CONNECTIONSTRINGPARSER_01_001: [connectionstringparser_parse shall parse all key value pairs from the connection_string passed in as argument and return a new map that holds the key/value pairs.]  */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_003: [connectionstringparser_parse shall create a STRING tokenizer to be used for parsing the connection string, by calling STRING_TOKENIZER_create.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_004: [connectionstringparser_parse shall start scanning at the beginning of the connection string.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_016: [2 STRINGs shall be allocated in order to hold the to be parsed key and value tokens.] */
 /* Tests_SRS_CONNECTIONSTRINGPARSER_01_005: [The following actions shall be repeated until parsing is complete:] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_006: [connectionstringparser_parse shall find a token (the key of the key/value pair) delimited by the "=" character, by calling STRING_TOKENIZER_get_next_token.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_007: [If STRING_TOKENIZER_get_next_token fails, parsing shall be considered complete.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_014: [After the parsing is complete the previously allocated STRINGs and STRING tokenizer shall be freed by calling STRING_TOKENIZER_destroy.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_008: [connectionstringparser_parse shall find a token (the value of the key/value pair) delimited by the ";" character, by calling STRING_TOKENIZER_get_next_token.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_006: [connectionstringparser_parse shall find a token (the key of the key/value pair) delimited by the `=` character, by calling STRING_VIEW_get_next_token.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_008: [connectionstringparser_parse shall find a token (the value of the key/value pair) delimited by the `;` character, by calling STRING_VIEW_get_next_token.] */
 /* Tests_SRS_CONNECTIONSTRINGPARSER_01_010: [The key and value shall be added to the result map by using Map_Add.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_011: [The C strings for the key and value shall be extracted from the previously parsed STRINGs by using STRING_c_str.] */
 TEST_FUNCTION(connectionstringparser_parse_with_2_key_value_pairs_adds_them_to_the_result_map)
 {
     // arrange
-    STRING_HANDLE key = STRING_new();
-    STRING_HANDLE value = STRING_new();
-    MAP_HANDLE map = Map_Create(NULL);
-    STRING_TOKENIZER_HANDLE tokens = STRING_TOKENIZER_create(TEST_STRING_HANDLE_2_PAIR);
-
-    umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_2_PAIR)).SetReturn(tokens);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(key);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_2_PAIR));
+    STRICT_EXPECTED_CALL(STRING_length(TEST_STRING_HANDLE_2_PAIR));
+    STRICT_EXPECTED_CALL(gballoc_malloc(24));
+    STRICT_EXPECTED_CALL(Map_Create(NULL));
 
     // 1st kvp
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_2_PAIR, 4));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
-    STRICT_EXPECTED_CALL(STRING_copy_n(value, (TEST_STRING_2_PAIR + 5), 6));
-    STRICT_EXPECTED_CALL(STRING_c_str(key));
-    STRICT_EXPECTED_CALL(STRING_c_str(value));
-    STRICT_EXPECTED_CALL(Map_Add(map, "key1", "value1"));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, ";"));
+    STRICT_EXPECTED_CALL(Map_Add(IGNORED_PTR_ARG, "key1", "value1"));
     STRICT_EXPECTED_CALL(gballoc_malloc(5));
     STRICT_EXPECTED_CALL(gballoc_malloc(7));
 
-    // 2st kvp
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_copy_n(key, (TEST_STRING_2_PAIR + 12), 4));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
-    STRICT_EXPECTED_CALL(STRING_copy_n(value, (TEST_STRING_2_PAIR + 17), 6));
-    STRICT_EXPECTED_CALL(STRING_c_str(key));
-    STRICT_EXPECTED_CALL(STRING_c_str(value));
-    STRICT_EXPECTED_CALL(Map_Add(map, "key2", "value2"));
+    // 2nd kvp
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, ";"));
+    STRICT_EXPECTED_CALL(Map_Add(IGNORED_PTR_ARG, "key2", "value2"));
     STRICT_EXPECTED_CALL(gballoc_malloc(5));
     STRICT_EXPECTED_CALL(gballoc_malloc(7));
 
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_delete(value));
-    STRICT_EXPECTED_CALL(STRING_delete(key));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(tokens));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
 
     // act
     MAP_HANDLE result = connectionstringparser_parse(TEST_STRING_HANDLE_2_PAIR);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, map, result);
+    ASSERT_ARE_NOT_EQUAL(void_ptr, NULL, result);
     ASSERT_ARE_EQUAL(char_ptr, "value1", Map_GetValueFromKey(result, "key1"));
     ASSERT_ARE_EQUAL(char_ptr, "value2", Map_GetValueFromKey(result, "key2"));
 
     // cleanup
     Map_Destroy(result);
-
 }
 
 /* Tests_SRS_CONNECTIONSTRINGPARSER_01_001: [connectionstringparser_parse shall parse all key value pairs from the connection_string passed in as argument and return a new map that holds the key/value pairs.]  */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_003: [connectionstringparser_parse shall create a STRING tokenizer to be used for parsing the connection string, by calling STRING_TOKENIZER_create.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_004: [connectionstringparser_parse shall start scanning at the beginning of the connection string.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_016: [2 STRINGs shall be allocated in order to hold the to be parsed key and value tokens.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_005: [The following actions shall be repeated until parsing is complete:] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_006: [connectionstringparser_parse shall find a token (the key of the key/value pair) delimited by the "=" character, by calling STRING_TOKENIZER_get_next_token.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_007: [If STRING_TOKENIZER_get_next_token fails, parsing shall be considered complete.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_014: [After the parsing is complete the previously allocated STRINGs and STRING tokenizer shall be freed by calling STRING_TOKENIZER_destroy.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_008: [connectionstringparser_parse shall find a token (the value of the key/value pair) delimited by the ";" character, by calling STRING_TOKENIZER_get_next_token.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_010: [The key and value shall be added to the result map by using Map_Add.] */
-/* Tests_SRS_CONNECTIONSTRINGPARSER_01_011: [The C strings for the key and value shall be extracted from the previously parsed STRINGs by using STRING_c_str.] */
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_007: [If STRING_VIEW_get_next_token fails, parsing shall be considered complete.] */
 TEST_FUNCTION(connectionstringparser_parse_with_2_key_value_pairs_ended_with_semicolon_adds_them_to_the_result_map)
 {
     // arrange
-    STRING_HANDLE key = STRING_new();
-    STRING_HANDLE value = STRING_new();
-    MAP_HANDLE map = Map_Create(NULL);
-    STRING_TOKENIZER_HANDLE tokens = STRING_TOKENIZER_create(TEST_STRING_HANDLE_2_PAIR_SEMICOLON);
-
-    umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_2_PAIR_SEMICOLON)).SetReturn(tokens);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(key);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_STRING_HANDLE_2_PAIR_SEMICOLON));
+    STRICT_EXPECTED_CALL(STRING_length(TEST_STRING_HANDLE_2_PAIR_SEMICOLON));
+    STRICT_EXPECTED_CALL(gballoc_malloc(25));
+    STRICT_EXPECTED_CALL(Map_Create(NULL));
 
     // 1st kvp
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_2_PAIR_SEMICOLON, 4));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
-    STRICT_EXPECTED_CALL(STRING_copy_n(value, (TEST_STRING_2_PAIR_SEMICOLON + 5), 6));
-    STRICT_EXPECTED_CALL(STRING_c_str(key));
-    STRICT_EXPECTED_CALL(STRING_c_str(value));
-    STRICT_EXPECTED_CALL(Map_Add(map, "key1", "value1"));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, ";"));
+    STRICT_EXPECTED_CALL(Map_Add(IGNORED_PTR_ARG, "key1", "value1"));
     STRICT_EXPECTED_CALL(gballoc_malloc(5));
     STRICT_EXPECTED_CALL(gballoc_malloc(7));
 
-    // 2st kvp
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_copy_n(key, (TEST_STRING_2_PAIR_SEMICOLON + 12), 4));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
-    STRICT_EXPECTED_CALL(STRING_copy_n(value, (TEST_STRING_2_PAIR_SEMICOLON + 17), 6));
-    STRICT_EXPECTED_CALL(STRING_c_str(key));
-    STRICT_EXPECTED_CALL(STRING_c_str(value));
-    STRICT_EXPECTED_CALL(Map_Add(map, "key2", "value2"));
+    // 2nd kvp
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, ";"));
+    STRICT_EXPECTED_CALL(Map_Add(IGNORED_PTR_ARG, "key2", "value2"));
     STRICT_EXPECTED_CALL(gballoc_malloc(5));
     STRICT_EXPECTED_CALL(gballoc_malloc(7));
 
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_delete(value));
-    STRICT_EXPECTED_CALL(STRING_delete(key));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(tokens));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
 
     // act
     MAP_HANDLE result = connectionstringparser_parse(TEST_STRING_HANDLE_2_PAIR_SEMICOLON);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, map, result);
+    ASSERT_ARE_NOT_EQUAL(void_ptr, NULL, result);
     ASSERT_ARE_EQUAL(char_ptr, "value1", Map_GetValueFromKey(result, "key1"));
     ASSERT_ARE_EQUAL(char_ptr, "value2", Map_GetValueFromKey(result, "key2"));
 
@@ -633,57 +427,58 @@ TEST_FUNCTION(connectionstringparser_parse_with_2_key_value_pairs_ended_with_sem
     Map_Destroy(result);
 }
 
-/* Tests_SRS_CONNECTIONSTRINGPARSER_21_020: [connectionstringparser_parse_from_char shall create a STRING_HANDLE from the connection_string passed in as argument and parse it using the connectionstringparser_parse.]*/
-TEST_FUNCTION(connectionstringparser_parse_from_char_with_2_key_value_pairs_ended_with_semicolon_adds_them_to_the_result_map)
+/* Tests_SRS_CONNECTIONSTRINGPARSER_01_008: [connectionstringparser_parse shall find a token (the value of the key/value pair) delimited by the `;` character, by calling STRING_VIEW_get_next_token.] */
+TEST_FUNCTION(connectionstringparser_parse_keeps_equal_signs_in_values)
 {
     // arrange
-    STRING_HANDLE key = STRING_new();
-    STRING_HANDLE value = STRING_new();
-    MAP_HANDLE map = Map_Create(NULL);
-    STRING_TOKENIZER_HANDLE tokens = STRING_TOKENIZER_create(TEST_STRING_HANDLE_2_PAIR_SEMICOLON);
+    STRING_HANDLE connectionString = STRING_construct("HostName=h.net;SharedAccessKey=a2V5==;DeviceId=d");
 
     umock_c_reset_all_calls();
-    STRICT_EXPECTED_CALL(STRING_construct(TEST_STRING_2_PAIR_SEMICOLON)).SetReturn(TEST_STRING_HANDLE_2_PAIR_SEMICOLON);
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_create(TEST_STRING_HANDLE_2_PAIR_SEMICOLON)).SetReturn(tokens);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(key);
-    STRICT_EXPECTED_CALL(STRING_new())
-        .SetReturn(value);
-    STRICT_EXPECTED_CALL(Map_Create(NULL)).SetReturn(map);
+
+    // act
+    MAP_HANDLE result = connectionstringparser_parse(connectionString);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, "h.net", Map_GetValueFromKey(result, "HostName"));
+    ASSERT_ARE_EQUAL(char_ptr, "a2V5==", Map_GetValueFromKey(result, "SharedAccessKey"));
+    ASSERT_ARE_EQUAL(char_ptr, "d", Map_GetValueFromKey(result, "DeviceId"));
+
+    // cleanup
+    Map_Destroy(result);
+    STRING_delete(connectionString);
+}
+
+/* Tests_SRS_CONNECTIONSTRINGPARSER_21_020: [connectionstringparser_parse_from_char shall parse the connection_string passed in as argument the same way connectionstringparser_parse does, without creating a STRING_HANDLE.]*/
+TEST_FUNCTION(connectionstringparser_parse_from_char_with_2_key_value_pairs_ended_with_semicolon_adds_them_to_the_result_map)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(gballoc_malloc(25));
+    STRICT_EXPECTED_CALL(Map_Create(NULL));
 
     // 1st kvp
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_copy_n(key, TEST_STRING_2_PAIR_SEMICOLON, 4));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
-    STRICT_EXPECTED_CALL(STRING_copy_n(value, (TEST_STRING_2_PAIR_SEMICOLON + 5), 6));
-    STRICT_EXPECTED_CALL(STRING_c_str(key));
-    STRICT_EXPECTED_CALL(STRING_c_str(value));
-    STRICT_EXPECTED_CALL(Map_Add(map, "key1", "value1"));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, ";"));
+    STRICT_EXPECTED_CALL(Map_Add(IGNORED_PTR_ARG, "key1", "value1"));
     STRICT_EXPECTED_CALL(gballoc_malloc(5));
     STRICT_EXPECTED_CALL(gballoc_malloc(7));
 
-    // 2st kvp
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_copy_n(key, (TEST_STRING_2_PAIR_SEMICOLON + 12), 4));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, value, ";"));
-    STRICT_EXPECTED_CALL(STRING_copy_n(value, (TEST_STRING_2_PAIR_SEMICOLON + 17), 6));
-    STRICT_EXPECTED_CALL(STRING_c_str(key));
-    STRICT_EXPECTED_CALL(STRING_c_str(value));
-    STRICT_EXPECTED_CALL(Map_Add(map, "key2", "value2"));
+    // 2nd kvp
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, ";"));
+    STRICT_EXPECTED_CALL(Map_Add(IGNORED_PTR_ARG, "key2", "value2"));
     STRICT_EXPECTED_CALL(gballoc_malloc(5));
     STRICT_EXPECTED_CALL(gballoc_malloc(7));
 
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_get_next_token(tokens, key, "="));
-    STRICT_EXPECTED_CALL(STRING_delete(value));
-    STRICT_EXPECTED_CALL(STRING_delete(key));
-    STRICT_EXPECTED_CALL(STRING_TOKENIZER_destroy(tokens));
+    STRICT_EXPECTED_CALL(STRING_VIEW_get_next_token(IGNORED_PTR_ARG, IGNORED_PTR_ARG, "="));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
 
     // act
     MAP_HANDLE result = connectionstringparser_parse_from_char(TEST_STRING_2_PAIR_SEMICOLON);
 
     // assert
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-    ASSERT_ARE_EQUAL(void_ptr, map, result);
+    ASSERT_ARE_NOT_EQUAL(void_ptr, NULL, result);
     ASSERT_ARE_EQUAL(char_ptr, "value1", Map_GetValueFromKey(result, "key1"));
     ASSERT_ARE_EQUAL(char_ptr, "value2", Map_GetValueFromKey(result, "key2"));
 
@@ -691,7 +486,7 @@ TEST_FUNCTION(connectionstringparser_parse_from_char_with_2_key_value_pairs_ende
     Map_Destroy(result);
 }
 
-/* Tests_SRS_CONNECTIONSTRINGPARSER_21_021: [If connectionstringparser_parse_from_char get error creating a STRING_HANDLE, it shall return NULL.]*/
+/* Tests_SRS_CONNECTIONSTRINGPARSER_21_021: [If connection_string is NULL, connectionstringparser_parse_from_char shall return NULL.]*/
 TEST_FUNCTION(connectionstringparser_parse_from_char_with_NULL_connection_string_fails)
 {
     // arrange
@@ -4,6 +4,7 @@
 #define GBALLOC_H
 
 #define Map_Create          real_Map_Create
+#define Map_CreateInArena   real_Map_CreateInArena
 #define Map_Destroy         real_Map_Destroy
 #define Map_Clone           real_Map_Clone
 #define Map_Add             real_Map_Add
@@ -6,6 +6,7 @@
 
 #define REGISTER_MAP_GLOBAL_MOCK_HOOK \
     REGISTER_GLOBAL_MOCK_HOOK(Map_Create, real_Map_Create); \
+    REGISTER_GLOBAL_MOCK_HOOK(Map_CreateInArena, real_Map_CreateInArena); \
     REGISTER_GLOBAL_MOCK_HOOK(Map_Destroy, real_Map_Destroy); \
     REGISTER_GLOBAL_MOCK_HOOK(Map_Clone, real_Map_Clone); \
     REGISTER_GLOBAL_MOCK_HOOK(Map_Add, real_Map_Add); \
@@ -25,6 +26,7 @@ extern "C"
 #include <stddef.h>
 #endif
     extern MAP_HANDLE real_Map_Create(MAP_FILTER_CALLBACK mapFilterFunc);
+    extern MAP_HANDLE real_Map_CreateInArena(ARENA_HANDLE arena, MAP_FILTER_CALLBACK mapFilterFunc);
     extern void real_Map_Destroy(MAP_HANDLE handle);
     extern MAP_HANDLE real_Map_Clone(MAP_HANDLE handle);
     extern MAP_RESULT real_Map_Add(MAP_HANDLE handle, const char* key, const char* value);
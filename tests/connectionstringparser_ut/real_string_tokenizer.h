@@ -8,12 +8,14 @@
     REGISTER_GLOBAL_MOCK_HOOK(STRING_TOKENIZER_create, real_STRING_TOKENIZER_create); \
     REGISTER_GLOBAL_MOCK_HOOK(STRING_TOKENIZER_create_from_char, real_STRING_TOKENIZER_create_from_char); \
     REGISTER_GLOBAL_MOCK_HOOK(STRING_TOKENIZER_get_next_token, real_STRING_TOKENIZER_get_next_token); \
-    REGISTER_GLOBAL_MOCK_HOOK(STRING_TOKENIZER_destroy, real_STRING_TOKENIZER_destroy); 
+    REGISTER_GLOBAL_MOCK_HOOK(STRING_TOKENIZER_destroy, real_STRING_TOKENIZER_destroy); \
+    REGISTER_GLOBAL_MOCK_HOOK(STRING_VIEW_get_next_token, real_STRING_VIEW_get_next_token); 
 
 #define STRING_TOKENIZER_create               real_STRING_TOKENIZER_create
 #define STRING_TOKENIZER_create_from_char     real_STRING_TOKENIZER_create_from_char
 #define STRING_TOKENIZER_get_next_token       real_STRING_TOKENIZER_get_next_token
 #define STRING_TOKENIZER_destroy              real_STRING_TOKENIZER_destroy
+#define STRING_VIEW_get_next_token            real_STRING_VIEW_get_next_token
 
 #undef STRING_TOKENIZER_H
 #include "azure_c_shared_utility/string_tokenizer.h"
@@ -24,6 +26,7 @@
 #undef STRING_TOKENIZER_create_from_char                
 #undef STRING_TOKENIZER_get_next_token            
 #undef STRING_TOKENIZER_destroy          
+#undef STRING_VIEW_get_next_token        
  
 #endif
 
@@ -13,9 +13,14 @@
     REGISTER_GLOBAL_MOCK_HOOK(STRING_new_quoted, real_STRING_new_quoted); \
     REGISTER_GLOBAL_MOCK_HOOK(STRING_new_JSON, real_STRING_new_JSON); \
     REGISTER_GLOBAL_MOCK_HOOK(STRING_from_byte_array, real_STRING_from_byte_array); \
+    REGISTER_GLOBAL_MOCK_HOOK(STRING_new_in_arena, real_STRING_new_in_arena); \
+    REGISTER_GLOBAL_MOCK_HOOK(STRING_construct_in_arena, real_STRING_construct_in_arena); \
     REGISTER_GLOBAL_MOCK_HOOK(STRING_delete, real_STRING_delete); \
     REGISTER_GLOBAL_MOCK_HOOK(STRING_concat, real_STRING_concat); \
     REGISTER_GLOBAL_MOCK_HOOK(STRING_concat_with_STRING, real_STRING_concat_with_STRING); \
+    REGISTER_GLOBAL_MOCK_HOOK(STRING_concat_n, real_STRING_concat_n); \
+    REGISTER_GLOBAL_MOCK_HOOK(STRING_concat_JSON, real_STRING_concat_JSON); \
+    REGISTER_GLOBAL_MOCK_HOOK(STRING_reserve, real_STRING_reserve); \
     REGISTER_GLOBAL_MOCK_HOOK(STRING_quote, real_STRING_quote); \
     REGISTER_GLOBAL_MOCK_HOOK(STRING_copy, real_STRING_copy); \
     REGISTER_GLOBAL_MOCK_HOOK(STRING_copy_n, real_STRING_copy_n); \
@@ -32,9 +37,14 @@
 #define STRING_new_quoted               real_STRING_new_quoted 
 #define STRING_new_JSON                 real_STRING_new_JSON 
 #define STRING_from_byte_array          real_STRING_from_byte_array 
+#define STRING_new_in_arena             real_STRING_new_in_arena 
+#define STRING_construct_in_arena       real_STRING_construct_in_arena 
 #define STRING_delete                   real_STRING_delete 
 #define STRING_concat                   real_STRING_concat 
 #define STRING_concat_with_STRING       real_STRING_concat_with_STRING 
+#define STRING_concat_n                 real_STRING_concat_n 
+#define STRING_concat_JSON              real_STRING_concat_JSON 
+#define STRING_reserve                  real_STRING_reserve 
 #define STRING_quote                    real_STRING_quote 
 #define STRING_copy                     real_STRING_copy 
 #define STRING_copy_n                   real_STRING_copy_n 
@@ -57,9 +67,14 @@
 #undef STRING_new_quoted           
 #undef STRING_new_JSON             
 #undef STRING_from_byte_array      
+#undef STRING_new_in_arena         
+#undef STRING_construct_in_arena   
 #undef STRING_delete               
 #undef STRING_concat               
 #undef STRING_concat_with_STRING   
+#undef STRING_concat_n             
+#undef STRING_concat_JSON          
+#undef STRING_reserve              
 #undef STRING_quote                
 #undef STRING_copy                 
 #undef STRING_copy_n               
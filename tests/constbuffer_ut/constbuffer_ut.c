@@ -99,6 +99,15 @@ size_t my_BUFFER_length(BUFFER_HANDLE handle)
     return result;
 }
 
+static size_t test_free_func_calls;
+static void* test_free_func_context;
+
+static void test_free_func(void* context)
+{
+    test_free_func_calls++;
+    test_free_func_context = context;
+}
+
 DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
 
 static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
@@ -145,6 +154,8 @@ BEGIN_TEST_SUITE(constbuffer_unittests)
 
         currentmalloc_call = 0;
         whenShallmalloc_fail = 0;
+        test_free_func_calls = 0;
+        test_free_func_context = NULL;
 
     }
 
@@ -591,4 +602,411 @@ BEGIN_TEST_SUITE(constbuffer_unittests)
         ///cleanup
     }
 
+    /*Tests_SRS_CONSTBUFFER_01_001: [If source is NULL and size is different than 0 then CONSTBUFFER_CreateWithMoveMemory shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateWithMoveMemory_with_invalid_args_fails)
+    {
+        ///arrange
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithMoveMemory(NULL, 1);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_002: [CONSTBUFFER_CreateWithMoveMemory shall store source and size and return a non-NULL handle to the newly created const buffer, without copying the bytes.]*/
+    /*Tests_SRS_CONSTBUFFER_01_004: [The non-NULL handle returned by CONSTBUFFER_CreateWithMoveMemory shall have its ref count set to "1".]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateWithMoveMemory_succeeds)
+    {
+        ///arrange
+        unsigned char* source = (unsigned char*)malloc(BUFFER1_length);
+        ASSERT_IS_NOT_NULL(source);
+        (void)memcpy(source, BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        /*this is the handle, the content is not copied*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithMoveMemory(source, BUFFER1_length);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(handle);
+        ASSERT_ARE_EQUAL(size_t, BUFFER1_length, content->size);
+        ASSERT_ARE_EQUAL(void_ptr, source, content->buffer);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_Destroy(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_002: [CONSTBUFFER_CreateWithMoveMemory shall store source and size and return a non-NULL handle to the newly created const buffer, without copying the bytes.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateWithMoveMemory_with_0_size_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithMoveMemory(NULL, 0);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(handle);
+        ASSERT_ARE_EQUAL(size_t, 0, content->size);
+        ASSERT_IS_NULL(content->buffer);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_Destroy(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_005: [If any error occurs, CONSTBUFFER_CreateWithMoveMemory shall fail, return NULL and leave the ownership of source with the caller.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateWithMoveMemory_fails_when_malloc_fails)
+    {
+        ///arrange
+        unsigned char* source = (unsigned char*)malloc(BUFFER1_length);
+        ASSERT_IS_NOT_NULL(source);
+        umock_c_reset_all_calls();
+
+        whenShallmalloc_fail = currentmalloc_call + 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithMoveMemory(source, BUFFER1_length);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        free(source);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_003: [The const buffer shall own source, which is freed with free when the last reference goes away.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateWithMoveMemory_frees_source_on_last_Destroy)
+    {
+        ///arrange
+        unsigned char* source = (unsigned char*)malloc(BUFFER1_length);
+        ASSERT_IS_NOT_NULL(source);
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithMoveMemory(source, BUFFER1_length);
+        CONSTBUFFER_HANDLE clone = CONSTBUFFER_Clone(handle);
+        CONSTBUFFER_Destroy(handle);
+        umock_c_reset_all_calls();
+
+        /*this is the content*/
+        STRICT_EXPECTED_CALL(gballoc_free(source));
+        /*this is the handle*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_Destroy(clone);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_006: [If source is NULL and size is different than 0 then CONSTBUFFER_CreateWithCustomFree shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateWithCustomFree_with_NULL_source_and_non_0_size_fails)
+    {
+        ///arrange
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithCustomFree(NULL, 1, test_free_func, (void*)0x4242);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(size_t, 0, test_free_func_calls);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_007: [If customFreeFunc is NULL, CONSTBUFFER_CreateWithCustomFree shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateWithCustomFree_with_NULL_customFreeFunc_fails)
+    {
+        ///arrange
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithCustomFree(BUFFER1_u_char, BUFFER1_length, NULL, (void*)0x4242);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_008: [CONSTBUFFER_CreateWithCustomFree shall store source, size, customFreeFunc and customFreeFuncContext and return a non-NULL handle to the newly created const buffer, without copying the bytes.]*/
+    /*Tests_SRS_CONSTBUFFER_01_010: [The non-NULL handle returned by CONSTBUFFER_CreateWithCustomFree shall have its ref count set to "1".]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateWithCustomFree_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithCustomFree(BUFFER1_u_char, BUFFER1_length, test_free_func, (void*)0x4242);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(handle);
+        ASSERT_ARE_EQUAL(size_t, BUFFER1_length, content->size);
+        ASSERT_ARE_EQUAL(void_ptr, BUFFER1_u_char, content->buffer);
+        ASSERT_ARE_EQUAL(size_t, 0, test_free_func_calls);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_Destroy(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_011: [If any error occurs, CONSTBUFFER_CreateWithCustomFree shall fail and return NULL without calling customFreeFunc.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateWithCustomFree_fails_when_malloc_fails)
+    {
+        ///arrange
+        whenShallmalloc_fail = 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithCustomFree(BUFFER1_u_char, BUFFER1_length, test_free_func, (void*)0x4242);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(size_t, 0, test_free_func_calls);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_009: [customFreeFunc shall be called with customFreeFuncContext when the last reference goes away.]*/
+    /*Tests_SRS_CONSTBUFFER_01_020: [If the const buffer was created with CONSTBUFFER_CreateWithCustomFree, CONSTBUFFER_Destroy shall call customFreeFunc with customFreeFuncContext instead of freeing the bytes.]*/
+    TEST_FUNCTION(CONSTBUFFER_Destroy_calls_customFreeFunc_on_last_reference)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithCustomFree(BUFFER1_u_char, BUFFER1_length, test_free_func, (void*)0x4242);
+        CONSTBUFFER_HANDLE clone = CONSTBUFFER_Clone(handle);
+        CONSTBUFFER_Destroy(handle);
+        ASSERT_ARE_EQUAL(size_t, 0, test_free_func_calls);
+        umock_c_reset_all_calls();
+
+        /*this is the handle, the content belongs to test_free_func*/
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_Destroy(clone);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 1, test_free_func_calls);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)0x4242, test_free_func_context);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_012: [If handle is NULL then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateFromOffsetAndSize(NULL, 0, 1);
+
+        ///assert
+        ASSERT_IS_NULL(slice);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_013: [If offset is greater than the size of handle then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_with_offset_past_the_end_fails)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        ///act
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateFromOffsetAndSize(handle, BUFFER1_length + 1, 0);
+
+        ///assert
+        ASSERT_IS_NULL(slice);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_Destroy(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_014: [If offset + size is greater than the size of handle then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_with_size_past_the_end_fails)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        ///act
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateFromOffsetAndSize(handle, 1, BUFFER1_length);
+
+        ///assert
+        ASSERT_IS_NULL(slice);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_Destroy(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_014: [If offset + size is greater than the size of handle then CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_with_overflowing_size_fails)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        ///act
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateFromOffsetAndSize(handle, 1, (size_t)-1);
+
+        ///assert
+        ASSERT_IS_NULL(slice);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_Destroy(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_015: [If offset is 0 and size is the size of handle then CONSTBUFFER_CreateFromOffsetAndSize shall increment the reference count of handle and return handle.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_with_the_whole_buffer_returns_a_clone)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+
+        ///act
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateFromOffsetAndSize(handle, 0, BUFFER1_length);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, handle, slice);
+        CONSTBUFFER_Destroy(handle); /*only a dec_Ref is expected here, so no effects*/
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_Destroy(slice);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_016: [Otherwise CONSTBUFFER_CreateFromOffsetAndSize shall return a non-NULL handle whose content is the size bytes of handle starting at offset, without copying the bytes.]*/
+    /*Tests_SRS_CONSTBUFFER_01_018: [The non-NULL handle returned by CONSTBUFFER_CreateFromOffsetAndSize shall have its ref count set to "1".]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_succeeds)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        const CONSTBUFFER* parent = CONSTBUFFER_GetContent(handle);
+        umock_c_reset_all_calls();
+
+        /*this is the handle, the content is not copied*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateFromOffsetAndSize(handle, 3, 6);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(slice);
+        ASSERT_ARE_NOT_EQUAL(void_ptr, handle, slice);
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(slice);
+        ASSERT_ARE_EQUAL(size_t, 6, content->size);
+        ASSERT_ARE_EQUAL(void_ptr, parent->buffer + 3, content->buffer);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(content->buffer, "buffer", 6));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        CONSTBUFFER_Destroy(slice);
+        CONSTBUFFER_Destroy(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_019: [If any error occurs, CONSTBUFFER_CreateFromOffsetAndSize shall fail and return NULL.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_fails_when_malloc_fails)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_Create(BUFFER1_u_char, BUFFER1_length);
+        umock_c_reset_all_calls();
+        currentmalloc_call = 0;
+
+        whenShallmalloc_fail = 1;
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateFromOffsetAndSize(handle, 3, 6);
+
+        ///assert
+        ASSERT_IS_NULL(slice);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        whenShallmalloc_fail = 0;
+        CONSTBUFFER_Destroy(handle);
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_017: [CONSTBUFFER_CreateFromOffsetAndSize shall increment the reference count of the const buffer that owns the bytes, so that they stay valid until the new handle is destroyed.]*/
+    /*Tests_SRS_CONSTBUFFER_01_021: [If the const buffer was created with CONSTBUFFER_CreateFromOffsetAndSize, CONSTBUFFER_Destroy shall release the reference it holds on the const buffer that owns the bytes.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_keeps_the_bytes_alive_after_the_original_is_destroyed)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithCustomFree(BUFFER1_u_char, BUFFER1_length, test_free_func, (void*)0x4242);
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateFromOffsetAndSize(handle, 3, 6);
+        CONSTBUFFER_Destroy(handle);
+        ASSERT_ARE_EQUAL(size_t, 0, test_free_func_calls);
+        umock_c_reset_all_calls();
+
+        /*this is the original handle*/
+        STRICT_EXPECTED_CALL(gballoc_free(handle));
+        /*this is the slice*/
+        STRICT_EXPECTED_CALL(gballoc_free(slice));
+
+        ///act
+        CONSTBUFFER_Destroy(slice);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 1, test_free_func_calls);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_CONSTBUFFER_01_016: [Otherwise CONSTBUFFER_CreateFromOffsetAndSize shall return a non-NULL handle whose content is the size bytes of handle starting at offset, without copying the bytes.]*/
+    /*Tests_SRS_CONSTBUFFER_01_017: [CONSTBUFFER_CreateFromOffsetAndSize shall increment the reference count of the const buffer that owns the bytes, so that they stay valid until the new handle is destroyed.]*/
+    TEST_FUNCTION(CONSTBUFFER_CreateFromOffsetAndSize_of_a_slice_references_the_owner)
+    {
+        ///arrange
+        CONSTBUFFER_HANDLE handle = CONSTBUFFER_CreateWithCustomFree(BUFFER1_u_char, BUFFER1_length, test_free_func, (void*)0x4242);
+        CONSTBUFFER_HANDLE slice = CONSTBUFFER_CreateFromOffsetAndSize(handle, 3, 6);
+        CONSTBUFFER_Destroy(handle);
+        umock_c_reset_all_calls();
+
+        ///act
+        CONSTBUFFER_HANDLE sliceOfSlice = CONSTBUFFER_CreateFromOffsetAndSize(slice, 1, 2);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(sliceOfSlice);
+        const CONSTBUFFER* content = CONSTBUFFER_GetContent(sliceOfSlice);
+        ASSERT_ARE_EQUAL(size_t, 2, content->size);
+        ASSERT_ARE_EQUAL(void_ptr, BUFFER1_u_char + 4, content->buffer);
+        /*the first slice can go away without releasing the bytes*/
+        CONSTBUFFER_Destroy(slice);
+        ASSERT_ARE_EQUAL(size_t, 0, test_free_func_calls);
+        CONSTBUFFER_Destroy(sliceOfSlice);
+        ASSERT_ARE_EQUAL(size_t, 1, test_free_func_calls);
+
+        ///cleanup
+    }
+
 END_TEST_SUITE(constbuffer_unittests)
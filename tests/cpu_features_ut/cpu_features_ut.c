@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#endif
+
+#ifdef _CRTDBG_MAP_ALLOC
+#include <crtdbg.h>
+#endif
+
+#include "testrunnerswitcher.h"
+#include "azure_c_shared_utility/cpu_features.h"
+
+#define ALL_CPU_FEATURES \
+    (CPU_FEATURE_X86_SSSE3 | CPU_FEATURE_X86_SSE41 | CPU_FEATURE_X86_AVX2 | CPU_FEATURE_X86_SHA | CPU_FEATURE_ARM_SHA1 | CPU_FEATURE_ARM_SHA2)
+
+static TEST_MUTEX_HANDLE g_testByTest;
+static TEST_MUTEX_HANDLE g_dllByDll;
+
+BEGIN_TEST_SUITE(cpu_features_ut)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+    g_testByTest = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_testByTest);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    TEST_MUTEX_DESTROY(g_testByTest);
+    TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(g_testByTest))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(g_testByTest);
+}
+
+/* cpu_features_get */
+
+/* Tests_SRS_CPU_FEATURES_01_001: [ `cpu_features_get` shall return the `CPU_FEATURE_` bits of the extensions the processor has, reporting `CPU_FEATURE_X86_AVX2` only when the OS also saves the YMM registers. ]*/
+TEST_FUNCTION(cpu_features_get_returns_only_known_features)
+{
+    // arrange
+    int result;
+
+    // act
+    result = cpu_features_get();
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result & ~ALL_CPU_FEATURES);
+}
+
+/* Tests_SRS_CPU_FEATURES_01_002: [ The processor shall be probed by the first call and the features published with a single atomic compare-and-swap, so that every call on every thread, including threads racing on the first call, returns the same value. ]*/
+TEST_FUNCTION(cpu_features_get_returns_the_same_features_on_every_call)
+{
+    // arrange
+    int first = cpu_features_get();
+    int i;
+
+    // act
+    for (i = 0; i < 100; i++)
+    {
+        // assert
+        ASSERT_ARE_EQUAL(int, first, cpu_features_get());
+    }
+}
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5)))
+/* Tests_SRS_CPU_FEATURES_01_001: [ `cpu_features_get` shall return the `CPU_FEATURE_` bits of the extensions the processor has, reporting `CPU_FEATURE_X86_AVX2` only when the OS also saves the YMM registers. ]*/
+TEST_FUNCTION(cpu_features_get_agrees_with_the_compiler_probe)
+{
+    // arrange
+    int result;
+    __builtin_cpu_init();
+
+    // act
+    result = cpu_features_get();
+
+    // assert
+    ASSERT_ARE_EQUAL(int, __builtin_cpu_supports("ssse3") ? 1 : 0, (result & CPU_FEATURE_X86_SSSE3) ? 1 : 0);
+    ASSERT_ARE_EQUAL(int, __builtin_cpu_supports("sse4.1") ? 1 : 0, (result & CPU_FEATURE_X86_SSE41) ? 1 : 0);
+    ASSERT_ARE_EQUAL(int, __builtin_cpu_supports("avx2") ? 1 : 0, (result & CPU_FEATURE_X86_AVX2) ? 1 : 0);
+    ASSERT_ARE_EQUAL(int, 0, result & (CPU_FEATURE_ARM_SHA1 | CPU_FEATURE_ARM_SHA2));
+}
+#endif
+
+END_TEST_SUITE(cpu_features_ut)
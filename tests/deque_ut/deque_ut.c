@@ -0,0 +1,739 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#endif
+
+static void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* my_gballoc_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_gballoc_free(void* s)
+{
+    free(s);
+}
+
+
+#define ENABLE_MOCKS
+#include "azure_c_shared_utility/gballoc.h"
+#undef ENABLE_MOCKS
+
+#include "azure_c_shared_utility/deque.h"
+
+#include "testrunnerswitcher.h"
+#include "umock_c.h"
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    char temp_str[256];
+    (void)snprintf(temp_str, sizeof(temp_str), "umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+    ASSERT_FAIL(temp_str);
+}
+
+
+typedef struct DEQUE_UNITTEST_TAG
+{
+    int  nValue1;
+    long lValue2;
+} DEQUE_UNITTEST;
+
+static TEST_MUTEX_HANDLE g_dllByDll;
+
+BEGIN_TEST_SUITE(Deque_UnitTests)
+
+    TEST_SUITE_INITIALIZE(a)
+    {
+        TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+
+        int result = umock_c_init(on_umock_c_error);
+        ASSERT_ARE_EQUAL(int, 0, result);
+
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+        REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_realloc, my_gballoc_realloc);
+        REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_realloc, NULL);
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+    }
+
+    TEST_SUITE_CLEANUP(TestClassCleanup)
+    {
+        umock_c_deinit();
+
+        TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+    }
+
+    TEST_FUNCTION_INITIALIZE(initialize)
+    {
+        umock_c_reset_all_calls();
+    }
+
+    TEST_FUNCTION_CLEANUP(cleans)
+    {
+    }
+
+    /* Deque_Tests BEGIN */
+
+    /* Tests_SRS_DEQUE_01_001: [DEQUE_create shall allocate a DEQUE_HANDLE that will contain an empty deque. The size of each element is given in elementSize.] */
+    TEST_FUNCTION(DEQUE_create_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size();
+
+        ///act
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        ASSERT_ARE_EQUAL(size_t, 0, DEQUE_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_002: [DEQUE_create shall fail and return NULL if elementSize is 0.] */
+    TEST_FUNCTION(DEQUE_create_fails_if_element_size_is_zero)
+    {
+        ///act
+        DEQUE_HANDLE handle = DEQUE_create(0);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_DEQUE_01_003: [DEQUE_create shall fail and return NULL if malloc fails.] */
+    TEST_FUNCTION(DEQUE_create_returns_NULL_if_malloc_fails)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size()
+            .SetReturn(NULL);
+
+        ///act
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_DEQUE_01_004: [DEQUE_destroy shall free the given handle and its internal storage.] */
+    TEST_FUNCTION(DEQUE_destroy_succeeds)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItem = {1, 2};
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        (void)DEQUE_push_back(handle, &sItem);
+        umock_c_reset_all_calls();
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument_ptr();
+        STRICT_EXPECTED_CALL(gballoc_free(handle));
+
+        ///act
+        DEQUE_destroy(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_DEQUE_01_005: [DEQUE_destroy shall return if the given handle is NULL.] */
+    TEST_FUNCTION(DEQUE_destroy_return_if_handle_is_NULL)
+    {
+        ///act
+        DEQUE_destroy(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_DEQUE_01_006: [DEQUE_push_back shall fail and return non-zero if `handle` or `element` is NULL.] */
+    TEST_FUNCTION(DEQUE_push_back_fails_if_handle_is_NULL)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItem = {1, 2};
+
+        ///act
+        int result = DEQUE_push_back(NULL, &sItem);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_DEQUE_01_006: [DEQUE_push_back shall fail and return non-zero if `handle` or `element` is NULL.] */
+    TEST_FUNCTION(DEQUE_push_back_fails_if_element_is_NULL)
+    {
+        ///arrange
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = DEQUE_push_back(handle, NULL);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 0, DEQUE_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_007: [DEQUE_push_back shall copy `element` after the last element of the deque and return 0.] */
+    /* Tests_SRS_DEQUE_01_008: [If the deque is full, DEQUE_push_back shall double its capacity.] */
+    TEST_FUNCTION(DEQUE_push_back_succeeds)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItem = {1, 2};
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        umock_c_reset_all_calls();
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, sizeof(DEQUE_UNITTEST)));
+
+        ///act
+        int result = DEQUE_push_back(handle, &sItem);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 1, DEQUE_size(handle));
+        DEQUE_UNITTEST* pResult = (DEQUE_UNITTEST*)DEQUE_back(handle);
+        ASSERT_ARE_EQUAL(int, sItem.nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(long, sItem.lValue2, pResult->lValue2);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_008: [If the deque is full, DEQUE_push_back shall double its capacity.] */
+    TEST_FUNCTION(DEQUE_push_back_doubles_the_capacity_when_full)
+    {
+        ///arrange
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        umock_c_reset_all_calls();
+        for (size_t capacity = 1; capacity <= 64; capacity *= 2)
+        {
+            STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, capacity * sizeof(DEQUE_UNITTEST)))
+                .IgnoreArgument_ptr();
+        }
+
+        ///act
+        int result = 0;
+        for (int i = 0; (i < 64) && (result == 0); i++)
+        {
+            DEQUE_UNITTEST sItem = { i, i };
+            result = DEQUE_push_back(handle, &sItem);
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 64, DEQUE_size(handle));
+        for (int i = 0; i < 64; i++)
+        {
+            DEQUE_UNITTEST* pResult = (DEQUE_UNITTEST*)DEQUE_element(handle, i);
+            ASSERT_ARE_EQUAL(int, i, pResult->nValue1);
+        }
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_009: [DEQUE_push_back shall fail and return non-zero if memory allocation fails.] */
+    TEST_FUNCTION(DEQUE_push_back_fails_if_realloc_fails)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItems[2] = { {1, 2}, {3, 4} };
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        (void)DEQUE_push_back(handle, &sItems[0]);
+        umock_c_reset_all_calls();
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(DEQUE_UNITTEST)))
+            .IgnoreArgument_ptr()
+            .SetReturn(NULL);
+
+        ///act
+        int result = DEQUE_push_back(handle, &sItems[1]);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 1, DEQUE_size(handle));
+        DEQUE_UNITTEST* pResult = (DEQUE_UNITTEST*)DEQUE_front(handle);
+        ASSERT_ARE_EQUAL(int, sItems[0].nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_010: [DEQUE_push_front shall fail and return non-zero if `handle` or `element` is NULL.] */
+    TEST_FUNCTION(DEQUE_push_front_fails_if_handle_is_NULL)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItem = {1, 2};
+
+        ///act
+        int result = DEQUE_push_front(NULL, &sItem);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_DEQUE_01_010: [DEQUE_push_front shall fail and return non-zero if `handle` or `element` is NULL.] */
+    TEST_FUNCTION(DEQUE_push_front_fails_if_element_is_NULL)
+    {
+        ///arrange
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = DEQUE_push_front(handle, NULL);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 0, DEQUE_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_011: [DEQUE_push_front shall copy `element` before the first element of the deque and return 0.] */
+    /* Tests_SRS_DEQUE_01_012: [If the deque is full, DEQUE_push_front shall double its capacity.] */
+    TEST_FUNCTION(DEQUE_push_front_succeeds)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItems[3] = { {1, 2}, {3, 4}, {5, 6} };
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        umock_c_reset_all_calls();
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, sizeof(DEQUE_UNITTEST)));
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(DEQUE_UNITTEST)))
+            .IgnoreArgument_ptr();
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 4 * sizeof(DEQUE_UNITTEST)))
+            .IgnoreArgument_ptr();
+
+        ///act
+        int result1 = DEQUE_push_front(handle, &sItems[2]);
+        int result2 = DEQUE_push_front(handle, &sItems[1]);
+        int result3 = DEQUE_push_front(handle, &sItems[0]);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_ARE_EQUAL(int, 0, result3);
+        ASSERT_ARE_EQUAL(size_t, 3, DEQUE_size(handle));
+        for (size_t i = 0; i < 3; i++)
+        {
+            DEQUE_UNITTEST* pResult = (DEQUE_UNITTEST*)DEQUE_element(handle, i);
+            ASSERT_ARE_EQUAL(int, sItems[i].nValue1, pResult->nValue1);
+            ASSERT_ARE_EQUAL(long, sItems[i].lValue2, pResult->lValue2);
+        }
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_013: [DEQUE_push_front shall fail and return non-zero if memory allocation fails.] */
+    TEST_FUNCTION(DEQUE_push_front_fails_if_realloc_fails)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItem = {1, 2};
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        umock_c_reset_all_calls();
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, sizeof(DEQUE_UNITTEST)))
+            .SetReturn(NULL);
+
+        ///act
+        int result = DEQUE_push_front(handle, &sItem);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 0, DEQUE_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_008: [If the deque is full, DEQUE_push_back shall double its capacity.] */
+    TEST_FUNCTION(DEQUE_growing_a_wrapped_deque_keeps_the_order)
+    {
+        ///arrange
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        for (int i = 0; i < 4; i++)
+        {
+            DEQUE_UNITTEST sItem = { i, i };
+            (void)DEQUE_push_back(handle, &sItem);
+        }
+        /* drop 0 and 1 and add 4 and 5 so that the elements wrap around the end of the storage */
+        DEQUE_pop_front(handle);
+        DEQUE_pop_front(handle);
+        for (int i = 4; i < 6; i++)
+        {
+            DEQUE_UNITTEST sItem = { i, i };
+            (void)DEQUE_push_back(handle, &sItem);
+        }
+        umock_c_reset_all_calls();
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 8 * sizeof(DEQUE_UNITTEST)))
+            .IgnoreArgument_ptr();
+
+        ///act
+        DEQUE_UNITTEST sItem = { 6, 6 };
+        int result = DEQUE_push_back(handle, &sItem);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 5, DEQUE_size(handle));
+        for (size_t i = 0; i < 5; i++)
+        {
+            DEQUE_UNITTEST* pResult = (DEQUE_UNITTEST*)DEQUE_element(handle, i);
+            ASSERT_ARE_EQUAL(int, (int)i + 2, pResult->nValue1);
+        }
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_014: [DEQUE_pop_front shall return if `handle` is NULL.] */
+    TEST_FUNCTION(DEQUE_pop_front_with_NULL_handle_returns)
+    {
+        ///act
+        DEQUE_pop_front(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_DEQUE_01_015: [DEQUE_pop_front shall return if the deque is empty.] */
+    TEST_FUNCTION(DEQUE_pop_front_on_an_empty_deque_returns)
+    {
+        ///arrange
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        DEQUE_pop_front(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, DEQUE_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_016: [DEQUE_pop_front shall remove the first element of the deque without reallocating the internal storage.] */
+    TEST_FUNCTION(DEQUE_pop_front_removes_the_first_element)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItems[2] = { {1, 2}, {3, 4} };
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        (void)DEQUE_push_back(handle, &sItems[0]);
+        (void)DEQUE_push_back(handle, &sItems[1]);
+        umock_c_reset_all_calls();
+
+        ///act
+        DEQUE_pop_front(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 1, DEQUE_size(handle));
+        DEQUE_UNITTEST* pResult = (DEQUE_UNITTEST*)DEQUE_front(handle);
+        ASSERT_ARE_EQUAL(int, sItems[1].nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_016: [DEQUE_pop_front shall remove the first element of the deque without reallocating the internal storage.] */
+    TEST_FUNCTION(DEQUE_used_as_a_queue_does_not_allocate_once_warm)
+    {
+        ///arrange
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        for (int i = 0; i < 4; i++)
+        {
+            DEQUE_UNITTEST sItem = { i, i };
+            (void)DEQUE_push_back(handle, &sItem);
+        }
+        umock_c_reset_all_calls();
+
+        ///act
+        for (int i = 4; i < 100; i++)
+        {
+            DEQUE_UNITTEST sItem = { i, i };
+            DEQUE_UNITTEST* pResult = (DEQUE_UNITTEST*)DEQUE_front(handle);
+            ASSERT_ARE_EQUAL(int, i - 4, pResult->nValue1);
+            DEQUE_pop_front(handle);
+            ASSERT_ARE_EQUAL(int, 0, DEQUE_push_back(handle, &sItem));
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 4, DEQUE_size(handle));
+        DEQUE_UNITTEST* pResult = (DEQUE_UNITTEST*)DEQUE_back(handle);
+        ASSERT_ARE_EQUAL(int, 99, pResult->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_017: [DEQUE_pop_back shall return if `handle` is NULL.] */
+    TEST_FUNCTION(DEQUE_pop_back_with_NULL_handle_returns)
+    {
+        ///act
+        DEQUE_pop_back(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_DEQUE_01_018: [DEQUE_pop_back shall return if the deque is empty.] */
+    TEST_FUNCTION(DEQUE_pop_back_on_an_empty_deque_returns)
+    {
+        ///arrange
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        DEQUE_pop_back(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, DEQUE_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_019: [DEQUE_pop_back shall remove the last element of the deque without reallocating the internal storage.] */
+    TEST_FUNCTION(DEQUE_pop_back_removes_the_last_element)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItems[2] = { {1, 2}, {3, 4} };
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        (void)DEQUE_push_back(handle, &sItems[1]);
+        (void)DEQUE_push_front(handle, &sItems[0]);
+        umock_c_reset_all_calls();
+
+        ///act
+        DEQUE_pop_back(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 1, DEQUE_size(handle));
+        DEQUE_UNITTEST* pResult = (DEQUE_UNITTEST*)DEQUE_back(handle);
+        ASSERT_ARE_EQUAL(int, sItems[0].nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_021: [DEQUE_element shall fail and return NULL if handle is NULL.] */
+    TEST_FUNCTION(DEQUE_element_fails_if_handle_is_NULL)
+    {
+        ///act
+        void* result = DEQUE_element(NULL, 0);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_DEQUE_01_022: [DEQUE_element shall fail and return NULL if the given index is out of range.] */
+    TEST_FUNCTION(DEQUE_element_fails_if_index_is_out_of_range)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItem = {1, 2};
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        (void)DEQUE_push_back(handle, &sItem);
+        umock_c_reset_all_calls();
+
+        ///act
+        void* result = DEQUE_element(handle, 1);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_020: [DEQUE_element shall return a pointer to the element at the given index, counting from the front of the deque.] */
+    TEST_FUNCTION(DEQUE_element_counts_from_the_front)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItems[3] = { {1, 2}, {3, 4}, {5, 6} };
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        (void)DEQUE_push_back(handle, &sItems[1]);
+        (void)DEQUE_push_back(handle, &sItems[2]);
+        (void)DEQUE_push_front(handle, &sItems[0]);
+        umock_c_reset_all_calls();
+
+        ///act
+        DEQUE_UNITTEST* pResult = (DEQUE_UNITTEST*)DEQUE_element(handle, 2);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(pResult);
+        ASSERT_ARE_EQUAL(int, sItems[2].nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(long, sItems[2].lValue2, pResult->lValue2);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_024: [DEQUE_front shall fail and return NULL if handle is NULL.] */
+    TEST_FUNCTION(DEQUE_front_fails_if_handle_is_NULL)
+    {
+        ///act
+        void* result = DEQUE_front(NULL);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_DEQUE_01_025: [DEQUE_front shall fail and return NULL if the deque is empty.] */
+    TEST_FUNCTION(DEQUE_front_returns_NULL_if_deque_is_empty)
+    {
+        ///arrange
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        void* result = DEQUE_front(handle);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_023: [DEQUE_front shall return a pointer to the first element of the deque.] */
+    TEST_FUNCTION(DEQUE_front_succeeds)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItems[2] = { {1, 2}, {3, 4} };
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        (void)DEQUE_push_back(handle, &sItems[1]);
+        (void)DEQUE_push_front(handle, &sItems[0]);
+        umock_c_reset_all_calls();
+
+        ///act
+        DEQUE_UNITTEST* pResult = (DEQUE_UNITTEST*)DEQUE_front(handle);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(pResult);
+        ASSERT_ARE_EQUAL(int, sItems[0].nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_027: [DEQUE_back shall fail and return NULL if handle is NULL.] */
+    TEST_FUNCTION(DEQUE_back_fails_if_handle_is_NULL)
+    {
+        ///act
+        void* result = DEQUE_back(NULL);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_DEQUE_01_028: [DEQUE_back shall fail and return NULL if the deque is empty.] */
+    TEST_FUNCTION(DEQUE_back_returns_NULL_if_deque_is_empty)
+    {
+        ///arrange
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        void* result = DEQUE_back(handle);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_026: [DEQUE_back shall return a pointer to the last element of the deque.] */
+    TEST_FUNCTION(DEQUE_back_succeeds)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItems[2] = { {1, 2}, {3, 4} };
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        (void)DEQUE_push_front(handle, &sItems[1]);
+        (void)DEQUE_push_front(handle, &sItems[0]);
+        umock_c_reset_all_calls();
+
+        ///act
+        DEQUE_UNITTEST* pResult = (DEQUE_UNITTEST*)DEQUE_back(handle);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(pResult);
+        ASSERT_ARE_EQUAL(int, sItems[1].nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Tests_SRS_DEQUE_01_030: [DEQUE_size shall return 0 if the given handle is NULL.] */
+    TEST_FUNCTION(DEQUE_size_returns_0_if_handle_is_NULL)
+    {
+        ///act
+        size_t result = DEQUE_size(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_DEQUE_01_029: [DEQUE_size shall return the number of elements stored in the deque.] */
+    TEST_FUNCTION(DEQUE_size_succeeds)
+    {
+        ///arrange
+        DEQUE_UNITTEST sItem = {1, 2};
+        DEQUE_HANDLE handle = DEQUE_create(sizeof(DEQUE_UNITTEST));
+        (void)DEQUE_push_back(handle, &sItem);
+        (void)DEQUE_push_front(handle, &sItem);
+        (void)DEQUE_push_back(handle, &sItem);
+        umock_c_reset_all_calls();
+
+        ///act
+        size_t result = DEQUE_size(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 3, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        DEQUE_destroy(handle);
+    }
+
+    /* Deque_Tests END */
+
+END_TEST_SUITE(Deque_UnitTests)
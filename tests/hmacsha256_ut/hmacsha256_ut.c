@@ -170,4 +170,414 @@ TEST_FUNCTION(HMACSHA256_ComputeHash_Succeeds)
     ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hash), expectedHash, 8));
 }
 
+/*Tests_SRS_HMACSHA256_01_001: [ HMACSHA256_ComputeHash, HMACSHA256_ComputeHashWithKey and HMACSHA256_Final shall append the 32 byte HMAC to the content of hash by calling BUFFER_enlarge, keeping the bytes hash already holds. ]*/
+TEST_FUNCTION(HMACSHA256_ComputeHash_Appends_To_A_Non_Empty_Buffer)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+    static const unsigned char buffer[] = "testPayload";
+    static const unsigned char prefix[] = { 'a', 'b', 'c' };
+    unsigned char expectedHash[32] = { 108, 7, 130, 47, 104, 233, 39, 188, 126, 122, 134, 187, 63, 19, 52, 120, 172, 7, 43, 25, 133, 60, 92, 217, 59, 59, 69, 116, 85, 104, 55, 224 };
+    HMACSHA256_RESULT result;
+    (void)BUFFER_build(hash, prefix, sizeof(prefix));
+
+    // act
+    result = HMACSHA256_ComputeHash(key, sizeof(key) - 1, buffer, sizeof(buffer) - 1, hash);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, result);
+    ASSERT_ARE_EQUAL(size_t, sizeof(prefix) + sizeof(expectedHash), BUFFER_length(hash));
+    ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hash), prefix, sizeof(prefix)));
+    ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hash) + sizeof(prefix), expectedHash, sizeof(expectedHash)));
+}
+
+/* HMACSHA256_CreateKey */
+
+TEST_FUNCTION(HMACSHA256_CreateKey_With_NULL_Key_Fails)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+
+    // act
+    HMACSHA256_KEY_HANDLE result = HMACSHA256_CreateKey(NULL, sizeof(key) - 1);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+TEST_FUNCTION(HMACSHA256_CreateKey_With_Zero_Key_Buffer_Size_Fails)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+
+    // act
+    HMACSHA256_KEY_HANDLE result = HMACSHA256_CreateKey(key, 0);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+TEST_FUNCTION(HMACSHA256_CreateKey_When_malloc_Fails_Fails)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .IgnoreArgument_size()
+        .SetReturn(NULL);
+
+    // act
+    HMACSHA256_KEY_HANDLE result = HMACSHA256_CreateKey(key, sizeof(key) - 1);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* HMACSHA256_ComputeHashWithKey */
+
+TEST_FUNCTION(HMACSHA256_ComputeHashWithKey_With_NULL_Key_Fails)
+{
+    // arrange
+    static const unsigned char buffer[] = "testPayload";
+
+    // act
+    HMACSHA256_RESULT result = HMACSHA256_ComputeHashWithKey(NULL, buffer, sizeof(buffer) - 1, hash);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_INVALID_ARG, result);
+}
+
+TEST_FUNCTION(HMACSHA256_ComputeHashWithKey_With_Zero_Payload_Buffer_Size_Fails)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+    static const unsigned char buffer[] = "testPayload";
+    HMACSHA256_KEY_HANDLE hmacKey = HMACSHA256_CreateKey(key, sizeof(key) - 1);
+
+    // act
+    HMACSHA256_RESULT result = HMACSHA256_ComputeHashWithKey(hmacKey, buffer, 0, hash);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_INVALID_ARG, result);
+
+    // cleanup
+    HMACSHA256_DestroyKey(hmacKey);
+}
+
+TEST_FUNCTION(HMACSHA256_ComputeHashWithKey_Succeeds_And_Key_Can_Be_Reused)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+    static const unsigned char buffer[] = "testPayload";
+    unsigned char expectedHash[32] = { 108, 7, 130, 47, 104, 233, 39, 188, 126, 122, 134, 187, 63, 19, 52, 120, 172, 7, 43, 25, 133, 60, 92, 217, 59, 59, 69, 116, 85, 104, 55, 224 };
+    HMACSHA256_KEY_HANDLE hmacKey = HMACSHA256_CreateKey(key, sizeof(key) - 1);
+    HMACSHA256_RESULT result1;
+    HMACSHA256_RESULT result2;
+
+    // act
+    result1 = HMACSHA256_ComputeHashWithKey(hmacKey, buffer, sizeof(buffer) - 1, hash);
+    result2 = HMACSHA256_ComputeHashWithKey(hmacKey, buffer, sizeof(buffer) - 1, hash);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, result1);
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, result2);
+    ASSERT_ARE_EQUAL(size_t, 2 * sizeof(expectedHash), BUFFER_length(hash));
+    ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hash), expectedHash, sizeof(expectedHash)));
+    ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hash) + sizeof(expectedHash), expectedHash, sizeof(expectedHash)));
+
+    // cleanup
+    HMACSHA256_DestroyKey(hmacKey);
+}
+
+TEST_FUNCTION(HMACSHA256_ComputeHashWithKey_With_Key_Longer_Than_Block_Matches_ComputeHash)
+{
+    // arrange
+    unsigned char key[100];
+    static const unsigned char buffer[] = "testPayload";
+    BUFFER_HANDLE expectedHash = BUFFER_new();
+    HMACSHA256_KEY_HANDLE hmacKey;
+    HMACSHA256_RESULT result;
+    size_t i;
+
+    for (i = 0; i < sizeof(key); i++)
+    {
+        key[i] = (unsigned char)i;
+    }
+    (void)HMACSHA256_ComputeHash(key, sizeof(key), buffer, sizeof(buffer) - 1, expectedHash);
+    hmacKey = HMACSHA256_CreateKey(key, sizeof(key));
+
+    // act
+    result = HMACSHA256_ComputeHashWithKey(hmacKey, buffer, sizeof(buffer) - 1, hash);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, result);
+    ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hash), BUFFER_u_char(expectedHash), BUFFER_length(expectedHash)));
+
+    // cleanup
+    HMACSHA256_DestroyKey(hmacKey);
+    BUFFER_delete(expectedHash);
+}
+
+/*Tests_SRS_HMACSHA256_01_001: [ HMACSHA256_ComputeHash, HMACSHA256_ComputeHashWithKey and HMACSHA256_Final shall append the 32 byte HMAC to the content of hash by calling BUFFER_enlarge, keeping the bytes hash already holds. ]*/
+TEST_FUNCTION(HMACSHA256_ComputeHashWithKey_Appends_To_A_Non_Empty_Buffer_Like_ComputeHash)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+    static const unsigned char buffer[] = "testPayload";
+    static const unsigned char prefix[] = { 'a', 'b', 'c' };
+    BUFFER_HANDLE expectedHash = BUFFER_create(prefix, sizeof(prefix));
+    HMACSHA256_KEY_HANDLE hmacKey = HMACSHA256_CreateKey(key, sizeof(key) - 1);
+    HMACSHA256_RESULT result;
+    (void)HMACSHA256_ComputeHash(key, sizeof(key) - 1, buffer, sizeof(buffer) - 1, expectedHash);
+    (void)BUFFER_build(hash, prefix, sizeof(prefix));
+
+    // act
+    result = HMACSHA256_ComputeHashWithKey(hmacKey, buffer, sizeof(buffer) - 1, hash);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, result);
+    ASSERT_ARE_EQUAL(size_t, BUFFER_length(expectedHash), BUFFER_length(hash));
+    ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hash), BUFFER_u_char(expectedHash), BUFFER_length(expectedHash)));
+
+    // cleanup
+    HMACSHA256_DestroyKey(hmacKey);
+    BUFFER_delete(expectedHash);
+}
+
+/* HMACSHA256_Init */
+
+TEST_FUNCTION(HMACSHA256_Init_With_NULL_Key_Fails)
+{
+    // arrange
+
+    // act
+    HMACSHA256_CONTEXT_HANDLE result = HMACSHA256_Init(NULL);
+
+    // assert
+    ASSERT_IS_NULL(result);
+}
+
+/* HMACSHA256_Update */
+
+TEST_FUNCTION(HMACSHA256_Update_With_NULL_Context_Fails)
+{
+    // arrange
+    static const unsigned char buffer[] = "testPayload";
+
+    // act
+    HMACSHA256_RESULT result = HMACSHA256_Update(NULL, buffer, sizeof(buffer) - 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_INVALID_ARG, result);
+}
+
+/* HMACSHA256_Final */
+
+TEST_FUNCTION(HMACSHA256_Final_With_NULL_Hash_Fails)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+    HMACSHA256_KEY_HANDLE hmacKey = HMACSHA256_CreateKey(key, sizeof(key) - 1);
+    HMACSHA256_CONTEXT_HANDLE hmacContext = HMACSHA256_Init(hmacKey);
+
+    // act
+    HMACSHA256_RESULT result = HMACSHA256_Final(hmacContext, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_INVALID_ARG, result);
+
+    // cleanup
+    HMACSHA256_DestroyContext(hmacContext);
+    HMACSHA256_DestroyKey(hmacKey);
+}
+
+TEST_FUNCTION(HMACSHA256_Update_In_Pieces_And_Final_Succeeds)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+    static const unsigned char buffer[] = "testPayload";
+    unsigned char expectedHash[32] = { 108, 7, 130, 47, 104, 233, 39, 188, 126, 122, 134, 187, 63, 19, 52, 120, 172, 7, 43, 25, 133, 60, 92, 217, 59, 59, 69, 116, 85, 104, 55, 224 };
+    HMACSHA256_KEY_HANDLE hmacKey = HMACSHA256_CreateKey(key, sizeof(key) - 1);
+    HMACSHA256_CONTEXT_HANDLE hmacContext = HMACSHA256_Init(hmacKey);
+    HMACSHA256_RESULT result1;
+    HMACSHA256_RESULT result2;
+    HMACSHA256_RESULT result3;
+
+    // act
+    result1 = HMACSHA256_Update(hmacContext, buffer, 4);
+    result2 = HMACSHA256_Update(hmacContext, buffer + 4, sizeof(buffer) - 1 - 4);
+    result3 = HMACSHA256_Final(hmacContext, hash);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, result1);
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, result2);
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, result3);
+    ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hash), expectedHash, sizeof(expectedHash)));
+
+    // cleanup
+    HMACSHA256_DestroyContext(hmacContext);
+    HMACSHA256_DestroyKey(hmacKey);
+}
+
+TEST_FUNCTION(HMACSHA256_Update_After_Final_Fails)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+    static const unsigned char buffer[] = "testPayload";
+    HMACSHA256_KEY_HANDLE hmacKey = HMACSHA256_CreateKey(key, sizeof(key) - 1);
+    HMACSHA256_CONTEXT_HANDLE hmacContext = HMACSHA256_Init(hmacKey);
+    HMACSHA256_RESULT result1;
+    HMACSHA256_RESULT result2;
+    (void)HMACSHA256_Update(hmacContext, buffer, sizeof(buffer) - 1);
+    (void)HMACSHA256_Final(hmacContext, hash);
+
+    // act
+    result1 = HMACSHA256_Update(hmacContext, buffer, sizeof(buffer) - 1);
+    result2 = HMACSHA256_Final(hmacContext, hash);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_ERROR, result1);
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_ERROR, result2);
+
+    // cleanup
+    HMACSHA256_DestroyContext(hmacContext);
+    HMACSHA256_DestroyKey(hmacKey);
+}
+
+/*Tests_SRS_HMACSHA256_01_001: [ HMACSHA256_ComputeHash, HMACSHA256_ComputeHashWithKey and HMACSHA256_Final shall append the 32 byte HMAC to the content of hash by calling BUFFER_enlarge, keeping the bytes hash already holds. ]*/
+TEST_FUNCTION(HMACSHA256_Final_Appends_To_A_Non_Empty_Buffer_Like_ComputeHash)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+    static const unsigned char buffer[] = "testPayload";
+    static const unsigned char prefix[] = { 'a', 'b', 'c' };
+    BUFFER_HANDLE expectedHash = BUFFER_create(prefix, sizeof(prefix));
+    HMACSHA256_KEY_HANDLE hmacKey = HMACSHA256_CreateKey(key, sizeof(key) - 1);
+    HMACSHA256_CONTEXT_HANDLE hmacContext = HMACSHA256_Init(hmacKey);
+    HMACSHA256_RESULT result;
+    (void)HMACSHA256_ComputeHash(key, sizeof(key) - 1, buffer, sizeof(buffer) - 1, expectedHash);
+    (void)BUFFER_build(hash, prefix, sizeof(prefix));
+    (void)HMACSHA256_Update(hmacContext, buffer, sizeof(buffer) - 1);
+
+    // act
+    result = HMACSHA256_Final(hmacContext, hash);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, result);
+    ASSERT_ARE_EQUAL(size_t, BUFFER_length(expectedHash), BUFFER_length(hash));
+    ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hash), BUFFER_u_char(expectedHash), BUFFER_length(expectedHash)));
+
+    // cleanup
+    HMACSHA256_DestroyContext(hmacContext);
+    HMACSHA256_DestroyKey(hmacKey);
+    BUFFER_delete(expectedHash);
+}
+
+/* HMACSHA256_ComputeHashBatch */
+
+TEST_FUNCTION(HMACSHA256_ComputeHashBatch_With_NULL_Payload_Fails)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+    static const unsigned char buffer[] = "testPayload";
+    HMACSHA256_KEY_HANDLE hmacKey = HMACSHA256_CreateKey(key, sizeof(key) - 1);
+    const unsigned char* payloads[2] = { buffer, NULL };
+    size_t payloadLens[2] = { sizeof(buffer) - 1, sizeof(buffer) - 1 };
+    BUFFER_HANDLE hashes[2] = { hash, hash };
+
+    // act
+    HMACSHA256_RESULT result = HMACSHA256_ComputeHashBatch(hmacKey, payloads, payloadLens, 2, hashes);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_INVALID_ARG, result);
+
+    // cleanup
+    HMACSHA256_DestroyKey(hmacKey);
+}
+
+TEST_FUNCTION(HMACSHA256_ComputeHashBatch_Matches_ComputeHash_For_Every_Payload)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+    unsigned char payloadBytes[300];
+    const unsigned char* payloads[11];
+    size_t payloadLens[11];
+    BUFFER_HANDLE hashes[11];
+    HMACSHA256_KEY_HANDLE hmacKey = HMACSHA256_CreateKey(key, sizeof(key) - 1);
+    HMACSHA256_RESULT result;
+    size_t i;
+
+    for (i = 0; i < sizeof(payloadBytes); i++)
+    {
+        payloadBytes[i] = (unsigned char)i;
+    }
+    for (i = 0; i < 11; i++)
+    {
+        payloads[i] = payloadBytes + i;
+        payloadLens[i] = 1 + (i * 27);
+        hashes[i] = BUFFER_new();
+    }
+
+    // act
+    result = HMACSHA256_ComputeHashBatch(hmacKey, payloads, payloadLens, 11, hashes);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, result);
+    for (i = 0; i < 11; i++)
+    {
+        /* HMACSHA256_ComputeHash enlarges the hash buffer, so it has to start empty every time */
+        (void)BUFFER_unbuild(hash);
+        ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, HMACSHA256_ComputeHash(key, sizeof(key) - 1, payloads[i], payloadLens[i], hash));
+        ASSERT_ARE_EQUAL(size_t, BUFFER_length(hash), BUFFER_length(hashes[i]));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hash), BUFFER_u_char(hashes[i]), BUFFER_length(hash)));
+    }
+
+    // cleanup
+    for (i = 0; i < 11; i++)
+    {
+        BUFFER_delete(hashes[i]);
+    }
+    HMACSHA256_DestroyKey(hmacKey);
+}
+
+/*Tests_SRS_HMACSHA256_01_003: [ HMACSHA256_ComputeHashBatch shall append the HMAC of payloads[i] to the content of hashes[i], as HMACSHA256_ComputeHashWithKey does. ]*/
+TEST_FUNCTION(HMACSHA256_ComputeHashBatch_Appends_To_Non_Empty_Buffers_Like_ComputeHash)
+{
+    // arrange
+    static const unsigned char key[] = "key";
+    static const unsigned char buffer[] = "testPayload";
+    static const unsigned char prefix[] = { 'a', 'b', 'c' };
+    const unsigned char* payloads[2] = { buffer, buffer + 4 };
+    size_t payloadLens[2] = { sizeof(buffer) - 1, sizeof(buffer) - 1 - 4 };
+    BUFFER_HANDLE hashes[2];
+    HMACSHA256_KEY_HANDLE hmacKey = HMACSHA256_CreateKey(key, sizeof(key) - 1);
+    HMACSHA256_RESULT result;
+    size_t i;
+
+    for (i = 0; i < 2; i++)
+    {
+        hashes[i] = BUFFER_create(prefix, sizeof(prefix));
+    }
+
+    // act
+    result = HMACSHA256_ComputeHashBatch(hmacKey, payloads, payloadLens, 2, hashes);
+
+    // assert
+    ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, result);
+    for (i = 0; i < 2; i++)
+    {
+        (void)BUFFER_build(hash, prefix, sizeof(prefix));
+        ASSERT_ARE_EQUAL(HMACSHA256_RESULT, HMACSHA256_OK, HMACSHA256_ComputeHash(key, sizeof(key) - 1, payloads[i], payloadLens[i], hash));
+        ASSERT_ARE_EQUAL(size_t, BUFFER_length(hash), BUFFER_length(hashes[i]));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(BUFFER_u_char(hash), BUFFER_u_char(hashes[i]), BUFFER_length(hash)));
+    }
+
+    // cleanup
+    for (i = 0; i < 2; i++)
+    {
+        BUFFER_delete(hashes[i]);
+    }
+    HMACSHA256_DestroyKey(hmacKey);
+}
+
 END_TEST_SUITE(HMACSHA256_UnitTests)
@@ -11,6 +11,7 @@
 #include "testrunnerswitcher.h"
 #include "umock_c.h"
 #include "umocktypes_charptr.h"
+#include "umocktypes_bool.h"
 #include "umock_c_negative_tests.h"
 
 static TEST_MUTEX_HANDLE g_testByTest;
@@ -50,6 +51,7 @@ extern "C"
 #include "azure_c_shared_utility/socketio.h"
 #include "azure_c_shared_utility/strings.h"
 #include "azure_c_shared_utility/base64.h"
+#include "azure_c_shared_utility/http_response_parser.h"
 
 TEST_DEFINE_ENUM_TYPE(IO_OPEN_RESULT, IO_OPEN_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(IO_OPEN_RESULT, IO_OPEN_RESULT_VALUES);
@@ -74,6 +76,20 @@ MOCK_FUNCTION_END();
 
 #undef ENABLE_MOCKS
 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+    HTTP_RESPONSE_PARSER_HANDLE real_http_response_parser_create(ON_HTTP_RESPONSE_STATUS on_status, ON_HTTP_RESPONSE_HEADER on_header, ON_HTTP_RESPONSE_HEADERS_COMPLETE on_headers_complete, ON_HTTP_RESPONSE_BODY on_body, ON_HTTP_RESPONSE_COMPLETE on_complete, void* callback_context);
+    void real_http_response_parser_destroy(HTTP_RESPONSE_PARSER_HANDLE http_response_parser);
+    int real_http_response_parser_parse(HTTP_RESPONSE_PARSER_HANDLE http_response_parser, const unsigned char* buffer, size_t size, size_t* bytes_consumed);
+    bool real_http_response_parser_is_complete(HTTP_RESPONSE_PARSER_HANDLE http_response_parser);
+    void real_http_response_parser_reset(HTTP_RESPONSE_PARSER_HANDLE http_response_parser);
+    void real_http_response_parser_set_connect_response(HTTP_RESPONSE_PARSER_HANDLE http_response_parser);
+#ifdef __cplusplus
+}
+#endif
+
 static char* umocktypes_stringify_const_SOCKETIO_CONFIG_ptr(const SOCKETIO_CONFIG** value)
 {
     char* result = NULL;
@@ -313,6 +329,8 @@ TEST_SUITE_INITIALIZE(suite_init)
     ASSERT_ARE_EQUAL(int, 0, result);
     result = umocktypes_charptr_register_types();
     ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_bool_register_types();
+    ASSERT_ARE_EQUAL(int, 0, result);
 
     REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, real_malloc);
     REGISTER_GLOBAL_MOCK_HOOK(gballoc_realloc, real_realloc);
@@ -321,6 +339,12 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_GLOBAL_MOCK_HOOK(OptionHandler_Create, my_OptionHandler_Create);
     REGISTER_GLOBAL_MOCK_HOOK(xio_open, my_xio_open);
     REGISTER_GLOBAL_MOCK_HOOK(xio_close, my_xio_close);
+    REGISTER_GLOBAL_MOCK_HOOK(http_response_parser_create, real_http_response_parser_create);
+    REGISTER_GLOBAL_MOCK_HOOK(http_response_parser_destroy, real_http_response_parser_destroy);
+    REGISTER_GLOBAL_MOCK_HOOK(http_response_parser_parse, real_http_response_parser_parse);
+    REGISTER_GLOBAL_MOCK_HOOK(http_response_parser_is_complete, real_http_response_parser_is_complete);
+    REGISTER_GLOBAL_MOCK_HOOK(http_response_parser_reset, real_http_response_parser_reset);
+    REGISTER_GLOBAL_MOCK_HOOK(http_response_parser_set_connect_response, real_http_response_parser_set_connect_response);
     REGISTER_GLOBAL_MOCK_RETURN(OptionHandler_Create, TEST_OPTION_HANDLER);
     REGISTER_GLOBAL_MOCK_RETURN(socketio_get_interface_description, TEST_SOCKETIO_INTERFACE_DESCRIPTION);
     REGISTER_GLOBAL_MOCK_RETURN(xio_create, TEST_IO_HANDLE);
@@ -342,7 +366,14 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_UMOCK_ALIAS_TYPE(ON_IO_CLOSE_COMPLETE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(ON_SEND_COMPLETE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(STRING_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_RESPONSE_PARSER_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_RESPONSE_STATUS, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_RESPONSE_HEADER, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_RESPONSE_HEADERS_COMPLETE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_RESPONSE_BODY, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_RESPONSE_COMPLETE, void*);
     REGISTER_UMOCKC_PAIRED_CREATE_DESTROY_CALLS(xio_create, xio_destroy);
+    REGISTER_UMOCKC_PAIRED_CREATE_DESTROY_CALLS(http_response_parser_create, http_response_parser_destroy);
 }
 
 TEST_SUITE_CLEANUP(suite_cleanup)
@@ -2240,8 +2271,9 @@ TEST_FUNCTION(on_underlying_io_open_complete_in_CLOSING_indicates_an_error)
 
 /* on_underlying_io_bytes_received */
 
-/* Tests_SRS_HTTP_PROXY_IO_01_065: [ When bytes are received and the response to the CONNECT request was not yet received, the bytes shall be accumulated until a double new-line is detected. ]*/
-TEST_FUNCTION(on_underlying_io_bytes_received_with_1_byte_buffers_the_received_bytes)
+/* Tests_SRS_HTTP_PROXY_IO_01_065: [ When bytes are received and the response to the CONNECT request was not yet received, the bytes shall be handed to an HTTP response parser, without being accumulated. ]*/
+/* Tests_SRS_HTTP_PROXY_IO_01_096: [ The HTTP response parser shall be created by calling `http_response_parser_create` the first time bytes are received for the CONNECT response. ]*/
+TEST_FUNCTION(on_underlying_io_bytes_received_with_1_byte_creates_the_parser_and_parses_the_received_bytes)
 {
     // arrange
     CONCRETE_IO_HANDLE http_io;
@@ -2251,7 +2283,10 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_1_byte_buffers_the_received_b
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
 
     // act
     g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)connect_response, 1);
@@ -2263,8 +2298,8 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_1_byte_buffers_the_received_b
     http_proxy_io_get_interface_description()->concrete_io_destroy(http_io);
 }
 
-/* Tests_SRS_HTTP_PROXY_IO_01_065: [ When bytes are received and the response to the CONNECT request was not yet received, the bytes shall be accumulated until a double new-line is detected. ]*/
-TEST_FUNCTION(on_underlying_io_bytes_received_with_2_times_1_byte_buffers_the_received_bytes)
+/* Tests_SRS_HTTP_PROXY_IO_01_065: [ When bytes are received and the response to the CONNECT request was not yet received, the bytes shall be handed to an HTTP response parser, without being accumulated. ]*/
+TEST_FUNCTION(on_underlying_io_bytes_received_with_2_times_1_byte_parses_the_received_bytes_with_the_same_parser)
 {
     // arrange
     CONCRETE_IO_HANDLE http_io;
@@ -2275,7 +2310,8 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_2_times_1_byte_buffers_the_re
     g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)connect_response, 1);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
 
     // act
     g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)connect_response + 1, 1);
@@ -2287,7 +2323,7 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_2_times_1_byte_buffers_the_re
     http_proxy_io_get_interface_description()->concrete_io_destroy(http_io);
 }
 
-/* Tests_SRS_HTTP_PROXY_IO_01_066: [ When a double new-line is detected the response shall be parsed in order to extract the status code. ]*/
+/* Tests_SRS_HTTP_PROXY_IO_01_066: [ The response shall be parsed incrementally in order to extract the status code. ]*/
 /* Tests_SRS_HTTP_PROXY_IO_01_069: [ Any successful (2xx) response to a CONNECT request indicates that the proxy has established a connection to the requested host and port, and has switched to tunneling the current connection to that server connection. ]*/
 /* Tests_SRS_HTTP_PROXY_IO_01_070: [ When a success status code is parsed, the `on_open_complete` callback shall be triggered with `IO_OPEN_OK`, passing also the `on_open_complete_context` argument as `context`. ]*/
 /* Tests_SRS_HTTP_PROXY_IO_01_073: [ Once a success status code was parsed, the IO shall be OPEN. ]*/
@@ -2301,7 +2337,11 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_good_reply_indicates_OPEN_O
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_OK));
 
     // act
@@ -2314,7 +2354,7 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_good_reply_indicates_OPEN_O
     http_proxy_io_get_interface_description()->concrete_io_destroy(http_io);
 }
 
-/* Tests_SRS_HTTP_PROXY_IO_01_066: [ When a double new-line is detected the response shall be parsed in order to extract the status code. ]*/
+/* Tests_SRS_HTTP_PROXY_IO_01_066: [ The response shall be parsed incrementally in order to extract the status code. ]*/
 TEST_FUNCTION(on_underlying_io_bytes_received_with_a_good_reply_in_2_chunks_indicates_OPEN_OK)
 {
     // arrange
@@ -2326,7 +2366,9 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_good_reply_in_2_chunks_indi
     g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)connect_response, sizeof(connect_response) - 2);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_OK));
 
     // act
@@ -2339,8 +2381,8 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_good_reply_in_2_chunks_indi
     http_proxy_io_get_interface_description()->concrete_io_destroy(http_io);
 }
 
-/* Tests_SRS_HTTP_PROXY_IO_01_067: [ If allocating memory for the buffered bytes fails, the `on_open_complete` callback shall be triggered with `IO_OPEN_ERROR`, passing also the `on_open_complete_context` argument as `context`. ]*/
-TEST_FUNCTION(when_allocating_memory_for_cached_data_in_on_underlying_io_bytes_an_error_is_triggered)
+/* Tests_SRS_HTTP_PROXY_IO_01_067: [ If creating the HTTP response parser fails, the `on_open_complete` callback shall be triggered with `IO_OPEN_ERROR`, passing also the `on_open_complete_context` argument as `context`. ]*/
+TEST_FUNCTION(when_creating_the_response_parser_in_on_underlying_io_bytes_fails_an_error_is_triggered)
 {
     // arrange
     CONCRETE_IO_HANDLE http_io;
@@ -2350,7 +2392,7 @@ TEST_FUNCTION(when_allocating_memory_for_cached_data_in_on_underlying_io_bytes_a
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG))
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG))
         .SetReturn(NULL);
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_ERROR));
@@ -2365,7 +2407,7 @@ TEST_FUNCTION(when_allocating_memory_for_cached_data_in_on_underlying_io_bytes_a
     http_proxy_io_get_interface_description()->concrete_io_destroy(http_io);
 }
 
-/* Tests_SRS_HTTP_PROXY_IO_01_066: [ When a double new-line is detected the response shall be parsed in order to extract the status code. ]*/
+/* Tests_SRS_HTTP_PROXY_IO_01_066: [ The response shall be parsed incrementally in order to extract the status code. ]*/
 /* Tests_SRS_HTTP_PROXY_IO_01_069: [ Any successful (2xx) response to a CONNECT request indicates that the proxy has established a connection to the requested host and port, and has switched to tunneling the current connection to that server connection. ]*/
 /* Tests_SRS_HTTP_PROXY_IO_01_070: [ When a success status code is parsed, the `on_open_complete` callback shall be triggered with `IO_OPEN_OK`, passing also the `on_open_complete_context` argument as `context`. ]*/
 /* Tests_SRS_HTTP_PROXY_IO_01_073: [ Once a success status code was parsed, the IO shall be OPEN. ]*/
@@ -2380,7 +2422,11 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_good_reply_status_code_201_
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_OK));
 
     // act
@@ -2393,7 +2439,7 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_good_reply_status_code_201_
     http_proxy_io_get_interface_description()->concrete_io_destroy(http_io);
 }
 
-/* Tests_SRS_HTTP_PROXY_IO_01_066: [ When a double new-line is detected the response shall be parsed in order to extract the status code. ]*/
+/* Tests_SRS_HTTP_PROXY_IO_01_066: [ The response shall be parsed incrementally in order to extract the status code. ]*/
 /* Tests_SRS_HTTP_PROXY_IO_01_069: [ Any successful (2xx) response to a CONNECT request indicates that the proxy has established a connection to the requested host and port, and has switched to tunneling the current connection to that server connection. ]*/
 /* Tests_SRS_HTTP_PROXY_IO_01_070: [ When a success status code is parsed, the `on_open_complete` callback shall be triggered with `IO_OPEN_OK`, passing also the `on_open_complete_context` argument as `context`. ]*/
 /* Tests_SRS_HTTP_PROXY_IO_01_073: [ Once a success status code was parsed, the IO shall be OPEN. ]*/
@@ -2408,7 +2454,11 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_good_reply_status_code_299_
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_OK));
 
     // act
@@ -2421,7 +2471,7 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_good_reply_status_code_299_
     http_proxy_io_get_interface_description()->concrete_io_destroy(http_io);
 }
 
-/* Tests_SRS_HTTP_PROXY_IO_01_066: [ When a double new-line is detected the response shall be parsed in order to extract the status code. ]*/
+/* Tests_SRS_HTTP_PROXY_IO_01_066: [ The response shall be parsed incrementally in order to extract the status code. ]*/
 /* Tests_SRS_HTTP_PROXY_IO_01_069: [ Any successful (2xx) response to a CONNECT request indicates that the proxy has established a connection to the requested host and port, and has switched to tunneling the current connection to that server connection. ]*/
 /* Tests_SRS_HTTP_PROXY_IO_01_070: [ When a success status code is parsed, the `on_open_complete` callback shall be triggered with `IO_OPEN_OK`, passing also the `on_open_complete_context` argument as `context`. ]*/
 /* Tests_SRS_HTTP_PROXY_IO_01_073: [ Once a success status code was parsed, the IO shall be OPEN. ]*/
@@ -2437,7 +2487,11 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_good_reply_status_code_200_
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_OK));
 
     // act
@@ -2462,7 +2516,9 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_199_code_indicates_an_error
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_ERROR));
 
@@ -2488,7 +2544,9 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_300_code_indicates_an_error
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_ERROR));
 
@@ -2516,6 +2574,7 @@ TEST_FUNCTION(after_a_bad_status_code_http_proxy_io_open_succeeds)
     g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)connect_response_300, sizeof(connect_response_300) - 1);
     umock_c_reset_all_calls();
 
+    EXPECTED_CALL(http_response_parser_reset(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(xio_open(TEST_IO_HANDLE, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG))
         .IgnoreArgument_on_io_open_complete()
         .IgnoreArgument_on_io_open_complete_context()
@@ -2548,7 +2607,11 @@ TEST_FUNCTION(one_extra_byte_gets_indicated_as_received)
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_OK));
     STRICT_EXPECTED_CALL(test_on_bytes_received((void*)0x4243, IGNORED_PTR_ARG, sizeof(expected_bytes)))
         .ValidateArgumentBuffer(2, expected_bytes, sizeof(expected_bytes));
@@ -2576,7 +2639,11 @@ TEST_FUNCTION(three_extra_byte_get_indicated_as_received)
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_OK));
     STRICT_EXPECTED_CALL(test_on_bytes_received((void*)0x4243, IGNORED_PTR_ARG, sizeof(expected_bytes)))
         .ValidateArgumentBuffer(2, expected_bytes, sizeof(expected_bytes));
@@ -2591,6 +2658,72 @@ TEST_FUNCTION(three_extra_byte_get_indicated_as_received)
     http_proxy_io_get_interface_description()->concrete_io_destroy(http_io);
 }
 
+/* Tests_SRS_HTTP_PROXY_IO_01_097: [ The HTTP response parser shall be told by calling `http_response_parser_set_connect_response` that it parses a CONNECT response, so that the bytes following the headers of a 2xx response are never taken as a body. ]*/
+/* Tests_SRS_HTTP_PROXY_IO_01_072: [ Any bytes that are extra (not consumed by the CONNECT response), shall be indicated as received by calling the `on_bytes_received` callback and passing the `on_bytes_received_context` as context argument. ]*/
+TEST_FUNCTION(tunnel_bytes_after_a_connect_response_with_content_length_get_indicated_as_received)
+{
+    // arrange
+    CONCRETE_IO_HANDLE http_io;
+    static const char connect_response_with_content_length[] = "HTTP/1.1 200 Connection established\r\nContent-Length: 5\r\n\r\nABC";
+    static const unsigned char expected_bytes[] = { 'A', 'B', 'C' };
+
+    http_io = http_proxy_io_get_interface_description()->concrete_io_create((void*)&http_proxy_io_config_with_username);
+    (void)http_proxy_io_get_interface_description()->concrete_io_open(http_io, test_on_io_open_complete, (void*)0x4242, test_on_bytes_received, (void*)0x4243, test_on_io_error, (void*)0x4244);
+    g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_OK));
+    STRICT_EXPECTED_CALL(test_on_bytes_received((void*)0x4243, IGNORED_PTR_ARG, sizeof(expected_bytes)))
+        .ValidateArgumentBuffer(2, expected_bytes, sizeof(expected_bytes));
+
+    // act
+    g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)connect_response_with_content_length, sizeof(connect_response_with_content_length) - 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_proxy_io_get_interface_description()->concrete_io_destroy(http_io);
+}
+
+/* Tests_SRS_HTTP_PROXY_IO_01_097: [ The HTTP response parser shall be told by calling `http_response_parser_set_connect_response` that it parses a CONNECT response, so that the bytes following the headers of a 2xx response are never taken as a body. ]*/
+/* Tests_SRS_HTTP_PROXY_IO_01_072: [ Any bytes that are extra (not consumed by the CONNECT response), shall be indicated as received by calling the `on_bytes_received` callback and passing the `on_bytes_received_context` as context argument. ]*/
+TEST_FUNCTION(tunnel_bytes_after_a_chunked_connect_response_get_indicated_as_received)
+{
+    // arrange
+    CONCRETE_IO_HANDLE http_io;
+    static const char chunked_connect_response[] = "HTTP/1.1 200 Connection established\r\nTransfer-Encoding: chunked\r\n\r\n\x16\x03\x01";
+    static const unsigned char expected_bytes[] = { 0x16, 0x03, 0x01 };
+
+    http_io = http_proxy_io_get_interface_description()->concrete_io_create((void*)&http_proxy_io_config_with_username);
+    (void)http_proxy_io_get_interface_description()->concrete_io_open(http_io, test_on_io_open_complete, (void*)0x4242, test_on_bytes_received, (void*)0x4243, test_on_io_error, (void*)0x4244);
+    g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_OK));
+    STRICT_EXPECTED_CALL(test_on_bytes_received((void*)0x4243, IGNORED_PTR_ARG, sizeof(expected_bytes)))
+        .ValidateArgumentBuffer(2, expected_bytes, sizeof(expected_bytes));
+
+    // act
+    g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)chunked_connect_response, sizeof(chunked_connect_response) - 1);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_proxy_io_get_interface_description()->concrete_io_destroy(http_io);
+}
+
 /* Tests_SRS_HTTP_PROXY_IO_01_074: [ If `on_underlying_io_bytes_received` is called while OPEN, all bytes shall be indicated as received by calling the `on_bytes_received` callback and passing the `on_bytes_received_context` as context argument. ]*/
 TEST_FUNCTION(bytes_indicated_as_received_in_OPEN_get_bubbled_up)
 {
@@ -2652,7 +2785,9 @@ TEST_FUNCTION(a_bad_reply_triggers_an_error_in_open_complete_callback)
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_ERROR));
 
@@ -2678,7 +2813,9 @@ TEST_FUNCTION(a_bad_reply_malformed_char_triggers_an_error_in_open_complete_call
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_ERROR));
 
@@ -2704,7 +2841,9 @@ TEST_FUNCTION(a_bad_reply_only_one_char_triggers_an_error_in_open_complete_callb
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_set_connect_response(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
     STRICT_EXPECTED_CALL(test_on_io_open_complete((void*)0x4242, IO_OPEN_ERROR));
 
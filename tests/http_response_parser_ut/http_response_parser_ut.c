@@ -0,0 +1,1009 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#endif
+
+#include "testrunnerswitcher.h"
+#include "umock_c.h"
+
+static void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* my_gballoc_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_gballoc_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+
+#include "azure_c_shared_utility/gballoc.h"
+
+#undef ENABLE_MOCKS
+
+#include "azure_c_shared_utility/http_response_parser.h"
+
+static TEST_MUTEX_HANDLE g_testByTest;
+static TEST_MUTEX_HANDLE g_dllByDll;
+
+#define TEST_CONTEXT (void*)0x4242
+
+static int status_code_received;
+static char reason_phrase_received[64];
+static size_t header_count;
+static char last_header_name[64];
+static char last_header_value[64];
+static size_t headers_complete_call_count;
+static bool is_chunked_received;
+static size_t content_length_received;
+static unsigned char body_received[256];
+static size_t body_received_length;
+static size_t body_call_count;
+static size_t complete_call_count;
+static void* last_context;
+
+static void copy_view(char* destination, size_t destination_size, const char* source, size_t source_length)
+{
+    if (source_length >= destination_size)
+    {
+        source_length = destination_size - 1;
+    }
+
+    (void)memcpy(destination, source, source_length);
+    destination[source_length] = '\0';
+}
+
+static void test_on_status(void* context, int status_code, const char* reason_phrase, size_t reason_phrase_length)
+{
+    last_context = context;
+    status_code_received = status_code;
+    copy_view(reason_phrase_received, sizeof(reason_phrase_received), reason_phrase, reason_phrase_length);
+}
+
+static void test_on_header(void* context, const char* name, size_t name_length, const char* value, size_t value_length)
+{
+    last_context = context;
+    header_count++;
+    copy_view(last_header_name, sizeof(last_header_name), name, name_length);
+    copy_view(last_header_value, sizeof(last_header_value), value, value_length);
+}
+
+static void test_on_headers_complete(void* context, bool is_chunked, size_t content_length)
+{
+    last_context = context;
+    headers_complete_call_count++;
+    is_chunked_received = is_chunked;
+    content_length_received = content_length;
+}
+
+static void test_on_body(void* context, const unsigned char* body_bytes, size_t length)
+{
+    last_context = context;
+    body_call_count++;
+    if (body_received_length + length <= sizeof(body_received))
+    {
+        (void)memcpy(body_received + body_received_length, body_bytes, length);
+    }
+    body_received_length += length;
+}
+
+static void test_on_complete(void* context)
+{
+    last_context = context;
+    complete_call_count++;
+}
+
+static HTTP_RESPONSE_PARSER_HANDLE create_test_parser(void)
+{
+    HTTP_RESPONSE_PARSER_HANDLE result = http_response_parser_create(test_on_status, test_on_header, test_on_headers_complete, test_on_body, test_on_complete, TEST_CONTEXT);
+    ASSERT_IS_NOT_NULL(result);
+    umock_c_reset_all_calls();
+    return result;
+}
+
+/* feeds the response in pieces of at most chunk_size bytes, returning the first non-zero parse result */
+static int parse_in_pieces(HTTP_RESPONSE_PARSER_HANDLE parser, const char* response, size_t chunk_size, size_t* total_consumed)
+{
+    int result = 0;
+    size_t length = strlen(response);
+    size_t pos = 0;
+
+    while ((pos < length) && (result == 0))
+    {
+        size_t bytes_consumed;
+        size_t to_parse = ((length - pos) < chunk_size) ? (length - pos) : chunk_size;
+
+        result = http_response_parser_parse(parser, (const unsigned char*)response + pos, to_parse, &bytes_consumed);
+        pos += bytes_consumed;
+        if (bytes_consumed < to_parse)
+        {
+            break;
+        }
+    }
+
+    *total_consumed = pos;
+    return result;
+}
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    char temp_str[256];
+    (void)snprintf(temp_str, sizeof(temp_str), "umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+    ASSERT_FAIL(temp_str);
+}
+
+BEGIN_TEST_SUITE(http_response_parser_ut)
+
+TEST_SUITE_INITIALIZE(suite_init)
+{
+    int result;
+
+    TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+    g_testByTest = TEST_MUTEX_CREATE();
+    ASSERT_IS_NOT_NULL(g_testByTest);
+
+    result = umock_c_init(on_umock_c_error);
+    ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_realloc, my_gballoc_realloc);
+    REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+}
+
+TEST_SUITE_CLEANUP(suite_cleanup)
+{
+    umock_c_deinit();
+
+    TEST_MUTEX_DESTROY(g_testByTest);
+    TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+}
+
+TEST_FUNCTION_INITIALIZE(method_init)
+{
+    if (TEST_MUTEX_ACQUIRE(g_testByTest))
+    {
+        ASSERT_FAIL("Could not acquire test serialization mutex.");
+    }
+
+    status_code_received = 0;
+    reason_phrase_received[0] = '\0';
+    header_count = 0;
+    last_header_name[0] = '\0';
+    last_header_value[0] = '\0';
+    headers_complete_call_count = 0;
+    is_chunked_received = false;
+    content_length_received = 0;
+    body_received_length = 0;
+    body_call_count = 0;
+    complete_call_count = 0;
+    last_context = NULL;
+
+    umock_c_reset_all_calls();
+}
+
+TEST_FUNCTION_CLEANUP(method_cleanup)
+{
+    TEST_MUTEX_RELEASE(g_testByTest);
+}
+
+/* http_response_parser_create */
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_001: [ `http_response_parser_create` shall create a new parser instance and on success return a non-NULL handle to it. ]*/
+TEST_FUNCTION(http_response_parser_create_succeeds)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE result;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    // act
+    result = http_response_parser_create(test_on_status, test_on_header, test_on_headers_complete, test_on_body, test_on_complete, TEST_CONTEXT);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_response_parser_destroy(result);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_002: [ Any of the callback arguments and `callback_context` shall be allowed to be NULL. ]*/
+TEST_FUNCTION(http_response_parser_create_with_NULL_callbacks_succeeds)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nab";
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+    // act
+    result = http_response_parser_create(NULL, NULL, NULL, NULL, NULL, NULL);
+
+    // assert
+    ASSERT_IS_NOT_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(int, 0, http_response_parser_parse(result, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed));
+    ASSERT_IS_TRUE(http_response_parser_is_complete(result));
+
+    // cleanup
+    http_response_parser_destroy(result);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_003: [ If allocating memory for the parser fails, `http_response_parser_create` shall return NULL. ]*/
+TEST_FUNCTION(when_allocating_memory_fails_http_response_parser_create_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE result;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = http_response_parser_create(test_on_status, test_on_header, test_on_headers_complete, test_on_body, test_on_complete, TEST_CONTEXT);
+
+    // assert
+    ASSERT_IS_NULL(result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* http_response_parser_destroy */
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_004: [ `http_response_parser_destroy` shall free all resources associated with the parser. ]*/
+TEST_FUNCTION(http_response_parser_destroy_frees_the_instance)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    // act
+    http_response_parser_destroy(parser);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_004: [ `http_response_parser_destroy` shall free all resources associated with the parser. ]*/
+TEST_FUNCTION(http_response_parser_destroy_frees_the_line_buffer)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    size_t bytes_consumed;
+    (void)http_response_parser_parse(parser, (const unsigned char*)"HTTP/1.1", 8, &bytes_consumed);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    // act
+    http_response_parser_destroy(parser);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_005: [ If `http_response_parser` is NULL, `http_response_parser_destroy` shall do nothing. ]*/
+TEST_FUNCTION(http_response_parser_destroy_with_NULL_does_nothing)
+{
+    // arrange
+
+    // act
+    http_response_parser_destroy(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* http_response_parser_parse */
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_007: [ If `http_response_parser` is NULL, or `buffer` is NULL while `size` is not 0, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(http_response_parser_parse_with_NULL_handle_fails)
+{
+    // arrange
+    int result;
+    size_t bytes_consumed;
+
+    // act
+    result = http_response_parser_parse(NULL, (const unsigned char*)"HTTP", 4, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_007: [ If `http_response_parser` is NULL, or `buffer` is NULL while `size` is not 0, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(http_response_parser_parse_with_NULL_buffer_and_non_zero_size_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+
+    // act
+    result = http_response_parser_parse(parser, NULL, 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_006: [ `http_response_parser_parse` shall parse the bytes in `buffer` incrementally, carrying any incomplete line over to the next call. ]*/
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_011: [ Lines fully contained in `buffer` shall be processed in place, without any copy. ]*/
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_012: [ If `bytes_consumed` is not NULL, it shall be set to the number of bytes from `buffer` that were consumed. ]*/
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_016: [ Once the status line is parsed, `on_status` shall be called with the status code and a view of the reason phrase. ]*/
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_023: [ For each header line `on_header` shall be called with views of the header name and header value. ]*/
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_020: [ When the empty line ending the headers is parsed, `on_headers_complete` shall be called indicating whether the body is chunked and the content length. ]*/
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_024: [ Body bytes shall be indicated through `on_body` as views into `buffer`, without being copied. ]*/
+TEST_FUNCTION(http_response_parser_parse_a_complete_response_in_one_buffer_does_not_allocate)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\n0123456789";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_ARE_EQUAL(size_t, sizeof(response) - 1, bytes_consumed);
+    ASSERT_ARE_EQUAL(int, 200, status_code_received);
+    ASSERT_ARE_EQUAL(char_ptr, "OK", reason_phrase_received);
+    ASSERT_ARE_EQUAL(size_t, 1, header_count);
+    ASSERT_ARE_EQUAL(char_ptr, "Content-Length", last_header_name);
+    ASSERT_ARE_EQUAL(char_ptr, "10", last_header_value);
+    ASSERT_ARE_EQUAL(size_t, 1, headers_complete_call_count);
+    ASSERT_IS_FALSE(is_chunked_received);
+    ASSERT_ARE_EQUAL(size_t, 10, content_length_received);
+    ASSERT_ARE_EQUAL(size_t, 10, body_received_length);
+    ASSERT_ARE_EQUAL(int, 0, memcmp("0123456789", body_received, 10));
+    ASSERT_ARE_EQUAL(size_t, 1, complete_call_count);
+    ASSERT_ARE_EQUAL(void_ptr, TEST_CONTEXT, last_context);
+    ASSERT_IS_TRUE(http_response_parser_is_complete(parser));
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_006: [ `http_response_parser_parse` shall parse the bytes in `buffer` incrementally, carrying any incomplete line over to the next call. ]*/
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_010: [ If a line is not complete, its bytes shall be copied to an internal line buffer. ]*/
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_029: [ The line buffer shall grow geometrically so that a line split across many calls does not cause a reallocation per call. ]*/
+TEST_FUNCTION(http_response_parser_parse_one_byte_at_a_time_succeeds)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/111.222 433 555\r\ncontent-length:10\r\ntransfer-encoding:\r\n\r\n0123456789";
+
+    // act
+    result = parse_in_pieces(parser, response, 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, sizeof(response) - 1, bytes_consumed);
+    ASSERT_ARE_EQUAL(int, 433, status_code_received);
+    ASSERT_ARE_EQUAL(char_ptr, "555", reason_phrase_received);
+    ASSERT_ARE_EQUAL(size_t, 2, header_count);
+    ASSERT_ARE_EQUAL(char_ptr, "transfer-encoding", last_header_name);
+    ASSERT_ARE_EQUAL(char_ptr, "", last_header_value);
+    ASSERT_ARE_EQUAL(size_t, 10, body_received_length);
+    ASSERT_ARE_EQUAL(size_t, 10, body_call_count);
+    ASSERT_ARE_EQUAL(int, 0, memcmp("0123456789", body_received, 10));
+    ASSERT_IS_TRUE(http_response_parser_is_complete(parser));
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_030: [ If growing the line buffer fails, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(when_growing_the_line_buffer_fails_http_response_parser_parse_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+
+    STRICT_EXPECTED_CALL(gballoc_realloc(NULL, IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)"HTTP/1.1 2", 10, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_008: [ Once parsing failed, any subsequent call to `http_response_parser_parse` shall fail until `http_response_parser_reset` is called. ]*/
+TEST_FUNCTION(http_response_parser_parse_after_an_error_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 OK\r\n\r\n";
+    (void)http_response_parser_parse(parser, (const unsigned char*)"HTTPS/1.1 200 OK\r\n", 18, &bytes_consumed);
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_IS_FALSE(http_response_parser_is_complete(parser));
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_009: [ Once the response is complete, `http_response_parser_parse` shall stop consuming bytes. ]*/
+TEST_FUNCTION(http_response_parser_parse_does_not_consume_bytes_after_the_response)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n\r\n\x81\x02hi";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, sizeof(response) - 1 - 4, bytes_consumed);
+    ASSERT_ARE_EQUAL(int, 101, status_code_received);
+    ASSERT_IS_TRUE(http_response_parser_is_complete(parser));
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_013: [ Lines shall be terminated by LF, with an optional preceding CR that is not part of the line. ]*/
+TEST_FUNCTION(http_response_parser_parse_accepts_LF_only_line_endings)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.0 204 No Content\nServer: test\n\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 204, status_code_received);
+    ASSERT_ARE_EQUAL(char_ptr, "No Content", reason_phrase_received);
+    ASSERT_ARE_EQUAL(char_ptr, "test", last_header_value);
+    ASSERT_IS_TRUE(http_response_parser_is_complete(parser));
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_014: [ If the status line does not start with `HTTP/`, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(http_response_parser_parse_with_a_non_HTTP_status_line_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTPS/111.222 433 555\r\n\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 0, status_code_received);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_015: [ If the HTTP version or the status code is missing or malformed, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(http_response_parser_parse_with_a_version_without_dot_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/111222 433 555\r\n\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_015: [ If the HTTP version or the status code is missing or malformed, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(http_response_parser_parse_without_a_status_code_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/111.222\r\n\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_015: [ If the HTTP version or the status code is missing or malformed, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(http_response_parser_parse_with_a_non_numeric_status_code_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 2x0 OK\r\n\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_017: [ If a header line does not contain a `:` preceded by a header name, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(http_response_parser_parse_with_a_header_without_colon_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 OK\r\nContent-Length 5\r\n\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, header_count);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_018: [ Leading and trailing whitespace shall be stripped from header values. ]*/
+TEST_FUNCTION(http_response_parser_parse_strips_whitespace_from_header_values)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 OK\r\niothub-value: \t some value \t\r\n\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, "iothub-value", last_header_name);
+    ASSERT_ARE_EQUAL(char_ptr, "some value", last_header_value);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_019: [ If the `Content-Length` value is not a valid decimal number, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(http_response_parser_parse_with_an_empty_content_length_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 OK\r\ncontent-length:\r\n\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_019: [ If the `Content-Length` value is not a valid decimal number, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(http_response_parser_parse_with_an_overflowing_content_length_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 OK\r\nContent-Length: 1000000000000000000000000000000\r\n\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_021: [ Responses with a 1xx, 204 or 304 status code shall be considered to have no body. ]*/
+TEST_FUNCTION(http_response_parser_parse_304_with_content_length_has_no_body)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 304 Not Modified\r\nContent-Length: 10\r\n\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, body_call_count);
+    ASSERT_IS_TRUE(http_response_parser_is_complete(parser));
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_022: [ A response that is neither chunked nor has a `Content-Length` header shall be considered to have no body. ]*/
+TEST_FUNCTION(http_response_parser_parse_without_content_length_has_no_body)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 Connection established\r\n\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 1, headers_complete_call_count);
+    ASSERT_ARE_EQUAL(size_t, 0, body_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, complete_call_count);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_024: [ Body bytes shall be indicated through `on_body` as views into `buffer`, without being copied. ]*/
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_026: [ A chunk of size 0 shall end the body; any trailer lines up to the final empty line shall be consumed and ignored. ]*/
+TEST_FUNCTION(http_response_parser_parse_chunked_body_succeeds)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 OK\r\nTransfer-Encoding: gzip, Chunked\r\n\r\n5\r\nhello\r\n6;name=value\r\n world\r\n0\r\nTrailer: x\r\n\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, sizeof(response) - 1, bytes_consumed);
+    ASSERT_IS_TRUE(is_chunked_received);
+    ASSERT_ARE_EQUAL(size_t, 2, body_call_count);
+    ASSERT_ARE_EQUAL(size_t, 11, body_received_length);
+    ASSERT_ARE_EQUAL(int, 0, memcmp("hello world", body_received, 11));
+    ASSERT_ARE_EQUAL(size_t, 1, complete_call_count);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_006: [ `http_response_parser_parse` shall parse the bytes in `buffer` incrementally, carrying any incomplete line over to the next call. ]*/
+TEST_FUNCTION(http_response_parser_parse_chunked_body_in_pieces_succeeds)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n6\r\n world\r\n0\r\n\r\n";
+
+    // act
+    result = parse_in_pieces(parser, response, 7, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, sizeof(response) - 1, bytes_consumed);
+    ASSERT_ARE_EQUAL(size_t, 11, body_received_length);
+    ASSERT_ARE_EQUAL(int, 0, memcmp("hello world", body_received, 11));
+    ASSERT_IS_TRUE(http_response_parser_is_complete(parser));
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_025: [ If a chunk size line does not start with a hexadecimal number, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(http_response_parser_parse_with_an_invalid_chunk_size_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\nxyz\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_027: [ If the chunk data is not followed by CRLF, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(http_response_parser_parse_with_chunk_data_not_followed_by_CRLF_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n2\r\nabc\r\n";
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_028: [ If a line is longer than `HTTP_RESPONSE_PARSER_MAX_LINE_LENGTH`, `http_response_parser_parse` shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(http_response_parser_parse_with_a_too_long_line_fails)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    size_t i;
+    unsigned char long_line[1024];
+
+    (void)memcpy(long_line, "HTTP/1.1 200 ", 13);
+    for (i = 13; i < sizeof(long_line); i++)
+    {
+        long_line[i] = 'a';
+    }
+
+    // act
+    result = 0;
+    for (i = 0; (i < 16) && (result == 0); i++)
+    {
+        result = http_response_parser_parse(parser, long_line + ((i == 0) ? 0 : 13), sizeof(long_line) - ((i == 0) ? 0 : 13), &bytes_consumed);
+    }
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* http_response_parser_is_complete */
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_031: [ `http_response_parser_is_complete` shall return true once a full response has been parsed. ]*/
+TEST_FUNCTION(http_response_parser_is_complete_returns_false_while_the_body_is_incomplete)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    bool result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\n01234";
+    (void)http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // act
+    result = http_response_parser_is_complete(parser);
+
+    // assert
+    ASSERT_IS_FALSE(result);
+    ASSERT_ARE_EQUAL(size_t, 0, complete_call_count);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_032: [ If `http_response_parser` is NULL, `http_response_parser_is_complete` shall return false. ]*/
+TEST_FUNCTION(http_response_parser_is_complete_with_NULL_returns_false)
+{
+    // arrange
+    bool result;
+
+    // act
+    result = http_response_parser_is_complete(NULL);
+
+    // assert
+    ASSERT_IS_FALSE(result);
+}
+
+/* http_response_parser_reset */
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_033: [ `http_response_parser_reset` shall prepare the parser for a new response, keeping the line buffer allocated. ]*/
+TEST_FUNCTION(http_response_parser_reset_allows_parsing_a_new_response)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 404 Not Found\r\n\r\n";
+    (void)http_response_parser_parse(parser, (const unsigned char*)"garbage\r\n", 9, &bytes_consumed);
+
+    // act
+    http_response_parser_reset(parser);
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(int, 404, status_code_received);
+    ASSERT_IS_TRUE(http_response_parser_is_complete(parser));
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_034: [ If `http_response_parser` is NULL, `http_response_parser_reset` shall do nothing. ]*/
+TEST_FUNCTION(http_response_parser_reset_with_NULL_does_nothing)
+{
+    // arrange
+
+    // act
+    http_response_parser_reset(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* http_response_parser_set_connect_response */
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_035: [ `http_response_parser_set_connect_response` shall make the parser treat every response it parses from then on, including after `http_response_parser_reset`, as the response to a CONNECT request. ]*/
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_036: [ Once `http_response_parser_set_connect_response` was called, a response with a 2xx status code shall be complete at the end of its headers, ignoring `Content-Length` and `Transfer-Encoding`. ]*/
+TEST_FUNCTION(http_response_parser_parse_2xx_connect_response_with_content_length_has_no_body)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char headers[] = "HTTP/1.1 200 Connection established\r\nContent-Length: 5\r\n\r\n";
+    static const char response[] = "HTTP/1.1 200 Connection established\r\nContent-Length: 5\r\n\r\n\x16\x03\x01\x00\x31";
+    http_response_parser_set_connect_response(parser);
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, sizeof(headers) - 1, bytes_consumed);
+    ASSERT_ARE_EQUAL(size_t, 0, body_call_count);
+    ASSERT_ARE_EQUAL(size_t, 1, complete_call_count);
+    ASSERT_IS_TRUE(http_response_parser_is_complete(parser));
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_036: [ Once `http_response_parser_set_connect_response` was called, a response with a 2xx status code shall be complete at the end of its headers, ignoring `Content-Length` and `Transfer-Encoding`. ]*/
+TEST_FUNCTION(http_response_parser_parse_2xx_connect_response_with_transfer_encoding_has_no_body)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char headers[] = "HTTP/1.1 200 Connection established\r\nTransfer-Encoding: chunked\r\nContent-Length: 5\r\n\r\n";
+    static const char response[] = "HTTP/1.1 200 Connection established\r\nTransfer-Encoding: chunked\r\nContent-Length: 5\r\n\r\n\x16\x03\x01\x00\x31";
+    http_response_parser_set_connect_response(parser);
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, sizeof(headers) - 1, bytes_consumed);
+    ASSERT_ARE_EQUAL(size_t, 0, body_call_count);
+    ASSERT_IS_TRUE(http_response_parser_is_complete(parser));
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_036: [ Once `http_response_parser_set_connect_response` was called, a response with a 2xx status code shall be complete at the end of its headers, ignoring `Content-Length` and `Transfer-Encoding`. ]*/
+TEST_FUNCTION(http_response_parser_parse_non_2xx_connect_response_keeps_its_body)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char response[] = "HTTP/1.1 407 Proxy Authentication Required\r\nContent-Length: 5\r\n\r\nhello";
+    http_response_parser_set_connect_response(parser);
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, sizeof(response) - 1, bytes_consumed);
+    ASSERT_ARE_EQUAL(size_t, 5, body_received_length);
+    ASSERT_IS_TRUE(http_response_parser_is_complete(parser));
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_035: [ `http_response_parser_set_connect_response` shall make the parser treat every response it parses from then on, including after `http_response_parser_reset`, as the response to a CONNECT request. ]*/
+TEST_FUNCTION(http_response_parser_set_connect_response_survives_reset)
+{
+    // arrange
+    HTTP_RESPONSE_PARSER_HANDLE parser = create_test_parser();
+    int result;
+    size_t bytes_consumed;
+    static const char headers[] = "HTTP/1.1 200 OK\r\nContent-Length: 3\r\n\r\n";
+    static const char response[] = "HTTP/1.1 200 OK\r\nContent-Length: 3\r\n\r\nabc";
+    http_response_parser_set_connect_response(parser);
+    http_response_parser_reset(parser);
+
+    // act
+    result = http_response_parser_parse(parser, (const unsigned char*)response, sizeof(response) - 1, &bytes_consumed);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, sizeof(headers) - 1, bytes_consumed);
+    ASSERT_ARE_EQUAL(size_t, 0, body_call_count);
+
+    // cleanup
+    http_response_parser_destroy(parser);
+}
+
+/* Tests_SRS_HTTP_RESPONSE_PARSER_01_037: [ If `http_response_parser` is NULL, `http_response_parser_set_connect_response` shall do nothing. ]*/
+TEST_FUNCTION(http_response_parser_set_connect_response_with_NULL_does_nothing)
+{
+    // arrange
+
+    // act
+    http_response_parser_set_connect_response(NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+END_TEST_SUITE(http_response_parser_ut)
@@ -0,0 +1,7 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+/* The response parser is not mocked in these tests, the real one is linked without going through gballoc */
+#define GBALLOC_H
+
+#include "http_response_parser.c"
@@ -116,11 +116,34 @@ void my_HTTPHeaders_Free(HTTP_HEADERS_HANDLE handle)
     free(handle);
 }
 
+HTTP_HEADERS_HANDLE my_HTTPHeaders_AllocInArena(ARENA_HANDLE arena)
+{
+    (void)arena;
+    return (HTTP_HEADERS_HANDLE)malloc(1);
+}
+
 BUFFER_HANDLE my_BUFFER_new(void)
 {
     return (BUFFER_HANDLE)malloc(1);
 }
 
+BUFFER_HANDLE my_BUFFER_new_in_arena(ARENA_HANDLE arena)
+{
+    (void)arena;
+    return (BUFFER_HANDLE)malloc(1);
+}
+
+ARENA_HANDLE my_ARENA_create(size_t block_size)
+{
+    (void)block_size;
+    return (ARENA_HANDLE)malloc(1);
+}
+
+void my_ARENA_destroy(ARENA_HANDLE arena)
+{
+    free(arena);
+}
+
 void my_BUFFER_delete(BUFFER_HANDLE handle)
 {
     free(handle);
@@ -443,6 +466,7 @@ TEST_SUITE_INITIALIZE(TestClassInitialize)
     REGISTER_UMOCK_ALIAS_TYPE(STRING_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(HTTP_HEADERS_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(HTTP_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ARENA_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(const unsigned char*, void*);
     REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
     REGISTER_GLOBAL_MOCK_HOOK(gballoc_realloc, my_gballoc_realloc);
@@ -451,11 +475,15 @@ TEST_SUITE_INITIALIZE(TestClassInitialize)
     REGISTER_GLOBAL_MOCK_HOOK(STRING_delete, my_STRING_delete);
     REGISTER_GLOBAL_MOCK_RETURN(STRING_c_str, TEST_HOSTNAME);
     REGISTER_GLOBAL_MOCK_HOOK(HTTPHeaders_Alloc, my_HTTPHeaders_Alloc);
+    REGISTER_GLOBAL_MOCK_HOOK(HTTPHeaders_AllocInArena, my_HTTPHeaders_AllocInArena);
     REGISTER_GLOBAL_MOCK_HOOK(HTTPHeaders_Free, my_HTTPHeaders_Free);
     REGISTER_GLOBAL_MOCK_RETURN(HTTPHeaders_AddHeaderNameValuePair, HTTP_HEADERS_OK);
     REGISTER_GLOBAL_MOCK_RETURN(HTTPHeaders_ReplaceHeaderNameValuePair, HTTP_HEADERS_OK);
     REGISTER_GLOBAL_MOCK_HOOK(BUFFER_new, my_BUFFER_new);
+    REGISTER_GLOBAL_MOCK_HOOK(BUFFER_new_in_arena, my_BUFFER_new_in_arena);
     REGISTER_GLOBAL_MOCK_HOOK(BUFFER_delete, my_BUFFER_delete);
+    REGISTER_GLOBAL_MOCK_HOOK(ARENA_create, my_ARENA_create);
+    REGISTER_GLOBAL_MOCK_HOOK(ARENA_destroy, my_ARENA_destroy);
     REGISTER_GLOBAL_MOCK_RETURN(BUFFER_u_char, TEST_BUFFER);
     REGISTER_GLOBAL_MOCK_RETURN(BUFFER_length, TEST_BUFFER_SIZE);
     REGISTER_GLOBAL_MOCK_HOOK(HTTPAPI_Init, my_HTTPAPI_Init);
@@ -541,6 +569,7 @@ TEST_FUNCTION(HTTPAPIEX_Create_with_NULL_name_fails)
 
 /*Tests_SRS_HTTPAPIEX_02_002: [Parameter hostName shall be saved.] */
 /*Tests_SRS_HTTPAPIEX_02_004: [Otherwise, HTTPAPIEX_Create shall return a HTTAPIEX_HANDLE suitable for further calls to the module.]*/
+/*Tests_SRS_HTTPAPIEX_01_001: [ HTTPAPIEX_Create shall create an arena by calling ARENA_create, the temporaries of HTTPAPIEX_ExecuteRequest are allocated from it. ]*/
 TEST_FUNCTION(HTTPAPIEX_Create_succeeds)
 {
     /// arrange
@@ -551,6 +580,8 @@ TEST_FUNCTION(HTTPAPIEX_Create_succeeds)
     STRICT_EXPECTED_CALL(VECTOR_create(IGNORED_NUM_ARG))
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_create(IGNORED_NUM_ARG));
+
     /// act
     HTTPAPIEX_HANDLE result = HTTPAPIEX_Create(TEST_HOSTNAME);
 
@@ -563,6 +594,7 @@ TEST_FUNCTION(HTTPAPIEX_Create_succeeds)
 }
 
 /*Tests_SRS_HTTPAPIEX_02_042: [HTTPAPIEX_Destroy shall free all the resources used by HTTAPIEX_HANDLE.] */
+/*Tests_SRS_HTTPAPIEX_01_006: [ HTTPAPIEX_Destroy shall destroy the arena by calling ARENA_destroy. ]*/
 TEST_FUNCTION(HTTPAPIEX_Destroy_frees_resources_1) /*this is destroy after created*/
 {
     /// arrange
@@ -578,6 +610,8 @@ TEST_FUNCTION(HTTPAPIEX_Destroy_frees_resources_1) /*this is destroy after creat
     STRICT_EXPECTED_CALL(VECTOR_destroy(IGNORED_PTR_ARG)) /*these are the options vector*/
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_destroy(IGNORED_PTR_ARG));
+
     STRICT_EXPECTED_CALL(gballoc_free(handle)); /*this is handle data*/
 
     /// act
@@ -613,6 +647,8 @@ TEST_FUNCTION(HTTPAPIEX_Destroy_frees_resources_2) /*this is destroy after setti
     STRICT_EXPECTED_CALL(VECTOR_destroy(IGNORED_PTR_ARG)) /*these are the options vector*/
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_destroy(IGNORED_PTR_ARG));
+
     STRICT_EXPECTED_CALL(gballoc_free(handle)); /*this is handle data*/
 
     /// act
@@ -652,6 +688,8 @@ TEST_FUNCTION(HTTPAPIEX_Destroy_frees_resources_3) /*this is destroy after havin
     STRICT_EXPECTED_CALL(VECTOR_destroy(IGNORED_PTR_ARG)) /*these are the options vector*/
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_destroy(IGNORED_PTR_ARG));
+
     STRICT_EXPECTED_CALL(gballoc_free(httpapiexhandle)); /*this is the handle*/
 
     /// act
@@ -735,6 +773,27 @@ TEST_FUNCTION(HTTPAPIEX_Create_fails_when_VECTOR_create_fails)
     ///destroy
 }
 
+/*Tests_SRS_HTTPAPIEX_01_002: [ If ARENA_create fails, HTTPAPIEX_Create shall fail and return NULL. ]*/
+TEST_FUNCTION(HTTPAPIEX_Create_fails_when_ARENA_create_fails)
+{
+    /// arrange
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(STRING_construct(TEST_HOSTNAME));
+    STRICT_EXPECTED_CALL(VECTOR_create(IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(ARENA_create(IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(VECTOR_destroy(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+    /// act
+    HTTPAPIEX_HANDLE result = HTTPAPIEX_Create(TEST_HOSTNAME);
+
+    /// assert
+    ASSERT_ARE_EQUAL(void_ptr, NULL, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
 /*Tests_SRS_HTTPAPIEX_02_006: [If parameter handle is NULL then HTTPAPIEX_ExecuteRequest shall fail and return HTTPAPIEX_INVALID_ARG.]*/
 TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_handle_fails)
 {
@@ -770,6 +829,7 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_fails_with_invalid_request_type)
 }
 
 /*Tests_SRS_HTTPAPIEX_02_023: [HTTPAPIEX_ExecuteRequest shall try to execute the HTTP call by ensuring the following API call sequence is respected:]*/
+/*Tests_SRS_HTTPAPIEX_01_004: [ After freeing the temporaries, if it created any, HTTPAPIEX_ExecuteRequest shall call ARENA_reset, so that the next request reuses their memory without allocating. ]*/
 TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_happy_path_with_all_non_NULL_parameters)
 {
     /// arrange
@@ -832,6 +892,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_relativePath_uses_empty)
     Content-Length:the size of the requestContent parameter, and use this instance to all the subsequent calls to HTTPAPI_ExecuteRequest as parameter httpHeadersHandle.] 
 */
 /*Tests_SRS_HTTPAPIEX_02_013: [If requestContent is NULL then HTTPAPIEX_ExecuteRequest shall behave as if a buffer of zero size would have been used, that is, it shall call HTTPAPI_ExecuteRequest with parameter content = NULL and contentLength = 0.]*/
+/*Tests_SRS_HTTPAPIEX_01_003: [ HTTPAPIEX_ExecuteRequest shall allocate its temporary HTTPHEADERS and BUFFER instances in the arena of the handle by calling HTTPHeaders_AllocInArena and BUFFER_new_in_arena. ]*/
+/*Tests_SRS_HTTPAPIEX_01_004: [ After freeing the temporaries, if it created any, HTTPAPIEX_ExecuteRequest shall call ARENA_reset, so that the next request reuses their memory without allocating. ]*/
 TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_request_headers_and_NULL_requestBody_succeeds)
 {
     /// arrange
@@ -844,9 +906,9 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_request_headers_and_NULL_reques
     createHttpObjects(&requestHttpHeaders, &responseHttpHeaders);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(BUFFER_new()); /*because it makes a fake buffer*/
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG)); /*because it makes a fake buffer*/
 
-    STRICT_EXPECTED_CALL(HTTPHeaders_Alloc()); /*because it makes fakes request headers*/
+    STRICT_EXPECTED_CALL(HTTPHeaders_AllocInArena(IGNORED_PTR_ARG)); /*because it makes fakes request headers*/
     /*this is building the host and content-length for the http request headers*/
     STRICT_EXPECTED_CALL(BUFFER_length(IGNORED_PTR_ARG))
         .IgnoreArgument(1).SetReturn(0);
@@ -893,6 +955,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_request_headers_and_NULL_reques
     STRICT_EXPECTED_CALL(HTTPHeaders_Free(IGNORED_PTR_ARG))
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, NULL, NULL, &httpStatusCode, responseHttpHeaders, responseHttpBody);
 
@@ -918,9 +982,9 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_request_headers_and_NULL_reques
     createHttpObjects(&requestHttpHeaders, &responseHttpHeaders);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(BUFFER_new()); /*because it makes a fake buffer*/
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG)); /*because it makes a fake buffer*/
 
-    STRICT_EXPECTED_CALL(HTTPHeaders_Alloc()); /*because it makes fakes request headers*/
+    STRICT_EXPECTED_CALL(HTTPHeaders_AllocInArena(IGNORED_PTR_ARG)); /*because it makes fakes request headers*/
     /*this is building the host and content-length for the http request headers*/
     STRICT_EXPECTED_CALL(BUFFER_length(IGNORED_PTR_ARG))
         .IgnoreArgument(1).SetReturn(0);
@@ -939,6 +1003,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_request_headers_and_NULL_reques
     STRICT_EXPECTED_CALL(BUFFER_delete(IGNORED_PTR_ARG))
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, NULL, NULL, &httpStatusCode, responseHttpHeaders, responseHttpBody);
 
@@ -964,9 +1030,9 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_request_headers_and_NULL_reques
     createHttpObjects(&requestHttpHeaders, &responseHttpHeaders);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(BUFFER_new()); /*because it makes a fake buffer*/
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG)); /*because it makes a fake buffer*/
 
-    STRICT_EXPECTED_CALL(HTTPHeaders_Alloc()); /*because it makes fakes request headers*/
+    STRICT_EXPECTED_CALL(HTTPHeaders_AllocInArena(IGNORED_PTR_ARG)); /*because it makes fakes request headers*/
     /*this is building the host and content-length for the http request headers*/
     STRICT_EXPECTED_CALL(BUFFER_length(IGNORED_PTR_ARG))
         .IgnoreArgument(1).SetReturn(TEST_BUFFER_SIZE);
@@ -983,6 +1049,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_request_headers_and_NULL_reques
     STRICT_EXPECTED_CALL(BUFFER_delete(IGNORED_PTR_ARG))
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, NULL, NULL, &httpStatusCode, responseHttpHeaders, responseHttpBody);
 
@@ -1008,14 +1076,16 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_request_headers_and_NULL_reques
     createHttpObjects(&requestHttpHeaders, &responseHttpHeaders);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(BUFFER_new()); /*because it makes a fake buffer*/
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG)); /*because it makes a fake buffer*/
 
-    STRICT_EXPECTED_CALL(HTTPHeaders_Alloc())
+    STRICT_EXPECTED_CALL(HTTPHeaders_AllocInArena(IGNORED_PTR_ARG))
         .SetReturn(NULL); /*because it makes fakes request headers*/
 
     STRICT_EXPECTED_CALL(BUFFER_delete(IGNORED_PTR_ARG))
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, NULL, NULL, &httpStatusCode, responseHttpHeaders, responseHttpBody);
 
@@ -1044,7 +1114,7 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_NULL_re
     createHttpObjects(&requestHttpHeaders, &responseHttpHeaders);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(BUFFER_new()); /*because it makes a fake buffer*/
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG)); /*because it makes a fake buffer*/
 
     /*this is building the host and content-length for the http request headers*/
     STRICT_EXPECTED_CALL(BUFFER_length(IGNORED_PTR_ARG))
@@ -1090,6 +1160,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_NULL_re
     STRICT_EXPECTED_CALL(BUFFER_delete(IGNORED_PTR_ARG))
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, requestHttpHeaders, NULL, &httpStatusCode, responseHttpHeaders, responseHttpBody);
 
@@ -1115,7 +1187,7 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_NULL_re
     createHttpObjects(&requestHttpHeaders, &responseHttpHeaders);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(BUFFER_new()); /*because it makes a fake buffer*/
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG)); /*because it makes a fake buffer*/
 
     /*this is building the host and content-length for the http request headers*/
     STRICT_EXPECTED_CALL(BUFFER_length(IGNORED_PTR_ARG))
@@ -1133,6 +1205,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_NULL_re
     STRICT_EXPECTED_CALL(BUFFER_delete(IGNORED_PTR_ARG))
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, requestHttpHeaders, NULL, &httpStatusCode, responseHttpHeaders, responseHttpBody);
 
@@ -1158,7 +1232,7 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_NULL_re
     createHttpObjects(&requestHttpHeaders, &responseHttpHeaders);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(BUFFER_new()); /*because it makes a fake buffer*/
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG)); /*because it makes a fake buffer*/
 
     /*this is building the host and content-length for the http request headers*/
     STRICT_EXPECTED_CALL(BUFFER_length(IGNORED_PTR_ARG))
@@ -1174,6 +1248,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_NULL_re
     STRICT_EXPECTED_CALL(BUFFER_delete(IGNORED_PTR_ARG))
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, requestHttpHeaders, NULL, &httpStatusCode, responseHttpHeaders, responseHttpBody);
 
@@ -1187,6 +1263,7 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_NULL_re
 }
 
 /*Tests_SRS_HTTPAPIEX_02_012: [If any of the operations required for SRS_HTTAPIEX_02_011 fails, then HTTPAPIEX_ExecuteRequest shall return HTTPAPIEX_ERROR.] */
+/*Tests_SRS_HTTPAPIEX_01_005: [ If building the temporaries fails, HTTPAPIEX_ExecuteRequest shall call ARENA_reset. ]*/
 TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_NULL_requestBody_fails_when_fake_requestbody_creation_fails)
 {
     /// arrange
@@ -1199,9 +1276,11 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_NULL_re
     createHttpObjects(&requestHttpHeaders, &responseHttpHeaders);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(BUFFER_new())
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG))
         .SetReturn(NULL); /*because it makes a fake buffer*/
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, requestHttpHeaders, NULL, &httpStatusCode, responseHttpHeaders, responseHttpBody);
 
@@ -1283,6 +1362,7 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_non_NUL
 }
 
 /*Tests_SRS_HTTPAPIEX_02_014: [If requestContent is not NULL then its content and its size shall be used for parameters content and contentLength of HTTPAPI_ExecuteRequest.] */
+/*Tests_SRS_HTTPAPIEX_01_005: [ If building the temporaries fails, HTTPAPIEX_ExecuteRequest shall call ARENA_reset. ]*/
 TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_non_NULL_requestBody_fails_when_HTTPHeaders_ReplaceHeaderNameValuePair_fails_1)
 {
     /// arrange
@@ -1309,6 +1389,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_non_NUL
         .IgnoreArgument(1)
         .SetReturn(HTTP_HEADERS_ERROR);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, requestHttpHeaders, requestHttpBody, &httpStatusCode, responseHttpHeaders, responseHttpBody);
 
@@ -1346,6 +1428,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_request_headers_and_non_NUL
         .IgnoreArgument(1)
         .SetReturn(HTTP_HEADERS_ERROR);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, requestHttpHeaders, requestHttpBody, &httpStatusCode, responseHttpHeaders, responseHttpBody);
 
@@ -1508,9 +1592,9 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_cleans_when_originalhttpbody_is_NULL_and_
     createHttpObjects(&requestHttpHeaders, &responseHttpHeaders);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(BUFFER_new()); /*because it makes a fake buffer*/
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG)); /*because it makes a fake buffer*/
 
-    STRICT_EXPECTED_CALL(HTTPHeaders_Alloc());
+    STRICT_EXPECTED_CALL(HTTPHeaders_AllocInArena(IGNORED_PTR_ARG));
 
     /*this is building the host and content-length for the http request headers*/
     STRICT_EXPECTED_CALL(BUFFER_length(IGNORED_PTR_ARG))
@@ -1525,7 +1609,7 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_cleans_when_originalhttpbody_is_NULL_and_
         .IgnoreArgument(1);
 
     /*Because it is creating fake response headers*/
-    STRICT_EXPECTED_CALL(HTTPHeaders_Alloc())
+    STRICT_EXPECTED_CALL(HTTPHeaders_AllocInArena(IGNORED_PTR_ARG))
         .SetReturn(NULL);
 
     STRICT_EXPECTED_CALL(BUFFER_delete(IGNORED_PTR_ARG))
@@ -1533,6 +1617,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_cleans_when_originalhttpbody_is_NULL_and_
     STRICT_EXPECTED_CALL(HTTPHeaders_Free(IGNORED_PTR_ARG))
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, NULL, NULL, &httpStatusCode, NULL, responseHttpBody);
 
@@ -1556,9 +1642,9 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_cleans_when_responsehttpbody_is_NULL_and_
     createHttpObjects(&requestHttpHeaders, &responseHttpHeaders);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(BUFFER_new()); /*because it makes a fake buffer*/
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG)); /*because it makes a fake buffer*/
 
-    STRICT_EXPECTED_CALL(HTTPHeaders_Alloc());
+    STRICT_EXPECTED_CALL(HTTPHeaders_AllocInArena(IGNORED_PTR_ARG));
 
     /*this is building the host and content-length for the http request headers*/
     STRICT_EXPECTED_CALL(BUFFER_length(IGNORED_PTR_ARG))
@@ -1573,9 +1659,9 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_cleans_when_responsehttpbody_is_NULL_and_
         .IgnoreArgument(1);
 
     /*Because it is creating fake response headers*/
-    STRICT_EXPECTED_CALL(HTTPHeaders_Alloc());
+    STRICT_EXPECTED_CALL(HTTPHeaders_AllocInArena(IGNORED_PTR_ARG));
 
-    STRICT_EXPECTED_CALL(BUFFER_new())
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG))
         .SetReturn(NULL); /*because it makes a fake buffer*/
 
     STRICT_EXPECTED_CALL(BUFFER_delete(IGNORED_PTR_ARG))
@@ -1585,6 +1671,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_cleans_when_responsehttpbody_is_NULL_and_
     STRICT_EXPECTED_CALL(HTTPHeaders_Free(IGNORED_PTR_ARG))
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, NULL, NULL, &httpStatusCode, NULL, NULL);
 
@@ -1625,7 +1713,7 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_response_headers_suceeds)
         .IgnoreArgument(1);
 
     /*Because it is creating fake response headers*/
-    STRICT_EXPECTED_CALL(HTTPHeaders_Alloc());
+    STRICT_EXPECTED_CALL(HTTPHeaders_AllocInArena(IGNORED_PTR_ARG));
 
     /*this is getting the buffer content and buffer length to pass to httpapi_executerequest*/
     STRICT_EXPECTED_CALL(HTTPAPI_Init());
@@ -1662,6 +1750,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_response_headers_suceeds)
     STRICT_EXPECTED_CALL(HTTPHeaders_Free(IGNORED_PTR_ARG))
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, requestHttpHeaders, requestHttpBody, &httpStatusCode, NULL, responseHttpBody);
 
@@ -1702,9 +1792,11 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_response_headers_fails_when_HTT
         .IgnoreArgument(1);
 
     /*Because it is creating fake response headers*/
-    STRICT_EXPECTED_CALL(HTTPHeaders_Alloc())
+    STRICT_EXPECTED_CALL(HTTPHeaders_AllocInArena(IGNORED_PTR_ARG))
         .SetReturn(NULL);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, requestHttpHeaders, requestHttpBody, &httpStatusCode, NULL, responseHttpBody);
 
@@ -1788,6 +1880,7 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_non_NULL_response_headers_suceeds)
 }
 
 /*Tests_SRS_HTTPAPIEX_02_020: [If responseContent is NULL then HTTPAPIEX_ExecuteRequest shall create a temporary internal BUFFER object and use that as parameter responseContent of HTTPAPI_ExecuteRequest call.] */
+/*Tests_SRS_HTTPAPIEX_01_004: [ After freeing the temporaries, if it created any, HTTPAPIEX_ExecuteRequest shall call ARENA_reset, so that the next request reuses their memory without allocating. ]*/
 TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_response_body_suceeds)
 {
     /// arrange
@@ -1813,7 +1906,7 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_response_body_suceeds)
     STRICT_EXPECTED_CALL(HTTPHeaders_ReplaceHeaderNameValuePair(IGNORED_PTR_ARG, "Content-Length", TOSTRING(TEST_BUFFER_SIZE)))
         .IgnoreArgument(1);
 
-    STRICT_EXPECTED_CALL(BUFFER_new()); /*because it makes a fake response buffer*/
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG)); /*because it makes a fake response buffer*/
 
     /*this is getting the buffer content and buffer length to pass to httpapi_executerequest*/
     STRICT_EXPECTED_CALL(HTTPAPI_Init());
@@ -1850,6 +1943,8 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_response_body_suceeds)
     STRICT_EXPECTED_CALL(BUFFER_delete(IGNORED_PTR_ARG))
         .IgnoreArgument(1);
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, requestHttpHeaders, requestHttpBody, &httpStatusCode, responseHttpHeaders, NULL);
 
@@ -1888,9 +1983,11 @@ TEST_FUNCTION(HTTPAPIEX_ExecuteRequest_with_NULL_fails_when_BUFFER_new_fails)
     STRICT_EXPECTED_CALL(HTTPHeaders_ReplaceHeaderNameValuePair(IGNORED_PTR_ARG, "Content-Length", TOSTRING(TEST_BUFFER_SIZE)))
         .IgnoreArgument(1);
 
-    STRICT_EXPECTED_CALL(BUFFER_new())
+    STRICT_EXPECTED_CALL(BUFFER_new_in_arena(IGNORED_PTR_ARG))
         .SetReturn(NULL); /*because it makes a fake response buffer*/
 
+    STRICT_EXPECTED_CALL(ARENA_reset(IGNORED_PTR_ARG));
+
     /// act
     HTTPAPIEX_RESULT result = HTTPAPIEX_ExecuteRequest(httpapiexhandle, HTTPAPI_REQUEST_PATCH, TEST_RELATIVE_PATH, requestHttpHeaders, requestHttpBody, &httpStatusCode, responseHttpHeaders, NULL);
 
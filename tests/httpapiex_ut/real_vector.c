@@ -6,12 +6,16 @@
 #define VECTOR_destroy real_VECTOR_destroy
 #define VECTOR_push_back real_VECTOR_push_back
 #define VECTOR_erase real_VECTOR_erase
+#define VECTOR_pop_back real_VECTOR_pop_back
 #define VECTOR_clear real_VECTOR_clear
 #define VECTOR_element real_VECTOR_element
 #define VECTOR_front real_VECTOR_front
 #define VECTOR_back real_VECTOR_back
 #define VECTOR_find_if real_VECTOR_find_if
 #define VECTOR_size real_VECTOR_size
+#define VECTOR_capacity real_VECTOR_capacity
+#define VECTOR_reserve real_VECTOR_reserve
+#define VECTOR_shrink_to_fit real_VECTOR_shrink_to_fit
 
 #define GBALLOC_H
 
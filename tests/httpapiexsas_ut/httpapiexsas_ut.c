@@ -50,14 +50,17 @@ void my_gballoc_free(void* ptr)
 #include "azure_c_shared_utility/agenttime.h"
 #include "azure_c_shared_utility/strings.h"
 #include "azure_c_shared_utility/buffer_.h"
+#include "azure_c_shared_utility/base64.h"
 #include "azure_c_shared_utility/sastoken.h"
 #include "azure_c_shared_utility/httpheaders.h"
 #include "azure_c_shared_utility/httpapiex.h"
 #include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/lock.h"
 
 #undef ENABLE_MOCKS
 
 #include "azure_c_shared_utility/httpapiexsas.h"
+#include "azure_c_shared_utility/shared_util_options.h"
 
 TEST_DEFINE_ENUM_TYPE(HTTPAPIEX_RESULT, HTTPAPIEX_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(HTTPAPIEX_RESULT, HTTPAPIEX_RESULT_VALUES);
@@ -65,6 +68,9 @@ IMPLEMENT_UMOCK_C_ENUM_TYPE(HTTPAPIEX_RESULT, HTTPAPIEX_RESULT_VALUES);
 TEST_DEFINE_ENUM_TYPE(HTTP_HEADERS_RESULT, HTTP_HEADERS_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(HTTP_HEADERS_RESULT, HTTP_HEADERS_RESULT_VALUES);
 
+TEST_DEFINE_ENUM_TYPE(LOCK_RESULT, LOCK_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(LOCK_RESULT, LOCK_RESULT_VALUES);
+
 #define TEST_STRING_HANDLE (STRING_HANDLE)0x46
 #define TEST_NULL_STRING_HANDLE (STRING_HANDLE)0x00
 #define TEST_KEYNAME_HANDLE (STRING_HANDLE)0x48
@@ -81,10 +87,16 @@ IMPLEMENT_UMOCK_C_ENUM_TYPE(HTTP_HEADERS_RESULT, HTTP_HEADERS_RESULT_VALUES);
 #define TEST_RESPONSE_CONTENT (BUFFER_HANDLE)0x59
 #define TEST_CONST_CHAR_STAR_NULL (const char*)NULL
 #define TEST_SASTOKEN_HANDLE (STRING_HANDLE)0x60
+#define TEST_SECOND_SASTOKEN_HANDLE (STRING_HANDLE)0x61
+#define TEST_DECODED_KEY_HANDLE (BUFFER_HANDLE)0x62
 #define TEST_EXPIRY ((size_t)7200)
 #define TEST_TIME_T ((time_t)-1)
+#define TEST_LOCK_HANDLE (LOCK_HANDLE)0x63
 
 static const char TEST_CHAR_ARRAY[10] = "ABCD";
+static const char TEST_KEY_STRING[] = "a2V5";
+static const char TEST_URIRESOURCE_STRING[] = "myhub.azure-devices.net/devices/mydevice";
+static const char TEST_KEYNAME_STRING[] = "iothubowner";
 
 static TEST_MUTEX_HANDLE g_testByTest;
 static TEST_MUTEX_HANDLE g_dllByDll;
@@ -100,11 +112,6 @@ void my_STRING_delete(STRING_HANDLE handle)
     free(handle);
 }
 
-STRING_HANDLE my_SASToken_Create(STRING_HANDLE key, STRING_HANDLE scope, STRING_HANDLE keyName, size_t expiry)
-{
-    (void)key, (void)scope, (void)keyName, (void)expiry;
-    return (STRING_HANDLE)malloc(1);
-}
 
 static void setupSAS_Create_happy_path(void)
 {
@@ -112,6 +119,33 @@ static void setupSAS_Create_happy_path(void)
     STRICT_EXPECTED_CALL(STRING_clone(TEST_KEY_HANDLE)).SetReturn(TEST_CLONED_KEY_HANDLE);
     STRICT_EXPECTED_CALL(STRING_clone(TEST_URIRESOURCE_HANDLE)).SetReturn(TEST_CLONED_URIRESOURCE_HANDLE);
     STRICT_EXPECTED_CALL(STRING_clone(TEST_KEYNAME_HANDLE)).SetReturn(TEST_CLONED_KEYNAME_HANDLE);
+    STRICT_EXPECTED_CALL(Lock_Init());
+}
+
+static void setup_generate_sas_token(time_t currentTime, STRING_HANDLE sasToken)
+{
+    STRICT_EXPECTED_CALL(HTTPHeaders_FindHeaderValue(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization")).SetReturn(TEST_CHAR_ARRAY);
+    STRICT_EXPECTED_CALL(get_time(NULL)).SetReturn(currentTime);
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_CLONED_KEY_HANDLE)).SetReturn(TEST_KEY_STRING);
+    STRICT_EXPECTED_CALL(Base64_Decoder(TEST_KEY_STRING)).SetReturn(TEST_DECODED_KEY_HANDLE);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_CLONED_URIRESOURCE_HANDLE)).SetReturn(TEST_URIRESOURCE_STRING);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_CLONED_KEYNAME_HANDLE)).SetReturn(TEST_KEYNAME_STRING);
+    STRICT_EXPECTED_CALL(SASToken_CreateWithDecodedKey(TEST_DECODED_KEY_HANDLE, TEST_URIRESOURCE_STRING, TEST_KEYNAME_STRING, (size_t)currentTime + 3600)).SetReturn(sasToken);
+}
+
+static HTTPAPIEX_SAS_HANDLE create_sas_handle_with_cached_token(void)
+{
+    HTTPAPIEX_SAS_HANDLE sasHandle;
+    unsigned int statusCode;
+
+    setupSAS_Create_happy_path();
+    sasHandle = HTTPAPIEX_SAS_Create(TEST_KEY_HANDLE, TEST_URIRESOURCE_HANDLE, TEST_KEYNAME_HANDLE);
+    setup_generate_sas_token((time_t)3600, TEST_SASTOKEN_HANDLE);
+    (void)HTTPAPIEX_SAS_ExecuteRequest(sasHandle, TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT);
+    umock_c_reset_all_calls();
+
+    return sasHandle;
 }
 
 DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
@@ -193,10 +227,13 @@ TEST_SUITE_INITIALIZE(TestClassInitialize)
     REGISTER_UMOCK_ALIAS_TYPE(HTTPAPIEX_HANDLE, void*);
     REGISTER_UMOCK_ALIAS_TYPE(BUFFER_HANDLE, void*);
     REGISTER_TYPE(HTTPAPI_REQUEST_TYPE, HTTPAPI_REQUEST_TYPE);
+    REGISTER_UMOCK_ALIAS_TYPE(LOCK_HANDLE, void*);
+    REGISTER_TYPE(LOCK_RESULT, LOCK_RESULT);
 
     REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
     REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
-    REGISTER_GLOBAL_MOCK_HOOK(SASToken_Create, my_SASToken_Create);
+    REGISTER_GLOBAL_MOCK_RETURN(Base64_Decoder, TEST_DECODED_KEY_HANDLE);
+    REGISTER_GLOBAL_MOCK_RETURN(SASToken_CreateWithDecodedKey, TEST_SASTOKEN_HANDLE);
 
     REGISTER_GLOBAL_MOCK_RETURN(STRING_c_str, TEST_CONST_CHAR_STAR_NULL);
     REGISTER_GLOBAL_MOCK_RETURN(STRING_length, 0);
@@ -205,6 +242,10 @@ TEST_SUITE_INITIALIZE(TestClassInitialize)
     REGISTER_GLOBAL_MOCK_RETURN(HTTPHeaders_FindHeaderValue, TEST_CONST_CHAR_STAR_NULL);
     REGISTER_GLOBAL_MOCK_RETURN(HTTPHeaders_ReplaceHeaderNameValuePair, HTTP_HEADERS_ERROR);
     REGISTER_GLOBAL_MOCK_RETURN(get_time, TEST_TIME_T);
+    REGISTER_GLOBAL_MOCK_RETURN(Lock_Init, TEST_LOCK_HANDLE);
+    REGISTER_GLOBAL_MOCK_RETURN(Lock, LOCK_OK);
+    REGISTER_GLOBAL_MOCK_RETURN(Unlock, LOCK_OK);
+    REGISTER_GLOBAL_MOCK_RETURN(Lock_Deinit, LOCK_OK);
 }
 
 TEST_SUITE_CLEANUP(TestClassCleanup)
@@ -248,6 +289,7 @@ TEST_FUNCTION(HTTPAPIEX_SAS_is_zero_the_epoch)
 }
 
 /*Tests_SRS_HTTPAPIEXSAS_01_001: [ HTTPAPIEX_SAS_Create shall create a new instance of HTTPAPIEX_SAS and return a non-NULL handle to it. ]*/
+/*Tests_SRS_HTTPAPIEXSAS_01_014: [ HTTPAPIEX_SAS_Create shall create a lock guarding the cached SAS token and the refresh margin by calling Lock_Init. ]*/
 TEST_FUNCTION(HTTPAPIEX_SAS_Create_Succeeds)
 {
     // arrange
@@ -386,7 +428,32 @@ TEST_FUNCTION(HTTPAPIEX_SAS_Create_third_string_clone_fails)
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
+/*Tests_SRS_HTTPAPIEXSAS_06_004: [If there are any other errors in the instantiation of this handle then HTTPAPIEX_SAS_Create shall return NULL.]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_Create_Lock_Init_fails)
+{
+    // arrange
+    HTTPAPIEX_SAS_HANDLE handle;
+
+    STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)).IgnoreArgument(1);
+    STRICT_EXPECTED_CALL(STRING_clone(TEST_KEY_HANDLE)).SetReturn(TEST_CLONED_KEY_HANDLE);
+    STRICT_EXPECTED_CALL(STRING_clone(TEST_URIRESOURCE_HANDLE)).SetReturn(TEST_CLONED_URIRESOURCE_HANDLE);
+    STRICT_EXPECTED_CALL(STRING_clone(TEST_KEYNAME_HANDLE)).SetReturn(TEST_CLONED_KEYNAME_HANDLE);
+    STRICT_EXPECTED_CALL(Lock_Init()).SetReturn((LOCK_HANDLE)NULL);
+    STRICT_EXPECTED_CALL(STRING_delete(TEST_CLONED_KEY_HANDLE));
+    STRICT_EXPECTED_CALL(STRING_delete(TEST_CLONED_URIRESOURCE_HANDLE));
+    STRICT_EXPECTED_CALL(STRING_delete(TEST_CLONED_KEYNAME_HANDLE));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)).IgnoreArgument(1);
+
+    // act
+    handle = HTTPAPIEX_SAS_Create(TEST_KEY_HANDLE, TEST_URIRESOURCE_HANDLE, TEST_KEYNAME_HANDLE);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    ASSERT_IS_NULL(handle);
+}
+
 /*Tests_SRS_HTTPAPIEXSAS_06_006: [HTTAPIEX_SAS_Destroy shall deallocate any structures denoted by the parameter handle.]*/
+/*Tests_SRS_HTTPAPIEXSAS_01_015: [ HTTAPIEX_SAS_Destroy shall free the lock by calling Lock_Deinit. ]*/
 TEST_FUNCTION(HTTPAPIEX_SAS_Destroy_frees_underlying_strings)
 {
     // arrange
@@ -399,6 +466,7 @@ TEST_FUNCTION(HTTPAPIEX_SAS_Destroy_frees_underlying_strings)
     STRICT_EXPECTED_CALL(STRING_delete(TEST_CLONED_KEY_HANDLE));
     STRICT_EXPECTED_CALL(STRING_delete(TEST_CLONED_URIRESOURCE_HANDLE));
     STRICT_EXPECTED_CALL(STRING_delete(TEST_CLONED_KEYNAME_HANDLE));
+    STRICT_EXPECTED_CALL(Lock_Deinit(TEST_LOCK_HANDLE));
     STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)).IgnoreArgument(1);
 
     // act
@@ -489,6 +557,36 @@ TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_findheadervalues_returns_null_
 }
 
 /*Tests_SRS_HTTPAPIEXSAS_06_018: [A value of type time_t that shall be known as currentTime is obtained from calling get_time.]*/
+/*Tests_SRS_HTTPAPIEXSAS_01_016: [ The cached SAS token shall only be read, generated and replaced while holding the lock. ]*/
+/*Tests_SRS_HTTPAPIEXSAS_01_017: [ If Lock fails then fallthrough. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_Lock_fails_succeeds)
+{
+
+    HTTPAPIEX_RESULT result;
+    unsigned int statusCode;
+    HTTPAPIEX_SAS_HANDLE sasHandle;
+
+    // arrange
+    setupSAS_Create_happy_path();
+    sasHandle = HTTPAPIEX_SAS_Create(TEST_KEY_HANDLE, TEST_URIRESOURCE_HANDLE, TEST_KEYNAME_HANDLE);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(HTTPHeaders_FindHeaderValue(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization")).SetReturn(TEST_CHAR_ARRAY);
+    STRICT_EXPECTED_CALL(get_time(NULL)).SetReturn((time_t)3600);
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE)).SetReturn(LOCK_ERROR);
+    STRICT_EXPECTED_CALL(HTTPAPIEX_ExecuteRequest(TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT)).SetReturn(HTTPAPIEX_OK);
+
+    // act
+    result = HTTPAPIEX_SAS_ExecuteRequest(sasHandle, TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT);
+
+    // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, result, HTTPAPIEX_OK);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // Cleanup
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+}
+
 /*Tests_SRS_HTTPAPIEXSAS_06_019: [If the value of currentTime is (time_t)-1 is then fallthrough.]*/
 TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_get_time_fails)
 {
@@ -517,9 +615,9 @@ TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_get_time_fails)
     HTTPAPIEX_SAS_Destroy(sasHandle);
 }
 
-/*Tests_SRS_HTTPAPIEXSAS_06_011: [SASToken_Create shall be invoked.]*/
-/*Tests_SRS_HTTPAPIEXSAS_06_012: [If the return result of SASToken_Create is NULL then fallthrough.]*/
-TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_sastoken_create_returns_null_succeeds)
+/*Tests_SRS_HTTPAPIEXSAS_01_008: [ The key shall be decoded by calling Base64_Decoder only the first time a SAS token is generated; the decoded key shall be kept for subsequent SAS token generations. ]*/
+/*Tests_SRS_HTTPAPIEXSAS_01_009: [ If Base64_Decoder fails, no new SAS token shall be generated. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_Base64_Decoder_fails_succeeds)
 {
 
     HTTPAPIEX_RESULT result;
@@ -532,8 +630,11 @@ TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_sastoken_create_returns_null_s
     umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(HTTPHeaders_FindHeaderValue(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization")).SetReturn(TEST_CHAR_ARRAY);
-    STRICT_EXPECTED_CALL(get_time(NULL)).SetReturn(3600);
-    STRICT_EXPECTED_CALL(SASToken_Create(TEST_CLONED_KEY_HANDLE, TEST_CLONED_URIRESOURCE_HANDLE, TEST_CLONED_KEYNAME_HANDLE, TEST_EXPIRY)).SetReturn(TEST_NULL_STRING_HANDLE);
+    STRICT_EXPECTED_CALL(get_time(NULL)).SetReturn((time_t)3600);
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_CLONED_KEY_HANDLE)).SetReturn(TEST_KEY_STRING);
+    STRICT_EXPECTED_CALL(Base64_Decoder(TEST_KEY_STRING)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
     STRICT_EXPECTED_CALL(HTTPAPIEX_ExecuteRequest(TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT)).SetReturn(HTTPAPIEX_OK);
 
     // act
@@ -547,9 +648,37 @@ TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_sastoken_create_returns_null_s
     HTTPAPIEX_SAS_Destroy(sasHandle);
 }
 
-/*Tests_SRS_HTTPAPIEXSAS_06_013: [HTTPHeaders_ReplaceHeaderNameValuePair shall be invoked with "Authorization" as its second argument and STRING_c_str (newSASToken) as its third argument.]*/
+/*Tests_SRS_HTTPAPIEXSAS_01_010: [ A new SAS token shall be generated by calling SASToken_CreateWithDecodedKey with the decoded key, the uri resource, the key name and an expiry of the current time plus 3600 seconds. ]*/
+/*Tests_SRS_HTTPAPIEXSAS_01_013: [ If there is no cached SAS token or the cached SAS token has already expired then fallthrough. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_sastoken_create_returns_null_succeeds)
+{
+
+    HTTPAPIEX_RESULT result;
+    unsigned int statusCode;
+    HTTPAPIEX_SAS_HANDLE sasHandle;
+
+    // arrange
+    setupSAS_Create_happy_path();
+    sasHandle = HTTPAPIEX_SAS_Create(TEST_KEY_HANDLE, TEST_URIRESOURCE_HANDLE, TEST_KEYNAME_HANDLE);
+    umock_c_reset_all_calls();
+
+    setup_generate_sas_token((time_t)3600, TEST_NULL_STRING_HANDLE);
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(HTTPAPIEX_ExecuteRequest(TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT)).SetReturn(HTTPAPIEX_OK);
+
+    // act
+    result = HTTPAPIEX_SAS_ExecuteRequest(sasHandle, TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT);
+
+    // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, result, HTTPAPIEX_OK);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // Cleanup
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+}
+
+/*Tests_SRS_HTTPAPIEXSAS_06_013: [HTTPHeaders_ReplaceHeaderNameValuePair shall be invoked with "Authorization" as its second argument and STRING_c_str of the cached SAS token as its third argument.]*/
 /*Tests_SRS_HTTPAPIEXSAS_06_014: [If the result of the invocation of HTTPHeaders_ReplaceHeaderNameValuePair is NOT HTTP_HEADERS_OK then fallthrough.]*/
-/*Tests_SRS_HTTPAPIEXSAS_06_015: [STRING_delete(newSASToken) will be invoked.]*/
 TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_replace_header_name_value_pair_fails_succeeds)
 {
 
@@ -562,12 +691,10 @@ TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_replace_header_name_value_pair
     sasHandle = HTTPAPIEX_SAS_Create(TEST_KEY_HANDLE, TEST_URIRESOURCE_HANDLE, TEST_KEYNAME_HANDLE);
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(HTTPHeaders_FindHeaderValue(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization")).SetReturn(TEST_CHAR_ARRAY);
-    STRICT_EXPECTED_CALL(get_time(NULL)).SetReturn(3600);
-    STRICT_EXPECTED_CALL(SASToken_Create(TEST_CLONED_KEY_HANDLE, TEST_CLONED_URIRESOURCE_HANDLE, TEST_CLONED_KEYNAME_HANDLE, TEST_EXPIRY)).SetReturn(TEST_SASTOKEN_HANDLE);
+    setup_generate_sas_token((time_t)3600, TEST_SASTOKEN_HANDLE);
     STRICT_EXPECTED_CALL(STRING_c_str(TEST_SASTOKEN_HANDLE)).SetReturn(TEST_CHAR_ARRAY);
     STRICT_EXPECTED_CALL(HTTPHeaders_ReplaceHeaderNameValuePair(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization", TEST_CHAR_ARRAY)).SetReturn(HTTP_HEADERS_ERROR);
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_SASTOKEN_HANDLE));
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
     STRICT_EXPECTED_CALL(HTTPAPIEX_ExecuteRequest(TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT)).SetReturn(HTTPAPIEX_OK);
 
     // act
@@ -594,20 +721,338 @@ TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_replace_header_name_value_pair
     sasHandle = HTTPAPIEX_SAS_Create(TEST_KEY_HANDLE, TEST_URIRESOURCE_HANDLE, TEST_KEYNAME_HANDLE);
     umock_c_reset_all_calls();
 
+    setup_generate_sas_token((time_t)3600, TEST_SASTOKEN_HANDLE);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SASTOKEN_HANDLE)).SetReturn(TEST_CHAR_ARRAY);
+    STRICT_EXPECTED_CALL(HTTPHeaders_ReplaceHeaderNameValuePair(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization", TEST_CHAR_ARRAY)).SetReturn(HTTP_HEADERS_OK);
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(HTTPAPIEX_ExecuteRequest(TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT)).SetReturn(HTTPAPIEX_OK);
+
+    // act
+    result = HTTPAPIEX_SAS_ExecuteRequest(sasHandle, TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT);
+
+    // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, result, HTTPAPIEX_OK);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // Cleanup
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+}
+
+/*Tests_SRS_HTTPAPIEXSAS_01_007: [ If a SAS token was generated by a previous call and it does not expire within the refresh margin, it shall be reused and no new SAS token shall be generated. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_reuses_the_cached_sas_token)
+{
+
+    HTTPAPIEX_RESULT result;
+    unsigned int statusCode;
+    HTTPAPIEX_SAS_HANDLE sasHandle;
+
+    // arrange
+    sasHandle = create_sas_handle_with_cached_token();
+
     STRICT_EXPECTED_CALL(HTTPHeaders_FindHeaderValue(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization")).SetReturn(TEST_CHAR_ARRAY);
-    STRICT_EXPECTED_CALL(get_time(NULL)).SetReturn((time_t)3600);
-    STRICT_EXPECTED_CALL(SASToken_Create(TEST_CLONED_KEY_HANDLE, TEST_CLONED_URIRESOURCE_HANDLE, TEST_CLONED_KEYNAME_HANDLE, TEST_EXPIRY)).SetReturn(TEST_SASTOKEN_HANDLE);
+    STRICT_EXPECTED_CALL(get_time(NULL)).SetReturn((time_t)6599);
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
     STRICT_EXPECTED_CALL(STRING_c_str(TEST_SASTOKEN_HANDLE)).SetReturn(TEST_CHAR_ARRAY);
     STRICT_EXPECTED_CALL(HTTPHeaders_ReplaceHeaderNameValuePair(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization", TEST_CHAR_ARRAY)).SetReturn(HTTP_HEADERS_OK);
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(HTTPAPIEX_ExecuteRequest(TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT)).SetReturn(HTTPAPIEX_OK);
+
+    // act
+    result = HTTPAPIEX_SAS_ExecuteRequest(sasHandle, TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT);
+
+    // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, result, HTTPAPIEX_OK);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // Cleanup
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+}
+
+/*Tests_SRS_HTTPAPIEXSAS_01_008: [ The key shall be decoded by calling Base64_Decoder only the first time a SAS token is generated; the decoded key shall be kept for subsequent SAS token generations. ]*/
+/*Tests_SRS_HTTPAPIEXSAS_01_012: [ The newly generated SAS token shall replace the cached SAS token, which shall be freed with STRING_delete. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_within_the_refresh_margin_generates_a_new_sas_token)
+{
+
+    HTTPAPIEX_RESULT result;
+    unsigned int statusCode;
+    HTTPAPIEX_SAS_HANDLE sasHandle;
+
+    // arrange
+    sasHandle = create_sas_handle_with_cached_token();
+
+    STRICT_EXPECTED_CALL(HTTPHeaders_FindHeaderValue(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization")).SetReturn(TEST_CHAR_ARRAY);
+    STRICT_EXPECTED_CALL(get_time(NULL)).SetReturn((time_t)6600);
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_CLONED_URIRESOURCE_HANDLE)).SetReturn(TEST_URIRESOURCE_STRING);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_CLONED_KEYNAME_HANDLE)).SetReturn(TEST_KEYNAME_STRING);
+    STRICT_EXPECTED_CALL(SASToken_CreateWithDecodedKey(TEST_DECODED_KEY_HANDLE, TEST_URIRESOURCE_STRING, TEST_KEYNAME_STRING, (size_t)10200)).SetReturn(TEST_SECOND_SASTOKEN_HANDLE);
     STRICT_EXPECTED_CALL(STRING_delete(TEST_SASTOKEN_HANDLE));
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SECOND_SASTOKEN_HANDLE)).SetReturn(TEST_CHAR_ARRAY);
+    STRICT_EXPECTED_CALL(HTTPHeaders_ReplaceHeaderNameValuePair(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization", TEST_CHAR_ARRAY)).SetReturn(HTTP_HEADERS_OK);
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
     STRICT_EXPECTED_CALL(HTTPAPIEX_ExecuteRequest(TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT)).SetReturn(HTTPAPIEX_OK);
 
     // act
     result = HTTPAPIEX_SAS_ExecuteRequest(sasHandle, TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT);
 
     // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, result, HTTPAPIEX_OK);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // Cleanup
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+}
+
+/*Tests_SRS_HTTPAPIEXSAS_01_011: [ If SASToken_CreateWithDecodedKey fails, the previously cached SAS token (if any) shall be kept. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_refresh_fails_uses_the_cached_sas_token)
+{
+
+    HTTPAPIEX_RESULT result;
+    unsigned int statusCode;
+    HTTPAPIEX_SAS_HANDLE sasHandle;
+
+    // arrange
+    sasHandle = create_sas_handle_with_cached_token();
+
+    STRICT_EXPECTED_CALL(HTTPHeaders_FindHeaderValue(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization")).SetReturn(TEST_CHAR_ARRAY);
+    STRICT_EXPECTED_CALL(get_time(NULL)).SetReturn((time_t)6600);
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_CLONED_URIRESOURCE_HANDLE)).SetReturn(TEST_URIRESOURCE_STRING);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_CLONED_KEYNAME_HANDLE)).SetReturn(TEST_KEYNAME_STRING);
+    STRICT_EXPECTED_CALL(SASToken_CreateWithDecodedKey(TEST_DECODED_KEY_HANDLE, TEST_URIRESOURCE_STRING, TEST_KEYNAME_STRING, (size_t)10200)).SetReturn(TEST_NULL_STRING_HANDLE);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SASTOKEN_HANDLE)).SetReturn(TEST_CHAR_ARRAY);
+    STRICT_EXPECTED_CALL(HTTPHeaders_ReplaceHeaderNameValuePair(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization", TEST_CHAR_ARRAY)).SetReturn(HTTP_HEADERS_OK);
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(HTTPAPIEX_ExecuteRequest(TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT)).SetReturn(HTTPAPIEX_OK);
+
+    // act
+    result = HTTPAPIEX_SAS_ExecuteRequest(sasHandle, TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT);
+
+    // assert
     ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, result, HTTPAPIEX_OK);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // Cleanup
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+}
+
+/*Tests_SRS_HTTPAPIEXSAS_01_013: [ If there is no cached SAS token or the cached SAS token has already expired then fallthrough. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_invoke_executerequest_refresh_fails_with_expired_cached_sas_token_succeeds)
+{
+
+    HTTPAPIEX_RESULT result;
+    unsigned int statusCode;
+    HTTPAPIEX_SAS_HANDLE sasHandle;
+
+    // arrange
+    sasHandle = create_sas_handle_with_cached_token();
+
+    STRICT_EXPECTED_CALL(HTTPHeaders_FindHeaderValue(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization")).SetReturn(TEST_CHAR_ARRAY);
+    STRICT_EXPECTED_CALL(get_time(NULL)).SetReturn((time_t)7200);
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_CLONED_URIRESOURCE_HANDLE)).SetReturn(TEST_URIRESOURCE_STRING);
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_CLONED_KEYNAME_HANDLE)).SetReturn(TEST_KEYNAME_STRING);
+    STRICT_EXPECTED_CALL(SASToken_CreateWithDecodedKey(TEST_DECODED_KEY_HANDLE, TEST_URIRESOURCE_STRING, TEST_KEYNAME_STRING, (size_t)10800)).SetReturn(TEST_NULL_STRING_HANDLE);
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(HTTPAPIEX_ExecuteRequest(TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT)).SetReturn(HTTPAPIEX_OK);
+
+    // act
+    result = HTTPAPIEX_SAS_ExecuteRequest(sasHandle, TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT);
+
+    // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, result, HTTPAPIEX_OK);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // Cleanup
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+}
+
+/*Tests_SRS_HTTPAPIEXSAS_06_006: [HTTAPIEX_SAS_Destroy shall deallocate any structures denoted by the parameter handle.]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_Destroy_frees_the_cached_sas_token_and_decoded_key)
+{
+    // arrange
+    HTTPAPIEX_SAS_HANDLE sasHandle = create_sas_handle_with_cached_token();
+
+    STRICT_EXPECTED_CALL(STRING_delete(TEST_CLONED_KEY_HANDLE));
+    STRICT_EXPECTED_CALL(STRING_delete(TEST_CLONED_URIRESOURCE_HANDLE));
+    STRICT_EXPECTED_CALL(STRING_delete(TEST_CLONED_KEYNAME_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODED_KEY_HANDLE));
+    STRICT_EXPECTED_CALL(STRING_delete(TEST_SASTOKEN_HANDLE));
+    STRICT_EXPECTED_CALL(Lock_Deinit(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG)).IgnoreArgument(1);
+
+    // act
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/* HTTPAPIEX_SAS_SetOption */
+
+/*Tests_SRS_HTTPAPIEXSAS_01_002: [ If sasHandle, optionName or value is NULL, HTTPAPIEX_SAS_SetOption shall fail and return HTTPAPIEX_INVALID_ARG. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_SetOption_with_NULL_handle_fails)
+{
+    // arrange
+    size_t refreshMargin = 60;
+    HTTPAPIEX_RESULT result;
+
+    // act
+    result = HTTPAPIEX_SAS_SetOption(NULL, OPTION_SAS_TOKEN_REFRESH_MARGIN, &refreshMargin);
+
+    // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, HTTPAPIEX_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
+
+/*Tests_SRS_HTTPAPIEXSAS_01_002: [ If sasHandle, optionName or value is NULL, HTTPAPIEX_SAS_SetOption shall fail and return HTTPAPIEX_INVALID_ARG. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_SetOption_with_NULL_optionName_fails)
+{
+    // arrange
+    size_t refreshMargin = 60;
+    HTTPAPIEX_RESULT result;
+    HTTPAPIEX_SAS_HANDLE sasHandle;
+
+    setupSAS_Create_happy_path();
+    sasHandle = HTTPAPIEX_SAS_Create(TEST_KEY_HANDLE, TEST_URIRESOURCE_HANDLE, TEST_KEYNAME_HANDLE);
+    umock_c_reset_all_calls();
+
+    // act
+    result = HTTPAPIEX_SAS_SetOption(sasHandle, NULL, &refreshMargin);
+
+    // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, HTTPAPIEX_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // Cleanup
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+}
+
+/*Tests_SRS_HTTPAPIEXSAS_01_002: [ If sasHandle, optionName or value is NULL, HTTPAPIEX_SAS_SetOption shall fail and return HTTPAPIEX_INVALID_ARG. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_SetOption_with_NULL_value_fails)
+{
+    // arrange
+    HTTPAPIEX_RESULT result;
+    HTTPAPIEX_SAS_HANDLE sasHandle;
+
+    setupSAS_Create_happy_path();
+    sasHandle = HTTPAPIEX_SAS_Create(TEST_KEY_HANDLE, TEST_URIRESOURCE_HANDLE, TEST_KEYNAME_HANDLE);
+    umock_c_reset_all_calls();
+
+    // act
+    result = HTTPAPIEX_SAS_SetOption(sasHandle, OPTION_SAS_TOKEN_REFRESH_MARGIN, NULL);
+
+    // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, HTTPAPIEX_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // Cleanup
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+}
+
+/*Tests_SRS_HTTPAPIEXSAS_01_006: [ If optionName is not a known option, HTTPAPIEX_SAS_SetOption shall fail and return HTTPAPIEX_INVALID_ARG. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_SetOption_with_unknown_option_fails)
+{
+    // arrange
+    size_t refreshMargin = 60;
+    HTTPAPIEX_RESULT result;
+    HTTPAPIEX_SAS_HANDLE sasHandle;
+
+    setupSAS_Create_happy_path();
+    sasHandle = HTTPAPIEX_SAS_Create(TEST_KEY_HANDLE, TEST_URIRESOURCE_HANDLE, TEST_KEYNAME_HANDLE);
+    umock_c_reset_all_calls();
+
+    // act
+    result = HTTPAPIEX_SAS_SetOption(sasHandle, "unknown_option", &refreshMargin);
+
+    // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, HTTPAPIEX_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // Cleanup
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+}
+
+/*Tests_SRS_HTTPAPIEXSAS_01_004: [ If the refresh margin is not smaller than the SAS token lifetime of 3600 seconds, HTTPAPIEX_SAS_SetOption shall fail and return HTTPAPIEX_INVALID_ARG. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_SetOption_with_refresh_margin_equal_to_token_lifetime_fails)
+{
+    // arrange
+    size_t refreshMargin = 3600;
+    HTTPAPIEX_RESULT result;
+    HTTPAPIEX_SAS_HANDLE sasHandle;
+
+    setupSAS_Create_happy_path();
+    sasHandle = HTTPAPIEX_SAS_Create(TEST_KEY_HANDLE, TEST_URIRESOURCE_HANDLE, TEST_KEYNAME_HANDLE);
+    umock_c_reset_all_calls();
+
+    // act
+    result = HTTPAPIEX_SAS_SetOption(sasHandle, OPTION_SAS_TOKEN_REFRESH_MARGIN, &refreshMargin);
+
+    // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, HTTPAPIEX_INVALID_ARG, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // Cleanup
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+}
+
+/*Tests_SRS_HTTPAPIEXSAS_01_019: [ If Lock fails, HTTPAPIEX_SAS_SetOption shall fail and return HTTPAPIEX_ERROR. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_SetOption_when_Lock_fails_fails)
+{
+    // arrange
+    size_t refreshMargin = 60;
+    HTTPAPIEX_RESULT result;
+    HTTPAPIEX_SAS_HANDLE sasHandle;
+
+    setupSAS_Create_happy_path();
+    sasHandle = HTTPAPIEX_SAS_Create(TEST_KEY_HANDLE, TEST_URIRESOURCE_HANDLE, TEST_KEYNAME_HANDLE);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE)).SetReturn(LOCK_ERROR);
+
+    // act
+    result = HTTPAPIEX_SAS_SetOption(sasHandle, OPTION_SAS_TOKEN_REFRESH_MARGIN, &refreshMargin);
+
+    // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, HTTPAPIEX_ERROR, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // Cleanup
+    HTTPAPIEX_SAS_Destroy(sasHandle);
+}
+
+/*Tests_SRS_HTTPAPIEXSAS_01_003: [ The option OPTION_SAS_TOKEN_REFRESH_MARGIN shall take a pointer to a size_t holding the number of seconds before expiry at which a cached SAS token is regenerated. ]*/
+/*Tests_SRS_HTTPAPIEXSAS_01_005: [ On success HTTPAPIEX_SAS_SetOption shall return HTTPAPIEX_OK. ]*/
+/*Tests_SRS_HTTPAPIEXSAS_01_018: [ The refresh margin shall be updated while holding the lock. ]*/
+TEST_FUNCTION(HTTPAPIEX_SAS_SetOption_refresh_margin_is_used_for_the_cached_sas_token)
+{
+    // arrange
+    size_t refreshMargin = 60;
+    unsigned int statusCode;
+    HTTPAPIEX_RESULT result;
+    HTTPAPIEX_SAS_HANDLE sasHandle = create_sas_handle_with_cached_token();
+
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+    // act
+    result = HTTPAPIEX_SAS_SetOption(sasHandle, OPTION_SAS_TOKEN_REFRESH_MARGIN, &refreshMargin);
+
+    // assert
+    ASSERT_ARE_EQUAL(HTTPAPIEX_RESULT, HTTPAPIEX_OK, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    umock_c_reset_all_calls();
+
+    // with the default margin of 600 seconds this would have refreshed the token
+    STRICT_EXPECTED_CALL(HTTPHeaders_FindHeaderValue(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization")).SetReturn(TEST_CHAR_ARRAY);
+    STRICT_EXPECTED_CALL(get_time(NULL)).SetReturn((time_t)7000);
+    STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SASTOKEN_HANDLE)).SetReturn(TEST_CHAR_ARRAY);
+    STRICT_EXPECTED_CALL(HTTPHeaders_ReplaceHeaderNameValuePair(TEST_REQUEST_HTTP_HEADERS_HANDLE, "Authorization", TEST_CHAR_ARRAY)).SetReturn(HTTP_HEADERS_OK);
+    STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+    STRICT_EXPECTED_CALL(HTTPAPIEX_ExecuteRequest(TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT)).SetReturn(HTTPAPIEX_OK);
+    (void)HTTPAPIEX_SAS_ExecuteRequest(sasHandle, TEST_HTTPAPIEX_HANDLE, TEST_HTTPAPI_REQUEST_TYPE, TEST_CHAR_ARRAY, TEST_REQUEST_HTTP_HEADERS_HANDLE, TEST_REQUEST_CONTENT, &statusCode, TEST_RESPONSE_HTTP_HEADERS_HANDLE, TEST_RESPONSE_CONTENT);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // Cleanup
     HTTPAPIEX_SAS_Destroy(sasHandle);
@@ -90,6 +90,26 @@ void my_Map_Destroy(MAP_HANDLE handle)
     free(handle);
 }
 
+MAP_HANDLE my_Map_CreateInArena(ARENA_HANDLE arena, MAP_FILTER_CALLBACK mapFilterFunc)
+{
+    (void)arena;
+    (void)mapFilterFunc;
+    return (MAP_HANDLE)malloc(1);
+}
+
+/*the arena mocks hand out heap memory, what is tested is that the handle comes from the arena*/
+void* my_ARENA_malloc(ARENA_HANDLE arena, size_t size)
+{
+    (void)arena;
+    return malloc(size);
+}
+
+void my_ARENA_free(ARENA_HANDLE arena, void* ptr)
+{
+    (void)arena;
+    free(ptr);
+}
+
 #include "azure_c_shared_utility/gballoc.h"
 
 #undef ENABLE_MOCKS
@@ -124,6 +144,18 @@ static char tempBuffer[TEMP_BUFFER_SIZE];
 
 #define MAX_NAME_VALUE_PAIR 100
 
+static const ARENA_HANDLE TEST_ARENA = (ARENA_HANDLE)0x4242;
+
+/*the module only looks at the names and values in the map when the hash of a name matches*/
+static void setup_Map_GetInternals(const char** keys, const char** values, size_t count)
+{
+    STRICT_EXPECTED_CALL(Map_GetInternals(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG))
+        .IgnoreArgument(1)
+        .CopyOutArgumentBuffer(2, &keys, sizeof(keys))
+        .CopyOutArgumentBuffer(3, &values, sizeof(values))
+        .CopyOutArgumentBuffer(4, &count, sizeof(count));
+}
+
 static TEST_MUTEX_HANDLE g_dllByDll;
 
 DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
@@ -154,10 +186,14 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             REGISTER_TYPE(MAP_RESULT, MAP_RESULT);
             REGISTER_UMOCK_ALIAS_TYPE(MAP_FILTER_CALLBACK, void*);
             REGISTER_UMOCK_ALIAS_TYPE(MAP_HANDLE, void*);
+            REGISTER_UMOCK_ALIAS_TYPE(ARENA_HANDLE, void*);
 
             REGISTER_GLOBAL_MOCK_HOOK(Map_Create, my_Map_Create);
             REGISTER_GLOBAL_MOCK_HOOK(Map_Clone, my_Map_Clone);
             REGISTER_GLOBAL_MOCK_HOOK(Map_Destroy, my_Map_Destroy);
+            REGISTER_GLOBAL_MOCK_HOOK(Map_CreateInArena, my_Map_CreateInArena);
+            REGISTER_GLOBAL_MOCK_HOOK(ARENA_malloc, my_ARENA_malloc);
+            REGISTER_GLOBAL_MOCK_HOOK(ARENA_free, my_ARENA_free);
             REGISTER_GLOBAL_MOCK_RETURN(Map_AddOrUpdate, MAP_OK);
             REGISTER_GLOBAL_MOCK_RETURN(Map_GetValueFromKey, VALUE1);
             REGISTER_GLOBAL_MOCK_RETURN(Map_GetInternals, MAP_OK);
@@ -287,6 +323,114 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
         }
 
+        /*Tests_SRS_HTTP_HEADERS_01_001: [ If arena is NULL, HTTPHeaders_AllocInArena shall fail and return NULL. ]*/
+        TEST_FUNCTION(HTTPHeaders_AllocInArena_with_NULL_arena_fails)
+        {
+            ///arrange
+
+            ///act
+            HTTP_HEADERS_HANDLE handle = HTTPHeaders_AllocInArena(NULL);
+
+            ///assert
+            ASSERT_IS_NULL(handle);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_002: [ HTTPHeaders_AllocInArena shall allocate the handle with ARENA_malloc and its headers with Map_CreateInArena, so that no header added later is allocated from the heap. ]*/
+        TEST_FUNCTION(HTTPHeaders_AllocInArena_allocates_from_the_arena)
+        {
+            ///arrange
+            STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG));
+            STRICT_EXPECTED_CALL(Map_CreateInArena(TEST_ARENA, IGNORED_PTR_ARG));
+
+            ///act
+            HTTP_HEADERS_HANDLE handle = HTTPHeaders_AllocInArena(TEST_ARENA);
+
+            ///assert
+            ASSERT_IS_NOT_NULL(handle);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            /// cleanup
+            HTTPHeaders_Free(handle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_003: [ If any of these fails, HTTPHeaders_AllocInArena shall return NULL. ]*/
+        TEST_FUNCTION(HTTPHeaders_AllocInArena_fails_when_ARENA_malloc_fails)
+        {
+            ///arrange
+            STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG))
+                .SetReturn(NULL);
+
+            ///act
+            HTTP_HEADERS_HANDLE handle = HTTPHeaders_AllocInArena(TEST_ARENA);
+
+            ///assert
+            ASSERT_IS_NULL(handle);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_003: [ If any of these fails, HTTPHeaders_AllocInArena shall return NULL. ]*/
+        TEST_FUNCTION(HTTPHeaders_AllocInArena_fails_when_Map_CreateInArena_fails)
+        {
+            ///arrange
+            STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG));
+            STRICT_EXPECTED_CALL(Map_CreateInArena(TEST_ARENA, IGNORED_PTR_ARG))
+                .SetReturn(NULL);
+            STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, IGNORED_PTR_ARG));
+
+            ///act
+            HTTP_HEADERS_HANDLE handle = HTTPHeaders_AllocInArena(TEST_ARENA);
+
+            ///assert
+            ASSERT_IS_NULL(handle);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_004: [ For a handle created by HTTPHeaders_AllocInArena, HTTPHeaders_Free shall give the memory back to the arena, which reclaims it when it is reset. ]*/
+        TEST_FUNCTION(HTTPHeaders_Free_with_handle_in_an_arena_gives_the_memory_back_to_the_arena)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE handle = HTTPHeaders_AllocInArena(TEST_ARENA);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_Destroy(IGNORED_PTR_ARG));
+            STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, handle));
+
+            ///act
+            HTTPHeaders_Free(handle);
+
+            ///assert
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_005: [ HTTPHeaders_Clone shall always allocate the clone from the heap, also when handle was created in an arena. ]*/
+        TEST_FUNCTION(HTTPHeaders_Clone_of_a_handle_in_an_arena_allocates_from_the_heap)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE handle = HTTPHeaders_AllocInArena(TEST_ARENA);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+            STRICT_EXPECTED_CALL(Map_Clone(IGNORED_PTR_ARG));
+
+            ///act
+            HTTP_HEADERS_HANDLE clone = HTTPHeaders_Clone(handle);
+
+            ///assert
+            ASSERT_IS_NOT_NULL(clone);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            /*the clone goes back to the heap*/
+            umock_c_reset_all_calls();
+            STRICT_EXPECTED_CALL(Map_Destroy(IGNORED_PTR_ARG));
+            STRICT_EXPECTED_CALL(gballoc_free(clone));
+            HTTPHeaders_Free(clone);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            /// cleanup
+            HTTPHeaders_Free(handle);
+        }
+
         /*Tests_SRS_HTTP_HEADERS_99_004:[ After a successful init, HTTPHeaders_GetHeaderCount shall report 0 existing headers.]*/
         TEST_FUNCTION(HTTPHeaders_Alloc_succeeds_and_GetHeaderCount_returns_0)
         {
@@ -320,9 +464,8 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist*/
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1); /*the index of the names*/
 
             STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, NAME1, VALUE1))
                 .IgnoreArgument(1);
@@ -347,10 +490,8 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist*/
-
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
 
             STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, NAME1, VALUE1))
                 .IgnoreArgument(1)
@@ -376,9 +517,8 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist*/
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
 
             STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, NAME1, VALUE1))
                 .IgnoreArgument(1);
@@ -452,15 +592,12 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
+            const char* keys[1] = { NAME1 };
+            const char* values[1] = { VALUE1 };
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn(VALUE1);
+            setup_Map_GetInternals(keys, values, 1);
 
             STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
                 .IgnoreArgument(1);
@@ -487,15 +624,12 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
+            const char* keys[1] = { NAME1 };
+            const char* values[1] = { VALUE1 };
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn(VALUE1);
+            setup_Map_GetInternals(keys, values, 1);
 
             STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
                 .IgnoreArgument(1);
@@ -523,15 +657,12 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
+            const char* keys[1] = { NAME1 };
+            const char* values[1] = { VALUE1 };
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn(VALUE1);
+            setup_Map_GetInternals(keys, values, 1);
 
             whenShallmalloc_fail = currentmalloc_call + 1;
             STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
@@ -553,16 +684,10 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME2))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
-
+            /*the hash of NAME2 is different, so NAME1 is not looked at*/
             STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, NAME2, VALUE2))
                 .IgnoreArgument(1);
 
@@ -582,15 +707,8 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, "ab"))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, "ab", VALUE1);
             umock_c_reset_all_calls();
-            
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, "a"))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
 
             STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, "a", VALUE1))
                 .IgnoreArgument(1);
@@ -643,14 +761,12 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
+            const char* keys[1] = { NAME1 };
+            const char* values[1] = { VALUE1 };
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1);
+            setup_Map_GetInternals(keys, values, 1);
 
             ///act
             const char* res1 = HTTPHeaders_FindHeaderValue(httpHandle, NAME1);
@@ -669,22 +785,14 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
+            const char* keys[2] = { NAME1, NAME2 };
+            const char* values[2] = { VALUE1, VALUE2 };
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME2))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME2, VALUE2);
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn(VALUE1);
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME2))
-                .IgnoreArgument(1)
-                .SetReturn(VALUE2);
+            setup_Map_GetInternals(keys, values, 2);
+            setup_Map_GetInternals(keys, values, 2);
 
             ///act
             const char* res1 = HTTPHeaders_FindHeaderValue(httpHandle, NAME1);
@@ -704,19 +812,15 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         TEST_FUNCTION(HTTPHeaders_FindHeaderValue_retrieves_concatenation_of_previously_stored_values_for_header_name_succeeds)
         {
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
+            const char* keys[1] = { NAME1 };
+            const char* values[1] = { VALUE1 };
+            const char* concatenatedValues[1] = { VALUE1 ", " VALUE2 };
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn(VALUE1); /*this key exists, was added above*/
+            setup_Map_GetInternals(keys, values, 1); /*this key exists, was added above*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE2);
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn(VALUE1 ", " VALUE2);
+            setup_Map_GetInternals(keys, concatenatedValues, 1);
 
             ///act
             const char* res = HTTPHeaders_FindHeaderValue(httpHandle, NAME1);
@@ -735,16 +839,9 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME2))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL);
-
             ///act
             const char* res2 = HTTPHeaders_FindHeaderValue(httpHandle, NAME2);
 
@@ -762,22 +859,9 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1_TRICK1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL);
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1_TRICK2))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL);
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1_TRICK3))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL);
-
             ///act
             const char* res1 = HTTPHeaders_FindHeaderValue(httpHandle, NAME1_TRICK1);
             const char* res2 = HTTPHeaders_FindHeaderValue(httpHandle, NAME1_TRICK2);
@@ -798,15 +882,12 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
+            const char* keys[1] = { NAME1 };
+            const char* values[1] = { VALUE1 };
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn(VALUE1); /*this key does not exist, the line below is adding it*/
+            setup_Map_GetInternals(keys, values, 1);
 
             STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, NAME1, VALUE2))
                 .IgnoreArgument(1);
@@ -829,9 +910,8 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL);
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
 
             STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, NAME1, VALUE2))
                 .IgnoreArgument(1);
@@ -886,9 +966,6 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
             size_t nHeaders;
             const char* keys[] = { "NAME1" }; 
@@ -947,13 +1024,7 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME2))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME2, VALUE2);
             size_t nHeaders;
             const char* keys[2] = { "NAME1", "NAME2" };
@@ -1002,9 +1073,6 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
             umock_c_reset_all_calls();
 
@@ -1053,9 +1121,6 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
             const char* keys[1] = { "NAME1" };
             const char* values[1] = { "VALUE1" };
@@ -1088,9 +1153,6 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, "a"))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, "a", "b");
             umock_c_reset_all_calls();
             char* headerValue;
@@ -1127,9 +1189,6 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, "a"))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, "a", "b");
             umock_c_reset_all_calls();
             char* headerValue;
@@ -1162,9 +1221,6 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         {
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, "a"))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, "a", "b");
             umock_c_reset_all_calls();
             char* headerValue;
@@ -1220,9 +1276,6 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             ///arrange
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
             char* headerValue;
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, "a"))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist, the line below is adding it*/
             (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, "a", ":");
             const char* keys[1] = { "a" };
             const char** pKeys = &keys[0];
@@ -1289,9 +1342,8 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
             umock_c_reset_all_calls();
 
-            STRICT_EXPECTED_CALL(Map_GetValueFromKey(IGNORED_PTR_ARG, NAME1))
-                .IgnoreArgument(1)
-                .SetReturn((const char*)NULL); /*this key does not exist*/
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
 
             STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, NAME1, VALUE1))
                 .IgnoreArgument(1);
@@ -1323,6 +1375,8 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         }
 
         /*Tests_SRS_HTTP_HEADERS_02_004: [Otherwise HTTPHeaders_Clone shall clone the content of handle to a new handle.*/
+        /*Tests_SRS_HTTP_HEADERS_01_006: [ Otherwise HTTPHeaders_Clone shall not copy the headers, the clone shall share them with handle and count its reference to them. ]*/
+        /*Tests_SRS_HTTP_HEADERS_01_007: [ The first time the headers of handle are shared, HTTPHeaders_Clone shall allocate their reference count with malloc. ]*/
         TEST_FUNCTION(HTTPHEADERS_Clone_happy_path)
         {
             ///arrange
@@ -1331,7 +1385,7 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
 
             STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
                 .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(Map_Clone(IGNORED_PTR_ARG))
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
                 .IgnoreArgument(1);
 
             ///act
@@ -1346,8 +1400,32 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             HTTPHeaders_Free(result);
         }
 
+        /*Tests_SRS_HTTP_HEADERS_01_006: [ Otherwise HTTPHeaders_Clone shall not copy the headers, the clone shall share them with handle and count its reference to them. ]*/
+        TEST_FUNCTION(HTTPHEADERS_Clone_of_shared_headers_only_allocates_the_handle)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE source = HTTPHeaders_Alloc();
+            HTTP_HEADERS_HANDLE first = HTTPHeaders_Clone(source);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
+
+            ///act
+            HTTP_HEADERS_HANDLE result = HTTPHeaders_Clone(first);
+
+            ///assert
+            ASSERT_IS_NOT_NULL(result);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(source);
+            HTTPHeaders_Free(first);
+            HTTPHeaders_Free(result);
+        }
+
         /*Tests_SRS_HTTP_HEADERS_02_005: [If cloning fails for any reason, then HTTPHeaders_Clone shall return NULL.] */
-        TEST_FUNCTION(HTTPHEADERS_Clone_fails_when_map_clone_fails)
+        TEST_FUNCTION(HTTPHEADERS_Clone_fails_when_allocating_the_reference_count_fails)
         {
             ///arrange
             HTTP_HEADERS_HANDLE source = HTTPHeaders_Alloc();
@@ -1355,7 +1433,7 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
 
             STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
                 .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(Map_Clone(IGNORED_PTR_ARG))
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
                 .IgnoreArgument(1).SetReturn(NULL);
 
             STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
@@ -1373,6 +1451,32 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
             HTTPHeaders_Free(result);
         }
 
+        /*Tests_SRS_HTTP_HEADERS_02_005: [If cloning fails for any reason, then HTTPHeaders_Clone shall return NULL.] */
+        TEST_FUNCTION(HTTPHEADERS_Clone_of_a_handle_in_an_arena_fails_when_map_clone_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE source = HTTPHeaders_AllocInArena(TEST_ARENA);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(Map_Clone(IGNORED_PTR_ARG))
+                .IgnoreArgument(1).SetReturn(NULL);
+
+            STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+
+            ///act
+            HTTP_HEADERS_HANDLE result = HTTPHeaders_Clone(source);
+
+            ///assert
+            ASSERT_IS_NULL(result);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(source);
+        }
+
         /*Tests_SRS_HTTP_HEADERS_02_005: [If cloning fails for any reason, then HTTPHeaders_Clone shall return NULL.] */
         TEST_FUNCTION(HTTPHEADERS_Clone_fails_when_gballoc_fails)
         {
@@ -1396,4 +1500,640 @@ BEGIN_TEST_SUITE(HTTPHeaders_UnitTests)
         }
 
 
+        /*Tests_SRS_HTTP_HEADERS_01_008: [ HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair called on a handle whose headers are shared shall first make a copy of the headers of their own by calling Map_Clone, so that no other handle observes the change. ]*/
+        TEST_FUNCTION(HTTPHeaders_AddHeaderNameValuePair_on_a_clone_copies_the_shared_headers_first)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE source = HTTPHeaders_Alloc();
+            HTTP_HEADERS_HANDLE clone = HTTPHeaders_Clone(source);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_Clone(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, NAME1, VALUE1))
+                .IgnoreArgument(1);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_AddHeaderNameValuePair(clone, NAME1, VALUE1);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_OK, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(source);
+            HTTPHeaders_Free(clone);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_008: [ HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair called on a handle whose headers are shared shall first make a copy of the headers of their own by calling Map_Clone, so that no other handle observes the change. ]*/
+        TEST_FUNCTION(HTTPHeaders_ReplaceHeaderNameValuePair_on_a_cloned_handle_copies_the_shared_headers_first)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE source = HTTPHeaders_Alloc();
+            HTTP_HEADERS_HANDLE clone = HTTPHeaders_Clone(source);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_Clone(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, NAME1, VALUE2))
+                .IgnoreArgument(1);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_ReplaceHeaderNameValuePair(source, NAME1, VALUE2);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_OK, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(source);
+            HTTPHeaders_Free(clone);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_008: [ HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair called on a handle whose headers are shared shall first make a copy of the headers of their own by calling Map_Clone, so that no other handle observes the change. ]*/
+        TEST_FUNCTION(HTTPHeaders_AddHeaderNameValuePair_after_the_copy_does_not_copy_again)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE source = HTTPHeaders_Alloc();
+            HTTP_HEADERS_HANDLE clone = HTTPHeaders_Clone(source);
+            (void)HTTPHeaders_AddHeaderNameValuePair(clone, NAME1, VALUE1);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, NAME2, VALUE2))
+                .IgnoreArgument(1);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_AddHeaderNameValuePair(clone, NAME2, VALUE2);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_OK, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(source);
+            HTTPHeaders_Free(clone);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_009: [ If Map_Clone fails, HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair shall return HTTP_HEADERS_ALLOC_FAILED and leave the handle unchanged. ]*/
+        TEST_FUNCTION(HTTPHeaders_AddHeaderNameValuePair_on_a_clone_fails_when_Map_Clone_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE source = HTTPHeaders_Alloc();
+            HTTP_HEADERS_HANDLE clone = HTTPHeaders_Clone(source);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_Clone(IGNORED_PTR_ARG))
+                .IgnoreArgument(1)
+                .SetReturn(NULL);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_AddHeaderNameValuePair(clone, NAME1, VALUE1);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_ALLOC_FAILED, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(source);
+            HTTPHeaders_Free(clone);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_010: [ HTTPHeaders_Free of a handle whose headers are shared shall release its reference to them and destroy them with Map_Destroy only if it was the last reference. ]*/
+        TEST_FUNCTION(HTTPHeaders_Free_of_a_clone_keeps_the_shared_headers)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE source = HTTPHeaders_Alloc();
+            HTTP_HEADERS_HANDLE clone = HTTPHeaders_Clone(source);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(gballoc_free(clone));
+
+            ///act
+            HTTPHeaders_Free(clone);
+
+            ///assert
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(source);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_010: [ HTTPHeaders_Free of a handle whose headers are shared shall release its reference to them and destroy them with Map_Destroy only if it was the last reference. ]*/
+        TEST_FUNCTION(HTTPHeaders_Free_of_the_last_handle_sharing_the_headers_destroys_them)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE source = HTTPHeaders_Alloc();
+            HTTP_HEADERS_HANDLE clone = HTTPHeaders_Clone(source);
+            HTTPHeaders_Free(source);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_Destroy(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_free(clone));
+
+            ///act
+            HTTPHeaders_Free(clone);
+
+            ///assert
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_012: [ HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair shall look for an existing header with the same name regardless of case, through a hash index of the lower case names that does not compare the name with any header whose hash is different. ]*/
+        /*Tests_SRS_HTTP_HEADERS_01_014: [ The value of an existing header shall be stored under the name it was first added with. ]*/
+        TEST_FUNCTION(HTTPHeaders_AddHeaderNameValuePair_with_the_name_in_another_case_appends_to_the_existing_header)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            const char* keys[1] = { "Content-Type" };
+            const char* values[1] = { VALUE1 };
+            (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, "Content-Type", VALUE1);
+            umock_c_reset_all_calls();
+
+            setup_Map_GetInternals(keys, values, 1);
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, "Content-Type", VALUE1 ", " VALUE2))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_AddHeaderNameValuePair(httpHandle, "content-TYPE", VALUE2);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_OK, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_014: [ The value of an existing header shall be stored under the name it was first added with. ]*/
+        TEST_FUNCTION(HTTPHeaders_ReplaceHeaderNameValuePair_with_the_name_in_another_case_replaces_the_existing_header)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            const char* keys[1] = { "Content-Length" };
+            const char* values[1] = { "0" };
+            (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, "Content-Length", "0");
+            umock_c_reset_all_calls();
+
+            setup_Map_GetInternals(keys, values, 1);
+            STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, "Content-Length", "42"))
+                .IgnoreArgument(1);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_ReplaceHeaderNameValuePair(httpHandle, "CONTENT-LENGTH", "42");
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_OK, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_013: [ If Map_GetInternals fails, HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair shall return HTTP_HEADERS_ERROR. ]*/
+        TEST_FUNCTION(HTTPHeaders_AddHeaderNameValuePair_fails_when_Map_GetInternals_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_GetInternals(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG))
+                .IgnoreAllArguments()
+                .SetReturn(MAP_ERROR);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE2);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_ERROR, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_016: [ If allocating the index fails, HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair shall return HTTP_HEADERS_ALLOC_FAILED. ]*/
+        TEST_FUNCTION(HTTPHeaders_AddHeaderNameValuePair_fails_when_allocating_the_index_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1)
+                .SetReturn(NULL);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_ALLOC_FAILED, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_015: [ Before adding a header with a new name, HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair shall make room for it in the index, allocating a larger index when it would be more than 3/4 full. ]*/
+        TEST_FUNCTION(HTTPHeaders_AddHeaderNameValuePair_grows_the_index_when_it_is_3_4_full)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            const char* keys[13] = { "h0", "h1", "h2", "h3", "h4", "h5", "h6", "h7", "h8", "h9", "h10", "h11", "h12" };
+            const char* values[13] = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "10", "11", "12" };
+            size_t i;
+            for (i = 0; i < 12; i++)
+            {
+                (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, keys[i], values[i]);
+            }
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, "h12", "12"))
+                .IgnoreArgument(1);
+            setup_Map_GetInternals(keys, values, 13);
+            setup_Map_GetInternals(keys, values, 13);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_AddHeaderNameValuePair(httpHandle, "h12", "12");
+            const char* value3 = HTTPHeaders_FindHeaderValue(httpHandle, "H3");
+            const char* value12 = HTTPHeaders_FindHeaderValue(httpHandle, "h12");
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_OK, res);
+            ASSERT_ARE_EQUAL(char_ptr, "3", value3);
+            ASSERT_ARE_EQUAL(char_ptr, "12", value12);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_017: [ HTTPHeaders_FindHeaderValue shall find the header regardless of the case of name, through the hash index of the lower case names. ]*/
+        TEST_FUNCTION(HTTPHeaders_FindHeaderValue_with_the_name_in_another_case_finds_the_header)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            const char* keys[2] = { "Authorization", "Transfer-Encoding" };
+            const char* values[2] = { "SharedAccessSignature sr=x", "chunked" };
+            (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, keys[0], values[0]);
+            (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, keys[1], values[1]);
+            umock_c_reset_all_calls();
+
+            setup_Map_GetInternals(keys, values, 2);
+            setup_Map_GetInternals(keys, values, 2);
+
+            ///act
+            const char* res1 = HTTPHeaders_FindHeaderValue(httpHandle, "transfer-encoding");
+            const char* res2 = HTTPHeaders_FindHeaderValue(httpHandle, "AUTHORIZATION");
+            const char* res3 = HTTPHeaders_FindHeaderValue(httpHandle, "Content-Type");
+
+            ///assert
+            ASSERT_ARE_EQUAL(char_ptr, "chunked", res1);
+            ASSERT_ARE_EQUAL(char_ptr, "SharedAccessSignature sr=x", res2);
+            ASSERT_IS_NULL(res3);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_018: [ If Map_GetInternals fails, HTTPHeaders_FindHeaderValue shall return NULL. ]*/
+        TEST_FUNCTION(HTTPHeaders_FindHeaderValue_returns_NULL_when_Map_GetInternals_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            (void)HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_GetInternals(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG))
+                .IgnoreAllArguments()
+                .SetReturn(MAP_ERROR);
+
+            ///act
+            const char* res = HTTPHeaders_FindHeaderValue(httpHandle, NAME1);
+
+            ///assert
+            ASSERT_IS_NULL(res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_002: [ HTTPHeaders_AllocInArena shall allocate the handle with ARENA_malloc and its headers with Map_CreateInArena, so that no header added later is allocated from the heap. ]*/
+        TEST_FUNCTION(HTTPHeaders_AddHeaderNameValuePair_to_a_handle_in_an_arena_allocates_the_index_from_the_arena)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_AllocInArena(TEST_ARENA);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG))
+                .IgnoreArgument(2);
+            STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, NAME1, VALUE1))
+                .IgnoreArgument(1);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_AddHeaderNameValuePair(httpHandle, NAME1, VALUE1);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_OK, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            /*the index goes back to the arena with the handle*/
+            umock_c_reset_all_calls();
+            STRICT_EXPECTED_CALL(Map_Destroy(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, IGNORED_PTR_ARG))
+                .IgnoreArgument(2);
+            STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, httpHandle));
+            HTTPHeaders_Free(httpHandle);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_011: [ For a handle created in an arena, HTTPHeaders_Clone shall copy the headers by calling Map_Clone, since they do not outlive ARENA_reset. ]*/
+        TEST_FUNCTION(HTTPHeaders_Clone_of_a_handle_in_an_arena_copies_the_index_to_the_heap)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE source = HTTPHeaders_AllocInArena(TEST_ARENA);
+            (void)HTTPHeaders_AddHeaderNameValuePair(source, NAME1, VALUE1);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(Map_Clone(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
+
+            ///act
+            HTTP_HEADERS_HANDLE result = HTTPHeaders_Clone(source);
+
+            ///assert
+            ASSERT_IS_NOT_NULL(result);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(result);
+            HTTPHeaders_Free(source);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_02_005: [If cloning fails for any reason, then HTTPHeaders_Clone shall return NULL.] */
+        TEST_FUNCTION(HTTPHeaders_Clone_of_a_handle_in_an_arena_fails_when_copying_the_index_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE source = HTTPHeaders_AllocInArena(TEST_ARENA);
+            (void)HTTPHeaders_AddHeaderNameValuePair(source, NAME1, VALUE1);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(Map_Clone(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1)
+                .SetReturn(NULL);
+            STRICT_EXPECTED_CALL(Map_Destroy(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+
+            ///act
+            HTTP_HEADERS_HANDLE result = HTTPHeaders_Clone(source);
+
+            ///assert
+            ASSERT_IS_NULL(result);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(source);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_008: [ HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair called on a handle whose headers are shared shall first make a copy of the headers of their own by calling Map_Clone, so that no other handle observes the change. ]*/
+        TEST_FUNCTION(HTTPHeaders_ReplaceHeaderNameValuePair_on_a_clone_copies_the_shared_index_with_the_headers)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE source = HTTPHeaders_Alloc();
+            HTTP_HEADERS_HANDLE clone;
+            const char* keys[1] = { NAME1 };
+            const char* values[1] = { VALUE1 };
+            (void)HTTPHeaders_AddHeaderNameValuePair(source, NAME1, VALUE1);
+            clone = HTTPHeaders_Clone(source);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_Clone(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1);
+            setup_Map_GetInternals(keys, values, 1);
+            STRICT_EXPECTED_CALL(Map_AddOrUpdate(IGNORED_PTR_ARG, NAME1, VALUE2))
+                .IgnoreArgument(1);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_ReplaceHeaderNameValuePair(clone, NAME1, VALUE2);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_OK, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(source);
+            HTTPHeaders_Free(clone);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_009: [ If Map_Clone fails, HTTPHeaders_AddHeaderNameValuePair and HTTPHeaders_ReplaceHeaderNameValuePair shall return HTTP_HEADERS_ALLOC_FAILED and leave the handle unchanged. ]*/
+        TEST_FUNCTION(HTTPHeaders_ReplaceHeaderNameValuePair_on_a_clone_fails_when_copying_the_index_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE source = HTTPHeaders_Alloc();
+            HTTP_HEADERS_HANDLE clone;
+            (void)HTTPHeaders_AddHeaderNameValuePair(source, NAME1, VALUE1);
+            clone = HTTPHeaders_Clone(source);
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_Clone(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+            STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+                .IgnoreArgument(1)
+                .SetReturn(NULL);
+            STRICT_EXPECTED_CALL(Map_Destroy(IGNORED_PTR_ARG))
+                .IgnoreArgument(1);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_ReplaceHeaderNameValuePair(clone, NAME1, VALUE2);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_ALLOC_FAILED, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(source);
+            HTTPHeaders_Free(clone);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_019: [ If handle or headerLength is NULL, HTTPHeaders_GetHeaderInto shall return HTTP_HEADERS_INVALID_ARG. ]*/
+        TEST_FUNCTION(HTTPHeaders_GetHeaderInto_with_NULL_handle_fails)
+        {
+            ///arrange
+            size_t headerLength;
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_GetHeaderInto(NULL, 0, tempBuffer, sizeof(tempBuffer), &headerLength);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_INVALID_ARG, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_019: [ If handle or headerLength is NULL, HTTPHeaders_GetHeaderInto shall return HTTP_HEADERS_INVALID_ARG. ]*/
+        TEST_FUNCTION(HTTPHeaders_GetHeaderInto_with_NULL_headerLength_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            umock_c_reset_all_calls();
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_GetHeaderInto(httpHandle, 0, tempBuffer, sizeof(tempBuffer), NULL);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_INVALID_ARG, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_020: [ If Map_GetInternals fails, HTTPHeaders_GetHeaderInto shall return HTTP_HEADERS_ERROR. ]*/
+        TEST_FUNCTION(HTTPHeaders_GetHeaderInto_fails_when_Map_GetInternals_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            size_t headerLength;
+            umock_c_reset_all_calls();
+
+            STRICT_EXPECTED_CALL(Map_GetInternals(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG))
+                .IgnoreAllArguments()
+                .SetReturn(MAP_ERROR);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_GetHeaderInto(httpHandle, 0, tempBuffer, sizeof(tempBuffer), &headerLength);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_ERROR, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_021: [ If index is not smaller than the number of stored headers, HTTPHeaders_GetHeaderInto shall return HTTP_HEADERS_INVALID_ARG. ]*/
+        TEST_FUNCTION(HTTPHeaders_GetHeaderInto_with_index_too_big_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            const char* keys[1] = { NAME1 };
+            const char* values[1] = { VALUE1 };
+            size_t headerLength;
+            umock_c_reset_all_calls();
+
+            setup_Map_GetInternals(keys, values, 1);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_GetHeaderInto(httpHandle, 1, tempBuffer, sizeof(tempBuffer), &headerLength);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_INVALID_ARG, res);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_022: [ HTTPHeaders_GetHeaderInto shall set *headerLength to the length of name+": "+value of the index header, not including the null terminator. ]*/
+        /*Tests_SRS_HTTP_HEADERS_01_023: [ If destination is NULL or destinationSize is not larger than *headerLength, HTTPHeaders_GetHeaderInto shall return HTTP_HEADERS_INSUFFICIENT_BUFFER. ]*/
+        TEST_FUNCTION(HTTPHeaders_GetHeaderInto_with_NULL_destination_reports_the_length)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            const char* keys[1] = { NAME1 };
+            const char* values[1] = { VALUE1 };
+            size_t headerLength = 0;
+            umock_c_reset_all_calls();
+
+            setup_Map_GetInternals(keys, values, 1);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_GetHeaderInto(httpHandle, 0, NULL, 0, &headerLength);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_INSUFFICIENT_BUFFER, res);
+            ASSERT_ARE_EQUAL(size_t, strlen(HEADER1), headerLength);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_023: [ If destination is NULL or destinationSize is not larger than *headerLength, HTTPHeaders_GetHeaderInto shall return HTTP_HEADERS_INSUFFICIENT_BUFFER. ]*/
+        TEST_FUNCTION(HTTPHeaders_GetHeaderInto_with_no_room_for_the_null_terminator_fails)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            const char* keys[1] = { NAME1 };
+            const char* values[1] = { VALUE1 };
+            size_t headerLength = 0;
+            umock_c_reset_all_calls();
+
+            setup_Map_GetInternals(keys, values, 1);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_GetHeaderInto(httpHandle, 0, tempBuffer, strlen(HEADER1), &headerLength);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_INSUFFICIENT_BUFFER, res);
+            ASSERT_ARE_EQUAL(size_t, strlen(HEADER1), headerLength);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
+        /*Tests_SRS_HTTP_HEADERS_01_024: [ Otherwise HTTPHeaders_GetHeaderInto shall write the null terminated name+": "+value to destination without allocating any memory and return HTTP_HEADERS_OK. ]*/
+        TEST_FUNCTION(HTTPHeaders_GetHeaderInto_writes_the_header_without_allocating)
+        {
+            ///arrange
+            HTTP_HEADERS_HANDLE httpHandle = HTTPHeaders_Alloc();
+            const char* keys[2] = { NAME1, NAME2 };
+            const char* values[2] = { VALUE1, VALUE2 };
+            size_t headerLength = 0;
+            umock_c_reset_all_calls();
+
+            setup_Map_GetInternals(keys, values, 2);
+
+            ///act
+            HTTP_HEADERS_RESULT res = HTTPHeaders_GetHeaderInto(httpHandle, 1, tempBuffer, strlen(HEADER2) + 1, &headerLength);
+
+            ///assert
+            ASSERT_ARE_EQUAL(HTTP_HEADERS_RESULT, HTTP_HEADERS_OK, res);
+            ASSERT_ARE_EQUAL(size_t, strlen(HEADER2), headerLength);
+            ASSERT_ARE_EQUAL(char_ptr, HEADER2, tempBuffer);
+            ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+            ///cleanup
+            HTTPHeaders_Free(httpHandle);
+        }
+
 END_TEST_SUITE(HTTPHeaders_UnitTests)
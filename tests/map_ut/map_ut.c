@@ -6,6 +6,7 @@
 #else
 #include <stdlib.h>
 #endif
+#include <string.h>
 
 #include "azure_c_shared_utility/optimize_size.h"
 
@@ -76,9 +77,8 @@ static TEST_MUTEX_HANDLE g_dllByDll;
 
 #include "azure_c_shared_utility/strings.h"
 
-STRING_HANDLE my_STRING_construct(const char* psz)
+STRING_HANDLE my_STRING_new(void)
 {
-    (void)psz;
     return (STRING_HANDLE)malloc(1);
 }
 
@@ -87,10 +87,33 @@ void my_STRING_delete(STRING_HANDLE handle)
     free(handle);
 }
 
-STRING_HANDLE my_STRING_new_JSON(const char* source)
+#include "azure_c_shared_utility/arena.h"
+
+/*the arena mocks hand out heap memory, what is tested is that an arena map takes all its memory from the arena*/
+void* my_ARENA_malloc(ARENA_HANDLE arena, size_t size)
 {
-    (void)source;
-    return (STRING_HANDLE)malloc(1);
+    (void)arena;
+    return malloc(size);
+}
+
+void* my_ARENA_realloc(ARENA_HANDLE arena, void* ptr, size_t size)
+{
+    (void)arena;
+    return realloc(ptr, size);
+}
+
+void my_ARENA_free(ARENA_HANDLE arena, void* ptr)
+{
+    (void)arena;
+    free(ptr);
+}
+
+char* my_ARENA_strdup(ARENA_HANDLE arena, const char* source)
+{
+    char* result = (char*)malloc(strlen(source) + 1);
+    (void)arena;
+    (void)strcpy(result, source);
+    return result;
 }
 
 #include "azure_c_shared_utility/gballoc.h"
@@ -147,6 +170,8 @@ static const char* TEST_BLUEVALUE = "cyan";
 static const char* TEST_GREENKEY = "testgreenkey";
 static const char* TEST_GREENVALUE = "green";
 
+static const ARENA_HANDLE TEST_ARENA = (ARENA_HANDLE)0x4242;
+
 DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
 
 static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
@@ -173,13 +198,17 @@ BEGIN_TEST_SUITE(map_unittests)
 
         REGISTER_UMOCK_ALIAS_TYPE(MAP_HANDLE, void*);
         REGISTER_UMOCK_ALIAS_TYPE(STRING_HANDLE, void*);
+        REGISTER_UMOCK_ALIAS_TYPE(ARENA_HANDLE, void*);
 
         REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
         REGISTER_GLOBAL_MOCK_HOOK(gballoc_realloc, my_gballoc_realloc);
         REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
-        REGISTER_GLOBAL_MOCK_HOOK(STRING_construct, my_STRING_construct);
+        REGISTER_GLOBAL_MOCK_HOOK(STRING_new, my_STRING_new);
         REGISTER_GLOBAL_MOCK_HOOK(STRING_delete, my_STRING_delete);
-        REGISTER_GLOBAL_MOCK_HOOK(STRING_new_JSON, my_STRING_new_JSON);
+        REGISTER_GLOBAL_MOCK_HOOK(ARENA_malloc, my_ARENA_malloc);
+        REGISTER_GLOBAL_MOCK_HOOK(ARENA_realloc, my_ARENA_realloc);
+        REGISTER_GLOBAL_MOCK_HOOK(ARENA_free, my_ARENA_free);
+        REGISTER_GLOBAL_MOCK_HOOK(ARENA_strdup, my_ARENA_strdup);
     }
 
     TEST_SUITE_CLEANUP(TestClassCleanup)
@@ -358,6 +387,167 @@ BEGIN_TEST_SUITE(map_unittests)
         ///cleanup
     }
 
+    /*Tests_SRS_MAP_01_002: [ If arena is NULL, Map_CreateInArena shall fail and return NULL. ]*/
+    TEST_FUNCTION(Map_CreateInArena_with_NULL_arena_fails)
+    {
+        ///arrange
+        ///act
+        MAP_HANDLE handle = Map_CreateInArena(NULL, NULL);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_MAP_01_003: [ Map_CreateInArena shall create a new, empty map as Map_Create does, with the map and all the keys and values later added to it allocated from arena. ]*/
+    TEST_FUNCTION(Map_CreateInArena_allocates_the_map_from_the_arena)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG));
+
+        ///act
+        MAP_HANDLE handle = Map_CreateInArena(TEST_ARENA, NULL);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_01_003: [ Map_CreateInArena shall create a new, empty map as Map_Create does, with the map and all the keys and values later added to it allocated from arena. ]*/
+    TEST_FUNCTION(Map_Add_on_a_map_in_an_arena_allocates_from_the_arena)
+    {
+        ///arrange
+        const char*const* keys;
+        const char*const* values;
+        size_t count;
+        MAP_HANDLE handle = Map_CreateInArena(TEST_ARENA, NULL);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(ARENA_realloc(TEST_ARENA, NULL, sizeof(char*))); /*keys*/
+        STRICT_EXPECTED_CALL(ARENA_realloc(TEST_ARENA, NULL, sizeof(char*))); /*values*/
+        STRICT_EXPECTED_CALL(ARENA_strdup(TEST_ARENA, TEST_REDKEY));
+        STRICT_EXPECTED_CALL(ARENA_strdup(TEST_ARENA, TEST_REDVALUE));
+
+        ///act
+        MAP_RESULT result = Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, Map_GetInternals(handle, &keys, &values, &count));
+        ASSERT_ARE_EQUAL(size_t, 1, count);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDKEY, keys[0]);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, values[0]);
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_01_003: [ Map_CreateInArena shall create a new, empty map as Map_Create does, with the map and all the keys and values later added to it allocated from arena. ]*/
+    TEST_FUNCTION(Map_AddOrUpdate_on_a_map_in_an_arena_reallocates_the_value_from_the_arena)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateInArena(TEST_ARENA, NULL);
+        (void)Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(ARENA_realloc(TEST_ARENA, IGNORED_PTR_ARG, strlen(TEST_YELLOWVALUE) + 1));
+
+        ///act
+        MAP_RESULT result = Map_AddOrUpdate(handle, TEST_REDKEY, TEST_YELLOWVALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(MAP_RESULT, MAP_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(char_ptr, TEST_YELLOWVALUE, Map_GetValueFromKey(handle, TEST_REDKEY));
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
+    /*Tests_SRS_MAP_01_004: [ If allocating from arena fails, Map_CreateInArena shall return NULL. ]*/
+    TEST_FUNCTION(Map_CreateInArena_fails_when_ARENA_malloc_fails)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        MAP_HANDLE handle = Map_CreateInArena(TEST_ARENA, NULL);
+
+        ///assert
+        ASSERT_IS_NULL(handle);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_MAP_01_005: [ For a map created in an arena, Map_Destroy shall give the memory back to the arena, which reclaims it when it is reset. ]*/
+    TEST_FUNCTION(Map_Destroy_on_a_map_in_an_arena_gives_the_memory_back_to_the_arena)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateInArena(TEST_ARENA, NULL);
+        (void)Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, IGNORED_PTR_ARG)) /*the red key*/
+            .ValidateArgumentBuffer(2, TEST_REDKEY, strlen(TEST_REDKEY) + 1);
+        STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, IGNORED_PTR_ARG)) /*the red value*/
+            .ValidateArgumentBuffer(2, TEST_REDVALUE, strlen(TEST_REDVALUE) + 1);
+        STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, IGNORED_PTR_ARG)); /*keys*/
+        STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, IGNORED_PTR_ARG)); /*values*/
+        STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, handle));
+
+        ///act
+        Map_Destroy(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_MAP_01_006: [ Map_Clone shall always allocate the clone from the heap, also when handle was created in an arena. ]*/
+    TEST_FUNCTION(Map_Clone_of_a_map_in_an_arena_allocates_from_the_heap)
+    {
+        ///arrange
+        MAP_HANDLE handle = Map_CreateInArena(TEST_ARENA, NULL);
+        (void)Map_Add(handle, TEST_REDKEY, TEST_REDVALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)); /*the map*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)); /*keys*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)); /*the red key*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)); /*values*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)); /*the red value*/
+
+        ///act
+        MAP_HANDLE clone = Map_Clone(handle);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(clone);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(char_ptr, TEST_REDVALUE, Map_GetValueFromKey(clone, TEST_REDKEY));
+
+        /*the clone goes back to the heap*/
+        umock_c_reset_all_calls();
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(gballoc_free(clone));
+        Map_Destroy(clone);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        Map_Destroy(handle);
+    }
+
     /*Tests_SRS_MAP_02_006: [If parameter handle is NULL then Map_Add shall return MAP_INVALID_ARG.]*/
     TEST_FUNCTION(Map_Add_with_NULL_parameter_handle_fails)
     {
@@ -2631,22 +2821,23 @@ BEGIN_TEST_SUITE(map_unittests)
 
     /*Tests_SRS_MAP_02_048: [Map_ToJSON shall produce a STRING_HANDLE representing the content of the MAP.]*/
     /*Tests_SRS_MAP_02_049: [If the MAP is empty, then Map_ToJSON shall produce the string "{}".] */
+    /*Tests_SRS_MAP_01_001: [ Map_ToJSON shall reserve the memory for the whole JSON before writing it. ]*/
     TEST_FUNCTION(Map_ToJSON_with_empty_MAP_produces_empty_JSON)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, "}"))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 2)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "}", 1)); /*now JSON is {}*/
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
 
         ///assert
+        ASSERT_IS_NOT_NULL(toJSON);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
         ///cleanup
@@ -2655,20 +2846,19 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_empty_MAP_produces_empty_JSON_fails_when_STRING_concat_fails)
+    TEST_FUNCTION(Map_ToJSON_with_empty_MAP_fails_when_STRING_fails_1)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 2)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "}", 1))
+            .SetReturn(1); /*now JSON is {}*/
 
-        STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, "}"))
-            .IgnoreArgument(1).SetReturn(1);
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -2682,100 +2872,42 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_empty_MAP_produces_empty_JSON_fails_when_STRING_construct_fails)
+    TEST_FUNCTION(Map_ToJSON_with_empty_MAP_fails_when_STRING_fails_2)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1).SetReturn(NULL);
-
-        ///act
-        STRING_HANDLE toJSON = Map_ToJSON(handle);
-
-        ///assert
-        ASSERT_IS_NULL(toJSON);
-        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
-
-        ///cleanup
-        Map_Destroy(handle);
-    }
-
-    /*Tests_SRS_MAP_02_050: [If the map has properties then Map_ToJSON shall produce the following string:{"name1":"value1", "name2":"value2" ...}] */
-    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_succeeds)
-    {
-        ///arrange
-        MAP_HANDLE handle = Map_Create(NULL);
-        (void)Map_AddOrUpdate(handle, "redkey", "reddoor");
-        umock_c_reset_all_calls();
-
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-        STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-        STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-        STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 2)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1))
+            .SetReturn(1);
 
-        STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, "}"))/*now JSON is {"redkey":"redoor"}*/
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
 
         ///assert
-        ASSERT_IS_NOT_NULL(toJSON);
+        ASSERT_IS_NULL(toJSON);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
         ///cleanup
         Map_Destroy(handle);
-        STRING_delete(toJSON);
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_1)
+    TEST_FUNCTION(Map_ToJSON_with_empty_MAP_fails_when_STRING_fails_3)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
-        (void)Map_AddOrUpdate(handle, "redkey", "reddoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-        STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-        STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-        STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 2))
+            .SetReturn(1); /*the whole JSON is allocated once*/
 
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, "}"))/*now JSON is {"redkey":"redoor"}*/
-            .IgnoreArgument(1).SetReturn(1);
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -2789,36 +2921,14 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_2)
+    TEST_FUNCTION(Map_ToJSON_with_empty_MAP_fails_when_STRING_fails_4)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
-        (void)Map_AddOrUpdate(handle, "redkey", "reddoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-        STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-        STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-        STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-            .IgnoreArgument(1)
-            .IgnoreArgument(2)
-            .SetReturn(1);
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new())
+            .SetReturn(NULL);
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -2831,70 +2941,53 @@ BEGIN_TEST_SUITE(map_unittests)
         Map_Destroy(handle);
     }
 
-    /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_3)
+    /*Tests_SRS_MAP_02_050: [If the map has properties then Map_ToJSON shall produce the following string:{"name1":"value1", "name2":"value2" ...}] */
+    /*Tests_SRS_MAP_01_001: [ Map_ToJSON shall reserve the memory for the whole JSON before writing it. ]*/
+    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_succeeds)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, "redkey", "reddoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-        STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-        STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-        STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-            .IgnoreArgument(1)
-            .SetReturn(1);
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 21)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey")); /*now JSON is {"redkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "reddoor")); /*now JSON is {"redkey":"reddoor"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "}", 1)); /*now JSON is {"redkey":"reddoor"}*/
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
 
         ///assert
-        ASSERT_IS_NULL(toJSON);
+        ASSERT_IS_NOT_NULL(toJSON);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
         ///cleanup
         Map_Destroy(handle);
+        STRING_delete(toJSON);
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_4)
+    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_1)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, "redkey", "reddoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 21)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey")); /*now JSON is {"redkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "reddoor")); /*now JSON is {"redkey":"reddoor"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "}", 1))
+            .SetReturn(1); /*now JSON is {"redkey":"reddoor"}*/
 
-        STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-        STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-        STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-            .IgnoreArgument(1)
-            .IgnoreArgument(2)
-            .SetReturn(1);
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -2908,25 +3001,22 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_5)
+    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_2)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, "redkey", "reddoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 21)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey")); /*now JSON is {"redkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "reddoor"))
+            .SetReturn(1); /*now JSON is {"redkey":"reddoor"*/
 
-        STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-        STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor"))
-            .SetReturn(NULL); /*prepare the value*/
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-            .IgnoreArgument(1);
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -2940,20 +3030,21 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_6)
+    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_3)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, "redkey", "reddoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 21)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey")); /*now JSON is {"redkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1))
+            .SetReturn(1); /*now JSON is {"redkey":*/
 
-        STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")).SetReturn(NULL); /*prepare the key*/
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -2967,16 +3058,20 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_7)
+    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_4)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, "redkey", "reddoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1)
-            .SetReturn(NULL);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 21)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey"))
+            .SetReturn(1); /*now JSON is {"redkey"*/
+
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -2989,127 +3084,45 @@ BEGIN_TEST_SUITE(map_unittests)
         Map_Destroy(handle);
     }
 
-    /*Tests_SRS_MAP_02_050: [If the map has properties then Map_ToJSON shall produce the following string:{"name1":"value1", "name2":"value2" ...}] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_succeeds)
+    /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
+    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_5)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, "redkey", "reddoor");
-        (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        { /*artificial scope for first key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-        }
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 21)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1))
+            .SetReturn(1);
 
-        { /*artificial scope for second key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowdoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ","))
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-        }
-
-        STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, "}"))/*now JSON is {"redkey":"redoor"}*/
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
 
         ///assert
-        ASSERT_IS_NOT_NULL(toJSON);
+        ASSERT_IS_NULL(toJSON);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
         ///cleanup
         Map_Destroy(handle);
-        STRING_delete(toJSON);
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_1)
+    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_6)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, "redkey", "reddoor");
-        (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        { /*artificial scope for first key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-        }
-
-        { /*artificial scope for second key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowdoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ","))
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-        }
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 21))
+            .SetReturn(1); /*the whole JSON is allocated once*/
 
-        STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, "}"))/*now JSON is {"redkey":"redoor"}*/
-            .IgnoreArgument(1)
-            .SetReturn(1);
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -3123,58 +3136,15 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_2)
+    TEST_FUNCTION(Map_ToJSON_with_1_MAP_element_fail_when_STRING_fails_7)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
         (void)Map_AddOrUpdate(handle, "redkey", "reddoor");
-        (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        { /*artificial scope for first key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-        }
-
-        { /*artificial scope for second key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowdoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ","))
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2)
-                .SetReturn(1);
-
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-        }
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new())
+            .SetReturn(NULL);
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -3187,8 +3157,9 @@ BEGIN_TEST_SUITE(map_unittests)
         Map_Destroy(handle);
     }
 
-    /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_3)
+    /*Tests_SRS_MAP_02_050: [If the map has properties then Map_ToJSON shall produce the following string:{"name1":"value1", "name2":"value2" ...}] */
+    /*Tests_SRS_MAP_01_001: [ Map_ToJSON shall reserve the memory for the whole JSON before writing it. ]*/
+    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_succeeds)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
@@ -3196,61 +3167,32 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        { /*artificial scope for first key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-        }
-
-        { /*artificial scope for second key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowdoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ","))
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1)
-                .SetReturn(1);
-
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-        }
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 46)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey")); /*now JSON is {"redkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "reddoor")); /*now JSON is {"redkey":"reddoor"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ",", 1)); /*now JSON is {"redkey":"reddoor",*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "yellowkey")); /*now JSON is {"redkey":"reddoor","yellowkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":"reddoor","yellowkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "yellowdoor")); /*now JSON is {"redkey":"reddoor","yellowkey":"yellowdoor"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "}", 1)); /*now JSON is {"redkey":"reddoor","yellowkey":"yellowdoor"}*/
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
 
         ///assert
-        ASSERT_IS_NULL(toJSON);
+        ASSERT_IS_NOT_NULL(toJSON);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
         ///cleanup
         Map_Destroy(handle);
+        STRING_delete(toJSON);
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_4)
+    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_1)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
@@ -3258,46 +3200,20 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 46)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey")); /*now JSON is {"redkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "reddoor")); /*now JSON is {"redkey":"reddoor"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ",", 1)); /*now JSON is {"redkey":"reddoor",*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "yellowkey")); /*now JSON is {"redkey":"reddoor","yellowkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":"reddoor","yellowkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "yellowdoor")); /*now JSON is {"redkey":"reddoor","yellowkey":"yellowdoor"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "}", 1))
+            .SetReturn(1); /*now JSON is {"redkey":"reddoor","yellowkey":"yellowdoor"}*/
 
-        { /*artificial scope for first key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-        }
-
-        { /*artificial scope for second key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowdoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ","))
-                .IgnoreArgument(1);
-
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2)
-                .SetReturn(1);
-
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-        }
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -3311,7 +3227,7 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_5)
+    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_2)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
@@ -3319,41 +3235,19 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        { /*artificial scope for first key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 46)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey")); /*now JSON is {"redkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "reddoor")); /*now JSON is {"redkey":"reddoor"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ",", 1)); /*now JSON is {"redkey":"reddoor",*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "yellowkey")); /*now JSON is {"redkey":"reddoor","yellowkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":"reddoor","yellowkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "yellowdoor"))
+            .SetReturn(1); /*now JSON is {"redkey":"reddoor","yellowkey":"yellowdoor"*/
 
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-        }
-
-        { /*artificial scope for second key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowdoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ","))
-                .IgnoreArgument(1).SetReturn(1);
-
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-        }
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -3367,7 +3261,7 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_6)
+    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_3)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
@@ -3375,35 +3269,18 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        { /*artificial scope for first key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-        }
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 46)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey")); /*now JSON is {"redkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "reddoor")); /*now JSON is {"redkey":"reddoor"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ",", 1)); /*now JSON is {"redkey":"reddoor",*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "yellowkey")); /*now JSON is {"redkey":"reddoor","yellowkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1))
+            .SetReturn(1); /*now JSON is {"redkey":"reddoor","yellowkey":*/
 
-        { /*artificial scope for second key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowdoor")).SetReturn(NULL); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-        }
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -3417,7 +3294,7 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_7)
+    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_4)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
@@ -3425,32 +3302,17 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        { /*artificial scope for first key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-        }
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 46)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey")); /*now JSON is {"redkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "reddoor")); /*now JSON is {"redkey":"reddoor"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ",", 1)); /*now JSON is {"redkey":"reddoor",*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "yellowkey"))
+            .SetReturn(1); /*now JSON is {"redkey":"reddoor","yellowkey"*/
 
-        { /*artificial scope for second key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("yellowkey")).SetReturn(NULL); /*prepare the key*/
-        }
-
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -3464,7 +3326,7 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_8)
+    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_5)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
@@ -3472,29 +3334,16 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        { /*artificial scope for first key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2)
-                .SetReturn(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-        }
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 46)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey")); /*now JSON is {"redkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "reddoor")); /*now JSON is {"redkey":"reddoor"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ",", 1))
+            .SetReturn(1); /*now JSON is {"redkey":"reddoor",*/
 
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -3508,7 +3357,7 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_9)
+    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_6)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
@@ -3516,28 +3365,15 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        { /*artificial scope for first key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey":"reddoor"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2)
-                .SetReturn(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-        }
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 46)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey")); /*now JSON is {"redkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1)); /*now JSON is {"redkey":*/
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "reddoor"))
+            .SetReturn(1); /*now JSON is {"redkey":"reddoor"*/
+
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -3551,7 +3387,7 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_10)
+    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_7)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
@@ -3559,25 +3395,14 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-
-        { /*artificial scope for first key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2);
-            STRICT_EXPECTED_CALL(STRING_concat(IGNORED_PTR_ARG, ":")) /*now JSON is {"redkey":*/
-                .IgnoreArgument(1)
-                .SetReturn(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-        }
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 46)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey")); /*now JSON is {"redkey"*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, ":", 1))
+            .SetReturn(1); /*now JSON is {"redkey":*/
+
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -3591,7 +3416,7 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_11)
+    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_8)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
@@ -3599,23 +3424,13 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 46)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1));
+        STRICT_EXPECTED_CALL(STRING_concat_JSON(IGNORED_PTR_ARG, "redkey"))
+            .SetReturn(1); /*now JSON is {"redkey"*/
 
-        { /*artificial scope for first key:value*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-            STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")); /*prepare the value*/
-            STRICT_EXPECTED_CALL(STRING_concat_with_STRING(IGNORED_PTR_ARG, IGNORED_PTR_ARG)) /*now JSON is {"redkey"*/
-                .IgnoreArgument(1)
-                .IgnoreArgument(2)
-                .SetReturn(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the value*/
-                .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-                .IgnoreArgument(1);
-        }
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -3629,7 +3444,7 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_12)
+    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_9)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
@@ -3637,15 +3452,12 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 46)); /*the whole JSON is allocated once*/
+        STRICT_EXPECTED_CALL(STRING_concat_n(IGNORED_PTR_ARG, "{", 1))
+            .SetReturn(1);
 
-        STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")); /*prepare the key*/
-        STRICT_EXPECTED_CALL(STRING_new_JSON("reddoor")).SetReturn(NULL); /*prepare the value*/
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG)) /*delete the key*/
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -3659,7 +3471,7 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_13)
+    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_10)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
@@ -3667,11 +3479,11 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(STRING_new_JSON("redkey")).SetReturn(NULL); /*prepare the key*/
-        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(STRING_new());
+        STRICT_EXPECTED_CALL(STRING_reserve(IGNORED_PTR_ARG, 46))
+            .SetReturn(1); /*the whole JSON is allocated once*/
+
+        STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
         ///act
         STRING_HANDLE toJSON = Map_ToJSON(handle);
@@ -3685,7 +3497,7 @@ BEGIN_TEST_SUITE(map_unittests)
     }
 
     /*Tests_SRS_MAP_02_051: [If any error occurs while producing the output, then Map_ToJSON shall fail and return NULL.] */
-    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_14)
+    TEST_FUNCTION(Map_ToJSON_with_2_MAP_elements_fails_when_STRING_fails_11)
     {
         ///arrange
         MAP_HANDLE handle = Map_Create(NULL);
@@ -3693,8 +3505,7 @@ BEGIN_TEST_SUITE(map_unittests)
         (void)Map_AddOrUpdate(handle, "yellowkey", "yellowdoor");
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(STRING_construct("{"))
-            .IgnoreArgument(1)
+        STRICT_EXPECTED_CALL(STRING_new())
             .SetReturn(NULL);
 
         ///act
@@ -3708,5 +3519,4 @@ BEGIN_TEST_SUITE(map_unittests)
         Map_Destroy(handle);
     }
 
-    
 END_TEST_SUITE(map_unittests)
@@ -27,6 +27,7 @@ static void my_gballoc_free(void* s)
 #include "umocktypes_charptr.h"
 #include "umock_c_negative_tests.h"
 #include "azure_c_shared_utility/optionhandler.h"
+#include "azure_c_shared_utility/shared_util_options.h"
 #include "azure_c_shared_utility/optimize_size.h"
 
 /*not very nice source level preprocessor mocking... */
@@ -37,24 +38,32 @@ static void my_gballoc_free(void* s)
 #define VECTOR_destroy real_VECTOR_destroy
 #define VECTOR_push_back real_VECTOR_push_back 
 #define VECTOR_erase real_VECTOR_erase 
+#define VECTOR_pop_back real_VECTOR_pop_back 
 #define VECTOR_clear real_VECTOR_clear 
 #define VECTOR_element real_VECTOR_element 
 #define VECTOR_front real_VECTOR_front 
 #define VECTOR_back real_VECTOR_back 
 #define VECTOR_find_if real_VECTOR_find_if 
 #define VECTOR_size real_VECTOR_size 
+#define VECTOR_capacity real_VECTOR_capacity 
+#define VECTOR_reserve real_VECTOR_reserve 
+#define VECTOR_shrink_to_fit real_VECTOR_shrink_to_fit 
 #include "../src/vector.c"
 #undef VECTOR_create
 #undef VECTOR_move
 #undef VECTOR_destroy
 #undef VECTOR_push_back 
 #undef VECTOR_erase 
+#undef VECTOR_pop_back 
 #undef VECTOR_clear 
 #undef VECTOR_element 
 #undef VECTOR_front 
 #undef VECTOR_back 
 #undef VECTOR_find_if 
 #undef VECTOR_size 
+#undef VECTOR_capacity 
+#undef VECTOR_reserve 
+#undef VECTOR_shrink_to_fit 
 #undef VECTOR_H
 #undef GBALLOC_H
 #undef CRT_ABSTRACTIONS_H
@@ -68,6 +77,9 @@ static void my_gballoc_free(void* s)
 MOCKABLE_FUNCTION(, void*, aCloneOption, const char*, name, const void*, value);
 MOCKABLE_FUNCTION(, void, aDestroyOption, const char*, name, const void*, value);
 MOCKABLE_FUNCTION(, int, aSetOption, void*, handle, const char*, name, const void*, value);
+MOCKABLE_FUNCTION(, void*, aCloneOptionById, OPTION_ID, id, const char*, name, const void*, value);
+MOCKABLE_FUNCTION(, void, aDestroyOptionById, OPTION_ID, id, const char*, name, const void*, value);
+MOCKABLE_FUNCTION(, int, aSetOptionById, void*, handle, OPTION_ID, id, const char*, name, const void*, value);
 
 #undef ENABLE_MOCKS
 
@@ -105,6 +117,18 @@ static void my_aDestroyOption(const char* name, const void* value)
     my_gballoc_free((void*)value);
 }
 
+static void* my_aCloneOptionById(OPTION_ID id, const char* name, const void* value)
+{
+    (void)id, (void)name, (void)value;
+    return my_gballoc_malloc(2);
+}
+
+static void my_aDestroyOptionById(OPTION_ID id, const char* name, const void* value)
+{
+    (void)id, (void)(name);
+    my_gballoc_free((void*)value);
+}
+
 
 BEGIN_TEST_SUITE(optionhandler_unittests)
 
@@ -120,6 +144,7 @@ BEGIN_TEST_SUITE(optionhandler_unittests)
 
         REGISTER_UMOCK_ALIAS_TYPE(const VECTOR_HANDLE, void*);
         REGISTER_UMOCK_ALIAS_TYPE(VECTOR_HANDLE, void*);
+        REGISTER_UMOCK_ALIAS_TYPE(OPTION_ID, int);
         
         REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
         REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
@@ -143,8 +168,14 @@ BEGIN_TEST_SUITE(optionhandler_unittests)
         REGISTER_GLOBAL_MOCK_FAIL_RETURN(aCloneOption, NULL);
 
         REGISTER_GLOBAL_MOCK_FAIL_RETURN(aSetOption, __FAILURE__);
+        REGISTER_GLOBAL_MOCK_FAIL_RETURN(aSetOptionById, __FAILURE__);
 
         REGISTER_GLOBAL_MOCK_HOOK(aDestroyOption, my_aDestroyOption);
+
+        REGISTER_GLOBAL_MOCK_HOOK(aCloneOptionById, my_aCloneOptionById);
+        REGISTER_GLOBAL_MOCK_FAIL_RETURN(aCloneOptionById, NULL);
+
+        REGISTER_GLOBAL_MOCK_HOOK(aDestroyOptionById, my_aDestroyOptionById);
     }
 
     TEST_SUITE_CLEANUP(TestClassCleanup)
@@ -270,6 +301,94 @@ BEGIN_TEST_SUITE(optionhandler_unittests)
         umock_c_negative_tests_deinit();
     }
 
+    /* OptionHandler_CreateWithOptionIds */
+
+    /*Tests_SRS_OPTIONHANDLER_01_012: [ OptionHandler_CreateWithOptionIds shall fail and return NULL if any parameters are NULL. ]*/
+    TEST_FUNCTION(OptionHandler_CreateWithOptionIds_fails_with_NULL_cloneOptionById_parameter)
+    {
+        ///arrange
+
+        ///act
+        OPTIONHANDLER_HANDLE h = OptionHandler_CreateWithOptionIds(NULL, aDestroyOptionById, aSetOptionById);
+
+        ///assert
+        ASSERT_IS_NULL(h);
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_OPTIONHANDLER_01_012: [ OptionHandler_CreateWithOptionIds shall fail and return NULL if any parameters are NULL. ]*/
+    TEST_FUNCTION(OptionHandler_CreateWithOptionIds_fails_with_NULL_destroyOptionById_parameter)
+    {
+        ///arrange
+
+        ///act
+        OPTIONHANDLER_HANDLE h = OptionHandler_CreateWithOptionIds(aCloneOptionById, NULL, aSetOptionById);
+
+        ///assert
+        ASSERT_IS_NULL(h);
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_OPTIONHANDLER_01_012: [ OptionHandler_CreateWithOptionIds shall fail and return NULL if any parameters are NULL. ]*/
+    TEST_FUNCTION(OptionHandler_CreateWithOptionIds_fails_with_NULL_setOptionById_parameter)
+    {
+        ///arrange
+
+        ///act
+        OPTIONHANDLER_HANDLE h = OptionHandler_CreateWithOptionIds(aCloneOptionById, aDestroyOptionById, NULL);
+
+        ///assert
+        ASSERT_IS_NULL(h);
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_OPTIONHANDLER_01_013: [ Otherwise OptionHandler_CreateWithOptionIds shall create the option handler as OptionHandler_Create does, except that its options shall be cloned with cloneOptionById, destroyed with destroyOptionById and fed with setOptionById. ]*/
+    TEST_FUNCTION(OptionHandler_CreateWithOptionIds_happy_path)
+    {
+        ///arrange
+        OptionHandler_Create_inert_path();
+
+        ///act
+        OPTIONHANDLER_HANDLE h = OptionHandler_CreateWithOptionIds(aCloneOptionById, aDestroyOptionById, aSetOptionById);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(h);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        OptionHandler_Destroy(h);
+    }
+
+    /*Tests_SRS_OPTIONHANDLER_01_013: [ Otherwise OptionHandler_CreateWithOptionIds shall create the option handler as OptionHandler_Create does, except that its options shall be cloned with cloneOptionById, destroyed with destroyOptionById and fed with setOptionById. ]*/
+    TEST_FUNCTION(OptionHandler_CreateWithOptionIds_unhappy_paths)
+    {
+        ///arrange
+        int negativeTestsInitResult = umock_c_negative_tests_init();
+        ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+        OptionHandler_Create_inert_path();
+
+        umock_c_negative_tests_snapshot();
+
+        for (size_t i = 0; i < umock_c_negative_tests_call_count(); i++)
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(i);
+
+            ///act
+            OPTIONHANDLER_HANDLE h = OptionHandler_CreateWithOptionIds(aCloneOptionById, aDestroyOptionById, aSetOptionById);
+
+            ///assert
+            ASSERT_IS_NULL(h);
+        }
+
+        ///cleanup
+        umock_c_negative_tests_deinit();
+    }
+
     /* OptionHandler_Clone */
 
     /* Tests_SRS_OPTIONHANDLER_01_010: [ If `handler` is NULL, OptionHandler_Clone shall fail and return NULL. ]*/
@@ -1144,6 +1263,196 @@ BEGIN_TEST_SUITE(optionhandler_unittests)
         umock_c_negative_tests_deinit();
     }
 
+    /*Tests_SRS_OPTIONHANDLER_01_014: [ OptionHandler_AddOption shall save along with name the id of name as returned by OptionHandler_GetOptionId. ]*/
+    /*Tests_SRS_OPTIONHANDLER_01_015: [ If the option handler was created with OptionHandler_CreateWithOptionIds, OptionHandler_FeedOptions shall call for every option setOptionById passing destinationHandle, the saved id, name and value. ]*/
+    TEST_FUNCTION(OptionHandler_FeedOptions_feeds_the_saved_ids_to_setOptionById)
+    {
+        ///arrange
+        OPTIONHANDLER_HANDLE handle = OptionHandler_CreateWithOptionIds(aCloneOptionById, aDestroyOptionById, aSetOptionById);
+        (void)OptionHandler_AddOption(handle, "x509certificate", "b");
+        (void)OptionHandler_AddOption(handle, "a", "b2");
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(VECTOR_size(IGNORED_PTR_ARG))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(VECTOR_element(IGNORED_PTR_ARG, 0))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(aSetOptionById((void*)42, OPTION_ID_X509_CERT, "x509certificate", IGNORED_PTR_ARG))
+            .IgnoreArgument_value();
+        STRICT_EXPECTED_CALL(VECTOR_element(IGNORED_PTR_ARG, 1))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(aSetOptionById((void*)42, OPTION_ID_UNKNOWN, "a", IGNORED_PTR_ARG))
+            .IgnoreArgument_value();
+
+        ///act
+        OPTIONHANDLER_RESULT result = OptionHandler_FeedOptions(handle, (void*)42);
+
+        ///assert
+        ASSERT_ARE_EQUAL(OPTIONHANDLER_RESULT, OPTIONHANDLER_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        OptionHandler_Destroy(handle);
+    }
+
+    /*Tests_SRS_OPTIONHANDLER_02_014: [ Otherwise, OptionHandler_FeedOptions shall fail and return OPTIONHANDLER_ERROR. ]*/
+    TEST_FUNCTION(when_setOptionById_fails_OptionHandler_FeedOptions_fails)
+    {
+        ///arrange
+        OPTIONHANDLER_HANDLE handle = OptionHandler_CreateWithOptionIds(aCloneOptionById, aDestroyOptionById, aSetOptionById);
+        (void)OptionHandler_AddOption(handle, "TrustedCerts", "b");
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(VECTOR_size(IGNORED_PTR_ARG))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(VECTOR_element(IGNORED_PTR_ARG, 0))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(aSetOptionById((void*)42, OPTION_ID_TRUSTED_CERT, "TrustedCerts", IGNORED_PTR_ARG))
+            .IgnoreArgument_value()
+            .SetReturn(1);
+
+        ///act
+        OPTIONHANDLER_RESULT result = OptionHandler_FeedOptions(handle, (void*)42);
+
+        ///assert
+        ASSERT_ARE_EQUAL(OPTIONHANDLER_RESULT, OPTIONHANDLER_ERROR, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        OptionHandler_Destroy(handle);
+    }
+
+    /*Tests_SRS_OPTIONHANDLER_01_016: [ The clone shall clone, destroy and feed its options with the same functions as handler. ]*/
+    /*Tests_SRS_OPTIONHANDLER_01_017: [ The saved id of every option shall be copied to the clone. ]*/
+    TEST_FUNCTION(OptionHandler_Clone_feeds_the_saved_ids_to_setOptionById)
+    {
+        ///arrange
+        OPTIONHANDLER_HANDLE source = OptionHandler_CreateWithOptionIds(aCloneOptionById, aDestroyOptionById, aSetOptionById);
+        (void)OptionHandler_AddOption(source, "tls_version", "b");
+        OPTIONHANDLER_HANDLE clone = OptionHandler_Clone(source);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(VECTOR_size(IGNORED_PTR_ARG))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(VECTOR_element(IGNORED_PTR_ARG, 0))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(aSetOptionById((void*)42, OPTION_ID_TLS_VERSION, "tls_version", IGNORED_PTR_ARG))
+            .IgnoreArgument_value();
+
+        ///act
+        OPTIONHANDLER_RESULT result = OptionHandler_FeedOptions(clone, (void*)42);
+
+        ///assert
+        ASSERT_ARE_EQUAL(OPTIONHANDLER_RESULT, OPTIONHANDLER_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        OptionHandler_Destroy(clone);
+        OptionHandler_Destroy(source);
+    }
+
+    /*Tests_SRS_OPTIONHANDLER_01_021: [ If the option handler was created with OptionHandler_CreateWithOptionIds, OptionHandler_AddOption and OptionHandler_Clone shall clone value by calling cloneOptionById passing the id of the option, name and value. ]*/
+    TEST_FUNCTION(OptionHandler_AddOption_clones_the_value_with_cloneOptionById)
+    {
+        ///arrange
+        OPTIONHANDLER_HANDLE handle = OptionHandler_CreateWithOptionIds(aCloneOptionById, aDestroyOptionById, aSetOptionById);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(mallocAndStrcpy_s(IGNORED_PTR_ARG, "TrustedCerts"))
+            .IgnoreArgument_destination();
+        STRICT_EXPECTED_CALL(aCloneOptionById(OPTION_ID_TRUSTED_CERT, "TrustedCerts", (void*)"b"));
+        STRICT_EXPECTED_CALL(VECTOR_push_back(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 1))
+            .IgnoreArgument_handle()
+            .IgnoreArgument_elements();
+
+        ///act
+        OPTIONHANDLER_RESULT result = OptionHandler_AddOption(handle, "TrustedCerts", "b");
+
+        ///assert
+        ASSERT_ARE_EQUAL(OPTIONHANDLER_RESULT, OPTIONHANDLER_OK, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        OptionHandler_Destroy(handle);
+    }
+
+    /*Tests_SRS_OPTIONHANDLER_01_021: [ If the option handler was created with OptionHandler_CreateWithOptionIds, OptionHandler_AddOption and OptionHandler_Clone shall clone value by calling cloneOptionById passing the id of the option, name and value. ]*/
+    /*Tests_SRS_OPTIONHANDLER_01_017: [ The saved id of every option shall be copied to the clone. ]*/
+    TEST_FUNCTION(OptionHandler_Clone_clones_the_values_with_cloneOptionById)
+    {
+        ///arrange
+        OPTIONHANDLER_HANDLE source = OptionHandler_CreateWithOptionIds(aCloneOptionById, aDestroyOptionById, aSetOptionById);
+        (void)OptionHandler_AddOption(source, "x509EccCertificate", "b");
+        (void)OptionHandler_AddOption(source, "a", "b2");
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size();
+        STRICT_EXPECTED_CALL(VECTOR_create(IGNORED_NUM_ARG))
+            .IgnoreArgument_elementSize();
+        STRICT_EXPECTED_CALL(VECTOR_size(IGNORED_PTR_ARG))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(VECTOR_element(IGNORED_PTR_ARG, 0))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(mallocAndStrcpy_s(IGNORED_PTR_ARG, "x509EccCertificate"))
+            .IgnoreArgument_destination();
+        STRICT_EXPECTED_CALL(aCloneOptionById(OPTION_ID_X509_ECC_CERT, "x509EccCertificate", IGNORED_PTR_ARG))
+            .IgnoreArgument_value();
+        STRICT_EXPECTED_CALL(VECTOR_push_back(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 1))
+            .IgnoreArgument_handle()
+            .IgnoreArgument_elements();
+        STRICT_EXPECTED_CALL(VECTOR_element(IGNORED_PTR_ARG, 1))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(mallocAndStrcpy_s(IGNORED_PTR_ARG, "a"))
+            .IgnoreArgument_destination();
+        STRICT_EXPECTED_CALL(aCloneOptionById(OPTION_ID_UNKNOWN, "a", IGNORED_PTR_ARG))
+            .IgnoreArgument_value();
+        STRICT_EXPECTED_CALL(VECTOR_push_back(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 1))
+            .IgnoreArgument_handle()
+            .IgnoreArgument_elements();
+
+        ///act
+        OPTIONHANDLER_HANDLE clone = OptionHandler_Clone(source);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(clone);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        OptionHandler_Destroy(clone);
+        OptionHandler_Destroy(source);
+    }
+
+    /*Tests_SRS_OPTIONHANDLER_01_022: [ If the option handler was created with OptionHandler_CreateWithOptionIds, the options shall be freed by calling destroyOptionById passing the saved id, name and value. ]*/
+    TEST_FUNCTION(when_VECTOR_push_back_fails_OptionHandler_AddOption_destroys_the_value_with_destroyOptionById)
+    {
+        ///arrange
+        OPTIONHANDLER_HANDLE handle = OptionHandler_CreateWithOptionIds(aCloneOptionById, aDestroyOptionById, aSetOptionById);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(mallocAndStrcpy_s(IGNORED_PTR_ARG, "tls_version"))
+            .IgnoreArgument_destination();
+        STRICT_EXPECTED_CALL(aCloneOptionById(OPTION_ID_TLS_VERSION, "tls_version", (void*)"b"));
+        STRICT_EXPECTED_CALL(VECTOR_push_back(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 1))
+            .IgnoreArgument_handle()
+            .IgnoreArgument_elements()
+            .SetReturn(1);
+        STRICT_EXPECTED_CALL(aDestroyOptionById(OPTION_ID_TLS_VERSION, "tls_version", IGNORED_PTR_ARG))
+            .IgnoreArgument_value();
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument_ptr();
+
+        ///act
+        OPTIONHANDLER_RESULT result = OptionHandler_AddOption(handle, "tls_version", "b");
+
+        ///assert
+        ASSERT_ARE_EQUAL(OPTIONHANDLER_RESULT, OPTIONHANDLER_ERROR, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        OptionHandler_Destroy(handle);
+    }
+
     /* OptionHandler_Destroy */
 
     /*Tests_SRS_OPTIONHANDLER_02_015: [ OptionHandler_Destroy shall do nothing if parameter handle is NULL. ]*/
@@ -1200,6 +1509,119 @@ BEGIN_TEST_SUITE(optionhandler_unittests)
         ///cleanup
     }
 
+    /*Tests_SRS_OPTIONHANDLER_01_022: [ If the option handler was created with OptionHandler_CreateWithOptionIds, the options shall be freed by calling destroyOptionById passing the saved id, name and value. ]*/
+    TEST_FUNCTION(OptionHandler_Destroy_destroys_the_values_with_destroyOptionById)
+    {
+        ///arrange
+        OPTIONHANDLER_HANDLE handle = OptionHandler_CreateWithOptionIds(aCloneOptionById, aDestroyOptionById, aSetOptionById);
+        (void)OptionHandler_AddOption(handle, "x509certificate", "b");
+        (void)OptionHandler_AddOption(handle, "c", "b2");
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(VECTOR_size(IGNORED_PTR_ARG))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(VECTOR_element(IGNORED_PTR_ARG, 0))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(aDestroyOptionById(OPTION_ID_X509_CERT, "x509certificate", IGNORED_PTR_ARG))
+            .IgnoreArgument_value();
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument_ptr();
+
+        STRICT_EXPECTED_CALL(VECTOR_element(IGNORED_PTR_ARG, 1))
+            .IgnoreArgument_handle();
+        STRICT_EXPECTED_CALL(aDestroyOptionById(OPTION_ID_UNKNOWN, "c", IGNORED_PTR_ARG))
+            .IgnoreArgument_value();
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument_ptr();
+
+        STRICT_EXPECTED_CALL(VECTOR_destroy(IGNORED_PTR_ARG))
+            .IgnoreArgument_handle();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument_ptr();
+
+        ///act
+        OptionHandler_Destroy(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /* OptionHandler_GetOptionId */
+
+    /*Tests_SRS_OPTIONHANDLER_01_018: [ If name is NULL, OptionHandler_GetOptionId shall return OPTION_ID_UNKNOWN. ]*/
+    TEST_FUNCTION(OptionHandler_GetOptionId_with_NULL_name_returns_OPTION_ID_UNKNOWN)
+    {
+        ///arrange
+
+        ///act
+        OPTION_ID result = OptionHandler_GetOptionId(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, (int)OPTION_ID_UNKNOWN, (int)result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_OPTIONHANDLER_01_019: [ OptionHandler_GetOptionId shall return the OPTION_ID of name when name is one of the option names of shared_util_options.h. ]*/
+    TEST_FUNCTION(OptionHandler_GetOptionId_returns_the_id_of_every_option_name)
+    {
+        ///arrange
+        const struct { const char* name; OPTION_ID id; } names[] =
+        {
+            { OPTION_HTTP_PROXY, OPTION_ID_HTTP_PROXY },
+            { OPTION_HTTP_TIMEOUT, OPTION_ID_HTTP_TIMEOUT },
+            { SU_OPTION_X509_CERT, OPTION_ID_X509_CERT },
+            { SU_OPTION_X509_PRIVATE_KEY, OPTION_ID_X509_PRIVATE_KEY },
+            { OPTION_X509_ECC_CERT, OPTION_ID_X509_ECC_CERT },
+            { OPTION_X509_ECC_KEY, OPTION_ID_X509_ECC_KEY },
+            { OPTION_CURL_LOW_SPEED_LIMIT, OPTION_ID_CURL_LOW_SPEED_LIMIT },
+            { OPTION_CURL_LOW_SPEED_TIME, OPTION_ID_CURL_LOW_SPEED_TIME },
+            { OPTION_CURL_FRESH_CONNECT, OPTION_ID_CURL_FRESH_CONNECT },
+            { OPTION_CURL_FORBID_REUSE, OPTION_ID_CURL_FORBID_REUSE },
+            { OPTION_CURL_VERBOSE, OPTION_ID_CURL_VERBOSE },
+            { OPTION_SAS_TOKEN_REFRESH_MARGIN, OPTION_ID_SAS_TOKEN_REFRESH_MARGIN },
+            { OPTION_TRUSTED_CERT, OPTION_ID_TRUSTED_CERT },
+            { OPTION_TLS_VERSION, OPTION_ID_TLS_VERSION },
+            { OPTION_TLS_VALIDATION_CALLBACK, OPTION_ID_TLS_VALIDATION_CALLBACK },
+            { OPTION_TLS_VALIDATION_CALLBACK_DATA, OPTION_ID_TLS_VALIDATION_CALLBACK_DATA },
+            { OPTION_TCP_KEEP_ALIVE, OPTION_ID_TCP_KEEP_ALIVE },
+            { OPTION_TCP_KEEP_ALIVE_TIME, OPTION_ID_TCP_KEEP_ALIVE_TIME },
+            { OPTION_TCP_KEEP_ALIVE_INTERVAL, OPTION_ID_TCP_KEEP_ALIVE_INTERVAL }
+        };
+        size_t i;
+
+        for (i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+        {
+            ///act
+            OPTION_ID result = OptionHandler_GetOptionId(names[i].name);
+
+            ///assert
+            ASSERT_ARE_EQUAL_WITH_MSG(int, (int)names[i].id, (int)result, names[i].name);
+        }
+    }
+
+    /*Tests_SRS_OPTIONHANDLER_01_020: [ Otherwise OptionHandler_GetOptionId shall return OPTION_ID_UNKNOWN. ]*/
+    TEST_FUNCTION(OptionHandler_GetOptionId_with_an_unknown_name_returns_OPTION_ID_UNKNOWN)
+    {
+        ///arrange
+
+        ///act
+        OPTION_ID result1 = OptionHandler_GetOptionId("TrustedCertsX");
+        OPTION_ID result2 = OptionHandler_GetOptionId("tls");
+        OPTION_ID result3 = OptionHandler_GetOptionId("");
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, (int)OPTION_ID_UNKNOWN, (int)result1);
+        ASSERT_ARE_EQUAL(int, (int)OPTION_ID_UNKNOWN, (int)result2);
+        ASSERT_ARE_EQUAL(int, (int)OPTION_ID_UNKNOWN, (int)result3);
+
+        ///cleanup
+    }
+
 END_TEST_SUITE(optionhandler_unittests)
 
 
@@ -0,0 +1,190 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <time.h>
+#include "azure_c_shared_utility/base64.h"
+#include "azure_c_shared_utility/strings.h"
+#include "azure_c_shared_utility/buffer_.h"
+
+/* every scenario encodes (or decodes back) this many bytes in total */
+#define BYTES_PER_SCENARIO  (128 * 1024 * 1024)
+#define MAX_DATA_SIZE       (16 * 1024 * 1024)
+/* the streaming scenarios feed the data in chunks of this size into a buffer of one chunk */
+#define STREAM_CHUNK_SIZE   (48 * 1024)
+
+typedef int(*RUN_ONCE)(size_t data_size);
+
+static unsigned char* data;
+static char* encoded;
+static unsigned char* decoded;
+
+static int encode_bytes(size_t data_size)
+{
+    STRING_HANDLE result = Base64_Encode_Bytes(data, data_size);
+    STRING_delete(result);
+    return (result == NULL) ? __LINE__ : 0;
+}
+
+static int encode_into(size_t data_size)
+{
+    size_t encoded_length;
+    return Base64_Encode_Into(data, data_size, encoded, (MAX_DATA_SIZE / 3 + 1) * 4 + 1, &encoded_length);
+}
+
+static int decoder(size_t data_size)
+{
+    BUFFER_HANDLE result = Base64_Decoder(encoded);
+    int failed = (result == NULL) || (BUFFER_length(result) != data_size);
+    BUFFER_delete(result);
+    return failed ? __LINE__ : 0;
+}
+
+static int decode_into(size_t data_size)
+{
+    size_t decoded_length;
+    return ((Base64_Decode_Into(encoded, ((data_size + 2) / 3) * 4, decoded, MAX_DATA_SIZE, &decoded_length) != 0) || (decoded_length != data_size)) ? __LINE__ : 0;
+}
+
+static int encode_update(size_t data_size)
+{
+    int result = 0;
+    BASE64_ENCODE_CONTEXT_HANDLE context = Base64_Encode_Init();
+    char chunk_encoded[(STREAM_CHUNK_SIZE / 3 + 1) * 4];
+    size_t encoded_length;
+    size_t position;
+
+    for (position = 0; (result == 0) && (position < data_size); position += STREAM_CHUNK_SIZE)
+    {
+        size_t chunk_size = ((data_size - position) < STREAM_CHUNK_SIZE) ? (data_size - position) : STREAM_CHUNK_SIZE;
+        result = Base64_Encode_Update(context, data + position, chunk_size, chunk_encoded, sizeof(chunk_encoded), &encoded_length);
+    }
+    if (result == 0)
+    {
+        result = Base64_Encode_Final(context, chunk_encoded, sizeof(chunk_encoded), &encoded_length);
+    }
+    Base64_Encode_DestroyContext(context);
+    return result;
+}
+
+static int decode_update(size_t data_size)
+{
+    int result = 0;
+    BASE64_DECODE_CONTEXT_HANDLE context = Base64_Decode_Init();
+    size_t encoded_size = ((data_size + 2) / 3) * 4;
+    unsigned char chunk_decoded[(STREAM_CHUNK_SIZE / 4 + 1) * 3];
+    size_t decoded_length;
+    size_t position;
+
+    for (position = 0; (result == 0) && (position < encoded_size); position += STREAM_CHUNK_SIZE)
+    {
+        size_t chunk_size = ((encoded_size - position) < STREAM_CHUNK_SIZE) ? (encoded_size - position) : STREAM_CHUNK_SIZE;
+        result = Base64_Decode_Update(context, encoded + position, chunk_size, chunk_decoded, sizeof(chunk_decoded), &decoded_length);
+    }
+    if (result == 0)
+    {
+        result = Base64_Decode_Final(context);
+    }
+    Base64_Decode_DestroyContext(context);
+    return result;
+}
+
+static int run_scenario(const char* scenario_name, RUN_ONCE run_once, size_t data_size)
+{
+    int result = 0;
+    size_t iterations = BYTES_PER_SCENARIO / data_size;
+    clock_t start_time;
+    clock_t end_time;
+    size_t i;
+
+    start_time = clock();
+
+    for (i = 0; (result == 0) && (i < iterations); i++)
+    {
+        result = run_once(data_size);
+        if (result != 0)
+        {
+            (void)printf("%s failed\r\n", scenario_name);
+        }
+    }
+
+    end_time = clock();
+
+    if (result == 0)
+    {
+        double elapsed_ms = ((double)(end_time - start_time) * 1000.0) / CLOCKS_PER_SEC;
+        double total_mb = ((double)data_size * iterations) / (1024.0 * 1024.0);
+
+        if (elapsed_ms <= 0)
+        {
+            elapsed_ms = 1;
+        }
+
+        (void)printf("%-20s %8lu bytes: %8.0f ms, %10.2f MB/s\r\n",
+            scenario_name, (unsigned long)data_size, elapsed_ms, total_mb / (elapsed_ms / 1000.0));
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    static const size_t data_sizes[] = { 32, 1024, 64 * 1024, 1024 * 1024, MAX_DATA_SIZE };
+    int result = 0;
+    size_t i;
+
+    data = (unsigned char*)malloc(MAX_DATA_SIZE);
+    encoded = (char*)malloc((MAX_DATA_SIZE / 3 + 1) * 4 + 1);
+    decoded = (unsigned char*)malloc(MAX_DATA_SIZE);
+    if ((data == NULL) || (encoded == NULL) || (decoded == NULL))
+    {
+        (void)printf("Allocation failed\r\n");
+        result = __LINE__;
+    }
+    else
+    {
+        for (i = 0; i < MAX_DATA_SIZE; i++)
+        {
+            data[i] = (unsigned char)(i * 31);
+        }
+
+        for (i = 0; (result == 0) && (i < sizeof(data_sizes) / sizeof(data_sizes[0])); i++)
+        {
+            size_t encoded_length;
+            result = run_scenario("Base64_Encode_Bytes", encode_bytes, data_sizes[i]);
+            if (result == 0)
+            {
+                result = run_scenario("Base64_Encode_Into", encode_into, data_sizes[i]);
+            }
+            if (result == 0)
+            {
+                result = run_scenario("Base64_Encode_Update", encode_update, data_sizes[i]);
+            }
+            /* the decoders work on the encoding of the current size */
+            if ((result == 0) && (Base64_Encode_Into(data, data_sizes[i], encoded, (MAX_DATA_SIZE / 3 + 1) * 4 + 1, &encoded_length) != 0))
+            {
+                result = __LINE__;
+            }
+            if (result == 0)
+            {
+                result = run_scenario("Base64_Decoder", decoder, data_sizes[i]);
+            }
+            if (result == 0)
+            {
+                result = run_scenario("Base64_Decode_Into", decode_into, data_sizes[i]);
+            }
+            if (result == 0)
+            {
+                result = run_scenario("Base64_Decode_Update", decode_update, data_sizes[i]);
+            }
+        }
+    }
+
+    free(data);
+    free(encoded);
+    free(decoded);
+
+    return result;
+}
@@ -0,0 +1,196 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+/* every scenario moves this many bytes through buffers in total */
+#define BYTES_PER_SCENARIO      (128 * 1024 * 1024)
+
+static size_t allocation_count;
+
+static void* counting_malloc(size_t size)
+{
+    allocation_count++;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* ptr, size_t size)
+{
+    allocation_count++;
+    return realloc(ptr, size);
+}
+
+/* buffer.c is compiled in here, with its allocations routed through the counters above */
+#define GBALLOC_H
+#define malloc counting_malloc
+#define realloc counting_realloc
+#include "buffer.c"
+#undef malloc
+#undef realloc
+
+typedef int(*RUN_ONCE)(const unsigned char* chunk, size_t chunk_size, size_t run_size);
+
+/* a message assembled piece by piece, as a transport receives it */
+static int append(const unsigned char* chunk, size_t chunk_size, size_t run_size)
+{
+    int result = 0;
+    BUFFER_HANDLE buffer = BUFFER_create(chunk, chunk_size);
+    BUFFER_HANDLE piece = BUFFER_create(chunk, chunk_size);
+    size_t i;
+
+    if ((buffer == NULL) || (piece == NULL))
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        for (i = chunk_size; (result == 0) && (i < run_size); i += chunk_size)
+        {
+            if (BUFFER_append(buffer, piece) != 0)
+            {
+                result = __LINE__;
+            }
+        }
+    }
+
+    BUFFER_delete(piece);
+    BUFFER_delete(buffer);
+    return result;
+}
+
+/* the pattern of the chunked body reader in httpapi_compact: make room, then write into it */
+static int enlarge(const unsigned char* chunk, size_t chunk_size, size_t run_size)
+{
+    int result = 0;
+    BUFFER_HANDLE buffer = BUFFER_new();
+    size_t i;
+
+    if (buffer == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        for (i = 0; (result == 0) && (i < run_size); i += chunk_size)
+        {
+            if (BUFFER_enlarge(buffer, chunk_size) != 0)
+            {
+                result = __LINE__;
+            }
+            else
+            {
+                (void)memcpy(BUFFER_u_char(buffer) + i, chunk, chunk_size);
+            }
+        }
+    }
+
+    BUFFER_delete(buffer);
+    return result;
+}
+
+/* protocol layers putting their headers in front of a payload */
+static int prepend(const unsigned char* chunk, size_t chunk_size, size_t run_size)
+{
+    int result = 0;
+    BUFFER_HANDLE buffer = BUFFER_create(chunk, chunk_size);
+    BUFFER_HANDLE header = BUFFER_create(chunk, chunk_size);
+    size_t i;
+
+    if ((buffer == NULL) || (header == NULL))
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        for (i = chunk_size; (result == 0) && (i < run_size); i += chunk_size)
+        {
+            if (BUFFER_prepend(buffer, header) != 0)
+            {
+                result = __LINE__;
+            }
+        }
+    }
+
+    BUFFER_delete(header);
+    BUFFER_delete(buffer);
+    return result;
+}
+
+static int run_scenario(const char* scenario_name, RUN_ONCE run_once, size_t chunk_size, size_t run_size)
+{
+    int result = 0;
+    size_t iterations = BYTES_PER_SCENARIO / run_size;
+    unsigned char* chunk = (unsigned char*)malloc(chunk_size);
+    clock_t start_time;
+    clock_t end_time;
+    size_t i;
+
+    if (chunk == NULL)
+    {
+        (void)printf("%s failed\r\n", scenario_name);
+        result = __LINE__;
+    }
+    else
+    {
+        (void)memset(chunk, 'x', chunk_size);
+        allocation_count = 0;
+
+        start_time = clock();
+
+        for (i = 0; (result == 0) && (i < iterations); i++)
+        {
+            result = run_once(chunk, chunk_size, run_size);
+            if (result != 0)
+            {
+                (void)printf("%s failed\r\n", scenario_name);
+            }
+        }
+
+        end_time = clock();
+
+        if (result == 0)
+        {
+            double elapsed_ms = ((double)(end_time - start_time) * 1000.0) / CLOCKS_PER_SEC;
+
+            if (elapsed_ms <= 0)
+            {
+                elapsed_ms = 1;
+            }
+
+            (void)printf("%-15s %5lu bytes/chunk: %8.0f ms, %9.2f MB/s, %8.1f allocations/MB\r\n",
+                scenario_name, (unsigned long)chunk_size, elapsed_ms, (BYTES_PER_SCENARIO / (1024.0 * 1024.0)) / (elapsed_ms / 1000.0),
+                (double)allocation_count / (BYTES_PER_SCENARIO / (1024.0 * 1024.0)));
+        }
+
+        free(chunk);
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    static const size_t chunk_sizes[] = { 64, 1024, 16384 };
+    int result = 0;
+    size_t i;
+
+    for (i = 0; (result == 0) && (i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0])); i++)
+    {
+        result = run_scenario("BUFFER_append", append, chunk_sizes[i], 1024 * 1024);
+        if (result == 0)
+        {
+            result = run_scenario("BUFFER_enlarge", enlarge, chunk_sizes[i], 1024 * 1024);
+        }
+        if (result == 0)
+        {
+            /* smaller messages, as prepending used to copy the whole buffer every time */
+            result = run_scenario("BUFFER_prepend", prepend, chunk_sizes[i], 64 * 1024);
+        }
+    }
+
+    return result;
+}
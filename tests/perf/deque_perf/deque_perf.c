@@ -0,0 +1,214 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <time.h>
+#include "azure_c_shared_utility/deque.h"
+#include "azure_c_shared_utility/vector.h"
+#include "azure_c_shared_utility/singlylinkedlist.h"
+
+/* every scenario pushes and pops this many elements in total */
+#define OPERATIONS_PER_SCENARIO   (1024 * 1024)
+
+/* the shape of an entry in a pending send queue */
+typedef struct PENDING_SEND_TAG
+{
+    const unsigned char* bytes;
+    size_t size;
+    void* on_send_complete;
+    void* callback_context;
+} PENDING_SEND;
+
+typedef int(*RUN_SCENARIO)(size_t queue_depth, size_t operations);
+
+/* the queue is filled to queue_depth, then every operation queues one entry at the back and completes the one at the front */
+static int deque_queue(size_t queue_depth, size_t operations)
+{
+    int result = 0;
+    DEQUE_HANDLE queue = DEQUE_create(sizeof(PENDING_SEND));
+    size_t i;
+
+    if (queue == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        for (i = 0; (result == 0) && (i < queue_depth + operations); i++)
+        {
+            PENDING_SEND pending_send = { NULL, i, NULL, NULL };
+            if (DEQUE_push_back(queue, &pending_send) != 0)
+            {
+                result = __LINE__;
+            }
+            else if (i >= queue_depth)
+            {
+                PENDING_SEND* front = (PENDING_SEND*)DEQUE_front(queue);
+                if (front->size != i - queue_depth)
+                {
+                    result = __LINE__;
+                }
+                else
+                {
+                    DEQUE_pop_front(queue);
+                }
+            }
+        }
+
+        DEQUE_destroy(queue);
+    }
+
+    return result;
+}
+
+static int vector_queue(size_t queue_depth, size_t operations)
+{
+    int result = 0;
+    VECTOR_HANDLE queue = VECTOR_create(sizeof(PENDING_SEND));
+    size_t i;
+
+    if (queue == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        for (i = 0; (result == 0) && (i < queue_depth + operations); i++)
+        {
+            PENDING_SEND pending_send = { NULL, i, NULL, NULL };
+            if (VECTOR_push_back(queue, &pending_send, 1) != 0)
+            {
+                result = __LINE__;
+            }
+            else if (i >= queue_depth)
+            {
+                PENDING_SEND* front = (PENDING_SEND*)VECTOR_front(queue);
+                if (front->size != i - queue_depth)
+                {
+                    result = __LINE__;
+                }
+                else
+                {
+                    VECTOR_erase(queue, front, 1);
+                }
+            }
+        }
+
+        VECTOR_destroy(queue);
+    }
+
+    return result;
+}
+
+/* the list only holds pointers, so every entry is allocated separately the way the IO layers do it */
+static int list_queue(size_t queue_depth, size_t operations)
+{
+    int result = 0;
+    SINGLYLINKEDLIST_HANDLE queue = singlylinkedlist_create();
+    size_t i;
+
+    if (queue == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        LIST_ITEM_HANDLE head;
+
+        for (i = 0; (result == 0) && (i < queue_depth + operations); i++)
+        {
+            PENDING_SEND* pending_send = (PENDING_SEND*)malloc(sizeof(PENDING_SEND));
+            if (pending_send == NULL)
+            {
+                result = __LINE__;
+            }
+            else
+            {
+                pending_send->size = i;
+                if (singlylinkedlist_add(queue, pending_send) == NULL)
+                {
+                    free(pending_send);
+                    result = __LINE__;
+                }
+                else if (i >= queue_depth)
+                {
+                    LIST_ITEM_HANDLE front = singlylinkedlist_get_head_item(queue);
+                    PENDING_SEND* front_send = (PENDING_SEND*)singlylinkedlist_item_get_value(front);
+                    if (front_send->size != i - queue_depth)
+                    {
+                        result = __LINE__;
+                    }
+                    else
+                    {
+                        (void)singlylinkedlist_remove(queue, front);
+                        free(front_send);
+                    }
+                }
+            }
+        }
+
+        while ((head = singlylinkedlist_get_head_item(queue)) != NULL)
+        {
+            free((void*)singlylinkedlist_item_get_value(head));
+            (void)singlylinkedlist_remove(queue, head);
+        }
+
+        singlylinkedlist_destroy(queue);
+    }
+
+    return result;
+}
+
+static int run_scenario(const char* scenario_name, RUN_SCENARIO run, size_t queue_depth)
+{
+    int result;
+    clock_t start_time;
+    clock_t end_time;
+
+    start_time = clock();
+    result = run(queue_depth, OPERATIONS_PER_SCENARIO);
+    end_time = clock();
+
+    if (result != 0)
+    {
+        (void)printf("%s failed\r\n", scenario_name);
+    }
+    else
+    {
+        double elapsed_ms = ((double)(end_time - start_time) * 1000.0) / CLOCKS_PER_SEC;
+
+        if (elapsed_ms <= 0)
+        {
+            elapsed_ms = 1;
+        }
+
+        (void)printf("%-18s depth %5lu: %8.0f ms, %8.2f M operations/s\r\n",
+            scenario_name, (unsigned long)queue_depth, elapsed_ms, (double)OPERATIONS_PER_SCENARIO / (elapsed_ms * 1000.0));
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    static const size_t queue_depths[] = { 4, 64, 1024 };
+    int result = 0;
+    size_t i;
+
+    for (i = 0; (result == 0) && (i < sizeof(queue_depths) / sizeof(queue_depths[0])); i++)
+    {
+        result = run_scenario("DEQUE", deque_queue, queue_depths[i]);
+        if (result == 0)
+        {
+            result = run_scenario("VECTOR", vector_queue, queue_depths[i]);
+        }
+        if (result == 0)
+        {
+            result = run_scenario("singlylinkedlist", list_queue, queue_depths[i]);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <time.h>
+#include "azure_c_shared_utility/hmacsha256.h"
+#include "azure_c_shared_utility/buffer_.h"
+
+#define PAYLOAD_COUNT   1024
+#define ROUNDS          200
+
+static const unsigned char key[] = "0123456789abcdef0123456789abcdef";
+
+static unsigned char payload_bytes[PAYLOAD_COUNT * 256];
+static const unsigned char* payloads[PAYLOAD_COUNT];
+static size_t payload_lengths[PAYLOAD_COUNT];
+static BUFFER_HANDLE hashes[PAYLOAD_COUNT];
+
+typedef enum SCENARIO_TAG
+{
+    SCENARIO_COMPUTE_HASH,
+    SCENARIO_COMPUTE_HASH_WITH_KEY,
+    SCENARIO_COMPUTE_HASH_BATCH
+} SCENARIO;
+
+static int run_scenario(const char* scenario_name, SCENARIO scenario, HMACSHA256_KEY_HANDLE hmac_key, size_t payload_length)
+{
+    int result = 0;
+    clock_t start_time;
+    clock_t end_time;
+    size_t round;
+    size_t i;
+
+    for (i = 0; i < PAYLOAD_COUNT; i++)
+    {
+        payloads[i] = payload_bytes + (i * 256);
+        payload_lengths[i] = payload_length;
+    }
+
+    start_time = clock();
+
+    for (round = 0; (result == 0) && (round < ROUNDS); round++)
+    {
+        /* the HMACs are appended to the buffers, so every round starts with empty ones */
+        for (i = 0; i < PAYLOAD_COUNT; i++)
+        {
+            (void)BUFFER_unbuild(hashes[i]);
+        }
+
+        switch (scenario)
+        {
+        case SCENARIO_COMPUTE_HASH:
+            for (i = 0; i < PAYLOAD_COUNT; i++)
+            {
+                if (HMACSHA256_ComputeHash(key, sizeof(key) - 1, payloads[i], payload_lengths[i], hashes[i]) != HMACSHA256_OK)
+                {
+                    result = __LINE__;
+                    break;
+                }
+            }
+            break;
+        case SCENARIO_COMPUTE_HASH_WITH_KEY:
+            for (i = 0; i < PAYLOAD_COUNT; i++)
+            {
+                if (HMACSHA256_ComputeHashWithKey(hmac_key, payloads[i], payload_lengths[i], hashes[i]) != HMACSHA256_OK)
+                {
+                    result = __LINE__;
+                    break;
+                }
+            }
+            break;
+        default:
+            if (HMACSHA256_ComputeHashBatch(hmac_key, payloads, payload_lengths, PAYLOAD_COUNT, hashes) != HMACSHA256_OK)
+            {
+                result = __LINE__;
+            }
+            break;
+        }
+    }
+
+    end_time = clock();
+
+    if (result != 0)
+    {
+        (void)printf("Computing the HMACs failed for %s\r\n", scenario_name);
+    }
+    else
+    {
+        double elapsed_ms = ((double)(end_time - start_time) * 1000.0) / CLOCKS_PER_SEC;
+
+        if (elapsed_ms <= 0)
+        {
+            elapsed_ms = 1;
+        }
+
+        (void)printf("%-30s payloads of %3lu bytes: %8.0f ms, %12.0f HMACs/s\r\n",
+            scenario_name, (unsigned long)payload_length, elapsed_ms, ((double)PAYLOAD_COUNT * ROUNDS) / (elapsed_ms / 1000.0));
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    static const size_t payload_lengths_to_run[] = { 16, 48, 100, 256 };
+    int result = 0;
+    HMACSHA256_KEY_HANDLE hmac_key;
+    size_t i;
+
+    for (i = 0; i < sizeof(payload_bytes); i++)
+    {
+        payload_bytes[i] = (unsigned char)i;
+    }
+
+    for (i = 0; i < PAYLOAD_COUNT; i++)
+    {
+        if ((hashes[i] = BUFFER_new()) == NULL)
+        {
+            (void)printf("Cannot create the hash buffers\r\n");
+            result = __LINE__;
+            break;
+        }
+    }
+
+    if (result == 0)
+    {
+        if ((hmac_key = HMACSHA256_CreateKey(key, sizeof(key) - 1)) == NULL)
+        {
+            (void)printf("Cannot create the HMAC key\r\n");
+            result = __LINE__;
+        }
+        else
+        {
+            for (i = 0; (result == 0) && (i < sizeof(payload_lengths_to_run) / sizeof(payload_lengths_to_run[0])); i++)
+            {
+                result = run_scenario("HMACSHA256_ComputeHash", SCENARIO_COMPUTE_HASH, hmac_key, payload_lengths_to_run[i]);
+                if (result == 0)
+                {
+                    result = run_scenario("HMACSHA256_ComputeHashWithKey", SCENARIO_COMPUTE_HASH_WITH_KEY, hmac_key, payload_lengths_to_run[i]);
+                }
+                if (result == 0)
+                {
+                    result = run_scenario("HMACSHA256_ComputeHashBatch", SCENARIO_COMPUTE_HASH_BATCH, hmac_key, payload_lengths_to_run[i]);
+                }
+            }
+
+            HMACSHA256_DestroyKey(hmac_key);
+        }
+    }
+
+    for (i = 0; i < PAYLOAD_COUNT; i++)
+    {
+        BUFFER_delete(hashes[i]);
+    }
+
+    return result;
+}
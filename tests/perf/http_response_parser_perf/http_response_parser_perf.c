@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+#include "azure_c_shared_utility/http_response_parser.h"
+
+#define ITERATIONS  200000
+
+static const char CONTENT_LENGTH_RESPONSE[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: application/json; charset=utf-8\r\n"
+    "Content-Length: 256\r\n"
+    "Server: Microsoft-HTTPAPI/2.0\r\n"
+    "iothub-messageid: 5b8a0dc4-7b53-4a2e-9c51-1f1d0e32c0a2\r\n"
+    "iothub-correlationid: 0d2a33d3-6a3f-4e1a-a0f2-bd1d4c5c3f10\r\n"
+    "Date: Tue, 02 May 2017 18:30:00 GMT\r\n"
+    "\r\n"
+    "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+    "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+    "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+    "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef";
+
+static const char CHUNKED_RESPONSE[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: application/json; charset=utf-8\r\n"
+    "Transfer-Encoding: chunked\r\n"
+    "Server: Microsoft-HTTPAPI/2.0\r\n"
+    "Date: Tue, 02 May 2017 18:30:00 GMT\r\n"
+    "\r\n"
+    "40\r\n"
+    "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef\r\n"
+    "40\r\n"
+    "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef\r\n"
+    "80\r\n"
+    "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"
+    "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef\r\n"
+    "0\r\n"
+    "\r\n";
+
+static size_t body_bytes;
+
+static void on_status(void* context, int status_code, const char* reason_phrase, size_t reason_phrase_length)
+{
+    (void)context, (void)status_code, (void)reason_phrase, (void)reason_phrase_length;
+}
+
+static void on_header(void* context, const char* name, size_t name_length, const char* value, size_t value_length)
+{
+    (void)context, (void)name, (void)name_length, (void)value, (void)value_length;
+}
+
+static void on_headers_complete(void* context, bool is_chunked, size_t content_length)
+{
+    (void)context, (void)is_chunked, (void)content_length;
+}
+
+static void on_body(void* context, const unsigned char* buffer, size_t size)
+{
+    (void)context, (void)buffer;
+    body_bytes += size;
+}
+
+static int run_scenario(const char* scenario_name, const char* response, size_t response_size, size_t piece_size)
+{
+    int result;
+    HTTP_RESPONSE_PARSER_HANDLE http_response_parser = http_response_parser_create(on_status, on_header, on_headers_complete, on_body, NULL, NULL);
+    if (http_response_parser == NULL)
+    {
+        (void)printf("Cannot create the HTTP response parser\r\n");
+        result = __LINE__;
+    }
+    else
+    {
+        clock_t start_time;
+        clock_t end_time;
+        size_t i;
+
+        result = 0;
+        body_bytes = 0;
+        start_time = clock();
+
+        for (i = 0; (result == 0) && (i < ITERATIONS); i++)
+        {
+            size_t pos;
+
+            http_response_parser_reset(http_response_parser);
+            for (pos = 0; pos < response_size; pos += piece_size)
+            {
+                size_t size = ((response_size - pos) < piece_size) ? (response_size - pos) : piece_size;
+                if (http_response_parser_parse(http_response_parser, (const unsigned char*)response + pos, size, NULL) != 0)
+                {
+                    (void)printf("Parsing failed for %s\r\n", scenario_name);
+                    result = __LINE__;
+                    break;
+                }
+            }
+
+            if ((result == 0) &&
+                !http_response_parser_is_complete(http_response_parser))
+            {
+                (void)printf("Response not complete for %s\r\n", scenario_name);
+                result = __LINE__;
+            }
+        }
+
+        end_time = clock();
+
+        if (result == 0)
+        {
+            double elapsed_ms = ((double)(end_time - start_time) * 1000.0) / CLOCKS_PER_SEC;
+            double total_mb = ((double)response_size * ITERATIONS) / (1024.0 * 1024.0);
+
+            if (elapsed_ms <= 0)
+            {
+                elapsed_ms = 1;
+            }
+
+            (void)printf("%-12s pieces of %5lu bytes: %8.0f ms, %10.2f MB/s, %lu body bytes\r\n",
+                scenario_name, (unsigned long)piece_size, elapsed_ms, total_mb / (elapsed_ms / 1000.0), (unsigned long)body_bytes);
+        }
+
+        http_response_parser_destroy(http_response_parser);
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    static const size_t piece_sizes[] = { 1, 7, 64, 1460, 16384 };
+    int result = 0;
+    size_t i;
+
+    for (i = 0; (result == 0) && (i < sizeof(piece_sizes) / sizeof(piece_sizes[0])); i++)
+    {
+        result = run_scenario("length", CONTENT_LENGTH_RESPONSE, sizeof(CONTENT_LENGTH_RESPONSE) - 1, piece_sizes[i]);
+        if (result == 0)
+        {
+            result = run_scenario("chunked", CHUNKED_RESPONSE, sizeof(CHUNKED_RESPONSE) - 1, piece_sizes[i]);
+        }
+    }
+
+    return result;
+}
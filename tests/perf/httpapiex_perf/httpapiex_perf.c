@@ -0,0 +1,211 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+/* every scenario executes this many requests */
+#define REQUESTS_PER_SCENARIO   (1024 * 1024)
+#define RESPONSE_BODY_SIZE      200
+
+static size_t allocation_count;
+
+static void* counting_malloc(size_t size)
+{
+    allocation_count++;
+    return malloc(size);
+}
+
+static void* counting_realloc(void* ptr, size_t size)
+{
+    allocation_count++;
+    return realloc(ptr, size);
+}
+
+/* httpapiex.c and everything it allocates through per request are compiled in here, with their allocations routed through the counters above */
+#define GBALLOC_H
+#define malloc counting_malloc
+#define realloc counting_realloc
+#include "crt_abstractions.c"
+#include "arena.c"
+#include "buffer.c"
+#include "map.c"
+#include "httpheaders.c"
+#include "httpapiex.c"
+#undef malloc
+#undef realloc
+
+static unsigned char response_body[RESPONSE_BODY_SIZE];
+
+/* an HTTPAPI that answers every request at once with the headers and body of a typical service response */
+HTTPAPI_RESULT HTTPAPI_Init(void)
+{
+    return HTTPAPI_OK;
+}
+
+void HTTPAPI_Deinit(void)
+{
+}
+
+HTTP_HANDLE HTTPAPI_CreateConnection(const char* hostName)
+{
+    (void)hostName;
+    return (HTTP_HANDLE)response_body;
+}
+
+void HTTPAPI_CloseConnection(HTTP_HANDLE handle)
+{
+    (void)handle;
+}
+
+HTTPAPI_RESULT HTTPAPI_ExecuteRequest(HTTP_HANDLE handle, HTTPAPI_REQUEST_TYPE requestType, const char* relativePath,
+    HTTP_HEADERS_HANDLE httpHeadersHandle, const unsigned char* content,
+    size_t contentLength, unsigned int* statusCode,
+    HTTP_HEADERS_HANDLE responseHeadersHandle, BUFFER_HANDLE responseContent)
+{
+    HTTPAPI_RESULT result;
+    size_t header_count;
+
+    (void)handle;
+    (void)requestType;
+    (void)relativePath;
+    (void)content;
+    (void)contentLength;
+
+    if ((HTTPHeaders_GetHeaderCount(httpHeadersHandle, &header_count) != HTTP_HEADERS_OK) ||
+        (HTTPHeaders_ReplaceHeaderNameValuePair(responseHeadersHandle, "Content-Type", "application/json; charset=utf-8") != HTTP_HEADERS_OK) ||
+        (HTTPHeaders_ReplaceHeaderNameValuePair(responseHeadersHandle, "Content-Length", "200") != HTTP_HEADERS_OK) ||
+        (HTTPHeaders_ReplaceHeaderNameValuePair(responseHeadersHandle, "Date", "Sun, 18 Oct 2026 10:00:00 GMT") != HTTP_HEADERS_OK) ||
+        (HTTPHeaders_ReplaceHeaderNameValuePair(responseHeadersHandle, "ETag", "\"0x8D4BCC2E4835CD0\"") != HTTP_HEADERS_OK) ||
+        (HTTPHeaders_ReplaceHeaderNameValuePair(responseHeadersHandle, "Server", "Microsoft-HTTPAPI/2.0") != HTTP_HEADERS_OK) ||
+        (HTTPHeaders_ReplaceHeaderNameValuePair(responseHeadersHandle, "iothub-errorcode", "ServerError") != HTTP_HEADERS_OK) ||
+        (BUFFER_build(responseContent, response_body, sizeof(response_body)) != 0))
+    {
+        result = HTTPAPI_ERROR;
+    }
+    else
+    {
+        *statusCode = 200;
+        result = HTTPAPI_OK;
+    }
+
+    return result;
+}
+
+HTTPAPI_RESULT HTTPAPI_SetOption(HTTP_HANDLE handle, const char* optionName, const void* value)
+{
+    (void)handle;
+    (void)optionName;
+    (void)value;
+    return HTTPAPI_OK;
+}
+
+HTTPAPI_RESULT HTTPAPI_CloneOption(const char* optionName, const void* value, const void** savedValue)
+{
+    (void)optionName;
+    (void)value;
+    *savedValue = NULL;
+    return HTTPAPI_OK;
+}
+
+typedef int(*RUN_ONE)(HTTPAPIEX_HANDLE httpapiex, HTTP_HEADERS_HANDLE request_headers, BUFFER_HANDLE request_body, HTTP_HEADERS_HANDLE response_headers, BUFFER_HANDLE response_body_buffer);
+
+/* a caller that is only interested in the status code, everything else is a temporary of HTTPAPIEX */
+static int temporaries(HTTPAPIEX_HANDLE httpapiex, HTTP_HEADERS_HANDLE request_headers, BUFFER_HANDLE request_body, HTTP_HEADERS_HANDLE response_headers, BUFFER_HANDLE response_body_buffer)
+{
+    unsigned int status_code;
+
+    (void)request_headers;
+    (void)request_body;
+    (void)response_headers;
+    (void)response_body_buffer;
+
+    return ((HTTPAPIEX_ExecuteRequest(httpapiex, HTTPAPI_REQUEST_GET, "/devices/perf/messages/deviceBound?api-version=2016-11-14", NULL, NULL, &status_code, NULL, NULL) != HTTPAPIEX_OK) ||
+        (status_code != 200)) ? __LINE__ : 0;
+}
+
+/* a caller that supplies all the headers and buffers, as the IoT Hub HTTP transport does */
+static int caller_objects(HTTPAPIEX_HANDLE httpapiex, HTTP_HEADERS_HANDLE request_headers, BUFFER_HANDLE request_body, HTTP_HEADERS_HANDLE response_headers, BUFFER_HANDLE response_body_buffer)
+{
+    unsigned int status_code;
+
+    return ((HTTPAPIEX_ExecuteRequest(httpapiex, HTTPAPI_REQUEST_POST, "/devices/perf/messages/events?api-version=2016-11-14", request_headers, request_body, &status_code, response_headers, response_body_buffer) != HTTPAPIEX_OK) ||
+        (status_code != 200)) ? __LINE__ : 0;
+}
+
+static int run_scenario(const char* scenario_name, RUN_ONE run_one)
+{
+    int result = 0;
+    HTTPAPIEX_HANDLE httpapiex = HTTPAPIEX_Create("perf.azure-devices.net");
+    HTTP_HEADERS_HANDLE request_headers = HTTPHeaders_Alloc();
+    HTTP_HEADERS_HANDLE response_headers = HTTPHeaders_Alloc();
+    BUFFER_HANDLE request_body = BUFFER_create(response_body, sizeof(response_body));
+    BUFFER_HANDLE response_body_buffer = BUFFER_new();
+    clock_t start_time;
+    clock_t end_time;
+    size_t i;
+
+    if ((httpapiex == NULL) ||
+        (request_headers == NULL) ||
+        (response_headers == NULL) ||
+        (request_body == NULL) ||
+        (response_body_buffer == NULL) ||
+        (HTTPHeaders_AddHeaderNameValuePair(request_headers, "Authorization", "SharedAccessSignature sr=perf.azure-devices.net&sig=x&se=1") != HTTP_HEADERS_OK) ||
+        (HTTPHeaders_AddHeaderNameValuePair(request_headers, "Content-Type", "application/octet-stream") != HTTP_HEADERS_OK) ||
+        (HTTPHeaders_AddHeaderNameValuePair(request_headers, "Accept", "application/json") != HTTP_HEADERS_OK) ||
+        (run_one(httpapiex, request_headers, request_body, response_headers, response_body_buffer) != 0))
+    {
+        (void)printf("%s failed\r\n", scenario_name);
+        result = __LINE__;
+    }
+    else
+    {
+        allocation_count = 0;
+        start_time = clock();
+        for (i = 0; (result == 0) && (i < REQUESTS_PER_SCENARIO); i++)
+        {
+            result = run_one(httpapiex, request_headers, request_body, response_headers, response_body_buffer);
+        }
+        end_time = clock();
+
+        if (result != 0)
+        {
+            (void)printf("%s failed\r\n", scenario_name);
+        }
+        else
+        {
+            double elapsed_ms = ((double)(end_time - start_time) * 1000.0) / CLOCKS_PER_SEC;
+
+            if (elapsed_ms <= 0)
+            {
+                elapsed_ms = 1;
+            }
+
+            (void)printf("%-16s: %6.0f ms, %9.0f requests/s, %5.2f allocations/request\r\n",
+                scenario_name, elapsed_ms, REQUESTS_PER_SCENARIO / (elapsed_ms / 1000.0), (double)allocation_count / REQUESTS_PER_SCENARIO);
+        }
+    }
+
+    BUFFER_delete(response_body_buffer);
+    BUFFER_delete(request_body);
+    HTTPHeaders_Free(response_headers);
+    HTTPHeaders_Free(request_headers);
+    HTTPAPIEX_Destroy(httpapiex);
+    return result;
+}
+
+int main(void)
+{
+    int result;
+
+    result = run_scenario("temporaries", temporaries);
+    if (result == 0)
+    {
+        result = run_scenario("caller objects", caller_objects);
+    }
+
+    return result;
+}
@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "azure_c_shared_utility/sastoken.h"
+#include "azure_c_shared_utility/strings.h"
+
+#define DEVICE_COUNT    20000
+#define SCOPE_SIZE      64
+
+static const char TEST_KEY[] = "AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGxwdHh8=";
+static const char TEST_KEY_NAME[] = "provisioningservice";
+
+static SAS_TOKEN_REQUEST requests[DEVICE_COUNT];
+static char scopes[DEVICE_COUNT][SCOPE_SIZE];
+static STRING_HANDLE single_tokens[DEVICE_COUNT];
+static STRING_HANDLE batch_tokens[DEVICE_COUNT];
+
+static double elapsed_seconds(clock_t start_time, clock_t end_time)
+{
+    double result = (double)(end_time - start_time) / CLOCKS_PER_SEC;
+    return (result <= 0) ? (1.0 / CLOCKS_PER_SEC) : result;
+}
+
+int main(void)
+{
+    int result = 0;
+    clock_t start_time;
+    double single_seconds;
+    double batch_seconds;
+    size_t i;
+
+    for (i = 0; i < DEVICE_COUNT; i++)
+    {
+        (void)sprintf(scopes[i], "myhub.azure-devices.net/devices/device%05lu", (unsigned long)i);
+        requests[i].key = TEST_KEY;
+        requests[i].scope = scopes[i];
+        requests[i].keyName = TEST_KEY_NAME;
+        requests[i].expiry = 1500000000 + i;
+    }
+
+    start_time = clock();
+    for (i = 0; i < DEVICE_COUNT; i++)
+    {
+        if ((single_tokens[i] = SASToken_CreateString(requests[i].key, requests[i].scope, requests[i].keyName, requests[i].expiry)) == NULL)
+        {
+            (void)printf("SASToken_CreateString failed for device %lu\r\n", (unsigned long)i);
+            result = __LINE__;
+            break;
+        }
+    }
+    single_seconds = elapsed_seconds(start_time, clock());
+
+    if (result == 0)
+    {
+        start_time = clock();
+        if (SASToken_CreateBatch(requests, DEVICE_COUNT, batch_tokens) != 0)
+        {
+            (void)printf("SASToken_CreateBatch failed\r\n");
+            result = __LINE__;
+        }
+        else
+        {
+            batch_seconds = elapsed_seconds(start_time, clock());
+
+            for (i = 0; i < DEVICE_COUNT; i++)
+            {
+                if (strcmp(STRING_c_str(single_tokens[i]), STRING_c_str(batch_tokens[i])) != 0)
+                {
+                    (void)printf("Token mismatch for device %lu\r\n", (unsigned long)i);
+                    result = __LINE__;
+                    break;
+                }
+            }
+
+            if (result == 0)
+            {
+                (void)printf("SASToken_CreateString: %10.0f tokens/s\r\n", DEVICE_COUNT / single_seconds);
+                (void)printf("SASToken_CreateBatch:  %10.0f tokens/s\r\n", DEVICE_COUNT / batch_seconds);
+            }
+
+            for (i = 0; i < DEVICE_COUNT; i++)
+            {
+                STRING_delete(batch_tokens[i]);
+            }
+        }
+    }
+
+    for (i = 0; i < DEVICE_COUNT; i++)
+    {
+        STRING_delete(single_tokens[i]);
+    }
+
+    return result;
+}
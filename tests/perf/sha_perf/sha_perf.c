@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <time.h>
+#include "azure_c_shared_utility/sha.h"
+
+/* every scenario hashes this many bytes in total */
+#define BYTES_PER_SCENARIO  (64 * 1024 * 1024)
+
+static unsigned char message[64 * 1024];
+
+static int run_scenario(const char* scenario_name, enum SHAversion whichSha, size_t message_size)
+{
+    int result = 0;
+    size_t iterations = BYTES_PER_SCENARIO / message_size;
+    uint8_t digest[USHAMaxHashSize];
+    clock_t start_time;
+    clock_t end_time;
+    size_t i;
+
+    start_time = clock();
+
+    for (i = 0; (result == 0) && (i < iterations); i++)
+    {
+        USHAContext context;
+        if ((USHAReset(&context, whichSha) != shaSuccess) ||
+            (USHAInput(&context, message, (unsigned int)message_size) != shaSuccess) ||
+            (USHAResult(&context, digest) != shaSuccess))
+        {
+            (void)printf("Hashing failed for %s\r\n", scenario_name);
+            result = __LINE__;
+        }
+    }
+
+    end_time = clock();
+
+    if (result == 0)
+    {
+        double elapsed_ms = ((double)(end_time - start_time) * 1000.0) / CLOCKS_PER_SEC;
+        double total_mb = ((double)message_size * iterations) / (1024.0 * 1024.0);
+
+        if (elapsed_ms <= 0)
+        {
+            elapsed_ms = 1;
+        }
+
+        (void)printf("%-8s messages of %6lu bytes: %8.0f ms, %10.2f MB/s, %12.0f hashes/s\r\n",
+            scenario_name, (unsigned long)message_size, elapsed_ms, total_mb / (elapsed_ms / 1000.0), (double)iterations / (elapsed_ms / 1000.0));
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    static const size_t message_sizes[] = { 16, 64, 256, 1024, 8192, 65536 };
+    int result = 0;
+    size_t i;
+
+    for (i = 0; i < sizeof(message); i++)
+    {
+        message[i] = (unsigned char)i;
+    }
+
+    for (i = 0; (result == 0) && (i < sizeof(message_sizes) / sizeof(message_sizes[0])); i++)
+    {
+        result = run_scenario("SHA1", SHA1, message_sizes[i]);
+        if (result == 0)
+        {
+            result = run_scenario("SHA256", SHA256, message_sizes[i]);
+        }
+        if (result == 0)
+        {
+            result = run_scenario("SHA512", SHA512, message_sizes[i]);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,255 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include "azure_c_shared_utility/slaballoc.h"
+#include "azure_c_shared_utility/threadapi.h"
+
+/* singlylinkedlist.c is compiled in here with its items coming from slaballoc, whether they do depends on slaballoc being initialized */
+#define GBALLOC_H
+#define SLABALLOC_FOR_THIS
+#include "singlylinkedlist.c"
+
+/* every scenario allocates and frees this many objects in total */
+#define OPERATIONS_PER_SCENARIO     (16 * 1024 * 1024)
+/* objects kept alive at any time, so that frees do not simply undo the last allocation */
+#define LIVE_OBJECTS                1024
+/* pending IO lists rarely hold more than a handful of items */
+#define QUEUE_LENGTH                16
+#define THREAD_COUNT                4
+
+/* the sizes of list items, pending IOs, BUFFER and STRING handles on a 64 bit build */
+static const size_t object_sizes[] = { 16, 40, 32, 48 };
+#define OBJECT_SIZE(i) object_sizes[(i) % (sizeof(object_sizes) / sizeof(object_sizes[0]))]
+
+typedef struct ALLOCATOR_TAG
+{
+    const char* name;
+    void*(*allocate)(size_t size);
+    void(*release)(void* ptr);
+    int use_slaballoc;
+} ALLOCATOR;
+
+static void* heap_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void heap_free(void* ptr)
+{
+    free(ptr);
+}
+
+static const ALLOCATOR allocators[] =
+{
+    { "malloc", heap_malloc, heap_free, 0 },
+    { "slaballoc", slaballoc_malloc, slaballoc_free, 1 }
+};
+
+typedef int(*RUN_SCENARIO)(const ALLOCATOR* allocator, size_t operations);
+
+/* allocate and immediately free, the best case for any allocator */
+static int allocate_free(const ALLOCATOR* allocator, size_t operations)
+{
+    int result = 0;
+    size_t i;
+
+    for (i = 0; (result == 0) && (i < operations); i++)
+    {
+        unsigned char* object = (unsigned char*)allocator->allocate(OBJECT_SIZE(i));
+        if (object == NULL)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            object[0] = 'x';
+            allocator->release(object);
+        }
+    }
+
+    return result;
+}
+
+/* objects of mixed sizes freed in the order they were allocated, as pending sends and list items are */
+static int fifo(const ALLOCATOR* allocator, size_t operations)
+{
+    int result = 0;
+    void* live[LIVE_OBJECTS];
+    size_t i;
+
+    (void)memset(live, 0, sizeof(live));
+
+    for (i = 0; (result == 0) && (i < operations); i++)
+    {
+        size_t slot = i % LIVE_OBJECTS;
+        allocator->release(live[slot]);
+        if ((live[slot] = allocator->allocate(OBJECT_SIZE(i))) == NULL)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            *(unsigned char*)live[slot] = 'x';
+        }
+    }
+
+    for (i = 0; i < LIVE_OBJECTS; i++)
+    {
+        allocator->release(live[i]);
+    }
+
+    return result;
+}
+
+typedef struct FIFO_THREAD_TAG
+{
+    const ALLOCATOR* allocator;
+    size_t operations;
+} FIFO_THREAD;
+
+static int fifo_thread(void* arg)
+{
+    FIFO_THREAD* fifo_thread_arg = (FIFO_THREAD*)arg;
+    return fifo(fifo_thread_arg->allocator, fifo_thread_arg->operations);
+}
+
+/* the same work spread over several threads allocating at once */
+static int fifo_threads(const ALLOCATOR* allocator, size_t operations)
+{
+    int result = 0;
+    THREAD_HANDLE threads[THREAD_COUNT];
+    FIFO_THREAD fifo_thread_arg;
+    size_t started;
+    size_t i;
+
+    fifo_thread_arg.allocator = allocator;
+    fifo_thread_arg.operations = operations / THREAD_COUNT;
+
+    for (started = 0; started < THREAD_COUNT; started++)
+    {
+        if (ThreadAPI_Create(&threads[started], fifo_thread, &fifo_thread_arg) != THREADAPI_OK)
+        {
+            result = __LINE__;
+            break;
+        }
+    }
+
+    for (i = 0; i < started; i++)
+    {
+        int thread_result;
+        if ((ThreadAPI_Join(threads[i], &thread_result) != THREADAPI_OK) ||
+            (thread_result != 0))
+        {
+            result = __LINE__;
+        }
+    }
+
+    return result;
+}
+
+/* a pending IO list: add at the tail, complete from the head */
+static int list_queue(const ALLOCATOR* allocator, size_t operations)
+{
+    int result = 0;
+    SINGLYLINKEDLIST_HANDLE list = singlylinkedlist_create();
+    size_t i;
+
+    (void)allocator;
+
+    if (list == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        for (i = 0; (result == 0) && (i < operations); i++)
+        {
+            if (singlylinkedlist_add(list, &result) == NULL)
+            {
+                result = __LINE__;
+            }
+            else if ((i >= QUEUE_LENGTH) &&
+                (singlylinkedlist_remove(list, singlylinkedlist_get_head_item(list)) != 0))
+            {
+                result = __LINE__;
+            }
+        }
+
+        singlylinkedlist_destroy(list);
+    }
+
+    return result;
+}
+
+/* clock() is the processor time of all threads together, so the threaded scenario shows the total cost of the work rather than its duration */
+static int run_scenario(const char* scenario_name, RUN_SCENARIO run, const ALLOCATOR* allocator)
+{
+    int result;
+    clock_t start_time;
+    clock_t end_time;
+
+    if ((allocator->use_slaballoc) &&
+        (slaballoc_init() != 0))
+    {
+        (void)printf("%s: slaballoc_init failed\r\n", scenario_name);
+        result = __LINE__;
+    }
+    else
+    {
+        start_time = clock();
+        result = run(allocator, OPERATIONS_PER_SCENARIO);
+        end_time = clock();
+
+        if (result != 0)
+        {
+            (void)printf("%s with %s failed\r\n", scenario_name, allocator->name);
+        }
+        else
+        {
+            double elapsed_ms = ((double)(end_time - start_time) * 1000.0) / CLOCKS_PER_SEC;
+
+            if (elapsed_ms <= 0)
+            {
+                elapsed_ms = 1;
+            }
+
+            (void)printf("%-20s %-10s: %6.0f ms, %7.2f M allocations/s\r\n",
+                scenario_name, allocator->name, elapsed_ms, (OPERATIONS_PER_SCENARIO / 1000000.0) / (elapsed_ms / 1000.0));
+        }
+
+        slaballoc_deinit();
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    int result = 0;
+    size_t i;
+
+    /* "malloc" is slaballoc off: the list then gets its items from the heap */
+    for (i = 0; (result == 0) && (i < sizeof(allocators) / sizeof(allocators[0])); i++)
+    {
+        result = run_scenario("allocate/free", allocate_free, &allocators[i]);
+        if (result == 0)
+        {
+            result = run_scenario("fifo", fifo, &allocators[i]);
+        }
+        if (result == 0)
+        {
+            result = run_scenario("fifo, 4 threads", fifo_threads, &allocators[i]);
+        }
+        if (result == 0)
+        {
+            result = run_scenario("singlylinkedlist", list_queue, &allocators[i]);
+        }
+    }
+
+    return result;
+}
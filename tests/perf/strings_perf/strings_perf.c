@@ -0,0 +1,202 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include "azure_c_shared_utility/strings.h"
+#include "azure_c_shared_utility/map.h"
+
+/* every scenario produces this many characters in total */
+#define BYTES_PER_SCENARIO  (16 * 1024 * 1024)
+/* strings are built by appending pieces of this size, like a JSON or header builder would */
+#define PIECE_LENGTH        16
+#define MAX_MAP_ENTRIES     1024
+
+typedef int(*RUN_ONCE)(size_t string_size);
+
+static const char piece[PIECE_LENGTH + 1] = "\"name\":\"value\", ";
+static MAP_HANDLE map;
+
+static int build_with_concat(size_t string_size)
+{
+    int result = 0;
+    STRING_HANDLE built = STRING_new();
+    size_t i;
+
+    for (i = 0; (result == 0) && (i < string_size / PIECE_LENGTH); i++)
+    {
+        result = STRING_concat(built, piece);
+    }
+
+    STRING_delete(built);
+    return ((built == NULL) || (result != 0)) ? __LINE__ : 0;
+}
+
+static int build_with_concat_n(size_t string_size)
+{
+    int result = 0;
+    STRING_HANDLE built = STRING_new();
+    size_t i;
+
+    for (i = 0; (result == 0) && (i < string_size / PIECE_LENGTH); i++)
+    {
+        result = STRING_concat_n(built, piece, PIECE_LENGTH);
+    }
+
+    STRING_delete(built);
+    return ((built == NULL) || (result != 0)) ? __LINE__ : 0;
+}
+
+static int build_with_reserve(size_t string_size)
+{
+    int result;
+    STRING_HANDLE built = STRING_new();
+    size_t i;
+
+    result = STRING_reserve(built, string_size);
+    for (i = 0; (result == 0) && (i < string_size / PIECE_LENGTH); i++)
+    {
+        result = STRING_concat_n(built, piece, PIECE_LENGTH);
+    }
+
+    STRING_delete(built);
+    return ((built == NULL) || (result != 0)) ? __LINE__ : 0;
+}
+
+static int build_with_sprintf(size_t string_size)
+{
+    int result = 0;
+    STRING_HANDLE built = STRING_new();
+    size_t i;
+
+    /* every piece is PIECE_LENGTH characters: "name":"12345", */
+    for (i = 0; (result == 0) && (i < string_size / PIECE_LENGTH); i++)
+    {
+        result = STRING_sprintf(built, "\"name\":\"%05lu\", ", (unsigned long)(i % 100000));
+    }
+
+    STRING_delete(built);
+    return ((built == NULL) || (result != 0)) ? __LINE__ : 0;
+}
+
+static int map_to_json(size_t string_size)
+{
+    STRING_HANDLE json = Map_ToJSON(map);
+    int failed = (json == NULL) || (STRING_length(json) != string_size);
+    STRING_delete(json);
+    return failed ? __LINE__ : 0;
+}
+
+static int run_scenario(const char* scenario_name, RUN_ONCE run_once, size_t string_size)
+{
+    int result = 0;
+    size_t iterations = BYTES_PER_SCENARIO / string_size;
+    clock_t start_time;
+    clock_t end_time;
+    size_t i;
+
+    start_time = clock();
+
+    for (i = 0; (result == 0) && (i < iterations); i++)
+    {
+        result = run_once(string_size);
+        if (result != 0)
+        {
+            (void)printf("%s failed\r\n", scenario_name);
+        }
+    }
+
+    end_time = clock();
+
+    if (result == 0)
+    {
+        double elapsed_ms = ((double)(end_time - start_time) * 1000.0) / CLOCKS_PER_SEC;
+        double total_mb = ((double)string_size * iterations) / (1024.0 * 1024.0);
+
+        if (elapsed_ms <= 0)
+        {
+            elapsed_ms = 1;
+        }
+
+        (void)printf("%-18s %8lu chars: %8.0f ms, %10.2f MB/s\r\n",
+            scenario_name, (unsigned long)string_size, elapsed_ms, total_mb / (elapsed_ms / 1000.0));
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    static const size_t string_sizes[] = { 64, 1024, 16 * 1024 };
+    static const size_t map_entries[] = { 4, 64, MAX_MAP_ENTRIES };
+    int result = 0;
+    size_t i;
+
+    for (i = 0; (result == 0) && (i < sizeof(string_sizes) / sizeof(string_sizes[0])); i++)
+    {
+        result = run_scenario("STRING_concat", build_with_concat, string_sizes[i]);
+        if (result == 0)
+        {
+            result = run_scenario("STRING_concat_n", build_with_concat_n, string_sizes[i]);
+        }
+        if (result == 0)
+        {
+            result = run_scenario("STRING_reserve", build_with_reserve, string_sizes[i]);
+        }
+        if (result == 0)
+        {
+            result = run_scenario("STRING_sprintf", build_with_sprintf, string_sizes[i]);
+        }
+    }
+
+    for (i = 0; (result == 0) && (i < sizeof(map_entries) / sizeof(map_entries[0])); i++)
+    {
+        map = Map_Create(NULL);
+        if (map == NULL)
+        {
+            (void)printf("Map_Create failed\r\n");
+            result = __LINE__;
+        }
+        else
+        {
+            STRING_HANDLE json;
+            size_t j;
+
+            for (j = 0; (result == 0) && (j < map_entries[i]); j++)
+            {
+                char key[16];
+                char value[16];
+                (void)sprintf(key, "key%04lu", (unsigned long)j);
+                (void)sprintf(value, "value%04lu", (unsigned long)j);
+                if (Map_Add(map, key, value) != MAP_OK)
+                {
+                    (void)printf("Map_Add failed\r\n");
+                    result = __LINE__;
+                }
+            }
+
+            /* the scenario size is the length of the JSON */
+            if (result == 0)
+            {
+                json = Map_ToJSON(map);
+                if (json == NULL)
+                {
+                    (void)printf("Map_ToJSON failed\r\n");
+                    result = __LINE__;
+                }
+                else
+                {
+                    result = run_scenario("Map_ToJSON", map_to_json, STRING_length(json));
+                    STRING_delete(json);
+                }
+            }
+
+            Map_Destroy(map);
+        }
+    }
+
+    return result;
+}
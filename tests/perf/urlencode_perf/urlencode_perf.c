@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include "azure_c_shared_utility/urlencode.h"
+#include "azure_c_shared_utility/strings.h"
+
+/* every scenario encodes (or decodes back) this many characters in total */
+#define BYTES_PER_SCENARIO  (64 * 1024 * 1024)
+#define MAX_TEXT_SIZE       (1024 * 1024)
+/* every character encodes to at most 6 */
+#define MAX_ENCODED_SIZE    (MAX_TEXT_SIZE * 6 + 1)
+
+typedef int(*RUN_ONCE)(size_t text_size);
+
+/* the text is made of this sample resource path, so that the mix of kept and escaped characters is a realistic one */
+static const char sample_path[] = "/devices/my device-01/messages/events?api-version=2016-11-14&sr=contoso.azure-devices.net%2fdevices&caf\xe9";
+
+static char* text;
+static char* encoded;
+static size_t encoded_size;
+static char* decoded;
+
+static int encode_string(size_t text_size)
+{
+    STRING_HANDLE result = URL_EncodeString(text);
+    (void)text_size;
+    STRING_delete(result);
+    return (result == NULL) ? __LINE__ : 0;
+}
+
+static int encode_into(size_t text_size)
+{
+    size_t encoded_length;
+    return URL_Encode_Into(text, text_size, encoded, MAX_ENCODED_SIZE, &encoded_length);
+}
+
+static int decode_string(size_t text_size)
+{
+    STRING_HANDLE result = URL_DecodeString(encoded);
+    int failed = (result == NULL) || (STRING_length(result) != text_size);
+    STRING_delete(result);
+    return failed ? __LINE__ : 0;
+}
+
+static int decode_into(size_t text_size)
+{
+    size_t decoded_length;
+    return ((URL_Decode_Into(encoded, encoded_size, decoded, MAX_TEXT_SIZE + 1, &decoded_length) != 0) || (decoded_length != text_size)) ? __LINE__ : 0;
+}
+
+static int run_scenario(const char* scenario_name, RUN_ONCE run_once, size_t text_size)
+{
+    int result = 0;
+    size_t iterations = BYTES_PER_SCENARIO / text_size;
+    clock_t start_time;
+    clock_t end_time;
+    size_t i;
+
+    start_time = clock();
+
+    for (i = 0; (result == 0) && (i < iterations); i++)
+    {
+        result = run_once(text_size);
+        if (result != 0)
+        {
+            (void)printf("%s failed\r\n", scenario_name);
+        }
+    }
+
+    end_time = clock();
+
+    if (result == 0)
+    {
+        double elapsed_ms = ((double)(end_time - start_time) * 1000.0) / CLOCKS_PER_SEC;
+        double total_mb = ((double)text_size * iterations) / (1024.0 * 1024.0);
+
+        if (elapsed_ms <= 0)
+        {
+            elapsed_ms = 1;
+        }
+
+        (void)printf("%-18s %8lu chars: %8.0f ms, %10.2f MB/s\r\n",
+            scenario_name, (unsigned long)text_size, elapsed_ms, total_mb / (elapsed_ms / 1000.0));
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    static const size_t text_sizes[] = { 32, 256, 4 * 1024, 64 * 1024, MAX_TEXT_SIZE };
+    int result = 0;
+    size_t i;
+
+    text = (char*)malloc(MAX_TEXT_SIZE + 1);
+    encoded = (char*)malloc(MAX_ENCODED_SIZE);
+    decoded = (char*)malloc(MAX_TEXT_SIZE + 1);
+    if ((text == NULL) || (encoded == NULL) || (decoded == NULL))
+    {
+        (void)printf("Allocation failed\r\n");
+        result = __LINE__;
+    }
+    else
+    {
+        for (i = 0; (result == 0) && (i < sizeof(text_sizes) / sizeof(text_sizes[0])); i++)
+        {
+            size_t j;
+            for (j = 0; j < text_sizes[i]; j++)
+            {
+                text[j] = sample_path[j % (sizeof(sample_path) - 1)];
+            }
+            text[text_sizes[i]] = '\0';
+
+            result = run_scenario("URL_EncodeString", encode_string, text_sizes[i]);
+            if (result == 0)
+            {
+                result = run_scenario("URL_Encode_Into", encode_into, text_sizes[i]);
+            }
+            /* the decoders work on the encoding of the current text */
+            if ((result == 0) && (URL_Encode_Into(text, text_sizes[i], encoded, MAX_ENCODED_SIZE, &encoded_size) != 0))
+            {
+                result = __LINE__;
+            }
+            if (result == 0)
+            {
+                result = run_scenario("URL_DecodeString", decode_string, text_sizes[i]);
+            }
+            if (result == 0)
+            {
+                result = run_scenario("URL_Decode_Into", decode_into, text_sizes[i]);
+            }
+        }
+    }
+
+    free(text);
+    free(encoded);
+    free(decoded);
+
+    return result;
+}
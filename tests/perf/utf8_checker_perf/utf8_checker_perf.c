@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "azure_c_shared_utility/utf8_checker.h"
+
+/* every scenario checks this many bytes in total */
+#define BYTES_PER_SCENARIO  (256 * 1024 * 1024)
+#define MAX_TEXT_SIZE       (1024 * 1024)
+/* the streaming scenarios get the text in pieces of the size of a typical WebSocket frame */
+#define FRAGMENT_SIZE       1400
+
+typedef int(*RUN_ONCE)(size_t text_size);
+
+static const char ascii_sample[] = "{\"deviceId\":\"my-device-01\",\"temperature\":21.5,\"humidity\":44,\"status\":\"ok\"}";
+/* latin, greek, CJK and emoji, so that 1, 2, 3 and 4 bytes sequences are all there */
+static const char mixed_sample[] = "{\"name\":\"caf\xc3\xa9 \xce\xb1\xce\xb2\xce\xb3 \xe6\xb8\xa9\xe5\xba\xa6 \xf0\x9f\x98\x80\",\"value\":21.5}";
+
+static unsigned char* text;
+
+static int is_valid_utf8(size_t text_size)
+{
+    return utf8_checker_is_valid_utf8(text, text_size) ? 0 : __LINE__;
+}
+
+static int update_fragments(size_t text_size)
+{
+    UTF8_CHECKER_STATE state;
+    size_t position;
+    bool is_valid = true;
+
+    utf8_checker_init(&state);
+    for (position = 0; is_valid && (position < text_size); position += FRAGMENT_SIZE)
+    {
+        size_t fragment_size = text_size - position;
+        if (fragment_size > FRAGMENT_SIZE)
+        {
+            fragment_size = FRAGMENT_SIZE;
+        }
+
+        is_valid = utf8_checker_update(&state, text + position, fragment_size);
+    }
+
+    return (is_valid && utf8_checker_final(&state)) ? 0 : __LINE__;
+}
+
+static int run_scenario(const char* scenario_name, RUN_ONCE run_once, size_t text_size)
+{
+    int result = 0;
+    size_t iterations = BYTES_PER_SCENARIO / text_size;
+    clock_t start_time;
+    clock_t end_time;
+    size_t i;
+
+    start_time = clock();
+
+    for (i = 0; (result == 0) && (i < iterations); i++)
+    {
+        result = run_once(text_size);
+        if (result != 0)
+        {
+            (void)printf("%s failed\r\n", scenario_name);
+        }
+    }
+
+    end_time = clock();
+
+    if (result == 0)
+    {
+        double elapsed_ms = ((double)(end_time - start_time) * 1000.0) / CLOCKS_PER_SEC;
+        double total_mb = ((double)text_size * iterations) / (1024.0 * 1024.0);
+
+        if (elapsed_ms <= 0)
+        {
+            elapsed_ms = 1;
+        }
+
+        (void)printf("%-24s %8lu bytes: %8.0f ms, %10.2f MB/s\r\n",
+            scenario_name, (unsigned long)text_size, elapsed_ms, total_mb / (elapsed_ms / 1000.0));
+    }
+
+    return result;
+}
+
+/* fills text_size bytes with copies of sample, without cutting a sequence at the end */
+static void fill_text(const char* sample, size_t sample_length, size_t text_size)
+{
+    size_t filled = 0;
+
+    while (filled + sample_length <= text_size)
+    {
+        (void)memcpy(text + filled, sample, sample_length);
+        filled += sample_length;
+    }
+    while (filled < text_size)
+    {
+        text[filled++] = ' ';
+    }
+}
+
+int main(void)
+{
+    static const size_t text_sizes[] = { 32, 256, 4 * 1024, 64 * 1024, MAX_TEXT_SIZE };
+    int result = 0;
+    size_t i;
+
+    text = (unsigned char*)malloc(MAX_TEXT_SIZE);
+    if (text == NULL)
+    {
+        (void)printf("Allocation failed\r\n");
+        result = __LINE__;
+    }
+    else
+    {
+        for (i = 0; (result == 0) && (i < sizeof(text_sizes) / sizeof(text_sizes[0])); i++)
+        {
+            fill_text(ascii_sample, sizeof(ascii_sample) - 1, text_sizes[i]);
+            result = run_scenario("is_valid_utf8 ascii", is_valid_utf8, text_sizes[i]);
+            if (result == 0)
+            {
+                result = run_scenario("update ascii", update_fragments, text_sizes[i]);
+            }
+
+            fill_text(mixed_sample, sizeof(mixed_sample) - 1, text_sizes[i]);
+            if (result == 0)
+            {
+                result = run_scenario("is_valid_utf8 mixed", is_valid_utf8, text_sizes[i]);
+            }
+            if (result == 0)
+            {
+                result = run_scenario("update mixed", update_fragments, text_sizes[i]);
+            }
+        }
+    }
+
+    free(text);
+
+    return result;
+}
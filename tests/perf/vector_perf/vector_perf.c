@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <time.h>
+#include "azure_c_shared_utility/vector.h"
+
+/* every scenario pushes this many elements in total */
+#define ELEMENTS_PER_SCENARIO   (4 * 1024 * 1024)
+
+typedef struct PERF_ELEMENT_TAG
+{
+    size_t key;
+    void* value;
+} PERF_ELEMENT;
+
+typedef int(*RUN_ONCE)(size_t element_count);
+
+static VECTOR_HANDLE fill(size_t element_count)
+{
+    VECTOR_HANDLE result = VECTOR_create(sizeof(PERF_ELEMENT));
+    size_t i;
+
+    for (i = 0; (result != NULL) && (i < element_count); i++)
+    {
+        PERF_ELEMENT element = { i, NULL };
+        if (VECTOR_push_back(result, &element, 1) != 0)
+        {
+            VECTOR_destroy(result);
+            result = NULL;
+        }
+    }
+
+    return result;
+}
+
+static int push_back(size_t element_count)
+{
+    VECTOR_HANDLE vector = fill(element_count);
+    VECTOR_destroy(vector);
+    return (vector == NULL) ? __LINE__ : 0;
+}
+
+static int reserve_and_push_back(size_t element_count)
+{
+    int result;
+    VECTOR_HANDLE vector = VECTOR_create(sizeof(PERF_ELEMENT));
+    size_t i;
+
+    result = VECTOR_reserve(vector, element_count);
+    for (i = 0; (result == 0) && (i < element_count); i++)
+    {
+        PERF_ELEMENT element = { i, NULL };
+        result = VECTOR_push_back(vector, &element, 1);
+    }
+
+    VECTOR_destroy(vector);
+    return (result != 0) ? __LINE__ : 0;
+}
+
+/* queue-like usage: elements are consumed in the order they were added */
+static int erase_front(size_t element_count)
+{
+    int result = 0;
+    VECTOR_HANDLE vector = fill(element_count);
+    size_t i;
+
+    if (vector == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        for (i = 0; (result == 0) && (i < element_count); i++)
+        {
+            PERF_ELEMENT* front = (PERF_ELEMENT*)VECTOR_front(vector);
+            if ((front == NULL) || (front->key != i))
+            {
+                result = __LINE__;
+            }
+            else
+            {
+                VECTOR_erase(vector, front, 1);
+            }
+        }
+
+        VECTOR_destroy(vector);
+    }
+
+    return result;
+}
+
+/* stack-like usage: elements are consumed in the reverse order they were added */
+static int erase_back(size_t element_count)
+{
+    int result = 0;
+    VECTOR_HANDLE vector = fill(element_count);
+    size_t i;
+
+    if (vector == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        for (i = element_count; (result == 0) && (i > 0); i--)
+        {
+            PERF_ELEMENT* back = (PERF_ELEMENT*)VECTOR_back(vector);
+            if ((back == NULL) || (back->key != i - 1))
+            {
+                result = __LINE__;
+            }
+            else
+            {
+                VECTOR_erase(vector, back, 1);
+            }
+        }
+
+        VECTOR_destroy(vector);
+    }
+
+    return result;
+}
+
+static int pop_back(size_t element_count)
+{
+    int result = 0;
+    VECTOR_HANDLE vector = fill(element_count);
+    size_t i;
+
+    if (vector == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        for (i = element_count; (result == 0) && (i > 0); i--)
+        {
+            PERF_ELEMENT* back = (PERF_ELEMENT*)VECTOR_back(vector);
+            if ((back == NULL) || (back->key != i - 1))
+            {
+                result = __LINE__;
+            }
+            else
+            {
+                VECTOR_pop_back(vector);
+            }
+        }
+
+        VECTOR_destroy(vector);
+    }
+
+    return result;
+}
+
+static int run_scenario(const char* scenario_name, RUN_ONCE run_once, size_t element_count)
+{
+    int result = 0;
+    size_t iterations = ELEMENTS_PER_SCENARIO / element_count;
+    clock_t start_time;
+    clock_t end_time;
+    size_t i;
+
+    start_time = clock();
+
+    for (i = 0; (result == 0) && (i < iterations); i++)
+    {
+        result = run_once(element_count);
+        if (result != 0)
+        {
+            (void)printf("%s failed\r\n", scenario_name);
+        }
+    }
+
+    end_time = clock();
+
+    if (result == 0)
+    {
+        double elapsed_ms = ((double)(end_time - start_time) * 1000.0) / CLOCKS_PER_SEC;
+
+        if (elapsed_ms <= 0)
+        {
+            elapsed_ms = 1;
+        }
+
+        (void)printf("%-22s %6lu elements: %8.0f ms, %8.2f M elements/s\r\n",
+            scenario_name, (unsigned long)element_count, elapsed_ms, ((double)element_count * iterations) / (elapsed_ms * 1000.0));
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    static const size_t element_counts[] = { 16, 256, 4096 };
+    int result = 0;
+    size_t i;
+
+    for (i = 0; (result == 0) && (i < sizeof(element_counts) / sizeof(element_counts[0])); i++)
+    {
+        result = run_scenario("VECTOR_push_back", push_back, element_counts[i]);
+        if (result == 0)
+        {
+            result = run_scenario("VECTOR_reserve", reserve_and_push_back, element_counts[i]);
+        }
+        if (result == 0)
+        {
+            result = run_scenario("VECTOR_erase (front)", erase_front, element_counts[i]);
+        }
+        if (result == 0)
+        {
+            result = run_scenario("VECTOR_erase (back)", erase_back, element_counts[i]);
+        }
+        if (result == 0)
+        {
+            result = run_scenario("VECTOR_pop_back", pop_back, element_counts[i]);
+        }
+    }
+
+    return result;
+}
@@ -33,39 +33,29 @@ static void my_gballoc_free(void* ptr)
 
 #include "azure_c_shared_utility/gballoc.h"
 
-#include "azure_c_shared_utility/hmacsha256.h"
 #include "azure_c_shared_utility/strings.h"
 #include "azure_c_shared_utility/buffer_.h"
 #include "azure_c_shared_utility/crt_abstractions.h"
-#include "azure_c_shared_utility/urlencode.h"
 #include "azure_c_shared_utility/base64.h"
 #include "azure_c_shared_utility/agenttime.h"
 
 #undef ENABLE_MOCKS
 
 
-TEST_DEFINE_ENUM_TYPE(HMACSHA256_RESULT, HMACSHA256_RESULT_VALUES);
-IMPLEMENT_UMOCK_C_ENUM_TYPE(HMACSHA256_RESULT, HMACSHA256_RESULT_VALUES);
-
 double my_get_difftime(time_t stopTime, time_t startTime)
 {
     return (double)(stopTime - startTime);
 }
 
-STRING_HANDLE my_STRING_new(void)
+/* the token memory handed over to STRING_new_with_memory is used as the handle so that tests can inspect it */
+STRING_HANDLE my_STRING_new_with_memory(const char* memory)
 {
-    return (STRING_HANDLE)malloc(1);
-}
-
-BUFFER_HANDLE my_BUFFER_new(void)
-{
-    return (BUFFER_HANDLE)malloc(1);
+    return (STRING_HANDLE)memory;
 }
 
-STRING_HANDLE my_Base64_Encode(BUFFER_HANDLE input)
+void my_STRING_delete(STRING_HANDLE handle)
 {
-    (void)input;
-    return (STRING_HANDLE)malloc(1);
+    free(handle);
 }
 
 BUFFER_HANDLE my_Base64_Decoder(const char* source)
@@ -74,32 +64,16 @@ BUFFER_HANDLE my_Base64_Decoder(const char* source)
     return (BUFFER_HANDLE)malloc(1);
 }
 
-STRING_HANDLE my_URL_Encode(STRING_HANDLE input)
-{
-    (void)input;
-    return (STRING_HANDLE)malloc(1);
-}
-
 #include "azure_c_shared_utility/sastoken.h"
 
 #define TEST_STRING_HANDLE (STRING_HANDLE)0x46
 #define TEST_NULL_STRING_HANDLE (STRING_HANDLE)0x00
-#define TEST_BUFFER_HANDLE (BUFFER_HANDLE)0x47
 #define TEST_NULL_BUFFER_HANDLE (BUFFER_HANDLE)0x00
 #define TEST_SCOPE_HANDLE (STRING_HANDLE)0x48
 #define TEST_KEY_HANDLE (STRING_HANDLE)0x49
 #define TEST_KEYNAME_HANDLE (STRING_HANDLE)0x50
-#define TEST_HASH_HANDLE (BUFFER_HANDLE)0x51
-#define TEST_TOBEHASHED_HANDLE (STRING_HANDLE)0x52
-#define TEST_RESULT_HANDLE (STRING_HANDLE)0x53
-#define TEST_BASE64SIGNATURE_HANDLE (STRING_HANDLE)0x54
-#define TEST_URLENCODEDSIGNATURE_HANDLE (STRING_HANDLE)0x55
 #define TEST_DECODEDKEY_HANDLE (BUFFER_HANDLE)0x56
 #define TEST_TIME_T ((time_t)3600)
-#define TEST_PTR_DECODEDKEY (unsigned char*)0x123
-#define TEST_LENGTH_DECODEDKEY (size_t)32
-#define TEST_PTR_TOBEHASHED (const char*)0x456
-#define TEST_LENGTH_TOBEHASHED (size_t)456
 #define TEST_EXPIRY ((size_t)7200)
 #define TEST_LATER_TIME (time_t) 11
 #define TEST_EARLY_TIME (time_t) 10
@@ -109,6 +83,9 @@ static const char* TEST_NULL_STRING_VALUE = 0x00;
 static char TEST_CHAR_ARRAY[10] = "ABCD";
 static unsigned char TEST_UNSIGNED_CHAR_ARRAY[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09 };
 static char TEST_TOKEN_EXPIRATION_TIME[32] = "7200";
+/* HMAC-SHA256 keyed with TEST_UNSIGNED_CHAR_ARRAY over TEST_STRING_VALUE "\n" TEST_TOKEN_EXPIRATION_TIME */
+static const char TEST_OTHER_KEY[] = "EFGH";
+static const char TEST_EXPECTED_SAS_TOKEN[] = "SharedAccessSignature sr=Test string value&sig=2129t7UF%2bYGLSUsOO1igxkvw%2fHdU8SAbSKn9SQam1O0%3d&se=7200&skn=Test string value";
 
 static TEST_MUTEX_HANDLE g_testByTest;
 static TEST_MUTEX_HANDLE g_dllByDll;
@@ -150,27 +127,20 @@ TEST_SUITE_INITIALIZE(TestClassInitialize)
 
     result = umocktypes_charptr_register_types();
     ASSERT_ARE_EQUAL(int, 0, result);
-    REGISTER_TYPE(HMACSHA256_RESULT, HMACSHA256_RESULT);
 
     REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
     REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
 
-    REGISTER_GLOBAL_MOCK_HOOK(STRING_new, my_STRING_new);
-    REGISTER_GLOBAL_MOCK_RETURN(STRING_concat, 0);
-    REGISTER_GLOBAL_MOCK_RETURN(STRING_concat_with_STRING, 0);
+    REGISTER_GLOBAL_MOCK_HOOK(STRING_new_with_memory, my_STRING_new_with_memory);
+    REGISTER_GLOBAL_MOCK_HOOK(STRING_delete, my_STRING_delete);
     REGISTER_GLOBAL_MOCK_RETURN(STRING_c_str, &TEST_CHAR_ARRAY[0]);
     REGISTER_GLOBAL_MOCK_RETURN(STRING_length, 1);
-    REGISTER_GLOBAL_MOCK_RETURN(STRING_copy, 0);
 
-    REGISTER_GLOBAL_MOCK_HOOK(BUFFER_new, my_BUFFER_new);
     REGISTER_GLOBAL_MOCK_RETURN(BUFFER_u_char, &TEST_UNSIGNED_CHAR_ARRAY[0]);
-    REGISTER_GLOBAL_MOCK_RETURN(BUFFER_length, 1);
+    REGISTER_GLOBAL_MOCK_RETURN(BUFFER_length, sizeof(TEST_UNSIGNED_CHAR_ARRAY));
 
-    REGISTER_GLOBAL_MOCK_HOOK(Base64_Encoder, my_Base64_Encode);
     REGISTER_GLOBAL_MOCK_HOOK(Base64_Decoder, my_Base64_Decoder);
-    REGISTER_GLOBAL_MOCK_HOOK(URL_Encode, my_URL_Encode);
-    REGISTER_GLOBAL_MOCK_RETURN(HMACSHA256_ComputeHash, HMACSHA256_OK);
     REGISTER_GLOBAL_MOCK_RETURN(size_tToString, 0);
 
     REGISTER_GLOBAL_MOCK_RETURN(get_time, TEST_TIME_T);
@@ -961,8 +931,8 @@ TEST_FUNCTION(SASToken_Create_size_tToString_fails)
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-/*Tests_SRS_SASTOKEN_06_024: [The size_t value ((size_t) (difftime(get_time(NULL),0) + 3600)) is converted to a string form.]*/
-TEST_FUNCTION(SASToken_Create_buffer_new_fails)
+/*Tests_SRS_SASTOKEN_06_013: [If an error is returned from the HMAC256 function then NULL is returned from SASToken_Create.]*/
+TEST_FUNCTION(SASToken_Create_empty_decoded_key_fails)
 {
     // arrange
     STRING_HANDLE handle;
@@ -971,12 +941,9 @@ TEST_FUNCTION(SASToken_Create_buffer_new_fails)
     STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
     STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
     STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
-
     STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(NULL);
-
-    STRICT_EXPECTED_CALL(STRING_delete(NULL));
-    STRICT_EXPECTED_CALL(BUFFER_delete(NULL));
+    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(0);
     STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
 
     // act
@@ -987,7 +954,8 @@ TEST_FUNCTION(SASToken_Create_buffer_new_fails)
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-TEST_FUNCTION(SASToken_Create_first_string_new_fails)
+/*Tests_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
+TEST_FUNCTION(SASToken_Create_malloc_fails)
 {
     // arrange
     STRING_HANDLE handle;
@@ -996,13 +964,10 @@ TEST_FUNCTION(SASToken_Create_first_string_new_fails)
     STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
     STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
     STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
-
     STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(NULL);
-
-    STRICT_EXPECTED_CALL(STRING_delete(NULL));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN))).SetReturn(NULL);
     STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
 
     // act
@@ -1013,7 +978,8 @@ TEST_FUNCTION(SASToken_Create_first_string_new_fails)
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-TEST_FUNCTION(SASToken_Create_second_string_new_fails)
+/*Tests_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
+TEST_FUNCTION(SASToken_Create_STRING_new_with_memory_fails)
 {
     // arrange
     STRING_HANDLE handle;
@@ -1022,14 +988,12 @@ TEST_FUNCTION(SASToken_Create_second_string_new_fails)
     STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
     STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
     STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
-
     STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(NULL);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN)));
+    STRICT_EXPECTED_CALL(STRING_new_with_memory(IGNORED_PTR_ARG)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
 
     // act
@@ -1040,7 +1004,22 @@ TEST_FUNCTION(SASToken_Create_second_string_new_fails)
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-TEST_FUNCTION(SASToken_Create_build_to_be_hashed_part1_fails)
+/*Tests_SRS_SASTOKEN_06_009: [The scope is the basis for creating a STRING_HANDLE.]*/
+/*Tests_SRS_SASTOKEN_06_010: [A "\n" is appended to that string.]*/
+/*Tests_SRS_SASTOKEN_06_011: [tokenExpirationTime is appended to that string.]*/
+/*Tests_SRS_SASTOKEN_06_012: [An HMAC256 hash is calculated using the decodedKey, over toBeHashed.]*/
+/*Tests_SRS_SASTOKEN_06_015: [The hash is base 64 encoded.]*/
+/*Tests_SRS_SASTOKEN_06_028: [base64Signature shall be url encoded.]*/
+/*Tests_SRS_SASTOKEN_06_016: [The string "SharedAccessSignature sr=" is the first part of the result of SASToken_Create.]*/
+/*Tests_SRS_SASTOKEN_06_017: [The scope parameter is appended to result.]*/
+/*Tests_SRS_SASTOKEN_06_018: [The string "&sig=" is appended to result.]*/
+/*Tests_SRS_SASTOKEN_06_019: [The string urlEncodedSignature shall be appended to result.]*/
+/*Tests_SRS_SASTOKEN_06_020: [The string "&se=" shall be appended to result.]*/
+/*Tests_SRS_SASTOKEN_06_021: [tokenExpirationTime is appended to result.]*/
+/*Tests_SRS_SASTOKEN_06_022: [The string "&skn=" is appended to result.]*/
+/*Tests_SRS_SASTOKEN_06_023: [The argument keyName is appended to result.]*/
+/*Tests_SRS_SASTOKEN_01_003: [ The SAS token shall be written into a single allocation of exactly the token length plus the null terminator, which shall be handed over to STRING_new_with_memory. ]*/
+TEST_FUNCTION(SASToken_Create_succeeds)
 {
     // arrange
     STRING_HANDLE handle;
@@ -1049,717 +1028,468 @@ TEST_FUNCTION(SASToken_Create_build_to_be_hashed_part1_fails)
     STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
     STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
     STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
-
     STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
-
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG)).SetReturn(1);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN)));
+    STRICT_EXPECTED_CALL(STRING_new_with_memory(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
 
     // act
     handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
 
     // assert
-    ASSERT_IS_NULL(handle);
+    ASSERT_IS_NOT_NULL(handle);
+    ASSERT_ARE_EQUAL(char_ptr, TEST_EXPECTED_SAS_TOKEN, (const char*)handle);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    free(handle);
 }
 
-/*Tests_SRS_SASTOKEN_06_009: [The scope is the basis for creating a STRING_HANDLE.]*/
-TEST_FUNCTION(SASToken_Create_build_to_be_hashed_part2_fails)
+TEST_FUNCTION(SASToken_CreateString_succeeds)
 {
     // arrange
     STRING_HANDLE handle;
 
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
     STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
-
     STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
-
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n")).SetReturn(1);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN)));
+    STRICT_EXPECTED_CALL(STRING_new_with_memory(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
 
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    handle = SASToken_CreateString(TEST_CHAR_ARRAY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY);
 
     // assert
-    ASSERT_IS_NULL(handle);
+    ASSERT_IS_NOT_NULL(handle);
+    ASSERT_ARE_EQUAL(char_ptr, TEST_EXPECTED_SAS_TOKEN, (const char*)handle);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    free(handle);
 }
 
-/*Tests_SRS_SASTOKEN_06_010: [A "\n" is appended to that string.]*/
-TEST_FUNCTION(SASToken_Create_build_to_be_hashed_part3_fails)
+/*Tests_SRS_SASTOKEN_01_001: [ If decodedKey, scope or keyName is NULL then SASToken_CreateWithDecodedKey shall return NULL. ]*/
+TEST_FUNCTION(SASToken_CreateWithDecodedKey_with_NULL_decodedKey_fails)
 {
     // arrange
     STRING_HANDLE handle;
 
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
-
-    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
-
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME)).SetReturn(1);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
-
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    handle = SASToken_CreateWithDecodedKey(TEST_NULL_BUFFER_HANDLE, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY);
 
     // assert
     ASSERT_IS_NULL(handle);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-/*Tests_SRS_SASTOKEN_06_011: [tokenExpirationTime is appended to that string.]*/
-/*Tests_SRS_SASTOKEN_06_013: [If an error is returned from the HMAC256 function then NULL is returned from SASToken_Create.]*/
-TEST_FUNCTION(SASToken_Create_HMAC256_fails)
+/*Tests_SRS_SASTOKEN_01_001: [ If decodedKey, scope or keyName is NULL then SASToken_CreateWithDecodedKey shall return NULL. ]*/
+TEST_FUNCTION(SASToken_CreateWithDecodedKey_with_NULL_scope_fails)
 {
     // arrange
     STRING_HANDLE handle;
 
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
-
-    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
-
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
-
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
-    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
-
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).SetReturn(HMACSHA256_ERROR);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(NULL));
-    STRICT_EXPECTED_CALL(STRING_delete(NULL));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
-
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    handle = SASToken_CreateWithDecodedKey(TEST_DECODEDKEY_HANDLE, NULL, TEST_STRING_VALUE, TEST_EXPIRY);
 
     // assert
     ASSERT_IS_NULL(handle);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-
-/*Tests_SRS_SASTOKEN_06_012: [An HMAC256 hash is calculated using the decodedKey, over toBeHashed.]*/
-/*Tests_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
-TEST_FUNCTION(SASToken_Create_HMAC256_passes_signature_encode_fails)
+/*Tests_SRS_SASTOKEN_01_001: [ If decodedKey, scope or keyName is NULL then SASToken_CreateWithDecodedKey shall return NULL. ]*/
+TEST_FUNCTION(SASToken_CreateWithDecodedKey_with_NULL_keyName_fails)
 {
     // arrange
     STRING_HANDLE handle;
 
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
-
-    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
-
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
-
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
-    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
-
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).IgnoreArgument(1).IgnoreArgument(3);
-    STRICT_EXPECTED_CALL(Base64_Encoder(TEST_HASH_HANDLE)).SetReturn(NULL);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(NULL));
-    STRICT_EXPECTED_CALL(STRING_delete(NULL));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
-
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    handle = SASToken_CreateWithDecodedKey(TEST_DECODEDKEY_HANDLE, TEST_STRING_VALUE, NULL, TEST_EXPIRY);
 
     // assert
     ASSERT_IS_NULL(handle);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-/*Tests_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
-/*Tests_SRS_SASTOKEN_06_015: [The hash is base 64 encoded.]*/
-TEST_FUNCTION(SASToken_Create_building_token_signature_url_encoding_fails)
+/*Tests_SRS_SASTOKEN_01_002: [ SASToken_CreateWithDecodedKey shall build the SAS token exactly like SASToken_Create, using decodedKey as the HMAC key instead of decoding a base64 key. ]*/
+TEST_FUNCTION(SASToken_CreateWithDecodedKey_succeeds)
 {
     // arrange
     STRING_HANDLE handle;
 
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
-
     STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
-
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
-
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
     STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
-
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).IgnoreArgument(1).IgnoreArgument(3);
-    STRICT_EXPECTED_CALL(Base64_Encoder(TEST_HASH_HANDLE)).SetReturn(TEST_BASE64SIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(URL_Encode(TEST_BASE64SIGNATURE_HANDLE)).SetReturn(NULL);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_BASE64SIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(NULL));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN)));
+    STRICT_EXPECTED_CALL(STRING_new_with_memory(IGNORED_PTR_ARG));
 
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    handle = SASToken_CreateWithDecodedKey(TEST_DECODEDKEY_HANDLE, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY);
 
     // assert
-    ASSERT_IS_NULL(handle);
+    ASSERT_IS_NOT_NULL(handle);
+    ASSERT_ARE_EQUAL(char_ptr, TEST_EXPECTED_SAS_TOKEN, (const char*)handle);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    free(handle);
 }
 
-/*Tests_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
-/*Tests_SRS_SASTOKEN_06_028: [base64Signature shall be url encoded.]*/
-TEST_FUNCTION(SASToken_Create_building_token_copy_scope_identifier_fails)
+/* SASToken_CreateInto */
+
+/*Tests_SRS_SASTOKEN_01_004: [ If decodedKey, scope, keyName or tokenLength is NULL then SASToken_CreateInto shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateInto_with_NULL_decodedKey_fails)
 {
     // arrange
-    STRING_HANDLE handle;
+    char destination[256];
+    size_t tokenLength;
+    int result;
 
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
+    // act
+    result = SASToken_CreateInto(NULL, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY, destination, sizeof(destination), &tokenLength);
 
-    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
 
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
+/*Tests_SRS_SASTOKEN_01_004: [ If decodedKey, scope, keyName or tokenLength is NULL then SASToken_CreateInto shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateInto_with_NULL_scope_fails)
+{
+    // arrange
+    char destination[256];
+    size_t tokenLength;
+    int result;
 
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
-    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
+    // act
+    result = SASToken_CreateInto(TEST_DECODEDKEY_HANDLE, NULL, TEST_STRING_VALUE, TEST_EXPIRY, destination, sizeof(destination), &tokenLength);
 
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).IgnoreArgument(1).IgnoreArgument(3);
-    STRICT_EXPECTED_CALL(Base64_Encoder(TEST_HASH_HANDLE)).SetReturn(TEST_BASE64SIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(URL_Encode(TEST_BASE64SIGNATURE_HANDLE)).SetReturn(TEST_URLENCODEDSIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_copy(TEST_RESULT_HANDLE, "SharedAccessSignature sr=")).SetReturn(1);
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
 
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_BASE64SIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
+/*Tests_SRS_SASTOKEN_01_004: [ If decodedKey, scope, keyName or tokenLength is NULL then SASToken_CreateInto shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateInto_with_NULL_keyName_fails)
+{
+    // arrange
+    char destination[256];
+    size_t tokenLength;
+    int result;
 
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    result = SASToken_CreateInto(TEST_DECODEDKEY_HANDLE, TEST_STRING_VALUE, NULL, TEST_EXPIRY, destination, sizeof(destination), &tokenLength);
 
     // assert
-    ASSERT_IS_NULL(handle);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-/*Tests_SRS_SASTOKEN_06_016: [The string "SharedAccessSignature sr=" is the first part of the result of SASToken_Create.]*/
-/*Tests_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
-TEST_FUNCTION(SASToken_Create_building_token_concat_scope_fails)
+/*Tests_SRS_SASTOKEN_01_004: [ If decodedKey, scope, keyName or tokenLength is NULL then SASToken_CreateInto shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateInto_with_NULL_tokenLength_fails)
 {
     // arrange
-    STRING_HANDLE handle;
-
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
+    char destination[256];
+    size_t tokenLength;
+    int result;
 
-    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
+    // act
+    result = SASToken_CreateInto(TEST_DECODEDKEY_HANDLE, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY, destination, sizeof(destination), NULL);
 
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
 
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
-    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
+/*Tests_SRS_SASTOKEN_01_005: [ If computing the SAS token fails, SASToken_CreateInto shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateInto_size_tToString_fails)
+{
+    // arrange
+    char destination[256];
+    size_t tokenLength;
+    int result;
 
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).IgnoreArgument(1).IgnoreArgument(3);
-    STRICT_EXPECTED_CALL(Base64_Encoder(TEST_HASH_HANDLE)).SetReturn(TEST_BASE64SIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(URL_Encode(TEST_BASE64SIGNATURE_HANDLE)).SetReturn(TEST_URLENCODEDSIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_copy(TEST_RESULT_HANDLE, "SharedAccessSignature sr="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, IGNORED_PTR_ARG)).SetReturn(1);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_BASE64SIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).SetReturn(-1);
 
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    result = SASToken_CreateInto(TEST_DECODEDKEY_HANDLE, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY, destination, sizeof(destination), &tokenLength);
 
     // assert
-    ASSERT_IS_NULL(handle);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-/*Tests_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
-/*Tests_SRS_SASTOKEN_06_017: [The scope parameter is appended to result.]*/
-TEST_FUNCTION(SASToken_Create_building_token_concat_signature_identifier_fails)
+/*Tests_SRS_SASTOKEN_01_006: [ SASToken_CreateInto shall set *tokenLength to the length of the SAS token, not including the null terminator. ]*/
+/*Tests_SRS_SASTOKEN_01_007: [ If destination is NULL or destinationSize is not larger than the SAS token length, SASToken_CreateInto shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateInto_with_NULL_destination_returns_the_token_length)
 {
     // arrange
-    STRING_HANDLE handle;
-
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
+    size_t tokenLength = 0;
+    int result;
 
     STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
-
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
-
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
     STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
-
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).IgnoreArgument(1).IgnoreArgument(3);
-    STRICT_EXPECTED_CALL(Base64_Encoder(TEST_HASH_HANDLE)).SetReturn(TEST_BASE64SIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(URL_Encode(TEST_BASE64SIGNATURE_HANDLE)).SetReturn(TEST_URLENCODEDSIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_copy(TEST_RESULT_HANDLE, "SharedAccessSignature sr="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&sig=")).SetReturn(1);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_BASE64SIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
 
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    result = SASToken_CreateInto(TEST_DECODEDKEY_HANDLE, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY, NULL, 0, &tokenLength);
 
     // assert
-    ASSERT_IS_NULL(handle);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, sizeof(TEST_EXPECTED_SAS_TOKEN) - 1, tokenLength);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-/*Tests_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
-/*Tests_SRS_SASTOKEN_06_018: [The string "&sig=" is appended to result.]*/
-TEST_FUNCTION(SASToken_Create_building_token_concat_signature_fails)
+/*Tests_SRS_SASTOKEN_01_006: [ SASToken_CreateInto shall set *tokenLength to the length of the SAS token, not including the null terminator. ]*/
+/*Tests_SRS_SASTOKEN_01_007: [ If destination is NULL or destinationSize is not larger than the SAS token length, SASToken_CreateInto shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateInto_with_no_room_for_the_null_terminator_fails)
 {
     // arrange
-    STRING_HANDLE handle;
-
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
+    char destination[sizeof(TEST_EXPECTED_SAS_TOKEN) - 1];
+    size_t tokenLength = 0;
+    int result;
 
     STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
-
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
-
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
     STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
-
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).IgnoreArgument(1).IgnoreArgument(3);
-    STRICT_EXPECTED_CALL(Base64_Encoder(TEST_HASH_HANDLE)).SetReturn(TEST_BASE64SIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(URL_Encode(TEST_BASE64SIGNATURE_HANDLE)).SetReturn(TEST_URLENCODEDSIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_copy(TEST_RESULT_HANDLE, "SharedAccessSignature sr="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&sig="));
-    STRICT_EXPECTED_CALL(STRING_concat_with_STRING(TEST_RESULT_HANDLE, TEST_URLENCODEDSIGNATURE_HANDLE)).SetReturn(1);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_BASE64SIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
 
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    result = SASToken_CreateInto(TEST_DECODEDKEY_HANDLE, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY, destination, sizeof(destination), &tokenLength);
 
     // assert
-    ASSERT_IS_NULL(handle);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, sizeof(TEST_EXPECTED_SAS_TOKEN) - 1, tokenLength);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-/*Tests_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
-/*Tests_SRS_SASTOKEN_06_019: [The string urlEncodedSignature shall be appended to result.]*/
-TEST_FUNCTION(SASToken_Create_building_token_concat_token_expiration_time_identifier_fails)
+/*Tests_SRS_SASTOKEN_01_008: [ Otherwise SASToken_CreateInto shall write the null terminated SAS token, built exactly like SASToken_Create builds it, into destination without allocating any memory and return 0. ]*/
+TEST_FUNCTION(SASToken_CreateInto_succeeds_without_allocating)
 {
     // arrange
-    STRING_HANDLE handle;
-
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
+    char destination[sizeof(TEST_EXPECTED_SAS_TOKEN)];
+    size_t tokenLength = 0;
+    int result;
 
     STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
-
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
-
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
     STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
-
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).IgnoreArgument(1).IgnoreArgument(3);
-    STRICT_EXPECTED_CALL(Base64_Encoder(TEST_HASH_HANDLE)).SetReturn(TEST_BASE64SIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(URL_Encode(TEST_BASE64SIGNATURE_HANDLE)).SetReturn(TEST_URLENCODEDSIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_copy(TEST_RESULT_HANDLE, "SharedAccessSignature sr="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&sig="));
-    STRICT_EXPECTED_CALL(STRING_concat_with_STRING(TEST_RESULT_HANDLE, TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&se=")).SetReturn(1);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_BASE64SIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
 
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    result = SASToken_CreateInto(TEST_DECODEDKEY_HANDLE, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY, destination, sizeof(destination), &tokenLength);
 
     // assert
-    ASSERT_IS_NULL(handle);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, sizeof(TEST_EXPECTED_SAS_TOKEN) - 1, tokenLength);
+    ASSERT_ARE_EQUAL(char_ptr, TEST_EXPECTED_SAS_TOKEN, destination);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-/*Tests_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
-/*Tests_SRS_SASTOKEN_06_020: [The string "&se=" shall be appended to result.]*/
-TEST_FUNCTION(SASToken_Create_building_token_concat_token_expiration_time_fails)
+/* SASToken_CreateBatch */
+
+/*Tests_SRS_SASTOKEN_01_009: [ If requests or tokens is NULL or requestCount is 0 then SASToken_CreateBatch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateBatch_with_NULL_requests_fails)
 {
     // arrange
-    STRING_HANDLE handle;
-
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
-
-    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
+    SAS_TOKEN_REQUEST requests[1] = { { TEST_CHAR_ARRAY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY } };
+    STRING_HANDLE tokens[1];
+    int result;
 
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
+    // act
+    result = SASToken_CreateBatch(NULL, 1, tokens);
 
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
-    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
 
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).IgnoreArgument(1).IgnoreArgument(3);
-    STRICT_EXPECTED_CALL(Base64_Encoder(TEST_HASH_HANDLE)).SetReturn(TEST_BASE64SIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(URL_Encode(TEST_BASE64SIGNATURE_HANDLE)).SetReturn(TEST_URLENCODEDSIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_copy(TEST_RESULT_HANDLE, "SharedAccessSignature sr="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&sig="));
-    STRICT_EXPECTED_CALL(STRING_concat_with_STRING(TEST_RESULT_HANDLE, TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&se="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, TEST_TOKEN_EXPIRATION_TIME)).SetReturn(1);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_BASE64SIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
+/*Tests_SRS_SASTOKEN_01_009: [ If requests or tokens is NULL or requestCount is 0 then SASToken_CreateBatch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateBatch_with_zero_requestCount_fails)
+{
+    // arrange
+    SAS_TOKEN_REQUEST requests[1] = { { TEST_CHAR_ARRAY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY } };
+    STRING_HANDLE tokens[1];
+    int result;
 
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    result = SASToken_CreateBatch(requests, 0, tokens);
 
     // assert
-    ASSERT_IS_NULL(handle);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-/*Tests_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
-/*Tests_SRS_SASTOKEN_06_021: [tokenExpirationTime is appended to result.]*/
-TEST_FUNCTION(SASToken_Create_building_token_concat_keyname_identifier_fails)
+/*Tests_SRS_SASTOKEN_01_009: [ If requests or tokens is NULL or requestCount is 0 then SASToken_CreateBatch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateBatch_with_NULL_tokens_fails)
 {
     // arrange
-    STRING_HANDLE handle;
+    SAS_TOKEN_REQUEST requests[1] = { { TEST_CHAR_ARRAY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY } };
+    STRING_HANDLE tokens[1];
+    int result;
 
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
+    // act
+    result = SASToken_CreateBatch(requests, 1, NULL);
 
-    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
 
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
+/*Tests_SRS_SASTOKEN_01_010: [ If the key, scope or keyName of any request is NULL then SASToken_CreateBatch shall fail and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateBatch_with_NULL_scope_in_a_request_fails)
+{
+    // arrange
+    SAS_TOKEN_REQUEST requests[2] = { { TEST_CHAR_ARRAY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY }, { TEST_CHAR_ARRAY, NULL, TEST_STRING_VALUE, TEST_EXPIRY } };
+    STRING_HANDLE tokens[2];
+    int result;
 
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
+    STRICT_EXPECTED_CALL(Base64_Decoder(TEST_CHAR_ARRAY)).SetReturn(TEST_DECODEDKEY_HANDLE);
     STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
-
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).IgnoreArgument(1).IgnoreArgument(3);
-    STRICT_EXPECTED_CALL(Base64_Encoder(TEST_HASH_HANDLE)).SetReturn(TEST_BASE64SIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(URL_Encode(TEST_BASE64SIGNATURE_HANDLE)).SetReturn(TEST_URLENCODEDSIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_copy(TEST_RESULT_HANDLE, "SharedAccessSignature sr="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&sig="));
-    STRICT_EXPECTED_CALL(STRING_concat_with_STRING(TEST_RESULT_HANDLE, TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&se="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&skn=")).SetReturn(1);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_BASE64SIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
     STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN)));
+    STRICT_EXPECTED_CALL(STRING_new_with_memory(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    result = SASToken_CreateBatch(requests, 2, tokens);
 
     // assert
-    ASSERT_IS_NULL(handle);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(tokens[0]);
+    ASSERT_IS_NULL(tokens[1]);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
-/*Tests_SRS_SASTOKEN_06_014: [If there are any errors from the following operations then NULL shall be returned.]*/
-/*Tests_SRS_SASTOKEN_06_022: [The string "&skn=" is appended to result.]*/
-TEST_FUNCTION(SASToken_Create_building_token_concat_keyname_fails)
+/*Tests_SRS_SASTOKEN_01_011: [ When a request has the same key as the previous request, the key shall not be decoded again and the HMAC state computed from it shall be reused. ]*/
+/*Tests_SRS_SASTOKEN_01_013: [ Each token shall be built exactly like SASToken_CreateString builds it and stored at the same index in tokens. ]*/
+/*Tests_SRS_SASTOKEN_01_015: [ On success SASToken_CreateBatch shall return 0. ]*/
+TEST_FUNCTION(SASToken_CreateBatch_with_the_same_key_decodes_the_key_once)
 {
     // arrange
-    STRING_HANDLE handle;
-
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
-
-    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
-
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
+    SAS_TOKEN_REQUEST requests[2] = { { TEST_CHAR_ARRAY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY }, { TEST_CHAR_ARRAY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY } };
+    STRING_HANDLE tokens[2];
+    int result;
 
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
+    STRICT_EXPECTED_CALL(Base64_Decoder(TEST_CHAR_ARRAY)).SetReturn(TEST_DECODEDKEY_HANDLE);
     STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
-
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).IgnoreArgument(1).IgnoreArgument(3);
-    STRICT_EXPECTED_CALL(Base64_Encoder(TEST_HASH_HANDLE)).SetReturn(TEST_BASE64SIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(URL_Encode(TEST_BASE64SIGNATURE_HANDLE)).SetReturn(TEST_URLENCODEDSIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_copy(TEST_RESULT_HANDLE, "SharedAccessSignature sr="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&sig="));
-    STRICT_EXPECTED_CALL(STRING_concat_with_STRING(TEST_RESULT_HANDLE, TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&se="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&skn="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, IGNORED_PTR_ARG)).SetReturn(1);
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_RESULT_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_BASE64SIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
     STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN)));
+    STRICT_EXPECTED_CALL(STRING_new_with_memory(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN)));
+    STRICT_EXPECTED_CALL(STRING_new_with_memory(IGNORED_PTR_ARG));
 
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    result = SASToken_CreateBatch(requests, 2, tokens);
 
     // assert
-    ASSERT_IS_NULL(handle);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, TEST_EXPECTED_SAS_TOKEN, (const char*)tokens[0]);
+    ASSERT_ARE_EQUAL(char_ptr, TEST_EXPECTED_SAS_TOKEN, (const char*)tokens[1]);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    free(tokens[0]);
+    free(tokens[1]);
 }
 
-/*Tests_SRS_SASTOKEN_06_023: [The argument keyName is appended to result.]*/
-TEST_FUNCTION(SASToken_Create_succeeds)
+/*Tests_SRS_SASTOKEN_01_012: [ Otherwise the key shall be decoded from base64 and used to initialize the HMAC state. ]*/
+TEST_FUNCTION(SASToken_CreateBatch_with_different_keys_decodes_each_key)
 {
     // arrange
-    STRING_HANDLE handle;
-
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEY_HANDLE)).SetReturn(&TEST_CHAR_ARRAY[0]);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_SCOPE_HANDLE)).SetReturn(TEST_STRING_VALUE);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_KEYNAME_HANDLE)).SetReturn(TEST_STRING_VALUE);
+    SAS_TOKEN_REQUEST requests[2] = { { TEST_CHAR_ARRAY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY }, { TEST_OTHER_KEY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY } };
+    STRING_HANDLE tokens[2];
+    int result;
 
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
+    STRICT_EXPECTED_CALL(Base64_Decoder(TEST_CHAR_ARRAY)).SetReturn(TEST_DECODEDKEY_HANDLE);
+    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
     STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
-
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
-
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
-
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN)));
+    STRICT_EXPECTED_CALL(STRING_new_with_memory(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Base64_Decoder(TEST_OTHER_KEY)).SetReturn(TEST_DECODEDKEY_HANDLE);
     STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
-
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).IgnoreArgument(1).IgnoreArgument(3);
-    STRICT_EXPECTED_CALL(Base64_Encoder(TEST_HASH_HANDLE)).SetReturn(TEST_BASE64SIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(URL_Encode(TEST_BASE64SIGNATURE_HANDLE)).SetReturn(TEST_URLENCODEDSIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_copy(TEST_RESULT_HANDLE, "SharedAccessSignature sr="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&sig="));
-    STRICT_EXPECTED_CALL(STRING_concat_with_STRING(TEST_RESULT_HANDLE, TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&se="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&skn="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, IGNORED_PTR_ARG));
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_BASE64SIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
     STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN)));
+    STRICT_EXPECTED_CALL(STRING_new_with_memory(IGNORED_PTR_ARG));
 
     // act
-    handle = SASToken_Create(TEST_KEY_HANDLE, TEST_SCOPE_HANDLE, TEST_KEYNAME_HANDLE, TEST_EXPIRY);
+    result = SASToken_CreateBatch(requests, 2, tokens);
 
     // assert
-    ASSERT_IS_NOT_NULL(handle);
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(char_ptr, TEST_EXPECTED_SAS_TOKEN, (const char*)tokens[0]);
+    ASSERT_ARE_EQUAL(char_ptr, TEST_EXPECTED_SAS_TOKEN, (const char*)tokens[1]);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    free(tokens[0]);
+    free(tokens[1]);
 }
 
-TEST_FUNCTION(SASToken_CreateString_succeeds)
+/*Tests_SRS_SASTOKEN_01_014: [ If creating any token fails, SASToken_CreateBatch shall free all tokens created so far, set them to NULL and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateBatch_when_decoding_the_second_key_fails_frees_the_first_token)
 {
     // arrange
-    STRING_HANDLE handle;
+    SAS_TOKEN_REQUEST requests[2] = { { TEST_CHAR_ARRAY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY }, { TEST_OTHER_KEY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY } };
+    STRING_HANDLE tokens[2];
+    int result;
 
-    STRICT_EXPECTED_CALL(Base64_Decoder(&TEST_CHAR_ARRAY[0])).SetReturn(TEST_DECODEDKEY_HANDLE);
+    STRICT_EXPECTED_CALL(Base64_Decoder(TEST_CHAR_ARRAY)).SetReturn(TEST_DECODEDKEY_HANDLE);
+    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
     STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN)));
+    STRICT_EXPECTED_CALL(STRING_new_with_memory(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(Base64_Decoder(TEST_OTHER_KEY)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
-    STRICT_EXPECTED_CALL(BUFFER_new()).SetReturn(TEST_HASH_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_TOBEHASHED_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_new()).SetReturn(TEST_RESULT_HANDLE);
+    // act
+    result = SASToken_CreateBatch(requests, 2, tokens);
 
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, "\n"));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_TOBEHASHED_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(tokens[0]);
+    ASSERT_IS_NULL(tokens[1]);
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+}
 
-    STRICT_EXPECTED_CALL(STRING_length(TEST_TOBEHASHED_HANDLE)).SetReturn(TEST_LENGTH_TOBEHASHED);
-    STRICT_EXPECTED_CALL(STRING_c_str(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE)).SetReturn(TEST_LENGTH_DECODEDKEY);
-    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
+/*Tests_SRS_SASTOKEN_01_014: [ If creating any token fails, SASToken_CreateBatch shall free all tokens created so far, set them to NULL and return a non-zero value. ]*/
+TEST_FUNCTION(SASToken_CreateBatch_when_allocating_the_second_token_fails_frees_the_first_token)
+{
+    // arrange
+    SAS_TOKEN_REQUEST requests[2] = { { TEST_CHAR_ARRAY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY }, { TEST_CHAR_ARRAY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY } };
+    STRING_HANDLE tokens[2];
+    int result;
 
-    STRICT_EXPECTED_CALL(HMACSHA256_ComputeHash(IGNORED_PTR_ARG, TEST_LENGTH_DECODEDKEY, IGNORED_PTR_ARG, TEST_LENGTH_TOBEHASHED, TEST_HASH_HANDLE)).IgnoreArgument(1).IgnoreArgument(3);
-    STRICT_EXPECTED_CALL(Base64_Encoder(TEST_HASH_HANDLE)).SetReturn(TEST_BASE64SIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(URL_Encode(TEST_BASE64SIGNATURE_HANDLE)).SetReturn(TEST_URLENCODEDSIGNATURE_HANDLE);
-    STRICT_EXPECTED_CALL(STRING_copy(TEST_RESULT_HANDLE, "SharedAccessSignature sr="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, IGNORED_PTR_ARG));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&sig="));
-    STRICT_EXPECTED_CALL(STRING_concat_with_STRING(TEST_RESULT_HANDLE, TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&se="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, TEST_TOKEN_EXPIRATION_TIME));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, "&skn="));
-    STRICT_EXPECTED_CALL(STRING_concat(TEST_RESULT_HANDLE, IGNORED_PTR_ARG));
-
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_BASE64SIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_URLENCODEDSIGNATURE_HANDLE));
-    STRICT_EXPECTED_CALL(STRING_delete(TEST_TOBEHASHED_HANDLE));
-    STRICT_EXPECTED_CALL(BUFFER_delete(TEST_HASH_HANDLE));
+    STRICT_EXPECTED_CALL(Base64_Decoder(TEST_CHAR_ARRAY)).SetReturn(TEST_DECODEDKEY_HANDLE);
+    STRICT_EXPECTED_CALL(BUFFER_u_char(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(BUFFER_length(TEST_DECODEDKEY_HANDLE));
     STRICT_EXPECTED_CALL(BUFFER_delete(TEST_DECODEDKEY_HANDLE));
+    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN)));
+    STRICT_EXPECTED_CALL(STRING_new_with_memory(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(size_tToString(IGNORED_PTR_ARG, sizeof(TEST_TOKEN_EXPIRATION_TIME), TEST_EXPIRY)).IgnoreArgument(1).CopyOutArgumentBuffer(1, TEST_TOKEN_EXPIRATION_TIME, sizeof(TEST_TOKEN_EXPIRATION_TIME));
+    STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(TEST_EXPECTED_SAS_TOKEN))).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(STRING_delete(IGNORED_PTR_ARG));
 
     // act
-    handle = SASToken_CreateString(TEST_CHAR_ARRAY, TEST_STRING_VALUE, TEST_STRING_VALUE, TEST_EXPIRY);
+    result = SASToken_CreateBatch(requests, 2, tokens);
 
     // assert
-    ASSERT_IS_NOT_NULL(handle);
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_IS_NULL(tokens[0]);
+    ASSERT_IS_NULL(tokens[1]);
     ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 }
 
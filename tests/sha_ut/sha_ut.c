@@ -0,0 +1,221 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#endif
+
+#include "azure_c_shared_utility/sha.h"
+
+#include "testrunnerswitcher.h"
+
+#define MILLION_A_LENGTH 1000000
+
+/* known answers from FIPS 180-2 appendixes A, B and C (and the SHA-224 change notice) */
+static const char ABC[] = "abc";
+static const char TWO_BLOCKS[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+static const struct
+{
+    enum SHAversion whichSha;
+    const char* abcDigest;
+    const char* twoBlocksDigest;
+    const char* millionADigest;
+} knownAnswers[] =
+{
+    { SHA1,
+      "a9993e364706816aba3e25717850c26c9cd0d89d",
+      "84983e441c3bd26ebaae4aa1f95129e5e54670f1",
+      "34aa973cd4c4daa4f61eeb2bdbad27316534016f" },
+    { SHA224,
+      "23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7",
+      "75388b16512776cc5dba5da1fd890150b0c6455cb4f58b1952522525",
+      "20794655980c91d8bbb4c1ea97618a4bf03f42581948b2ee4ee7ad67" },
+    { SHA256,
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+      "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0" },
+    { SHA384,
+      "cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7",
+      "3391fdddfc8dc7393707a65b1b4709397cf8b1d162af05abfe8f450de5f36bc6b0455a8520bc4e6f5fe95b1fe3c8452b",
+      "9d0e1809716474cb086e834e310a4a1ced149e9c00f248527972cec5704c2a5b07b8b3dc38ecc4ebae97ddd87f3d8985" },
+    { SHA512,
+      "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f",
+      "204a8fc6dda82f0a0ced7beb8e08a41657c16ef468b228a8279be331a703c33596fd15c13b1b07f9aa1d3bea57789ca031ad85c7a71dd70354ec631238ca3445",
+      "e718483d0ce769644e2e42c7bc15b4638e1f98b13b2044285632a803afa973ebde0ff244877ea60a4cb0432ce577c31beb009c5c2c49aa2e4eadb217ad8cc09b" }
+};
+
+static TEST_MUTEX_HANDLE g_dllByDll;
+
+static unsigned char* millionA;
+static char hexDigest[USHAMaxHashSize * 2 + 1];
+
+/* hashes message in pieces of pieceSize bytes and returns the digest as a hex string */
+static const char* hash_in_pieces(enum SHAversion whichSha, const unsigned char* message, size_t messageLength, size_t pieceSize)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    USHAContext context;
+    uint8_t digest[USHAMaxHashSize];
+    size_t position;
+    int i;
+
+    ASSERT_ARE_EQUAL(int, shaSuccess, USHAReset(&context, whichSha));
+    for (position = 0; position < messageLength; position += pieceSize)
+    {
+        size_t length = ((messageLength - position) < pieceSize) ? (messageLength - position) : pieceSize;
+        ASSERT_ARE_EQUAL(int, shaSuccess, USHAInput(&context, message + position, (unsigned int)length));
+    }
+    ASSERT_ARE_EQUAL(int, shaSuccess, USHAResult(&context, digest));
+
+    for (i = 0; i < USHAHashSize(whichSha); i++)
+    {
+        hexDigest[i * 2] = hexDigits[digest[i] >> 4];
+        hexDigest[i * 2 + 1] = hexDigits[digest[i] & 0x0F];
+    }
+    hexDigest[i * 2] = '\0';
+
+    return hexDigest;
+}
+
+BEGIN_TEST_SUITE(sha_unittests)
+
+TEST_SUITE_INITIALIZE(TestSuiteInitialize)
+{
+    TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+
+    millionA = (unsigned char*)malloc(MILLION_A_LENGTH);
+    ASSERT_IS_NOT_NULL(millionA);
+    (void)memset(millionA, 'a', MILLION_A_LENGTH);
+}
+
+TEST_SUITE_CLEANUP(TestClassCleanup)
+{
+    free(millionA);
+
+    TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+}
+
+TEST_FUNCTION(USHA_known_answers_with_one_input)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(knownAnswers) / sizeof(knownAnswers[0]); i++)
+    {
+        ///act, assert
+        ASSERT_ARE_EQUAL(char_ptr, knownAnswers[i].abcDigest, hash_in_pieces(knownAnswers[i].whichSha, (const unsigned char*)ABC, sizeof(ABC) - 1, sizeof(ABC) - 1));
+        ASSERT_ARE_EQUAL(char_ptr, knownAnswers[i].twoBlocksDigest, hash_in_pieces(knownAnswers[i].whichSha, (const unsigned char*)TWO_BLOCKS, sizeof(TWO_BLOCKS) - 1, sizeof(TWO_BLOCKS) - 1));
+        ASSERT_ARE_EQUAL(char_ptr, knownAnswers[i].millionADigest, hash_in_pieces(knownAnswers[i].whichSha, millionA, MILLION_A_LENGTH, MILLION_A_LENGTH));
+    }
+}
+
+TEST_FUNCTION(USHA_known_answers_with_one_byte_inputs)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(knownAnswers) / sizeof(knownAnswers[0]); i++)
+    {
+        ///act, assert
+        ASSERT_ARE_EQUAL(char_ptr, knownAnswers[i].abcDigest, hash_in_pieces(knownAnswers[i].whichSha, (const unsigned char*)ABC, sizeof(ABC) - 1, 1));
+        ASSERT_ARE_EQUAL(char_ptr, knownAnswers[i].twoBlocksDigest, hash_in_pieces(knownAnswers[i].whichSha, (const unsigned char*)TWO_BLOCKS, sizeof(TWO_BLOCKS) - 1, 1));
+        ASSERT_ARE_EQUAL(char_ptr, knownAnswers[i].millionADigest, hash_in_pieces(knownAnswers[i].whichSha, millionA, MILLION_A_LENGTH, 1));
+    }
+}
+
+/* pieces that do not line up with the 64/128 byte blocks mix buffered bytes and whole blocks hashed in place */
+TEST_FUNCTION(USHA_known_answers_with_inputs_not_aligned_to_blocks)
+{
+    static const size_t pieceSizes[] = { 7, 63, 65, 129, 1000, 4097 };
+    size_t i;
+    size_t j;
+
+    for (i = 0; i < sizeof(knownAnswers) / sizeof(knownAnswers[0]); i++)
+    {
+        for (j = 0; j < sizeof(pieceSizes) / sizeof(pieceSizes[0]); j++)
+        {
+            ///act, assert
+            ASSERT_ARE_EQUAL(char_ptr, knownAnswers[i].twoBlocksDigest, hash_in_pieces(knownAnswers[i].whichSha, (const unsigned char*)TWO_BLOCKS, sizeof(TWO_BLOCKS) - 1, pieceSizes[j]));
+            ASSERT_ARE_EQUAL(char_ptr, knownAnswers[i].millionADigest, hash_in_pieces(knownAnswers[i].whichSha, millionA, MILLION_A_LENGTH, pieceSizes[j]));
+        }
+    }
+}
+
+TEST_FUNCTION(USHA_SHA1_and_SHA256_do_not_depend_on_how_the_message_is_split)
+{
+    unsigned char message[1000];
+    size_t i;
+    size_t pieceSize;
+
+    for (i = 0; i < sizeof(message); i++)
+    {
+        message[i] = (unsigned char)(i * 7);
+    }
+
+    for (pieceSize = 1; pieceSize <= 130; pieceSize++)
+    {
+        ///act, assert
+        ASSERT_ARE_EQUAL(char_ptr, "38f3aa587f4aa04965a359f9151092759b3a4c2a", hash_in_pieces(SHA1, message, sizeof(message), pieceSize));
+        ASSERT_ARE_EQUAL(char_ptr, "89f4ff56a25dd1db06a4ce6033603775d705fb96f30f8693733fef602a1ca532", hash_in_pieces(SHA256, message, sizeof(message), pieceSize));
+    }
+}
+
+TEST_FUNCTION(SHA256InputResultMultiple_matches_SHA256_for_every_message)
+{
+    /* lengths around the block and padding boundaries, more messages than lanes */
+    static const unsigned int lengths[] = { 0, 1, 3, 55, 56, 57, 63, 64, 65, 119, 120, 128, 200, 1000, 56, 3, 0 };
+    SHA256Context contexts[sizeof(lengths) / sizeof(lengths[0])];
+    const uint8_t* messages[sizeof(lengths) / sizeof(lengths[0])];
+    uint8_t digests[sizeof(lengths) / sizeof(lengths[0])][SHA256HashSize];
+    size_t i;
+
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        ASSERT_ARE_EQUAL(int, shaSuccess, SHA256Reset(&contexts[i]));
+        messages[i] = millionA + i;
+    }
+    /* a context that already holds part of its message */
+    ASSERT_ARE_EQUAL(int, shaSuccess, SHA256Input(&contexts[5], millionA, 70));
+
+    ///act
+    ASSERT_ARE_EQUAL(int, shaSuccess, SHA256InputResultMultiple(contexts, messages, lengths, digests, (unsigned int)(sizeof(lengths) / sizeof(lengths[0]))));
+
+    ///assert
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        SHA256Context context;
+        uint8_t expectedDigest[SHA256HashSize];
+        ASSERT_ARE_EQUAL(int, shaSuccess, SHA256Reset(&context));
+        if (i == 5)
+        {
+            ASSERT_ARE_EQUAL(int, shaSuccess, SHA256Input(&context, millionA, 70));
+        }
+        ASSERT_ARE_EQUAL(int, shaSuccess, SHA256Input(&context, messages[i], lengths[i]));
+        ASSERT_ARE_EQUAL(int, shaSuccess, SHA256Result(&context, expectedDigest));
+        ASSERT_ARE_EQUAL(int, 0, memcmp(expectedDigest, digests[i], SHA256HashSize));
+    }
+}
+
+TEST_FUNCTION(SHA256InputResultMultiple_with_a_computed_context_fails)
+{
+    SHA256Context contexts[2];
+    const uint8_t* messages[2] = { (const uint8_t*)ABC, (const uint8_t*)ABC };
+    const unsigned int lengths[2] = { sizeof(ABC) - 1, sizeof(ABC) - 1 };
+    uint8_t digests[2][SHA256HashSize];
+
+    (void)SHA256Reset(&contexts[0]);
+    (void)SHA256Reset(&contexts[1]);
+    (void)SHA256Result(&contexts[1], digests[1]);
+
+    ///act
+    int result = SHA256InputResultMultiple(contexts, messages, lengths, digests, 2);
+
+    ///assert
+    ASSERT_ARE_EQUAL(int, shaStateError, result);
+}
+
+END_TEST_SUITE(sha_unittests)
@@ -0,0 +1,744 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#ifndef SIZE_MAX
+#define SIZE_MAX ((size_t)~(size_t)0)
+#endif
+
+static void* my_gballoc_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* my_gballoc_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_gballoc_free(void* s)
+{
+    free(s);
+}
+
+#define ENABLE_MOCKS
+#include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/lock.h"
+#undef ENABLE_MOCKS
+
+#include "azure_c_shared_utility/slaballoc.h"
+
+#include "testrunnerswitcher.h"
+#include "umock_c.h"
+
+static const LOCK_HANDLE TEST_LOCK_HANDLE = (LOCK_HANDLE)0x4244;
+
+/* one lock per size class */
+#define TEST_SIZE_CLASS_COUNT 8
+/* blocks carved out of each slab */
+#define TEST_BLOCKS_PER_SLAB 64
+
+TEST_DEFINE_ENUM_TYPE(LOCK_RESULT, LOCK_RESULT_VALUES);
+IMPLEMENT_UMOCK_C_ENUM_TYPE(LOCK_RESULT, LOCK_RESULT_VALUES);
+
+DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    char temp_str[256];
+    (void)snprintf(temp_str, sizeof(temp_str), "umock_c reported error :%s", ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+    ASSERT_FAIL(temp_str);
+}
+
+static TEST_MUTEX_HANDLE g_testByTest;
+static TEST_MUTEX_HANDLE g_dllByDll;
+
+static void init_slaballoc(void)
+{
+    ASSERT_ARE_EQUAL(int, 0, slaballoc_init());
+    umock_c_reset_all_calls();
+}
+
+BEGIN_TEST_SUITE(slaballoc_UnitTests)
+
+    TEST_SUITE_INITIALIZE(TestClassInitialize)
+    {
+        TEST_INITIALIZE_MEMORY_DEBUG(g_dllByDll);
+
+        g_testByTest = TEST_MUTEX_CREATE();
+        ASSERT_IS_NOT_NULL(g_testByTest);
+
+        int result = umock_c_init(on_umock_c_error);
+        ASSERT_ARE_EQUAL(int, 0, result);
+
+        REGISTER_UMOCK_ALIAS_TYPE(LOCK_HANDLE, void*);
+        REGISTER_TYPE(LOCK_RESULT, LOCK_RESULT);
+
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_malloc, my_gballoc_malloc);
+        REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_malloc, NULL);
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_realloc, my_gballoc_realloc);
+        REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_realloc, NULL);
+        REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+
+        REGISTER_GLOBAL_MOCK_RETURN(Lock_Init, TEST_LOCK_HANDLE);
+        REGISTER_GLOBAL_MOCK_RETURN(Lock, LOCK_OK);
+        REGISTER_GLOBAL_MOCK_RETURN(Unlock, LOCK_OK);
+        REGISTER_GLOBAL_MOCK_RETURN(Lock_Deinit, LOCK_OK);
+    }
+
+    TEST_SUITE_CLEANUP(TestClassCleanup)
+    {
+        umock_c_deinit();
+        TEST_MUTEX_DESTROY(g_testByTest);
+
+        TEST_DEINITIALIZE_MEMORY_DEBUG(g_dllByDll);
+    }
+
+    TEST_FUNCTION_INITIALIZE(TestMethodInitialize)
+    {
+        if (TEST_MUTEX_ACQUIRE(g_testByTest))
+        {
+            ASSERT_FAIL("our mutex is ABANDONED. Failure in test framework");
+        }
+
+        umock_c_reset_all_calls();
+    }
+
+    TEST_FUNCTION_CLEANUP(TestMethodCleanup)
+    {
+        slaballoc_deinit();
+
+        TEST_MUTEX_RELEASE(g_testByTest);
+    }
+
+    /* slaballoc_init */
+
+    /* Tests_SRS_SLABALLOC_01_001: [ slaballoc_init shall initialize the slaballoc module and return 0 upon success. ]*/
+    /* Tests_SRS_SLABALLOC_01_003: [ slaballoc_init shall create one lock for each size class by calling Lock_Init. ]*/
+    TEST_FUNCTION(slaballoc_init_creates_one_lock_per_size_class)
+    {
+        ///arrange
+        size_t i;
+        for (i = 0; i < TEST_SIZE_CLASS_COUNT; i++)
+        {
+            STRICT_EXPECTED_CALL(Lock_Init());
+        }
+
+        ///act
+        int result = slaballoc_init();
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_SLABALLOC_01_002: [ Init after Init shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(slaballoc_init_after_slaballoc_init_fails)
+    {
+        ///arrange
+        init_slaballoc();
+
+        ///act
+        int result = slaballoc_init();
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_SLABALLOC_01_004: [ If creating any of the locks fails, slaballoc_init shall destroy the locks created so far and return a non-zero value. ]*/
+    TEST_FUNCTION(when_Lock_Init_fails_slaballoc_init_destroys_the_locks_created_so_far_and_fails)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(Lock_Init());
+        STRICT_EXPECTED_CALL(Lock_Init());
+        STRICT_EXPECTED_CALL(Lock_Init())
+            .SetReturn((LOCK_HANDLE)NULL);
+        STRICT_EXPECTED_CALL(Lock_Deinit(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(Lock_Deinit(TEST_LOCK_HANDLE));
+
+        ///act
+        int result = slaballoc_init();
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        umock_c_reset_all_calls();
+        slaballoc_deinit();
+        ASSERT_ARE_EQUAL(char_ptr, "", umock_c_get_actual_calls());
+    }
+
+    /* slaballoc_deinit */
+
+    /* Tests_SRS_SLABALLOC_01_005: [ slaballoc_deinit shall free all the slabs and destroy the locks created by slaballoc_init. ]*/
+    TEST_FUNCTION(slaballoc_deinit_frees_the_slabs_and_the_locks)
+    {
+        ///arrange
+        size_t i;
+        init_slaballoc();
+        slaballoc_free(slaballoc_malloc(16));
+        slaballoc_free(slaballoc_malloc(200));
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        for (i = 0; i < TEST_SIZE_CLASS_COUNT - 1; i++)
+        {
+            STRICT_EXPECTED_CALL(Lock_Deinit(TEST_LOCK_HANDLE));
+        }
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(Lock_Deinit(TEST_LOCK_HANDLE));
+
+        ///act
+        slaballoc_deinit();
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_SLABALLOC_01_006: [ If slaballoc is not initialized slaballoc_deinit shall do nothing. ]*/
+    TEST_FUNCTION(slaballoc_deinit_without_init_does_nothing)
+    {
+        ///act
+        slaballoc_deinit();
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* slaballoc_malloc */
+
+    /* Tests_SRS_SLABALLOC_01_007: [ If slaballoc is not initialized, slaballoc_malloc shall call malloc for size bytes plus a block header and return the memory following the header. ]*/
+    /* Tests_SRS_SLABALLOC_01_025: [ If ptr was passed through to malloc, slaballoc_free shall free the underlying allocation. ]*/
+    TEST_FUNCTION(slaballoc_malloc_without_init_passes_through_to_malloc)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size();
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+        ///act
+        unsigned char* result = (unsigned char*)slaballoc_malloc(16);
+        ASSERT_IS_NOT_NULL(result);
+        (void)memset(result, 0x42, 16);
+        slaballoc_free(result);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_SLABALLOC_01_008: [ If size is greater than SLABALLOC_MAX_BLOCK_SIZE, slaballoc_malloc shall call malloc for size bytes plus a block header and return the memory following the header. ]*/
+    TEST_FUNCTION(slaballoc_malloc_passes_sizes_above_the_largest_size_class_through_to_malloc)
+    {
+        ///arrange
+        init_slaballoc();
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size();
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+        ///act
+        unsigned char* result = (unsigned char*)slaballoc_malloc(SLABALLOC_MAX_BLOCK_SIZE + 1);
+        ASSERT_IS_NOT_NULL(result);
+        (void)memset(result, 0x42, SLABALLOC_MAX_BLOCK_SIZE + 1);
+        slaballoc_free(result);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_SLABALLOC_01_009: [ If size plus the size of the block header overflows, slaballoc_malloc shall fail and return NULL. ]*/
+    TEST_FUNCTION(slaballoc_malloc_with_SIZE_MAX_fails)
+    {
+        ///arrange
+        init_slaballoc();
+
+        ///act
+        void* result = slaballoc_malloc(SIZE_MAX);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_SLABALLOC_01_010: [ Otherwise slaballoc_malloc shall return a block taken from the free list of the smallest size class whose blocks can hold size bytes. ]*/
+    /* Tests_SRS_SLABALLOC_01_011: [ If the free list of the size class is empty, slaballoc_malloc shall allocate a new slab holding SLABALLOC_BLOCKS_PER_SLAB blocks by calling malloc and add its blocks to the free list. ]*/
+    /* Tests_SRS_SLABALLOC_01_013: [ slaballoc_malloc shall only access the free list of a size class while holding the lock of the size class. ]*/
+    TEST_FUNCTION(the_first_slaballoc_malloc_of_a_size_class_allocates_a_slab)
+    {
+        ///arrange
+        init_slaballoc();
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size();
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        unsigned char* result = (unsigned char*)slaballoc_malloc(40);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)memset(result, 0x42, 40);
+
+        ///cleanup
+        slaballoc_free(result);
+    }
+
+    /* Tests_SRS_SLABALLOC_01_010: [ Otherwise slaballoc_malloc shall return a block taken from the free list of the smallest size class whose blocks can hold size bytes. ]*/
+    TEST_FUNCTION(slaballoc_malloc_takes_the_following_blocks_from_the_slab_without_allocating)
+    {
+        ///arrange
+        init_slaballoc();
+        void* first = slaballoc_malloc(40);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        void* result = slaballoc_malloc(48);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_NOT_EQUAL(void_ptr, first, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        slaballoc_free(result);
+        slaballoc_free(first);
+    }
+
+    /* Tests_SRS_SLABALLOC_01_011: [ If the free list of the size class is empty, slaballoc_malloc shall allocate a new slab holding SLABALLOC_BLOCKS_PER_SLAB blocks by calling malloc and add its blocks to the free list. ]*/
+    TEST_FUNCTION(slaballoc_malloc_allocates_a_new_slab_when_all_blocks_are_in_use)
+    {
+        ///arrange
+        void* blocks[TEST_BLOCKS_PER_SLAB];
+        size_t i;
+        init_slaballoc();
+        for (i = 0; i < TEST_BLOCKS_PER_SLAB; i++)
+        {
+            blocks[i] = slaballoc_malloc(8);
+            ASSERT_IS_NOT_NULL(blocks[i]);
+        }
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size();
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        void* result = slaballoc_malloc(8);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        slaballoc_free(result);
+        for (i = 0; i < TEST_BLOCKS_PER_SLAB; i++)
+        {
+            slaballoc_free(blocks[i]);
+        }
+    }
+
+    /* Tests_SRS_SLABALLOC_01_012: [ If allocating the slab fails, slaballoc_malloc shall fail and return NULL. ]*/
+    TEST_FUNCTION(when_allocating_the_slab_fails_slaballoc_malloc_fails)
+    {
+        ///arrange
+        init_slaballoc();
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size()
+            .SetReturn(NULL);
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        void* result = slaballoc_malloc(100);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_SLABALLOC_01_014: [ If acquiring the lock fails, slaballoc_malloc shall fail and return NULL. ]*/
+    TEST_FUNCTION(when_Lock_fails_slaballoc_malloc_fails)
+    {
+        ///arrange
+        init_slaballoc();
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE))
+            .SetReturn(LOCK_ERROR);
+
+        ///act
+        void* result = slaballoc_malloc(100);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    TEST_FUNCTION(slaballoc_malloc_returns_pointer_aligned_blocks_of_every_size_class)
+    {
+        ///arrange
+        void* blocks[SLABALLOC_MAX_BLOCK_SIZE + 1];
+        size_t i;
+        init_slaballoc();
+
+        ///act
+        for (i = 0; i <= SLABALLOC_MAX_BLOCK_SIZE; i++)
+        {
+            blocks[i] = slaballoc_malloc(i);
+
+            ///assert
+            ASSERT_IS_NOT_NULL(blocks[i]);
+            ASSERT_ARE_EQUAL(size_t, 0, (size_t)((uintptr_t)blocks[i] % sizeof(void*)));
+            (void)memset(blocks[i], 0x42, i);
+        }
+
+        ///cleanup
+        for (i = 0; i <= SLABALLOC_MAX_BLOCK_SIZE; i++)
+        {
+            slaballoc_free(blocks[i]);
+        }
+    }
+
+    /* slaballoc_calloc */
+
+    /* Tests_SRS_SLABALLOC_01_016: [ If nmemb * size overflows, slaballoc_calloc shall fail and return NULL. ]*/
+    TEST_FUNCTION(slaballoc_calloc_with_overflowing_size_fails)
+    {
+        ///arrange
+        init_slaballoc();
+
+        ///act
+        void* result = slaballoc_calloc(SIZE_MAX / 2, 4);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_SLABALLOC_01_017: [ slaballoc_calloc shall allocate nmemb * size bytes as slaballoc_malloc does and set them to 0. ]*/
+    TEST_FUNCTION(slaballoc_calloc_zeroes_a_reused_block)
+    {
+        ///arrange
+        size_t i;
+        init_slaballoc();
+        unsigned char* block = (unsigned char*)slaballoc_malloc(32);
+        (void)memset(block, 0xAA, 32);
+        slaballoc_free(block);
+
+        ///act
+        unsigned char* result = (unsigned char*)slaballoc_calloc(4, 8);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, block, result);
+        for (i = 0; i < 32; i++)
+        {
+            ASSERT_ARE_EQUAL(int, 0, result[i]);
+        }
+
+        ///cleanup
+        slaballoc_free(result);
+    }
+
+    /* slaballoc_realloc */
+
+    /* Tests_SRS_SLABALLOC_01_018: [ If ptr is NULL, slaballoc_realloc shall behave as slaballoc_malloc. ]*/
+    TEST_FUNCTION(slaballoc_realloc_with_NULL_ptr_allocates_a_block)
+    {
+        ///arrange
+        init_slaballoc();
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size();
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        void* result = slaballoc_realloc(NULL, 16);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        slaballoc_free(result);
+    }
+
+    /* Tests_SRS_SLABALLOC_01_019: [ If ptr is a block of a size class that can hold size bytes, slaballoc_realloc shall return ptr. ]*/
+    TEST_FUNCTION(slaballoc_realloc_within_the_size_class_returns_the_same_block)
+    {
+        ///arrange
+        init_slaballoc();
+        void* block = slaballoc_malloc(17);
+        umock_c_reset_all_calls();
+
+        ///act
+        void* result = slaballoc_realloc(block, 32);
+
+        ///assert
+        ASSERT_ARE_EQUAL(void_ptr, block, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        slaballoc_free(result);
+    }
+
+    /* Tests_SRS_SLABALLOC_01_020: [ Otherwise slaballoc_realloc shall allocate size bytes with slaballoc_malloc, copy the content of the block, free the block with slaballoc_free and return the new memory. ]*/
+    TEST_FUNCTION(slaballoc_realloc_to_a_larger_size_class_moves_the_content)
+    {
+        ///arrange
+        init_slaballoc();
+        unsigned char* block = (unsigned char*)slaballoc_malloc(16);
+        (void)memcpy(block, "0123456789ABCDEF", 16);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size();
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        unsigned char* result = (unsigned char*)slaballoc_realloc(block, 64);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_NOT_EQUAL(void_ptr, block, result);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(result, "0123456789ABCDEF", 16));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        /* the old block went back to its size class */
+        ASSERT_ARE_EQUAL(void_ptr, block, slaballoc_malloc(16));
+
+        ///cleanup
+        slaballoc_free(block);
+        slaballoc_free(result);
+    }
+
+    /* Tests_SRS_SLABALLOC_01_020: [ Otherwise slaballoc_realloc shall allocate size bytes with slaballoc_malloc, copy the content of the block, free the block with slaballoc_free and return the new memory. ]*/
+    TEST_FUNCTION(slaballoc_realloc_above_the_largest_size_class_moves_the_content_to_malloc)
+    {
+        ///arrange
+        init_slaballoc();
+        unsigned char* block = (unsigned char*)slaballoc_malloc(SLABALLOC_MAX_BLOCK_SIZE);
+        (void)memset(block, 0x42, SLABALLOC_MAX_BLOCK_SIZE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size();
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        unsigned char* result = (unsigned char*)slaballoc_realloc(block, 2 * SLABALLOC_MAX_BLOCK_SIZE);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_EQUAL(int, 0x42, result[0]);
+        ASSERT_ARE_EQUAL(int, 0x42, result[SLABALLOC_MAX_BLOCK_SIZE - 1]);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)memset(result, 0x43, 2 * SLABALLOC_MAX_BLOCK_SIZE);
+
+        ///cleanup
+        slaballoc_free(result);
+    }
+
+    /* Tests_SRS_SLABALLOC_01_021: [ If the allocation fails, slaballoc_realloc shall return NULL and leave ptr unchanged. ]*/
+    TEST_FUNCTION(when_allocating_the_new_block_fails_slaballoc_realloc_fails_and_keeps_the_block)
+    {
+        ///arrange
+        init_slaballoc();
+        unsigned char* block = (unsigned char*)slaballoc_malloc(16);
+        (void)memcpy(block, "0123456789ABCDEF", 16);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size()
+            .SetReturn(NULL);
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        void* result = slaballoc_realloc(block, 64);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(block, "0123456789ABCDEF", 16));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        slaballoc_free(block);
+    }
+
+    /* Tests_SRS_SLABALLOC_01_022: [ If ptr was passed through to malloc, slaballoc_realloc shall call realloc for size bytes plus the block header and return the memory following the header. ]*/
+    TEST_FUNCTION(slaballoc_realloc_of_a_passed_through_allocation_calls_realloc)
+    {
+        ///arrange
+        init_slaballoc();
+        unsigned char* block = (unsigned char*)slaballoc_malloc(1000);
+        (void)memcpy(block, "0123456789ABCDEF", 16);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG))
+            .IgnoreArgument_ptr()
+            .IgnoreArgument_size();
+
+        ///act
+        unsigned char* result = (unsigned char*)slaballoc_realloc(block, 2000);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_EQUAL(int, 0, memcmp(result, "0123456789ABCDEF", 16));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        (void)memset(result, 0x42, 2000);
+
+        ///cleanup
+        slaballoc_free(result);
+    }
+
+    /* Tests_SRS_SLABALLOC_01_023: [ If realloc fails, slaballoc_realloc shall fail and return NULL. ]*/
+    TEST_FUNCTION(when_realloc_fails_slaballoc_realloc_fails)
+    {
+        ///arrange
+        init_slaballoc();
+        void* block = slaballoc_malloc(1000);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG))
+            .IgnoreArgument_ptr()
+            .IgnoreArgument_size()
+            .SetReturn(NULL);
+
+        ///act
+        void* result = slaballoc_realloc(block, 2000);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        slaballoc_free(block);
+    }
+
+    /* slaballoc_free */
+
+    /* Tests_SRS_SLABALLOC_01_024: [ If ptr is NULL, slaballoc_free shall do nothing. ]*/
+    TEST_FUNCTION(slaballoc_free_with_NULL_does_nothing)
+    {
+        ///arrange
+        init_slaballoc();
+
+        ///act
+        slaballoc_free(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_SLABALLOC_01_026: [ Otherwise slaballoc_free shall put the block back on the free list of its size class while holding the lock of the size class. ]*/
+    TEST_FUNCTION(slaballoc_free_puts_the_block_back_for_reuse)
+    {
+        ///arrange
+        init_slaballoc();
+        void* block = slaballoc_malloc(24);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE));
+        STRICT_EXPECTED_CALL(Unlock(TEST_LOCK_HANDLE));
+
+        ///act
+        slaballoc_free(block);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(void_ptr, block, slaballoc_malloc(32));
+
+        ///cleanup
+        slaballoc_free(block);
+    }
+
+    /* Tests_SRS_SLABALLOC_01_025: [ If ptr was passed through to malloc, slaballoc_free shall free the underlying allocation. ]*/
+    TEST_FUNCTION(slaballoc_free_after_init_frees_a_block_allocated_before_init)
+    {
+        ///arrange
+        void* block = slaballoc_malloc(16);
+        init_slaballoc();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG));
+
+        ///act
+        slaballoc_free(block);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_SLABALLOC_01_028: [ If acquiring the lock fails, slaballoc_free shall log the error and leave the block unused until slaballoc_deinit. ]*/
+    TEST_FUNCTION(when_Lock_fails_slaballoc_free_leaves_the_block_unused)
+    {
+        ///arrange
+        init_slaballoc();
+        void* block = slaballoc_malloc(24);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(Lock(TEST_LOCK_HANDLE))
+            .SetReturn(LOCK_ERROR);
+
+        ///act
+        slaballoc_free(block);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        void* next = slaballoc_malloc(24);
+        ASSERT_ARE_NOT_EQUAL(void_ptr, block, next);
+
+        ///cleanup
+        slaballoc_free(next);
+    }
+
+    /* slaballoc_release_thread_cache */
+
+    /* Tests_SRS_SLABALLOC_01_030: [ If slaballoc is not initialized, slaballoc_release_thread_cache shall do nothing. ]*/
+    TEST_FUNCTION(slaballoc_release_thread_cache_without_init_does_nothing)
+    {
+        ///act
+        slaballoc_release_thread_cache();
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* these tests build slaballoc without SLABALLOC_THREAD_CACHE, so a freed block is already back on the free list of its size class */
+    TEST_FUNCTION(slaballoc_release_thread_cache_without_thread_cache_does_nothing)
+    {
+        ///arrange
+        init_slaballoc();
+        void* block = slaballoc_malloc(24);
+        slaballoc_free(block);
+        umock_c_reset_all_calls();
+
+        ///act
+        slaballoc_release_thread_cache();
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+        ASSERT_ARE_EQUAL(void_ptr, block, slaballoc_malloc(24));
+
+        ///cleanup
+        slaballoc_free(block);
+    }
+
+END_TEST_SUITE(slaballoc_UnitTests)
@@ -4,9 +4,11 @@
 #ifdef __cplusplus
 #include <cstdlib>
 #include <cstddef>
+#include <cstring>
 #else
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
 #endif
 
 #include "testrunnerswitcher.h"
@@ -326,10 +328,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         ///act
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "m");
 
@@ -356,10 +354,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         ///act
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "P");
 
@@ -387,10 +381,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         ///act
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "P");
 
@@ -442,10 +432,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         ///act1
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "P");
 
@@ -479,10 +465,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         ///act1
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "?");
 
@@ -510,16 +492,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result1. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result2. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result3. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         ///act1
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "P");
         
@@ -587,11 +559,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         umock_c_reset_all_calls();
 
         ///act1
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
-
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "?");
 
         ///Assert1
@@ -599,11 +566,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         ASSERT_ARE_EQUAL(int, r, 0);
 
         ///act2
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
-
         r = STRING_TOKENIZER_get_next_token(t, output_string_handle, ",");
 
         ///Assert2
@@ -611,10 +573,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         ASSERT_ARE_EQUAL(int, r, 0);
 
         ///act3
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
         r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "#,");
 
         ///Assert3
@@ -648,11 +606,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         umock_c_reset_all_calls();
 
         ///act1
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
-
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "?");
 
         ///Assert1
@@ -686,11 +639,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         umock_c_reset_all_calls();
 
         ///act1
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
-
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "1");
 
         ///Assert1
@@ -719,9 +667,7 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         umock_c_reset_all_calls();
 
         ///act1
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
+        EXPECTED_CALL(gballoc_free(0));  //Token fits in the STRING, the longer content is released.
 
 
         int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "\r\n");
@@ -731,11 +677,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         ASSERT_ARE_EQUAL(int, r, 0);
 
         ///act2
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
-
         r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "\r\n");
 
         ///Assert2
@@ -743,11 +684,6 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         ASSERT_ARE_EQUAL(int, r, 0);
 
         ///act3
-        EXPECTED_CALL(gballoc_realloc(0, 0))  //Alloc memory to copy result. 
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
-
-
         r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "\r\n\t");
 
         ///Assert3
@@ -760,6 +696,45 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         STRING_delete(input_string_handle);
         STRING_delete(output_string_handle);
     }
+    /* Tests_SRS_STRING_04_008: [STRING_TOKENIZER_get_next_token than searches from the start of a token for a character that is contained in the delimiters string.] */
+    /* Tests_SRS_STRING_04_010: [If such a character is found, STRING_TOKENIZER_get_next_token consider it the end of the token and copy it's content to output, updates the current position inside t to the next character and returns 0.] */
+    TEST_FUNCTION(STRING_TOKENIZER_get_next_token_ends_the_token_at_the_first_of_several_delimiters)
+    {
+        ///arrange
+        const char* inputString = "a;b=c";
+
+        STRING_HANDLE output_string_handle = STRING_new();
+        STRING_TOKENIZER_HANDLE t = STRING_TOKENIZER_create_from_char(inputString);
+
+        umock_c_reset_all_calls();
+
+        ///act1
+        int r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "=;");
+
+        ///Assert1
+        ASSERT_ARE_EQUAL(char_ptr, "a", STRING_c_str(output_string_handle));
+        ASSERT_ARE_EQUAL(int, r, 0);
+
+        ///act2
+        r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "=;");
+
+        ///Assert2
+        ASSERT_ARE_EQUAL(char_ptr, "b", STRING_c_str(output_string_handle));
+        ASSERT_ARE_EQUAL(int, r, 0);
+
+        ///act3
+        r = STRING_TOKENIZER_get_next_token(t, output_string_handle, "=;");
+
+        ///Assert3
+        ASSERT_ARE_EQUAL(char_ptr, "c", STRING_c_str(output_string_handle));
+        ASSERT_ARE_EQUAL(int, r, 0);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///Clean Up
+        STRING_TOKENIZER_destroy(t);
+        STRING_delete(output_string_handle);
+    }
+
     /* STRING_TOKENIZER_delete */
     /*Test_SRS_STRING_TOKENIZER_04_012: [STRING_TOKENIZER_destroy shall free the memory allocated by the STRING_TOKENIZER_create ] */
     TEST_FUNCTION(STRING_TOKENIZER_DESTROY_Succeed)
@@ -800,4 +775,228 @@ BEGIN_TEST_SUITE(string_tokenizer_unittests)
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
     }
 
+    /* STRING_VIEW_get_next_token */
+
+    /* Tests_SRS_STRING_TOKENIZER_01_001: [ If input, token or delimiters is NULL, STRING_VIEW_get_next_token shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_VIEW_get_next_token_with_NULL_input_fails)
+    {
+        ///arrange
+        STRING_VIEW token;
+
+        ///act
+        int r = STRING_VIEW_get_next_token(NULL, &token, ";");
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, r);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_01_001: [ If input, token or delimiters is NULL, STRING_VIEW_get_next_token shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_VIEW_get_next_token_with_NULL_token_fails)
+    {
+        ///arrange
+        STRING_VIEW input;
+        input.str = "a;b";
+        input.length = 3;
+
+        ///act
+        int r = STRING_VIEW_get_next_token(&input, NULL, ";");
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, r);
+        ASSERT_ARE_EQUAL(size_t, 3, input.length);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_01_001: [ If input, token or delimiters is NULL, STRING_VIEW_get_next_token shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_VIEW_get_next_token_with_NULL_delimiters_fails)
+    {
+        ///arrange
+        STRING_VIEW input;
+        STRING_VIEW token;
+        input.str = "a;b";
+        input.length = 3;
+
+        ///act
+        int r = STRING_VIEW_get_next_token(&input, &token, NULL);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, r);
+        ASSERT_ARE_EQUAL(size_t, 3, input.length);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_01_002: [ If delimiters is an empty string, STRING_VIEW_get_next_token shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_VIEW_get_next_token_with_empty_delimiters_fails)
+    {
+        ///arrange
+        STRING_VIEW input;
+        STRING_VIEW token;
+        input.str = "a;b";
+        input.length = 3;
+
+        ///act
+        int r = STRING_VIEW_get_next_token(&input, &token, "");
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, r);
+        ASSERT_ARE_EQUAL(size_t, 3, input.length);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_01_003: [ STRING_VIEW_get_next_token shall skip the characters at the beginning of input that are contained in delimiters. ]*/
+    /* Tests_SRS_STRING_TOKENIZER_01_005: [ Otherwise STRING_VIEW_get_next_token shall set token to the characters from the first character not contained in delimiters up to, but not including, the next character contained in delimiters or the end of input, and return 0. ]*/
+    /* Tests_SRS_STRING_TOKENIZER_01_006: [ STRING_VIEW_get_next_token shall advance input past the token and the delimiter that ended it. ]*/
+    /* Tests_SRS_STRING_TOKENIZER_01_007: [ STRING_VIEW_get_next_token shall not allocate memory and shall not copy characters. ]*/
+    TEST_FUNCTION(STRING_VIEW_get_next_token_returns_a_view_of_the_first_token)
+    {
+        ///arrange
+        const char* inputString = "?;ab?cd";
+        STRING_VIEW input;
+        STRING_VIEW token;
+        input.str = inputString;
+        input.length = strlen(inputString);
+
+        ///act
+        int r = STRING_VIEW_get_next_token(&input, &token, ";?");
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, r);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(inputString + 2), (void*)token.str);
+        ASSERT_ARE_EQUAL(size_t, 2, token.length);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(inputString + 5), (void*)input.str);
+        ASSERT_ARE_EQUAL(size_t, 2, input.length);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_01_005: [ Otherwise STRING_VIEW_get_next_token shall set token to the characters from the first character not contained in delimiters up to, but not including, the next character contained in delimiters or the end of input, and return 0. ]*/
+    /* Tests_SRS_STRING_TOKENIZER_01_006: [ STRING_VIEW_get_next_token shall advance input past the token and the delimiter that ended it. ]*/
+    TEST_FUNCTION(STRING_VIEW_get_next_token_ends_the_last_token_at_the_end_of_input)
+    {
+        ///arrange
+        const char* inputString = "ab;cd;ef";
+        STRING_VIEW input;
+        STRING_VIEW token;
+        input.str = inputString + 3;
+        input.length = 2;
+
+        ///act
+        int r = STRING_VIEW_get_next_token(&input, &token, ";");
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, r);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(inputString + 3), (void*)token.str);
+        ASSERT_ARE_EQUAL(size_t, 2, token.length);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(inputString + 5), (void*)input.str);
+        ASSERT_ARE_EQUAL(size_t, 0, input.length);
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_01_005: [ Otherwise STRING_VIEW_get_next_token shall set token to the characters from the first character not contained in delimiters up to, but not including, the next character contained in delimiters or the end of input, and return 0. ]*/
+    TEST_FUNCTION(STRING_VIEW_get_next_token_does_not_stop_at_a_zero_character)
+    {
+        ///arrange
+        const char inputString[] = "a\0b;c";
+        STRING_VIEW input;
+        STRING_VIEW token;
+        input.str = inputString;
+        input.length = sizeof(inputString) - 1;
+
+        ///act
+        int r = STRING_VIEW_get_next_token(&input, &token, ";");
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, r);
+        ASSERT_ARE_EQUAL(size_t, 3, token.length);
+        ASSERT_ARE_EQUAL(size_t, 1, input.length);
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_01_006: [ STRING_VIEW_get_next_token shall advance input past the token and the delimiter that ended it. ]*/
+    /* Tests_SRS_STRING_TOKENIZER_01_004: [ If no other character remains in input, STRING_VIEW_get_next_token shall set input to an empty view at its end and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_VIEW_get_next_token_called_repeatedly_returns_all_tokens)
+    {
+        ///arrange
+        const char* inputString = "HostName=h;DeviceId=d;SharedAccessKey=k==;";
+        const char* expected_tokens[] = { "HostName", "h", "DeviceId", "d", "SharedAccessKey", "k==" };
+        const char* delimiters[] = { "=", ";", "=", ";", "=", ";" };
+        STRING_VIEW input;
+        STRING_VIEW token;
+        size_t i;
+        int r;
+        input.str = inputString;
+        input.length = strlen(inputString);
+
+        ///act
+        for (i = 0; i < sizeof(expected_tokens) / sizeof(expected_tokens[0]); i++)
+        {
+            r = STRING_VIEW_get_next_token(&input, &token, delimiters[i]);
+
+            ///assert
+            ASSERT_ARE_EQUAL(int, 0, r);
+            ASSERT_ARE_EQUAL(size_t, strlen(expected_tokens[i]), token.length);
+            ASSERT_ARE_EQUAL(int, 0, memcmp(expected_tokens[i], token.str, token.length));
+        }
+
+        r = STRING_VIEW_get_next_token(&input, &token, "=");
+        ASSERT_ARE_NOT_EQUAL(int, 0, r);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(inputString + strlen(inputString)), (void*)input.str);
+        ASSERT_ARE_EQUAL(size_t, 0, input.length);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_01_004: [ If no other character remains in input, STRING_VIEW_get_next_token shall set input to an empty view at its end and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_VIEW_get_next_token_with_only_delimiters_consumes_input_and_fails)
+    {
+        ///arrange
+        const char* inputString = ";;;";
+        STRING_VIEW input;
+        STRING_VIEW token;
+        input.str = inputString;
+        input.length = 3;
+
+        ///act
+        int r = STRING_VIEW_get_next_token(&input, &token, ";");
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, r);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(inputString + 3), (void*)input.str);
+        ASSERT_ARE_EQUAL(size_t, 0, input.length);
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_01_004: [ If no other character remains in input, STRING_VIEW_get_next_token shall set input to an empty view at its end and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_VIEW_get_next_token_with_an_empty_input_fails)
+    {
+        ///arrange
+        STRING_VIEW input;
+        STRING_VIEW token;
+        input.str = "";
+        input.length = 0;
+
+        ///act
+        int r = STRING_VIEW_get_next_token(&input, &token, ";");
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, r);
+        ASSERT_ARE_EQUAL(size_t, 0, input.length);
+    }
+
+    /* Tests_SRS_STRING_TOKENIZER_01_003: [ STRING_VIEW_get_next_token shall skip the characters at the beginning of input that are contained in delimiters. ]*/
+    TEST_FUNCTION(STRING_VIEW_get_next_token_handles_delimiters_above_127)
+    {
+        ///arrange
+        const char inputString[] = "\xff\x80" "ab" "\x80" "c";
+        STRING_VIEW input;
+        STRING_VIEW token;
+        input.str = inputString;
+        input.length = sizeof(inputString) - 1;
+
+        ///act
+        int r = STRING_VIEW_get_next_token(&input, &token, "\x80\xff");
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, r);
+        ASSERT_ARE_EQUAL(void_ptr, (void*)(inputString + 2), (void*)token.str);
+        ASSERT_ARE_EQUAL(size_t, 2, token.length);
+        ASSERT_ARE_EQUAL(size_t, 1, input.length);
+    }
+
 END_TEST_SUITE(string_tokenizer_unittests)
\ No newline at end of file
@@ -32,9 +32,28 @@ void my_gballoc_free(void* ptr)
 #define ENABLE_MOCKS
 
 #include "azure_c_shared_utility/gballoc.h"
+#include "azure_c_shared_utility/arena.h"
 
 #undef ENABLE_MOCKS
 
+static void* my_ARENA_malloc(ARENA_HANDLE arena, size_t size)
+{
+    (void)arena;
+    return my_gballoc_malloc(size);
+}
+
+static void* my_ARENA_realloc(ARENA_HANDLE arena, void* ptr, size_t size)
+{
+    (void)arena;
+    return my_gballoc_realloc(ptr, size);
+}
+
+static void my_ARENA_free(ARENA_HANDLE arena, void* ptr)
+{
+    (void)arena;
+    my_gballoc_free(ptr);
+}
+
 #include "azure_c_shared_utility/strings.h"
 
 static const char TEST_STRING_VALUE []= "DataValueTest";
@@ -52,6 +71,9 @@ static const char* EMPTY_STRING = "";
 
 #define NUMBER_OF_CHAR_TOCOPY           8
 #define TEST_INTEGER_VALUE              1234
+/*the longest string that is kept in the STRING allocation, MULTIPLE_TEST_STRING_VALUE is longer*/
+#define INLINE_STRING_LENGTH            23
+#define TEST_ARENA                      (ARENA_HANDLE)0x4242
 
 static TEST_MUTEX_HANDLE g_dllByDll;
 static TEST_MUTEX_HANDLE g_testByTest;
@@ -69,11 +91,13 @@ static const struct JSONEncoding {
         { "\x1F", "\"\\u001F\"" },
         { "\"", "\"\\\"\""},
         { "\\", "\"\\\\\"" },
-        { "\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F some text\"\\a/a", 
-          "\"\\u0001\\u0002\\u0003\\u0004\\u0005\\u0006\\u0007\\u0008\\u0009\\u000A\\u000B\\u000C\\u000D\\u000E\\u000F\\u0010\\u0011\\u0012\\u0013\\u0014\\u0015\\u0016\\u0017\\u0018\\u0019\\u001A\\u001B\\u001C\\u001D\\u001E\\u001F some text\\\"\\\\a\\/a\"" },
-
+        { "/", "\"\\/\"" },
     };
 
+/*escapes characters all along a string that does not fit in the STRING allocation, so that the memory grows while it is written*/
+static const char JSON_ESCAPES_SOURCE[] = "\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F\x10\x11\x12\x13\x14\x15\x16\x17\x18\x19\x1A\x1B\x1C\x1D\x1E\x1F some text\"\\a/a";
+static const char JSON_ESCAPES_EXPECTED[] = "\"\\u0001\\u0002\\u0003\\u0004\\u0005\\u0006\\u0007\\u0008\\u0009\\u000A\\u000B\\u000C\\u000D\\u000E\\u000F\\u0010\\u0011\\u0012\\u0013\\u0014\\u0015\\u0016\\u0017\\u0018\\u0019\\u001A\\u001B\\u001C\\u001D\\u001E\\u001F some text\\\"\\\\a\\/a\"";
+
 DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
 
 static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
@@ -103,6 +127,11 @@ BEGIN_TEST_SUITE(strings_unittests)
         REGISTER_GLOBAL_MOCK_FAIL_RETURN(gballoc_realloc, NULL);
 
         REGISTER_GLOBAL_MOCK_HOOK(gballoc_free, my_gballoc_free);
+
+        REGISTER_UMOCK_ALIAS_TYPE(ARENA_HANDLE, void*);
+        REGISTER_GLOBAL_MOCK_HOOK(ARENA_malloc, my_ARENA_malloc);
+        REGISTER_GLOBAL_MOCK_HOOK(ARENA_realloc, my_ARENA_realloc);
+        REGISTER_GLOBAL_MOCK_HOOK(ARENA_free, my_ARENA_free);
     }
 
     TEST_SUITE_CLEANUP(TestClassCleanup)
@@ -130,6 +159,7 @@ BEGIN_TEST_SUITE(strings_unittests)
 
     /* STRING_Tests BEGIN */
     /* Tests_SRS_STRING_07_001: [STRING_new shall allocate a new STRING_HANDLE pointing to an empty string.] */
+    /* Tests_SRS_STRING_01_010: [ A string of up to 23 characters shall be stored in the STRING allocation, so that creating it allocates memory only once. ]*/
     TEST_FUNCTION(STRING_new_Succeed)
     {
         ///arrange
@@ -137,7 +167,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(1));
 
         ///act
         g_hString = STRING_new();
@@ -160,7 +189,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(1));
 
         umock_c_negative_tests_snapshot();
 
@@ -222,7 +250,153 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_delete(g_hString);
     }
 
+    /* Tests_SRS_STRING_01_014: [ If `arena` is NULL, `STRING_new_in_arena` shall fail and return NULL. ]*/
+    TEST_FUNCTION(STRING_new_in_arena_with_NULL_arena_fails)
+    {
+        ///arrange
+
+        ///act
+        STRING_HANDLE result = STRING_new_in_arena(NULL);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_01_015: [ `STRING_new_in_arena` shall allocate a new empty string with `ARENA_malloc`, all the memory the string needs later shall also be allocated, grown and freed with `ARENA_malloc`, `ARENA_realloc` and `ARENA_free`. ]*/
+    TEST_FUNCTION(STRING_new_in_arena_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG));
+
+        ///act
+        STRING_HANDLE result = STRING_new_in_arena(TEST_ARENA);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, EMPTY_STRING, STRING_c_str(result));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(result);
+    }
+
+    /* Tests_SRS_STRING_01_016: [ If allocating the memory fails, `STRING_new_in_arena` shall fail and return NULL. ]*/
+    TEST_FUNCTION(when_ARENA_malloc_fails_STRING_new_in_arena_fails)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        STRING_HANDLE result = STRING_new_in_arena(TEST_ARENA);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_01_015: [ `STRING_new_in_arena` shall allocate a new empty string with `ARENA_malloc`, all the memory the string needs later shall also be allocated, grown and freed with `ARENA_malloc`, `ARENA_realloc` and `ARENA_free`. ]*/
+    TEST_FUNCTION(STRING_concat_on_a_string_in_an_arena_grows_it_in_the_arena)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_new_in_arena(TEST_ARENA);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG));
+
+        ///act
+        int result = STRING_concat(g_hString, MULTIPLE_TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, MULTIPLE_TEST_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_01_019: [ If `arena` or `psz` is NULL, `STRING_construct_in_arena` shall fail and return NULL. ]*/
+    TEST_FUNCTION(STRING_construct_in_arena_with_NULL_arena_fails)
+    {
+        ///arrange
+
+        ///act
+        STRING_HANDLE result = STRING_construct_in_arena(NULL, TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_01_019: [ If `arena` or `psz` is NULL, `STRING_construct_in_arena` shall fail and return NULL. ]*/
+    TEST_FUNCTION(STRING_construct_in_arena_with_NULL_psz_fails)
+    {
+        ///arrange
+
+        ///act
+        STRING_HANDLE result = STRING_construct_in_arena(TEST_ARENA, NULL);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_01_020: [ `STRING_construct_in_arena` shall create a string with the value of `psz` the way `STRING_new_in_arena` does. ]*/
+    TEST_FUNCTION(STRING_construct_in_arena_with_a_short_string_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG));
+
+        ///act
+        STRING_HANDLE result = STRING_construct_in_arena(TEST_ARENA, TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, TEST_STRING_VALUE, STRING_c_str(result));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(result);
+    }
+
+    /* Tests_SRS_STRING_01_020: [ `STRING_construct_in_arena` shall create a string with the value of `psz` the way `STRING_new_in_arena` does. ]*/
+    TEST_FUNCTION(STRING_construct_in_arena_with_a_long_string_succeeds)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG));
+        STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, sizeof(MULTIPLE_TEST_STRING_VALUE)));
+
+        ///act
+        STRING_HANDLE result = STRING_construct_in_arena(TEST_ARENA, MULTIPLE_TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, MULTIPLE_TEST_STRING_VALUE, STRING_c_str(result));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(result);
+    }
+
+    /* Tests_SRS_STRING_01_021: [ If allocating the memory fails, `STRING_construct_in_arena` shall fail and return NULL. ]*/
+    TEST_FUNCTION(when_allocating_the_characters_fails_STRING_construct_in_arena_fails)
+    {
+        ///arrange
+        STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, IGNORED_NUM_ARG));
+        STRICT_EXPECTED_CALL(ARENA_malloc(TEST_ARENA, sizeof(MULTIPLE_TEST_STRING_VALUE)))
+            .SetReturn(NULL);
+        STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, IGNORED_PTR_ARG));
+
+        ///act
+        STRING_HANDLE result = STRING_construct_in_arena(TEST_ARENA, MULTIPLE_TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_IS_NULL(result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
     /* Tests_SRS_STRING_07_003: [STRING_construct shall allocate a new string with the value of the specified const char*.] */
+    /* Tests_SRS_STRING_01_010: [ A string of up to 23 characters shall be stored in the STRING allocation, so that creating it allocates memory only once. ]*/
     TEST_FUNCTION(STRING_construct_Succeed)
     {
         ///arrange
@@ -230,7 +404,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_STRING_VALUE) + 1));
 
         ///act
         g_hString = STRING_construct(TEST_STRING_VALUE);
@@ -243,6 +416,28 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_delete(g_hString);
     }
 
+    /* Tests_SRS_STRING_07_003: [STRING_construct shall allocate a new string with the value of the specified const char*.] */
+    TEST_FUNCTION(STRING_construct_with_a_long_string_Succeed)
+    {
+        ///arrange
+        STRING_HANDLE g_hString;
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(MULTIPLE_TEST_STRING_VALUE) + 1));
+
+        ///act
+        g_hString = STRING_construct(MULTIPLE_TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, MULTIPLE_TEST_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(size_t, strlen(MULTIPLE_TEST_STRING_VALUE), STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
     /* Tests_SRS_STRING_07_003: [STRING_construct shall allocate a new string with the value of the specified const char*.] */
     TEST_FUNCTION(STRING_construct_Fail)
     {
@@ -254,7 +449,7 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_STRING_VALUE) + 1));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(MULTIPLE_TEST_STRING_VALUE) + 1));
 
         umock_c_negative_tests_snapshot();
 
@@ -265,7 +460,7 @@ BEGIN_TEST_SUITE(strings_unittests)
             umock_c_negative_tests_reset();
             umock_c_negative_tests_fail_call(index);
 
-            str_handle = STRING_construct(TEST_STRING_VALUE);
+            str_handle = STRING_construct(MULTIPLE_TEST_STRING_VALUE);
 
             char tmp_msg[64];
             sprintf(tmp_msg, "STRING_construct failure in test %zu/%zu", index+1, count);
@@ -300,7 +495,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(2 + strlen(TEST_STRING_VALUE) + 1));
 
         ///act
         g_hString = STRING_new_quoted(TEST_STRING_VALUE);
@@ -371,7 +565,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         ///arrange
         STRING_HANDLE str_handle;
 
-        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
         EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
 
         ///act
@@ -428,8 +621,7 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(INITIAL_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(INITIAL_STRING_VALUE) + strlen(TEST_STRING_VALUE) + 1))
-            .IgnoreArgument(1);
+        /*the result still fits in the STRING allocation, so no memory is allocated*/
 
         ///act
         int nResult = STRING_concat(g_hString, TEST_STRING_VALUE);
@@ -443,6 +635,29 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_delete(g_hString);
     }
 
+    /* Tests_SRS_STRING_07_012: [STRING_concat shall concatenate the given STRING_HANDLE and the const char* value and place the value in the handle.] */
+    TEST_FUNCTION(STRING_concat_moves_a_string_that_outgrows_the_STRING_to_the_heap)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        /*the string leaves the STRING allocation and grows by 32 characters*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(INLINE_STRING_LENGTH + 1 + 32));
+
+        ///act
+        int nResult = STRING_concat(g_hString, MULTIPLE_TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(int, 0, strncmp(INITIAL_STRING_VALUE, STRING_c_str(g_hString), strlen(INITIAL_STRING_VALUE)));
+        ASSERT_ARE_EQUAL(char_ptr, MULTIPLE_TEST_STRING_VALUE, STRING_c_str(g_hString) + strlen(INITIAL_STRING_VALUE));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
     /* Tests_SRS_STRING_07_013: [STRING_concat shall return a nonzero number if the STRING_HANDLE and const char* is NULL.] */
     TEST_FUNCTION(STRING_Concat_HANDLE_NULL_Fail)
     {
@@ -505,9 +720,8 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_copy(g_hString, TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(TEST_STRING_VALUE) + strlen(TEST_STRING_VALUE)+1))
-            .IgnoreArgument(1)
-            .IgnoreArgument(2);
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
 
         ///act
         STRING_concat(g_hString, TEST_STRING_VALUE);
@@ -529,8 +743,7 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_HANDLE hAppend = STRING_construct(TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(INITIAL_STRING_VALUE) + strlen(TEST_STRING_VALUE) + 1))
-            .IgnoreArgument(1);
+        /*the result still fits in the STRING allocation, so no memory is allocated*/
 
         ///act
         int nResult = STRING_concat_with_STRING(g_hString, hAppend);
@@ -603,9 +816,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(INITIAL_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, strlen(TEST_STRING_VALUE) + 1))
-            .IgnoreArgument(1);
-
         ///act
         int nResult = STRING_copy(g_hString, TEST_STRING_VALUE);
 
@@ -618,6 +828,50 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_delete(g_hString);
     }
 
+    /* Tests_SRS_STRING_07_016: [STRING_copy shall copy the const char* into the supplied STRING_HANDLE.] */
+    TEST_FUNCTION(STRING_copy_of_a_long_string_allocates_exactly_its_size)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(MULTIPLE_TEST_STRING_VALUE) + 1));
+
+        ///act
+        int nResult = STRING_copy(g_hString, MULTIPLE_TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, MULTIPLE_TEST_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_07_016: [STRING_copy shall copy the const char* into the supplied STRING_HANDLE.] */
+    TEST_FUNCTION(STRING_copy_of_a_short_string_frees_the_memory_of_a_long_one)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(MULTIPLE_TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        int nResult = STRING_copy(g_hString, TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, TEST_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(size_t, strlen(TEST_STRING_VALUE), STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
     /* Tests_SRS_STRING_07_017: [STRING_copy shall return a nonzero value if any of the supplied parameters are NULL.] */
     TEST_FUNCTION(STRING_Copy_NULL_Fail)
     {
@@ -645,9 +899,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(INITIAL_STRING_VALUE);
         umock_c_reset_all_calls();
         
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, NUMBER_OF_CHAR_TOCOPY + 1))
-            .IgnoreArgument(1);
-
         ///act
         int nResult = STRING_copy_n(g_hString, COMBINED_STRING_VALUE, NUMBER_OF_CHAR_TOCOPY);
 
@@ -700,9 +951,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(INITIAL_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1))
-            .IgnoreArgument(1);
-
         ///act
         int nResult = STRING_copy_n(g_hString, COMBINED_STRING_VALUE, 0);
 
@@ -723,9 +971,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 + strlen(TEST_STRING_VALUE) + 1))
-            .IgnoreArgument(1);
-
         ///act
         int nResult = STRING_quote(g_hString);
 
@@ -744,10 +989,10 @@ BEGIN_TEST_SUITE(strings_unittests)
         int negativeTestsInitResult = umock_c_negative_tests_init();
         ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
 
-        STRING_HANDLE str_handle = STRING_construct(TEST_STRING_VALUE);
+        STRING_HANDLE str_handle = STRING_construct(MULTIPLE_TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 + strlen(TEST_STRING_VALUE) + 1))
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 + strlen(MULTIPLE_TEST_STRING_VALUE) + 1))
             .IgnoreArgument(1);
 
         umock_c_negative_tests_snapshot();
@@ -807,7 +1052,6 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(TEST_STRING_VALUE) + 1));
 
         ///act
         g_hString = STRING_construct(TEST_STRING_VALUE);
@@ -829,9 +1073,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_construct(TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 1))
-            .IgnoreArgument(1);
-
         ///act
         int nResult = STRING_empty(g_hString);
 
@@ -844,6 +1085,29 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_delete(g_hString);
     }
 
+    /* Tests_SRS_STRING_07_022: [STRING_empty shall revert the STRING_HANDLE to an empty state.] */
+    TEST_FUNCTION(STRING_empty_frees_the_memory_of_a_long_string)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(MULTIPLE_TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        int nResult = STRING_empty(g_hString);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, nResult);
+        ASSERT_ARE_EQUAL(char_ptr, EMPTY_STRING, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(size_t, 0, STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
     /* Tests_SRS_STRING_07_023: [STRING_empty shall return a nonzero value if the STRING_HANDLE is NULL.] */
     TEST_FUNCTION(STRING_empty_NULL_HANDLE_Fail)
     {
@@ -877,6 +1141,23 @@ BEGIN_TEST_SUITE(strings_unittests)
         g_hString = STRING_new();
         umock_c_reset_all_calls();
 
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        STRING_delete(g_hString);
+        
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_07_010: [STRING_delete will free the memory allocated by the STRING_HANDLE.] */
+    TEST_FUNCTION(STRING_delete_of_a_long_string_frees_its_memory)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(MULTIPLE_TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
             .IgnoreArgument(1);
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
@@ -884,7 +1165,24 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         ///act
         STRING_delete(g_hString);
-        
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_01_017: [ If the string was created in an arena, `STRING_delete` shall give its memory back with `ARENA_free`. ]*/
+    TEST_FUNCTION(STRING_delete_of_a_string_in_an_arena_frees_to_the_arena)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct_in_arena(TEST_ARENA, MULTIPLE_TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, IGNORED_PTR_ARG));
+        STRICT_EXPECTED_CALL(ARENA_free(TEST_ARENA, g_hString));
+
+        ///act
+        STRING_delete(g_hString);
+
         ///assert
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
     }
@@ -932,44 +1230,64 @@ BEGIN_TEST_SUITE(strings_unittests)
         ASSERT_IS_NULL( result);
     }
 
-    /*Tests_SRS_STRING_02_001: [STRING_clone shall produce a new string having the same content as the handle string.]*/
-    TEST_FUNCTION(STRING_clone_succeeds)
+    /*Tests_SRS_STRING_01_018: [ The clone of a string created in an arena shall be allocated from the heap, it does not depend on the arena. ]*/
+    TEST_FUNCTION(STRING_clone_of_a_string_in_an_arena_allocates_from_the_heap)
     {
         ///arrange
-        STRING_HANDLE hSource = STRING_construct("aa");
+        STRING_HANDLE hSource = STRING_construct_in_arena(TEST_ARENA, TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
-            .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof("aa")));
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
 
         ///act
         STRING_HANDLE result = STRING_clone(hSource);
 
         ///assert
-        ASSERT_ARE_NOT_EQUAL(void_ptr, NULL, result);
-        ASSERT_ARE_NOT_EQUAL(void_ptr, STRING_c_str(hSource), STRING_c_str(result));
-        ASSERT_ARE_EQUAL    (char_ptr, STRING_c_str(hSource), STRING_c_str(result));
+        ASSERT_ARE_EQUAL(char_ptr, TEST_STRING_VALUE, STRING_c_str(result));
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
         ///cleanup
-        STRING_delete(hSource);
         STRING_delete(result);
+        STRING_delete(hSource);
     }
 
-    /*Tests_SRS_STRING_02_002: [If parameter handle is NULL then STRING_clone shall return NULL.]*/
-    TEST_FUNCTION(STRING_clone_fail)
+    /*Tests_SRS_STRING_02_001: [STRING_clone shall produce a new string having the same content as the handle string.]*/
+    TEST_FUNCTION(STRING_clone_succeeds)
     {
-        //arrange
+        ///arrange
+        STRING_HANDLE hSource = STRING_construct("aa");
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument(1);
+
+        ///act
+        STRING_HANDLE result = STRING_clone(hSource);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(void_ptr, NULL, result);
+        ASSERT_ARE_NOT_EQUAL(void_ptr, STRING_c_str(hSource), STRING_c_str(result));
+        ASSERT_ARE_EQUAL    (char_ptr, STRING_c_str(hSource), STRING_c_str(result));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(hSource);
+        STRING_delete(result);
+    }
+
+    /*Tests_SRS_STRING_02_002: [If parameter handle is NULL then STRING_clone shall return NULL.]*/
+    TEST_FUNCTION(STRING_clone_fail)
+    {
+        //arrange
         int negativeTestsInitResult = umock_c_negative_tests_init();
         ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
 
-        STRING_HANDLE str_handle = STRING_construct("aa");
+        STRING_HANDLE str_handle = STRING_construct(MULTIPLE_TEST_STRING_VALUE);
         umock_c_reset_all_calls();
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof("aa")));
+        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(MULTIPLE_TEST_STRING_VALUE)));
 
         umock_c_negative_tests_snapshot();
 
@@ -1026,8 +1344,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         ///arrange
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(3))
-            .IgnoreArgument(1);
 
         ///act
         STRING_HANDLE result = STRING_construct_n("qq", 2);
@@ -1047,8 +1363,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         ///arrange
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(4))
-            .IgnoreArgument(1);
 
         ///act
         STRING_HANDLE result = STRING_construct_n("12345", 3);
@@ -1070,8 +1384,7 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(3))
-            .IgnoreArgument(1);
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(MULTIPLE_TEST_STRING_VALUE) + 1));
 
         umock_c_negative_tests_snapshot();
 
@@ -1082,7 +1395,7 @@ BEGIN_TEST_SUITE(strings_unittests)
             umock_c_negative_tests_reset();
             umock_c_negative_tests_fail_call(index);
 
-            STRING_HANDLE result = STRING_construct_n("qq", 2);
+            STRING_HANDLE result = STRING_construct_n(MULTIPLE_TEST_STRING_VALUE, strlen(MULTIPLE_TEST_STRING_VALUE));
 
             char tmp_msg[64];
             sprintf(tmp_msg, "STRING_construct_n failure in test %zu/%zu", index+1, count);
@@ -1239,7 +1552,10 @@ BEGIN_TEST_SUITE(strings_unittests)
 
             STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
                 .IgnoreArgument(1);
-            STRICT_EXPECTED_CALL(gballoc_malloc(strlen(JSONtests[i].expectedJSON) + 1));
+            if (strlen(JSONtests[i].source) + 2 > INLINE_STRING_LENGTH)
+            {
+                STRICT_EXPECTED_CALL(gballoc_malloc(strlen(JSONtests[i].source) + 2 + 1));
+            }
 
             ///act
             STRING_HANDLE result = STRING_new_JSON(JSONtests[i].source);
@@ -1261,7 +1577,7 @@ BEGIN_TEST_SUITE(strings_unittests)
         ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
 
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG)).IgnoreArgument(1);
-        STRICT_EXPECTED_CALL(gballoc_malloc(strlen("ab") + 2+1));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(MULTIPLE_TEST_STRING_VALUE) + 2+1));
 
         umock_c_negative_tests_snapshot();
 
@@ -1272,7 +1588,7 @@ BEGIN_TEST_SUITE(strings_unittests)
             umock_c_negative_tests_reset();
             umock_c_negative_tests_fail_call(index);
 
-            STRING_HANDLE result = STRING_new_JSON("ab");
+            STRING_HANDLE result = STRING_new_JSON(MULTIPLE_TEST_STRING_VALUE);
 
             char tmp_msg[64];
             sprintf(tmp_msg, "STRING_new_JSON failure in test %zu/%zu", index+1, count);
@@ -1295,8 +1611,78 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         ///assert
         ASSERT_IS_NULL(result);
+
+        ///cleanup
+    }
+
+    /*Tests_SRS_STRING_02_019: [If the character code is less than 0x20 then it shall be represented as \\u00xx, where xx is the hex representation of the character code.]*/
+    TEST_FUNCTION(STRING_new_JSON_grows_the_string_as_it_escapes_characters)
+    {
+        ///arrange
+        /*the memory is sized for the characters as they are, and grows by half of it whenever the escapes need more*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+        STRICT_EXPECTED_CALL(gballoc_malloc(strlen(JSON_ESCAPES_SOURCE) + 2 + 1));
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 81));
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 121));
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 181));
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 271));
+
+        ///act
+        STRING_HANDLE result = STRING_new_JSON(JSON_ESCAPES_SOURCE);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, JSON_ESCAPES_EXPECTED, STRING_c_str(result));
+        ASSERT_ARE_EQUAL(size_t, strlen(JSON_ESCAPES_EXPECTED), STRING_length(result));
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
+        ///cleanup
+        STRING_delete(result);
+    }
+
+    /*Tests_SRS_STRING_02_013: [The string shall copy the characters of source "as they are" (until the '\0' character) with the following exceptions:] */
+    TEST_FUNCTION(STRING_new_JSON_escapes_a_character_at_any_position)
+    {
+        static const char specials[] = { '\x01', '\x1F', '"', '\\', '/', 'a' };
+        char source[41];
+        char expected[48];
+        size_t position;
+        size_t j;
+
+        for (j = 0; j < sizeof(specials); j++)
+        {
+            for (position = 0; position < sizeof(source) - 1; position++)
+            {
+                ///arrange
+                const char* escape = (specials[j] == '\x01') ? "\\u0001" : (specials[j] == '\x1F') ? "\\u001F" : (specials[j] == '"') ? "\\\"" :
+                    (specials[j] == '\\') ? "\\\\" : (specials[j] == '/') ? "\\/" : "a";
+                (void)memset(source, 'x', sizeof(source) - 1);
+                source[sizeof(source) - 1] = '\0';
+                source[position] = specials[j];
+                (void)sprintf(expected, "\"%.*s%s%s\"", (int)position, source, escape, source + position + 1);
+
+                ///act
+                STRING_HANDLE result = STRING_new_JSON(source);
+
+                ///assert
+                ASSERT_ARE_EQUAL(char_ptr, expected, STRING_c_str(result));
+
+                ///cleanup
+                STRING_delete(result);
+            }
+        }
+    }
+
+    /*Tests_SRS_STRING_02_014: [If any character has the value outside [1...127] then STRING_new_JSON shall fail and return NULL.] */
+    TEST_FUNCTION(STRING_new_JSON_when_a_character_after_a_long_run_is_not_ASCII_fails)
+    {
+        ///arrange
+
+        ///act
+        STRING_HANDLE result = STRING_new_JSON("0123456789abcdef0123456789abcdef\x80");
+
+        ///assert
+        ASSERT_IS_NULL(result);
+
         ///cleanup
     }
 
@@ -1323,8 +1709,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument_size();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(1 + 1));
-
         ///act
         STRING_HANDLE result = STRING_from_byte_array((const unsigned char*)"a", 1);
 
@@ -1345,8 +1729,6 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument_size();
 
-        STRICT_EXPECTED_CALL(gballoc_malloc(1 + 0));
-
         ///act
         STRING_HANDLE result = STRING_from_byte_array(NULL, 0);
 
@@ -1367,14 +1749,14 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
             .IgnoreArgument_size();
         
-        STRICT_EXPECTED_CALL(gballoc_malloc(1 + 1))
+        STRICT_EXPECTED_CALL(gballoc_malloc(sizeof(MULTIPLE_TEST_STRING_VALUE)))
             .SetReturn(NULL);
 
         STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
             .IgnoreArgument_ptr();
 
         ///act
-        STRING_HANDLE result = STRING_from_byte_array((const unsigned char*)"a", 1);
+        STRING_HANDLE result = STRING_from_byte_array((const unsigned char*)MULTIPLE_TEST_STRING_VALUE, strlen(MULTIPLE_TEST_STRING_VALUE));
 
         ///assert
         ASSERT_IS_NULL(result);
@@ -1444,7 +1826,7 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
 
         ///act
         int str_result = STRING_sprintf(str_handle, FORMAT_STRING, TEST_STRING_VALUE);
@@ -1491,7 +1873,7 @@ BEGIN_TEST_SUITE(strings_unittests)
 
         umock_c_reset_all_calls();
 
-        EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+        EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
 
         umock_c_negative_tests_snapshot();
 
@@ -1516,4 +1898,411 @@ BEGIN_TEST_SUITE(strings_unittests)
         STRING_delete(str_handle);
     }
 
+    /* STRING_concat_n */
+
+    /* Tests_SRS_STRING_01_001: [ If `handle` is NULL, or `s2` is NULL while `n` is not 0, `STRING_concat_n` shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_concat_n_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        int result = STRING_concat_n(NULL, TEST_STRING_VALUE, 1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_01_001: [ If `handle` is NULL, or `s2` is NULL while `n` is not 0, `STRING_concat_n` shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_concat_n_with_NULL_s2_fails)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = STRING_concat_n(g_hString, NULL, 1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_01_002: [ `STRING_concat_n` shall append the first `n` characters of `s2` to the string, without looking for a null terminator in `s2`. ]*/
+    /* Tests_SRS_STRING_01_005: [ On success `STRING_concat_n` shall return 0. ]*/
+    TEST_FUNCTION(STRING_concat_n_with_NULL_s2_and_0_n_succeeds)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = STRING_concat_n(g_hString, NULL, 0);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_01_002: [ `STRING_concat_n` shall append the first `n` characters of `s2` to the string, without looking for a null terminator in `s2`. ]*/
+    /* Tests_SRS_STRING_01_005: [ On success `STRING_concat_n` shall return 0. ]*/
+    TEST_FUNCTION(STRING_concat_n_appends_n_characters)
+    {
+        ///arrange
+        static const char not_terminated[] = { 'D', 'a', 't', 'a', 'X' };
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = STRING_concat_n(g_hString, not_terminated, 4);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, "Initial_Data", STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(size_t, strlen("Initial_Data"), STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_01_003: [ When the string has to grow, its memory shall grow by at least half of its size and at least 32 characters, so that building a string in `n` appends is linear in its length. ]*/
+    TEST_FUNCTION(STRING_concat_n_grows_a_small_string_by_32_characters)
+    {
+        ///arrange
+        size_t i;
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        /*only the append that leaves the STRING allocation allocates, the following ones use the extra memory*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(INLINE_STRING_LENGTH + 1 + 32));
+
+        ///act
+        for (i = strlen(INITIAL_STRING_VALUE); i < INLINE_STRING_LENGTH + 32; i++)
+        {
+            ASSERT_ARE_EQUAL(int, 0, STRING_concat_n(g_hString, "a", 1));
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, INLINE_STRING_LENGTH + 32, STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_01_003: [ When the string has to grow, its memory shall grow by at least half of its size and at least 32 characters, so that building a string in `n` appends is linear in its length. ]*/
+    TEST_FUNCTION(STRING_concat_n_grows_the_memory_by_half_of_its_size)
+    {
+        ///arrange
+        size_t i;
+        STRING_HANDLE g_hString = STRING_new();
+        (void)STRING_reserve(g_hString, 199);
+        for (i = 0; i < 199; i++)
+        {
+            (void)STRING_concat_n(g_hString, "a", 1);
+        }
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 300))
+            .IgnoreArgument(1);
+
+        ///act
+        for (i = 0; i < 100; i++)
+        {
+            ASSERT_ARE_EQUAL(int, 0, STRING_concat_n(g_hString, "a", 1));
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 299, STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_01_004: [ If any error occurs, `STRING_concat_n` shall fail, leave the string unchanged and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_concat_n_when_allocating_fails_leaves_the_string_unchanged)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        int result = STRING_concat_n(g_hString, MULTIPLE_TEST_STRING_VALUE, strlen(MULTIPLE_TEST_STRING_VALUE));
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(size_t, strlen(INITIAL_STRING_VALUE), STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_07_034: [String_Concat_with_STRING shall concatenate a given STRING_HANDLE variable with a source STRING_HANDLE.] */
+    TEST_FUNCTION(STRING_concat_with_STRING_with_the_same_handle_doubles_the_string)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        /*the string is moved out of the STRING allocation before it is read*/
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG));
+
+        ///act
+        int result = STRING_concat_with_STRING(g_hString, g_hString);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, MULTIPLE_TEST_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* STRING_concat_JSON */
+
+    /* Tests_SRS_STRING_01_011: [ If `handle` or `source` is NULL, `STRING_concat_JSON` shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_concat_JSON_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        int result = STRING_concat_JSON(NULL, TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_01_011: [ If `handle` or `source` is NULL, `STRING_concat_JSON` shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_concat_JSON_with_NULL_source_fails)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = STRING_concat_JSON(g_hString, NULL);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_01_012: [ `STRING_concat_JSON` shall append to the string the JSON representation of `source`, as produced by `STRING_new_JSON`, and return 0. ]*/
+    TEST_FUNCTION(STRING_concat_JSON_appends_the_JSON_representation)
+    {
+        size_t i;
+        for (i = 0; i < sizeof(JSONtests) / sizeof(JSONtests[0]); i++)
+        {
+            ///arrange
+            char expected[64];
+            STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+            (void)sprintf(expected, "%s%s", INITIAL_STRING_VALUE, JSONtests[i].expectedJSON);
+
+            ///act
+            int result = STRING_concat_JSON(g_hString, JSONtests[i].source);
+
+            ///assert
+            ASSERT_ARE_EQUAL(int, 0, result);
+            ASSERT_ARE_EQUAL(char_ptr, expected, STRING_c_str(g_hString));
+            ASSERT_ARE_EQUAL(size_t, strlen(expected), STRING_length(g_hString));
+
+            ///cleanup
+            STRING_delete(g_hString);
+        }
+    }
+
+    /* Tests_SRS_STRING_01_012: [ `STRING_concat_JSON` shall append to the string the JSON representation of `source`, as produced by `STRING_new_JSON`, and return 0. ]*/
+    TEST_FUNCTION(STRING_concat_JSON_into_reserved_memory_does_not_allocate)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_new();
+        ASSERT_ARE_EQUAL(int, 0, STRING_reserve(g_hString, 100));
+        umock_c_reset_all_calls();
+
+        ///act
+        int result1 = STRING_concat_JSON(g_hString, MULTIPLE_TEST_STRING_VALUE);
+        int result2 = STRING_concat_n(g_hString, ":", 1);
+        int result3 = STRING_concat_JSON(g_hString, "a\"b");
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result1);
+        ASSERT_ARE_EQUAL(int, 0, result2);
+        ASSERT_ARE_EQUAL(int, 0, result3);
+        ASSERT_ARE_EQUAL(char_ptr, "\"DataValueTestDataValueTest\":\"a\\\"b\"", STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_01_013: [ If `source` has a character outside [1...127] or allocating memory fails, `STRING_concat_JSON` shall fail, leave the string unchanged and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_concat_JSON_with_a_character_not_ASCII_leaves_the_string_unchanged)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = STRING_concat_JSON(g_hString, "a\\b\xFF");
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(size_t, strlen(INITIAL_STRING_VALUE), STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_01_013: [ If `source` has a character outside [1...127] or allocating memory fails, `STRING_concat_JSON` shall fail, leave the string unchanged and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_concat_JSON_when_allocating_fails_leaves_the_string_unchanged)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        int result = STRING_concat_JSON(g_hString, MULTIPLE_TEST_STRING_VALUE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_01_013: [ If `source` has a character outside [1...127] or allocating memory fails, `STRING_concat_JSON` shall fail, leave the string unchanged and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_concat_JSON_when_growing_for_an_escape_fails_leaves_the_string_unchanged)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(MULTIPLE_TEST_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG))
+            .SetReturn(NULL);
+
+        ///act
+        int result = STRING_concat_JSON(g_hString, JSON_ESCAPES_SOURCE);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, MULTIPLE_TEST_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(size_t, strlen(MULTIPLE_TEST_STRING_VALUE), STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* STRING_reserve */
+
+    /* Tests_SRS_STRING_01_006: [ If `handle` is NULL, `STRING_reserve` shall fail and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_reserve_with_NULL_handle_fails)
+    {
+        ///arrange
+
+        ///act
+        int result = STRING_reserve(NULL, 10);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_STRING_01_007: [ If the string can already hold `capacity` characters, `STRING_reserve` shall not allocate memory and shall return 0. ]*/
+    TEST_FUNCTION(STRING_reserve_with_capacity_already_there_does_not_allocate)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = STRING_reserve(g_hString, strlen(INITIAL_STRING_VALUE));
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_01_008: [ Otherwise `STRING_reserve` shall reallocate the string so that it can hold `capacity` characters plus the null terminator, keeping its content, and return 0. ]*/
+    TEST_FUNCTION(STRING_reserve_allocates_the_memory_and_the_following_appends_do_not)
+    {
+        ///arrange
+        size_t i;
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(101));
+
+        ///act
+        int result = STRING_reserve(g_hString, 100);
+        for (i = strlen(INITIAL_STRING_VALUE); i < 100; i++)
+        {
+            ASSERT_ARE_EQUAL(int, 0, STRING_concat(g_hString, "a"));
+        }
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 100, STRING_length(g_hString));
+        ASSERT_ARE_EQUAL(int, 0, strncmp(INITIAL_STRING_VALUE, STRING_c_str(g_hString), strlen(INITIAL_STRING_VALUE)));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
+    /* Tests_SRS_STRING_01_009: [ If allocating the memory fails, `STRING_reserve` shall fail, leave the string unchanged and return a non-zero value. ]*/
+    TEST_FUNCTION(STRING_reserve_when_realloc_fails_fails)
+    {
+        ///arrange
+        STRING_HANDLE g_hString = STRING_construct(INITIAL_STRING_VALUE);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(101))
+            .SetReturn(NULL);
+
+        ///act
+        int result = STRING_reserve(g_hString, 100);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, INITIAL_STRING_VALUE, STRING_c_str(g_hString));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        STRING_delete(g_hString);
+    }
+
 END_TEST_SUITE(strings_unittests)
\ No newline at end of file
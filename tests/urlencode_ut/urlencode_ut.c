@@ -579,4 +579,303 @@ TEST_FUNCTION(URL_Exhaustive_chars)
     }
 }
 
+/*Tests_SRS_URL_ENCODE_01_002: [If textEncode is NULL while textLength is not 0, or encodedLength is NULL, URL_Encode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(URL_Encode_Into_with_NULL_text_fails)
+{
+    // arrange
+    char destination[16];
+    size_t encodedLength;
+
+    // act
+    int result = URL_Encode_Into(NULL, 1, destination, sizeof(destination), &encodedLength);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/*Tests_SRS_URL_ENCODE_01_002: [If textEncode is NULL while textLength is not 0, or encodedLength is NULL, URL_Encode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(URL_Encode_Into_with_NULL_encodedLength_fails)
+{
+    // arrange
+    char destination[16];
+
+    // act
+    int result = URL_Encode_Into("a b", 3, destination, sizeof(destination), NULL);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/*Tests_SRS_URL_ENCODE_01_003: [URL_Encode_Into shall encode textLength characters of textEncode in a single pass, the same way URL_Encode does.]*/
+/*Tests_SRS_URL_ENCODE_01_006: [On success URL_Encode_Into shall null terminate destination and return 0.]*/
+TEST_FUNCTION(URL_Encode_Into_Exhaustive_chars)
+{
+    size_t i;
+    size_t numberOfTests = sizeof(testVector) / sizeof(testVector[i]);
+    for (i = 0; i < numberOfTests; i++)
+    {
+        // arrange
+        char destination[7];
+        size_t encodedLength;
+
+        // act
+        int result = URL_Encode_Into(testVector[i].inputData, 1, destination, sizeof(destination), &encodedLength);
+
+        // assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, strlen(testVector[i].expectedOutput), encodedLength);
+        ASSERT_ARE_EQUAL(char_ptr, testVector[i].expectedOutput, destination);
+    }
+}
+
+/*Tests_SRS_URL_ENCODE_01_003: [URL_Encode_Into shall encode textLength characters of textEncode in a single pass, the same way URL_Encode does.]*/
+TEST_FUNCTION(URL_Encode_Into_encodes_only_textLength_characters)
+{
+    // arrange
+    char destination[64];
+    size_t encodedLength;
+
+    // act
+    int result = URL_Encode_Into("/getalarm('Le Pichet')/ignored", 22, destination, sizeof(destination), &encodedLength);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 30, encodedLength);
+    ASSERT_ARE_EQUAL(char_ptr, "%2fgetalarm(%27Le%20Pichet%27)", destination);
+}
+
+/*Tests_SRS_URL_ENCODE_01_004: [URL_Encode_Into shall set *encodedLength to the length of the encoding, not including the null terminator, even when destination is NULL or too small.]*/
+/*Tests_SRS_URL_ENCODE_01_005: [If destination is NULL or destinationSize is not larger than the length of the encoding, URL_Encode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(URL_Encode_Into_with_NULL_destination_returns_the_length)
+{
+    // arrange
+    size_t encodedLength = 0;
+
+    // act
+    int result = URL_Encode_Into("hello world\xe9", 12, NULL, 0, &encodedLength);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 19, encodedLength);
+}
+
+/*Tests_SRS_URL_ENCODE_01_004: [URL_Encode_Into shall set *encodedLength to the length of the encoding, not including the null terminator, even when destination is NULL or too small.]*/
+/*Tests_SRS_URL_ENCODE_01_005: [If destination is NULL or destinationSize is not larger than the length of the encoding, URL_Encode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(URL_Encode_Into_with_no_room_for_the_null_terminator_fails)
+{
+    // arrange
+    char destination[13];
+    size_t encodedLength = 0;
+
+    // act
+    int result = URL_Encode_Into("hello world", 11, destination, sizeof(destination), &encodedLength);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 13, encodedLength);
+}
+
+/*Tests_SRS_URL_ENCODE_01_006: [On success URL_Encode_Into shall null terminate destination and return 0.]*/
+TEST_FUNCTION(URL_Encode_Into_empty_text_succeeds)
+{
+    // arrange
+    char destination[1] = { 'x' };
+    size_t encodedLength = 1;
+
+    // act
+    int result = URL_Encode_Into("", 0, destination, sizeof(destination), &encodedLength);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 0, encodedLength);
+    ASSERT_ARE_EQUAL(char_ptr, "", destination);
+}
+
+/*Tests_SRS_URL_ENCODE_01_007: [If textDecode is NULL while textLength is not 0, or destination or decodedLength is NULL, URL_Decode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(URL_Decode_Into_with_NULL_destination_fails)
+{
+    // arrange
+    size_t decodedLength;
+
+    // act
+    int result = URL_Decode_Into("a%20b", 5, NULL, 6, &decodedLength);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/*Tests_SRS_URL_ENCODE_01_008: [Characters other than '%' shall be copied as they are.]*/
+/*Tests_SRS_URL_ENCODE_01_010: [Each "%xx" shall be decoded to the byte whose value the 2 hexadecimal digits, in either case, give.]*/
+/*Tests_SRS_URL_ENCODE_01_013: [On success URL_Decode_Into shall null terminate destination, set *decodedLength to the number of decoded characters and return 0.]*/
+TEST_FUNCTION(URL_Decode_Into_decodes_escapes_in_either_case)
+{
+    // arrange
+    char destination[32];
+    size_t decodedLength;
+
+    // act
+    int result = URL_Decode_Into("%2Fgetalarm(%27Le+Pichet%27)", 28, destination, sizeof(destination), &decodedLength);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 22, decodedLength);
+    ASSERT_ARE_EQUAL(char_ptr, "/getalarm('Le+Pichet')", destination);
+}
+
+/*Tests_SRS_URL_ENCODE_01_011: [A "%c2%xx" or "%c3%xx" where xx is in the range 80 to bf shall be decoded to the single byte URL_Encode encoded to it.]*/
+TEST_FUNCTION(URL_Decode_Into_Exhaustive_chars)
+{
+    size_t i;
+    size_t numberOfTests = sizeof(testVector) / sizeof(testVector[i]);
+    for (i = 0; i < numberOfTests; i++)
+    {
+        // arrange
+        char destination[2];
+        size_t decodedLength;
+
+        // act
+        int result = URL_Decode_Into(testVector[i].expectedOutput, strlen(testVector[i].expectedOutput), destination, sizeof(destination), &decodedLength);
+
+        // assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 1, decodedLength);
+        ASSERT_ARE_EQUAL(char_ptr, testVector[i].inputData, destination);
+    }
+}
+
+/*Tests_SRS_URL_ENCODE_01_010: [Each "%xx" shall be decoded to the byte whose value the 2 hexadecimal digits, in either case, give.]*/
+TEST_FUNCTION(URL_Decode_Into_keeps_other_utf8_sequences)
+{
+    // arrange
+    char destination[8];
+    size_t decodedLength;
+
+    // act
+    int result = URL_Decode_Into("%e2%82%ac%c3A", 13, destination, sizeof(destination), &decodedLength);
+
+    // assert
+    ASSERT_ARE_EQUAL(int, 0, result);
+    ASSERT_ARE_EQUAL(size_t, 5, decodedLength);
+    ASSERT_ARE_EQUAL(char_ptr, "\xe2\x82\xac\xc3" "A", destination);
+}
+
+/*Tests_SRS_URL_ENCODE_01_009: [If a '%' is not followed by 2 hexadecimal digits, URL_Decode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(URL_Decode_Into_with_truncated_escape_fails)
+{
+    // arrange
+    char destination[8];
+    size_t decodedLength;
+
+    // act
+    int result = URL_Decode_Into("ab%2", 4, destination, sizeof(destination), &decodedLength);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/*Tests_SRS_URL_ENCODE_01_009: [If a '%' is not followed by 2 hexadecimal digits, URL_Decode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(URL_Decode_Into_with_invalid_hex_digit_fails)
+{
+    // arrange
+    char destination[8];
+    size_t decodedLength;
+
+    // act
+    int result = URL_Decode_Into("%g0", 3, destination, sizeof(destination), &decodedLength);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/*Tests_SRS_URL_ENCODE_01_012: [If destination cannot hold the decoded characters and a null terminator, URL_Decode_Into shall fail and return a non-zero value.]*/
+TEST_FUNCTION(URL_Decode_Into_with_small_destination_fails)
+{
+    // arrange
+    char destination[3];
+    size_t decodedLength;
+
+    // act
+    int result = URL_Decode_Into("a%20b", 5, destination, sizeof(destination), &decodedLength);
+
+    // assert
+    ASSERT_ARE_NOT_EQUAL(int, 0, result);
+}
+
+/*Tests_SRS_URL_ENCODE_01_014: [If textDecode is NULL then URL_DecodeString shall return NULL.]*/
+TEST_FUNCTION(URL_DecodeString_is_null_should_yield_NULL)
+{
+    // arrange
+    // act
+    STRING_HANDLE decodedURL = URL_DecodeString(NULL);
+
+    // assert
+    ASSERT_IS_NULL(decodedURL);
+}
+
+/*Tests_SRS_URL_ENCODE_01_017: [Otherwise URL_DecodeString shall return a STRING holding the decoding of textDecode.]*/
+TEST_FUNCTION(URL_DecodeString_full_url)
+{
+    // arrange
+    const char* encodedFullUrl = "https%3a%2f%2fone.two.three.four-five.com%2fsix%2fSeven(%27EightNine1234567890.Ten_Eleven%27)%3ftwelve-thirteen%3d2015-11-31%20HTTP%2f1.1";
+
+    // act
+    STRING_HANDLE decodedFullUrl = URL_DecodeString(encodedFullUrl);
+
+    // assert
+    ASSERT_IS_NOT_NULL(decodedFullUrl);
+    ASSERT_ARE_EQUAL(char_ptr, "https://one.two.three.four-five.com/six/Seven('EightNine1234567890.Ten_Eleven')?twelve-thirteen=2015-11-31 HTTP/1.1", STRING_c_str(decodedFullUrl));
+    STRING_delete(decodedFullUrl);
+}
+
+/*Tests_SRS_URL_ENCODE_01_015: [If an error occurs during the decoding URL_DecodeString shall return NULL.]*/
+TEST_FUNCTION(URL_DecodeString_invalid_escape_should_yield_NULL)
+{
+    // arrange
+    // act
+    STRING_HANDLE decodedURL = URL_DecodeString("100%");
+
+    // assert
+    ASSERT_IS_NULL(decodedURL);
+}
+
+/*Tests_SRS_URL_ENCODE_01_016: [If the decoding contains a null character URL_DecodeString shall return NULL.]*/
+TEST_FUNCTION(URL_DecodeString_null_character_should_yield_NULL)
+{
+    // arrange
+    // act
+    STRING_HANDLE decodedURL = URL_DecodeString("a%00b");
+
+    // assert
+    ASSERT_IS_NULL(decodedURL);
+}
+
+/*Tests_SRS_URL_ENCODE_01_018: [If input is NULL then URL_Decode shall return NULL.]*/
+TEST_FUNCTION(URL_Decode_is_null_should_yield_NULL)
+{
+    // arrange
+    // act
+    STRING_HANDLE decodedURL = URL_Decode(NULL);
+
+    // assert
+    ASSERT_IS_NULL(decodedURL);
+}
+
+/*Tests_SRS_URL_ENCODE_01_019: [Otherwise URL_Decode shall behave as URL_DecodeString on the characters of input.]*/
+TEST_FUNCTION(URL_Decode_reverses_URL_Encode)
+{
+    // arrange
+    STRING_HANDLE original = STRING_construct("/getalarm('Le Pichet') \xe9\xff\x80");
+    STRING_HANDLE encoded = URL_Encode(original);
+
+    // act
+    STRING_HANDLE decoded = URL_Decode(encoded);
+
+    // assert
+    ASSERT_IS_NOT_NULL(decoded);
+    ASSERT_ARE_EQUAL(char_ptr, STRING_c_str(original), STRING_c_str(decoded));
+    STRING_delete(original);
+    STRING_delete(encoded);
+    STRING_delete(decoded);
+}
+
 END_TEST_SUITE(URLEncode_UnitTests)
@@ -19,6 +19,8 @@
 #include <stdbool.h>
 #endif
 
+#include <string.h>
+
 #include "testrunnerswitcher.h"
 #include "azure_c_shared_utility/utf8_checker.h"
 
@@ -562,4 +564,300 @@ TEST_FUNCTION(utf8_checker_with_4th_char_bad_fails)
     ASSERT_IS_FALSE(result);
 }
 
+/* Tests_SRS_UTF8_CHECKER_01_001: [ `utf8_checker_is_valid_utf8` shall verify that the sequence of chars pointed to by `utf8_str` represent UTF-8 encoded codepoints. ]*/
+TEST_FUNCTION(utf8_checker_with_long_valid_string_succeeds)
+{
+    // arrange
+    bool result;
+    unsigned char test_str[100];
+    size_t i;
+
+    (void)memset(test_str, 'a', sizeof(test_str));
+    for (i = 5; i + 4 < sizeof(test_str); i += 13)
+    {
+        test_str[i] = 0xC2;
+        test_str[i + 1] = 0x80;
+        test_str[i + 4] = 0xEF;
+        test_str[i + 5] = 0xBF;
+        test_str[i + 6] = 0xBF;
+    }
+
+    // act
+    result = utf8_checker_is_valid_utf8(test_str, sizeof(test_str));
+
+    // assert
+    ASSERT_IS_TRUE(result);
+}
+
+/* Tests_SRS_UTF8_CHECKER_01_001: [ `utf8_checker_is_valid_utf8` shall verify that the sequence of chars pointed to by `utf8_str` represent UTF-8 encoded codepoints. ]*/
+TEST_FUNCTION(utf8_checker_with_bad_char_after_long_ascii_run_fails)
+{
+    // arrange
+    bool result;
+    unsigned char test_str[100];
+
+    (void)memset(test_str, 'a', sizeof(test_str));
+    test_str[70] = 0x80;
+
+    // act
+    result = utf8_checker_is_valid_utf8(test_str, sizeof(test_str));
+
+    // assert
+    ASSERT_IS_FALSE(result);
+}
+
+/* Tests_SRS_UTF8_CHECKER_01_001: [ `utf8_checker_is_valid_utf8` shall verify that the sequence of chars pointed to by `utf8_str` represent UTF-8 encoded codepoints. ]*/
+/* Tests_SRS_UTF8_CHECKER_01_008: [ zzzzyyyy yyxxxxxx 1110zzzz 10yyyyyy 10xxxxxx ]*/
+TEST_FUNCTION(utf8_checker_with_long_string_ending_in_the_middle_of_a_sequence_fails)
+{
+    // arrange
+    bool result;
+    unsigned char test_str[64];
+
+    (void)memset(test_str, 'a', sizeof(test_str));
+    test_str[62] = 0xEF;
+    test_str[63] = 0xBF;
+
+    // act
+    result = utf8_checker_is_valid_utf8(test_str, sizeof(test_str));
+
+    // assert
+    ASSERT_IS_FALSE(result);
+}
+
+/* Tests_SRS_UTF8_CHECKER_01_001: [ `utf8_checker_is_valid_utf8` shall verify that the sequence of chars pointed to by `utf8_str` represent UTF-8 encoded codepoints. ]*/
+/* Tests_SRS_UTF8_CHECKER_01_007: [ 00000yyy yyxxxxxx 110yyyyy 10xxxxxx ]*/
+TEST_FUNCTION(utf8_checker_with_overlong_2_bytes_sequence_in_long_string_fails)
+{
+    // arrange
+    bool result;
+    unsigned char test_str[64];
+
+    (void)memset(test_str, 'a', sizeof(test_str));
+    test_str[40] = 0xC1;
+    test_str[41] = 0xBF;
+
+    // act
+    result = utf8_checker_is_valid_utf8(test_str, sizeof(test_str));
+
+    // assert
+    ASSERT_IS_FALSE(result);
+}
+
+/* utf8_checker_init */
+
+/* Tests_SRS_UTF8_CHECKER_01_010: [ If `state` is NULL, `utf8_checker_init` shall do nothing. ]*/
+TEST_FUNCTION(utf8_checker_init_with_NULL_state_does_nothing)
+{
+    // arrange
+
+    // act
+    utf8_checker_init(NULL);
+
+    // assert
+    // no explicit assert, no crash
+}
+
+/* Tests_SRS_UTF8_CHECKER_01_011: [ `utf8_checker_init` shall set `state` to the start of a string. ]*/
+/* Tests_SRS_UTF8_CHECKER_01_016: [ `utf8_checker_final` shall return true if all the bytes given since `utf8_checker_init` are valid UTF-8 and do not end in the middle of a sequence, and false otherwise. ]*/
+TEST_FUNCTION(utf8_checker_final_right_after_init_succeeds)
+{
+    // arrange
+    UTF8_CHECKER_STATE state;
+    bool result;
+
+    utf8_checker_init(&state);
+
+    // act
+    result = utf8_checker_final(&state);
+
+    // assert
+    ASSERT_IS_TRUE(result);
+}
+
+/* Tests_SRS_UTF8_CHECKER_01_011: [ `utf8_checker_init` shall set `state` to the start of a string. ]*/
+TEST_FUNCTION(utf8_checker_init_resets_a_failed_check)
+{
+    // arrange
+    UTF8_CHECKER_STATE state;
+    unsigned char bad_str[] = { 0xFF };
+    unsigned char good_str[] = { 'a', 0xC2, 0x80 };
+    bool result;
+
+    utf8_checker_init(&state);
+    (void)utf8_checker_update(&state, bad_str, sizeof(bad_str));
+
+    // act
+    utf8_checker_init(&state);
+    result = utf8_checker_update(&state, good_str, sizeof(good_str));
+
+    // assert
+    ASSERT_IS_TRUE(result);
+    ASSERT_IS_TRUE(utf8_checker_final(&state));
+}
+
+/* utf8_checker_update */
+
+/* Tests_SRS_UTF8_CHECKER_01_012: [ If `state` is NULL, or `utf8_str` is NULL while `length` is not 0, `utf8_checker_update` shall return false. ]*/
+TEST_FUNCTION(utf8_checker_update_with_NULL_state_fails)
+{
+    // arrange
+    bool result;
+
+    // act
+    result = utf8_checker_update(NULL, (const unsigned char*)"a", 1);
+
+    // assert
+    ASSERT_IS_FALSE(result);
+}
+
+/* Tests_SRS_UTF8_CHECKER_01_012: [ If `state` is NULL, or `utf8_str` is NULL while `length` is not 0, `utf8_checker_update` shall return false. ]*/
+TEST_FUNCTION(utf8_checker_update_with_NULL_string_fails)
+{
+    // arrange
+    UTF8_CHECKER_STATE state;
+    bool result;
+
+    utf8_checker_init(&state);
+
+    // act
+    result = utf8_checker_update(&state, NULL, 1);
+
+    // assert
+    ASSERT_IS_FALSE(result);
+}
+
+/* Tests_SRS_UTF8_CHECKER_01_014: [ `utf8_checker_update` shall return false once any of the bytes given since `utf8_checker_init` are not valid UTF-8, and true otherwise. ]*/
+TEST_FUNCTION(utf8_checker_update_with_NULL_string_and_0_length_succeeds)
+{
+    // arrange
+    UTF8_CHECKER_STATE state;
+    bool result;
+
+    utf8_checker_init(&state);
+
+    // act
+    result = utf8_checker_update(&state, NULL, 0);
+
+    // assert
+    ASSERT_IS_TRUE(result);
+}
+
+/* Tests_SRS_UTF8_CHECKER_01_013: [ `utf8_checker_update` shall check the `length` bytes of `utf8_str` as the continuation of the bytes given to the previous calls, so that a sequence may be split between calls. ]*/
+/* Tests_SRS_UTF8_CHECKER_01_014: [ `utf8_checker_update` shall return false once any of the bytes given since `utf8_checker_init` are not valid UTF-8, and true otherwise. ]*/
+/* Tests_SRS_UTF8_CHECKER_01_016: [ `utf8_checker_final` shall return true if all the bytes given since `utf8_checker_init` are valid UTF-8 and do not end in the middle of a sequence, and false otherwise. ]*/
+TEST_FUNCTION(utf8_checker_update_with_sequences_split_between_calls_succeeds)
+{
+    // arrange
+    UTF8_CHECKER_STATE state;
+    unsigned char test_str[] = { 'a', 0xEF, 0xBF, 0xBF, 0xF0, 0x9F, 0x98, 0x80, 0xC2, 0x80 };
+    size_t i;
+
+    utf8_checker_init(&state);
+
+    // act
+    for (i = 0; i < sizeof(test_str); i++)
+    {
+        ASSERT_IS_TRUE(utf8_checker_update(&state, test_str + i, 1));
+    }
+
+    // assert
+    ASSERT_IS_TRUE(utf8_checker_final(&state));
+}
+
+/* Tests_SRS_UTF8_CHECKER_01_013: [ `utf8_checker_update` shall check the `length` bytes of `utf8_str` as the continuation of the bytes given to the previous calls, so that a sequence may be split between calls. ]*/
+TEST_FUNCTION(utf8_checker_update_with_long_pieces_split_in_a_sequence_succeeds)
+{
+    // arrange
+    UTF8_CHECKER_STATE state;
+    unsigned char test_str[80];
+
+    (void)memset(test_str, 'a', sizeof(test_str));
+    test_str[38] = 0xF0;
+    test_str[39] = 0x9F;
+    test_str[40] = 0x98;
+    test_str[41] = 0x80;
+
+    utf8_checker_init(&state);
+
+    // act
+    ASSERT_IS_TRUE(utf8_checker_update(&state, test_str, 40));
+    ASSERT_IS_TRUE(utf8_checker_update(&state, test_str + 40, sizeof(test_str) - 40));
+
+    // assert
+    ASSERT_IS_TRUE(utf8_checker_final(&state));
+}
+
+/* Tests_SRS_UTF8_CHECKER_01_013: [ `utf8_checker_update` shall check the `length` bytes of `utf8_str` as the continuation of the bytes given to the previous calls, so that a sequence may be split between calls. ]*/
+TEST_FUNCTION(utf8_checker_update_with_missing_continuation_in_next_call_fails)
+{
+    // arrange
+    UTF8_CHECKER_STATE state;
+    unsigned char first_str[] = { 'a', 0xC2 };
+    unsigned char second_str[] = { 'a' };
+    bool result;
+
+    utf8_checker_init(&state);
+    (void)utf8_checker_update(&state, first_str, sizeof(first_str));
+
+    // act
+    result = utf8_checker_update(&state, second_str, sizeof(second_str));
+
+    // assert
+    ASSERT_IS_FALSE(result);
+}
+
+/* Tests_SRS_UTF8_CHECKER_01_014: [ `utf8_checker_update` shall return false once any of the bytes given since `utf8_checker_init` are not valid UTF-8, and true otherwise. ]*/
+TEST_FUNCTION(utf8_checker_update_after_a_bad_char_keeps_failing)
+{
+    // arrange
+    UTF8_CHECKER_STATE state;
+    unsigned char bad_str[] = { 'a', 0x80 };
+    unsigned char good_str[] = { 'a' };
+    bool result;
+
+    utf8_checker_init(&state);
+    (void)utf8_checker_update(&state, bad_str, sizeof(bad_str));
+
+    // act
+    result = utf8_checker_update(&state, good_str, sizeof(good_str));
+
+    // assert
+    ASSERT_IS_FALSE(result);
+    ASSERT_IS_FALSE(utf8_checker_final(&state));
+}
+
+/* utf8_checker_final */
+
+/* Tests_SRS_UTF8_CHECKER_01_015: [ If `state` is NULL, `utf8_checker_final` shall return false. ]*/
+TEST_FUNCTION(utf8_checker_final_with_NULL_state_fails)
+{
+    // arrange
+    bool result;
+
+    // act
+    result = utf8_checker_final(NULL);
+
+    // assert
+    ASSERT_IS_FALSE(result);
+}
+
+/* Tests_SRS_UTF8_CHECKER_01_016: [ `utf8_checker_final` shall return true if all the bytes given since `utf8_checker_init` are valid UTF-8 and do not end in the middle of a sequence, and false otherwise. ]*/
+TEST_FUNCTION(utf8_checker_final_in_the_middle_of_a_sequence_fails)
+{
+    // arrange
+    UTF8_CHECKER_STATE state;
+    unsigned char test_str[] = { 'a', 0xF0, 0x9F, 0x98 };
+    bool result;
+
+    utf8_checker_init(&state);
+    ASSERT_IS_TRUE(utf8_checker_update(&state, test_str, sizeof(test_str)));
+
+    // act
+    result = utf8_checker_final(&state);
+
+    // assert
+    ASSERT_IS_FALSE(result);
+}
+
 END_TEST_SUITE(utf8_checker_ut)
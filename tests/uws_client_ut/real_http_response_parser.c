@@ -0,0 +1,13 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#define http_response_parser_create real_http_response_parser_create
+#define http_response_parser_destroy real_http_response_parser_destroy
+#define http_response_parser_parse real_http_response_parser_parse
+#define http_response_parser_is_complete real_http_response_parser_is_complete
+#define http_response_parser_reset real_http_response_parser_reset
+#define http_response_parser_set_connect_response real_http_response_parser_set_connect_response
+
+#define GBALLOC_H
+
+#include "http_response_parser.c"
@@ -40,7 +40,6 @@ Tests_SRS_UWS_CLIENT_01_327: [ 1003 indicates that an endpoint is terminating th
 Tests_SRS_UWS_CLIENT_01_328: [ Reserved.  The specific meaning might be defined in the future. ]
 Tests_SRS_UWS_CLIENT_01_329: [ 1005 is a reserved value and MUST NOT be set as a status code in a Close control frame by an endpoint. ]
 Tests_SRS_UWS_CLIENT_01_330: [ 1006 is a reserved value and MUST NOT be set as a status code in a Close control frame by an endpoint. ]
-Tests_SRS_UWS_CLIENT_01_331: [ 1007 indicates that an endpoint is terminating the connection because it has received data within a message that was not consistent with the type of the message (e.g., non-UTF-8 [RFC3629] data within a text message). ]
 Tests_SRS_UWS_CLIENT_01_332: [ 1008 indicates that an endpoint is terminating the connection because it has received a message that violates its policy. ]
 Tests_SRS_UWS_CLIENT_01_333: [ 1009 indicates that an endpoint is terminating the connection because it has received a message that is too big for it to process. ]
 Tests_SRS_UWS_CLIENT_01_334: [ 1010 indicates that an endpoint (client) is terminating the connection because it has expected the server to negotiate one or more extension, but the server didn't return them in the response message of the WebSocket handshake. ]
@@ -61,6 +60,7 @@ Tests_SRS_UWS_CLIENT_01_211: [ One implication of this is that in absence of ext
 #include "azure_c_shared_utility/uws_frame_encoder.h"
 #include "azure_c_shared_utility/gb_rand.h"
 #include "azure_c_shared_utility/base64.h"
+#include "azure_c_shared_utility/http_response_parser.h"
 
 TEST_DEFINE_ENUM_TYPE(IO_OPEN_RESULT, IO_OPEN_RESULT_VALUES);
 IMPLEMENT_UMOCK_C_ENUM_TYPE(IO_OPEN_RESULT, IO_OPEN_RESULT_VALUES);
@@ -409,6 +409,12 @@ extern "C" {
     extern unsigned char* real_BUFFER_u_char(BUFFER_HANDLE handle);
     extern size_t real_BUFFER_length(BUFFER_HANDLE handle);
 
+    extern HTTP_RESPONSE_PARSER_HANDLE real_http_response_parser_create(ON_HTTP_RESPONSE_STATUS on_status, ON_HTTP_RESPONSE_HEADER on_header, ON_HTTP_RESPONSE_HEADERS_COMPLETE on_headers_complete, ON_HTTP_RESPONSE_BODY on_body, ON_HTTP_RESPONSE_COMPLETE on_complete, void* callback_context);
+    extern void real_http_response_parser_destroy(HTTP_RESPONSE_PARSER_HANDLE http_response_parser);
+    extern int real_http_response_parser_parse(HTTP_RESPONSE_PARSER_HANDLE http_response_parser, const unsigned char* buffer, size_t size, size_t* bytes_consumed);
+    extern bool real_http_response_parser_is_complete(HTTP_RESPONSE_PARSER_HANDLE http_response_parser);
+    extern void real_http_response_parser_reset(HTTP_RESPONSE_PARSER_HANDLE http_response_parser);
+
     BUFFER_HANDLE my_uws_frame_encoder_encode(WS_FRAME_TYPE opcode, const unsigned char* payload, size_t length, bool is_masked, bool is_final, unsigned char reserved)
     {
         (void)opcode;
@@ -468,6 +474,8 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_GLOBAL_MOCK_RETURN(xio_create, TEST_IO_HANDLE);
     REGISTER_GLOBAL_MOCK_RETURN(xio_retrieveoptions, TEST_IO_OPTIONHANDLER_HANDLE);
     REGISTER_GLOBAL_MOCK_RETURN(utf8_checker_is_valid_utf8, true);
+    REGISTER_GLOBAL_MOCK_RETURN(utf8_checker_update, true);
+    REGISTER_GLOBAL_MOCK_RETURN(utf8_checker_final, true);
     REGISTER_GLOBAL_MOCK_RETURN(Base64_Encode_Bytes, BASE64_ENCODED_STRING);
     REGISTER_GLOBAL_MOCK_RETURN(OptionHandler_FeedOptions, OPTIONHANDLER_OK);
     REGISTER_GLOBAL_MOCK_RETURN(OptionHandler_AddOption, OPTIONHANDLER_OK);
@@ -477,6 +485,11 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_GLOBAL_MOCK_HOOK(BUFFER_u_char, real_BUFFER_u_char);
     REGISTER_GLOBAL_MOCK_HOOK(BUFFER_length, real_BUFFER_length);
     REGISTER_GLOBAL_MOCK_HOOK(uws_frame_encoder_encode, my_uws_frame_encoder_encode);
+    REGISTER_GLOBAL_MOCK_HOOK(http_response_parser_create, real_http_response_parser_create);
+    REGISTER_GLOBAL_MOCK_HOOK(http_response_parser_destroy, real_http_response_parser_destroy);
+    REGISTER_GLOBAL_MOCK_HOOK(http_response_parser_parse, real_http_response_parser_parse);
+    REGISTER_GLOBAL_MOCK_HOOK(http_response_parser_is_complete, real_http_response_parser_is_complete);
+    REGISTER_GLOBAL_MOCK_HOOK(http_response_parser_reset, real_http_response_parser_reset);
     REGISTER_GLOBAL_MOCK_RETURN(STRING_c_str, "test_str");
     REGISTER_TYPE(IO_OPEN_RESULT, IO_OPEN_RESULT);
     REGISTER_TYPE(IO_SEND_RESULT, IO_SEND_RESULT);
@@ -504,6 +517,13 @@ TEST_SUITE_INITIALIZE(suite_init)
     REGISTER_UMOCK_ALIAS_TYPE(pfCloneOption, void*);
     REGISTER_UMOCK_ALIAS_TYPE(pfSetOption, void*);
     REGISTER_UMOCK_ALIAS_TYPE(pfDestroyOption, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(HTTP_RESPONSE_PARSER_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_RESPONSE_STATUS, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_RESPONSE_HEADER, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_RESPONSE_HEADERS_COMPLETE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_RESPONSE_BODY, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(UTF8_CHECKER_STATE*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ON_HTTP_RESPONSE_COMPLETE, void*);
 }
 
 TEST_SUITE_CLEANUP(suite_cleanup)
@@ -3136,8 +3156,8 @@ TEST_FUNCTION(uws_client_open_async_after_WS_OPEN_ERROR_MULTIPLE_UNDERLYING_IO_O
 
 /* on_underlying_io_bytes_received */
 
-/* Tests_SRS_UWS_CLIENT_01_378: [ When `on_underlying_io_bytes_received` is called while the uws is OPENING, the received bytes shall be accumulated in order to attempt parsing the WebSocket Upgrade response. ]*/
-/* Tests_SRS_UWS_CLIENT_01_380: [ If an WebSocket Upgrade request can be parsed from the accumulated bytes, the status shall be read from the WebSocket upgrade response. ]*/
+/* Tests_SRS_UWS_CLIENT_01_378: [ When `on_underlying_io_bytes_received` is called while the uws is OPENING, the received bytes shall be handed to an HTTP response parser in order to attempt parsing the WebSocket Upgrade response. ]*/
+/* Tests_SRS_UWS_CLIENT_01_380: [ The status shall be read from the WebSocket upgrade response by the HTTP response parser, without the received bytes being accumulated. ]*/
 /* Tests_SRS_UWS_CLIENT_01_381: [ If the status is 101, uws shall be considered OPEN and this shall be indicated by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `IO_OPEN_OK`. ]*/
 /* Tests_SRS_UWS_CLIENT_01_065: [ When the client is to _Establish a WebSocket Connection_ given a set of (/host/, /port/, /resource name/, and /secure/ flag), along with a list of /protocols/ and /extensions/ to be used, and an /origin/ in the case of web browsers, it MUST open a connection, send an opening handshake, and read the server's handshake in response. ]*/
 /* Tests_SRS_UWS_CLIENT_01_102: [ Once the client's opening handshake has been sent, the client MUST wait for a response from the server before sending any further data. ]*/
@@ -3159,7 +3179,10 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_full_reply_after_the_upgrad
 
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_OK));
 
     // act
@@ -3190,7 +3213,8 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_reply_with_a_status_code_di
 
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_ERROR_BAD_RESPONSE_STATUS));
 
@@ -3222,7 +3246,8 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_reply_with_status_100_indic
 
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_ERROR_BAD_RESPONSE_STATUS));
 
@@ -3255,6 +3280,7 @@ TEST_FUNCTION(open_after_a_bad_status_is_decoded_succeeds)
     g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)test_upgrade_response, sizeof(test_upgrade_response) - 1);
     umock_c_reset_all_calls();
 
+    EXPECTED_CALL(http_response_parser_reset(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(xio_open(TEST_IO_HANDLE, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_PTR_ARG))
         .IgnoreArgument_on_io_open_complete()
         .IgnoreArgument_on_io_open_complete_context()
@@ -3274,8 +3300,8 @@ TEST_FUNCTION(open_after_a_bad_status_is_decoded_succeeds)
     uws_client_destroy(uws_client);
 }
 
-/* Tests_SRS_UWS_CLIENT_01_378: [ When `on_underlying_io_bytes_received` is called while the uws is OPENING, the received bytes shall be accumulated in order to attempt parsing the WebSocket Upgrade response. ]*/
-/* Tests_SRS_UWS_CLIENT_01_380: [ If an WebSocket Upgrade request can be parsed from the accumulated bytes, the status shall be read from the WebSocket upgrade response. ]*/
+/* Tests_SRS_UWS_CLIENT_01_378: [ When `on_underlying_io_bytes_received` is called while the uws is OPENING, the received bytes shall be handed to an HTTP response parser in order to attempt parsing the WebSocket Upgrade response. ]*/
+/* Tests_SRS_UWS_CLIENT_01_380: [ The status shall be read from the WebSocket upgrade response by the HTTP response parser, without the received bytes being accumulated. ]*/
 /* Tests_SRS_UWS_CLIENT_01_381: [ If the status is 101, uws shall be considered OPEN and this shall be indicated by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `IO_OPEN_OK`. ]*/
 /* Tests_SRS_UWS_CLIENT_01_065: [ When the client is to _Establish a WebSocket Connection_ given a set of (/host/, /port/, /resource name/, and /secure/ flag), along with a list of /protocols/ and /extensions/ to be used, and an /origin/ in the case of web browsers, it MUST open a connection, send an opening handshake, and read the server's handshake in response. ]*/
 /* Tests_SRS_UWS_CLIENT_01_102: [ Once the client's opening handshake has been sent, the client MUST wait for a response from the server before sending any further data. ]*/
@@ -3302,7 +3328,9 @@ TEST_FUNCTION(after_a_bad_status_code_a_subsequent_open_completes)
 
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_OK));
 
     // act
@@ -3333,7 +3361,8 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_an_empty_reply_indicates_an_o
 
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_ERROR_BAD_UPGRADE_RESPONSE));
 
@@ -3365,7 +3394,8 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_an_imcomplete_HTTP_1_1__reply
 
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_ERROR_BAD_UPGRADE_RESPONSE));
 
@@ -3397,7 +3427,8 @@ TEST_FUNCTION(on_underlying_io_bytes_received_with_a_complete_HTTP_version_but_n
 
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_ERROR_BAD_UPGRADE_RESPONSE));
 
@@ -3428,7 +3459,10 @@ TEST_FUNCTION(open_completes_when_response_has_more_spaces_in_it)
 
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_OK));
 
     // act
@@ -3458,7 +3492,10 @@ TEST_FUNCTION(open_completes_when_response_has_more_spaces_in_it_after_the_statu
 
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_OK));
 
     // act
@@ -3488,7 +3525,10 @@ TEST_FUNCTION(open_completes_when_a_header_is_present_in_the_response)
 
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_OK));
 
     // act
@@ -3501,8 +3541,8 @@ TEST_FUNCTION(open_completes_when_a_header_is_present_in_the_response)
     uws_client_destroy(uws_client);
 }
 
-/* Tests_SRS_UWS_CLIENT_01_379: [ If allocating memory for accumulating the bytes fails, uws shall report that the open failed by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_NOT_ENOUGH_MEMORY`. ]*/
-TEST_FUNCTION(when_allocating_memory_for_the_received_bytes_fails_on_underlying_io_bytes_received_indicates_open_complete_with_error)
+/* Tests_SRS_UWS_CLIENT_01_379: [ If creating the HTTP response parser fails, uws shall report that the open failed by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_NOT_ENOUGH_MEMORY`. ]*/
+TEST_FUNCTION(when_creating_the_upgrade_response_parser_fails_on_underlying_io_bytes_received_indicates_open_complete_with_error)
 {
     // arrange
     TLSIO_CONFIG tlsio_config;
@@ -3518,7 +3558,7 @@ TEST_FUNCTION(when_allocating_memory_for_the_received_bytes_fails_on_underlying_
 
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG))
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG))
         .SetReturn(NULL);
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_ERROR_NOT_ENOUGH_MEMORY));
@@ -3533,8 +3573,9 @@ TEST_FUNCTION(when_allocating_memory_for_the_received_bytes_fails_on_underlying_
     uws_client_destroy(uws_client);
 }
 
-/* Tests_SRS_UWS_CLIENT_01_378: [ When `on_underlying_io_bytes_received` is called while the uws is OPENING, the received bytes shall be accumulated in order to attempt parsing the WebSocket Upgrade response. ]*/
-/* Tests_SRS_UWS_CLIENT_01_380: [ If an WebSocket Upgrade request can be parsed from the accumulated bytes, the status shall be read from the WebSocket upgrade response. ]*/
+/* Tests_SRS_UWS_CLIENT_01_378: [ When `on_underlying_io_bytes_received` is called while the uws is OPENING, the received bytes shall be handed to an HTTP response parser in order to attempt parsing the WebSocket Upgrade response. ]*/
+/* Tests_SRS_UWS_CLIENT_01_380: [ The status shall be read from the WebSocket upgrade response by the HTTP response parser, without the received bytes being accumulated. ]*/
+/* Tests_SRS_UWS_CLIENT_01_532: [ The HTTP response parser shall be created by calling `http_response_parser_create` the first time bytes are received for the WebSocket Upgrade response. ]*/
 TEST_FUNCTION(when_only_a_byte_is_received_no_open_complete_is_indicated)
 {
     // arrange
@@ -3551,7 +3592,9 @@ TEST_FUNCTION(when_only_a_byte_is_received_no_open_complete_is_indicated)
 
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
 
     // act
     g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)test_upgrade_response, sizeof(test_upgrade_response) - 1);
@@ -3674,8 +3717,8 @@ TEST_FUNCTION(on_underlying_io_bytes_received_before_underlying_io_open_complete
     uws_client_destroy(uws_client);
 }
 
-/* Tests_SRS_UWS_CLIENT_01_379: [ If allocating memory for accumulating the bytes fails, uws shall report that the open failed by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_NOT_ENOUGH_MEMORY`. ]*/
-TEST_FUNCTION(when_allocating_memory_for_a_second_byte_fails_open_complete_is_indicated_with_error)
+/* Tests_SRS_UWS_CLIENT_01_383: [ If the WebSocket upgrade request cannot be decoded an error shall be indicated by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_BAD_UPGRADE_RESPONSE`. ]*/
+TEST_FUNCTION(when_parsing_a_second_byte_fails_open_complete_is_indicated_with_error)
 {
     // arrange
     TLSIO_CONFIG tlsio_config;
@@ -3691,10 +3734,10 @@ TEST_FUNCTION(when_allocating_memory_for_a_second_byte_fails_open_complete_is_in
     g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)test_upgrade_response, 1);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG))
-        .SetReturn(NULL);
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG))
+        .SetReturn(1);
     STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
-    STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_ERROR_NOT_ENOUGH_MEMORY));
+    STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_ERROR_BAD_UPGRADE_RESPONSE));
 
     // act
     g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)test_upgrade_response + 1, 1);
@@ -3721,7 +3764,9 @@ void when_only_n_bytes_are_received_from_the_response_no_open_complete_is_indica
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
-    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
 
     // act
     g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)test_upgrade_response, n);
@@ -3734,7 +3779,7 @@ void when_only_n_bytes_are_received_from_the_response_no_open_complete_is_indica
     uws_client_destroy(uws_client);
 }
 
-/* Tests_SRS_UWS_CLIENT_01_380: [ If an WebSocket Upgrade request can be parsed from the accumulated bytes, the status shall be read from the WebSocket upgrade response. ]*/
+/* Tests_SRS_UWS_CLIENT_01_380: [ The status shall be read from the WebSocket upgrade response by the HTTP response parser, without the received bytes being accumulated. ]*/
 TEST_FUNCTION(when_all_but_1_bytes_are_received_from_the_response_no_open_complete_is_indicated)
 {
     const char test_upgrade_response[] = "HTTP/1.1 101 Switching Protocols\r\n\r";
@@ -3762,6 +3807,10 @@ TEST_FUNCTION(when_1_extra_byte_is_received_the_open_complete_is_properly_indica
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_OK));
 
@@ -3775,6 +3824,41 @@ TEST_FUNCTION(when_1_extra_byte_is_received_the_open_complete_is_properly_indica
     uws_client_destroy(uws_client);
 }
 
+/* Tests_SRS_UWS_CLIENT_01_533: [ If allocating memory for the extra bytes fails, uws shall report that the open failed by calling the `on_ws_open_complete` callback passed to `uws_client_open_async` with `WS_OPEN_ERROR_NOT_ENOUGH_MEMORY`. ]*/
+TEST_FUNCTION(when_allocating_memory_for_the_extra_bytes_fails_open_complete_is_indicated_with_error)
+{
+    // arrange
+    TLSIO_CONFIG tlsio_config;
+    UWS_CLIENT_HANDLE uws_client;
+    const char test_upgrade_response[] = "HTTP/1.1 101 Switching Protocols\r\n\r\n\0";
+
+    tlsio_config.hostname = "test_host";
+    tlsio_config.port = 444;
+
+    uws_client = uws_client_create("test_host", 444, "/aaa", true, protocols, sizeof(protocols) / sizeof(protocols[0]));
+    (void)uws_client_open_async(uws_client, test_on_ws_open_complete, (void*)0x4242, test_on_ws_frame_received, (void*)0x4243, test_on_ws_peer_closed, (void*)0x4301, test_on_ws_error, (void*)0x4244);
+    g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
+    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG))
+        .SetReturn(NULL);
+    STRICT_EXPECTED_CALL(xio_close(TEST_IO_HANDLE, NULL, NULL));
+    STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_ERROR_NOT_ENOUGH_MEMORY));
+
+    // act
+    g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)test_upgrade_response, sizeof(test_upgrade_response));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    uws_client_destroy(uws_client);
+}
+
 /* Tests_SRS_UWS_CLIENT_01_386: [ When a WebSocket data frame is decoded succesfully it shall be indicated via the callback `on_ws_frame_received`. ]*/
 /* Tests_SRS_UWS_CLIENT_01_385: [ If the state of the uws instance is OPEN, the received bytes shall be used for decoding WebSocket frames. ]*/
 /* Tests_SRS_UWS_CLIENT_01_154: [ *  %x2 denotes a binary frame ]*/
@@ -3845,6 +3929,8 @@ TEST_FUNCTION(when_a_1_byte_text_frame_is_received_it_shall_be_indicated_to_the_
     umock_c_reset_all_calls();
 
     EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(utf8_checker_is_valid_utf8(IGNORED_PTR_ARG, 1))
+        .ValidateArgumentBuffer(1, expected_payload, sizeof(expected_payload));
     STRICT_EXPECTED_CALL(test_on_ws_frame_received((void*)0x4243, WS_FRAME_TYPE_TEXT, IGNORED_PTR_ARG, 1))
         .ValidateArgumentBuffer(3, expected_payload, sizeof(expected_payload));
 
@@ -3913,6 +3999,7 @@ TEST_FUNCTION(when_a_0_bytes_text_frame_is_received_it_shall_be_indicated_to_the
     umock_c_reset_all_calls();
 
     EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(utf8_checker_is_valid_utf8(IGNORED_PTR_ARG, 0));
     STRICT_EXPECTED_CALL(test_on_ws_frame_received((void*)0x4243, WS_FRAME_TYPE_TEXT, IGNORED_PTR_ARG, 0))
         .IgnoreArgument_buffer();
 
@@ -3926,6 +4013,184 @@ TEST_FUNCTION(when_a_0_bytes_text_frame_is_received_it_shall_be_indicated_to_the
     uws_client_destroy(uws_client);
 }
 
+/* Tests_SRS_UWS_CLIENT_01_261: [ The "Payload data" is text data encoded as UTF-8. ]*/
+/* Tests_SRS_UWS_CLIENT_01_342: [ When an endpoint is to interpret a byte stream as UTF-8 but finds that the byte stream is not, in fact, a valid UTF-8 stream, that endpoint MUST _Fail the WebSocket Connection_. ]*/
+/* Tests_SRS_UWS_CLIENT_01_331: [ 1007 indicates that an endpoint is terminating the connection because it has received data within a message that was not consistent with the type of the message (e.g., non-UTF-8 [RFC3629] data within a text message). ]*/
+TEST_FUNCTION(when_a_text_frame_that_is_not_utf8_is_received_an_error_is_indicated_and_connection_is_closed)
+{
+    // arrange
+    TLSIO_CONFIG tlsio_config;
+    UWS_CLIENT_HANDLE uws_client;
+    const char test_upgrade_response[] = "HTTP/1.1 101 Switching Protocols\r\n\r\n";
+    const unsigned char test_frame[] = { 0x81, 0x01, 0xFF };
+    unsigned char close_frame_payload[] = { 0x03, 0xEF };
+    unsigned char close_frame[] = { 0x88, 0x82, 0x00, 0x00, 0x00, 0x00, 0x03, 0xEF };
+    BUFFER_HANDLE buffer_handle;
+
+    tlsio_config.hostname = "test_host";
+    tlsio_config.port = 444;
+
+    uws_client = uws_client_create("test_host", 444, "/aaa", true, protocols, sizeof(protocols) / sizeof(protocols[0]));
+    (void)uws_client_open_async(uws_client, test_on_ws_open_complete, (void*)0x4242, test_on_ws_frame_received, (void*)0x4243, test_on_ws_peer_closed, (void*)0x4301, test_on_ws_error, (void*)0x4244);
+    g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
+    g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)test_upgrade_response, sizeof(test_upgrade_response) - 1);
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(utf8_checker_is_valid_utf8(IGNORED_PTR_ARG, 1))
+        .ValidateArgumentBuffer(1, test_frame + 2, 1)
+        .SetReturn(false);
+    STRICT_EXPECTED_CALL(uws_frame_encoder_encode(WS_CLOSE_FRAME, IGNORED_PTR_ARG, sizeof(close_frame_payload), true, true, 0))
+        .ValidateArgumentBuffer(2, close_frame_payload, sizeof(close_frame_payload))
+        .CaptureReturn(&buffer_handle);
+    STRICT_EXPECTED_CALL(BUFFER_u_char(IGNORED_PTR_ARG))
+        .ValidateArgumentValue_handle(&buffer_handle)
+        .SetReturn(close_frame);
+    STRICT_EXPECTED_CALL(BUFFER_length(IGNORED_PTR_ARG))
+        .ValidateArgumentValue_handle(&buffer_handle)
+        .SetReturn(sizeof(close_frame));
+    STRICT_EXPECTED_CALL(xio_send(TEST_IO_HANDLE, close_frame, sizeof(close_frame), NULL, NULL))
+        .ValidateArgumentBuffer(2, close_frame, sizeof(close_frame));
+    STRICT_EXPECTED_CALL(BUFFER_delete(IGNORED_PTR_ARG))
+        .ValidateArgumentValue_handle(&buffer_handle);
+    STRICT_EXPECTED_CALL(test_on_ws_error((void*)0x4244, WS_ERROR_BAD_FRAME_RECEIVED));
+
+    // act
+    g_on_bytes_received(g_on_bytes_received_context, test_frame, sizeof(test_frame));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    uws_client_destroy(uws_client);
+}
+
+/* Tests_SRS_UWS_CLIENT_01_262: [ a particular text frame might include a partial UTF-8 sequence; however, the whole message MUST contain valid UTF-8. ]*/
+/* Tests_SRS_UWS_CLIENT_01_263: [ Invalid UTF-8 in reassembled messages is handled as described in Section 8.1. ]*/
+TEST_FUNCTION(when_a_fragmented_text_message_is_received_the_utf8_check_carries_over_the_frames)
+{
+    // arrange
+    TLSIO_CONFIG tlsio_config;
+    UWS_CLIENT_HANDLE uws_client;
+    const char test_upgrade_response[] = "HTTP/1.1 101 Switching Protocols\r\n\r\n";
+    const unsigned char test_frames[] = { 0x01, 0x01, 0xC3, 0x80, 0x01, 0xA9 };
+
+    tlsio_config.hostname = "test_host";
+    tlsio_config.port = 444;
+
+    uws_client = uws_client_create("test_host", 444, "/aaa", true, protocols, sizeof(protocols) / sizeof(protocols[0]));
+    (void)uws_client_open_async(uws_client, test_on_ws_open_complete, (void*)0x4242, test_on_ws_frame_received, (void*)0x4243, test_on_ws_peer_closed, (void*)0x4301, test_on_ws_error, (void*)0x4244);
+    g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
+    g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)test_upgrade_response, sizeof(test_upgrade_response) - 1);
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(utf8_checker_init(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(utf8_checker_update(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 1))
+        .ValidateArgumentBuffer(2, test_frames + 2, 1);
+    STRICT_EXPECTED_CALL(test_on_ws_frame_received((void*)0x4243, WS_FRAME_TYPE_TEXT, IGNORED_PTR_ARG, 1))
+        .ValidateArgumentBuffer(3, test_frames + 2, 1);
+    STRICT_EXPECTED_CALL(utf8_checker_update(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 1))
+        .ValidateArgumentBuffer(2, test_frames + 5, 1);
+    STRICT_EXPECTED_CALL(utf8_checker_final(IGNORED_PTR_ARG));
+
+    // act
+    g_on_bytes_received(g_on_bytes_received_context, test_frames, sizeof(test_frames));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    uws_client_destroy(uws_client);
+}
+
+/* Tests_SRS_UWS_CLIENT_01_263: [ Invalid UTF-8 in reassembled messages is handled as described in Section 8.1. ]*/
+/* Tests_SRS_UWS_CLIENT_01_342: [ When an endpoint is to interpret a byte stream as UTF-8 but finds that the byte stream is not, in fact, a valid UTF-8 stream, that endpoint MUST _Fail the WebSocket Connection_. ]*/
+TEST_FUNCTION(when_a_fragmented_text_message_ends_in_the_middle_of_a_utf8_sequence_an_error_is_indicated_and_connection_is_closed)
+{
+    // arrange
+    TLSIO_CONFIG tlsio_config;
+    UWS_CLIENT_HANDLE uws_client;
+    const char test_upgrade_response[] = "HTTP/1.1 101 Switching Protocols\r\n\r\n";
+    const unsigned char test_frames[] = { 0x01, 0x01, 'a', 0x80, 0x01, 0xC3 };
+    unsigned char close_frame_payload[] = { 0x03, 0xEF };
+    unsigned char close_frame[] = { 0x88, 0x82, 0x00, 0x00, 0x00, 0x00, 0x03, 0xEF };
+    BUFFER_HANDLE buffer_handle;
+
+    tlsio_config.hostname = "test_host";
+    tlsio_config.port = 444;
+
+    uws_client = uws_client_create("test_host", 444, "/aaa", true, protocols, sizeof(protocols) / sizeof(protocols[0]));
+    (void)uws_client_open_async(uws_client, test_on_ws_open_complete, (void*)0x4242, test_on_ws_frame_received, (void*)0x4243, test_on_ws_peer_closed, (void*)0x4301, test_on_ws_error, (void*)0x4244);
+    g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
+    g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)test_upgrade_response, sizeof(test_upgrade_response) - 1);
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+    STRICT_EXPECTED_CALL(utf8_checker_init(IGNORED_PTR_ARG));
+    STRICT_EXPECTED_CALL(utf8_checker_update(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 1))
+        .ValidateArgumentBuffer(2, test_frames + 2, 1);
+    STRICT_EXPECTED_CALL(test_on_ws_frame_received((void*)0x4243, WS_FRAME_TYPE_TEXT, IGNORED_PTR_ARG, 1))
+        .ValidateArgumentBuffer(3, test_frames + 2, 1);
+    STRICT_EXPECTED_CALL(utf8_checker_update(IGNORED_PTR_ARG, IGNORED_PTR_ARG, 1))
+        .ValidateArgumentBuffer(2, test_frames + 5, 1);
+    STRICT_EXPECTED_CALL(utf8_checker_final(IGNORED_PTR_ARG))
+        .SetReturn(false);
+    STRICT_EXPECTED_CALL(uws_frame_encoder_encode(WS_CLOSE_FRAME, IGNORED_PTR_ARG, sizeof(close_frame_payload), true, true, 0))
+        .ValidateArgumentBuffer(2, close_frame_payload, sizeof(close_frame_payload))
+        .CaptureReturn(&buffer_handle);
+    STRICT_EXPECTED_CALL(BUFFER_u_char(IGNORED_PTR_ARG))
+        .ValidateArgumentValue_handle(&buffer_handle)
+        .SetReturn(close_frame);
+    STRICT_EXPECTED_CALL(BUFFER_length(IGNORED_PTR_ARG))
+        .ValidateArgumentValue_handle(&buffer_handle)
+        .SetReturn(sizeof(close_frame));
+    STRICT_EXPECTED_CALL(xio_send(TEST_IO_HANDLE, close_frame, sizeof(close_frame), NULL, NULL))
+        .ValidateArgumentBuffer(2, close_frame, sizeof(close_frame));
+    STRICT_EXPECTED_CALL(BUFFER_delete(IGNORED_PTR_ARG))
+        .ValidateArgumentValue_handle(&buffer_handle);
+    STRICT_EXPECTED_CALL(test_on_ws_error((void*)0x4244, WS_ERROR_BAD_FRAME_RECEIVED));
+
+    // act
+    g_on_bytes_received(g_on_bytes_received_context, test_frames, sizeof(test_frames));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    uws_client_destroy(uws_client);
+}
+
+/* Tests_SRS_UWS_CLIENT_01_152: [ *  %x0 denotes a continuation frame ]*/
+TEST_FUNCTION(when_a_continuation_frame_is_received_outside_of_a_text_message_utf8_is_not_checked)
+{
+    // arrange
+    TLSIO_CONFIG tlsio_config;
+    UWS_CLIENT_HANDLE uws_client;
+    const char test_upgrade_response[] = "HTTP/1.1 101 Switching Protocols\r\n\r\n";
+    const unsigned char test_frame[] = { 0x80, 0x01, 0xFF };
+
+    tlsio_config.hostname = "test_host";
+    tlsio_config.port = 444;
+
+    uws_client = uws_client_create("test_host", 444, "/aaa", true, protocols, sizeof(protocols) / sizeof(protocols[0]));
+    (void)uws_client_open_async(uws_client, test_on_ws_open_complete, (void*)0x4242, test_on_ws_frame_received, (void*)0x4243, test_on_ws_peer_closed, (void*)0x4301, test_on_ws_error, (void*)0x4244);
+    g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
+    g_on_bytes_received(g_on_bytes_received_context, (const unsigned char*)test_upgrade_response, sizeof(test_upgrade_response) - 1);
+    umock_c_reset_all_calls();
+
+    EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
+
+    // act
+    g_on_bytes_received(g_on_bytes_received_context, test_frame, sizeof(test_frame));
+
+    // assert
+    ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    uws_client_destroy(uws_client);
+}
+
 /* Tests_SRS_UWS_CLIENT_01_163: [ The length of the "Payload data", in bytes: ]*/
 /* Tests_SRS_UWS_CLIENT_01_164: [ if 0-125, that is the payload length. ]*/
 /* Tests_SRS_UWS_CLIENT_01_264: [ The "Payload data" is arbitrary binary data whose interpretation is solely up to the application layer. ]*/
@@ -4544,6 +4809,10 @@ TEST_FUNCTION(when_a_complete_frame_is_received_together_with_the_upgrade_reques
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_OK));
     STRICT_EXPECTED_CALL(test_on_ws_frame_received((void*)0x4243, WS_FRAME_TYPE_BINARY, IGNORED_PTR_ARG, 0))
@@ -4584,6 +4853,10 @@ TEST_FUNCTION(when_a_1_byte_complete_frame_is_received_together_with_the_upgrade
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_OK));
     STRICT_EXPECTED_CALL(test_on_ws_frame_received((void*)0x4243, WS_FRAME_TYPE_BINARY, expected_frame_payload, sizeof(expected_frame_payload)))
@@ -4625,8 +4898,14 @@ TEST_FUNCTION(when_2_complete_frames_are_received_together_with_the_upgrade_requ
     g_on_io_open_complete(g_on_io_open_complete_context, IO_OPEN_OK);
     umock_c_reset_all_calls();
 
+    EXPECTED_CALL(http_response_parser_create(IGNORED_PTR_ARG, NULL, NULL, NULL, NULL, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_parse(IGNORED_PTR_ARG, IGNORED_PTR_ARG, IGNORED_NUM_ARG, IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_is_complete(IGNORED_PTR_ARG));
+    EXPECTED_CALL(http_response_parser_destroy(IGNORED_PTR_ARG));
     EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG));
     STRICT_EXPECTED_CALL(test_on_ws_open_complete((void*)0x4242, WS_OPEN_OK));
+    STRICT_EXPECTED_CALL(utf8_checker_is_valid_utf8(IGNORED_PTR_ARG, 1))
+        .ValidateArgumentBuffer(1, "a", 1);
     STRICT_EXPECTED_CALL(test_on_ws_frame_received((void*)0x4243, WS_FRAME_TYPE_TEXT, IGNORED_PTR_ARG, 1))
         .ValidateArgumentBuffer(3, "a", 1);
     STRICT_EXPECTED_CALL(test_on_ws_frame_received((void*)0x4243, WS_FRAME_TYPE_BINARY, IGNORED_PTR_ARG, 0))
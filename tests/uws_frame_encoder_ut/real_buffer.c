@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 #define BUFFER_new real_BUFFER_new
+#define BUFFER_new_in_arena real_BUFFER_new_in_arena
 #define BUFFER_create real_BUFFER_create
 #define BUFFER_pre_build real_BUFFER_pre_build
 #define BUFFER_build real_BUFFER_build
@@ -15,6 +16,11 @@
 #define BUFFER_enlarge real_BUFFER_enlarge
 #define BUFFER_size real_BUFFER_size
 #define BUFFER_content real_BUFFER_content
+#define BUFFER_create_with_moved_memory real_BUFFER_create_with_moved_memory
+#define BUFFER_transfer real_BUFFER_transfer
+#define BUFFER_reserve real_BUFFER_reserve
+#define BUFFER_reserve_front real_BUFFER_reserve_front
+#define BUFFER_shrink real_BUFFER_shrink
 
 #define GBALLOC_H
 
@@ -750,7 +750,8 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         VECTOR_destroy(handle);
     }
 
-    /* Tests_SRS_VECTOR_10_014: [VECTOR_erase shall remove the `numElements` starting at `elements` and reduce its internal storage.] */
+    /* Tests_SRS_VECTOR_10_014: [VECTOR_erase shall remove the `numElements` starting at `elements`.] */
+    /* Tests_SRS_VECTOR_01_003: [VECTOR_erase shall not reallocate the internal storage.] */
     TEST_FUNCTION(VECTOR_erase_succeeds_case_1)
     {
         ///arrange
@@ -761,8 +762,6 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         (void)VECTOR_push_back(handle, &sItem2, 1);
         VECTOR_UNITTEST* pfindItem = (VECTOR_UNITTEST*)VECTOR_find_if(handle, VECTOR_UNITTEST_isEqual, &sItem1);
         umock_c_reset_all_calls();
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, sizeof(VECTOR_UNITTEST)))
-            .IgnoreArgument_ptr();
 
         ///act
         VECTOR_erase(handle, pfindItem, 1);
@@ -778,7 +777,8 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         VECTOR_destroy(handle);
     }
 
-    /* Tests_SRS_VECTOR_10_014: [VECTOR_erase shall remove the `numElements` starting at `elements` and reduce its internal storage.] */
+    /* Tests_SRS_VECTOR_10_014: [VECTOR_erase shall remove the `numElements` starting at `elements`.] */
+    /* Tests_SRS_VECTOR_01_003: [VECTOR_erase shall not reallocate the internal storage.] */
     TEST_FUNCTION(VECTOR_erase_succeeds_case_2)
     {
         ///arrange
@@ -789,8 +789,6 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         (void)VECTOR_push_back(handle, &sItem2, 1);
         VECTOR_UNITTEST* pfindItem = (VECTOR_UNITTEST*)VECTOR_find_if(handle, VECTOR_UNITTEST_isEqual, &sItem1);
         umock_c_reset_all_calls();
-        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
-            .IgnoreArgument_ptr();
 
         ///act
         VECTOR_erase(handle, pfindItem, 2);
@@ -798,6 +796,7 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         ///assert
         size_t num = VECTOR_size(handle);
         ASSERT_ARE_EQUAL(size_t, 0, num);
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_capacity(handle));
         pfindItem = (VECTOR_UNITTEST*)VECTOR_find_if(handle, VECTOR_UNITTEST_isEqual, &sItem1);
         ASSERT_IS_NULL(pfindItem);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
@@ -806,32 +805,25 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         VECTOR_destroy(handle);
     }
 
-    /* Tests_SRS_VECTOR_10_014: [VECTOR_erase shall remove the `numElements` starting at `elements` and reduce its internal storage.] */
+    /* Tests_SRS_VECTOR_10_014: [VECTOR_erase shall remove the `numElements` starting at `elements`.] */
     TEST_FUNCTION(VECTOR_erase_succeeds_case_3)
     {
         ///arrange
-        VECTOR_UNITTEST sItem1 = {1, 2};
-        VECTOR_UNITTEST sItem2 = {3, 4};
+        VECTOR_UNITTEST sItems[3] = { {1, 2}, {3, 4}, {5, 6} };
         VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
-        (void)VECTOR_push_back(handle, &sItem1, 1);
-        (void)VECTOR_push_back(handle, &sItem2, 1);
-        VECTOR_UNITTEST* pfindItem = (VECTOR_UNITTEST*)VECTOR_find_if(handle, VECTOR_UNITTEST_isEqual, &sItem1);
+        (void)VECTOR_push_back(handle, sItems, 3);
         umock_c_reset_all_calls();
-        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, IGNORED_NUM_ARG))
-            .IgnoreArgument_ptr()
-            .IgnoreArgument_size()
-            .SetReturn(NULL);
 
         ///act
-        VECTOR_erase(handle, pfindItem, 1);
+        VECTOR_erase(handle, VECTOR_front(handle), 1);
 
         ///assert
-        size_t num = VECTOR_size(handle);
-        ASSERT_ARE_EQUAL(size_t, 1, num);
-        pfindItem = (VECTOR_UNITTEST*)VECTOR_find_if(handle, VECTOR_UNITTEST_isEqual, &sItem1);
-        ASSERT_IS_NULL(pfindItem);
-        pfindItem = (VECTOR_UNITTEST*)VECTOR_find_if(handle, VECTOR_UNITTEST_isEqual, &sItem2);
-        ASSERT_IS_NOT_NULL(pfindItem);
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(size_t, 3, VECTOR_capacity(handle));
+        VECTOR_UNITTEST* pResult = (VECTOR_UNITTEST*)VECTOR_element(handle, 0);
+        ASSERT_ARE_EQUAL(int, sItems[1].nValue1, pResult->nValue1);
+        pResult = (VECTOR_UNITTEST*)VECTOR_element(handle, 1);
+        ASSERT_ARE_EQUAL(int, sItems[2].nValue1, pResult->nValue1);
         ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
         ///cleanup
@@ -957,15 +949,17 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         VECTOR_destroy(handle);
     }
 
+    /* Tests_SRS_VECTOR_01_001: [Otherwise VECTOR_push_back shall grow the capacity to the larger of twice the current capacity and the number of elements needed.] */
+    /* Tests_SRS_VECTOR_01_002: [If the capacity of the vector is large enough, VECTOR_push_back shall not allocate memory.] */
     TEST_FUNCTION(VECTOR_push_back_multiple_elements_succeeds)
     {
             ///arrange
         VECTOR_UNITTEST sItem1 = {1, 2};
         VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
         umock_c_reset_all_calls();
-        for (size_t nIndex = 0; nIndex < NUM_ITEM_PUSH_BACK; nIndex++)
+        for (size_t nCapacity = 1; nCapacity <= NUM_ITEM_PUSH_BACK; nCapacity *= 2)
         {
-            STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, (nIndex + 1) * sizeof(VECTOR_UNITTEST)))
+            STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, nCapacity * sizeof(VECTOR_UNITTEST)))
                 .IgnoreArgument_ptr();
         }
 
@@ -990,6 +984,379 @@ BEGIN_TEST_SUITE(Vector_UnitTests)
         VECTOR_destroy(handle);
     }
 
+    /* Tests_SRS_VECTOR_01_001: [Otherwise VECTOR_push_back shall grow the capacity to the larger of twice the current capacity and the number of elements needed.] */
+    TEST_FUNCTION(VECTOR_push_back_grows_to_the_number_of_elements_needed)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItems[5] = { {1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, sItems, 1);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 5 * sizeof(VECTOR_UNITTEST)))
+            .IgnoreArgument_ptr();
+
+        ///act
+        int result = VECTOR_push_back(handle, sItems + 1, 4);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 5, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(size_t, 5, VECTOR_capacity(handle));
+        VECTOR_UNITTEST* pResult = (VECTOR_UNITTEST*)VECTOR_back(handle);
+        ASSERT_ARE_EQUAL(int, sItems[4].nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_10_012: [VECTOR_push_back shall fail and return non-zero if memory allocation fails.] */
+    TEST_FUNCTION(VECTOR_push_back_keeps_the_vector_if_growing_fails)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItems[2] = { {1, 2}, {3, 4} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, sItems, 1);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(VECTOR_UNITTEST)))
+            .IgnoreArgument_ptr()
+            .SetReturn(NULL);
+
+        ///act
+        int result = VECTOR_push_back(handle, sItems + 1, 1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 1, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(size_t, 1, VECTOR_capacity(handle));
+        VECTOR_UNITTEST* pResult = (VECTOR_UNITTEST*)VECTOR_front(handle);
+        ASSERT_ARE_EQUAL(int, sItems[0].nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_10_004: [VECTOR_move shall allocate a VECTOR_HANDLE and move the data to it from the given handle.] */
+    TEST_FUNCTION(VECTOR_move_moves_the_capacity)
+    {
+        ///arrange
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_reserve(handle, 8);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_malloc(IGNORED_NUM_ARG))
+            .IgnoreArgument_size();
+
+        ///act
+        VECTOR_HANDLE result = VECTOR_move(handle);
+
+        ///assert
+        ASSERT_IS_NOT_NULL(result);
+        ASSERT_ARE_EQUAL(size_t, 8, VECTOR_capacity(result));
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+        VECTOR_destroy(result);
+    }
+
+    /* Tests_SRS_VECTOR_01_004: [VECTOR_pop_back shall return if `handle` is NULL.] */
+    TEST_FUNCTION(VECTOR_pop_back_with_NULL_handle_returns)
+    {
+        ///act
+        VECTOR_pop_back(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_01_005: [VECTOR_pop_back shall return if the vector is empty.] */
+    TEST_FUNCTION(VECTOR_pop_back_on_an_empty_vector_returns)
+    {
+        ///arrange
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        VECTOR_pop_back(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_01_006: [VECTOR_pop_back shall remove the last element of the vector without reallocating the internal storage.] */
+    TEST_FUNCTION(VECTOR_pop_back_removes_the_last_element)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItems[2] = { {1, 2}, {3, 4} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, sItems, 2);
+        umock_c_reset_all_calls();
+
+        ///act
+        VECTOR_pop_back(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 1, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_capacity(handle));
+        VECTOR_UNITTEST* pResult = (VECTOR_UNITTEST*)VECTOR_back(handle);
+        ASSERT_ARE_EQUAL(int, sItems[0].nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_01_008: [VECTOR_capacity shall return 0 if the given handle is NULL.] */
+    TEST_FUNCTION(VECTOR_capacity_with_NULL_handle_returns_0)
+    {
+        ///act
+        size_t result = VECTOR_capacity(NULL);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_01_007: [VECTOR_capacity shall return the number of elements the vector can hold without allocating memory.] */
+    TEST_FUNCTION(VECTOR_capacity_of_a_new_vector_is_0)
+    {
+        ///arrange
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        size_t result = VECTOR_capacity(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(size_t, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_01_009: [VECTOR_reserve shall fail and return non-zero if `handle` is NULL.] */
+    TEST_FUNCTION(VECTOR_reserve_with_NULL_handle_fails)
+    {
+        ///act
+        int result = VECTOR_reserve(NULL, 1);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_01_011: [Otherwise VECTOR_reserve shall resize the internal storage to hold exactly `numElements` elements and return 0.] */
+    TEST_FUNCTION(VECTOR_reserve_allocates_the_requested_capacity)
+    {
+        ///arrange
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(NULL, 10 * sizeof(VECTOR_UNITTEST)));
+
+        ///act
+        int result = VECTOR_reserve(handle, 10);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 10, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_01_010: [If `numElements` is not larger than the capacity, VECTOR_reserve shall return 0 without allocating memory.] */
+    /* Tests_SRS_VECTOR_01_002: [If the capacity of the vector is large enough, VECTOR_push_back shall not allocate memory.] */
+    TEST_FUNCTION(VECTOR_reserve_with_a_smaller_capacity_does_not_allocate)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItems[4] = { {1, 2}, {3, 4}, {5, 6}, {7, 8} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_reserve(handle, 4);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = VECTOR_reserve(handle, 2);
+        (void)VECTOR_push_back(handle, sItems, 4);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 4, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(size_t, 4, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_01_012: [VECTOR_reserve shall fail and return non-zero if memory allocation fails, leaving the vector unchanged.] */
+    TEST_FUNCTION(VECTOR_reserve_fails_if_realloc_fails)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItem = {1, 2};
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, &sItem, 1);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 10 * sizeof(VECTOR_UNITTEST)))
+            .IgnoreArgument_ptr()
+            .SetReturn(NULL);
+
+        ///act
+        int result = VECTOR_reserve(handle, 10);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 1, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(size_t, 1, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_01_012: [VECTOR_reserve shall fail and return non-zero if memory allocation fails, leaving the vector unchanged.] */
+    TEST_FUNCTION(VECTOR_reserve_fails_if_the_size_overflows)
+    {
+        ///arrange
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = VECTOR_reserve(handle, ((size_t)-1) / 2);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_01_013: [VECTOR_shrink_to_fit shall fail and return non-zero if `handle` is NULL.] */
+    TEST_FUNCTION(VECTOR_shrink_to_fit_with_NULL_handle_fails)
+    {
+        ///act
+        int result = VECTOR_shrink_to_fit(NULL);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    }
+
+    /* Tests_SRS_VECTOR_01_014: [If the capacity already equals the number of elements, VECTOR_shrink_to_fit shall return 0 without touching the internal storage.] */
+    TEST_FUNCTION(VECTOR_shrink_to_fit_on_a_full_vector_does_nothing)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItems[2] = { {1, 2}, {3, 4} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, sItems, 2);
+        umock_c_reset_all_calls();
+
+        ///act
+        int result = VECTOR_shrink_to_fit(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_01_015: [If the vector is empty, VECTOR_shrink_to_fit shall free the internal storage and return 0.] */
+    TEST_FUNCTION(VECTOR_shrink_to_fit_on_an_empty_vector_frees_the_storage)
+    {
+        ///arrange
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_reserve(handle, 4);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_free(IGNORED_PTR_ARG))
+            .IgnoreArgument_ptr();
+
+        ///act
+        int result = VECTOR_shrink_to_fit(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 0, VECTOR_capacity(handle));
+        ASSERT_IS_NULL(VECTOR_front(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_01_016: [Otherwise VECTOR_shrink_to_fit shall resize the internal storage to hold exactly the elements of the vector and return 0.] */
+    TEST_FUNCTION(VECTOR_shrink_to_fit_releases_the_unused_capacity)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItems[3] = { {1, 2}, {3, 4}, {5, 6} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, sItems, 3);
+        VECTOR_erase(handle, VECTOR_front(handle), 1);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(VECTOR_UNITTEST)))
+            .IgnoreArgument_ptr();
+
+        ///act
+        int result = VECTOR_shrink_to_fit(handle);
+
+        ///assert
+        ASSERT_ARE_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_size(handle));
+        VECTOR_UNITTEST* pResult = (VECTOR_UNITTEST*)VECTOR_front(handle);
+        ASSERT_ARE_EQUAL(int, sItems[1].nValue1, pResult->nValue1);
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
+    /* Tests_SRS_VECTOR_01_017: [VECTOR_shrink_to_fit shall fail and return non-zero if memory allocation fails, leaving the vector unchanged.] */
+    TEST_FUNCTION(VECTOR_shrink_to_fit_fails_if_realloc_fails)
+    {
+        ///arrange
+        VECTOR_UNITTEST sItems[3] = { {1, 2}, {3, 4}, {5, 6} };
+        VECTOR_HANDLE handle = VECTOR_create(sizeof(VECTOR_UNITTEST));
+        (void)VECTOR_push_back(handle, sItems, 3);
+        VECTOR_pop_back(handle);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(gballoc_realloc(IGNORED_PTR_ARG, 2 * sizeof(VECTOR_UNITTEST)))
+            .IgnoreArgument_ptr()
+            .SetReturn(NULL);
+
+        ///act
+        int result = VECTOR_shrink_to_fit(handle);
+
+        ///assert
+        ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        ASSERT_ARE_EQUAL(size_t, 3, VECTOR_capacity(handle));
+        ASSERT_ARE_EQUAL(size_t, 2, VECTOR_size(handle));
+        ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        ///cleanup
+        VECTOR_destroy(handle);
+    }
+
     /* Vector_Tests END */
 
 END_TEST_SUITE(Vector_UnitTests)